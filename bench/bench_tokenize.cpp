@@ -0,0 +1,84 @@
+/*
+  bench_tokenize -- how many tokens per second MainWindow::tokenize() does.
+
+  For copyright and license notice, see beginning of ocelotgui.cpp.
+
+  Build with cmake . -DBENCH=ON && make bench_tokenize, see CMakeLists.txt.
+  Usage: bench_tokenize [file [repeat]]
+  The file is tokenized repeat times (default 20), as the statement widget
+  would tokenize it, i.e. with the same version, comment behaviour and
+  delimiter arguments as action_statement_edit_widget_text_changed().
+  If there's no file, the text is made up: INSERTs like a mysqldump's,
+  with long strings, numbers and comments, since tokenize_skip_till()
+  etc. are for those. The result is the best of the repeats, so run it
+  before and after a tokenize() change on the same file to compare.
+  No connection, no MainWindow, no QApplication: tokenize() is static.
+*/
+#define OCELOTGUI_NO_MAIN
+#include "../ocelotgui.cpp"
+
+static QString bench_tokenize_made_up_text()
+{
+  QString text;
+  for (int i= 0; i < 2000; ++i)
+  {
+    text.append("/* row group " + QString::number(i) + " */\n");
+    text.append("INSERT INTO `t` (`id`, `name`, `price`, `note`) VALUES ");
+    for (int j= 0; j < 20; ++j)
+    {
+      if (j > 0) text.append(",");
+      text.append("(" + QString::number(i * 20 + j) + ",'name " + QString::number(j)
+                  + "'," + QString::number(j) + ".25,'");
+      text.append(QString(200, QChar('x')));
+      text.append(" it''s \\\\ \\' done')");
+    }
+    text.append(";\n-- end\n");
+  }
+  return text;
+}
+
+int main(int argc, char *argv[])
+{
+  QString text;
+  if (argc > 1)
+  {
+    QFile file(argv[1]);
+    if (file.open(QIODevice::ReadOnly) == false)
+    {
+      fprintf(stderr, "bench_tokenize: can't open %s\n", argv[1]);
+      return 1;
+    }
+    text= QString::fromUtf8(file.readAll());
+  }
+  else text= bench_tokenize_made_up_text();
+  int repeat= 20;
+  if (argc > 2) repeat= atoi(argv[2]);
+  if (repeat < 1) repeat= 1;
+
+  /* tokenize() makes at most one token per character, plus the terminating 0-length one */
+  int max_tokens= text.size() + 1;
+  QVector<int> token_lengths(max_tokens);
+  QVector<int> token_offsets(max_tokens);
+  int token_count= 0;
+  qint64 best_ns= 0;
+  for (int r= 0; r < repeat; ++r)
+  {
+    QElapsedTimer timer;
+    timer.start();
+    MainWindow::tokenize(text.data(),
+                         text.size(),
+                         token_lengths.data(), token_offsets.data(), max_tokens, (QChar*)"33333", 1, ";", 1);
+    qint64 ns= timer.nsecsElapsed();
+    if ((r == 0) || (ns < best_ns)) best_ns= ns;
+  }
+  while (token_lengths[token_count] != 0) ++token_count;
+  if (best_ns <= 0) best_ns= 1;
+
+  double seconds= (double) best_ns / 1000000000;
+  printf("characters: %d\n", text.size());
+  printf("tokens: %d\n", token_count);
+  printf("best of %d: %.3f ms\n", repeat, (double) best_ns / 1000000);
+  printf("tokens/second: %.0f\n", token_count / seconds);
+  printf("characters/second: %.0f\n", text.size() / seconds);
+  return 0;
+}
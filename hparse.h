@@ -46,6 +46,12 @@
 void MainWindow::hparse_f_nexttoken()
 {
   if (hparse_errno > 0) return;
+  /* A newer edit came while we were in the background. See hparse_background_cancel(). */
+  if (hparse_is_cancelled)
+  {
+    hparse_errno= 1;
+    return;
+  }
   for (;;)
   {
     ++hparse_i;
@@ -169,35 +175,106 @@ bool MainWindow::hparse_f_is_special_verb(int outer_verb)
   return false;
 }
 
+/*
+  Pseudo-tokens that hparse_f_accept() callers pass instead of a real token.
+  hparse_f_pseudo_token() turns the string into one of these, cheaply,
+  because only they start with "[" and a letter.
+*/
+#define HPARSE_PSEUDO_NONE 0
+#define HPARSE_PSEUDO_EOF 1
+#define HPARSE_PSEUDO_IDENTIFIER 2
+#define HPARSE_PSEUDO_LITERAL 3
+#define HPARSE_PSEUDO_INTRODUCER 4
+#define HPARSE_PSEUDO_RESERVED_FUNCTION 5
+#define HPARSE_PSEUDO_FIELD_IDENTIFIER 6
+static int hparse_f_pseudo_token(const char *token)
+{
+  if (token[0] != '[') return HPARSE_PSEUDO_NONE;
+  switch (token[1])
+  {
+  case 'e': if (strcmp(token, "[eof]") == 0) return HPARSE_PSEUDO_EOF; break;
+  case 'i': if (strcmp(token, "[identifier]") == 0) return HPARSE_PSEUDO_IDENTIFIER;
+            if (strcmp(token, "[introducer]") == 0) return HPARSE_PSEUDO_INTRODUCER; break;
+  case 'l': if (strcmp(token, "[literal]") == 0) return HPARSE_PSEUDO_LITERAL; break;
+  case 'r': if (strcmp(token, "[reserved function]") == 0) return HPARSE_PSEUDO_RESERVED_FUNCTION; break;
+  case 'f': if (strcmp(token, "[field identifier]") == 0) return HPARSE_PSEUDO_FIELD_IDENTIFIER; break;
+  }
+  return HPARSE_PSEUDO_NONE;
+}
+
+/*
+  Same as QString::compare(hparse_token, token, ...) == 0, but without
+  making a QString of token or upper-casing anything. Usually it's
+  over at the first character. If there's non-ASCII, do it the slow way.
+*/
+bool MainWindow::hparse_f_token_is(const char *token, bool is_case_sensitive)
+{
+  int length= hparse_token.size();
+  const QChar *p= hparse_token.constData();
+  int i;
+  for (i= 0; i < length; ++i)
+  {
+    unsigned char c= (unsigned char) token[i];
+    if (c == '\0') return false;
+    unsigned short int u= p[i].unicode();
+    if ((c > 127) || (u > 127)) break;
+    if (u == c) continue;
+    if (is_case_sensitive) return false;
+    if ((u >= 'a') && (u <= 'z')) u-= 'a' - 'A';
+    if ((c >= 'a') && (c <= 'z')) c-= 'a' - 'A';
+    if (u != c) return false;
+  }
+  if (i == length) return (token[i] == '\0');
+  if (is_case_sensitive) return (QString::compare(hparse_token, QString::fromUtf8(token), Qt::CaseSensitive) == 0);
+  return (QString::compare(hparse_token, QString::fromUtf8(token), Qt::CaseInsensitive) == 0);
+}
+
+/* hparse_expected.append(token), without a temporary QString if token is ASCII */
+void MainWindow::hparse_f_expected_append(const char *token)
+{
+  const char *p;
+  for (p= token; *p != '\0'; ++p) if ((unsigned char) *p > 127) break;
+  if (*p == '\0') hparse_expected.append(QLatin1String(token));
+  else hparse_expected.append(QString::fromUtf8(token));
+}
+
 /*
   accept means: if current == expected then clear list of what was expected, get next, and return 1,
                 else add to list of what was expected, and return 0
+  This is called thousands of times per statement, nearly always with a
+  string literal that doesn't match, so token is const char* and there
+  are no QString allocations unless something matches.
 */
-int MainWindow::hparse_f_accept(unsigned short int flag_version, unsigned char reftype, int proposed_type, QString token)
+int MainWindow::hparse_f_accept(unsigned short int flag_version, unsigned char reftype, int proposed_type, const char *token)
 {
   if (hparse_errno > 0) return 0;
   if ((hparse_dbms_mask & flag_version) == 0) return 0;
   bool equality= false;
-  if (token == "[eof]")
+  int pseudo_token= hparse_f_pseudo_token(token);
+  int offset= main_token_offsets[hparse_i];
+  if (pseudo_token == HPARSE_PSEUDO_EOF)
   {
     if (hparse_token.length() == 0)
     {
       equality= true;
     }
   }
-  else if ((hparse_token == hparse_delimiter_str) && (hparse_delimiter_str != ";"))
+  else if ((hparse_token == hparse_delimiter_str)
+        && ((hparse_delimiter_str.size() != 1) || (hparse_delimiter_str.at(0) != ';')))
   {
-    if ((hparse_token == token) && (proposed_type == TOKEN_TYPE_DELIMITER)) equality= true;
+    if ((hparse_f_token_is(token, true)) && (proposed_type == TOKEN_TYPE_DELIMITER)) equality= true;
     else equality= false;
   }
-  else if (hparse_text_copy.mid(main_token_offsets[hparse_i], 2).toUpper() == "\\G")
+  else if ((offset + 1 < hparse_text_copy.size())
+        && (hparse_text_copy.at(offset) == '\\')
+        && ((hparse_text_copy.at(offset + 1) == 'G') || (hparse_text_copy.at(offset + 1) == 'g')))
   {
     /* \G and \g can act somewhat like delimiters. No change to hparse_expected list. */
     if (proposed_type == TOKEN_TYPE_DELIMITER)
     {
       //main_token_types[hparse_i]= proposed_type;
       //main_token_types[hparse_i + 1]= proposed_type;
-      hparse_expected= "";
+      hparse_expected.truncate(0);
       hparse_f_nexttoken();
       hparse_i_of_last_accepted= hparse_i;
       hparse_f_nexttoken();
@@ -206,7 +283,7 @@ int MainWindow::hparse_f_accept(unsigned short int flag_version, unsigned char r
     }
     return 0;
   }
-  else if (token == "[identifier]")
+  else if (pseudo_token == HPARSE_PSEUDO_IDENTIFIER)
   {
     /* todo: stop checking if it's "[identifier]" when reftype is always passed. */
     if ((hparse_dbms_mask & FLAG_VERSION_LUA) != 0)
@@ -257,7 +334,7 @@ int MainWindow::hparse_f_accept(unsigned short int flag_version, unsigned char r
       }
     }
   }
-  else if (token == "[literal]")
+  else if (pseudo_token == HPARSE_PSEUDO_LITERAL)
   {
     if (hparse_token_type == TOKEN_TYPE_LITERAL_WITH_SINGLE_QUOTE)
     {
@@ -296,7 +373,7 @@ int MainWindow::hparse_f_accept(unsigned short int flag_version, unsigned char r
       equality= true;
     }
   }
-  else if (token == "[introducer]")
+  else if (pseudo_token == HPARSE_PSEUDO_INTRODUCER)
   {
     if ((hparse_token_type >= TOKEN_KEYWORD__ARMSCII8)
      && (hparse_token_type <= TOKEN_KEYWORD__UTF8MB4))
@@ -304,14 +381,14 @@ int MainWindow::hparse_f_accept(unsigned short int flag_version, unsigned char r
       equality= true;
     }
   }
-  else if (token == "[reserved function]")
+  else if (pseudo_token == HPARSE_PSEUDO_RESERVED_FUNCTION)
   {
     if (((main_token_flags[hparse_i] & TOKEN_FLAG_IS_RESERVED) != 0)
      && ((main_token_flags[hparse_i] & TOKEN_FLAG_IS_FUNCTION) != 0))
       equality= true;
   }
 #ifdef DBMS_TARANTOOL
-  else if (token == "[field identifier]")
+  else if (pseudo_token == HPARSE_PSEUDO_FIELD_IDENTIFIER)
   {
     int base_size= strlen(TARANTOOL_FIELD_NAME_BASE);
     bool ok= false;
@@ -332,12 +409,12 @@ int MainWindow::hparse_f_accept(unsigned short int flag_version, unsigned char r
   {
     if ((hparse_dbms_mask & FLAG_VERSION_LUA) != 0)
     {
-      if (QString::compare(hparse_token, token, Qt::CaseSensitive) == 0)
+      if (hparse_f_token_is(token, true))
       {
         equality= true;
       }
     }
-    else if (QString::compare(hparse_token, token, Qt::CaseInsensitive) == 0)
+    else if (hparse_f_token_is(token, false))
     {
       equality= true;
     }
@@ -357,18 +434,26 @@ int MainWindow::hparse_f_accept(unsigned short int flag_version, unsigned char r
      && (main_token_types[hparse_i] < TOKEN_TYPE_LITERAL)) {;}
     else main_token_types[hparse_i]= proposed_type;
     main_token_reftypes[hparse_i]= reftype;
-    hparse_expected= "";
+    hparse_expected.truncate(0);
     hparse_i_of_last_accepted= hparse_i;
     hparse_f_nexttoken();
     ++hparse_count_of_accepts;
     return 1;
   }
   /* these 2 lines are duplicated in hparse_f_accept_dotted() */
-  if (hparse_expected > "") hparse_expected.append(" or ");
-  hparse_expected.append(hparse_f_token_to_appendee(token, reftype));
+  if (hparse_expected.isEmpty() == false) hparse_expected.append(QLatin1String(" or "));
+  if (pseudo_token == HPARSE_PSEUDO_IDENTIFIER) hparse_expected.append(hparse_f_token_to_appendee(token, reftype));
+  else hparse_f_expected_append(token);
   return 0;
 }
 
+/* For a token that isn't a string literal, e.g. hparse_delimiter_str or a label */
+int MainWindow::hparse_f_accept(unsigned short int flag_version, unsigned char reftype, int proposed_type, QString token)
+{
+  QByteArray token_as_utf8= token.toUtf8();
+  return hparse_f_accept(flag_version, reftype, proposed_type, token_as_utf8.constData());
+}
+
 /*
   Replace [identifier] with something more specific.
   Todo: there are some problems with what-is-an-identifier calculation:
@@ -464,7 +549,7 @@ int MainWindow::hparse_f_acceptn(int proposed_type, QString token, int n)
 }
 
 /* expect means: if current == expected then get next and return 1; else error */
-int MainWindow::hparse_f_expect(unsigned short int flag_version, unsigned char reftype,int proposed_type, QString token)
+int MainWindow::hparse_f_expect(unsigned short int flag_version, unsigned char reftype,int proposed_type, const char *token)
 {
   if (hparse_errno > 0) return 0;
   if ((hparse_dbms_mask & flag_version) == 0) return 0;
@@ -473,6 +558,12 @@ int MainWindow::hparse_f_expect(unsigned short int flag_version, unsigned char r
   return 0;
 }
 
+int MainWindow::hparse_f_expect(unsigned short int flag_version, unsigned char reftype,int proposed_type, QString token)
+{
+  QByteArray token_as_utf8= token.toUtf8();
+  return hparse_f_expect(flag_version, reftype, proposed_type, token_as_utf8.constData());
+}
+
 /* [literal] or _introducer [literal], return 1 if true */
 /* todo: this is also accepting {ODBC junk} or NULL, sometimes when it shouldn't. */
 /* todo: in fact it's far far too lax, you should pass what's acceptable data type */
@@ -5603,6 +5694,338 @@ void MainWindow::hparse_f_indexes_or_keys() /* for SHOW {INDEX | INDEXES | KEYS}
   }
 }
 
+/*
+  The grammar of SHOW is a table rather than a chain of if/else if.
+  Each row is: which DBMSs have it, the keyword after SHOW, up to two
+  more words that must follow (keywords, or "[literal]"), and what comes
+  after that. A row with no keyword means "try hparse_f_character_set()".
+  Order matters: rows are tried top to bottom, and the ones that fail
+  go into the "expected" list in that order, as they did before.
+  To support a new SHOW variant, usually all you need is a new row.
+*/
+#define HPARSE_SHOW_NOTHING                0
+#define HPARSE_SHOW_LIKE_OR_WHERE          1
+#define HPARSE_SHOW_FROM_OR_LIKE_OR_WHERE  2
+#define HPARSE_SHOW_LIMIT                  3
+#define HPARSE_SHOW_COLUMNS                4
+#define HPARSE_SHOW_INDEXES_OR_KEYS        5
+#define HPARSE_SHOW_CHARACTER_SET          6
+#define HPARSE_SHOW_EVENTS                 7
+#define HPARSE_SHOW_RELAYLOG               8
+#define HPARSE_SHOW_COUNT                  9
+#define HPARSE_SHOW_CREATE                 10
+#define HPARSE_SHOW_ENGINE                 11
+#define HPARSE_SHOW_FULL                   12
+#define HPARSE_SHOW_FUNCTION               13
+#define HPARSE_SHOW_PROCEDURE              14
+#define HPARSE_SHOW_STATUS_OR_VARIABLES    15
+#define HPARSE_SHOW_GRANTS                 16
+#define HPARSE_SHOW_MASTER                 17
+#define HPARSE_SHOW_PLUGINS                18
+#define HPARSE_SHOW_PROFILE                19
+#define HPARSE_SHOW_SLAVE                  20
+
+struct hparse_show_rule
+{
+  unsigned short int flag_version;
+  const char *keyword;
+  const char *then_1;
+  const char *then_2;
+  unsigned char what_follows;
+};
+
+static const hparse_show_rule hparse_show_rules[]=
+{
+  {FLAG_VERSION_MYSQL_OR_MARIADB_ALL, "ALL", "SLAVES", "STATUS", HPARSE_SHOW_NOTHING},
+  {FLAG_VERSION_MYSQL_OR_MARIADB_ALL, "AUTHORS", 0, 0, HPARSE_SHOW_NOTHING}, /* removed in MySQL 5.6.8 */
+  {FLAG_VERSION_MYSQL_OR_MARIADB_ALL, "BINARY", "LOGS", 0, HPARSE_SHOW_NOTHING},
+  {FLAG_VERSION_MYSQL_OR_MARIADB_ALL, "BINLOG", "EVENTS", 0, HPARSE_SHOW_EVENTS},
+  {FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, 0, 0, HPARSE_SHOW_CHARACTER_SET},
+  {FLAG_VERSION_MARIADB_ALL, "CLIENT_STATISTICS", 0, 0, HPARSE_SHOW_NOTHING},
+  {FLAG_VERSION_MYSQL_OR_MARIADB_ALL, "COLLATION", 0, 0, HPARSE_SHOW_LIKE_OR_WHERE},
+  {FLAG_VERSION_MYSQL_OR_MARIADB_ALL, "COLUMNS", 0, 0, HPARSE_SHOW_COLUMNS},
+  {FLAG_VERSION_MARIADB_ALL, "CONTRIBUTORS", 0, 0, HPARSE_SHOW_NOTHING},
+  {FLAG_VERSION_MYSQL_OR_MARIADB_ALL, "COUNT", 0, 0, HPARSE_SHOW_COUNT},
+  {FLAG_VERSION_MYSQL_OR_MARIADB_ALL, "CREATE", 0, 0, HPARSE_SHOW_CREATE},
+  {FLAG_VERSION_MYSQL_OR_MARIADB_ALL, "DATABASES", 0, 0, HPARSE_SHOW_LIKE_OR_WHERE},
+  {FLAG_VERSION_MYSQL_OR_MARIADB_ALL, "ENGINE", 0, 0, HPARSE_SHOW_ENGINE},
+  {FLAG_VERSION_MYSQL_OR_MARIADB_ALL, "ENGINES", 0, 0, HPARSE_SHOW_NOTHING},
+  {FLAG_VERSION_MYSQL_OR_MARIADB_ALL, "ERRORS", 0, 0, HPARSE_SHOW_LIMIT},
+  {FLAG_VERSION_MYSQL_OR_MARIADB_ALL, "EVENTS", 0, 0, HPARSE_SHOW_FROM_OR_LIKE_OR_WHERE},
+  {FLAG_VERSION_MARIADB_ALL, "EXPLAIN", "FOR", "[literal]", HPARSE_SHOW_NOTHING},
+  {FLAG_VERSION_MYSQL_OR_MARIADB_ALL, "FIELDS", 0, 0, HPARSE_SHOW_COLUMNS},
+  {FLAG_VERSION_MYSQL_OR_MARIADB_ALL, "FULL", 0, 0, HPARSE_SHOW_FULL},
+  {FLAG_VERSION_MYSQL_OR_MARIADB_ALL, "FUNCTION", 0, 0, HPARSE_SHOW_FUNCTION},
+  {FLAG_VERSION_MYSQL_OR_MARIADB_ALL, "GLOBAL", 0, 0, HPARSE_SHOW_STATUS_OR_VARIABLES},
+  {FLAG_VERSION_MYSQL_OR_MARIADB_ALL, "GRANTS", 0, 0, HPARSE_SHOW_GRANTS},
+  {FLAG_VERSION_MYSQL_OR_MARIADB_ALL, "INDEX", 0, 0, HPARSE_SHOW_INDEXES_OR_KEYS},
+  {FLAG_VERSION_MYSQL_OR_MARIADB_ALL, "INDEXES", 0, 0, HPARSE_SHOW_INDEXES_OR_KEYS},
+  {FLAG_VERSION_MARIADB_ALL, "INDEX_STATISTICS", 0, 0, HPARSE_SHOW_NOTHING},
+  {FLAG_VERSION_MYSQL_OR_MARIADB_ALL, "KEYS", 0, 0, HPARSE_SHOW_INDEXES_OR_KEYS},
+  {FLAG_VERSION_MARIADB_ALL, "LOCALES", 0, 0, HPARSE_SHOW_NOTHING},
+  {FLAG_VERSION_MYSQL_OR_MARIADB_ALL, "MASTER", 0, 0, HPARSE_SHOW_MASTER},
+  {FLAG_VERSION_MYSQL_OR_MARIADB_ALL, "OPEN", "TABLES", 0, HPARSE_SHOW_FROM_OR_LIKE_OR_WHERE},
+  {FLAG_VERSION_MYSQL_OR_MARIADB_ALL, "PLUGINS", 0, 0, HPARSE_SHOW_PLUGINS},
+  {FLAG_VERSION_MYSQL_OR_MARIADB_ALL, "PRIVILEGES", 0, 0, HPARSE_SHOW_NOTHING},
+  {FLAG_VERSION_MYSQL_OR_MARIADB_ALL, "PROCEDURE", 0, 0, HPARSE_SHOW_PROCEDURE},
+  {FLAG_VERSION_MYSQL_OR_MARIADB_ALL, "PROCESSLIST", 0, 0, HPARSE_SHOW_NOTHING},
+  {FLAG_VERSION_MYSQL_OR_MARIADB_ALL, "PROFILE", 0, 0, HPARSE_SHOW_PROFILE},
+  {FLAG_VERSION_MYSQL_OR_MARIADB_ALL, "PROFILES", 0, 0, HPARSE_SHOW_NOTHING},
+  {FLAG_VERSION_MARIADB_ALL, "QUERY_RESPONSE_TIME", 0, 0, HPARSE_SHOW_NOTHING},
+  {FLAG_VERSION_MYSQL_OR_MARIADB_ALL, "RELAYLOG", 0, 0, HPARSE_SHOW_RELAYLOG},
+  {FLAG_VERSION_MYSQL_OR_MARIADB_ALL, "SCHEMAS", 0, 0, HPARSE_SHOW_LIKE_OR_WHERE},
+  {FLAG_VERSION_MYSQL_OR_MARIADB_ALL, "SESSION", 0, 0, HPARSE_SHOW_STATUS_OR_VARIABLES},
+  {FLAG_VERSION_MYSQL_OR_MARIADB_ALL, "SLAVE", 0, 0, HPARSE_SHOW_SLAVE},
+  {FLAG_VERSION_MYSQL_OR_MARIADB_ALL, "STATUS", 0, 0, HPARSE_SHOW_LIKE_OR_WHERE},
+  {FLAG_VERSION_MYSQL_OR_MARIADB_ALL, "STORAGE", "ENGINES", 0, HPARSE_SHOW_NOTHING},
+  {FLAG_VERSION_MYSQL_OR_MARIADB_ALL, "TABLE", "STATUS", 0, HPARSE_SHOW_FROM_OR_LIKE_OR_WHERE},
+  {FLAG_VERSION_MYSQL_OR_MARIADB_ALL, "TABLES", 0, 0, HPARSE_SHOW_FROM_OR_LIKE_OR_WHERE},
+  {FLAG_VERSION_MARIADB_ALL, "TABLE_STATISTICS", 0, 0, HPARSE_SHOW_NOTHING},
+  {FLAG_VERSION_MYSQL_OR_MARIADB_ALL, "TRIGGERS", 0, 0, HPARSE_SHOW_FROM_OR_LIKE_OR_WHERE},
+  {FLAG_VERSION_MARIADB_ALL, "USER_STATISTICS", 0, 0, HPARSE_SHOW_NOTHING},
+  {FLAG_VERSION_MYSQL_OR_MARIADB_ALL, "VARIABLES", 0, 0, HPARSE_SHOW_LIKE_OR_WHERE},
+  {FLAG_VERSION_MYSQL_OR_MARIADB_ALL, "WARNINGS", 0, 0, HPARSE_SHOW_LIMIT},
+  {FLAG_VERSION_MARIADB_ALL, "WSREP_MEMBERSHIP", 0, 0, HPARSE_SHOW_NOTHING},
+  {FLAG_VERSION_MARIADB_ALL, "WSREP_STATUS", 0, 0, HPARSE_SHOW_NOTHING}
+};
+
+/* A word that must follow a SHOW keyword, from hparse_show_rules[] */
+void MainWindow::hparse_f_show_expect(const char *word)
+{
+  if (word == 0) return;
+  if (strcmp(word, "[literal]") == 0)
+    hparse_f_expect(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_LITERAL, word);
+  else hparse_f_expect(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, word);
+}
+
+/* SHOW has been accepted. Find the rule for what follows, then do what the rule says. */
+void MainWindow::hparse_f_show()
+{
+  const hparse_show_rule *rule= 0;
+  for (unsigned int i= 0; i < sizeof(hparse_show_rules) / sizeof(hparse_show_rules[0]); ++i)
+  {
+    const hparse_show_rule *r= &hparse_show_rules[i];
+    if (r->keyword == 0)
+    {
+      if (hparse_f_character_set() == 1) { rule= r; break; }
+      if (hparse_errno > 0) return;
+    }
+    else if (hparse_f_accept(r->flag_version, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, r->keyword) == 1) { rule= r; break; }
+  }
+  if (rule == 0)
+  {
+    hparse_f_error();
+    return;
+  }
+  hparse_f_show_expect(rule->then_1);
+  if (hparse_errno > 0) return;
+  hparse_f_show_expect(rule->then_2);
+  if (hparse_errno > 0) return;
+  switch (rule->what_follows)
+  {
+  case HPARSE_SHOW_NOTHING:
+    break;
+  case HPARSE_SHOW_LIKE_OR_WHERE:
+  case HPARSE_SHOW_CHARACTER_SET:
+    hparse_f_like_or_where();
+    break;
+  case HPARSE_SHOW_FROM_OR_LIKE_OR_WHERE:
+    hparse_f_from_or_like_or_where();
+    break;
+  case HPARSE_SHOW_LIMIT:
+    hparse_f_limit(TOKEN_KEYWORD_SHOW);
+    break;
+  case HPARSE_SHOW_COLUMNS:
+    hparse_f_show_columns();
+    break;
+  case HPARSE_SHOW_INDEXES_OR_KEYS:
+    hparse_f_indexes_or_keys();
+    break;
+  case HPARSE_SHOW_RELAYLOG:
+    if ((hparse_dbms_mask & FLAG_VERSION_MARIADB_ALL) != 0) hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_LITERAL, "[literal]");
+    hparse_f_expect(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "EVENTS");
+    if (hparse_errno > 0) return;
+    /* fall through */
+  case HPARSE_SHOW_EVENTS: /* show binlog events | show relaylog events */
+    if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "IN") == 1)
+    {
+      main_token_flags[hparse_i_of_last_accepted] &= (~TOKEN_FLAG_IS_FUNCTION);
+      if (hparse_f_literal() == 0) hparse_f_error();
+      if (hparse_errno > 0) return;
+    }
+    if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "FROM") == 1)
+    {
+      if (hparse_f_literal() == 0) hparse_f_error();
+      if (hparse_errno > 0) return;
+    }
+    hparse_f_limit(TOKEN_KEYWORD_SHOW);
+    break;
+  case HPARSE_SHOW_COUNT:
+    hparse_f_expect(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_OPERATOR, "(");
+    if (hparse_errno > 0) return;
+    hparse_f_expect(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_IDENTIFIER, "*");
+    if (hparse_errno > 0) return;
+    hparse_f_expect(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_OPERATOR, ")");
+    if (hparse_errno > 0) return;
+    if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "ERRORS") == 1) ;
+    else hparse_f_expect(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "WARNINGS");
+    break;
+  case HPARSE_SHOW_CREATE: /* show create ... */
+    if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "DATABASE") == 1)
+    {
+      hparse_f_if_not_exists();
+      if (hparse_errno > 0) return;
+      hparse_f_expect(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_DATABASE, TOKEN_TYPE_IDENTIFIER, "[identifier]");
+    }
+    else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "EVENT") == 1)
+    {
+      if (hparse_f_qualified_name_of_object(TOKEN_REFTYPE_DATABASE_OR_EVENT, TOKEN_REFTYPE_EVENT) == 0) hparse_f_error();
+    }
+    else if (hparse_f_accept(FLAG_VERSION_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "EXPLAIN") == 1)
+    {
+      hparse_f_expect(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "FOR");
+      if (hparse_errno > 0) return;
+      hparse_f_expect(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_LITERAL, "[literal]");
+    }
+    else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "FUNCTION") == 1)
+    {
+      if (hparse_f_qualified_name_of_object(TOKEN_REFTYPE_DATABASE_OR_FUNCTION, TOKEN_REFTYPE_FUNCTION) == 0) hparse_f_error();
+    }
+    else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "PROCEDURE") == 1)
+    {
+      if (hparse_f_qualified_name_of_object(TOKEN_REFTYPE_DATABASE_OR_PROCEDURE, TOKEN_REFTYPE_PROCEDURE) == 0) hparse_f_error();
+    }
+    else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "SCHEMA") == 1)
+    {
+      hparse_f_if_not_exists();
+      if (hparse_errno > 0) return;
+      hparse_f_expect(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_DATABASE, TOKEN_TYPE_IDENTIFIER, "[identifier]");
+    }
+    else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "TABLE") == 1)
+    {
+      if (hparse_f_qualified_name_of_object(TOKEN_REFTYPE_DATABASE_OR_TABLE, TOKEN_REFTYPE_TABLE) == 0) hparse_f_error();
+    }
+    else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "TRIGGER") == 1)
+    {
+      if (hparse_f_qualified_name_of_object(TOKEN_REFTYPE_DATABASE_OR_TRIGGER, TOKEN_REFTYPE_TRIGGER) == 0) hparse_f_error();
+    }
+    else if (hparse_f_accept(FLAG_VERSION_MYSQL_5_7|FLAG_VERSION_MARIADB_10_2_2, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "USER") == 1)
+    {
+      if (hparse_f_user_name() == 0) hparse_f_error();
+    }
+    else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "VIEW") == 1)
+    {
+      if (hparse_f_qualified_name_of_object(TOKEN_REFTYPE_DATABASE_OR_VIEW, TOKEN_REFTYPE_VIEW) == 0) hparse_f_error();
+    }
+    break;
+  case HPARSE_SHOW_ENGINE: /* show engine */
+    hparse_f_expect(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ENGINE,TOKEN_TYPE_IDENTIFIER, "[identifier]");
+    if (hparse_errno > 0) return;
+    if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "STATUS") == 0)
+      hparse_f_expect(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "MUTEX");
+    break;
+  case HPARSE_SHOW_FULL: /* show full [columns|tables|etc.] */
+    if ((hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "COLUMNS") == 1)
+     || (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "FIELDS") == 1))
+      hparse_f_show_columns();
+    else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "TABLES") == 1)
+      hparse_f_from_or_like_or_where();
+    else hparse_f_expect(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "PROCESSLIST");
+    break;
+  case HPARSE_SHOW_FUNCTION: /* show function [code|status] */
+  case HPARSE_SHOW_PROCEDURE: /* show procedure [code|status] */
+    if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "CODE") == 1)
+    {
+      int result;
+      if (rule->what_follows == HPARSE_SHOW_FUNCTION)
+        result= hparse_f_qualified_name_of_object(TOKEN_REFTYPE_DATABASE_OR_FUNCTION, TOKEN_REFTYPE_FUNCTION);
+      else
+        result= hparse_f_qualified_name_of_object(TOKEN_REFTYPE_DATABASE_OR_PROCEDURE, TOKEN_REFTYPE_PROCEDURE);
+      if (result == 0) hparse_f_error();
+    }
+    else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "STATUS") == 1)
+      hparse_f_like_or_where();
+    break;
+  case HPARSE_SHOW_STATUS_OR_VARIABLES: /* show global ... | show session ... */
+    if ((hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "STATUS") == 1)
+     || (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "VARIABLES") == 1))
+      hparse_f_like_or_where();
+    else hparse_f_error();
+    break;
+  case HPARSE_SHOW_GRANTS: /* show grants */
+    if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "FOR") == 1)
+    {
+      if (hparse_f_user_name() == 0) hparse_f_error();
+    }
+    break;
+  case HPARSE_SHOW_MASTER: /* show master [status|logs] */
+    if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "STATUS") == 0)
+      hparse_f_expect(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "LOGS");
+    break;
+  case HPARSE_SHOW_PLUGINS: /* show plugins */
+    if (hparse_f_accept(FLAG_VERSION_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "SONAME") == 1)
+    {
+      if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_LITERAL, "[literal]") == 1) {;}
+      else hparse_f_from_or_like_or_where();
+    }
+    break;
+  case HPARSE_SHOW_PROFILE: /* show profile */
+    for (;;)
+    {
+      if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "ALL") == 1) {;}
+      else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "BLOCK") == 1)
+      {
+        hparse_f_expect(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "IO");
+        if (hparse_errno > 0) return;
+      }
+      else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "ALL") == 1) {;}
+      else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "BLOCK_IO") == 1) {;}
+      else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "CONTEXT") == 1)
+      {
+        hparse_f_expect(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "SWITCHES");
+        if (hparse_errno > 0) return;
+      }
+      else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "CPU") == 1) {;}
+      else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "IPC") == 1) {;}
+      else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "MEMORY") == 1) {;}
+      else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "PAGE") == 1)
+      {
+        hparse_f_expect(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "FAULTS");
+        if (hparse_errno > 0) return;
+      }
+      else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "SOURCE") == 1) {;}
+      else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "SWAPS") == 1) {;}
+      else break;
+      if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_OPERATOR, ",") == 1) continue;
+      break;
+    }
+    if (hparse_errno > 0) return;
+    if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "FOR") == 1)
+    {
+      hparse_f_expect(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "QUERY");
+      if (hparse_errno > 0) return;
+      if (hparse_f_literal() == 0) hparse_f_error();
+      if (hparse_errno > 0) return;
+    }
+    hparse_f_limit(TOKEN_KEYWORD_SHOW);
+    break;
+  case HPARSE_SHOW_SLAVE: /* show slave */
+    if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "HOSTS") == 1) {;}
+    else
+    {
+      if ((hparse_dbms_mask & FLAG_VERSION_MARIADB_ALL) != 0) hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_LITERAL, "[literal]");
+      hparse_f_expect(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "STATUS");
+      if (hparse_errno > 0) return;
+      if ((hparse_dbms_mask & FLAG_VERSION_MYSQL_ALL) != 0)
+      {
+        if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "NONBLOCKING") == 1) {;}
+        hparse_f_for_channel();
+      }
+    }
+    break;
+  }
+}
+
 /*
    For CREATE/ALTER: some clauses precede the object type, so e.g. we don't know yet
    whether it's a table, a view, an index, or whatever.
@@ -7750,523 +8173,75 @@ void MainWindow::hparse_f_statement(int block_top)
   {
     hparse_statement_type= TOKEN_KEYWORD_SHOW;
     main_token_flags[hparse_i_of_last_accepted] |= TOKEN_FLAG_IS_START_STATEMENT;
-    if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "ALL") == 1)
+    hparse_f_show();
+  }
+  else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_KEYWORD_SHUTDOWN, "SHUTDOWN"))
+  {
+    hparse_statement_type= TOKEN_KEYWORD_SHUTDOWN;
+    main_token_flags[hparse_i_of_last_accepted] |= TOKEN_FLAG_IS_START_STATEMENT;
+    return;
+  }
+  else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_KEYWORD_SIGNAL, "SIGNAL"))
+  {
+    hparse_statement_type= TOKEN_KEYWORD_SIGNAL;
+    main_token_flags[hparse_i_of_last_accepted] |= TOKEN_FLAG_IS_START_STATEMENT;
+    if (hparse_f_signal_or_resignal(TOKEN_KEYWORD_SIGNAL, block_top) == 0) hparse_f_error();
+    if (hparse_errno > 0) return;
+  }
+  else if (((hparse_dbms_mask & FLAG_VERSION_MARIADB_ALL) != 0) && (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_KEYWORD_SONAME, "SONAME") == 1))
+  {
+    hparse_statement_type= TOKEN_KEYWORD_SONAME;
+    main_token_flags[hparse_i_of_last_accepted] |= TOKEN_FLAG_IS_START_STATEMENT;
+    if (hparse_f_literal() == 0) hparse_f_error();
+    if (hparse_errno > 0) return;
+  }
+  else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_KEYWORD_START, "START"))
+  {
+    hparse_statement_type= TOKEN_KEYWORD_START;
+    main_token_flags[hparse_i_of_last_accepted] |= TOKEN_FLAG_IS_START_STATEMENT;
+    if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "TRANSACTION") == 1)
     {
-      hparse_f_expect(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "SLAVES");
-      if (hparse_errno > 0) return;
-      hparse_f_expect(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "STATUS");
       if (hparse_errno > 0) return;
+      bool with_seen= false, read_seen= false;
+      do
+      {
+        if ((with_seen == false) && (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "WITH")))
+        {
+          with_seen= true;
+          hparse_f_expect(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "CONSISTENT");
+          if (hparse_errno > 0) return;
+          hparse_f_expect(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "SNAPSHOT");
+          if (hparse_errno > 0) return;
+        }
+        if ((read_seen == false) && (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "READ")))
+        {
+          read_seen= true;
+          if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "ONLY") == 1) ;
+          else hparse_f_expect(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "WRITE");
+          if (hparse_errno > 0) return;
+        }
+      } while (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_OPERATOR, ","));
     }
-    else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "AUTHORS") == 1) {;} /* removed in MySQL 5.6.8 */
-    else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "BINARY") == 1)
+    else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "GROUP_REPLICATION") == 1) {;}
+    else if (((hparse_dbms_mask & FLAG_VERSION_MARIADB_ALL) != 0) && (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "ALL") == 1))
     {
-      hparse_f_expect(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "LOGS");
+      hparse_f_expect(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "SLAVES");
       if (hparse_errno > 0) return;
+      do
+      {
+        if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "IO_THREAD") == 1) {;}
+        else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "SQL_THREAD") == 1) {;}
+      } while (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_OPERATOR, ","));
     }
-    else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "BINLOG") == 1) /* show binlog */
+    else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "SLAVE") == 1)
     {
-      hparse_f_expect(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "EVENTS");
-      if (hparse_errno > 0) return;
-      if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "IN") == 1)
+      if ((hparse_dbms_mask & FLAG_VERSION_MARIADB_ALL) != 0) hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_LITERAL, "[literal]");
+      do
       {
-        main_token_flags[hparse_i_of_last_accepted] &= (~TOKEN_FLAG_IS_FUNCTION);
-        if (hparse_f_literal() == 0) hparse_f_error();
-        if (hparse_errno > 0) return;
-      }
-      if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "FROM") == 1)
-      {
-        if (hparse_f_literal() == 0) hparse_f_error();
-        if (hparse_errno > 0) return;
-      }
-      hparse_f_limit(TOKEN_KEYWORD_SHOW);
-      if (hparse_errno > 0) return;
-    }
-    else if (hparse_f_character_set() == 1) /* show character set */
-    {
-      hparse_f_like_or_where();
-      if (hparse_errno > 0) return;
-    }
-    else if (hparse_errno > 0) return;
-    else if (((hparse_dbms_mask & FLAG_VERSION_MARIADB_ALL) != 0) && (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "CLIENT_STATISTICS") == 1))
-    {
-      ;
-    }
-    else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "COLLATION") == 1) /* show collation */
-    {
-      hparse_f_like_or_where();
-      if (hparse_errno > 0) return;
-    }
-    else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "COLUMNS") == 1) /* show columns */
-    {
-      hparse_f_show_columns();
-      if (hparse_errno > 0) return;
-    }
-    else if (((hparse_dbms_mask & FLAG_VERSION_MARIADB_ALL) != 0) && (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "CONTRIBUTORS") == 1))
-    {
-      ;
-    }
-    else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "COUNT") == 1)
-    {
-      hparse_f_expect(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_OPERATOR, "(");
-      if (hparse_errno > 0) return;
-      hparse_f_expect(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_IDENTIFIER, "*");
-      if (hparse_errno > 0) return;
-      hparse_f_expect(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_OPERATOR, ")");
-      if (hparse_errno > 0) return;
-      if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "ERRORS") == 1) ;
-      else
-      {
-        hparse_f_expect(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "WARNINGS");
-        if (hparse_errno > 0) return;
-      }
-    }
-    else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "CREATE") == 1) /* show create ... */
-    {
-      if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "DATABASE") == 1)
-      {
-        hparse_f_if_not_exists();
-        if (hparse_errno > 0) return;
-        hparse_f_expect(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_DATABASE, TOKEN_TYPE_IDENTIFIER, "[identifier]");
-        if (hparse_errno > 0) return;
-      }
-      else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "EVENT") == 1)
-      {
-        if (hparse_f_qualified_name_of_object(TOKEN_REFTYPE_DATABASE_OR_EVENT, TOKEN_REFTYPE_EVENT) == 0) hparse_f_error();
-        if (hparse_errno > 0) return;
-      }
-      else if (((hparse_dbms_mask & FLAG_VERSION_MARIADB_ALL) != 0) && (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "EXPLAIN") == 1))
-      {
-        hparse_f_expect(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "FOR");
-        if (hparse_errno > 0) return;
-        hparse_f_expect(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_LITERAL, "[literal]");
-        if (hparse_errno > 0) return;
-      }
-      else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "FUNCTION") == 1)
-      {
-        if (hparse_f_qualified_name_of_object(TOKEN_REFTYPE_DATABASE_OR_FUNCTION, TOKEN_REFTYPE_FUNCTION) == 0) hparse_f_error();
-        if (hparse_errno > 0) return;
-      }
-      else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "PROCEDURE") == 1)
-      {
-        if (hparse_f_qualified_name_of_object(TOKEN_REFTYPE_DATABASE_OR_PROCEDURE, TOKEN_REFTYPE_PROCEDURE) == 0) hparse_f_error();
-        if (hparse_errno > 0) return;
-      }
-      else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "SCHEMA") == 1)
-      {
-        hparse_f_if_not_exists();
-        if (hparse_errno > 0) return;
-        hparse_f_expect(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_DATABASE, TOKEN_TYPE_IDENTIFIER, "[identifier]");
-        if (hparse_errno > 0) return;
-      }
-      else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "TABLE") == 1)
-      {
-        if (hparse_f_qualified_name_of_object(TOKEN_REFTYPE_DATABASE_OR_TABLE, TOKEN_REFTYPE_TABLE) == 0) hparse_f_error();
-        if (hparse_errno > 0) return;
-      }
-      else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "TRIGGER") == 1)
-      {
-        if (hparse_f_qualified_name_of_object(TOKEN_REFTYPE_DATABASE_OR_TRIGGER, TOKEN_REFTYPE_TRIGGER) == 0) hparse_f_error();
-        if (hparse_errno > 0) return;
-      }
-      else if (((hparse_dbms_mask & (FLAG_VERSION_MYSQL_5_7|FLAG_VERSION_MARIADB_10_2_2)) != 0) && (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "USER") == 1))
-      {
-        if (hparse_f_user_name() == 0) hparse_f_error();
-        if (hparse_errno > 0) return;
-      }
-      else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "VIEW") == 1)
-      {
-        if (hparse_f_qualified_name_of_object(TOKEN_REFTYPE_DATABASE_OR_VIEW, TOKEN_REFTYPE_VIEW) == 0) hparse_f_error();
-        if (hparse_errno > 0) return;
-      }
-    }
-    else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "DATABASES") == 1) /* show databases */
-    {
-      hparse_f_like_or_where();
-      if (hparse_errno > 0) return;
-    }
-    else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "ENGINE") == 1) /* show engine */
-    {
-      hparse_f_expect(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ENGINE,TOKEN_TYPE_IDENTIFIER, "[identifier]");
-      if (hparse_errno > 0) return;
-      if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "STATUS") == 0)
-      {
-        hparse_f_expect(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "MUTEX");
-        if (hparse_errno > 0) return;
-      }
-    }
-    else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "ENGINES") == 1) /* show engines */
-    {
-      ;
-    }
-    else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "ERRORS") == 1) /* show errors */
-    {
-      hparse_f_limit(TOKEN_KEYWORD_SHOW);
-      if (hparse_errno > 0) return;
-    }
-    else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "EVENTS") == 1) /* show events */
-    {
-      hparse_f_from_or_like_or_where();
-      if (hparse_errno > 0) return;
-    }
-    else if (((hparse_dbms_mask & FLAG_VERSION_MARIADB_ALL) != 0) && (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "EXPLAIN") == 1))
-    {
-      hparse_f_expect(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "FOR");
-      if (hparse_errno > 0) return;
-      hparse_f_expect(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_LITERAL, "[literal]");
-      if (hparse_errno > 0) return;
-    }
-    else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "FIELDS") == 1) /* show columns */
-    {
-      hparse_f_show_columns();
-      if (hparse_errno > 0) return;
-    }
-    else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "FULL") == 1) /* show full [columns|tables|etc.] */
-    {
-      if ((hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "COLUMNS") == 1)
-       || (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "FIELDS") == 1))
-      {
-        hparse_f_show_columns();
-        if (hparse_errno > 0) return;
-      }
-      else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "TABLES") == 1)
-      {
-        hparse_f_from_or_like_or_where();
-        if (hparse_errno > 0) return;
-      }
-      else hparse_f_expect(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "PROCESSLIST");
-      if (hparse_errno > 0) return;
-    }
-    else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "FUNCTION") == 1) /* show function [code] */
-    {
-      if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "CODE") == 1)
-      {
-        if (hparse_f_qualified_name_of_object(TOKEN_REFTYPE_DATABASE_OR_FUNCTION, TOKEN_REFTYPE_FUNCTION) == 0) hparse_f_error();
-        if (hparse_errno > 0) return;
-      }
-      else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "STATUS") == 1)
-      {
-        hparse_f_like_or_where();
-        if (hparse_errno > 0) return;
-      }
-    }
-    else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "GLOBAL") == 1) /* show global ... */
-    {
-      if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "STATUS") == 1)
-      {
-        hparse_f_like_or_where();
-        if (hparse_errno > 0) return;
-      }
-      else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "VARIABLES") == 1)
-      {
-        hparse_f_like_or_where();
-        if (hparse_errno > 0) return;
-      }
-      else hparse_f_error();
-      if (hparse_errno > 0) return;
-    }
-    else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "GRANTS") == 1) /* show grants */
-    {
-      if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "FOR") == 1)
-      {
-        if (hparse_f_user_name() == 0) hparse_f_error();
-        if (hparse_errno > 0) return;
-      }
-    }
-    else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "INDEX") == 1) /* show index */
-    {
-      hparse_f_indexes_or_keys();
-      if (hparse_errno > 0) return;
-    }
-    else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "INDEXES") == 1) /* show indexes */
-    {
-      hparse_f_indexes_or_keys();
-      if (hparse_errno > 0) return;
-    }
-    else if (((hparse_dbms_mask & FLAG_VERSION_MARIADB_ALL) != 0) && (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "INDEX_STATISTICS") == 1))
-    {
-      ;
-    }
-    else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "KEYS") == 1) /* show keys */
-    {
-      hparse_f_indexes_or_keys();
-      if (hparse_errno > 0) return;
-    }
-    else if (((hparse_dbms_mask & FLAG_VERSION_MARIADB_ALL) != 0) && (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "LOCALES") == 1))
-    {
-      ;
-    }
-    else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "MASTER") == 1) /* show master [status|logs\ */
-    {
-      if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "STATUS") == 0)
-      {
-        hparse_f_expect(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "LOGS");
-      }
-      if (hparse_errno > 0) return;
-    }
-    else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "OPEN") == 1) /* show open [tables] */
-    {
-      hparse_f_expect(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "TABLES");
-      if (hparse_errno > 0) return;
-      hparse_f_from_or_like_or_where();
-      if (hparse_errno > 0) return;
-    }
-    else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "PLUGINS") == 1) /* show plugins */
-    {
-      if (((hparse_dbms_mask & FLAG_VERSION_MARIADB_ALL) != 0) && (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "SONAME") == 1))
-      {
-        if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_LITERAL, "[literal]") == 1) {;}
-        else hparse_f_from_or_like_or_where();
-        if (hparse_errno > 0) return;
-      }
-    }
-    else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "PRIVILEGES") == 1) /* show privileges */
-    {
-      ;
-    }
-    else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "PROCEDURE") == 1) /* show procedure [code|status] */
-    {
-      if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "CODE") == 1)
-      {
-        if (hparse_f_qualified_name_of_object(TOKEN_REFTYPE_DATABASE_OR_PROCEDURE, TOKEN_REFTYPE_PROCEDURE) == 0) hparse_f_error();
-        if (hparse_errno > 0) return;
-      }
-      else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "STATUS") == 1)
-      {
-        hparse_f_like_or_where();
-        if (hparse_errno > 0) return;
-      }
-    }
-    else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "PROCESSLIST") == 1) /* show processlist */
-    {
-      ;
-    }
-    else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "PROFILE") == 1) /* show profile */
-    {
-      for (;;)
-      {
-        if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "ALL") == 1) {;}
-        else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "BLOCK") == 1)
-        {
-          hparse_f_expect(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "IO");
-          if (hparse_errno > 0) return;
-        }
-        else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "ALL") == 1) {;}
-        else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "BLOCK_IO") == 1) {;}
-        else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "CONTEXT") == 1)
-        {
-          hparse_f_expect(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "SWITCHES");
-          if (hparse_errno > 0) return;
-        }
-        else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "CPU") == 1) {;}
-        else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "IPC") == 1) {;}
-        else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "MEMORY") == 1) {;}
-        else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "PAGE") == 1)
-        {
-          hparse_f_expect(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "FAULTS");
-          if (hparse_errno > 0) return;
-        }
-        else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "SOURCE") == 1) {;}
-        else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "SWAPS") == 1) {;}
-        else break;
-        if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_OPERATOR, ",") == 1) continue;
-        break;
-      }
-      if (hparse_errno > 0) return;
-      if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "FOR") == 1)
-      {
-        hparse_f_expect(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "QUERY");
-        if (hparse_errno > 0) return;
-        if (hparse_f_literal() == 0) hparse_f_error();
-        if (hparse_errno > 0) return;
-      }
-      hparse_f_limit(TOKEN_KEYWORD_SHOW);
-      if (hparse_errno > 0) return;
-    }
-    else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "PROFILES") == 1) /* show profiles */
-    {
-      ;
-    }
-    else if (((hparse_dbms_mask & FLAG_VERSION_MARIADB_ALL) != 0) && (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "QUERY_RESPONSE_TIME") == 1))
-    {
-      ;
-    }
-    else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "RELAYLOG") == 1) /* show relaylog */
-    {
-      if ((hparse_dbms_mask & FLAG_VERSION_MARIADB_ALL) != 0) hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_LITERAL, "[literal]");
-      hparse_f_expect(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "EVENTS");
-      if (hparse_errno > 0) return;
-      if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "IN") == 1)
-      {
-        main_token_flags[hparse_i_of_last_accepted] &= (~TOKEN_FLAG_IS_FUNCTION);
-        if (hparse_f_literal() == 0) hparse_f_error();
-        if (hparse_errno > 0) return;
-      }
-      if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "FROM") == 1)
-      {
-        if (hparse_f_literal() == 0) hparse_f_error();
-        if (hparse_errno > 0) return;
-      }
-      hparse_f_limit(TOKEN_KEYWORD_SHOW);
-      if (hparse_errno > 0) return;
-    }
-    else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "SCHEMAS") == 1) /* show schemas */
-    {
-      hparse_f_like_or_where();
-      if (hparse_errno > 0) return;
-    }
-    else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "SESSION") == 1) /* show session ... */
-    {
-      if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "STATUS") == 1)
-      {
-        hparse_f_like_or_where();
-        if (hparse_errno > 0) return;
-      }
-      else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "VARIABLES") == 1)
-      {
-        hparse_f_like_or_where();
-        if (hparse_errno > 0) return;
-      }
-      else hparse_f_error();
-      if (hparse_errno > 0) return;
-    }
-    else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "SLAVE") == 1) /* show slave */
-    {
-      if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "HOSTS") == 1) {;}
-      else
-      {
-        if ((hparse_dbms_mask & FLAG_VERSION_MARIADB_ALL) != 0) hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_LITERAL, "[literal]");
-        hparse_f_expect(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "STATUS");
-        if (hparse_errno > 0) return;
-        if ((hparse_dbms_mask & FLAG_VERSION_MYSQL_ALL) != 0)
-        {
-          if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "NONBLOCKING") == 1) {;}
-          hparse_f_for_channel();
-          if (hparse_errno > 0) return;
-        }
-      }
-    }
-    else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "STATUS") == 1) /* show status */
-    {
-      hparse_f_like_or_where();
-      if (hparse_errno > 0) return;
-    }
-    else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "STORAGE") == 1) /* show storage */
-    {
-      hparse_f_expect(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "ENGINES");
-      if (hparse_errno > 0) return;
-    }
-    else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "TABLE") == 1) /* show table */
-    {
-      hparse_f_expect(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "STATUS");
-      if (hparse_errno > 0) return;
-      hparse_f_from_or_like_or_where();
-      if (hparse_errno > 0) return;
-    }
-    else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "TABLES") == 1) /* show tables */
-    {
-      hparse_f_from_or_like_or_where();
-      if (hparse_errno > 0) return;
-    }
-    else if (((hparse_dbms_mask & FLAG_VERSION_MARIADB_ALL) != 0) && (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "TABLE_STATISTICS") == 1))
-    {
-      ;
-    }
-    else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "TRIGGERS") == 1) /* show triggers */
-    {
-      hparse_f_from_or_like_or_where();
-      if (hparse_errno > 0) return;
-    }
-    else if (((hparse_dbms_mask & FLAG_VERSION_MARIADB_ALL) != 0) && (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "USER_STATISTICS") == 1))
-    {
-      ;
-    }
-    else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "VARIABLES") == 1) /* show variables */
-    {
-      hparse_f_like_or_where();
-      if (hparse_errno > 0) return;
-    }
-    else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "WARNINGS") == 1) /* show warnings */
-    {
-      hparse_f_limit(TOKEN_KEYWORD_SHOW);
-      if (hparse_errno > 0) return;
-    }
-    else if (((hparse_dbms_mask & FLAG_VERSION_MARIADB_ALL) != 0) && (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "WSREP_MEMBERSHIP") == 1))
-    {
-      ;
-    }
-    else if (((hparse_dbms_mask & FLAG_VERSION_MARIADB_ALL) != 0) && (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "WSREP_STATUS") == 1))
-    {
-      ;
-    }
-    else hparse_f_error();
-  }
-  else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_KEYWORD_SHUTDOWN, "SHUTDOWN"))
-  {
-    hparse_statement_type= TOKEN_KEYWORD_SHUTDOWN;
-    main_token_flags[hparse_i_of_last_accepted] |= TOKEN_FLAG_IS_START_STATEMENT;
-    return;
-  }
-  else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_KEYWORD_SIGNAL, "SIGNAL"))
-  {
-    hparse_statement_type= TOKEN_KEYWORD_SIGNAL;
-    main_token_flags[hparse_i_of_last_accepted] |= TOKEN_FLAG_IS_START_STATEMENT;
-    if (hparse_f_signal_or_resignal(TOKEN_KEYWORD_SIGNAL, block_top) == 0) hparse_f_error();
-    if (hparse_errno > 0) return;
-  }
-  else if (((hparse_dbms_mask & FLAG_VERSION_MARIADB_ALL) != 0) && (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_KEYWORD_SONAME, "SONAME") == 1))
-  {
-    hparse_statement_type= TOKEN_KEYWORD_SONAME;
-    main_token_flags[hparse_i_of_last_accepted] |= TOKEN_FLAG_IS_START_STATEMENT;
-    if (hparse_f_literal() == 0) hparse_f_error();
-    if (hparse_errno > 0) return;
-  }
-  else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_KEYWORD_START, "START"))
-  {
-    hparse_statement_type= TOKEN_KEYWORD_START;
-    main_token_flags[hparse_i_of_last_accepted] |= TOKEN_FLAG_IS_START_STATEMENT;
-    if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "TRANSACTION") == 1)
-    {
-      if (hparse_errno > 0) return;
-      bool with_seen= false, read_seen= false;
-      do
-      {
-        if ((with_seen == false) && (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "WITH")))
-        {
-          with_seen= true;
-          hparse_f_expect(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "CONSISTENT");
-          if (hparse_errno > 0) return;
-          hparse_f_expect(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "SNAPSHOT");
-          if (hparse_errno > 0) return;
-        }
-        if ((read_seen == false) && (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "READ")))
-        {
-          read_seen= true;
-          if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "ONLY") == 1) ;
-          else hparse_f_expect(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "WRITE");
-          if (hparse_errno > 0) return;
-        }
-      } while (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_OPERATOR, ","));
-    }
-    else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "GROUP_REPLICATION") == 1) {;}
-    else if (((hparse_dbms_mask & FLAG_VERSION_MARIADB_ALL) != 0) && (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "ALL") == 1))
-    {
-      hparse_f_expect(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "SLAVES");
-      if (hparse_errno > 0) return;
-      do
-      {
-        if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "IO_THREAD") == 1) {;}
-        else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "SQL_THREAD") == 1) {;}
-      } while (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_OPERATOR, ","));
-    }
-    else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "SLAVE") == 1)
-    {
-      if ((hparse_dbms_mask & FLAG_VERSION_MARIADB_ALL) != 0) hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_LITERAL, "[literal]");
-      do
-      {
-        if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "IO_THREAD") == 1) {;}
-        else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "SQL_THREAD") == 1) {;}
-      } while (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_OPERATOR, ","));
-      if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "UNTIL") == 1)
+        if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "IO_THREAD") == 1) {;}
+        else if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "SQL_THREAD") == 1) {;}
+      } while (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_OPERATOR, ","));
+      if (hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "UNTIL") == 1)
       {
         if (((hparse_dbms_mask & FLAG_VERSION_MYSQL_ALL) != 0)
          && ((hparse_f_accept(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_KEYWORD, "SQL_BEFORE_GTIDS") == 1)
@@ -9952,7 +9927,7 @@ int MainWindow::hparse_f_conditions(int block_top)
 void MainWindow::hparse_f_multi_block(QString text)
 {
   log("hparse_f_multi_block start", 90);
-  hparse_line_edit->hide();
+  hparse_hint= "";
   if (connections_is_connected[0] == 1) hparse_dbms_mask= dbms_version_mask;
   else if (ocelot_dbms == "mariadb") hparse_dbms_mask= FLAG_VERSION_MARIADB_ALL;
   else if (ocelot_dbms == "mysql") hparse_dbms_mask= FLAG_VERSION_MYSQL_ALL;
@@ -9962,6 +9937,7 @@ void MainWindow::hparse_f_multi_block(QString text)
   else hparse_dbms_mask= FLAG_VERSION_MYSQL_OR_MARIADB_ALL;
   hparse_i= -1;
   hparse_delimiter_str= ocelot_delimiter_str;
+  hparse_f_statement_cache_start(text);
   for (;;)
   {
     hparse_statement_type= -1;
@@ -9985,15 +9961,23 @@ void MainWindow::hparse_f_multi_block(QString text)
     hparse_i_of_last_accepted= 0;
     if (hparse_i == -1) hparse_f_nexttoken();
     hparse_i_of_statement= hparse_i;
-    if (hparse_f_client_statement() == 1)
+    if (hparse_f_statement_cache_restore() == true)
     {
       if (main_token_lengths[hparse_i] == 0) return; /* empty token marks end of input */
-      if ((hparse_prev_token != ";") && (hparse_prev_token != hparse_delimiter_str))
+      continue;
+    }
+    if (hparse_f_client_statement() == 1)
+    {
+      if (main_token_lengths[hparse_i] != 0)
       {
-        hparse_f_semicolon_and_or_delimiter(0);
-        if (hparse_errno > 0) goto error;
-        if (main_token_lengths[hparse_i] == 0) return;
+        if ((hparse_prev_token != ";") && (hparse_prev_token != hparse_delimiter_str))
+        {
+          hparse_f_semicolon_and_or_delimiter(0);
+          if (hparse_errno > 0) goto error;
+        }
       }
+      hparse_f_statement_cache_save();
+      if (main_token_lengths[hparse_i] == 0) return; /* empty token marks end of input */
       continue; /* ?? rather than "return"? */
     }
     if (hparse_errno > 0) goto error;
@@ -10027,12 +10011,14 @@ void MainWindow::hparse_f_multi_block(QString text)
     //hparse_f_expect(FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_REFTYPE_ANY,TOKEN_TYPE_OPERATOR, "[eof]");
     if (hparse_errno > 0) goto error;
     if (hparse_i > 0) main_token_flags[hparse_i - 1]= (main_token_flags[hparse_i - 1] | TOKEN_FLAG_IS_BLOCK_END);
+    hparse_f_statement_cache_save();
     if (main_token_lengths[hparse_i] == 0) return; /* empty token marks end of input */
   }
   log("hparse_f_multi_block end", 90);
   return;
 error:
   log("hparse_f_multi_block error", 90);
+  if (hparse_is_cancelled) return;
   QString expected_list;
   bool unfinished_comment_seen= false;
   bool unfinished_identifier_seen= false;
@@ -10130,10 +10116,179 @@ error:
     }
   }
 
-  hparse_line_edit->setText(expected_list);
+  hparse_hint= expected_list;
+  log("hparse_f_multi_block end", 90);
+}
+
+
+/*
+  The statement cache.
+  Usually the user changes one statement, so parsing all the others
+  again would be a waste. For each statement that hparse_f_multi_block()
+  gets through without error, hparse_f_statement_cache_save() keeps
+  what hparse did to main_token_types|flags|reftypes. Next time,
+  hparse_f_statement_cache_restore() finds the statement if its tokens
+  are the same (and the delimiter and dbms are the same), and puts the
+  results back instead of parsing.
+  The key is a hash of the statement's first "segment", i.e. up to and
+  including the first ";" or delimiter -- that's the statement boundary,
+  except for compound statements, so we check a hash of all the tokens
+  too. Hashes are of the tokens before hparse changes them, which is
+  why hparse_f_statement_cache_start() makes hparse_token_hashes[].
+  A statement that changes the delimiter isn't cached, and statements
+  after it will have different keys, so they'll be parsed again.
+  A statement with an error isn't cached, parsing stops there anyway.
+  Entries that weren't used are dropped at the start of the next parse,
+  unless the parse didn't reach the end.
+*/
+#define HPARSE_STATEMENT_CACHE_MAX 10000
+void MainWindow::hparse_f_statement_cache_start(QString text)
+{
+  if ((hparse_statement_cache_is_partial == false)
+   || (hparse_statement_cache_previous.size() > HPARSE_STATEMENT_CACHE_MAX))
+  {
+    hparse_statement_cache_previous= hparse_statement_cache;
+  }
+  else
+  {
+    QHash<unsigned int, hparse_statement_cache_entry>::const_iterator it;
+    for (it= hparse_statement_cache.constBegin(); it != hparse_statement_cache.constEnd(); ++it)
+      hparse_statement_cache_previous.insert(it.key(), it.value());
+  }
+  hparse_statement_cache.clear();
+  hparse_statement_cache_is_partial= true;
+  if (main_token_max_count > hparse_token_hashes_max_count)
+  {
+    if (hparse_token_hashes_max_count != 0) delete [] hparse_token_hashes;
+    hparse_token_hashes_max_count= main_token_max_count;
+    hparse_token_hashes= new unsigned int[hparse_token_hashes_max_count];
+  }
+  hparse_f_statement_cache_hash_tokens(text, 0);
+}
+
+/* FNV-1a of token text, type, flags, and whether there's space before it */
+void MainWindow::hparse_f_statement_cache_hash_tokens(QString text, int start)
+{
+  const QChar *text_data= text.constData();
+  for (int i= start; main_token_lengths[i] != 0; ++i)
+  {
+    unsigned int h= 2166136261U;
+    const QChar *p= text_data + main_token_offsets[i];
+    for (int j= 0; j < main_token_lengths[i]; ++j) h= (h ^ p[j].unicode()) * 16777619U;
+    h= (h ^ (unsigned int) main_token_types[i]) * 16777619U;
+    h= (h ^ main_token_flags[i]) * 16777619U;
+    if ((i > 0) && (main_token_offsets[i] != main_token_offsets[i - 1] + main_token_lengths[i - 1]))
+      h= (h ^ 1) * 16777619U;
+    hparse_token_hashes[i]= h;
+  }
+}
+
+/* How many tokens up to and including the first ";" or delimiter */
+int MainWindow::hparse_f_statement_cache_segment(int start)
+{
+  int delimiter_size= hparse_delimiter_str.size();
+  int i;
+  for (i= start; main_token_lengths[i] != 0; ++i)
+  {
+    if ((main_token_lengths[i] == 1) && (hparse_text_copy.at(main_token_offsets[i]) == ';')) return i - start + 1;
+    if ((main_token_lengths[i] == delimiter_size)
+     && (hparse_text_copy.mid(main_token_offsets[i], delimiter_size) == hparse_delimiter_str)) return i - start + 1;
+  }
+  return i - start;
+}
+
+unsigned int MainWindow::hparse_f_statement_cache_key(int start, int count)
+{
+  unsigned int h= 2166136261U;
+  for (int j= 0; j < hparse_delimiter_str.size(); ++j) h= (h ^ hparse_delimiter_str.at(j).unicode()) * 16777619U;
+  h= (h ^ hparse_dbms_mask) * 16777619U;
+  h= (h ^ (unsigned int) hparse_sql_mode_ansi_quotes) * 16777619U;
+  for (int i= start; i < start + count; ++i) h= (h ^ hparse_token_hashes[i]) * 16777619U;
+  return h;
+}
+
+/* Called with hparse_i = the first token of a statement. If it's cached, skip it. */
+bool MainWindow::hparse_f_statement_cache_restore()
+{
+  int start= hparse_i;
+  hparse_statement_cache_delimiter= hparse_delimiter_str;
+  if (hparse_is_cancelled) return false;
+  if (main_token_lengths[start] == 0) return false;
+#ifdef DBMS_TARANTOOL
+  if ((hparse_dbms_mask & FLAG_VERSION_TARANTOOL) != 0) return false;
+#endif
+  unsigned int key= hparse_f_statement_cache_key(start, hparse_f_statement_cache_segment(start));
+  QHash<unsigned int, hparse_statement_cache_entry>::const_iterator it;
+  it= hparse_statement_cache.constFind(key);
+  if (it == hparse_statement_cache.constEnd())
+  {
+    it= hparse_statement_cache_previous.constFind(key);
+    if (it == hparse_statement_cache_previous.constEnd()) return false;
+  }
+  hparse_statement_cache_entry entry= it.value();
+  int count= entry.token_count;
+  if ((unsigned int) (start + count) > main_token_count_in_all) return false;
+  for (int i= start; i < start + count; ++i) if (main_token_lengths[i] == 0) return false;
+  if (hparse_f_statement_cache_key(start, count) != entry.hash) return false;
+  const char *results= entry.results.constData();
+  memcpy(&main_token_types[start], results, count * sizeof(int));
+  results+= count * sizeof(int);
+  memcpy(&main_token_flags[start], results, count * sizeof(unsigned int));
+  results+= count * sizeof(unsigned int);
+  memcpy(&main_token_reftypes[start], results, count * sizeof(unsigned char));
+  hparse_statement_cache.insert(key, entry);
+  /* As if we'd parsed it: hparse_i is the first token of the next statement */
+  hparse_i= start + count - 1;
+  hparse_f_nexttoken();
+  if (main_token_lengths[hparse_i] == 0) hparse_statement_cache_is_partial= false;
+  return true;
+}
+
+/* Called after a statement was parsed without error. */
+void MainWindow::hparse_f_statement_cache_save()
+{
+  int start= hparse_i_of_statement;
+  int count= hparse_i - start;
+  if (main_token_lengths[hparse_i] == 0) hparse_statement_cache_is_partial= false;
+  if (hparse_delimiter_str != hparse_statement_cache_delimiter)
+  {
+    /* DELIMITER re-tokenized everything after it, see hparse_f_client_statement() */
+    hparse_f_statement_cache_hash_tokens(hparse_text_copy, hparse_i);
+    return;
+  }
+  if ((start < 0) || (count <= 0)) return;
+#ifdef DBMS_TARANTOOL
+  if ((hparse_dbms_mask & FLAG_VERSION_TARANTOOL) != 0) return;
+#endif
+  hparse_statement_cache_entry entry;
+  entry.hash= hparse_f_statement_cache_key(start, count);
+  entry.token_count= count;
+  entry.results.resize(count * (sizeof(int) + sizeof(unsigned int) + sizeof(unsigned char)));
+  char *results= entry.results.data();
+  memcpy(results, &main_token_types[start], count * sizeof(int));
+  results+= count * sizeof(int);
+  memcpy(results, &main_token_flags[start], count * sizeof(unsigned int));
+  results+= count * sizeof(unsigned int);
+  memcpy(results, &main_token_reftypes[start], count * sizeof(unsigned char));
+  hparse_statement_cache.insert(hparse_f_statement_cache_key(start, hparse_f_statement_cache_segment(start)), entry);
+}
+
+
+/*
+  hparse_f_multi_block() only says what the hint is, it might be running
+  in the background. This puts it in hparse_line_edit, or hides it if
+  there's no hint, in the GUI thread.
+*/
+void MainWindow::hparse_f_show_hint()
+{
+  if (hparse_hint == "")
+  {
+    hparse_line_edit->hide();
+    return;
+  }
+  hparse_line_edit->setText(hparse_hint);
   hparse_line_edit->setCursorPosition(0);
   hparse_line_edit->show();
-  log("hparse_f_multi_block end", 90);
 }
 
 #ifdef DBMS_TARANTOOL
@@ -10409,6 +10564,21 @@ int MainWindow::hparse_f_client_statement()
   else if ((slash_token == TOKEN_KEYWORD_PAGER) || (hparse_f_accept(FLAG_VERSION_ALL, TOKEN_REFTYPE_ANY,TOKEN_KEYWORD_PAGER, "PAGER") == 1))
   {
     if (slash_token <= 0) main_token_flags[hparse_i_of_last_accepted] |= TOKEN_FLAG_IS_START_STATEMENT;
+    /* PAGER can be followed by a command e.g. less -S, as far as ; or delimiter or eof or \n. Compare PROMPT. */
+    QString d;
+    int j;
+    for (;;)
+    {
+      j= main_token_offsets[hparse_i - 1] + main_token_lengths[hparse_i - 1];
+      d= hparse_text_copy.mid(j, main_token_offsets[hparse_i]- j);
+      if (d.contains("\n")) break;
+      if ((main_token_lengths[hparse_i] == 0)
+       || (hparse_token == hparse_delimiter_str)) break;
+      main_token_flags[hparse_i] &= (~TOKEN_FLAG_IS_RESERVED);
+      main_token_flags[hparse_i] &= (~TOKEN_FLAG_IS_FUNCTION);
+      main_token_types[hparse_i]= TOKEN_TYPE_OTHER;
+      hparse_f_nexttoken();
+    }
   }
   else if ((slash_token == TOKEN_KEYWORD_PRINT) || (hparse_f_accept(FLAG_VERSION_ALL, TOKEN_REFTYPE_ANY,TOKEN_KEYWORD_PRINT, "PRINT") == 1))
   {
@@ -10624,6 +10794,12 @@ int MainWindow::hparse_f_client_statement()
     {
       ;
     }
+    else if (hparse_f_acceptn(TOKEN_TYPE_KEYWORD, "$BENCH", 6) == 1)
+    {
+      /* $BENCH [n=count] [concurrency=count] statement, see bench_run() */
+      hparse_f_other(1);
+      if (hparse_errno > 0) return 0;
+    }
     else if (hparse_f_acceptn(TOKEN_KEYWORD_DEBUG_LEAVE, "$LEAVE", 2) == 1)
     {
       ;
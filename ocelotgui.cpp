@@ -206,7 +206,10 @@
 #define MYSQL_DEBUGGER_CONNECTION 1
 #define MYSQL_KILL_CONNECTION 2
 #define MYSQL_REMOTE_CONNECTION 3
-#define MYSQL_MAX_CONNECTIONS 4
+#define MYSQL_PROFILE_CONNECTION 4  /* see profile_capture() */
+#define MYSQL_SOURCE_PARALLEL_CONNECTION 5 /* first of SOURCE_PARALLEL_MAX, see source_parallel_run() */
+#define SOURCE_PARALLEL_MAX 8
+#define MYSQL_MAX_CONNECTIONS (MYSQL_SOURCE_PARALLEL_CONNECTION + SOURCE_PARALLEL_MAX)
 
 #include "ostrings.h"
 #include "ocelotgui.h"
@@ -325,6 +328,15 @@
   static unsigned short int ocelot_grid_tabs= 16;
   static unsigned short int ocelot_grid_actual_tabs= 0; /* Todo: move this, it's not an option. */
   static unsigned short int ocelot_client_side_functions= 1;
+  static unsigned int ocelot_grid_lazy_blob_length= 0; /* 0 = get all of every BLOB|TEXT, see lazy_blob_rewrite() */
+  static QString ocelot_export_format= "";  /* '' or csv|tsv|jsonl|insert|html|xml, see export_result_set() */
+  static QString ocelot_export_file= "";    /* file name, or |command for popen() */
+  static bool ocelot_pager_is_on= false;   /* PAGER turns on, NOPAGER turns off, command is ocelot_pager */
+  static unsigned int ocelot_history_max_result_bytes= 1048576; /* budget for result sets in history, see copy_to_history() */
+  static unsigned int ocelot_source_batch_size= 0; /* statements per multi-statement batch for SOURCE, 0 or 1 = no batching */
+  static unsigned short ocelot_statement_timing= 0; /* 1 = time each statement's phases, 2 = and put them in history */
+  static unsigned int ocelot_prepared_statement_cache= 0; /* prepared statements kept per connection, 0 = none */
+  static unsigned short ocelot_statement_profile= 0; /* 1 = show server-side profile of each statement */
 
   /* Some items we allow, but the reasons we allow them are lost in the mists of time */
   /* I gather that one is supposed to read the charset file. I don't think we do. */
@@ -406,6 +418,10 @@
   static bool hparse_sql_mode_ansi_quotes= false;
   static unsigned short int hparse_dbms_mask= FLAG_VERSION_MYSQL_OR_MARIADB_ALL;
 
+static bool keyword_hash_table_make();
+
+/* bench/bench_tokenize.cpp includes this file and has its own main() */
+#ifndef OCELOTGUI_NO_MAIN
 int main(int argc, char *argv[])
 {
     QApplication main_application(argc, argv);
@@ -414,6 +430,7 @@ int main(int argc, char *argv[])
     w.showMaximized();
     return main_application.exec();
 }
+#endif
 
 
 MainWindow::MainWindow(int argc, char *argv[], QWidget *parent) :
@@ -423,11 +440,18 @@ MainWindow::MainWindow(int argc, char *argv[], QWidget *parent) :
   /* Maximum QString length = sizeof(int)/4. Maximum LONGBLOB length = 2**32. So 32 bit int is ok. */
   assert(sizeof(int) >= 4);
 
+  /* Here, before any thread that could tokenize has started. */
+  if (keyword_hash_table_make() == false)
+  {
+    fprintf(stderr, "ocelotgui: strvalues[] is out of order or doesn't match TOKEN_KEYWORD_..., see keyword_hash_table_make()\n");
+    exit(1);
+  }
+
   /* Initialization */
 
   main_window_maximum_width= 0;
   main_window_maximum_height= 0;
-  main_token_max_count= 0;
+  main_token_use();
 
   /*
     setupUi() is in ui_ocelotgui.h, which is generated by a tool named "uic",
@@ -454,6 +478,9 @@ MainWindow::MainWindow(int argc, char *argv[], QWidget *parent) :
 
   connections_is_connected[0]= 0;
   mysql_res= 0;
+  is_headless= false;
+  history_result_bytes= 0;
+  history_result_next_id= 1;
 
   /* client variable defaults */
   /* Most settings done here might be overridden when connect_mysql_options_2 reads options. */
@@ -592,6 +619,12 @@ MainWindow::MainWindow(int argc, char *argv[], QWidget *parent) :
     action_connect();
   }
 
+  if ((ocelot_execute != "")
+   && ((ocelot_batch != 0) || (ocelot_html != 0) || (ocelot_xml != 0)))
+  {
+    run_headless();
+  }
+
   statement_edit_widget->setFocus(); /* Show user we're ready to accept a statement in the statement edit widget */
 
 }
@@ -599,6 +632,9 @@ MainWindow::MainWindow(int argc, char *argv[], QWidget *parent) :
 
 MainWindow::~MainWindow()
 {
+  hparse_background_cancel();
+  profile_stop();                    /* before the executors go, it uses MYSQL_PROFILE_CONNECTION's */
+  dbms_executors_stop();
   delete ui;
 }
 
@@ -671,8 +707,29 @@ void MainWindow::initialize_widget_statement()
 
   statement_edit_widget->setLineWrapMode(QPlainTextEdit::NoWrap);
   /* statement_edit_widget->setAcceptRichText(false); */ /* Todo: test whether this works */
+  connect(statement_edit_widget->document(), SIGNAL(contentsChange(int,int,int)), this, SLOT(action_statement_edit_widget_contents_change(int,int,int)));
   connect(statement_edit_widget->document(), SIGNAL(contentsChanged()), this, SLOT(action_statement_edit_widget_text_changed()));
   statement_edit_widget_text_changed_flag= 0;
+  editor_token_use();
+  editor_token_is_valid= false;
+  editor_token_has_version_comment= false;
+  editor_change_position= -1;
+  editor_token_highlights= 0;
+  editor_token_highlights_count= 0;
+  statement_highlight_colors= "";
+  statement_highlight_dirty_start= 1;
+  statement_highlight_dirty_end= 0;
+  statement_highlighter= new StatementHighlighter(statement_edit_widget->document(), this);
+  connect(statement_edit_widget->verticalScrollBar(), SIGNAL(valueChanged(int)), this, SLOT(statement_highlight_visible(int)));
+  hparse_hint= "";
+  hparse_is_cancelled= false;
+  hparse_background_state= HPARSE_BACKGROUND_IDLE;
+  hparse_background_generation= 0;
+  hparse_background_timer= new QTimer(this);
+  hparse_background_timer->setSingleShot(true);
+  connect(hparse_background_timer, SIGNAL(timeout()), this, SLOT(hparse_background_start()));
+  hparse_token_hashes_max_count= 0;
+  hparse_statement_cache_is_partial= false;
 
   /*
     Defaults.
@@ -742,6 +799,7 @@ void MainWindow::statement_edit_widget_setstylesheet()
 void MainWindow::statement_edit_widget_formatter()
 {
   if (((ocelot_statement_syntax_checker.toInt()) & FLAG_FOR_HIGHLIGHTS) == 0) return;
+  hparse_background_finish();
 
   int *output_offsets;
   int i;
@@ -1097,6 +1155,7 @@ bool MainWindow::eventfilter_function(QObject *obj, QEvent *event)
 
   if ((key->key() == Qt::Key_Tab) && (ocelot_auto_rehash > 0))
   {
+    hparse_background_finish();
     if (hparse_line_edit->isHidden() == false)
     {
       if (statement_edit_widget->hasFocus() == true)
@@ -1284,6 +1343,7 @@ bool MainWindow::is_statement_complete(QString text)
   ocelot_history_font_family|size|style|weight     default = system
   ocelot_history_includes_warnings                 default = 0 (no)
   ocelot_history_max_row_count                     default = 0 (suppressed)
+  ocelot_history_max_result_bytes                  default = 1048576
 
   The statement is always followed by an error message,
   but ocelot_history_includes_warnings is affected by ...
@@ -1378,6 +1438,7 @@ void MainWindow::initialize_widget_history()
   history_edit_widget->setReadOnly(false);       /* if history shouldn't be editable, set to "true" here */
   history_edit_widget->hide();                   /* hidden until a statement is executed */
   history_markup_make_strings();
+  connect(history_edit_widget->verticalScrollBar(), SIGNAL(valueChanged(int)), this, SLOT(history_result_expand(int)));
   return;
 }
 
@@ -1403,7 +1464,7 @@ void MainWindow::history_markup_make_strings()
 /* It seems to work except that the prompt is not right-justified. */
 /* is_interactive == false if we're reading from mysql_histfile during start */
 /* Todo: right justify. Make it optional to show the prompt, unless prompt can be hidden. */
-void MainWindow::history_markup_append(QString result_set_for_history, bool is_interactive)
+void MainWindow::history_markup_append(QByteArray result_set_for_history, bool is_interactive)
 {
   QString plainTextEditContents;
   QStringList statement_lines;
@@ -1436,15 +1497,40 @@ void MainWindow::history_markup_append(QString result_set_for_history, bool is_i
   if (is_interactive == true)
     history_statement.append(history_markup_copy_for_history(statement_edit_widget->result)); /* the main "OK" or error message */
   else history_statement.append("--");
-  if (result_set_for_history > "")
+  unsigned int result_set_id= 0;
+  if (result_set_for_history.isEmpty() == false)
   {
+    /* Only a marker goes in the document. history_result_expand() replaces it. */
+    result_set_id= history_result_add(result_set_for_history);
     history_statement.append("<pre>");
-    history_statement.append(result_set_for_history);
+    history_statement.append("[result set #" + QString::number(result_set_id) + "]");
     history_statement.append("<//pre>");
   }
   history_statement.append(history_markup_statement_end);
 
+  int position_before_append= history_edit_widget->document()->characterCount();
   history_edit_widget->append(history_statement);
+  if (result_set_id != 0)
+  {
+    /*
+      The marker's block gets userState() == id, and that's what
+      history_result_expand() looks for, so text that happens to look
+      like a marker, in a statement or a result, isn't replaced.
+      We only look at what was just appended.
+    */
+    QString marker= "[result set #" + QString::number(result_set_id) + "]";
+    for (QTextBlock block= history_edit_widget->document()->lastBlock();
+         (block.isValid()) && (block.position() + block.length() > position_before_append);
+         block= block.previous())
+    {
+      if (block.text() == marker)
+      {
+        block.setUserState((int) result_set_id);
+        break;
+      }
+    }
+  }
+  if (history_edit_widget->isVisible()) history_result_expand(0);
 
   history_markup_counter= 0;
 
@@ -1454,8 +1540,344 @@ void MainWindow::history_markup_append(QString result_set_for_history, bool is_i
   history_file_write("TEE", query_utf16);
   history_file_write("HIST", query_utf16);
   history_file_write("TEE", statement_edit_widget->result);
-  if (result_set_for_history > "")
-    history_file_write("TEE", result_set_for_history);
+  if ((result_set_id != 0) && (ocelot_history_tee_file_is_open == true))
+    history_file_write("TEE", history_result_render(result_set_for_history));
+}
+
+
+/*
+  Result sets in history.
+  copy_to_history() gives a compact snapshot, not text. We keep snapshots
+  in a ring (history_result_snapshots) and put a "[result set #id]" marker
+  in the history widget, in a block whose userState() is id. When the user scrolls (or when history_markup_append()
+  happens while history is visible) history_result_expand() replaces
+  markers that are on the screen with history_result_render() text.
+  Snapshots and rendered text both count against
+  ocelot_history_max_result_bytes. When it's exceeded the oldest goes
+  first: a snapshot is dropped, and its marker says so when it is seen;
+  rendered text is replaced by the same message, which we can find
+  because we keep a QTextCursor whose selection is the rendered text
+  (Qt moves kept cursors when the document changes).
+  Thus a big ocelot_history_max_row_count costs memcpy, not formatting,
+  and never more than ocelot_history_max_result_bytes.
+*/
+unsigned int MainWindow::history_result_add(QByteArray snapshot)
+{
+  unsigned int id= 0;
+  if (snapshot.isEmpty() == false)
+  {
+    id= history_result_next_id++;
+    history_result_snapshots.append(snapshot);
+    history_result_ids.append(id);
+    history_result_bytes+= snapshot.size();
+  }
+  history_result_trim();
+  return id;
+}
+
+/* Drop the oldest snapshot or rendered result till we're within ocelot_history_max_result_bytes. */
+void MainWindow::history_result_trim()
+{
+  while (history_result_bytes > ocelot_history_max_result_bytes)
+  {
+    bool is_snapshot= (history_result_ids.count() > 0);
+    bool is_rendered= (history_result_rendered_ids.count() > 0);
+    if ((is_snapshot == false) && (is_rendered == false)) break;
+    if ((is_snapshot == true) && (is_rendered == true))
+      is_rendered= (history_result_rendered_ids.at(0) < history_result_ids.at(0));
+    if (is_rendered == false)
+    {
+      history_result_bytes-= history_result_snapshots.at(0).size();
+      history_result_snapshots.removeFirst();
+      history_result_ids.removeFirst();
+      continue;
+    }
+    QTextCursor text_cursor= history_result_rendered_cursors.at(0);
+    /* If the history was cleared there's no selection and nothing to replace */
+    if (text_cursor.hasSelection())
+    {
+      history_edit_widget->verticalScrollBar()->blockSignals(true);
+      text_cursor.insertText("[result set #" + QString::number(history_result_rendered_ids.at(0))
+                             + " discarded, see ocelot_history_max_result_bytes]");
+      history_edit_widget->verticalScrollBar()->blockSignals(false);
+    }
+    history_result_bytes-= history_result_rendered_sizes.at(0);
+    history_result_rendered_cursors.removeFirst();
+    history_result_rendered_ids.removeFirst();
+    history_result_rendered_sizes.removeFirst();
+  }
+}
+
+
+/*
+  Only the blocks that are on the screen are looked at, so the cost of
+  a scroll doesn't depend on how big the history is.
+*/
+void MainWindow::history_result_expand(int value)
+{
+  (void) value;
+  QTextDocument *document= history_edit_widget->document();
+  int first_position= history_edit_widget->cursorForPosition(QPoint(0, 0)).position();
+  int last_position= history_edit_widget->cursorForPosition(QPoint(history_edit_widget->viewport()->width(),
+                                                                    history_edit_widget->viewport()->height())).position();
+  /* inserting can move the scroll bar, we don't want to come back here while inserting */
+  history_edit_widget->verticalScrollBar()->blockSignals(true);
+  /* One edit block, so the user's undo stack stays and one undo takes back all of this scroll's expansions */
+  QTextCursor text_cursor(document);
+  bool is_edit_block_started= false;
+  QTextBlock block= document->findBlock(first_position);
+  while ((block.isValid()) && (block.position() <= last_position))
+  {
+    if (block.userState() <= 0)
+    {
+      block= block.next();
+      continue;
+    }
+    unsigned int id= (unsigned int) block.userState();
+    block.setUserState(-1);
+    int i= history_result_ids.indexOf(id);
+    QString replacement;
+    bool is_rendered= false;
+    if (i == -1) replacement= "[result set #" + QString::number(id) + " discarded, see ocelot_history_max_result_bytes]";
+    else
+    {
+      replacement= history_result_render(history_result_snapshots.at(i));
+      /* Once it is in the document we don't need the snapshot, but the rendered text counts instead. */
+      history_result_bytes-= history_result_snapshots.at(i).size();
+      history_result_snapshots.removeAt(i);
+      history_result_ids.removeAt(i);
+      is_rendered= true;
+    }
+    if (replacement.endsWith("\n")) replacement.chop(1);
+    if (is_edit_block_started == false)
+    {
+      text_cursor.beginEditBlock();
+      is_edit_block_started= true;
+    }
+    text_cursor.setPosition(block.position());
+    text_cursor.movePosition(QTextCursor::EndOfBlock, QTextCursor::KeepAnchor);
+    last_position+= replacement.length() - (text_cursor.selectionEnd() - text_cursor.selectionStart());
+    int start_position= text_cursor.selectionStart();
+    text_cursor.insertText(replacement);
+    if (is_rendered == true)
+    {
+      QTextCursor rendered_cursor(document);
+      rendered_cursor.setPosition(start_position);
+      rendered_cursor.setPosition(text_cursor.position(), QTextCursor::KeepAnchor);
+      /* Keep them in id order, so history_result_trim() takes the oldest */
+      int j= 0;
+      while ((j < history_result_rendered_ids.count()) && (history_result_rendered_ids.at(j) < id)) ++j;
+      history_result_rendered_cursors.insert(j, rendered_cursor);
+      history_result_rendered_ids.insert(j, id);
+      history_result_rendered_sizes.insert(j, replacement.size());
+      history_result_bytes+= replacement.size();
+    }
+    block= text_cursor.block().next();
+  }
+  if (is_edit_block_started == true) text_cursor.endEditBlock();
+  history_edit_widget->verticalScrollBar()->blockSignals(false);
+  history_result_trim();
+}
+
+
+/*
+  Format a copy_to_history() snapshot.
+  Example output:
+  +------+------+------------+
+  | s1   | s2   | The Rain I |
+  +------+------+------------+
+  |    1 | A    |          0 |
+  | NULL | NULL |          0 |
+  +------+------+------------+
+  The output is the same as what mysql client would display --
+    left margin = 1, right margin = 1, left justify if number,
+    content length = maximum actual length -- except that mysql
+    client has minimum content length = 4 if column is nullable,
+    and we don't bother with that, it looks like a flaw.
+  Or, if is_vertical, "*** n. row ***" and name: value lines.
+*/
+QString MainWindow::history_result_render(QByteArray snapshot)
+{
+  QString s= "";
+  if (snapshot.size() < (int) (sizeof(unsigned int) * 2 + 2)) return s;
+  const char *pointer_to_snapshot= snapshot.constData();
+  unsigned int col;
+  unsigned int r;
+  unsigned int length;
+  unsigned int history_result_column_count;
+  unsigned int history_result_row_count;
+  char is_vertical, is_column_names;
+  unsigned int *history_max_column_widths;
+  char *history_is_number;
+  const char **history_field_names;
+  unsigned int *history_field_name_lengths;
+  char *history_line;
+  char *divider_line;
+  char *pointer_to_history_line;
+  unsigned int history_line_width;
+
+  memcpy(&history_result_column_count, pointer_to_snapshot, sizeof(unsigned int));
+  pointer_to_snapshot+= sizeof(unsigned int);
+  memcpy(&history_result_row_count, pointer_to_snapshot, sizeof(unsigned int));
+  pointer_to_snapshot+= sizeof(unsigned int);
+  is_vertical= *(pointer_to_snapshot++);
+  is_column_names= *(pointer_to_snapshot++);
+
+  history_max_column_widths= new unsigned int[history_result_column_count];
+  history_is_number= new char[history_result_column_count];
+  history_field_names= new const char*[history_result_column_count];
+  history_field_name_lengths= new unsigned int[history_result_column_count];
+  history_line_width= 2;
+  unsigned int longest_column_name_length= 0;
+  for (col= 0; col < history_result_column_count; ++col)
+  {
+    memcpy(&history_max_column_widths[col], pointer_to_snapshot, sizeof(unsigned int));
+    pointer_to_snapshot+= sizeof(unsigned int);
+    history_is_number[col]= *(pointer_to_snapshot++);
+    memcpy(&history_field_name_lengths[col], pointer_to_snapshot, sizeof(unsigned int));
+    pointer_to_snapshot+= sizeof(unsigned int);
+    history_field_names[col]= pointer_to_snapshot;
+    pointer_to_snapshot+= history_field_name_lengths[col];
+    if (history_field_name_lengths[col] > longest_column_name_length)
+      longest_column_name_length= history_field_name_lengths[col];
+    history_line_width+= history_max_column_widths[col] + 1 + HISTORY_COLUMN_MARGIN * 2;
+  }
+
+  if (is_vertical == 1)
+  {
+    if (is_column_names != 1) longest_column_name_length= 0;
+    history_line= new char[longest_column_name_length + HISTORY_MAX_VERTICAL_COLUMN_WIDTH + 256];
+    for (r= 0; r < history_result_row_count; ++r)
+    {
+      sprintf(history_line, "*************************** %u. row ***************************\n", r + 1);
+      s.append(history_line);
+      for (col= 0; col < history_result_column_count; ++col)
+      {
+        char flag;
+        const char *pointer_to_source;
+        pointer_to_history_line= history_line;
+        length= history_field_name_lengths[col];
+        if (length > longest_column_name_length) length= longest_column_name_length;
+        memset(pointer_to_history_line, ' ', longest_column_name_length - length);
+        pointer_to_history_line+= longest_column_name_length - length;
+        memcpy(pointer_to_history_line, history_field_names[col], length);
+        pointer_to_history_line+= length;
+        *(pointer_to_history_line++)= ':';
+        *(pointer_to_history_line++)= ' ';
+        memcpy(&length, pointer_to_snapshot, sizeof(unsigned int));
+        flag= *(pointer_to_snapshot + sizeof(unsigned int));
+        pointer_to_snapshot+= sizeof(unsigned int) + sizeof(char);
+        pointer_to_source= pointer_to_snapshot;
+        pointer_to_snapshot+= length;
+        if ((flag & FIELD_VALUE_FLAG_IS_NULL) != 0)
+        {
+          length= strlen(NULL_STRING);
+          pointer_to_source= NULL_STRING;
+        }
+        memcpy(pointer_to_history_line, pointer_to_source, length);
+        pointer_to_history_line+= length;
+        *(pointer_to_history_line)= '\n'; *(pointer_to_history_line + 1)= '\0';
+        s.append(history_line);
+      }
+    }
+  }
+  else
+  {
+    history_line= new char[history_line_width + 2];
+    divider_line= new char[history_line_width + 2];
+    {
+      char *pointer_to_divider_line;
+      pointer_to_divider_line= divider_line;
+      *(pointer_to_divider_line++)= '+';
+      for (col= 0; col < history_result_column_count; ++col)
+      {
+        memset(pointer_to_divider_line, '-',
+               history_max_column_widths[col] + HISTORY_COLUMN_MARGIN * 2);
+        pointer_to_divider_line+=
+               history_max_column_widths[col] + HISTORY_COLUMN_MARGIN * 2;
+        *(pointer_to_divider_line++)= '+';
+      }
+      *(pointer_to_divider_line)= '\n'; *(pointer_to_divider_line + 1)= '\0';
+    }
+    if (is_column_names == 1)
+    {
+      s.append(divider_line);
+      pointer_to_history_line= history_line;
+      *(pointer_to_history_line++)= '|';
+      for (col= 0; col < history_result_column_count; ++col)
+      {
+        memset(pointer_to_history_line, ' ', HISTORY_COLUMN_MARGIN);
+        pointer_to_history_line+= HISTORY_COLUMN_MARGIN;
+        length= history_field_name_lengths[col];
+        if (length > history_max_column_widths[col]) length= history_max_column_widths[col];
+        memcpy(pointer_to_history_line, history_field_names[col], length);
+        pointer_to_history_line+= length;
+        if (length < history_max_column_widths[col])
+        {
+          length= history_max_column_widths[col] - length;
+          memset(pointer_to_history_line, ' ', length);
+          pointer_to_history_line+= length;
+        }
+        memset(pointer_to_history_line, ' ', HISTORY_COLUMN_MARGIN);
+        pointer_to_history_line+= HISTORY_COLUMN_MARGIN;
+        *(pointer_to_history_line++)= '|';
+      }
+      *(pointer_to_history_line)= '\n'; *(pointer_to_history_line + 1)= '\0';
+      s.append(history_line);
+    }
+    s.append(divider_line);
+    for (r= 0; r < history_result_row_count; ++r)
+    {
+      char flag;
+      const char *pointer_to_source;
+      unsigned int spaces_before, spaces_after;
+      pointer_to_history_line= history_line;
+      *(pointer_to_history_line++)= '|';
+      for (col= 0; col < history_result_column_count; ++col)
+      {
+        memcpy(&length, pointer_to_snapshot, sizeof(unsigned int));
+        flag= *(pointer_to_snapshot + sizeof(unsigned int));
+        pointer_to_snapshot+= sizeof(unsigned int) + sizeof(char);
+        pointer_to_source= pointer_to_snapshot;
+        pointer_to_snapshot+= length;
+        if ((flag & FIELD_VALUE_FLAG_IS_NULL) != 0)
+        {
+          length= strlen(NULL_STRING);
+          pointer_to_source= NULL_STRING;
+        }
+        spaces_before= spaces_after= HISTORY_COLUMN_MARGIN;
+        if (length > history_max_column_widths[col]) length= history_max_column_widths[col];
+        else
+        {
+          if (history_is_number[col] != 0)
+          {
+            spaces_before+= history_max_column_widths[col] - length;
+          }
+          else
+          {
+            spaces_after+= history_max_column_widths[col] - length;
+          }
+        }
+        memset(pointer_to_history_line, ' ', spaces_before);
+        pointer_to_history_line+= spaces_before;
+        memcpy(pointer_to_history_line, pointer_to_source, length);
+        pointer_to_history_line+= length;
+        memset(pointer_to_history_line, ' ', spaces_after);
+        pointer_to_history_line+= spaces_after;
+        *(pointer_to_history_line++)= '|';
+      }
+      *(pointer_to_history_line)= '\n'; *(pointer_to_history_line + 1)= '\0';
+      s.append(history_line);
+    }
+    s.append(divider_line);
+    delete [] divider_line;
+  }
+  delete [] history_line;
+  delete [] history_field_name_lengths;
+  delete [] history_field_names;
+  delete [] history_is_number;
+  delete [] history_max_column_widths;
+  return s;
 }
 
 
@@ -2078,6 +2500,58 @@ void MainWindow::menu_edit_select_all()
     qobject_cast<QTextEdit*>(focus_widget)->selectAll();
 }
 
+token_buffer::token_buffer()
+{
+  arena= 0;
+  offsets= lengths= types= pointers= 0;
+  flags= 0;
+  reftypes= 0;
+  max_count= 0;
+  count_in_all= 0;
+}
+
+token_buffer::~token_buffer()
+{
+  delete [] arena;
+}
+
+/*
+  Make room for at least desired_count tokens. Like the old
+  main_token_new(), this doesn't preserve what was there before,
+  and never shrinks. The int/unsigned int arrays come first in
+  the arena so that each is aligned.
+*/
+void token_buffer::reserve(unsigned int desired_count)
+{
+  if (desired_count <= max_count) return;
+  delete [] arena;
+  size_t per_token= 4 * sizeof(int) + sizeof(unsigned int) + sizeof(unsigned char);
+  arena= new char[desired_count * per_token];
+  char *p= arena;
+  offsets= (int*) p;           p+= desired_count * sizeof(int);
+  lengths= (int*) p;           p+= desired_count * sizeof(int);
+  types= (int*) p;             p+= desired_count * sizeof(int);
+  pointers= (int*) p;          p+= desired_count * sizeof(int);
+  flags= (unsigned int*) p;    p+= desired_count * sizeof(unsigned int);
+  reftypes= (unsigned char*) p;
+  lengths[0]= 0;
+  max_count= desired_count;
+  count_in_all= 0;
+}
+
+void token_buffer::swap(token_buffer &other)
+{
+  char *tmp_arena= arena; arena= other.arena; other.arena= tmp_arena;
+  int *tmp_offsets= offsets; offsets= other.offsets; other.offsets= tmp_offsets;
+  int *tmp_lengths= lengths; lengths= other.lengths; other.lengths= tmp_lengths;
+  int *tmp_types= types; types= other.types; other.types= tmp_types;
+  unsigned int *tmp_flags= flags; flags= other.flags; other.flags= tmp_flags;
+  int *tmp_pointers= pointers; pointers= other.pointers; other.pointers= tmp_pointers;
+  unsigned char *tmp_reftypes= reftypes; reftypes= other.reftypes; other.reftypes= tmp_reftypes;
+  unsigned int tmp_max_count= max_count; max_count= other.max_count; other.max_count= tmp_max_count;
+  unsigned int tmp_count_in_all= count_in_all; count_in_all= other.count_in_all; other.count_in_all= tmp_count_in_all;
+}
+
 /*
   The required size of main_token_offsets|lengths|types|flags is
   #-of-tokens + 1. We allocate lots more than enough after calculating
@@ -2091,82 +2565,396 @@ void MainWindow::main_token_new(int text_size)
   desired_count= text_size + 1;
   if (desired_count >= main_token_max_count)
   {
-    if (main_token_max_count != 0)
-    {
-      delete [] main_token_offsets;
-      delete [] main_token_lengths;
-      delete [] main_token_types;
-      delete [] main_token_flags;
-      delete [] main_token_pointers;
-      delete [] main_token_reftypes;
-    }
     desired_count= (desired_count - (desired_count % 1000)) + 1000;
-    main_token_offsets= new int[desired_count];
-    main_token_lengths= new int[desired_count];
-    main_token_lengths[0]= 0;
-    main_token_types= new int[desired_count];
-    main_token_flags= new unsigned int[desired_count];
-    main_token_pointers= new int[desired_count];
-    main_token_reftypes= new unsigned char[desired_count];
-    main_token_max_count= desired_count;
+    main_token_buffer.reserve(desired_count);
+    main_token_use();
   }
 }
 
+/*
+  main_token_* are used in hundreds of places so they stay as they were,
+  but now they're only aliases for main_token_buffer's arrays.
+  Call this whenever main_token_buffer is reallocated or swapped.
+*/
+void MainWindow::main_token_use()
+{
+  main_token_offsets= main_token_buffer.offsets;
+  main_token_lengths= main_token_buffer.lengths;
+  main_token_types= main_token_buffer.types;
+  main_token_flags= main_token_buffer.flags;
+  main_token_pointers= main_token_buffer.pointers;
+  main_token_reftypes= main_token_buffer.reftypes;
+  main_token_max_count= main_token_buffer.max_count;
+}
+
+/* Same as main_token_use(), for editor_token_buffer */
+void MainWindow::editor_token_use()
+{
+  editor_token_offsets= editor_token_buffer.offsets;
+  editor_token_lengths= editor_token_buffer.lengths;
+  editor_token_types= editor_token_buffer.types;
+  editor_token_flags= editor_token_buffer.flags;
+  editor_token_max_count= editor_token_buffer.max_count;
+}
+
 #ifdef HAVE_PUSH_AND_POP
 /*
   Saving and restoring the main_token variables.
   This was conceived for a trick with subqueries that I didn't do,
-  but could be useful someday. The problem is that main_token_*
-  variables are global (okay, bad early laziness, but refactoring
-  now would be hard). So save them when you're about to parse
+  but could be useful someday. Save them when you're about to parse
   something else e.g. a local subquery, and restore when the
   subquery is done. Optimistically I call this push + pop, but
   in fact can only save one level. Expect text to be saved elsewhere.
+  Nothing is copied: the buffers are swapped, so after push the
+  main_token arrays are empty and main_token_new() must be called.
 */
 void MainWindow::main_token_push()
 {
-  assert(sizeof(main_token_offsets[0] == sizeof(int)));
-  assert(sizeof(main_token_lengths[0] == sizeof(int)));
-  assert(sizeof(main_token_types[0] == sizeof(int)));
-  assert(sizeof(main_token_flags[0] == sizeof(unsigned int)));
-  assert(sizeof(main_token_pointers[0] == sizeof(int)));
-  assert(sizeof(main_token_reftypes[0] == sizeof(unsigned char)));
-  saved_main_token_count_in_all= main_token_count_in_all;
+  main_token_buffer.count_in_all= main_token_count_in_all;
   saved_main_token_count_in_statement= main_token_count_in_statement;
   saved_main_token_number= main_token_number;
-  saved_main_token_offsets= new int[saved_main_token_count_in_all];
-  saved_main_token_lengths= new int[saved_main_token_count_in_all];
-  saved_main_token_types= new int[saved_main_token_count_in_all];
-  saved_main_token_flags= new unsigned int[saved_main_token_count_in_all];
-  saved_main_token_pointers= new int[saved_main_token_count_in_all];
-  saved_main_token_reftypes= new unsigned char[saved_main_token_count_in_all];
-  memcpy(saved_main_token_offsets, main_token_offsets, saved_main_token_count_in_all * sizeof(int));
-  memcpy(saved_main_token_lengths, main_token_lengths, saved_main_token_count_in_all * sizeof(int));
-  memcpy(saved_main_token_types, main_token_types, saved_main_token_count_in_all * sizeof(int));
-  memcpy(saved_main_token_flags, main_token_flags, saved_main_token_count_in_all * sizeof(unsigned int));
-  memcpy(saved_main_token_pointers, main_token_pointers, saved_main_token_count_in_all * sizeof(int));
-  memcpy(saved_main_token_reftypes, main_token_reftypes, saved_main_token_count_in_all * sizeof(unsigned char));
+  main_token_buffer.swap(saved_main_token_buffer);
+  main_token_use();
+  main_token_count_in_all= 0;
 }
 void MainWindow::main_token_pop()
 {
-  memcpy(main_token_offsets, saved_main_token_offsets, saved_main_token_count_in_all * sizeof(int));
-  memcpy(main_token_lengths, saved_main_token_lengths, saved_main_token_count_in_all * sizeof(int));
-  memcpy(main_token_types, saved_main_token_types, saved_main_token_count_in_all * sizeof(int));
-  memcpy(main_token_flags, saved_main_token_flags, saved_main_token_count_in_all * sizeof(unsigned int));
-  memcpy(main_token_pointers, saved_main_token_pointers, saved_main_token_count_in_all * sizeof(int));
-  memcpy(main_token_reftypes, saved_main_token_reftypes, saved_main_token_count_in_all * sizeof(unsigned char));
-  delete [] saved_main_token_reftypes;
-  delete [] saved_main_token_pointers;
-  delete [] saved_main_token_flags;
-  delete [] saved_main_token_types;
-  delete [] saved_main_token_lengths;
-  delete [] saved_main_token_offsets;
-  main_token_count_in_all= saved_main_token_count_in_all;
+  main_token_buffer.swap(saved_main_token_buffer);
+  main_token_use();
+  main_token_count_in_all= main_token_buffer.count_in_all;
   main_token_count_in_statement= saved_main_token_count_in_statement;
   main_token_number= saved_main_token_number;
 }
 #endif
 
+/*
+  Incremental re-tokenizing of statement_edit_widget.
+  action_statement_edit_widget_contents_change() notes what the document says
+  changed: position, chars removed, chars added. If there were several changes
+  before contentsChanged(), e.g. during an edit block, they're merged.
+  editor_tokens_update() then does what tokenize() + tokens_to_keywords_lookup()
+  would do for the whole text, but only around the change:
+  * Find a restart token: the last token that ends before the change position,
+    or an earlier one, which follows white space. After white space tokenize()
+    is in its initial state, since strings and comments are single tokens.
+    The exception is / *! ... * / which is several tokens and has state, so if
+    there's a / *! anywhere we don't try.
+  * tokenize() a window of the new text starting at the restart token.
+  * Look for a "sync" token: after the change, follows white space, not near
+    the window end, and there's an old token with the same length at the same
+    place (adjusted by chars added - chars removed). The rest would be the same
+    as before. If no sync token, double the window and try again.
+  * Splice: old tokens between restart and sync are replaced by the new ones,
+    later tokens move and their offsets are adjusted.
+  Keyword lookup happens only for the new tokens. But tokens_to_keywords_context()
+  looks at neighbours (find_start_of_body() can go back to the start of a
+  CREATE PROCEDURE), so it's still done for everything.
+  So this is a constant-factor gain, not a cost that's independent of the
+  size of the text: each keystroke still has toPlainText(), the context
+  pass, the memmove of the tokens after the change, and the copy to
+  main_token_*, all O(text), and hparse_f_multi_block() is O(text) too.
+  What's saved is tokenize() and the keyword bsearch, which were most of it.
+  Todo: context pass for the changed statement only, offsets relative to
+  the statement so the tail needn't be adjusted.
+  If anything is doubtful (delimiter or dbms changed, text doesn't match what
+  the change said, too much to walk back over) we return false and the caller
+  does the whole thing. Either way the caller ends with editor_tokens_save().
+*/
+#define EDITOR_TOKENS_WINDOW 4096
+#define EDITOR_TOKENS_LOOKAHEAD 16
+#define EDITOR_TOKENS_MAX_WALK_BACK 1000
+void MainWindow::action_statement_edit_widget_contents_change(int position, int chars_removed, int chars_added)
+{
+  if (editor_change_position == -1)
+  {
+    editor_change_position= position;
+    editor_change_removed= chars_removed;
+    editor_change_added= chars_added;
+    return;
+  }
+  /* Merge. Positions so far are in terms of the text after the earlier change. */
+  int start= editor_change_position;
+  if (position < start) start= position;
+  int end= editor_change_position + editor_change_added;
+  if (position + chars_removed > end) end= position + chars_removed;
+  editor_change_removed= (end - start) - editor_change_added + editor_change_removed;
+  editor_change_added= (end - chars_removed + chars_added) - start;
+  editor_change_position= start;
+}
+
+bool MainWindow::editor_tokens_update(QString text)
+{
+  int position= editor_change_position;
+  int removed= editor_change_removed;
+  int added= editor_change_added;
+  int delta= added - removed;
+  int text_length= text.size();
+  int old_count= editor_token_count;
+
+  if ((editor_token_is_valid == false) || (position < 0)) return false;
+  if ((editor_token_delimiter_str != ocelot_delimiter_str)
+   || (editor_token_dbms_version_mask != dbms_version_mask)
+   || (editor_token_hparse_dbms_mask != hparse_dbms_mask)) return false;
+  if (editor_token_text.size() + delta != text_length) return false;
+  if ((position > editor_token_text.size()) || (position + removed > editor_token_text.size())) return false;
+  /* Cheap check that the text around the change is what we expect. */
+  int before= EDITOR_TOKENS_LOOKAHEAD;
+  if (before > position) before= position;
+  if (text.mid(position - before, before) != editor_token_text.mid(position - before, before))
+    return false;
+  if (text.mid(position + added, EDITOR_TOKENS_LOOKAHEAD) != editor_token_text.mid(position + removed, EDITOR_TOKENS_LOOKAHEAD))
+    return false;
+  if (editor_token_has_version_comment == true) return false;
+  if (text.mid(position - before, before + added + EDITOR_TOKENS_LOOKAHEAD).indexOf("/*!") != -1) return false;
+  int lookahead= EDITOR_TOKENS_LOOKAHEAD + ocelot_delimiter_str.length();
+
+  /* restart = first old token that might change. Binary search for last token ending before position. */
+  int restart= 0;
+  {
+    int low= 0, high= old_count - 1;
+    while (low <= high)
+    {
+      int middle= (low + high) / 2;
+      if (editor_token_offsets[middle] + editor_token_lengths[middle] < position)
+      {
+        restart= middle;
+        low= middle + 1;
+      }
+      else high= middle - 1;
+    }
+  }
+  {
+    int walk_back;
+    for (walk_back= 0; restart > 0; --restart, ++walk_back)
+    {
+      if (walk_back > EDITOR_TOKENS_MAX_WALK_BACK) return false;
+      int offset= editor_token_offsets[restart];
+      if ((offset < position) && (text.at(offset - 1) <= ' ')) break;
+    }
+  }
+  int restart_offset= 0;
+  if (restart > 0) restart_offset= editor_token_offsets[restart];
+
+  /* tokenize() a window, bigger each time, until we find a sync token or reach the end. */
+  int window_length= (position + added - restart_offset) + EDITOR_TOKENS_WINDOW;
+  int *new_offsets= 0;
+  int *new_lengths= 0;
+  int new_count;
+  int sync;                 /* index in old tokens of the first token that's unchanged */
+  for (;;)
+  {
+    if (restart_offset + window_length > text_length) window_length= text_length - restart_offset;
+    bool is_at_end= (restart_offset + window_length == text_length);
+    if (new_offsets != 0) { delete [] new_offsets; delete [] new_lengths; }
+    new_offsets= new int[window_length + 2];
+    new_lengths= new int[window_length + 2];
+    new_lengths[0]= 0;
+    tokenize(text.data() + restart_offset,
+             window_length,
+             new_lengths, new_offsets, window_length + 2, (QChar*)"33333", 1, ocelot_delimiter_str, 1);
+    for (new_count= 0; new_lengths[new_count] != 0; ++new_count) new_offsets[new_count]+= restart_offset;
+    if (is_at_end)
+    {
+      sync= old_count;
+      break;
+    }
+    sync= -1;
+    int j;
+    for (j= 0; j < new_count; ++j)
+    {
+      int offset= new_offsets[j];
+      if (offset < position + added) continue;
+      if (offset + new_lengths[j] + lookahead > restart_offset + window_length) break;
+      if ((offset == 0) || (text.at(offset - 1) > ' ')) continue;
+      /* binary search in old tokens for offset - delta */
+      int low= restart, high= old_count - 1;
+      while (low <= high)
+      {
+        int middle= (low + high) / 2;
+        if (editor_token_offsets[middle] < offset - delta) low= middle + 1;
+        else if (editor_token_offsets[middle] > offset - delta) high= middle - 1;
+        else
+        {
+          if ((editor_token_lengths[middle] == new_lengths[j])
+           && (editor_token_offsets[middle] >= position + removed))
+            sync= middle;
+          break;
+        }
+      }
+      if (sync != -1) break;
+    }
+    if (sync != -1)
+    {
+      new_count= j;
+      break;
+    }
+    window_length*= 2;
+  }
+
+  /* Splice. Tokens [restart, sync) are replaced by new tokens [0, new_count). */
+  unsigned int count= restart + new_count + (old_count - sync);
+  if ((count + 1 > main_token_max_count) || (count + 1 > editor_token_max_count))
+  {
+    delete [] new_offsets; delete [] new_lengths;
+    return false;
+  }
+  int tail_count= old_count - sync + 1;             /* + 1 for the terminating 0 length */
+  memmove(&editor_token_offsets[restart + new_count], &editor_token_offsets[sync], tail_count * sizeof(int));
+  memmove(&editor_token_lengths[restart + new_count], &editor_token_lengths[sync], tail_count * sizeof(int));
+  memmove(&editor_token_types[restart + new_count], &editor_token_types[sync], tail_count * sizeof(int));
+  memmove(&editor_token_flags[restart + new_count], &editor_token_flags[sync], tail_count * sizeof(unsigned int));
+  for (unsigned int i= restart + new_count; i < count; ++i) editor_token_offsets[i]+= delta;
+  memcpy(&editor_token_offsets[restart], new_offsets, new_count * sizeof(int));
+  memcpy(&editor_token_lengths[restart], new_lengths, new_count * sizeof(int));
+  delete [] new_offsets;
+  delete [] new_lengths;
+  editor_token_lengths[count]= 0;
+  editor_token_count= count;
+
+  /* Copy to main_token_*, then lookup for the new tokens only. */
+  memcpy(main_token_offsets, editor_token_offsets, (count + 1) * sizeof(int));
+  memcpy(main_token_lengths, editor_token_lengths, (count + 1) * sizeof(int));
+  memcpy(main_token_types, editor_token_types, (count + 1) * sizeof(int));
+  memcpy(main_token_flags, editor_token_flags, (count + 1) * sizeof(unsigned int));
+  memset(main_token_pointers, 0, (count + 1) * sizeof(int));
+  memset(main_token_reftypes, 0, (count + 1) * sizeof(unsigned char));
+  tokens_to_keywords_lookup(text, restart, restart + new_count);
+  main_token_count_in_all= count;
+  main_token_types[count]= 0;
+  return true;
+}
+
+/*
+  After tokenize() + tokens_to_keywords_lookup() of the whole editor text,
+  (is_whole == true), or after editor_tokens_update(), remember the results
+  for next time.
+*/
+void MainWindow::editor_tokens_save(QString text, bool is_whole)
+{
+  unsigned int count= main_token_count_in_all;
+  if (count + 1 > editor_token_max_count)
+  {
+    editor_token_buffer.reserve(main_token_max_count);
+    editor_token_use();
+  }
+  memcpy(editor_token_offsets, main_token_offsets, (count + 1) * sizeof(int));
+  memcpy(editor_token_lengths, main_token_lengths, (count + 1) * sizeof(int));
+  memcpy(editor_token_types, main_token_types, (count + 1) * sizeof(int));
+  memcpy(editor_token_flags, main_token_flags, (count + 1) * sizeof(unsigned int));
+  editor_token_count= count;
+  editor_token_text= text;
+  editor_token_delimiter_str= ocelot_delimiter_str;
+  editor_token_dbms_version_mask= dbms_version_mask;
+  editor_token_hparse_dbms_mask= hparse_dbms_mask;
+  if (is_whole == true) editor_token_has_version_comment= (text.indexOf("/*!") != -1);
+  editor_token_is_valid= true;
+  editor_change_position= -1;
+}
+
+/*
+  Statement timing, if ocelot_statement_timing > 0.
+  The time that a statement takes is split into the STATEMENT_TIMING_*
+  phases. statement_timing_start() is at the start of action_execute(),
+  and statement_timing_mark(phase) charges the time since the previous
+  mark to phase, so the phases add up to the total.
+  tokenize is different: tokens are made while the user types, so it's
+  how long the last tokenize of the statement widget took.
+  parse is what hparse does after Execute, usually not much because
+  the recognizer already did it in the background.
+  send and server are mysql_real_query(). With MariaDB's non-blocking
+  API, send ends when the library first waits to read, so server is
+  execution + network + first byte of the response. Otherwise it's
+  all server, the client library can't tell us more. Only the user's
+  statement on the main connection marks send, see real_query_send(),
+  so information_schema lookups etc. don't move it.
+  paint ends when the event loop gets around to a zero-time timer,
+  i.e. after Qt has handled the paint events that the new result caused.
+  The result goes in the status bar, and if ocelot_statement_timing = 2
+  it's also appended to the result message, so it's in the history
+  (without paint, since history is written before painting).
+*/
+static const char *statement_timing_names[STATEMENT_TIMING_MAX]=
+{
+  "tokenize", "parse", "client", "utf8", "send", "server", "store", "scan", "layout", "paint"
+};
+static QElapsedTimer statement_timer;
+static qint64 statement_timing_last_mark;
+static qint64 statement_timing_ns[STATEMENT_TIMING_MAX];
+static qint64 statement_timing_tokenize_ns= 0;    /* for the last tokenize of the statement widget */
+static bool statement_timing_is_paint_pending= false;
+
+static qint64 statement_timing_elapsed(const QElapsedTimer *timer)
+{
+#if QT_VERSION >= 0x40800
+  return timer->nsecsElapsed();
+#else
+  return timer->elapsed() * 1000000;
+#endif
+}
+
+static qint64 statement_timing_now()
+{
+  return statement_timing_elapsed(&statement_timer);
+}
+
+static void statement_timing_start()
+{
+  for (int i= 0; i < STATEMENT_TIMING_MAX; ++i) statement_timing_ns[i]= 0;
+  statement_timing_ns[STATEMENT_TIMING_TOKENIZE]= statement_timing_tokenize_ns;
+  statement_timing_is_paint_pending= false;
+  statement_timer.start();
+  statement_timing_last_mark= 0;
+}
+
+void statement_timing_mark(int phase)
+{
+  if (ocelot_statement_timing == 0) return;
+  qint64 now= statement_timing_now();
+  statement_timing_ns[phase]+= now - statement_timing_last_mark;
+  statement_timing_last_mark= now;
+}
+
+/* e.g. "server 12.41 ms, store 0.80 ms, ... total 14.02 ms". Phases that took no time are skipped. */
+static QString statement_timing_text()
+{
+  QString s;
+  qint64 total= 0;
+  for (int i= 0; i < STATEMENT_TIMING_MAX; ++i)
+  {
+    if (statement_timing_ns[i] == 0) continue;
+    total+= statement_timing_ns[i];
+    s.append(statement_timing_names[i]);
+    s.append(" " + QString::number((double) statement_timing_ns[i] / 1000000, 'f', 2) + " ms, ");
+  }
+  s.append("total " + QString::number((double) total / 1000000, 'f', 2) + " ms");
+  return s;
+}
+
+/*
+  Called from action_execute() when a statement is done.
+  If statements are executed one after another, only the last one
+  gets to the status bar, because statement_timing_start() clears
+  statement_timing_is_paint_pending.
+*/
+void MainWindow::statement_timing_end()
+{
+  if (ocelot_statement_timing == 0) return;
+  statement_timing_mark(STATEMENT_TIMING_LAYOUT);
+  if (is_headless == true) return;
+  statement_timing_is_paint_pending= true;
+  QTimer::singleShot(0, this, SLOT(statement_timing_paint()));
+}
+
+/* Slot. See statement_timing_end(). */
+void MainWindow::statement_timing_paint()
+{
+  if (statement_timing_is_paint_pending == false) return;
+  statement_timing_is_paint_pending= false;
+  statement_timing_mark(STATEMENT_TIMING_PAINT);
+  statusBar()->show();
+  statusBar()->showMessage(statement_timing_text());
+}
+
 /*
   ACTIONS
   ! All action_ functions must be in the "public slots" area of ocelotgui.h
@@ -2192,138 +2980,272 @@ void MainWindow::action_statement_edit_widget_text_changed()
   statement_edit_widget->document()->blockSignals(true);
 
   QString text;
-  int i;
-  int pos;
 
   /* Syntax highlighting */
   text= statement_edit_widget->toPlainText(); /* or I could just pass this to tokenize() directly */
 
-  /* Todo: avoid total tokenize() + tokens_to_keywords() if user is just adding at end */
+  hparse_background_cancel();
+  int change_position= editor_change_position;
+  int change_added= editor_change_added;
+  int change_removed= editor_change_removed;
+  QElapsedTimer tokenize_timer;
+  tokenize_timer.start();
   main_token_new(text.size());
-  tokenize(text.data(),
-           text.size(),
-           main_token_lengths, main_token_offsets, main_token_max_count, (QChar*)"33333", 1, ocelot_delimiter_str, 1);
-
-  tokens_to_keywords(text, 0);
+  /* Usually only the tokens near the change are redone, see editor_tokens_update() */
+  if (editor_tokens_update(text) == true) editor_tokens_save(text, false);
+  else
+  {
+    tokenize(text.data(),
+             text.size(),
+             main_token_lengths, main_token_offsets, main_token_max_count, (QChar*)"33333", 1, ocelot_delimiter_str, 1);
+    tokens_to_keywords_lookup(text, 0, -1);
+    editor_tokens_save(text, true);
+  }
+  tokens_to_keywords_context(text, 0);
+  statement_timing_tokenize_ns= statement_timing_elapsed(&tokenize_timer);
+  /* The recognizer waits till the user stops typing, see hparse_background_start() */
   if (((ocelot_statement_syntax_checker.toInt()) & FLAG_FOR_HIGHLIGHTS) != 0)
   {
-    hparse_f_multi_block(text); /* recognizer */
+    hparse_background_timer->start(HPARSE_DEBOUNCE_MS);
   }
-  /* This "sets" the colour, it does not "merge" it. */
-  /* Do not try to set underlines, they won't go away. */
-  QTextDocument *pDoc= statement_edit_widget->document();
-  QTextCursor cur(pDoc);
+  statement_highlight(text, change_position, change_added, change_added - change_removed);
+
+  /* Todo: consider what to do about trailing whitespace. */
 
-  /* cur.select (QTextCursor::Document); */ /* desperate attempt to fix so undo/redo is not destroyed ... does not work */
+  widget_sizer(); /* Perhaps adjust relative sizes of the main widgets. */
+
+  statement_edit_widget->document()->blockSignals(false);
+  statement_edit_widget_text_changed_flag= 0;
+  log("action_statement_edit_widget_text_changed end", 90);
+}
 
-  QTextCharFormat format_of_literal;
-  format_of_literal.setForeground(QColor(qt_color(ocelot_statement_highlight_literal_color)));
-  QTextCharFormat format_of_identifier;
-  format_of_identifier.setForeground(QColor(qt_color(ocelot_statement_highlight_identifier_color)));
-  QTextCharFormat format_of_comment;
-  format_of_comment.setForeground(QColor(qt_color(ocelot_statement_highlight_comment_color)));
-  QTextCharFormat format_of_operator;
-  format_of_operator.setForeground(QColor(qt_color(ocelot_statement_highlight_operator_color)));
-  QTextCharFormat format_of_reserved_word;
-  format_of_reserved_word.setForeground(QColor(qt_color(ocelot_statement_highlight_keyword_color)));
-  QTextCharFormat format_of_function;
-  format_of_function.setForeground(QColor(qt_color(ocelot_statement_highlight_function_color)));
-  QTextCharFormat format_of_other;
-  format_of_other.setForeground(QColor(qt_color(ocelot_statement_text_color)));
 
-  pos= 0;
-  /* cur.setPosition(pos, QTextCursor::KeepAnchor); */
-  cur.beginEditBlock();                                     /* ought to affect undo/redo stack? */
+/*
+  Syntax highlighting, after tokens_to_keywords() and maybe hparse.
+  Work out HIGHLIGHT_... for each token. Compare with what it was for the
+  last change: the tokens that are the same at the front and at the back
+  needn't be redone, so dirty = what the user changed + what's between.
+  Formats are set by StatementHighlighter, for the dirty blocks that are
+  visible now, or later when statement_highlight_visible() sees them.
+  change_position = -1 means we don't know what changed, so it's all dirty.
+  change_position = -2 means the text didn't change, only hparse results did.
+  A color change from Settings also makes it all dirty.
+  While hparse_background_timer is waiting, hparse hasn't seen the text yet,
+  so words aren't identifiers and nothing is an error. Then the tokens at
+  the front and back that are the same kind of thing as before keep what
+  hparse said before, otherwise every identifier would flicker.
+*/
+static bool statement_highlight_is_same_kind(unsigned char h, unsigned char old_h)
+{
+  h&= ~HIGHLIGHT_IS_ERROR;
+  old_h&= ~HIGHLIGHT_IS_ERROR;
+  if (h == old_h) return true;
+  if ((h != HIGHLIGHT_OTHER) && (h != HIGHLIGHT_KEYWORD)) return false;
+  if ((old_h == HIGHLIGHT_OTHER) || (old_h == HIGHLIGHT_KEYWORD)
+   || (old_h == HIGHLIGHT_IDENTIFIER) || (old_h == HIGHLIGHT_FUNCTION)) return true;
+  return false;
+}
+
+void MainWindow::statement_highlight(QString text, int change_position, int change_added, int delta)
+{
+  unsigned int count= main_token_count_in_all;
+  unsigned int i;
 
+  QString colors= ocelot_statement_highlight_literal_color + ocelot_statement_highlight_identifier_color
+                + ocelot_statement_highlight_comment_color + ocelot_statement_highlight_operator_color
+                + ocelot_statement_highlight_keyword_color + ocelot_statement_highlight_function_color
+                + ocelot_statement_text_color;
+  bool is_all_dirty= (colors != statement_highlight_colors);
+  if (is_all_dirty)
   {
-    /* This sets everything to normal format / no underline. Gets overridden by token formats. */
-    QTextCharFormat format_of_white_space;
-    cur.setPosition(0, QTextCursor::MoveAnchor);
-    cur.setPosition(text.size(), QTextCursor::KeepAnchor);
-    format_of_white_space= format_of_other;
-    format_of_white_space.setUnderlineStyle(QTextCharFormat::NoUnderline);
-    cur.setCharFormat(format_of_white_space);
+    statement_highlighter->formats[HIGHLIGHT_OTHER].setForeground(QColor(qt_color(ocelot_statement_text_color)));
+    statement_highlighter->formats[HIGHLIGHT_LITERAL].setForeground(QColor(qt_color(ocelot_statement_highlight_literal_color)));
+    statement_highlighter->formats[HIGHLIGHT_IDENTIFIER].setForeground(QColor(qt_color(ocelot_statement_highlight_identifier_color)));
+    statement_highlighter->formats[HIGHLIGHT_COMMENT].setForeground(QColor(qt_color(ocelot_statement_highlight_comment_color)));
+    statement_highlighter->formats[HIGHLIGHT_OPERATOR].setForeground(QColor(qt_color(ocelot_statement_highlight_operator_color)));
+    statement_highlighter->formats[HIGHLIGHT_KEYWORD].setForeground(QColor(qt_color(ocelot_statement_highlight_keyword_color)));
+    statement_highlighter->formats[HIGHLIGHT_FUNCTION].setForeground(QColor(qt_color(ocelot_statement_highlight_function_color)));
+    statement_highlight_colors= colors;
   }
 
-  for (i= 0; main_token_lengths[i] != 0; ++i)
+  unsigned char *highlights= new unsigned char[count + 1];
+  for (i= 0; i < count; ++i)
   {
-    QTextCharFormat format_of_current_token;
-    /* Todo: find out why this is necessary. It looks redundant but without it there's trouble. */
-    for (; pos < main_token_offsets[i]; ++pos)
-    {
-      cur.setPosition(pos, QTextCursor::MoveAnchor);
-      format_of_current_token= format_of_other;
-      format_of_current_token.setUnderlineStyle(QTextCharFormat::NoUnderline);
-      cur.setCharFormat(format_of_current_token);
-      /* cur.clearSelection(); */
-    }
+    unsigned char h= HIGHLIGHT_OTHER;
     int t= main_token_types[i];
-    if (t == TOKEN_TYPE_LITERAL_WITH_SINGLE_QUOTE) format_of_current_token= format_of_literal;
-    if (t == TOKEN_TYPE_LITERAL_WITH_DOUBLE_QUOTE) format_of_current_token= format_of_literal;
-    if (t == TOKEN_TYPE_LITERAL_WITH_DIGIT) format_of_current_token= format_of_literal;
+    if (t == TOKEN_TYPE_LITERAL_WITH_SINGLE_QUOTE) h= HIGHLIGHT_LITERAL;
+    if (t == TOKEN_TYPE_LITERAL_WITH_DOUBLE_QUOTE) h= HIGHLIGHT_LITERAL;
+    if (t == TOKEN_TYPE_LITERAL_WITH_DIGIT) h= HIGHLIGHT_LITERAL;
     /* literal_with_brace == literal */
-    if (t == TOKEN_TYPE_LITERAL_WITH_BRACE) format_of_current_token= format_of_literal; /* obsolete? */
-    if (t == TOKEN_TYPE_IDENTIFIER_WITH_BACKTICK) format_of_current_token= format_of_identifier;
-    if (t == TOKEN_TYPE_IDENTIFIER_WITH_DOUBLE_QUOTE) format_of_current_token= format_of_identifier;
-    if (t == TOKEN_TYPE_IDENTIFIER) format_of_current_token= format_of_identifier;
-    if (t == TOKEN_TYPE_IDENTIFIER_WITH_AT) format_of_current_token= format_of_identifier;
-    if (t == TOKEN_TYPE_COMMENT_WITH_SLASH) format_of_current_token= format_of_comment;
-    if (t == TOKEN_TYPE_COMMENT_WITH_OCTOTHORPE) format_of_current_token= format_of_comment;
-    if (t == TOKEN_TYPE_COMMENT_WITH_MINUS) format_of_current_token= format_of_comment;
-    if (t == TOKEN_TYPE_OPERATOR) format_of_current_token= format_of_operator;
+    if (t == TOKEN_TYPE_LITERAL_WITH_BRACE) h= HIGHLIGHT_LITERAL; /* obsolete? */
+    if (t == TOKEN_TYPE_IDENTIFIER_WITH_BACKTICK) h= HIGHLIGHT_IDENTIFIER;
+    if (t == TOKEN_TYPE_IDENTIFIER_WITH_DOUBLE_QUOTE) h= HIGHLIGHT_IDENTIFIER;
+    if (t == TOKEN_TYPE_IDENTIFIER) h= HIGHLIGHT_IDENTIFIER;
+    if (t == TOKEN_TYPE_IDENTIFIER_WITH_AT) h= HIGHLIGHT_IDENTIFIER;
+    if (t == TOKEN_TYPE_COMMENT_WITH_SLASH) h= HIGHLIGHT_COMMENT;
+    if (t == TOKEN_TYPE_COMMENT_WITH_OCTOTHORPE) h= HIGHLIGHT_COMMENT;
+    if (t == TOKEN_TYPE_COMMENT_WITH_MINUS) h= HIGHLIGHT_COMMENT;
+    if (t == TOKEN_TYPE_OPERATOR) h= HIGHLIGHT_OPERATOR;
     if (t >= TOKEN_KEYWORDS_START)
     {
       if (((main_token_flags[i] & TOKEN_FLAG_IS_FUNCTION) != 0)
        && (main_token_lengths[i + 1] == 1)
-       && (text.mid(main_token_offsets[i + 1], 1) == "("))
+       && (text.at(main_token_offsets[i + 1]) == '('))
       {
-        format_of_current_token= format_of_function;
+        h= HIGHLIGHT_FUNCTION;
       }
-      else format_of_current_token= format_of_reserved_word;
+      else h= HIGHLIGHT_KEYWORD;
     }
-    if (t == TOKEN_TYPE_OTHER) format_of_current_token= format_of_other;
+    if ((main_token_flags[i] & TOKEN_FLAG_IS_ERROR) != 0) h|= HIGHLIGHT_IS_ERROR;
+    highlights[i]= h;
+  }
 
-    /* Todo: consider using SpellCheckUnderline instead of WaveUnderline. */
-    if ((main_token_flags[i] & TOKEN_FLAG_IS_ERROR) != 0)
+  if ((hparse_background_timer->isActive()) && (editor_token_highlights != 0))
+  {
+    unsigned int old_count= editor_token_highlights_count;
+    unsigned int front= 0, back= 0;
+    while ((front < count) && (front < old_count)
+        && (statement_highlight_is_same_kind(highlights[front], editor_token_highlights[front])))
     {
-      format_of_current_token.setUnderlineStyle(QTextCharFormat::WaveUnderline);
-      format_of_current_token.setUnderlineColor(Qt::red);
+      highlights[front]= editor_token_highlights[front];
+      ++front;
     }
-    else
+    while ((back < count - front) && (back < old_count - front)
+        && (statement_highlight_is_same_kind(highlights[count - 1 - back], editor_token_highlights[old_count - 1 - back])))
     {
-      //format_of_current_token.setUnderlineStyle(QTextCharFormat::NoUnderline);
+      highlights[count - 1 - back]= editor_token_highlights[old_count - 1 - back];
+      ++back;
     }
-
-    cur.setPosition(pos, QTextCursor::MoveAnchor);
-    cur.setPosition(pos + main_token_lengths[i], QTextCursor::KeepAnchor);
-    cur.setCharFormat(format_of_current_token);
-    pos+= main_token_lengths[i];
   }
-  cur.endEditBlock();
-
-  /* Todo: consider what to do about trailing whitespace. */
 
-  widget_sizer(); /* Perhaps adjust relative sizes of the main widgets. */
+  /* What's dirty: the change, and any tokens that look different now. */
+  int dirty_start= text.size();
+  int dirty_end= 0;
+  if (change_position == -2) {} /* nothing typed, so only what the comparison below finds */
+  else if ((change_position == -1) || (change_position + change_added > text.size())) is_all_dirty= true;
+  else
+  {
+    dirty_start= change_position;
+    dirty_end= change_position + change_added;
+  }
+  if (editor_token_highlights != 0)
+  {
+    unsigned int old_count= editor_token_highlights_count;
+    unsigned int front= 0, back= 0;
+    while ((front < count) && (front < old_count) && (highlights[front] == editor_token_highlights[front])) ++front;
+    while ((back < count - front) && (back < old_count - front)
+        && (highlights[count - 1 - back] == editor_token_highlights[old_count - 1 - back])) ++back;
+    if (front < count - back)
+    {
+      if (main_token_offsets[front] < dirty_start) dirty_start= main_token_offsets[front];
+      i= count - back - 1;
+      if (main_token_offsets[i] + main_token_lengths[i] > dirty_end) dirty_end= main_token_offsets[i] + main_token_lengths[i];
+    }
+    delete [] editor_token_highlights;
+  }
+  else is_all_dirty= true;
+  editor_token_highlights= highlights;
+  editor_token_highlights_count= count;
 
-  statement_edit_widget->document()->blockSignals(false);
-  statement_edit_widget_text_changed_flag= 0;
-  log("action_statement_edit_widget_text_changed end", 90);
+  /* Merge with what was dirty before, which was in terms of the text before this change. */
+  if (is_all_dirty)
+  {
+    statement_highlight_dirty_start= 0;
+    statement_highlight_dirty_end= text.size();
+  }
+  else
+  {
+    if (statement_highlight_dirty_start <= statement_highlight_dirty_end)
+    {
+      if (statement_highlight_dirty_start > change_position)
+      {
+        statement_highlight_dirty_start+= delta;
+        if (statement_highlight_dirty_start < change_position) statement_highlight_dirty_start= change_position;
+      }
+      if (statement_highlight_dirty_end > change_position)
+      {
+        statement_highlight_dirty_end+= delta;
+        if (statement_highlight_dirty_end < change_position + change_added) statement_highlight_dirty_end= change_position + change_added;
+      }
+      if (statement_highlight_dirty_start < dirty_start) dirty_start= statement_highlight_dirty_start;
+      if (statement_highlight_dirty_end > dirty_end) dirty_end= statement_highlight_dirty_end;
+    }
+    if (dirty_end > text.size()) dirty_end= text.size();
+    statement_highlight_dirty_start= dirty_start;
+    statement_highlight_dirty_end= dirty_end;
+  }
+  statement_highlight_visible(0);
 }
 
 
 /*
-  For menu item "connect" we said connect(...SLOT(action_connect())));
-  By default this is on and associated with File|Connect menu item.
-  Actually connect will be attempted depending on defaults and command-line parameters.
+  Rehighlight the part of the dirty range that's on the screen.
+  The dirty range is empty if statement_highlight_dirty_start > statement_highlight_dirty_end.
+  Slot for statement_edit_widget vertical scroll bar, also called by statement_highlight().
+  If what's on the screen is at the start or end of the dirty range, the range shrinks.
 */
-void MainWindow::action_connect()
+void MainWindow::statement_highlight_visible(int value)
 {
-  action_connect_once(tr("File|Connect"));
+  (void) value;
+  if (statement_highlight_dirty_start > statement_highlight_dirty_end) return;
+  int first_position= statement_edit_widget->cursorForPosition(QPoint(0, 0)).position();
+  int last_position= statement_edit_widget->cursorForPosition(QPoint(statement_edit_widget->viewport()->width(),
+                                                                      statement_edit_widget->viewport()->height())).position();
+  int start= statement_highlight_dirty_start;
+  if (start < first_position) start= first_position;
+  int end= statement_highlight_dirty_end;
+  if (end > last_position) end= last_position;
+  if (start > end) return;
+  QTextDocument *document= statement_edit_widget->document();
+  bool was_blocked= document->blockSignals(true);
+  QTextBlock block;
+  int end_of_block= start;
+  for (block= document->findBlock(start); (block.isValid()) && (block.position() <= end); block= block.next())
+  {
+    statement_highlighter->highlight_block(block);
+    end_of_block= block.position() + block.length();
+  }
+  document->blockSignals(was_blocked);
+  if (start <= statement_highlight_dirty_start) statement_highlight_dirty_start= end_of_block;
+  else if (end >= statement_highlight_dirty_end) statement_highlight_dirty_end= start - 1;
 }
 
 
 /*
-  If we're connecting, action_connect() calls action_connect_once with arg = "File|Connect".
+  Put editor_token_* back in main_token_*, as they were before
+  tokens_to_keywords_context() and hparse, then redo
+  tokens_to_keywords_context(). For when hparse was cancelled halfway,
+  or something else used main_token_* since the last text change.
+*/
+void MainWindow::editor_tokens_restore()
+{
+  if (editor_token_is_valid == false) return;
+  unsigned int count= editor_token_count;
+  main_token_new(editor_token_text.size());
+  memcpy(main_token_offsets, editor_token_offsets, (count + 1) * sizeof(int));
+  memcpy(main_token_lengths, editor_token_lengths, (count + 1) * sizeof(int));
+  memcpy(main_token_types, editor_token_types, (count + 1) * sizeof(int));
+  memcpy(main_token_flags, editor_token_flags, (count + 1) * sizeof(unsigned int));
+  memset(main_token_pointers, 0, (count + 1) * sizeof(int));
+  memset(main_token_reftypes, 0, (count + 1) * sizeof(unsigned char));
+  main_token_count_in_all= count;
+  tokens_to_keywords_context(editor_token_text, 0);
+}
+
+
+/*
+  For menu item "connect" we said connect(...SLOT(action_connect())));
+  By default this is on and associated with File|Connect menu item.
+  Actually connect will be attempted depending on defaults and command-line parameters.
+*/
+void MainWindow::action_connect()
+{
+  action_connect_once(tr("File|Connect"));
+}
+
+
+/*
+  If we're connecting, action_connect() calls action_connect_once with arg = "File|Connect".
   If we're printing for --help, print_help calls action_connect_once with arg = "Print".
   Todo:
   If user types OK and there's an error, repeat the dialog box with a new message e.g. "Connect failed ...".
@@ -3144,6 +4066,7 @@ void MainWindow::action_change_one_setting(QString old_setting,
   {
     QString text;
     old_setting= new_setting;
+    hparse_background_finish();
     main_token_number= 0;
     text= "SET ";
     text.append(name_of_setting);
@@ -4061,6 +4984,79 @@ int MainWindow::make_statement_ready_to_send(QString text, char *dbms_query, int
   return (strlen(dbms_query));
 }
 
+/*
+  Same result as make_statement_ready_to_send(), but for the statement that's
+  already in main_token_* i.e. main_token_number .. main_token_number +
+  main_token_count_in_statement - 1, with offsets relative to text.
+  So no call to tokenize(), no token arrays to allocate, and one UTF8
+  conversion for the whole statement instead of one per token.
+  Puts the result in dbms_query (new[]) and dbms_query_len.
+  If parameters != NULL, literals that prepared_statement_is_parameter()
+  accepts are sent as ? and appended to parameters.
+*/
+void MainWindow::make_statement_ready_to_send_from_tokens(QString text, QStringList *parameters)
+{
+  unsigned int i_start= main_token_number;
+  unsigned int i_end= main_token_number + main_token_count_in_statement;
+  const QChar *p= text.constData();
+  int text_size= text.size();
+  bool is_delimiter_semicolon= ((ocelot_delimiter_str.size() == 1) && (ocelot_delimiter_str.at(0) == ';'));
+  QString q;
+  if (i_end > i_start)
+    q.reserve(main_token_offsets[i_end - 1] + main_token_lengths[i_end - 1] - main_token_offsets[i_start]);
+  for (unsigned int i= i_start; i < i_end; ++i)
+  {
+    int offset= main_token_offsets[i];
+    int length= main_token_lengths[i];
+    int next_length= 0;
+    if (i + 1 < i_end) next_length= main_token_lengths[i + 1];
+    QChar c0= p[offset];
+    QChar c1= (offset + 1 < text_size) ? p[offset + 1] : QChar(' ');
+    /* Don't send comments unless --comments or equivalent, or comment is / * special ... */
+    if (ocelot_comments == 0)
+    {
+      if (((c0 == '/') && (c1 == '*'))
+       || ((c0 == '-') && (c1 == '-'))
+       || (c0 == '#'))
+      {
+        if ((text.mid(offset, 3) != "/*!")
+         && (text.mid(offset, 4) != "/*M!"))
+        {
+          q.append(QLatin1Char(' '));
+          continue;
+        }
+      }
+    }
+    /* Don't send \G or \g */
+    if ((next_length == 1) && (c0 == '\\') && ((c1 == 'G') || (c1 == 'g')))
+    {
+      ++i;
+      continue;
+    }
+    /* Don't send delimiter unless it is ; */
+    if ((is_delimiter_semicolon == false)
+     && (c0 == ocelot_delimiter_str.at(0))
+     && (text.mid(offset, ocelot_delimiter_str.length()) == ocelot_delimiter_str))
+    {
+      break;
+    }
+    /* Preserve whitespace after a token, unless this is the last token */
+    if (next_length != 0) length= main_token_offsets[i + 1] - offset;
+    if ((parameters != NULL) && (prepared_statement_is_parameter(text, i, i_start)))
+    {
+      parameters->append(text.mid(offset, main_token_lengths[i]));
+      q.append(QLatin1Char('?'));
+      q.append(QString::fromRawData(p + offset + main_token_lengths[i], length - main_token_lengths[i]));
+      continue;
+    }
+    q.append(QString::fromRawData(p + offset, length));
+  }
+  QByteArray q_as_utf8= q.toUtf8();           /* See comment "UTF8 Conversion" */
+  dbms_query_len= q_as_utf8.size();
+  dbms_query= new char[dbms_query_len + 1];
+  memcpy(dbms_query, q_as_utf8.constData(), dbms_query_len + 1);
+}
+
 /*
   select_1_row() is a convenience routine, made because frequently there are single-row selects.
   And if they are multiple-row selects, we can always do them one-at-a-time with limit and offset clauses.
@@ -4134,3220 +5130,6191 @@ int volatile kill_connection_id;
 #define LONG_QUERY_STATE_ENDED 1
 char *dbms_query;
 int dbms_query_len;
-int dbms_query_connection_number;
 volatile int dbms_long_query_result;
 volatile int dbms_long_query_state= LONG_QUERY_STATE_ENDED;
 
+/* Request types for dbms_executor_run(), see dbms_executor_thread() */
+#define DBMS_EXECUTOR_REAL_QUERY 1
+#define DBMS_EXECUTOR_NEXT_RESULT 2
+#define DBMS_EXECUTOR_STOP 3
+#define DBMS_EXECUTOR_STMT_PREPARE 4 /* see prepared_statement_run() */
+#define DBMS_EXECUTOR_STMT_EXECUTE 5
 
-#ifdef DEBUGGER
 
 /*
-  Debug
-
-  Re debug_top_widget: It's a QWidget which contains a status line and debug_tab_widget.
-
-  Re debug_tab_widget: It's a QTabWidget which may contain more than one debug_widget.
-
-  Re debug_widget: it's derived from CodeEditor just as statement_edit_widget is, and it uses the
-  same stylesheet as statement_edit_widget. It starts hidden, but debug|initialize shows it.
-  It will contain the text of a procedure which is being debugged.
-  Actually debug_widget[] occurs 10 times -- todo: there's no check for overflow.
-
-  Re statements that come via statement_edit_widget: suppose the statement is "$DEB p8;".
-  During tokens_to_keywords() we recognize that this is TOKEN_KEYWORD_DEBUG_DEBUG and highlight appropriately.
-  During execute_client_statement(), after we check if statement_type == TOKEN_DEBUG_DEBUG_DEBUG and find that
-  it's true, there's a call to action_debug_debug() followed by "return 1". When we're in action_debug_debug(),
-  we have access to main_tokens so we can say things like "QString s= text.mid(main_token_offsets[i], main_token_lengths[i]);".
+  Lazy BLOB|TEXT fetching, for SET ocelot_grid_lazy_blob_length = n where n > 0.
+  If the statement is
+    SELECT * FROM [database.]table [WHERE ...] [ORDER BY ...] [LIMIT ...]
+  we look up the table's columns in information_schema, and change the select
+  list so that each BLOB or TEXT column becomes
+    LEFT(column, n) AS column
+  so a table with megabyte documents doesn't cause megabytes to go over the
+  network, into result_set_copy, and through scan_rows() + the grid layout.
+  ResultGrid remembers lazy_blob_table and lazy_blob_column_names, and when
+  the user double-clicks a truncated cell, lazy_blob_fetch() gets the full
+  value by primary key. So we don't rewrite if there's no primary key.
+  We set lazy_blob_table + lazy_blob_column_names, or clear them if we return
+  the statement unchanged (query_utf16).
+  Todo: allow a column list, aliases, joins. That needs hparse reftypes.
+  Todo: LEFT() counts characters, not bytes, so for a multi-byte TEXT column
+        scan_rows() may think a value is truncated when it isn't. That is
+        harmless, double-click would just fetch the same value again.
+  Todo: the information_schema lookup costs a round trip per statement.
+        Cache by table name, but then we'd need to notice ALTER TABLE.
 */
+QString MainWindow::lazy_blob_rewrite(QString text)
+{
+  int i= main_token_number;
+  int i_end= main_token_number + main_token_count_in_statement;
+  int i_of_from, i_of_table_start, i_of_table_end;
+  QString schema_name= "", table_name= "";
+
+  lazy_blob_table= "";
+  lazy_blob_column_names.clear();
+  if (ocelot_grid_lazy_blob_length == 0) return query_utf16;
+  if ((connections_dbms[0] != DBMS_MYSQL) && (connections_dbms[0] != DBMS_MARIADB)) return query_utf16;
+  if (i + 4 > i_end) return query_utf16;
+  if (main_token_types[i] != TOKEN_KEYWORD_SELECT) return query_utf16;
+  if (text.mid(main_token_offsets[i + 1], main_token_lengths[i + 1]) != "*") return query_utf16;
+  if (main_token_types[i + 2] != TOKEN_KEYWORD_FROM) return query_utf16;
+  i_of_from= i + 2;
+
+  /* [database.]table, where each part is `quoted` or is a word that isn't reserved */
+  i_of_table_start= i + 3;
+  for (i= i_of_table_start;; i+= 2)
+  {
+    if (i >= i_end) return query_utf16;
+    int t= main_token_types[i];
+    if ((t != TOKEN_TYPE_IDENTIFIER_WITH_BACKTICK)
+     && (t != TOKEN_TYPE_IDENTIFIER)
+     && (t != TOKEN_TYPE_OTHER)
+     && ((t < TOKEN_KEYWORDS_START) || ((main_token_flags[i] & TOKEN_FLAG_IS_RESERVED) != 0)))
+      return query_utf16;
+    if (text.mid(main_token_offsets[i], 1) == "@") return query_utf16;
+    schema_name= table_name;
+    table_name= connect_stripper(text.mid(main_token_offsets[i], main_token_lengths[i]), false);
+    if ((i + 1 < i_end)
+     && (text.mid(main_token_offsets[i + 1], main_token_lengths[i + 1]) == "."))
+    {
+      if (i != i_of_table_start) return query_utf16;
+      continue;
+    }
+    break;
+  }
+  i_of_table_end= i;
 
-/* This means "while debugger is going check status 20 times per second" (50 = 50 milliseconds). */
-#define DEBUG_TIMER_INTERVAL 50
-
-#define DEBUGGEE_STATE_0 0
-#define DEBUGGEE_STATE_CONNECT_THREAD_STARTED 1
-#define DEBUGGEE_STATE_BECOME_DEBUGEE_CONNECTION 2
-#define DEBUGGEE_STATE_DEBUGGEE_WAIT_LOOP 3
-#define DEBUGGEE_STATE_CONNECT_FAILED -1
-#define DEBUGGEE_STATE_MYSQL_REAL_QUERY_ERROR -2
-#define DEBUGGEE_STATE_MYSQL_STORE_RESULT_ERROR -3
-#define DEBUGGEE_STATE_MYSQL_FETCH_ROW_ERROR -4
-#define DEBUGGEE_STATE_BECOME_DEBUGGEE_CONNECTION_ERROR -5
-#define DEBUGGEE_STATE_DEBUGGEE_WAIT_LOOP_ERROR -6
-#define DEBUGGEE_STATE_END -7
-
-char debuggee_channel_name[128]= "";
-int volatile debuggee_state= DEBUGGEE_STATE_0;
-char debuggee_state_error[STRING_LENGTH_512]= "";
-char debuggee_information_status_debugger_name[32];
-char debuggee_information_status_debugger_version[8];
-char debuggee_information_status_timestamp_of_status_message[32];
-char debuggee_information_status_number_of_status_message[8];
-char debuggee_information_status_icc_count[8];
-char debuggee_information_status_schema_identifier[256];
-char debuggee_information_status_routine_identifier[256];
-char debuggee_information_status_line_number[8];
-char debuggee_information_status_is_at_breakpoint[8];
-char debuggee_information_status_is_at_tbreakpoint[8];
-char debuggee_information_status_is_at_routine_exit[8];
-char debuggee_information_status_stack_depth[8];
-char debuggee_information_status_last_command[256];
-char debuggee_information_status_last_command_result[256];
-char debuggee_information_status_commands_count[8];
-
-QString debug_routine_schema_name[DEBUG_TAB_WIDGET_MAX + 1];
-QString debug_routine_name[DEBUG_TAB_WIDGET_MAX + 1];
-
-QString debug_q_schema_name_in_statement;
-QString debug_q_routine_name_in_statement;
-QString debug_statement;
+  /* What follows must be nothing, WHERE, ORDER, LIMIT, or delimiter, and no subqueries or unions */
+  i= i_of_table_end + 1;
+  if (i < i_end)
+  {
+    int t= main_token_types[i];
+    if ((t != TOKEN_KEYWORD_WHERE)
+     && (t != TOKEN_KEYWORD_ORDER)
+     && (t != TOKEN_KEYWORD_LIMIT)
+     && (t != TOKEN_TYPE_DELIMITER)
+     && (text.mid(main_token_offsets[i], main_token_lengths[i]) != ocelot_delimiter_str))
+      return query_utf16;
+  }
+  for (; i < i_end; ++i)
+  {
+    int t= main_token_types[i];
+    if ((t == TOKEN_KEYWORD_SELECT) || (t == TOKEN_KEYWORD_UNION)
+     || (t == TOKEN_KEYWORD_INTO) || (t == TOKEN_KEYWORD_JOIN))
+      return query_utf16;
+  }
 
-QTimer *debug_timer;                                    /* For calling action_debug_timer_status() every 1/10 seconds */
-int debug_timer_old_line_number;
-char debug_timer_old_schema_identifier[256];
-char debug_timer_old_routine_identifier[256];
-int volatile debuggee_connection_id;                             /* Save this if you need to kill the debuggee (an unusual need) */
-int debug_timer_old_commands_count;
-int debug_timer_old_number_of_status_message;
-int debug_timer_old_icc_count;
-int debug_timer_old_debug_widget_index;
+  /* Ask the server what the columns are */
+  QString query_for_columns= "SELECT column_name, data_type, column_key FROM information_schema.columns WHERE table_schema = ";
+  if (schema_name == "") query_for_columns.append("database()");
+  else
+  {
+    query_for_columns.append("'");
+    query_for_columns.append(schema_name.replace("\\", "\\\\").replace("'", "''"));
+    query_for_columns.append("'");
+  }
+  query_for_columns.append(" AND table_name = '");
+  query_for_columns.append(table_name.replace("\\", "\\\\").replace("'", "''"));
+  query_for_columns.append("' ORDER BY ordinal_position");
 
+  /* Through the executor, so the GUI isn't frozen and Run|Kill works if information_schema is slow */
+  QByteArray query_for_columns_as_utf8= query_for_columns.toUtf8();
+  MYSQL_RES *res;
+  if (dbms_executor_run(MYSQL_MAIN_CONNECTION, DBMS_EXECUTOR_REAL_QUERY,
+                        query_for_columns_as_utf8.constData(),
+                        query_for_columns_as_utf8.size(), &res) != 0)
+    return query_utf16;
+  if (res == NULL) return query_utf16;
+
+  QString select_list= "";
+  bool is_primary_key_seen= false;
+  MYSQL_ROW row;
+  while ((row= lmysql->ldbms_mysql_fetch_row(res)) != NULL)
+  {
+    if ((row[0] == NULL) || (row[1] == NULL)) continue;
+    QString column_name= QString::fromUtf8(row[0]);
+    QString data_type= QString::fromUtf8(row[1]).toLower();
+    QString quoted_column_name= column_name;
+    quoted_column_name.replace("`", "``");
+    quoted_column_name= "`" + quoted_column_name + "`";
+    if (select_list != "") select_list.append(",");
+    if ((data_type.endsWith("blob")) || (data_type.endsWith("text")))
+    {
+      select_list.append("LEFT(");
+      select_list.append(quoted_column_name);
+      select_list.append(",");
+      select_list.append(QString::number(ocelot_grid_lazy_blob_length));
+      select_list.append(") AS ");
+      select_list.append(quoted_column_name);
+      lazy_blob_column_names.append(column_name);
+    }
+    else select_list.append(quoted_column_name);
+    if ((row[2] != NULL) && (strcmp(row[2], "PRI") == 0)) is_primary_key_seen= true;
+  }
+  lmysql->ldbms_mysql_free_result(res);
 
+  if ((is_primary_key_seen == false) || (lazy_blob_column_names.count() == 0))
+  {
+    lazy_blob_column_names.clear();
+    return query_utf16;
+  }
+  lazy_blob_table= text.mid(main_token_offsets[i_of_table_start],
+                            main_token_offsets[i_of_table_end] + main_token_lengths[i_of_table_end]
+                            - main_token_offsets[i_of_table_start]);
+  QString rewritten_query= "SELECT ";
+  rewritten_query.append(select_list);
+  rewritten_query.append(" ");
+  rewritten_query.append(text.mid(main_token_offsets[i_of_from],
+                                  main_token_offsets[i_end - 1] + main_token_lengths[i_end - 1]
+                                  - main_token_offsets[i_of_from]));
+  return rewritten_query;
+}
 
 /*
-  Enable or disable debug menu items.
-  If debug succeeds: most items after debug are enabled. (Todo: eventually all should be enabled.)
-  If exit succeeds: most items after debug are disabled.
+  Called from ResultGrid::lazy_blob_fetch() with SELECT column FROM table WHERE primary-key = ...
+  Like select_1_row() but we want one value, which may be binary, with its length.
+  Return 0 if ok, else 1.
+  This uses the main connection, so it must not happen while a statement is running.
+  It goes through the executor, so the GUI isn't frozen while a big value comes.
 */
-void MainWindow::debug_menu_enable_or_disable(int statement_type)
-{
-  bool e;
-
-  if (statement_type == TOKEN_KEYWORD_BEGIN) e= false;
-  if (statement_type == TOKEN_KEYWORD_DEBUG_DEBUG) e= true;
-  if (statement_type == TOKEN_KEYWORD_DEBUG_EXIT) e= false;
-
-//  menu_debug_action_install->setEnabled(e);
-//  menu_debug_action_setup->setEnabled(e);
-//  menu_debug_action_debug->setEnabled(e);
-  menu_debug_action_breakpoint->setEnabled(e);
-  menu_debug_action_continue->setEnabled(e);
-//  menu_debug_action_leave->setEnabled(e);
-  menu_debug_action_next->setEnabled(e);
-//  menu_debug_action_skip->setEnabled(e);
-  menu_debug_action_step->setEnabled(e);
-  menu_debug_action_clear->setEnabled(e);
-//  menu_debug_action_delete->setEnabled(e);
-  menu_debug_action_exit->setEnabled(e);                                      /* everything after debug goes gray after this succeeds */
-  menu_debug_action_information->setEnabled(e);
-  menu_debug_action_refresh_server_variables->setEnabled(e);
-  menu_debug_action_refresh_user_variables->setEnabled(e);
-  menu_debug_action_refresh_variables->setEnabled(e);
-  menu_debug_action_refresh_call_stack->setEnabled(e);
-}
-
-
-void MainWindow::create_widget_debug()
+int MainWindow::lazy_blob_select(QString select_statement, QByteArray *value)
 {
-  /* We make debug_tab_widget now but we don't expect anyone to see it until debug|setup happens. */
-  /* Todo: should you create with an initially-hidden flag? */
-  debug_top_widget= new QWidget(this);              /* 2015-08-25 added "this" */
-  debug_top_widget->hide();                         /* hidden until debug|initialize is executed */
-
-  /*
-    Todo: check: am I doing it right by saying parent = debug_top_widget
-    i.e. will automatic delete happen when debug_top_widget is deleted?
-    or will there be a memory leak?
-    Hmm, why do I care? I don't delete debug_top_widget anyway, do I?
-    Hmm Hmm, yes I do but it must be an error.
-  */
-
-  debug_line_widget= new QLineEdit(debug_top_widget);
-  debug_line_widget->setText("Debugger Status = Inactive");
-  debug_tab_widget= new QTabWidget(debug_top_widget);
-
-  debug_top_widget_layout= new QVBoxLayout(debug_top_widget);
-  debug_top_widget_layout->addWidget(debug_line_widget);
-  debug_top_widget_layout->addWidget(debug_tab_widget);
-  debug_top_widget->setLayout(debug_top_widget_layout);
-
-  /* We make debug_timer now but we don't start it until debug status can be shown. */
-  debug_timer= new QTimer(this);
-  connect(debug_timer, SIGNAL(timeout()), this, SLOT(action_debug_timer_status()));
-
-  /* This must be done before we set statement stylesheet. */
-  for (int i= 0; i < DEBUG_TAB_WIDGET_MAX; ++i) debug_widget[i]= 0;
-
+  MYSQL_RES *res;
+  MYSQL_ROW row;
+  unsigned long *lengths;
+  int return_value= 1;
+
+  if (connections_is_connected[0] != 1) return 1;
+  if (dbms_long_query_state == LONG_QUERY_STATE_STARTED) return 1;
+  QByteArray select_statement_as_utf8= select_statement.toUtf8();
+  if (dbms_executor_run(MYSQL_MAIN_CONNECTION, DBMS_EXECUTOR_REAL_QUERY,
+                        select_statement_as_utf8.constData(),
+                        select_statement_as_utf8.size(), &res) != 0)
+    return 1;
+  if (res == NULL) return 1;
+  row= lmysql->ldbms_mysql_fetch_row(res);
+  if ((row != NULL) && (row[0] != NULL))
+  {
+    lengths= lmysql->ldbms_mysql_fetch_lengths(res);
+    *value= QByteArray(row[0], lengths[0]);
+    return_value= 0;
+  }
+  lmysql->ldbms_mysql_free_result(res);
+  return return_value;
 }
 
-
-//#include <pthread.h>
-
 /*
-  The debuggee is a separate thread and makes its own connection using ocelot_ parameters just like the main connection.
-  Problem: debuggee_thread() cannot be in MainWindow (at least, I didn't figure out how to make it in MainWindow).
-  That explains why I made a lot of things global.
-  Todo: Check: Why do you end statements with ";"?
-  Todo: If an error occurs, copy the whole thing into a fixed-size char so debugger can see it.
-        And notice that the result is that the thread ends, so beware of racing and worry about cleanup.
+  Streaming export, for SET ocelot_export_format = 'csv'|'tsv'|'jsonl'|'insert'|'html'|'xml'.
+  While ocelot_export_format <> '', a result set does not go to the result
+  grid. We say mysql_use_result() instead of mysql_store_result(), so the
+  rows are never all in client memory at once, and write them to
+  ocelot_export_file, or if ocelot_export_file starts with '|' to the
+  standard input of a command started with popen(), for example
+    SET ocelot_export_file = '|gzip > /tmp/x.csv.gz';
+  Formats:
+    csv    header line, "..." around a value if it contains , " CR or LF,
+           NULL is an empty field
+    tsv    like mysql --batch: header line, tab newline backslash and \0
+           are escaped, NULL is \N
+    jsonl  one {"column":value,...} object per line, NULL is null,
+           BINARY|VARBINARY|BLOB values are hex strings
+    insert INSERT INTO table (columns) VALUES (...),...; with up to
+           EXPORT_ROWS_PER_CHUNK rows per statement. The table name is the
+           org_table of the first column, so this is for single-table selects.
+    html   like mysql --html: <TABLE BORDER=1><TR><TH>...
+    xml    like mysql --xml: <resultset statement=...><row><field name=...
+  If ocelot_export_file = '' the output goes to stdout, and also to the
+  tee file if TEE is on. That is also what happens for a headless run,
+  ocelotgui --batch|--html|--xml --execute='...', see run_headless().
+  Fetching happens in export_thread() while the main thread waits in
+  dbms_long_query_wait(), so Run|Kill works. export_thread()
+  copies rows into a chunk in the same [length][flag][bytes] layout that
+  ResultGrid uses for result_set_copy, and when the chunk is full it starts
+  an export_format_thread() for it. There are EXPORT_CHUNKS chunks in a ring,
+  so up to EXPORT_CHUNKS chunks are being formatted while the next one is
+  being fetched. Before a chunk is reused we pthread_join() its formatter
+  and fwrite() its output, so output order is always fetch order.
+  If a CALL returns several result sets they all go to the same file.
+  The export_* globals are only changed when no formatter is running.
+  Todo: Tarantool.
 */
+#define EXPORT_FORMAT_CSV 1
+#define EXPORT_FORMAT_TSV 2
+#define EXPORT_FORMAT_JSONL 3
+#define EXPORT_FORMAT_INSERT 4
+#define EXPORT_FORMAT_HTML 5
+#define EXPORT_FORMAT_XML 6
+#define EXPORT_ROWS_PER_CHUNK 1000
+#define EXPORT_CHUNKS 4
+
+struct export_chunk
+{
+  pthread_t thread_id;
+  bool is_thread_started;
+  unsigned int row_count;
+  QByteArray raw;                   /* rows as [unsigned int length][char flag][bytes] */
+  QByteArray formatted;             /* what export_format_thread() made from raw */
+};
+
+static int export_format;
+static bool export_is_header;       /* false if --skip-column-names */
+static bool export_is_raw;          /* true if --raw, so no tsv escapes */
+static QByteArray export_statement; /* for <resultset statement="..."> */
+static FILE *export_file;
+static bool export_is_pipe;         /* export_file came from popen() */
+static bool export_is_stdout;       /* export_file is stdout */
+static QFile *export_tee_file= 0;   /* if export_file is stdout and TEE is on */
+static MYSQL_RES *export_res;
+static unsigned int export_connection_number;
+static unsigned int export_column_count;
+static bool *export_is_number= 0;   /* e.g. INT or DECIMAL, so no quotes */
+static bool *export_is_binary= 0;   /* BINARY|VARBINARY|BLOB|GEOMETRY, so hex for jsonl + insert */
+static QList<QByteArray> export_json_names; /* "name": */
+static QByteArray export_insert_prefix;     /* INSERT INTO `t` (`a`,`b`) VALUES */
+static unsigned long long export_row_count;
+static int export_write_error;
+static int export_fetch_error;
+static bool export_is_cancelled;    /* export_thread() started a kill_thread() */
+static pthread_t export_kill_thread_id;
+static export_chunk export_chunks[EXPORT_CHUNKS];
+
+void* kill_thread(void* unused);
+
+static void export_write(const QByteArray &data)
+{
+  if (export_write_error != 0) return;
+  if (data.size() == 0) return;
+  if (fwrite(data.constData(), 1, data.size(), export_file) != (size_t) data.size())
+    export_write_error= 1;
+  if (export_tee_file != 0) export_tee_file->write(data);
+}
 
-void* debuggee_thread(void* unused)
+/* Append with & < > " escaped, for html + xml. */
+static void export_append_markup(QByteArray *out, const char *p, unsigned int length)
 {
-  (void) unused; /* suppress "unused parameter" warning */
-  char call_statement[512];
-  int is_connected= 0;
-  MYSQL_RES *debug_res= NULL;
-  MYSQL_ROW debug_row= NULL;
-  const char *unexpected_error= NULL;
+  for (unsigned int i= 0; i < length; ++i)
+  {
+    if (p[i] == '&') out->append("&amp;");
+    else if (p[i] == '<') out->append("&lt;");
+    else if (p[i] == '>') out->append("&gt;");
+    else if (p[i] == '"') out->append("&quot;");
+    else out->append(p[i]);
+  }
+}
 
-  debuggee_connection_id= 0;
+static void export_append_hex(QByteArray *out, const char *p, unsigned int length)
+{
+  static const char hex_digits[]= "0123456789ABCDEF";
+  for (unsigned int i= 0; i < length; ++i)
+  {
+    out->append(hex_digits[((unsigned char) p[i]) >> 4]);
+    out->append(hex_digits[((unsigned char) p[i]) & 0x0f]);
+  }
+}
 
-  memset(debuggee_state_error, 0, STRING_LENGTH_512);
-  debuggee_state= DEBUGGEE_STATE_CONNECT_THREAD_STARTED;
+/* Append "...", escaped for JSON. We assume the value is UTF-8. */
+static void export_append_json_string(QByteArray *out, const char *p, unsigned int length)
+{
+  char u_escape[8];
+  out->append('"');
+  for (unsigned int i= 0; i < length; ++i)
+  {
+    unsigned char c= p[i];
+    if (c == '"') out->append("\\\"");
+    else if (c == '\\') out->append("\\\\");
+    else if (c == '\n') out->append("\\n");
+    else if (c == '\r') out->append("\\r");
+    else if (c == '\t') out->append("\\t");
+    else if (c < 0x20) { sprintf(u_escape, "\\u%04x", c); out->append(u_escape); }
+    else out->append((char) c);
+  }
+  out->append('"');
+}
 
-  for (;;)
+/* Append one non-NULL value in the style of export_format. */
+static void export_append_value(QByteArray *out, const char *p, unsigned int length, unsigned int column_number)
+{
+  if (export_format == EXPORT_FORMAT_CSV)
   {
-    /*
-      The debuggee connection.
-      Todo: the_connect() could easily fail: parameters are changed, # of connections = max, password no longer works, etc.
-            ... so you should try to pass back a better explanation if the_connect() fails here.
-    */
-    if (options_and_connect(MYSQL_DEBUGGER_CONNECTION))
+    unsigned int i;
+    for (i= 0; i < length; ++i)
     {
-       debuggee_state= DEBUGGEE_STATE_CONNECT_FAILED;
-       strncpy(debuggee_state_error, lmysql->ldbms_mysql_error(&mysql[MYSQL_DEBUGGER_CONNECTION]), STRING_LENGTH_512 - 1);
-       break;
+      if ((p[i] == ',') || (p[i] == '"') || (p[i] == '\n') || (p[i] == '\r')) break;
     }
-
-    is_connected= 1;
-
-    /* Get connection_id(). This is only in case regular "exit" fails and we have to issue a kill statement. */
-    strcpy(call_statement, "select connection_id();");
-    if (lmysql->ldbms_mysql_real_query(&mysql[MYSQL_DEBUGGER_CONNECTION], call_statement, strlen(call_statement)))
+    if (i == length) { out->append(p, length); return; }
+    out->append('"');
+    for (i= 0; i < length; ++i)
     {
-      debuggee_state= DEBUGGEE_STATE_MYSQL_REAL_QUERY_ERROR;
-      strncpy(debuggee_state_error, lmysql->ldbms_mysql_error(&mysql[MYSQL_DEBUGGER_CONNECTION]), STRING_LENGTH_512 - 1);
-      break;
+      if (p[i] == '"') out->append('"');
+      out->append(p[i]);
     }
-    debug_res= lmysql->ldbms_mysql_store_result(&mysql[MYSQL_DEBUGGER_CONNECTION]);
-    if (debug_res == NULL)
-    {
-      debuggee_state= DEBUGGEE_STATE_MYSQL_STORE_RESULT_ERROR;
-      strncpy(debuggee_state_error, lmysql->ldbms_mysql_error(&mysql[MYSQL_DEBUGGER_CONNECTION]), STRING_LENGTH_512 - 1);
-      break;
-    }
-    debug_row= lmysql->ldbms_mysql_fetch_row(debug_res);
-    if (debug_row == NULL)
+    out->append('"');
+    return;
+  }
+  if ((export_format == EXPORT_FORMAT_HTML) || (export_format == EXPORT_FORMAT_XML))
+  {
+    export_append_markup(out, p, length);
+    return;
+  }
+  if ((export_format == EXPORT_FORMAT_TSV) && (export_is_raw == true))
+  {
+    out->append(p, length);
+    return;
+  }
+  if (export_format == EXPORT_FORMAT_TSV)
+  {
+    for (unsigned int i= 0; i < length; ++i)
     {
-      debuggee_state= DEBUGGEE_STATE_MYSQL_FETCH_ROW_ERROR;
-      strncpy(debuggee_state_error, lmysql->ldbms_mysql_error(&mysql[MYSQL_DEBUGGER_CONNECTION]), STRING_LENGTH_512 - 1);
-      lmysql->ldbms_mysql_free_result(debug_res);
-      break;
+      if (p[i] == '\t') out->append("\\t");
+      else if (p[i] == '\n') out->append("\\n");
+      else if (p[i] == '\\') out->append("\\\\");
+      else if (p[i] == '\0') out->append("\\0");
+      else out->append(p[i]);
     }
-    debuggee_connection_id= atoi(debug_row[0]);
-    lmysql->ldbms_mysql_free_result(debug_res);
-
-    strcpy(call_statement, "call xxxmdbug.become_debuggee_connection('");
-    strcat(call_statement, debuggee_channel_name);
-    strcat(call_statement, "');");
-    debuggee_state= DEBUGGEE_STATE_BECOME_DEBUGEE_CONNECTION;
-    if (lmysql->ldbms_mysql_real_query(&mysql[MYSQL_DEBUGGER_CONNECTION], call_statement, strlen(call_statement)))
+    return;
+  }
+  if (export_is_number[column_number] == true) { out->append(p, length); return; }
+  if (export_format == EXPORT_FORMAT_JSONL)
+  {
+    if (export_is_binary[column_number] == true)
     {
-      debuggee_state= DEBUGGEE_STATE_BECOME_DEBUGGEE_CONNECTION_ERROR;
-      strncpy(debuggee_state_error, lmysql->ldbms_mysql_error(&mysql[MYSQL_DEBUGGER_CONNECTION]), STRING_LENGTH_512 - 1);
-      break;
+      out->append('"');
+      export_append_hex(out, p, length);
+      out->append('"');
     }
+    else export_append_json_string(out, p, length);
+    return;
+  }
+  /* EXPORT_FORMAT_INSERT */
+  if (export_is_binary[column_number] == true)
+  {
+    out->append("X'");
+    export_append_hex(out, p, length);
+    out->append('\'');
+    return;
+  }
+  out->append('\'');
+  for (unsigned int i= 0; i < length; ++i)
+  {
+    if (p[i] == '\'') out->append("\\'");
+    else if (p[i] == '\\') out->append("\\\\");
+    else if (p[i] == '\n') out->append("\\n");
+    else if (p[i] == '\r') out->append("\\r");
+    else if (p[i] == '\0') out->append("\\0");
+    else if (p[i] == '\032') out->append("\\Z");
+    else out->append(p[i]);
+  }
+  out->append('\'');
+}
 
-    /*
-      Originally we just had debuggee_wait_loop here.
-      Then the PREPARE+EXECUTE failed because of a procedure that contained a SELECT.
-      So I replaced debuggee_wait_loop()'s PREPARE with "LEAVE".
-      The actual execution will be done here in C.
-      Todo: Replace all debuggee_wait_loop() with a C routine.
-      Todo: Catch errors -- debuggee_wait_loop() didn't necessarily end via LEAVE x.
-    */
-
-    strcpy(call_statement, "call xxxmdbug.debuggee_wait_loop();");
-    debuggee_state= DEBUGGEE_STATE_DEBUGGEE_WAIT_LOOP;
-    if (lmysql->ldbms_mysql_real_query(&mysql[MYSQL_DEBUGGER_CONNECTION], call_statement, strlen(call_statement)))
-    {
-      debuggee_state= DEBUGGEE_STATE_DEBUGGEE_WAIT_LOOP_ERROR;
-      strncpy(debuggee_state_error, lmysql->ldbms_mysql_error(&mysql[MYSQL_DEBUGGER_CONNECTION]), STRING_LENGTH_512 - 1);
-      break;
-    }
-    {
-      char xxxmdbug_status_last_command_result[512];
-      if (lmysql->ldbms_mysql_query(&mysql[MYSQL_DEBUGGER_CONNECTION], "select @xxxmdbug_status_last_command_result"))
-      {
-        /* This can happen, for example if debug command failed. */
-        debuggee_state= DEBUGGEE_STATE_DEBUGGEE_WAIT_LOOP_ERROR;
-        unexpected_error=" select @xxxmdbug_status_last_command_result failed";
-        strcpy(debuggee_state_error, "no result from last command");
-        break;
-      }
-      debug_res= lmysql->ldbms_mysql_store_result(&mysql[MYSQL_DEBUGGER_CONNECTION]);
-      if (debug_res == NULL)
+/* Format one chunk. Runs in its own thread, touching nothing but the chunk. */
+void* export_format_thread(void* chunk_pointer)
+{
+  export_chunk *chunk= (export_chunk*) chunk_pointer;
+  QByteArray *out= &chunk->formatted;
+  const char *p= chunk->raw.constData();
+  unsigned int length;
+  char flag;
+
+  out->resize(0);
+  out->reserve(chunk->raw.size() + chunk->raw.size() / 4 + export_insert_prefix.size() + 16);
+  if (export_format == EXPORT_FORMAT_INSERT) out->append(export_insert_prefix);
+  for (unsigned int r= 0; r < chunk->row_count; ++r)
+  {
+    if (export_format == EXPORT_FORMAT_JSONL) out->append('{');
+    if (export_format == EXPORT_FORMAT_INSERT)
+    {
+      if (r > 0) out->append(",\n");
+      out->append('(');
+    }
+    if (export_format == EXPORT_FORMAT_HTML) out->append("<TR>");
+    if (export_format == EXPORT_FORMAT_XML) out->append("  <row>\n");
+    for (unsigned int c= 0; c < export_column_count; ++c)
+    {
+      memcpy(&length, p, sizeof(unsigned int));
+      p+= sizeof(unsigned int);
+      flag= *p;
+      p+= sizeof(char);
+      if (c > 0)
       {
-        unexpected_error= "mysql_store_result failed";
+        if (export_format == EXPORT_FORMAT_TSV) out->append('\t');
+        else if ((export_format != EXPORT_FORMAT_HTML) && (export_format != EXPORT_FORMAT_XML)) out->append(',');
       }
-      if (lmysql->ldbms_mysql_num_fields(debug_res) != 1)
+      if (export_format == EXPORT_FORMAT_JSONL) out->append(export_json_names.at(c));
+      if (export_format == EXPORT_FORMAT_HTML) out->append("<TD>");
+      if (export_format == EXPORT_FORMAT_XML)
       {
-        unexpected_error= "wrong field count";
-        lmysql->ldbms_mysql_free_result(debug_res);
-        break;
+        /* For xml export_json_names[c] is the escaped name, not "name": */
+        out->append("\t<field name=\"");
+        out->append(export_json_names.at(c));
+        if (flag == FIELD_VALUE_FLAG_IS_NULL) out->append("\" xsi:nil=\"true\" />\n");
+        else out->append("\">");
       }
-      debug_row= lmysql->ldbms_mysql_fetch_row(debug_res);
-      if (debug_row == NULL)
+      if (flag == FIELD_VALUE_FLAG_IS_NULL)
       {
-        unexpected_error= "mysql_fetch_row failed";
-        lmysql->ldbms_mysql_free_result(debug_res);
-       break;
+        if (export_format == EXPORT_FORMAT_TSV) out->append("\\N");
+        if (export_format == EXPORT_FORMAT_JSONL) out->append("null");
+        if ((export_format == EXPORT_FORMAT_INSERT) || (export_format == EXPORT_FORMAT_HTML)) out->append("NULL");
       }
-      strcpy(xxxmdbug_status_last_command_result, debug_row[0]);
-      lmysql->ldbms_mysql_free_result(debug_res);
-      /* There are various errors that xxxmdbug.check_surrogate_routine could have returned. */
-      if ((strstr(xxxmdbug_status_last_command_result,"Error reading setup log") != 0)
-       || (strstr(xxxmdbug_status_last_command_result,"is incorrect format for a surrogate identifier") != 0)
-       || (strstr(xxxmdbug_status_last_command_result,"is not found once in xxxmdbug.setup_log") != 0)
-       || (strstr(xxxmdbug_status_last_command_result,"was set up with an older debugger version") != 0)
-       || (strstr(xxxmdbug_status_last_command_result,"original was not found") != 0)
-       || (strstr(xxxmdbug_status_last_command_result,"original was altered") != 0)
-       || (strstr(xxxmdbug_status_last_command_result,"surrogate was not found") != 0))
+      else
       {
-        debuggee_state= DEBUGGEE_STATE_DEBUGGEE_WAIT_LOOP_ERROR;
-        strncpy(debuggee_state_error, xxxmdbug_status_last_command_result, STRING_LENGTH_512 - 1);
-        break;
+        export_append_value(out, p, length, c);
+        if (export_format == EXPORT_FORMAT_XML) out->append("</field>\n");
       }
+      if (export_format == EXPORT_FORMAT_HTML) out->append("</TD>");
+      p+= length;
     }
-    if (lmysql->ldbms_mysql_query(&mysql[MYSQL_DEBUGGER_CONNECTION], "select @xxxmdbug_what_to_call"))
-    {
-      unexpected_error=" select @xxxmdbug_what_to_call failed";
-      break;
-    }
-    debug_res= lmysql->ldbms_mysql_store_result(&mysql[MYSQL_DEBUGGER_CONNECTION]);
-    if (debug_res == NULL)
-    {
-      unexpected_error= "mysql_store_result failed";
-    }
-    if (lmysql->ldbms_mysql_num_fields(debug_res) != 1)
-    {
-      unexpected_error= "wrong field count";
-      lmysql->ldbms_mysql_free_result(debug_res);
-      break;
-    }
-    debug_row= lmysql->ldbms_mysql_fetch_row(debug_res);
-    if (debug_row == NULL)
-    {
-      unexpected_error= "mysql_fetch_row failed";
-      lmysql->ldbms_mysql_free_result(debug_res);
-      break;
-    }
-    strcpy(call_statement, debug_row[0]);
-    lmysql->ldbms_mysql_free_result(debug_res);
-
-    if (lmysql->ldbms_mysql_real_query(&mysql[MYSQL_DEBUGGER_CONNECTION], call_statement, strlen(call_statement)))
-    {
-      debuggee_state= DEBUGGEE_STATE_DEBUGGEE_WAIT_LOOP_ERROR;
-      strncpy(debuggee_state_error, lmysql->ldbms_mysql_error(&mysql[MYSQL_DEBUGGER_CONNECTION]), STRING_LENGTH_512 - 1);
-    }
-    else
-    {
-        /*
-          Following is pretty much the same as for MYSQL_MAIN_CONNECTION.
-          We're just throwing result sets away. NB: the statement has not
-          really ended -- when there's a result set MySQL temporarily drops
-          out of the procedure, and resumes during each iteration of this loop.
-          Todo: we can put each result into the result grid widget as it comes;
-          we'll have to decide whether the debugger should do it, or the main.
-        */
-        if (lmysql->ldbms_mysql_more_results(&mysql[MYSQL_DEBUGGER_CONNECTION]))
-        {
-          debug_res= lmysql->ldbms_mysql_store_result(&mysql[MYSQL_DEBUGGER_CONNECTION]);
-          if (debug_res != 0)
-          {
-            lmysql->ldbms_mysql_free_result(debug_res);
-
-            if (lmysql->ldbms_mysql_more_results(&mysql[MYSQL_DEBUGGER_CONNECTION]))
-            {
-              while (lmysql->ldbms_mysql_next_result(&mysql[MYSQL_DEBUGGER_CONNECTION]) == 0)
-              {
-                debug_res= lmysql->ldbms_mysql_store_result(&mysql[MYSQL_DEBUGGER_CONNECTION]);
-                if (debug_res != 0) lmysql->ldbms_mysql_free_result(debug_res);
-              }
-              debug_res= 0;
-            }
-          }
-        }
-
-      debuggee_state= DEBUGGEE_STATE_END;
-    }
-    break;
-  }
-
-  /* Todo: Even after failure, get rid of result sets. But, oddly, lmysql->ldbms_mysql_next_result() never returns anything. */
-  /* This just would throw any results away, which is what happens also with MYSQL_MAIN_CONNECTION. */
-  /* What I'd have liked to do is: have the main connection put the result set up on the main screen. */
-  //while (lmysql->ldbms_mysql_next_result(&mysql[MYSQL_DEBUGGER_CONNECTION]) == 0) ;
-  //if (lmysql->ldbms_mysql_more_results(&mysql[MYSQL_DEBUGGER_CONNECTION]))
-  //{
-  //  while (lmysql->ldbms_mysql_next_result(&mysql[MYSQL_DEBUGGER_CONNECTION]) == 0)
-  //  {
-  //    debug_res= lmysql->ldbms_mysql_store_result(&mysql[MYSQL_DEBUGGER_CONNECTION]);
-  //    if (debug_res != 0) lmysql->ldbms_mysql_free_result(debug_res);
-  //  }
-  //  debug_res= 0;
-  //}
-  if (unexpected_error != NULL)
-  {
-    strncpy(debuggee_state_error, lmysql->ldbms_mysql_error(&mysql[MYSQL_DEBUGGER_CONNECTION]), STRING_LENGTH_512 - 1);
+    if (export_format == EXPORT_FORMAT_JSONL) out->append('}');
+    if (export_format == EXPORT_FORMAT_HTML) out->append("</TR>");
+    if (export_format == EXPORT_FORMAT_XML) out->append("  </row>\n");
+    else if (export_format == EXPORT_FORMAT_INSERT) out->append(')');
+    else out->append('\n');
   }
-
-  /* Cleanup */
-  /* Shut the connection, which seems to cause disconnect automatically. */
-  if (is_connected == 1) lmysql->ldbms_mysql_close(&mysql[MYSQL_DEBUGGER_CONNECTION]);
-
-  /* Typically we'll reach this point with last_command_result = "debuggee_wait_loop() termination" */
-
-  /* Here I am overwriting DEBUGGEE_WAIT_LOOP_ERROR / DEBUGGEE_STATE_END. Maybe they're informative but they caused trouble. */
-  //debuggee_state= DEBUGGEE_STATE_0;
-
-  /* options_and_connect called mysql_init which called mysql_thread_init, so cancel it */
-  lmysql->ldbms_mysql_thread_end();
-  /* The thread will end. */
+  if (export_format == EXPORT_FORMAT_INSERT) out->append(";\n");
   return ((void*) NULL);
 }
 
+/* Wait for the chunk's formatter if any, and write what it made. */
+static void export_chunk_wait(export_chunk *chunk)
+{
+  if (chunk->is_thread_started == false) return;
+  pthread_join(chunk->thread_id, NULL);
+  chunk->is_thread_started= false;
+  export_write(chunk->formatted);
+}
 
 /*
-  Debug|Install -- install the debugger routines and tables in xxxmdbug.
-  The actual CREATE statements are all xxxmdbug_install_sql in
-  a separate file, install_sql.cpp, so that it's clear what the HP-licence part is.
-  debug|install menu item is commented out, one must say $INSTALL
-  Todo: decide what to do if it's already installed.
-  Todo: privilege check
-  Todo: what we really should be doing: passing the original command, in all cases.
+  Set up export_is_number etc. for a new result set and write the header.
+  Column names are org_name if there is one, so an INSERT can go back to
+  the original table even if the select said "column AS alias".
 */
-//void MainWindow::action_debug_install()
-//{
-//  statement_edit_widget->setPlainText("$INSTALL");
-//  action_execute(1);
-//}
-
-void MainWindow::debug_install_go()
+/*
+  charsetnr 63 alone isn't enough: DATE, TIME, DATETIME, TIMESTAMP, BIT
+  and MySQL's JSON have it too, and they're text. GEOMETRY is WKB bytes.
+*/
+static bool export_field_is_binary(MYSQL_FIELD *field)
 {
-  char x[32768];
-  char command_string[2048];
-  QString qstring_error_message;
-
-  if (debug_error((char*)"") != 0) return;
+  if (field->type == MYSQL_TYPE_GEOMETRY) return true;
+  if (field->charsetnr != 63) return false;
+  switch (field->type)
+  {
+  case MYSQL_TYPE_TINY_BLOB:
+  case MYSQL_TYPE_MEDIUM_BLOB:
+  case MYSQL_TYPE_LONG_BLOB:
+  case MYSQL_TYPE_BLOB:
+  case MYSQL_TYPE_STRING:
+  case MYSQL_TYPE_VAR_STRING:
+  case MYSQL_TYPE_VARCHAR:
+    return true;
+  default:
+    return false;
+  }
+}
 
-  if ((statement_edit_widget->dbms_version.mid(1,1) == ".")
-  &&  (statement_edit_widget->dbms_version < "5.5"))
+static void export_start_result_set(MYSQL_RES *res)
+{
+  MYSQL_FIELD *fields= lmysql->ldbms_mysql_fetch_fields(res);
+  QByteArray header;
+
+  export_column_count= lmysql->ldbms_mysql_num_fields(res);
+  if (export_is_number != 0) delete [] export_is_number;
+  if (export_is_binary != 0) delete [] export_is_binary;
+  export_is_number= new bool[export_column_count];
+  export_is_binary= new bool[export_column_count];
+  export_json_names.clear();
+  export_insert_prefix= "INSERT INTO `";
+  if ((export_column_count > 0) && (fields[0].org_table_length > 0))
+    export_insert_prefix.append(QByteArray(fields[0].org_table, fields[0].org_table_length).replace("`", "``"));
+  else export_insert_prefix.append("exported");
+  export_insert_prefix.append("` (");
+  for (unsigned int i= 0; i < export_column_count; ++i)
+  {
+    export_is_number[i]= ((fields[i].flags & NUM_FLAG) != 0);
+    export_is_binary[i]= export_field_is_binary(&fields[i]);
+    QByteArray name(fields[i].name, fields[i].name_length);
+    if (i > 0)
+    {
+      if (export_format == EXPORT_FORMAT_TSV) header.append('\t');
+      if (export_format == EXPORT_FORMAT_CSV) header.append(',');
+      export_insert_prefix.append(',');
+    }
+    if (export_format == EXPORT_FORMAT_HTML) header.append("<TH>");
+    if (export_format != EXPORT_FORMAT_XML)
+      export_append_value(&header, name.constData(), name.size(), i);
+    if (export_format == EXPORT_FORMAT_HTML) header.append("</TH>");
+    QByteArray json_name;
+    if (export_format == EXPORT_FORMAT_XML) export_append_markup(&json_name, name.constData(), name.size());
+    else
+    {
+      export_append_json_string(&json_name, name.constData(), name.size());
+      json_name.append(':');
+    }
+    export_json_names.append(json_name);
+    if (fields[i].org_name_length > 0) name= QByteArray(fields[i].org_name, fields[i].org_name_length);
+    export_insert_prefix.append('`');
+    export_insert_prefix.append(name.replace("`", "``"));
+    export_insert_prefix.append('`');
+  }
+  export_insert_prefix.append(") VALUES\n");
+  if (export_format == EXPORT_FORMAT_HTML)
   {
-    strcpy(command_string, er_strings[er_off + ER_DEBUGGER_REQUIRES]);
-    if (debug_error(command_string) != 0) return;
+    header.prepend("<TABLE BORDER=1><TR>");
+    header.append("</TR>");
+    if (export_is_header == false) header= "<TABLE BORDER=1>";
   }
-
-  qstring_error_message= debug_privilege_check(TOKEN_KEYWORD_DEBUG_INSTALL);
-  if (qstring_error_message != "")
+  if (export_format == EXPORT_FORMAT_XML)
   {
-    strcpy(command_string, qstring_error_message.toUtf8());
-    if (debug_error(command_string) != 0) return; /* setup wouldn't be able to operate so fail */
+    header= "<?xml version=\"1.0\"?>\n\n<resultset statement=\"";
+    export_append_markup(&header, export_statement.constData(), export_statement.size());
+    header.append("\n\" xmlns:xsi=\"http://www.w3.org/2001/XMLSchema-instance\">\n");
   }
-
-  if (debug_mdbug_install_sql(&mysql[MYSQL_MAIN_CONNECTION], x) < 0)
+  else if ((export_format == EXPORT_FORMAT_CSV) || (export_format == EXPORT_FORMAT_TSV))
   {
-      put_diagnostics_in_result(MYSQL_MAIN_CONNECTION);
-      return;
-    //if (debug_error((char*)"Install failed") != 0) return;
+    header.append('\n');
+    if (export_is_header == false) header= "";
   }
-  put_diagnostics_in_result(MYSQL_MAIN_CONNECTION);
+  else if (export_format != EXPORT_FORMAT_HTML) header= "";
+  export_write(header);
 }
 
-/* For copyright and license notice of debug_mdbug_install function contents, see beginning of this program. */
-void debug_mdbug_install()
+/* Write what has to come after the last row, if anything. */
+static void export_end_result_set()
 {
-  ;
+  if (export_format == EXPORT_FORMAT_HTML) export_write("</TABLE>");
+  if (export_format == EXPORT_FORMAT_XML) export_write("</resultset>\n");
 }
-/* End of debug_mdbug_install. End of effect of licence of debug_mdbug_install_function contents. */
-
 
 /*
-  Debug|Setup
-  Todo: This should put up a list box with the routines which the user can execute. No hard coding of test.p8 and test.p9.
-        Or, it should look in the log for the last setup by this user, and re-do it.
-  Todo: Shortcut = Same as last time.
-  Todo: Search for schema name not just routine name.
-  Todo: We require SELECT access on mysql.proc. We could change the install_sql.cpp routines so that $setup accesses
-        a view of mysql.proc, and have a WHERE clause that restricts to only some procedures.
-  Format =  CALL xxxmdbug.setup('[option] object name list');
-  debug|setup menu item is removed, one must say $SETUP ...
+  Fetch all rows of all result sets. If there was an open or write error
+  we still fetch, and throw away, so that the connection is not out of sync.
+  If the pipe reader (e.g. the pager) has gone, there's no point
+  fetching the rest of a huge result, so kill the query, as Run|Kill would,
+  but without is_kill_requested, the following statements can still run.
+  So that the KILL can't land on the next statement, we join the
+  kill_thread() before we say we've ended.
 */
-//void MainWindow::action_debug_setup()
-//{
-//  char call_statement[512]; /* Todo: this is dangerously small. */
-//  int debug_widget_index;
-//  QString routine_schema_name[DEBUG_TAB_WIDGET_MAX + 1];
-//  QString routine_name[DEBUG_TAB_WIDGET_MAX + 1];
-//
-//  /*
-//    TODO: Put up a list box with the routines that the user has a right to execute.
-//    Allow user to pick which ones will go in routine_names[], which will be what is used for setup().
-//    Max = DEBUG_TAB_WIDGET_MAX.
-//  */
-//
-//  routine_schema_name[0]= "test";
-//  routine_schema_name[1]= "test";
-//  routine_name[0]= "p8";
-//  routine_name[1]= "p9";
-//  routine_name[2]= "";
-//
-//  /* Make a setup statement. Example possibility = CALL xxxmdbug.setup('test.p8',test.p9'). */
-//  strcpy(call_statement, "CALL xxxmdbug.setup('");
-//  for (debug_widget_index= 0; ; ++debug_widget_index)
-//  {
-//    if (strcmp(routine_name[debug_widget_index].toUtf8(), "") == 0) break;
-//    if (debug_widget_index > 0) strcat(call_statement, ",");
-//    strcat(call_statement, routine_schema_name[debug_widget_index].toUtf8());
-//    strcat(call_statement, ".");
-//    strcat(call_statement, routine_name[debug_widget_index].toUtf8());
-//  }
-//  strcat(call_statement, "');");
-//  call_statement=%s\n", call_statement);
-//
-//  statement_edit_widget->setPlainText(call_statement);
-//  action_execute(1);
-//}
-
-
-/* Todo: $setup does a GET_LOCK() so that two users won't do $setup at the same time. Figure out a better way. */
-void MainWindow::debug_setup_go(QString text)
+void* export_thread(void* main_window)
 {
-  char command_string[512];
-  int index_of_number_1, index_of_number_2;
-  QString qstring_error_message;
-  QString q_routine_schema, q_routine_name;
+  MYSQL *connection= &mysql[export_connection_number];
+  MYSQL_RES *res= export_res;
+  MYSQL_ROW row;
+  unsigned long *lengths;
+  unsigned int length;
+  char flag;
 
-  /* Todo: Check that 'install' has happened -- but for now it's OK, at least we return some sort of error. */
-  /* Todo: use debug_error instead, provided debug_error gets rid of any problematic ''s */
-  qstring_error_message= debug_privilege_check(TOKEN_KEYWORD_DEBUG_SETUP);
-  if (qstring_error_message != "")
+  for (;;)
   {
-    strcpy(command_string, qstring_error_message.toUtf8());
-    if (debug_error(command_string) != 0) return; /* setup wouldn't be able to operate so fail */
+    if ((res != NULL) && (export_write_error != 0))
+      lmysql->ldbms_mysql_free_result(res);
+    else if (res != NULL)
+    {
+      int chunk_number= 0;
+      export_chunk *chunk= &export_chunks[chunk_number];
+      export_start_result_set(res);
+      chunk->raw.resize(0);
+      chunk->row_count= 0;
+      for (;;)
+      {
+        row= lmysql->ldbms_mysql_fetch_row(res);
+        if (row == NULL)
+        {
+          if (lmysql->ldbms_mysql_errno(connection) != 0) export_fetch_error= 1;
+          break;
+        }
+        /* After a write error we only fetch until the kill, if any, takes effect */
+        if (export_write_error != 0)
+        {
+          if ((export_is_pipe == true) && (export_file != NULL) && (export_is_cancelled == false))
+          {
+            kill_state= KILL_STATE_CONNECT_THREAD_STARTED;
+            if (pthread_create(&export_kill_thread_id, NULL, &kill_thread, NULL) == 0) export_is_cancelled= true;
+          }
+          continue;
+        }
+        lengths= lmysql->ldbms_mysql_fetch_lengths(res);
+        for (unsigned int i= 0; i < export_column_count; ++i)
+        {
+          length= lengths[i];
+          if (row[i] == NULL) flag= FIELD_VALUE_FLAG_IS_NULL;
+          else flag= FIELD_VALUE_FLAG_IS_STRING;
+          chunk->raw.append((const char*) &length, sizeof(unsigned int));
+          chunk->raw.append(flag);
+          if (length > 0) chunk->raw.append(row[i], length);
+        }
+        ++chunk->row_count;
+        ++export_row_count;
+        if (chunk->row_count == EXPORT_ROWS_PER_CHUNK)
+        {
+          pthread_create(&chunk->thread_id, NULL, &export_format_thread, chunk);
+          chunk->is_thread_started= true;
+          chunk_number= (chunk_number + 1) % EXPORT_CHUNKS;
+          chunk= &export_chunks[chunk_number];
+          export_chunk_wait(chunk);
+          chunk->raw.resize(0);
+          chunk->row_count= 0;
+        }
+      }
+      if (chunk->row_count > 0)
+      {
+        pthread_create(&chunk->thread_id, NULL, &export_format_thread, chunk);
+        chunk->is_thread_started= true;
+      }
+      /* The oldest chunk is the one after chunk_number. */
+      for (int i= 1; i <= EXPORT_CHUNKS; ++i)
+        export_chunk_wait(&export_chunks[(chunk_number + i) % EXPORT_CHUNKS]);
+      export_end_result_set();
+      lmysql->ldbms_mysql_free_result(res);
+    }
+    if (export_fetch_error != 0) break;
+    if (lmysql->ldbms_mysql_more_results(connection) == 0) break;
+    if (lmysql->ldbms_mysql_next_result(connection) != 0) break;
+    res= lmysql->ldbms_mysql_use_result(connection);
   }
-  if (debug_parse_statement(text, command_string, &index_of_number_1, &index_of_number_2) < 0)
+  /* pclose() waits till the pager ends, so it's here not in the main thread. */
+  if (export_file != NULL)
   {
-    if (debug_error(command_string) != 0) return;
+    if (export_is_stdout) { if (fflush(export_file) != 0) export_write_error= 1; }
+    else if (export_is_pipe) { if (pclose(export_file) == -1) export_write_error= 1; }
+    else { if (fclose(export_file) != 0) export_write_error= 1; }
   }
+  if (export_tee_file != 0) export_tee_file->flush();
+  if (export_is_cancelled == true) pthread_join(export_kill_thread_id, NULL);
+  dbms_long_query_state= LONG_QUERY_STATE_ENDED;
+  QMetaObject::invokeMethod((MainWindow*) main_window, "dbms_long_query_done", Qt::QueuedConnection);
+  return ((void*) NULL);
+}
 
-  q_routine_schema= debug_q_schema_name_in_statement;
-  q_routine_name= debug_q_routine_name_in_statement;
-  if ((q_routine_schema == "") || (q_routine_name == ""))
+/*
+  Called from action_execute_one_statement() after a successful query when
+  ocelot_export_format <> '' or when run_headless() is happening.
+  See the "Streaming export" comment above.
+  Return 0 = there was no result set, 1 = exported, 2 = error.
+  Todo: the export file is rewritten by each statement. Maybe allow append.
+*/
+int MainWindow::export_result_set(unsigned int connection_number, QString format, QString file_name)
+{
+  MYSQL_RES *res= lmysql->ldbms_mysql_use_result(&mysql[connection_number]);
+  if (res == NULL) return 0;
+
+  format= format.toLower();
+  if (format == "csv") export_format= EXPORT_FORMAT_CSV;
+  else if (format == "tsv") export_format= EXPORT_FORMAT_TSV;
+  else if (format == "jsonl") export_format= EXPORT_FORMAT_JSONL;
+  else if (format == "html") export_format= EXPORT_FORMAT_HTML;
+  else if (format == "xml") export_format= EXPORT_FORMAT_XML;
+  else export_format= EXPORT_FORMAT_INSERT;
+  export_is_header= (is_headless == false) || (ocelot_result_grid_column_names != 0);
+  export_is_raw= (is_headless == true) && (ocelot_raw != 0);
+  export_statement= query_utf16_copy.toUtf8();
+  QByteArray file_name_as_utf8= file_name.toUtf8();
+  export_is_pipe= file_name_as_utf8.startsWith('|');
+  export_is_stdout= (file_name_as_utf8 == "");
+  export_tee_file= 0;
+  if (export_is_stdout)
+  {
+    export_file= stdout;
+    if (ocelot_history_tee_file_is_open) export_tee_file= &ocelot_history_tee_file;
+  }
+  else if (export_is_pipe) export_file= popen(file_name_as_utf8.constData() + 1, "w");
+  else export_file= fopen(file_name_as_utf8.constData(), "wb");
+  export_res= res;
+  export_connection_number= connection_number;
+  export_row_count= 0;
+  export_fetch_error= 0;
+  export_write_error= 0;
+  export_is_cancelled= false;
+  /* for export_thread()'s kill_thread(), if the pipe reader goes away */
+  kill_connection_id= statement_edit_widget->dbms_connection_id;
+  if (export_file == NULL) export_write_error= 1;
+  for (int i= 0; i < EXPORT_CHUNKS; ++i) export_chunks[i].is_thread_started= false;
+
+#ifdef __linux
+  /* If a pipe's reader goes away, fwrite() should fail rather than kill us. */
+  void (*old_sigpipe_handler)(int)= signal(SIGPIPE, SIG_IGN);
+#endif
+  dbms_long_query_state= LONG_QUERY_STATE_STARTED;
+  pthread_t thread_id;
+  if (pthread_create(&thread_id, NULL, &export_thread, this) != 0) export_thread(this);
+  else
   {
-    if (debug_error((char*)er_strings[er_off + ER_MISSING_ROUTINE_NAMES]) != 0) return;
+    dbms_long_query_wait(&dbms_long_query_state);
+    pthread_join(thread_id, NULL);
   }
-  /* Todo: since yes there is a bug, but we want to get this out, just release the lock instead of doing the right thing. */
+  bool is_cancelled= export_is_cancelled;
+#ifdef __linux
+  signal(SIGPIPE, old_sigpipe_handler);
+#endif
+
+  if (export_file == NULL)
   {
-    QString result_string= select_1_row("SELECT is_free_lock('xxxmdbug_lock')");
-    if (select_1_row_result_1.toInt() != 0)
+    if (export_is_pipe) make_and_put_message_in_result(ER_POPEN_FAILED, 0, (char*)"");
+    else make_and_put_message_in_result(ER_FILE_OPEN, 0, (char*)"");
+    return 2;
+  }
+  if (is_cancelled == false)
+  {
+    if (export_fetch_error != 0)
     {
-      //if (debug_error((char*)"Another user has done $setup and caused a lock. This might be an ocelotgui bug.") != 0) return;
-      result_string= select_1_row("SELECT release_lock('xxxmdbug_lock')");
+      put_diagnostics_in_result(connection_number);
+      return 2;
+    }
+    if (export_write_error != 0)
+    {
+      make_and_put_message_in_result(ER_EXPORT_WRITE_FAILED, 0, (char*)"");
+      return 2;
     }
   }
-  /* Throw away the first word i.e. "$setup" and execute "call xxxmdbug.setup('...')". */
-  char call_statement[512 + 128];
-  strcpy(call_statement, "call xxxmdbug.setup('");
-  strcat(call_statement, strstr(command_string, " ") + 1);
-  strcat(call_statement, "')");
-
-  if (lmysql->ldbms_mysql_real_query(&mysql[MYSQL_MAIN_CONNECTION], call_statement, strlen(call_statement)))
   {
-    put_diagnostics_in_result(MYSQL_MAIN_CONNECTION);
-    return;
-    //if (debug_error((char*)"call xxxmdbug.setup() failed.") != 0) return;
+    char rows_exported_string[ER_MAX_LENGTH];
+    char elapsed_time_string[50];
+    qint64 elapsed_time= QDateTime::currentMSecsSinceEpoch() - statement_edit_widget->start_time;
+    sprintf(elapsed_time_string, " (%.1f seconds)", (float) elapsed_time / 1000);
+    sprintf(rows_exported_string, er_strings[er_off + ER_ROWS_EXPORTED], export_row_count);
+    QString s= er_strings[er_off + ER_OK];
+    s.append(rows_exported_string);
+    s.append(elapsed_time_string);
+    put_message_in_result(s);
   }
-  debug_setup_mysql_proc_insert();
+  return 1;
 }
 
-
 /*
-  The following routine replaces the procedures xxxmdbug.mysql_proc_insert()
-  and xxxmdbug.mysql_proc_insert_caller() in install_sql.cpp, which are no
-  longer called from xxxmdbug.setup(). The effect is the same,
-  but there is no INSERT into a mysql-database table.
-  Also: definition_of_surrogate_routine will have three statements: DROP IF EXISTS, SET, CREATE.
-        I could execute them all at once, but prefer to separate. Assume original name didn't contain ;.
-        ... For icc_core routines the SET statement might be missing, I don't know why.
+  ocelot_export_file if ocelot_export_format was set, else stdout for a headless run,
+  else the pager. For the pager, "|" + command means export_result_set() will popen().
+  Since fwrite() to a full pipe blocks, the export thread stops fetching while the
+  pager isn't reading, so a huge result viewed with less takes constant memory.
 */
-void MainWindow::debug_setup_mysql_proc_insert()
+QString MainWindow::export_file_for_result()
 {
-  char command[512];
-  MYSQL_RES *res= NULL;
-  MYSQL_ROW row= NULL;
-  const char *unexpected_error= NULL;
-  unsigned int num_fields;
-  unsigned int num_rows;
-  QString definition_of_surrogate_routine;
-  int it_is_ok_if_proc_is_already_there;
-  QString list_of_drop_statements= "";
+  if (ocelot_export_format != "") return ocelot_export_file;
+  if (is_headless == true) return "";
+  QString command= ocelot_pager;
+  if ((command == "") && (getenv("PAGER") != 0)) command= getenv("PAGER");
+  if (command == "") command= "less";
+  return "|" + command;
+}
 
-  lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "select * from xxxmdbug.routines");
-  res= lmysql->ldbms_mysql_store_result(&mysql[MYSQL_MAIN_CONNECTION]);
-  if (res != NULL)
+/* ocelot_export_format if it was set, else the format that --batch|--html|--xml implies */
+QString MainWindow::export_format_for_result()
+{
+  if (ocelot_export_format != "") return ocelot_export_format;
+  if (ocelot_html != 0) return "html";
+  if (ocelot_xml != 0) return "xml";
+  return "tsv";
+}
+
+/*
+  ocelotgui --batch|--html|--xml --execute='statement(s)' acts like the mysql client:
+  execute, stream each result set to stdout with export_result_set(), exit.
+  No result grid, batch_text_edit, or history is shown, the main window never appears.
+  Errors go to stderr, and the first error stops execution, exit code = 1.
+  Called from the MainWindow constructor after CONNECT, compare --version.
+*/
+void MainWindow::run_headless()
+{
+  if (connections_is_connected[0] != 1)
   {
-    num_rows= lmysql->ldbms_mysql_num_rows(res);
-    lmysql->ldbms_mysql_free_result(res);
-    res= NULL;
-    if (num_rows - 3 >= DEBUG_TAB_WIDGET_MAX)
-    {
-      sprintf(command, er_strings[er_off + ER_SETUP], num_rows - 3, DEBUG_TAB_WIDGET_MAX - 1);
-      put_message_in_result(command);
-      return;
-    }
+    fprintf(stderr, "%s\n", statement_edit_widget->result.toUtf8().constData());
+    exit(1);
   }
-  lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "SET @xxxmdbug_saved_sql_mode=@@sql_mode");
-  /*
-    Go through all the rows of mysql.proc, doing DROP IF EXISTS and CREATE.
-    If a create fails, we will later have a cleanup which should drop what we created.
-  */
-  int index_of_semicolon, index_of_set, index_of_create;
-  QString first_query, second_query, third_query;
-  //int second_iteration_is_necessary= 0;
-  res= NULL;
-  //for (int iteration=0; iteration <= 1; ++iteration)
-  {
-    //if ((iteration == 1) && (second_iteration_is_necessary == 0))
-    //{
-    //  break;
-    //}
-    if (res != NULL)
-    {
-      lmysql->ldbms_mysql_free_result(res);
-      res= NULL;
-    }
-    row= NULL;
+  is_headless= true;
+  statement_edit_widget->clear();
+  statement_edit_widget->insertPlainText(ocelot_execute);
+  int result= action_execute(1);
+  fflush(stdout);
+  exit((result == 0) ? 0 : 1);
+}
 
-    strcpy(command,
-    "SELECT TRIM(BOTH '`' FROM schema_identifier_of_original),"
-    "       TRIM(BOTH '`' FROM routine_identifier_of_original),"
-    "       TRIM(BOTH '`' FROM routine_identifier_of_surrogate),"
-    "       definition_of_surrogate_routine,"
-    "       offset_of_begin "
-    "FROM xxxmdbug.routines");
 
-    if (lmysql->ldbms_mysql_real_query(&mysql[MYSQL_MAIN_CONNECTION], command, strlen(command)))
-    {
-      unexpected_error= "select failed";
-    }
-    if (unexpected_error == NULL)
-    {
-      res= lmysql->ldbms_mysql_store_result(&mysql[MYSQL_MAIN_CONNECTION]);
-      if (res == NULL) unexpected_error= "mysql_store_result failed";
-    }
-    if (unexpected_error == NULL)
-    {
-      num_fields= lmysql->ldbms_mysql_num_fields(res);
-      if (num_fields != 5) unexpected_error= "wrong field count";
-    }
+#ifdef DEBUGGER
 
-    if (unexpected_error == NULL)
-    {
-      MYSQL_RES *res_2= NULL;
-      for (;;)
-      {
-        row= lmysql->ldbms_mysql_fetch_row(res);
-        if (row == NULL) break;
-        it_is_ok_if_proc_is_already_there= 0;
-        /* todo: make sure row[2] i.e. routine_identifier_of_surrogate is not null */
-        if ((strcmp(row[2], "icc_process_user_command_r_server_variables") == 0)
-         || (strcmp(row[2], "icc_process_user_command_set_server_variables") == 0))
-        {
-          /* We will not insert icc_process_user_command_r_server_variables
-             or icc_process_user_command_set_server_variables into mysql.proc
-             if it already exists. This is okay as long as there is no change of
-             DBMS server version or engine or plugin. But recommend always:
-             DROP PROCEDURE xxxmdbug.icc_process_user_command_r_server_variables; */
-          it_is_ok_if_proc_is_already_there= 1;
-        }
-        else
-        {
-          /* MDBug might not care if the routine definition was blank, but we do. */
-          char tmp[512];
-          MYSQL_ROW row_2= NULL;
-          unsigned int num_rows_2= 0;
-          strcpy(tmp, "select routine_definition from information_schema.routines where routine_schema='");
-          strcat(tmp, row[0]);
-          strcat(tmp, "' and routine_name='");
-          strcat(tmp, row[1]);
-          strcat(tmp, "'");
-          if (lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], tmp)) num_rows_2= 0;
-          else
-          {
-            res_2= lmysql->ldbms_mysql_store_result(&mysql[MYSQL_MAIN_CONNECTION]);
-            if (res_2 != NULL)
-            {
-              num_rows_2= lmysql->ldbms_mysql_num_rows(res_2);
-            }
-          }
-          if (num_rows_2 == 1)
-          {
-            row_2= lmysql->ldbms_mysql_fetch_row(res_2);
-            if ((row_2 == NULL) || (row_2[0] == NULL) || (strcmp(row_2[0],"") == 0))
-            {
-              lmysql->ldbms_mysql_free_result(res_2);
-              res_2= NULL;
-              /* ""Could not get a routine definition for %s.%s" ... */
-              sprintf(tmp, er_strings[er_off + ER_COULD_NOT_GET], row[0], row[1]);
-              /* Todo: merge this sort of stuff into debug_error() */
-              unexpected_error= "create failed";
-              put_message_in_result(tmp);
-              //second_iteration_is_necessary= 1;
-              break;
-            }
-          }
-          if (res_2 != NULL)
-          {
-            lmysql->ldbms_mysql_free_result(res_2);
-            res_2= NULL;
-          }
-        }
-        definition_of_surrogate_routine= QString::fromUtf8(row[3]);
-        index_of_semicolon= definition_of_surrogate_routine.indexOf(";");
-        index_of_set= definition_of_surrogate_routine.indexOf("SET session sql_mode = '", index_of_semicolon);
-        if (index_of_set == -1) index_of_create= definition_of_surrogate_routine.indexOf("CREATE ", index_of_semicolon);
-        else index_of_create= definition_of_surrogate_routine.indexOf("CREATE ", index_of_set);
-        if (index_of_create == -1) unexpected_error= "bad definition_of_surrogate_routine";
-        if (unexpected_error == NULL)
+/*
+  Debug
+
+  Re debug_top_widget: It's a QWidget which contains a status line and debug_tab_widget.
+
+  Re debug_tab_widget: It's a QTabWidget which may contain more than one debug_widget.
+
+  Re debug_widget: it's derived from CodeEditor just as statement_edit_widget is, and it uses the
+  same stylesheet as statement_edit_widget. It starts hidden, but debug|initialize shows it.
+  It will contain the text of a procedure which is being debugged.
+  Actually debug_widget[] occurs 10 times -- todo: there's no check for overflow.
+
+  Re statements that come via statement_edit_widget: suppose the statement is "$DEB p8;".
+  During tokens_to_keywords() we recognize that this is TOKEN_KEYWORD_DEBUG_DEBUG and highlight appropriately.
+  During execute_client_statement(), after we check if statement_type == TOKEN_DEBUG_DEBUG_DEBUG and find that
+  it's true, there's a call to action_debug_debug() followed by "return 1". When we're in action_debug_debug(),
+  we have access to main_tokens so we can say things like "QString s= text.mid(main_token_offsets[i], main_token_lengths[i]);".
+*/
+
+/* This means "while debugger is going check status 20 times per second" (50 = 50 milliseconds). */
+#define DEBUG_TIMER_INTERVAL 50
+
+#define DEBUGGEE_STATE_0 0
+#define DEBUGGEE_STATE_CONNECT_THREAD_STARTED 1
+#define DEBUGGEE_STATE_BECOME_DEBUGEE_CONNECTION 2
+#define DEBUGGEE_STATE_DEBUGGEE_WAIT_LOOP 3
+#define DEBUGGEE_STATE_CONNECT_FAILED -1
+#define DEBUGGEE_STATE_MYSQL_REAL_QUERY_ERROR -2
+#define DEBUGGEE_STATE_MYSQL_STORE_RESULT_ERROR -3
+#define DEBUGGEE_STATE_MYSQL_FETCH_ROW_ERROR -4
+#define DEBUGGEE_STATE_BECOME_DEBUGGEE_CONNECTION_ERROR -5
+#define DEBUGGEE_STATE_DEBUGGEE_WAIT_LOOP_ERROR -6
+#define DEBUGGEE_STATE_END -7
+
+char debuggee_channel_name[128]= "";
+int volatile debuggee_state= DEBUGGEE_STATE_0;
+char debuggee_state_error[STRING_LENGTH_512]= "";
+char debuggee_information_status_debugger_name[32];
+char debuggee_information_status_debugger_version[8];
+char debuggee_information_status_timestamp_of_status_message[32];
+char debuggee_information_status_number_of_status_message[8];
+char debuggee_information_status_icc_count[8];
+char debuggee_information_status_schema_identifier[256];
+char debuggee_information_status_routine_identifier[256];
+char debuggee_information_status_line_number[8];
+char debuggee_information_status_is_at_breakpoint[8];
+char debuggee_information_status_is_at_tbreakpoint[8];
+char debuggee_information_status_is_at_routine_exit[8];
+char debuggee_information_status_stack_depth[8];
+char debuggee_information_status_last_command[256];
+char debuggee_information_status_last_command_result[256];
+char debuggee_information_status_commands_count[8];
+
+QString debug_routine_schema_name[DEBUG_TAB_WIDGET_MAX + 1];
+QString debug_routine_name[DEBUG_TAB_WIDGET_MAX + 1];
+
+QString debug_q_schema_name_in_statement;
+QString debug_q_routine_name_in_statement;
+QString debug_statement;
+
+QTimer *debug_timer;                                    /* For calling action_debug_timer_status() every 1/10 seconds */
+int debug_timer_old_line_number;
+char debug_timer_old_schema_identifier[256];
+char debug_timer_old_routine_identifier[256];
+int volatile debuggee_connection_id;                             /* Save this if you need to kill the debuggee (an unusual need) */
+int debug_timer_old_commands_count;
+int debug_timer_old_number_of_status_message;
+int debug_timer_old_icc_count;
+int debug_timer_old_debug_widget_index;
+
+
+
+/*
+  Enable or disable debug menu items.
+  If debug succeeds: most items after debug are enabled. (Todo: eventually all should be enabled.)
+  If exit succeeds: most items after debug are disabled.
+*/
+void MainWindow::debug_menu_enable_or_disable(int statement_type)
+{
+  bool e;
+
+  if (statement_type == TOKEN_KEYWORD_BEGIN) e= false;
+  if (statement_type == TOKEN_KEYWORD_DEBUG_DEBUG) e= true;
+  if (statement_type == TOKEN_KEYWORD_DEBUG_EXIT) e= false;
+
+//  menu_debug_action_install->setEnabled(e);
+//  menu_debug_action_setup->setEnabled(e);
+//  menu_debug_action_debug->setEnabled(e);
+  menu_debug_action_breakpoint->setEnabled(e);
+  menu_debug_action_continue->setEnabled(e);
+//  menu_debug_action_leave->setEnabled(e);
+  menu_debug_action_next->setEnabled(e);
+//  menu_debug_action_skip->setEnabled(e);
+  menu_debug_action_step->setEnabled(e);
+  menu_debug_action_clear->setEnabled(e);
+//  menu_debug_action_delete->setEnabled(e);
+  menu_debug_action_exit->setEnabled(e);                                      /* everything after debug goes gray after this succeeds */
+  menu_debug_action_information->setEnabled(e);
+  menu_debug_action_refresh_server_variables->setEnabled(e);
+  menu_debug_action_refresh_user_variables->setEnabled(e);
+  menu_debug_action_refresh_variables->setEnabled(e);
+  menu_debug_action_refresh_call_stack->setEnabled(e);
+}
+
+
+void MainWindow::create_widget_debug()
+{
+  /* We make debug_tab_widget now but we don't expect anyone to see it until debug|setup happens. */
+  /* Todo: should you create with an initially-hidden flag? */
+  debug_top_widget= new QWidget(this);              /* 2015-08-25 added "this" */
+  debug_top_widget->hide();                         /* hidden until debug|initialize is executed */
+
+  /*
+    Todo: check: am I doing it right by saying parent = debug_top_widget
+    i.e. will automatic delete happen when debug_top_widget is deleted?
+    or will there be a memory leak?
+    Hmm, why do I care? I don't delete debug_top_widget anyway, do I?
+    Hmm Hmm, yes I do but it must be an error.
+  */
+
+  debug_line_widget= new QLineEdit(debug_top_widget);
+  debug_line_widget->setText("Debugger Status = Inactive");
+  debug_tab_widget= new QTabWidget(debug_top_widget);
+
+  debug_top_widget_layout= new QVBoxLayout(debug_top_widget);
+  debug_top_widget_layout->addWidget(debug_line_widget);
+  debug_top_widget_layout->addWidget(debug_tab_widget);
+  debug_top_widget->setLayout(debug_top_widget_layout);
+
+  /* We make debug_timer now but we don't start it until debug status can be shown. */
+  debug_timer= new QTimer(this);
+  connect(debug_timer, SIGNAL(timeout()), this, SLOT(action_debug_timer_status()));
+
+  /* This must be done before we set statement stylesheet. */
+  for (int i= 0; i < DEBUG_TAB_WIDGET_MAX; ++i) debug_widget[i]= 0;
+
+}
+
+
+//#include <pthread.h>
+
+/*
+  The debuggee is a separate thread and makes its own connection using ocelot_ parameters just like the main connection.
+  Problem: debuggee_thread() cannot be in MainWindow (at least, I didn't figure out how to make it in MainWindow).
+  That explains why I made a lot of things global.
+  Todo: Check: Why do you end statements with ";"?
+  Todo: If an error occurs, copy the whole thing into a fixed-size char so debugger can see it.
+        And notice that the result is that the thread ends, so beware of racing and worry about cleanup.
+*/
+
+void* debuggee_thread(void* unused)
+{
+  (void) unused; /* suppress "unused parameter" warning */
+  char call_statement[512];
+  int is_connected= 0;
+  MYSQL_RES *debug_res= NULL;
+  MYSQL_ROW debug_row= NULL;
+  const char *unexpected_error= NULL;
+
+  debuggee_connection_id= 0;
+
+  memset(debuggee_state_error, 0, STRING_LENGTH_512);
+  debuggee_state= DEBUGGEE_STATE_CONNECT_THREAD_STARTED;
+
+  for (;;)
+  {
+    /*
+      The debuggee connection.
+      Todo: the_connect() could easily fail: parameters are changed, # of connections = max, password no longer works, etc.
+            ... so you should try to pass back a better explanation if the_connect() fails here.
+    */
+    if (options_and_connect(MYSQL_DEBUGGER_CONNECTION))
+    {
+       debuggee_state= DEBUGGEE_STATE_CONNECT_FAILED;
+       strncpy(debuggee_state_error, lmysql->ldbms_mysql_error(&mysql[MYSQL_DEBUGGER_CONNECTION]), STRING_LENGTH_512 - 1);
+       break;
+    }
+
+    is_connected= 1;
+
+    /* Get connection_id(). This is only in case regular "exit" fails and we have to issue a kill statement. */
+    strcpy(call_statement, "select connection_id();");
+    if (lmysql->ldbms_mysql_real_query(&mysql[MYSQL_DEBUGGER_CONNECTION], call_statement, strlen(call_statement)))
+    {
+      debuggee_state= DEBUGGEE_STATE_MYSQL_REAL_QUERY_ERROR;
+      strncpy(debuggee_state_error, lmysql->ldbms_mysql_error(&mysql[MYSQL_DEBUGGER_CONNECTION]), STRING_LENGTH_512 - 1);
+      break;
+    }
+    debug_res= lmysql->ldbms_mysql_store_result(&mysql[MYSQL_DEBUGGER_CONNECTION]);
+    if (debug_res == NULL)
+    {
+      debuggee_state= DEBUGGEE_STATE_MYSQL_STORE_RESULT_ERROR;
+      strncpy(debuggee_state_error, lmysql->ldbms_mysql_error(&mysql[MYSQL_DEBUGGER_CONNECTION]), STRING_LENGTH_512 - 1);
+      break;
+    }
+    debug_row= lmysql->ldbms_mysql_fetch_row(debug_res);
+    if (debug_row == NULL)
+    {
+      debuggee_state= DEBUGGEE_STATE_MYSQL_FETCH_ROW_ERROR;
+      strncpy(debuggee_state_error, lmysql->ldbms_mysql_error(&mysql[MYSQL_DEBUGGER_CONNECTION]), STRING_LENGTH_512 - 1);
+      lmysql->ldbms_mysql_free_result(debug_res);
+      break;
+    }
+    debuggee_connection_id= atoi(debug_row[0]);
+    lmysql->ldbms_mysql_free_result(debug_res);
+
+    strcpy(call_statement, "call xxxmdbug.become_debuggee_connection('");
+    strcat(call_statement, debuggee_channel_name);
+    strcat(call_statement, "');");
+    debuggee_state= DEBUGGEE_STATE_BECOME_DEBUGEE_CONNECTION;
+    if (lmysql->ldbms_mysql_real_query(&mysql[MYSQL_DEBUGGER_CONNECTION], call_statement, strlen(call_statement)))
+    {
+      debuggee_state= DEBUGGEE_STATE_BECOME_DEBUGGEE_CONNECTION_ERROR;
+      strncpy(debuggee_state_error, lmysql->ldbms_mysql_error(&mysql[MYSQL_DEBUGGER_CONNECTION]), STRING_LENGTH_512 - 1);
+      break;
+    }
+
+    /*
+      Originally we just had debuggee_wait_loop here.
+      Then the PREPARE+EXECUTE failed because of a procedure that contained a SELECT.
+      So I replaced debuggee_wait_loop()'s PREPARE with "LEAVE".
+      The actual execution will be done here in C.
+      Todo: Replace all debuggee_wait_loop() with a C routine.
+      Todo: Catch errors -- debuggee_wait_loop() didn't necessarily end via LEAVE x.
+    */
+
+    strcpy(call_statement, "call xxxmdbug.debuggee_wait_loop();");
+    debuggee_state= DEBUGGEE_STATE_DEBUGGEE_WAIT_LOOP;
+    if (lmysql->ldbms_mysql_real_query(&mysql[MYSQL_DEBUGGER_CONNECTION], call_statement, strlen(call_statement)))
+    {
+      debuggee_state= DEBUGGEE_STATE_DEBUGGEE_WAIT_LOOP_ERROR;
+      strncpy(debuggee_state_error, lmysql->ldbms_mysql_error(&mysql[MYSQL_DEBUGGER_CONNECTION]), STRING_LENGTH_512 - 1);
+      break;
+    }
+    {
+      char xxxmdbug_status_last_command_result[512];
+      if (lmysql->ldbms_mysql_query(&mysql[MYSQL_DEBUGGER_CONNECTION], "select @xxxmdbug_status_last_command_result"))
+      {
+        /* This can happen, for example if debug command failed. */
+        debuggee_state= DEBUGGEE_STATE_DEBUGGEE_WAIT_LOOP_ERROR;
+        unexpected_error=" select @xxxmdbug_status_last_command_result failed";
+        strcpy(debuggee_state_error, "no result from last command");
+        break;
+      }
+      debug_res= lmysql->ldbms_mysql_store_result(&mysql[MYSQL_DEBUGGER_CONNECTION]);
+      if (debug_res == NULL)
+      {
+        unexpected_error= "mysql_store_result failed";
+      }
+      if (lmysql->ldbms_mysql_num_fields(debug_res) != 1)
+      {
+        unexpected_error= "wrong field count";
+        lmysql->ldbms_mysql_free_result(debug_res);
+        break;
+      }
+      debug_row= lmysql->ldbms_mysql_fetch_row(debug_res);
+      if (debug_row == NULL)
+      {
+        unexpected_error= "mysql_fetch_row failed";
+        lmysql->ldbms_mysql_free_result(debug_res);
+       break;
+      }
+      strcpy(xxxmdbug_status_last_command_result, debug_row[0]);
+      lmysql->ldbms_mysql_free_result(debug_res);
+      /* There are various errors that xxxmdbug.check_surrogate_routine could have returned. */
+      if ((strstr(xxxmdbug_status_last_command_result,"Error reading setup log") != 0)
+       || (strstr(xxxmdbug_status_last_command_result,"is incorrect format for a surrogate identifier") != 0)
+       || (strstr(xxxmdbug_status_last_command_result,"is not found once in xxxmdbug.setup_log") != 0)
+       || (strstr(xxxmdbug_status_last_command_result,"was set up with an older debugger version") != 0)
+       || (strstr(xxxmdbug_status_last_command_result,"original was not found") != 0)
+       || (strstr(xxxmdbug_status_last_command_result,"original was altered") != 0)
+       || (strstr(xxxmdbug_status_last_command_result,"surrogate was not found") != 0))
+      {
+        debuggee_state= DEBUGGEE_STATE_DEBUGGEE_WAIT_LOOP_ERROR;
+        strncpy(debuggee_state_error, xxxmdbug_status_last_command_result, STRING_LENGTH_512 - 1);
+        break;
+      }
+    }
+    if (lmysql->ldbms_mysql_query(&mysql[MYSQL_DEBUGGER_CONNECTION], "select @xxxmdbug_what_to_call"))
+    {
+      unexpected_error=" select @xxxmdbug_what_to_call failed";
+      break;
+    }
+    debug_res= lmysql->ldbms_mysql_store_result(&mysql[MYSQL_DEBUGGER_CONNECTION]);
+    if (debug_res == NULL)
+    {
+      unexpected_error= "mysql_store_result failed";
+    }
+    if (lmysql->ldbms_mysql_num_fields(debug_res) != 1)
+    {
+      unexpected_error= "wrong field count";
+      lmysql->ldbms_mysql_free_result(debug_res);
+      break;
+    }
+    debug_row= lmysql->ldbms_mysql_fetch_row(debug_res);
+    if (debug_row == NULL)
+    {
+      unexpected_error= "mysql_fetch_row failed";
+      lmysql->ldbms_mysql_free_result(debug_res);
+      break;
+    }
+    strcpy(call_statement, debug_row[0]);
+    lmysql->ldbms_mysql_free_result(debug_res);
+
+    if (lmysql->ldbms_mysql_real_query(&mysql[MYSQL_DEBUGGER_CONNECTION], call_statement, strlen(call_statement)))
+    {
+      debuggee_state= DEBUGGEE_STATE_DEBUGGEE_WAIT_LOOP_ERROR;
+      strncpy(debuggee_state_error, lmysql->ldbms_mysql_error(&mysql[MYSQL_DEBUGGER_CONNECTION]), STRING_LENGTH_512 - 1);
+    }
+    else
+    {
+        /*
+          Following is pretty much the same as for MYSQL_MAIN_CONNECTION.
+          We're just throwing result sets away. NB: the statement has not
+          really ended -- when there's a result set MySQL temporarily drops
+          out of the procedure, and resumes during each iteration of this loop.
+          Todo: we can put each result into the result grid widget as it comes;
+          we'll have to decide whether the debugger should do it, or the main.
+        */
+        if (lmysql->ldbms_mysql_more_results(&mysql[MYSQL_DEBUGGER_CONNECTION]))
+        {
+          debug_res= lmysql->ldbms_mysql_store_result(&mysql[MYSQL_DEBUGGER_CONNECTION]);
+          if (debug_res != 0)
+          {
+            lmysql->ldbms_mysql_free_result(debug_res);
+
+            if (lmysql->ldbms_mysql_more_results(&mysql[MYSQL_DEBUGGER_CONNECTION]))
+            {
+              while (lmysql->ldbms_mysql_next_result(&mysql[MYSQL_DEBUGGER_CONNECTION]) == 0)
+              {
+                debug_res= lmysql->ldbms_mysql_store_result(&mysql[MYSQL_DEBUGGER_CONNECTION]);
+                if (debug_res != 0) lmysql->ldbms_mysql_free_result(debug_res);
+              }
+              debug_res= 0;
+            }
+          }
+        }
+
+      debuggee_state= DEBUGGEE_STATE_END;
+    }
+    break;
+  }
+
+  /* Todo: Even after failure, get rid of result sets. But, oddly, lmysql->ldbms_mysql_next_result() never returns anything. */
+  /* This just would throw any results away, which is what happens also with MYSQL_MAIN_CONNECTION. */
+  /* What I'd have liked to do is: have the main connection put the result set up on the main screen. */
+  //while (lmysql->ldbms_mysql_next_result(&mysql[MYSQL_DEBUGGER_CONNECTION]) == 0) ;
+  //if (lmysql->ldbms_mysql_more_results(&mysql[MYSQL_DEBUGGER_CONNECTION]))
+  //{
+  //  while (lmysql->ldbms_mysql_next_result(&mysql[MYSQL_DEBUGGER_CONNECTION]) == 0)
+  //  {
+  //    debug_res= lmysql->ldbms_mysql_store_result(&mysql[MYSQL_DEBUGGER_CONNECTION]);
+  //    if (debug_res != 0) lmysql->ldbms_mysql_free_result(debug_res);
+  //  }
+  //  debug_res= 0;
+  //}
+  if (unexpected_error != NULL)
+  {
+    strncpy(debuggee_state_error, lmysql->ldbms_mysql_error(&mysql[MYSQL_DEBUGGER_CONNECTION]), STRING_LENGTH_512 - 1);
+  }
+
+  /* Cleanup */
+  /* Shut the connection, which seems to cause disconnect automatically. */
+  if (is_connected == 1) lmysql->ldbms_mysql_close(&mysql[MYSQL_DEBUGGER_CONNECTION]);
+
+  /* Typically we'll reach this point with last_command_result = "debuggee_wait_loop() termination" */
+
+  /* Here I am overwriting DEBUGGEE_WAIT_LOOP_ERROR / DEBUGGEE_STATE_END. Maybe they're informative but they caused trouble. */
+  //debuggee_state= DEBUGGEE_STATE_0;
+
+  /* options_and_connect called mysql_init which called mysql_thread_init, so cancel it */
+  lmysql->ldbms_mysql_thread_end();
+  /* The thread will end. */
+  return ((void*) NULL);
+}
+
+
+/*
+  Debug|Install -- install the debugger routines and tables in xxxmdbug.
+  The actual CREATE statements are all xxxmdbug_install_sql in
+  a separate file, install_sql.cpp, so that it's clear what the HP-licence part is.
+  debug|install menu item is commented out, one must say $INSTALL
+  Todo: decide what to do if it's already installed.
+  Todo: privilege check
+  Todo: what we really should be doing: passing the original command, in all cases.
+*/
+//void MainWindow::action_debug_install()
+//{
+//  statement_edit_widget->setPlainText("$INSTALL");
+//  action_execute(1);
+//}
+
+void MainWindow::debug_install_go()
+{
+  char x[32768];
+  char command_string[2048];
+  QString qstring_error_message;
+
+  if (debug_error((char*)"") != 0) return;
+
+  if ((statement_edit_widget->dbms_version.mid(1,1) == ".")
+  &&  (statement_edit_widget->dbms_version < "5.5"))
+  {
+    strcpy(command_string, er_strings[er_off + ER_DEBUGGER_REQUIRES]);
+    if (debug_error(command_string) != 0) return;
+  }
+
+  qstring_error_message= debug_privilege_check(TOKEN_KEYWORD_DEBUG_INSTALL);
+  if (qstring_error_message != "")
+  {
+    strcpy(command_string, qstring_error_message.toUtf8());
+    if (debug_error(command_string) != 0) return; /* setup wouldn't be able to operate so fail */
+  }
+
+  if (debug_mdbug_install_sql(&mysql[MYSQL_MAIN_CONNECTION], x) < 0)
+  {
+      put_diagnostics_in_result(MYSQL_MAIN_CONNECTION);
+      return;
+    //if (debug_error((char*)"Install failed") != 0) return;
+  }
+  put_diagnostics_in_result(MYSQL_MAIN_CONNECTION);
+}
+
+/* For copyright and license notice of debug_mdbug_install function contents, see beginning of this program. */
+void debug_mdbug_install()
+{
+  ;
+}
+/* End of debug_mdbug_install. End of effect of licence of debug_mdbug_install_function contents. */
+
+
+/*
+  Debug|Setup
+  Todo: This should put up a list box with the routines which the user can execute. No hard coding of test.p8 and test.p9.
+        Or, it should look in the log for the last setup by this user, and re-do it.
+  Todo: Shortcut = Same as last time.
+  Todo: Search for schema name not just routine name.
+  Todo: We require SELECT access on mysql.proc. We could change the install_sql.cpp routines so that $setup accesses
+        a view of mysql.proc, and have a WHERE clause that restricts to only some procedures.
+  Format =  CALL xxxmdbug.setup('[option] object name list');
+  debug|setup menu item is removed, one must say $SETUP ...
+*/
+//void MainWindow::action_debug_setup()
+//{
+//  char call_statement[512]; /* Todo: this is dangerously small. */
+//  int debug_widget_index;
+//  QString routine_schema_name[DEBUG_TAB_WIDGET_MAX + 1];
+//  QString routine_name[DEBUG_TAB_WIDGET_MAX + 1];
+//
+//  /*
+//    TODO: Put up a list box with the routines that the user has a right to execute.
+//    Allow user to pick which ones will go in routine_names[], which will be what is used for setup().
+//    Max = DEBUG_TAB_WIDGET_MAX.
+//  */
+//
+//  routine_schema_name[0]= "test";
+//  routine_schema_name[1]= "test";
+//  routine_name[0]= "p8";
+//  routine_name[1]= "p9";
+//  routine_name[2]= "";
+//
+//  /* Make a setup statement. Example possibility = CALL xxxmdbug.setup('test.p8',test.p9'). */
+//  strcpy(call_statement, "CALL xxxmdbug.setup('");
+//  for (debug_widget_index= 0; ; ++debug_widget_index)
+//  {
+//    if (strcmp(routine_name[debug_widget_index].toUtf8(), "") == 0) break;
+//    if (debug_widget_index > 0) strcat(call_statement, ",");
+//    strcat(call_statement, routine_schema_name[debug_widget_index].toUtf8());
+//    strcat(call_statement, ".");
+//    strcat(call_statement, routine_name[debug_widget_index].toUtf8());
+//  }
+//  strcat(call_statement, "');");
+//  call_statement=%s\n", call_statement);
+//
+//  statement_edit_widget->setPlainText(call_statement);
+//  action_execute(1);
+//}
+
+
+/* Todo: $setup does a GET_LOCK() so that two users won't do $setup at the same time. Figure out a better way. */
+void MainWindow::debug_setup_go(QString text)
+{
+  char command_string[512];
+  int index_of_number_1, index_of_number_2;
+  QString qstring_error_message;
+  QString q_routine_schema, q_routine_name;
+
+  /* Todo: Check that 'install' has happened -- but for now it's OK, at least we return some sort of error. */
+  /* Todo: use debug_error instead, provided debug_error gets rid of any problematic ''s */
+  qstring_error_message= debug_privilege_check(TOKEN_KEYWORD_DEBUG_SETUP);
+  if (qstring_error_message != "")
+  {
+    strcpy(command_string, qstring_error_message.toUtf8());
+    if (debug_error(command_string) != 0) return; /* setup wouldn't be able to operate so fail */
+  }
+  if (debug_parse_statement(text, command_string, &index_of_number_1, &index_of_number_2) < 0)
+  {
+    if (debug_error(command_string) != 0) return;
+  }
+
+  q_routine_schema= debug_q_schema_name_in_statement;
+  q_routine_name= debug_q_routine_name_in_statement;
+  if ((q_routine_schema == "") || (q_routine_name == ""))
+  {
+    if (debug_error((char*)er_strings[er_off + ER_MISSING_ROUTINE_NAMES]) != 0) return;
+  }
+  /* Todo: since yes there is a bug, but we want to get this out, just release the lock instead of doing the right thing. */
+  {
+    QString result_string= select_1_row("SELECT is_free_lock('xxxmdbug_lock')");
+    if (select_1_row_result_1.toInt() != 0)
+    {
+      //if (debug_error((char*)"Another user has done $setup and caused a lock. This might be an ocelotgui bug.") != 0) return;
+      result_string= select_1_row("SELECT release_lock('xxxmdbug_lock')");
+    }
+  }
+  /* Throw away the first word i.e. "$setup" and execute "call xxxmdbug.setup('...')". */
+  char call_statement[512 + 128];
+  strcpy(call_statement, "call xxxmdbug.setup('");
+  strcat(call_statement, strstr(command_string, " ") + 1);
+  strcat(call_statement, "')");
+
+  if (lmysql->ldbms_mysql_real_query(&mysql[MYSQL_MAIN_CONNECTION], call_statement, strlen(call_statement)))
+  {
+    put_diagnostics_in_result(MYSQL_MAIN_CONNECTION);
+    return;
+    //if (debug_error((char*)"call xxxmdbug.setup() failed.") != 0) return;
+  }
+  debug_setup_mysql_proc_insert();
+}
+
+
+/*
+  The following routine replaces the procedures xxxmdbug.mysql_proc_insert()
+  and xxxmdbug.mysql_proc_insert_caller() in install_sql.cpp, which are no
+  longer called from xxxmdbug.setup(). The effect is the same,
+  but there is no INSERT into a mysql-database table.
+  Also: definition_of_surrogate_routine will have three statements: DROP IF EXISTS, SET, CREATE.
+        I could execute them all at once, but prefer to separate. Assume original name didn't contain ;.
+        ... For icc_core routines the SET statement might be missing, I don't know why.
+*/
+void MainWindow::debug_setup_mysql_proc_insert()
+{
+  char command[512];
+  MYSQL_RES *res= NULL;
+  MYSQL_ROW row= NULL;
+  const char *unexpected_error= NULL;
+  unsigned int num_fields;
+  unsigned int num_rows;
+  QString definition_of_surrogate_routine;
+  int it_is_ok_if_proc_is_already_there;
+  QString list_of_drop_statements= "";
+
+  lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "select * from xxxmdbug.routines");
+  res= lmysql->ldbms_mysql_store_result(&mysql[MYSQL_MAIN_CONNECTION]);
+  if (res != NULL)
+  {
+    num_rows= lmysql->ldbms_mysql_num_rows(res);
+    lmysql->ldbms_mysql_free_result(res);
+    res= NULL;
+    if (num_rows - 3 >= DEBUG_TAB_WIDGET_MAX)
+    {
+      sprintf(command, er_strings[er_off + ER_SETUP], num_rows - 3, DEBUG_TAB_WIDGET_MAX - 1);
+      put_message_in_result(command);
+      return;
+    }
+  }
+  lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "SET @xxxmdbug_saved_sql_mode=@@sql_mode");
+  /*
+    Go through all the rows of mysql.proc, doing DROP IF EXISTS and CREATE.
+    If a create fails, we will later have a cleanup which should drop what we created.
+  */
+  int index_of_semicolon, index_of_set, index_of_create;
+  QString first_query, second_query, third_query;
+  //int second_iteration_is_necessary= 0;
+  res= NULL;
+  //for (int iteration=0; iteration <= 1; ++iteration)
+  {
+    //if ((iteration == 1) && (second_iteration_is_necessary == 0))
+    //{
+    //  break;
+    //}
+    if (res != NULL)
+    {
+      lmysql->ldbms_mysql_free_result(res);
+      res= NULL;
+    }
+    row= NULL;
+
+    strcpy(command,
+    "SELECT TRIM(BOTH '`' FROM schema_identifier_of_original),"
+    "       TRIM(BOTH '`' FROM routine_identifier_of_original),"
+    "       TRIM(BOTH '`' FROM routine_identifier_of_surrogate),"
+    "       definition_of_surrogate_routine,"
+    "       offset_of_begin "
+    "FROM xxxmdbug.routines");
+
+    if (lmysql->ldbms_mysql_real_query(&mysql[MYSQL_MAIN_CONNECTION], command, strlen(command)))
+    {
+      unexpected_error= "select failed";
+    }
+    if (unexpected_error == NULL)
+    {
+      res= lmysql->ldbms_mysql_store_result(&mysql[MYSQL_MAIN_CONNECTION]);
+      if (res == NULL) unexpected_error= "mysql_store_result failed";
+    }
+    if (unexpected_error == NULL)
+    {
+      num_fields= lmysql->ldbms_mysql_num_fields(res);
+      if (num_fields != 5) unexpected_error= "wrong field count";
+    }
+
+    if (unexpected_error == NULL)
+    {
+      MYSQL_RES *res_2= NULL;
+      for (;;)
+      {
+        row= lmysql->ldbms_mysql_fetch_row(res);
+        if (row == NULL) break;
+        it_is_ok_if_proc_is_already_there= 0;
+        /* todo: make sure row[2] i.e. routine_identifier_of_surrogate is not null */
+        if ((strcmp(row[2], "icc_process_user_command_r_server_variables") == 0)
+         || (strcmp(row[2], "icc_process_user_command_set_server_variables") == 0))
+        {
+          /* We will not insert icc_process_user_command_r_server_variables
+             or icc_process_user_command_set_server_variables into mysql.proc
+             if it already exists. This is okay as long as there is no change of
+             DBMS server version or engine or plugin. But recommend always:
+             DROP PROCEDURE xxxmdbug.icc_process_user_command_r_server_variables; */
+          it_is_ok_if_proc_is_already_there= 1;
+        }
+        else
+        {
+          /* MDBug might not care if the routine definition was blank, but we do. */
+          char tmp[512];
+          MYSQL_ROW row_2= NULL;
+          unsigned int num_rows_2= 0;
+          strcpy(tmp, "select routine_definition from information_schema.routines where routine_schema='");
+          strcat(tmp, row[0]);
+          strcat(tmp, "' and routine_name='");
+          strcat(tmp, row[1]);
+          strcat(tmp, "'");
+          if (lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], tmp)) num_rows_2= 0;
+          else
+          {
+            res_2= lmysql->ldbms_mysql_store_result(&mysql[MYSQL_MAIN_CONNECTION]);
+            if (res_2 != NULL)
+            {
+              num_rows_2= lmysql->ldbms_mysql_num_rows(res_2);
+            }
+          }
+          if (num_rows_2 == 1)
+          {
+            row_2= lmysql->ldbms_mysql_fetch_row(res_2);
+            if ((row_2 == NULL) || (row_2[0] == NULL) || (strcmp(row_2[0],"") == 0))
+            {
+              lmysql->ldbms_mysql_free_result(res_2);
+              res_2= NULL;
+              /* ""Could not get a routine definition for %s.%s" ... */
+              sprintf(tmp, er_strings[er_off + ER_COULD_NOT_GET], row[0], row[1]);
+              /* Todo: merge this sort of stuff into debug_error() */
+              unexpected_error= "create failed";
+              put_message_in_result(tmp);
+              //second_iteration_is_necessary= 1;
+              break;
+            }
+          }
+          if (res_2 != NULL)
+          {
+            lmysql->ldbms_mysql_free_result(res_2);
+            res_2= NULL;
+          }
+        }
+        definition_of_surrogate_routine= QString::fromUtf8(row[3]);
+        index_of_semicolon= definition_of_surrogate_routine.indexOf(";");
+        index_of_set= definition_of_surrogate_routine.indexOf("SET session sql_mode = '", index_of_semicolon);
+        if (index_of_set == -1) index_of_create= definition_of_surrogate_routine.indexOf("CREATE ", index_of_semicolon);
+        else index_of_create= definition_of_surrogate_routine.indexOf("CREATE ", index_of_set);
+        if (index_of_create == -1) unexpected_error= "bad definition_of_surrogate_routine";
+        if (unexpected_error == NULL)
+        {
+          if (index_of_set == -1) first_query= definition_of_surrogate_routine.mid(0, index_of_create - 1);
+          else first_query= definition_of_surrogate_routine.mid(0, index_of_set - 1);
+          if (index_of_set != -1) second_query= definition_of_surrogate_routine.mid(index_of_set, index_of_create - index_of_set);
+          third_query= definition_of_surrogate_routine.mid(index_of_create, -1);
+          if (it_is_ok_if_proc_is_already_there == 0)
+          {
+            if (lmysql->ldbms_mysql_real_query(&mysql[MYSQL_MAIN_CONNECTION], first_query.toUtf8(), strlen(first_query.toUtf8())))
+            {
+              /* Actually, a failed drop will have to be considered to be okay. */
+            }
+          }
+          if ((unexpected_error == NULL) && (index_of_set != -1))
+          {
+            if (lmysql->ldbms_mysql_real_query(&mysql[MYSQL_MAIN_CONNECTION], second_query.toUtf8(), strlen(second_query.toUtf8())))
+            {
+              unexpected_error= "set failed";
+              break;
+            }
+          }
+          if (unexpected_error == NULL)
+          {
+            //if (iteration == 0)
+            {
+              /* Kludge. If we have DEFINER=@ we have to change to DEFINER=''@''. */
+              {
+                int i;
+                i= third_query.indexOf("DEFINER=@");
+                if (i > 0)
+                {
+                  third_query.insert(i + 8, "''");
+                }
+                i=third_query.indexOf("@ PROCEDURE `");
+                if (i < 0) i=third_query.indexOf("@ FUNCTION `");
+                if (i < 0) i=third_query.indexOf("@ TRIGGER `");
+                if (i > 0)
+                {
+                  third_query.insert(i + 1, "''");
+                }
+              }
+              if (lmysql->ldbms_mysql_real_query(&mysql[MYSQL_MAIN_CONNECTION], third_query.toUtf8(), strlen(third_query.toUtf8())))
+              {
+                /* If there's an error, the diagnostics here should go all the way back up to the user. */
+                if (it_is_ok_if_proc_is_already_there == 0)
+                {
+                  unexpected_error= "create failed";
+                  put_diagnostics_in_result(MYSQL_MAIN_CONNECTION);
+                  //second_iteration_is_necessary= 1;
+                  if (res != NULL)
+                  {
+                    lmysql->ldbms_mysql_free_result(res);
+                    res= NULL;
+                  }
+                  break;
+                }
+              }
+              list_of_drop_statements.append(first_query);
+            }
+          }
+        }
+      }
+      if (res != NULL)
+      {
+        lmysql->ldbms_mysql_free_result(res);
+        res= NULL;
+      }
+      if (res_2 != NULL)
+      {
+        lmysql->ldbms_mysql_free_result(res_2);
+        res_2= NULL;
+      }
+    }
+    if (res != NULL)
+    {
+      lmysql->ldbms_mysql_free_result(res);
+      res= NULL;
+    }
+  }
+  if (res != NULL)
+  {
+    lmysql->ldbms_mysql_free_result(res);
+    res= NULL;
+  }
+
+  lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "set session sql_mode=@xxxmdbug_saved_sql_mode");
+
+  if (unexpected_error != NULL)
+  {
+    while (list_of_drop_statements > " ")
+    {
+      int i= list_of_drop_statements.indexOf(";") + 1;
+      if (i <= 0) break;
+      QString first_query= list_of_drop_statements.left(i);
+      if (lmysql->ldbms_mysql_real_query(&mysql[MYSQL_MAIN_CONNECTION], first_query.toUtf8(), strlen(first_query.toUtf8())))
+      {
+        ; /* create failed, cleanup failed, but what can I do? */
+      }
+      list_of_drop_statements= list_of_drop_statements.right(list_of_drop_statements.size() - i);
+    }
+    if (strcmp(unexpected_error, "create failed") ==0) return; /* we already have the diagnostics */
+    put_message_in_result(unexpected_error);
+    return;
+  }
+  put_diagnostics_in_result(MYSQL_MAIN_CONNECTION);
+}
+
+
+/*
+  debug_privilege_check() -- check in advance whether some debuggee-related privileges exist
+  It will be more convenient if the user is told in advance, and is told multiple problems at once.
+  Of course I could search for the grants, but it's easier to try it and see what happens.
+  However, this doesn't consider all possibilities and is only called before initializing.
+  To see if you have execute privilege, see if you can select from information_schema.routines, rather than execute.
+  A variant of that would be selecting where routine_definition > '' if you want to look for all privileges.
+  As well as the checks here, $setup also needs routine_definition > '' i.e. you must be routine creator
+  or you must have select privilege on mysql.proc.
+  Todo: check other possible things that the debuggee could do, and check all routines not just xxxmdbug.command.
+        one way would be to say 'command' OR 'other_routine' ... but putting into a loop would be better, I think.
+  Todo: xxxmdbug.command calls xxxmdbug.privilege_checks which will generate a signal,
+        but I'm wondering whether it's good because it sends messages using init_connect every time.
+  statement_type = TOKEN_KEYWORD_DEBUG_DEBUG or TOKEN_KEYWORD_DEBUG_SETUP or TOKEN_KEYWORD_DEBUG_INSTALL.
+*/
+QString MainWindow::debug_privilege_check(int statement_type)
+{
+  QString s= "";
+  char call_statement[512];
+  unsigned int num_rows;
+  MYSQL_RES *res;
+  QString result_string;
+
+  if (connections_is_connected[0] != 1)
+  {
+    s.append("Not connected");
+    return s;
+  }
+
+  if (statement_type == TOKEN_KEYWORD_DEBUG_INSTALL)
+  {
+    /* Somebody has to have said: grant create, drop, create routine, alter routine, select, insert, update, delete, select on xxxmdbug.* ... */
+    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "create database xxxmdbug");
+    if (lmysql->ldbms_mysql_errno(&mysql[MYSQL_MAIN_CONNECTION]) == 1142) s.append("Need create privilege on xxxmdbug.*. ");
+    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "drop table if exists xxxmdbug.xxxmdbug");
+    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "create table xxxmdbug.xxxmdbug (s1 int)");
+    if ((s == "") && (lmysql->ldbms_mysql_errno(&mysql[MYSQL_MAIN_CONNECTION]) == 1142)) s.append("Need create privilege on xxxmdbug.*. ");
+    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "prepare xxxmdbug_stmt from 'select * from xxxmdbug.xxxmdbug'");
+    if (lmysql->ldbms_mysql_errno(&mysql[MYSQL_MAIN_CONNECTION]) == 1142) s.append("Need select privilege on xxxmdbug.*. ");
+    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "deallocate prepare xxxmdbug_stmt");
+    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "prepare xxxmdbug_stmt from 'insert into xxxmdbug.xxxmdbug values (1)'");
+    if (lmysql->ldbms_mysql_errno(&mysql[MYSQL_MAIN_CONNECTION]) == 1142) s.append("Need insert privilege on xxxmdbug.*. ");
+    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "deallocate prepare xxxmdbug_stmt");
+    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "prepare xxxmdbug_stmt from 'delete from xxxmdbug.xxxmdbug'");
+    if (lmysql->ldbms_mysql_errno(&mysql[MYSQL_MAIN_CONNECTION]) == 1142) s.append("Need delete privilege on xxxmdbug.*. ");
+    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "deallocate prepare xxxmdbug_stmt");
+    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "prepare xxxmdbug_stmt from 'update xxxmdbug.xxxmdbug set s1 = 1'");
+    if (lmysql->ldbms_mysql_errno(&mysql[MYSQL_MAIN_CONNECTION]) == 1142) s.append("Need update privilege on xxxmdbug.*. ");
+    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "deallocate prepare xxxmdbug_stmt");
+    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "drop table xxxmdbug.xxxmdbug");
+    if (lmysql->ldbms_mysql_errno(&mysql[MYSQL_MAIN_CONNECTION]) == 1142) s.append("Need drop privilege on xxxmdbug.*. ");
+    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "drop procedure if exists xxxmdbug.xxxmdbug");
+    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "create procedure xxxmdbug.xxxmdbug () set @a = 1");
+    if (lmysql->ldbms_mysql_errno(&mysql[MYSQL_MAIN_CONNECTION]) == 1044) s.append("Need create routine privilege on xxxmdbug.*. ");
+    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "drop procedure xxxmdbug.xxxmdbug");
+    if (lmysql->ldbms_mysql_errno(&mysql[MYSQL_MAIN_CONNECTION]) == 1370) s.append("Need alter routine privilege on xxxmdbug.*. ");
+    return s;
+  }
+
+  /* First make sure xxxmdbug exists */
+  num_rows= 0;
+  if (lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "select * from information_schema.schemata where schema_name = 'xxxmdbug'"))
+  {
+    s.append("Cannot select from information_schema");
+    return s;
+  }
+  res= lmysql->ldbms_mysql_store_result(&mysql[MYSQL_MAIN_CONNECTION]);
+  if (res != NULL)
+  {
+    num_rows= lmysql->ldbms_mysql_num_rows(res);
+    lmysql->ldbms_mysql_free_result(res);
+  }
+  if (num_rows != 1)
+  {
+    s.append("Cannot access database xxxmdbug. Check that $install was done and privileges were granted.");
+    return s;
+  }
+
+  if ((statement_type == TOKEN_KEYWORD_DEBUG_DEBUG) || (statement_type == TOKEN_KEYWORD_DEBUG_SETUP))
+  {
+    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "prepare xxxmdbug_stmt from 'select * from xxxmdbug.readme union all select * from xxxmdbug.copyright'");/* Returns 1142 if SELECT denied */
+    if (lmysql->ldbms_mysql_errno(&mysql[MYSQL_MAIN_CONNECTION]) == 1142) s.append("Need select privilege on xxxmdbug.*. ");
+    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "deallocate prepare xxxmdbug_stmt");
+    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "prepare xxxmdbug_stmt from 'create temporary table xxxmdbug.xxxmdbug_tmp (s1 int)'");/* Returns 1044 if CREATE TEMPORARY denied */
+    if (lmysql->ldbms_mysql_errno(&mysql[MYSQL_MAIN_CONNECTION]) == 1044) s.append("Need create temporary privilege on xxxmdbug.*. ");
+    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "deallocate prepare xxxmdbug_stmt");
+  }
+
+  if (statement_type == TOKEN_KEYWORD_DEBUG_DEBUG)
+  {
+    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "prepare xxxmdbug_stmt from 'set global init_connect = @@init_connect'");/* Returns 1227 if you need SUPER */
+    if (lmysql->ldbms_mysql_errno(&mysql[MYSQL_MAIN_CONNECTION]) == 1227) s.append("Need super privilege. ");
+    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "deallocate prepare xxxmdbug_stmt");
+    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "prepare xxxmdbug_stmt from 'call xxxmdbug.command()'");
+    if (lmysql->ldbms_mysql_errno(&mysql[MYSQL_MAIN_CONNECTION]) == 1044) s.append("Need execute privilege on xxxmdbug.command. ");
+    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "deallocate prepare xxxmdbug_stmt");
+  }
+
+  if (statement_type == TOKEN_KEYWORD_DEBUG_SETUP)
+  {
+    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "prepare stmt1 from 'select * from mysql.proc'");
+    if (lmysql->ldbms_mysql_errno(&mysql[MYSQL_MAIN_CONNECTION]) == 1142) s.append("Need select privilege on mysql.proc. ");
+    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "deallocate prepare xxxmdbug_stmt");
+
+    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "prepare xxxmdbug_stmt from 'create table xxxmdbug.xxxmdbug_nontmp (s1 int)'");/* Returns 1044 if CREATE TEMPORARY denied */
+    if (lmysql->ldbms_mysql_errno(&mysql[MYSQL_MAIN_CONNECTION]) == 1044) s.append("Need create privilege on xxxmdbug.*. ");
+    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "deallocate prepare xxxmdbug_stmt");
+
+    /* Can't prepare create-routine statements so test by actually creating and dropping a trivial for-test-only routine */
+    sprintf(call_statement, "create procedure xxxmdbug.xxxmdbugp () set @=@a");
+    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], call_statement);
+    if (lmysql->ldbms_mysql_errno(&mysql[MYSQL_MAIN_CONNECTION]) == 1044) s.append("Need create routine privilege on xxxmdbug.*. ");
+    else
+    {
+      sprintf(call_statement, "drop procedure xxxmdbug.xxxmdbugp");
+      lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], call_statement);
+      if (lmysql->ldbms_mysql_errno(&mysql[MYSQL_MAIN_CONNECTION]) == 1044) s.append("Need drop routine privilege on xxxmdbug.*. ");
+    }
+    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "deallocate prepare xxxmdbug_stmt");
+    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "prepare xxxmdbug_stmt from 'call xxxmdbug.setup()'");
+    if (lmysql->ldbms_mysql_errno(&mysql[MYSQL_MAIN_CONNECTION]) == 1044) s.append("Need execute privilege on xxxmdbug.setup. ");
+    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "deallocate prepare xxxmdbug_stmt");
+
+    result_string= select_1_row("select count(*) from information_schema.tables where table_schema = 'xxxmdbug' and table_name = 'setup_log'" );
+    if (result_string != "") s.append(result_string);
+    else if (select_1_row_result_1.toInt() != 0)
+    {
+      lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "prepare xxxmdbug_stmt from 'select * from xxxmdbug.setup_log'");
+      if (lmysql->ldbms_mysql_errno(&mysql[MYSQL_MAIN_CONNECTION]) == 1044) s.append("Need select privilege on xxxmdbug.setup_log. ");
+      lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "deallocate prepare xxxmdbug_stmt");
+      lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "prepare xxxmdbug_stmt from 'insert into setup_log select * from xxxmdbug.setup_log'");
+      if (lmysql->ldbms_mysql_errno(&mysql[MYSQL_MAIN_CONNECTION]) == 1044) s.append("Need insert privilege on xxxmdbug.setup_log. ");
+      lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "deallocate prepare xxxmdbug_stmt");
+      /* Todo: Find out why repair table is sometimes necessary. I know it can get corrupted but don't yet know why. */
+      if (lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "repair table xxxmdbug.setup_log"))
+      {
+        s.append("Repair Table xxxmdbug.setup_log failed");
+      }
+      else
+      {
+        res= lmysql->ldbms_mysql_store_result(&mysql[MYSQL_MAIN_CONNECTION]);
+        if (res != NULL) lmysql->ldbms_mysql_free_result(res);
+      }
+    }
+  }
+
+  /* TODO: Following isn't good. */
+
+  result_string= select_1_row("select count(*) from information_schema.routines where routine_schema = 'xxxmdbug' and routine_name = 'command'" );
+  if (result_string != "") s.append(result_string);
+  else if (select_1_row_result_1.toInt() == 0) s.append("Need execute privilege for xxxmdbug.*. ");
+  return s;
+}
+
+
+/*
+  Called from: debug_debug_go(), debug_breakpoint_or_clear_go(), or other debug_ routines that might contain arguments.
+  An SQL statement may contain comments, plus semicolon and/or delimiter, which should be stripped before passing to xxxmdbug.
+  Also these procedures need to know: which tokens (if any) are for schema, routine, start line number, end line number.
+  For example from "$DEBUG x.y -- comment;", we want to produce "debug x.y" and the offsets of x and y.
+  Possible are: breakpoint/tbreakpoint location information [condition information]
+                clear [schema_identifier[.routine_identifier]] line_number_minimum [-line_number_maximum]
+                debug [schema_identifier[.routine_identifier]
+                delete breakpoint number
+  This does not detect syntax errors, we assume xxxmdbug.command() will return an error immediately for a syntax error.
+  So it's not really a parse, but should find the tokens that matter.
+  Todo: see if confusion happens if there's condition information, or parameters enclosed inside ''s.
+  If there is clearly an error, debug_parse_statement() returns -1 and command_string has an error message.
+*/
+int MainWindow::debug_parse_statement(QString text,
+                           char *command_string,
+                           int *index_of_number_1,
+                           int *index_of_number_2)
+{
+  char token[512];
+  int i, s_len;
+  int token_type;
+  QString s;
+//  int index_of_dot= -1;
+//  int index_of_minus= -1;
+  int statement_type= 0;
+  //bool left_parenthesis_seen= false;
+  bool name_is_expected= false; /* true if syntax demands [schema_name.]routine_name at this point */
+  char default_schema_name[512];
+
+  strcpy(default_schema_name, "");
+  debug_q_schema_name_in_statement="";
+  debug_q_routine_name_in_statement="";
+  *index_of_number_1= -1;
+  *index_of_number_2= -1;
+  strcpy(command_string, "");
+  for (i= 0; main_token_lengths[i] != 0; ++i)
+  {
+    token_type= main_token_types[i];
+    if ((token_type == TOKEN_TYPE_COMMENT_WITH_SLASH)
+     || (token_type == TOKEN_TYPE_COMMENT_WITH_OCTOTHORPE)
+     || (token_type == TOKEN_TYPE_COMMENT_WITH_MINUS)) continue;
+    s= text.mid(main_token_offsets[i], main_token_lengths[i]);
+
+    if ((token_type >= TOKEN_KEYWORD_DEBUG_BREAKPOINT)
+     && (token_type <= TOKEN_KEYWORD_DEBUG_TBREAKPOINT)
+     && (strcmp(command_string, "") == 0))
+    {
+      /* We're at the first word, which is the statement type. Write it in full. */
+      statement_type= token_type;
+      if (token_type == TOKEN_KEYWORD_DEBUG_BREAKPOINT) { strcpy(command_string, "breakpoint"); name_is_expected= true; }
+      if (token_type == TOKEN_KEYWORD_DEBUG_CLEAR) { strcpy(command_string, "clear"); name_is_expected= true; }
+      if (token_type == TOKEN_KEYWORD_DEBUG_CONTINUE) strcpy(command_string, "continue");
+      if (token_type == TOKEN_KEYWORD_DEBUG_DEBUG) { strcpy(command_string, "debug"); name_is_expected= true; }
+      if (token_type == TOKEN_KEYWORD_DEBUG_DELETE) strcpy(command_string, "delete");
+      if (token_type == TOKEN_KEYWORD_DEBUG_EXECUTE) strcpy(command_string, "execute");
+      if (token_type == TOKEN_KEYWORD_DEBUG_EXIT) strcpy(command_string, "exit");
+      if (token_type == TOKEN_KEYWORD_DEBUG_INFORMATION) strcpy(command_string, "information");
+      if (token_type == TOKEN_KEYWORD_DEBUG_INSTALL) strcpy(command_string, "install");
+      if (token_type == TOKEN_KEYWORD_DEBUG_LEAVE) strcpy(command_string, "leave");
+      if (token_type == TOKEN_KEYWORD_DEBUG_NEXT) strcpy(command_string, "next");
+      if (token_type == TOKEN_KEYWORD_DEBUG_REFRESH) strcpy(command_string, "refresh");
+      if (token_type == TOKEN_KEYWORD_DEBUG_SET) strcpy(command_string, "set");
+      if (token_type == TOKEN_KEYWORD_DEBUG_SETUP) { strcpy(command_string, "setup"); name_is_expected= true; }
+      if (token_type == TOKEN_KEYWORD_DEBUG_SKIP) strcpy(command_string, "skip");
+      if (token_type == TOKEN_KEYWORD_DEBUG_SOURCE) strcpy(command_string, "source");
+      if (token_type == TOKEN_KEYWORD_DEBUG_STEP) strcpy(command_string, "step");
+      if (token_type == TOKEN_KEYWORD_DEBUG_TBREAKPOINT) { strcpy(command_string, "tbreakpoint"); name_is_expected= true; }
+      continue;
+    }
+
+    s= text.mid(main_token_offsets[i], main_token_lengths[i]);
+    s_len= s.toUtf8().size(); /* See comment "UTF8 Conversion" */
+    if (s_len + 1 >= 512) { strcpy(command_string, "overflow"); return -1; }
+    memcpy(token, s.toUtf8().constData(), s_len);
+    token[s_len]= 0;
+    if (token[0] == ';') continue;
+    if (s == ocelot_delimiter_str) continue;
+//    if (token[0] == '.') index_of_dot= i;
+//    if (token[0] == '-') index_of_minus= i;
+//    if (token[0] == '(') left_parenthesis_seen= true;
+    if (name_is_expected)
+    {
+      if ((token_type == TOKEN_TYPE_OTHER)
+       || (token_type == TOKEN_TYPE_IDENTIFIER)
+       || (token_type == TOKEN_TYPE_IDENTIFIER_WITH_DOUBLE_QUOTE)
+       || (token_type == TOKEN_TYPE_IDENTIFIER_WITH_BACKTICK))
+      {
+        /* It's possibly a routine name, and we're expecting a routine name. */
+        char tmp_schema_name[512];
+        char tmp_routine_name[512];
+        int s2_len;
+        QString s2;
+        if (text.mid(main_token_offsets[i + 1], 1) == ".")
         {
-          if (index_of_set == -1) first_query= definition_of_surrogate_routine.mid(0, index_of_create - 1);
-          else first_query= definition_of_surrogate_routine.mid(0, index_of_set - 1);
-          if (index_of_set != -1) second_query= definition_of_surrogate_routine.mid(index_of_set, index_of_create - index_of_set);
-          third_query= definition_of_surrogate_routine.mid(index_of_create, -1);
-          if (it_is_ok_if_proc_is_already_there == 0)
+          /* schema-name . routine_name */
+          if ((main_token_types[i + 2] == TOKEN_TYPE_OTHER)
+           || (main_token_types[i + 2] == TOKEN_TYPE_IDENTIFIER)
+           || (token_type == TOKEN_TYPE_IDENTIFIER_WITH_DOUBLE_QUOTE)
+           || (main_token_types[i + 2] == TOKEN_TYPE_IDENTIFIER_WITH_BACKTICK))
           {
-            if (lmysql->ldbms_mysql_real_query(&mysql[MYSQL_MAIN_CONNECTION], first_query.toUtf8(), strlen(first_query.toUtf8())))
-            {
-              /* Actually, a failed drop will have to be considered to be okay. */
-            }
+            strcpy(tmp_schema_name, token);
+            s2= text.mid(main_token_offsets[i + 2], main_token_lengths[i + 2]);
+            s2_len= s2.toUtf8().size(); /* See comment "UTF8 Conversion" */
+            if (s2_len + 1 + s_len + 1 >= 512) { strcpy(command_string, "overflow"); return -1; }
+            memcpy(tmp_routine_name, s2.toUtf8().constData(), s2_len);
+            tmp_routine_name[s2_len]= 0;
+            i+= 2;
           }
-          if ((unexpected_error == NULL) && (index_of_set != -1))
+          else
           {
-            if (lmysql->ldbms_mysql_real_query(&mysql[MYSQL_MAIN_CONNECTION], second_query.toUtf8(), strlen(second_query.toUtf8())))
-            {
-              unexpected_error= "set failed";
-              break;
-            }
+            strcpy(command_string, "Expected routine-name after .");
+            return -1;
           }
-          if (unexpected_error == NULL)
+        }
+        else
+        {
+          /* Just routine name. Fill in [default schema name]. Todo: shouldn't require a server request so frequently. */
+          if (strcmp(default_schema_name, "") == 0)
           {
-            //if (iteration == 0)
-            {
-              /* Kludge. If we have DEFINER=@ we have to change to DEFINER=''@''. */
-              {
-                int i;
-                i= third_query.indexOf("DEFINER=@");
-                if (i > 0)
-                {
-                  third_query.insert(i + 8, "''");
-                }
-                i=third_query.indexOf("@ PROCEDURE `");
-                if (i < 0) i=third_query.indexOf("@ FUNCTION `");
-                if (i < 0) i=third_query.indexOf("@ TRIGGER `");
-                if (i > 0)
-                {
-                  third_query.insert(i + 1, "''");
-                }
-              }
-              if (lmysql->ldbms_mysql_real_query(&mysql[MYSQL_MAIN_CONNECTION], third_query.toUtf8(), strlen(third_query.toUtf8())))
-              {
-                /* If there's an error, the diagnostics here should go all the way back up to the user. */
-                if (it_is_ok_if_proc_is_already_there == 0)
-                {
-                  unexpected_error= "create failed";
-                  put_diagnostics_in_result(MYSQL_MAIN_CONNECTION);
-                  //second_iteration_is_necessary= 1;
-                  if (res != NULL)
-                  {
-                    lmysql->ldbms_mysql_free_result(res);
-                    res= NULL;
-                  }
-                  break;
-                }
-              }
-              list_of_drop_statements.append(first_query);
-            }
+            QString result_string;
+            select_1_row_result_1= "";
+            result_string= select_1_row("select database()");
+            if (result_string != "") { strcpy(command_string, "Need to know default database but select database() failed"); return -1; }
+            if (select_1_row_result_1== "") { strcpy(command_string, "Need to know default database but select database() returned nothing"); return -1; }
+            s2= select_1_row_result_1;
+            s2_len= s2.toUtf8().size();
+            if (s2_len + 1 + s_len + 1 >= 512) { strcpy(command_string, "overflow"); return -1; }
+            memcpy(default_schema_name, s2.toUtf8().constData(), s2_len);
+            default_schema_name[s2_len]= 0;
+          }
+          strcpy(tmp_routine_name, token);
+          strcpy(tmp_schema_name, default_schema_name);
+        }
+        name_is_expected= false;
+        strcpy(token, tmp_schema_name);
+        strcat(token, ".");
+        strcat(token, tmp_routine_name);
+
+        {
+          QString result_string;
+          char query_for_select_check[512];
+          sprintf(query_for_select_check, "select count(*) from information_schema.routines where routine_schema='%s' and routine_name='%s'", tmp_schema_name, tmp_routine_name);
+          result_string= select_1_row(query_for_select_check);
+          if (result_string != "") { strcpy(command_string, "Tried to check routine name but select from information_schema.routines failed"); return -1; }
+          if (select_1_row_result_1.toInt() == 0)
+          {
+            sprintf(command_string, "Could not find routine %s.%s", tmp_schema_name, tmp_routine_name);
+            return -1;
           }
+
         }
+
+        debug_q_schema_name_in_statement= tmp_schema_name;
+        debug_q_routine_name_in_statement= tmp_routine_name;
+      }
+      else
+      {
+        /* It's not possibly a routine identifier, and we're expecting a routine identifier. */
+        strcpy(command_string, "Expected a routine name"); return -1;
+      }
+    }
+    if ((token[0] == ',') && (statement_type == TOKEN_KEYWORD_DEBUG_SETUP)) name_is_expected= true;
+
+    if ((token_type == TOKEN_TYPE_LITERAL_WITH_DIGIT)
+     || (token_type == TOKEN_TYPE_LITERAL))
+    {
+      if (*index_of_number_1 == -1) *index_of_number_1= i;
+      else if (*index_of_number_2 == -1) *index_of_number_2= i;
+    }
+    if (strlen(command_string) + strlen(token) + 1 >= 512) { strcpy(command_string, "overflow"); return -1; }
+    if (strcmp(command_string, "") != 0) strcat(command_string, " ");
+    strcat(command_string, token);
+  }
+  return 0;
+}
+
+
+/*
+  First: find the surrogate routine that debuggee will call (if it's not there, error = you should call setup).
+  Todo: schema_name could be '.' i.e. default
+  Then: put up debug_top_widget
+  Then: execute xxxmdbug.command(...,'debug ...')
+  Todo: check that surrogate routine is not obsolete, i.e. timestamp is after original routine's timestamp
+  Todo: check that everything in the group is present and executable
+  Todo: check that user is the same ... but how can you do that? Is it only in setup_log?
+  Todo: get rid of initialize() from menu
+  Todo: when starting, make sure debuggee is not already running -- even a finished routine is not over
+  Todo: if clicking causes you to get to action_debug_debug() you must generate a $DEBUG statement -- but how click a list??
+*/
+//void MainWindow::action_debug_debug()
+//{
+//  /* Figure out what the parameter should be -- it's not text, eh? */
+//  QString parameter;
+//  debug_debug_go(parameter);
+//}
+
+
+/*
+  Call debug_error((char*)"error-text") whenever, in one of the debug routines, you encounter an error.
+  Call debug_error((char*)"") regardless, at the start of a debug routine, so basic prerequisite checks can happen.
+  For example, if the user says "$debug test.x" and there is no surrogate for x, we want the user to see:
+  Error 1644 (05678) Surrogate not found.
+  TODO: make sure all the debug-routine failures go through here!
+  Todo: if the error is due to a failure of the last call, add what that last call's error message was.
+*/
+int MainWindow::debug_error(char *text)
+{
+//  unsigned int statement_type;
+
+  if (connections_is_connected[0] == 0)
+  {
+    /* Unfortunately this might not get through. */
+    make_and_put_message_in_result(ER_NOT_CONNECTED, 0, (char*)"");
+    return 1;
+  }
+
+  if (debuggee_state < 0)
+  {
+    char tmp_string[STRING_LENGTH_512]="";
+    char tmp_string_2[STRING_LENGTH_512 + 64];
+    if (debuggee_state != DEBUGGEE_STATE_END)
+    {
+      /* debuggee_state_error should tell us something, but remove all ' first */
+      strcpy(tmp_string, debuggee_state_error);
+      for (int i= 0; tmp_string[i] != '\0'; ++i) if (tmp_string[i] == '\047') tmp_string[i]= ' ';
+    }
+    if (debuggee_state == DEBUGGEE_STATE_END)
+    {
+      make_and_put_message_in_result(ER_ROUTINE_HAS_STOPPED, 0, (char*)"");
+    }
+    else
+    {
+      sprintf(tmp_string_2, "'%s %d. %s'", "debuggee_state:", debuggee_state, tmp_string);
+      put_message_in_result(tmp_string_2);
+    }
+    return 1;
+  }
+
+
+  if (strcmp(text,"") != 0)
+  {
+    put_message_in_result(text);
+    return 1;
+  }
+
+  return 0;
+}
+
+
+/* $DEBUG [schema.]routine [(parameters)] */
+void MainWindow::debug_debug_go(QString text) /* called from execute_client_statement() or action_debug_debug() */
+{
+  char routine_schema[512];
+  char routine_name[512];
+  char call_statement[512];
+  QString result_string;
+  QString qstring_error_message;
+  int current_widget_index;
+  QString q_routine_schema, q_routine_name;
+  char command_string[2048];
+  int index_of_number_1, index_of_number_2;
+
+  /* Todo: Check that 'debug' has not happened */
+
+  if (debug_parse_statement(text, command_string, &index_of_number_1, &index_of_number_2) < 0)
+  {
+    if (debug_error(command_string) != 0) return;
+  }
+
+  q_routine_schema= debug_q_schema_name_in_statement;
+  q_routine_name= debug_q_routine_name_in_statement;
+
+  if ((q_routine_schema == "") || (q_routine_name == ""))
+  {
+    if (debug_error((char*)er_strings[er_off + ER_MISSING_ROUTINE_NAME]) != 0) return;
+  }
+
+  /*
+    If a $debug was started before, and didn't finish, we demand that the user do $exit.
+    We could instead call debug_exit_go(1).
+    Perhaps $exit will fail somehow, and users will be falsely told they can't debug.
+    That's a bug but better than hanging, which is a risk if we make two debug threads.
+  */
+  if (debug_thread_exists == true)
+  {
+    if (debug_error((char*)er_strings[er_off + ER_DEBUG_IS_ALREADY_RUNNING]) != 0) return;
+  }
+
+  if (debuggee_state < 0) debuggee_state= DEBUGGEE_STATE_0;
+  if (debuggee_state == DEBUGGEE_STATE_END) debuggee_state= DEBUGGEE_STATE_0;
+  if (debug_error((char*)"") != 0) return;
+
+  strcpy(routine_schema, q_routine_schema.toUtf8());
+  strcpy(routine_name, q_routine_name.toUtf8());
+
+  if (debuggee_state > 0)
+  {
+    if (debug_error((char*)er_strings[er_off + ER_DEBUG_IS_ALREADY_RUNNING]) != 0) return;
+  }
+
+  qstring_error_message= debug_privilege_check(TOKEN_KEYWORD_DEBUG_DEBUG);
+  if (qstring_error_message != "")
+  {
+    strcpy(command_string, qstring_error_message.toUtf8());
+    if (debug_error(command_string) != 0) return; /* debuggee wouldn't be able to operate so fail */
+  }
+
+  /* Call xxxmdbug.debuggee_get_surrogate_name */
+  strcpy(call_statement, "CALL xxxmdbug.debuggee_get_surrogate_name('");
+  strcat(call_statement, routine_name);
+  strcat(call_statement, "','");
+  strcat(call_statement, routine_schema);
+  strcat(call_statement, "',@schema_identifier,@surrogate_routine_identifier,@routine_type,@remainder_of_original_name)");
+  if (lmysql->ldbms_mysql_real_query(&mysql[MYSQL_MAIN_CONNECTION], call_statement, strlen(call_statement)))
+  {
+    if (debug_error((char*)er_strings[er_off + ER_SURROGATE]) != 0) return;
+  }
+  result_string= select_1_row("select @schema_identifier, concat(left(@surrogate_routine_identifier,11), '%'), @routine_type, @remainder_of_original_name, isnull(@schema_identifier)");
+  if (result_string != "")
+  {
+    char char_result_string[512];
+    strcpy(char_result_string, result_string.toUtf8());
+    if (debug_error(char_result_string) != 0) return;
+  }
+  /* select_1_row_result_1 = @schema_identifier. select_1_row_result_2 = left(@surrogate_routine_identifier,11) || '%'. */
+
+  /* Todo: this checks whether select returned null, good. But it should make even more certain that $debug will succeed. */
+  if (select_1_row_result_5.toInt() == 1)
+  {
+    if (debug_error((char*)er_strings[er_off + ER_SURROGATE_NOT_FOUND]) != 0) return;
+  }
+
+  QString routine_schema_name_for_search= select_1_row_result_1;
+  QString routine_name_for_search= select_1_row_result_2;
+
+  /*
+    This will find all surrogate routines which have the same prefix, xxxmdbug___
+    That means they're in the same group. Ignore icc_core.
+    Get only the part that's not part of the prefix.
+    Interesting idea: you could have a way to show both the surrogate and the original.
+  */
+  int i, j;
+  char i_as_string[10];
+  /* Todo: n should not be hard-coded here, it limits us to only 10 routines can be searched */
+  for (i= 0, j= 0; i < DEBUG_TAB_WIDGET_MAX; ++i)
+  {
+    sprintf(i_as_string, "%d", i);
+    strcpy(call_statement, "select routine_schema, right(routine_name,length(routine_name)-12) from information_schema.routines ");
+    strcat(call_statement, "where routine_schema = '");
+    strcat(call_statement, routine_schema_name_for_search.toUtf8());
+    strcat(call_statement, "' and routine_name like '");
+    strcat(call_statement, routine_name_for_search.toUtf8());
+    strcat(call_statement, "' order by routine_name limit 1 offset ");
+    strcat(call_statement, i_as_string);
+    result_string= select_1_row(call_statement);
+    if (result_string != "")
+    {
+      char char_result_string[512];
+      if (result_string == er_strings[er_off + ER_MYSQL_FETCH_ROW_FAILED]) break;
+      strcpy(char_result_string, result_string.toUtf8());
+      if (debug_error(char_result_string) != 0) return;
+    }
+    if (select_1_row_result_2 != "icc_core")
+    {
+      /* Todo: debug_routine_schema_name and debug_routine_name are global so setup() will ruin them. Fix that! */
+      debug_routine_schema_name[j]= select_1_row_result_1;
+      debug_routine_name[j]= select_1_row_result_2;
+      ++j;
+    }
+  }
+
+  /* Todo: check: can this crash if there are DEBUG_TAB_WIDGET_MAX routines? Is this unnecessary if there are DEBUG_TAB_WIDGET_MAX routines? */
+  debug_routine_name[j]= "";
+
+  int debug_widget_index;
+
+  /* Todo: check if this is useless. You're supposed to have called debug_delete_tab_widgets[] during $exit. */
+  for (debug_widget_index= 0; debug_widget_index < DEBUG_TAB_WIDGET_MAX; ++debug_widget_index)
+  {
+    debug_widget[debug_widget_index]= 0;
+  }
+
+  /* After this point, some items that get created are persistent, so be sure to clear them if there's an error. */
+
+  //MYSQL_RES *debug_res;
+  //MYSQL_ROW row;
+  QString routine_definition;
+  current_widget_index= -1;
+  for (debug_widget_index= 0; debug_widget_index < DEBUG_TAB_WIDGET_MAX; ++debug_widget_index)
+  {
+    if (strcmp(debug_routine_name[debug_widget_index].toUtf8(), "") == 0) break;
+    strcpy(call_statement, "select routine_definition from information_schema.routines where routine_schema = '");
+    strcat(call_statement, debug_routine_schema_name[debug_widget_index].toUtf8());
+    strcat(call_statement, "' and routine_name = '");
+    strcat(call_statement, debug_routine_name[debug_widget_index].toUtf8());
+    strcat(call_statement, "'");
+    QString error_return= select_1_row(call_statement);
+    if (error_return != "")
+    {
+      debug_delete_tab_widgets();                          /* delete already-made widgets. Rest of 'exit' shouldn't happen. */
+      {
+        /* Could not find a routine in the $setup group: ... */
+        char t_error_return[256];
+        char t_schema_name[256];
+        char t_routine_name[256];
+        strcpy(t_error_return, error_return.toUtf8());
+        strcpy(t_schema_name, debug_routine_schema_name[debug_widget_index].toUtf8());
+        strcpy(t_routine_name, debug_routine_name[debug_widget_index].toUtf8());
+        sprintf(call_statement,
+                er_strings[er_off + ER_COULD_NOT_FIND_A_ROUTINE],
+                t_error_return,
+                t_schema_name,
+                t_routine_name);
       }
-      if (res != NULL)
+      debug_error(call_statement);                         /* Todo: you forgot to look for icc_core */
+      return;
+    }
+    routine_definition= select_1_row_result_1;             /* = information_schema.routines.routine_definition */
+
+    if (routine_definition == "")
+    {
+      debug_delete_tab_widgets();
       {
-        lmysql->ldbms_mysql_free_result(res);
-        res= NULL;
+        /* Could not get a routine definition for ... */
+        char t_routine_name[256];
+        strcpy(t_routine_name, debug_routine_name[debug_widget_index].toUtf8());
+        sprintf(call_statement, er_strings[er_off + ER_COULD_NOT_GET], t_routine_name);
       }
-      if (res_2 != NULL)
+      if (debug_error(call_statement)) return;
+    }
+
+    debug_widget[debug_widget_index]= new CodeEditor(this);
+    debug_widget[debug_widget_index]->is_debug_widget= true;
+    debug_widget[debug_widget_index]->statement_edit_widget_left_bgcolor= QColor(ocelot_statement_prompt_background_color);
+    debug_widget[debug_widget_index]->statement_edit_widget_left_treatment1_textcolor= QColor(ocelot_statement_text_color);
+
+    debug_maintain_prompt(0, debug_widget_index, 0); /* clear prompt_as_input_by_user */
+
+    debug_widget[debug_widget_index]->setStyleSheet(ocelot_statement_style_string);
+
+    /* todo: call 'refresh breakpoints' and debug_maintain_prompt() for breakpoints that already have been set up. */
+    debug_widget[debug_widget_index]->prompt_default= (QString)"\\2 \\L";
+    debug_widget[debug_widget_index]->result= (QString)"ABCDEFG";
+    debug_widget[debug_widget_index]->setPlainText(routine_definition);
+
+    debug_widget[debug_widget_index]->setReadOnly(false);                 /* if debug shouldn't be editable, set to "true" here */
+    debug_widget[debug_widget_index]->installEventFilter(this);           /* is this necessary? */
+    debug_tab_widget->addTab(debug_widget[debug_widget_index], debug_routine_name[debug_widget_index]);
+
+    if ((QString::compare(debug_routine_name[debug_widget_index], q_routine_name, Qt::CaseInsensitive) == 0)
+    &&  (QString::compare(debug_routine_schema_name[debug_widget_index], q_routine_schema, Qt::CaseInsensitive) == 0))
+    {
+      current_widget_index= debug_widget_index;
+    }
+  }
+
+  if (current_widget_index == -1)
+  {
+    debug_delete_tab_widgets();
+    if (debug_error((char*)er_strings[er_off + ER_ROUTINE_IS_MISSING])) return;
+  }
+
+  debug_tab_widget->setCurrentIndex(current_widget_index);
+
+  /* Getting ready to create a separate thread for the debugger and 'attach' to it */
+
+  char error_message[512];
+
+  debuggee_state= DEBUGGEE_STATE_0;
+
+  /*
+    We want a channel name that will differ from what others might choose.
+    Arbitrary decision = debug_channel_name will be "ch#" || connection-number-of-main-connection.
+    It could be uniquified beyond that if necessary, e.g. add user name.
+    Todo: this could be moved so it doesn't happen every time $debug happens. */
+
+  sprintf(debuggee_channel_name, "ch#%d", statement_edit_widget->dbms_connection_id);
+
+  /* Create a debuggee thread. */
+  /* Todo: consider whether it would have been better to use the Qt QThread function */
+  int pthread_create_result= pthread_create(&debug_thread_id, NULL, &debuggee_thread, NULL);
+  assert(pthread_create_result == 0);
+  debug_thread_exists= true;
+
+  /*
+    Wait till debuggee has indicated that it is about to call debuggee_wait_loop().
+    Todo: Give a better diagnostic if this doesn't happen.
+    Todo: Is it possible to fail anyway? If so, sleep + repeat?
+    Todo: This gives up after 1 second. Maybe on a heavily loaded machine that's too early?
+  */
+  for (int k= 0; k < 100; ++k)
+  {
+    QThread48::msleep(10);
+    if (debuggee_state == DEBUGGEE_STATE_DEBUGGEE_WAIT_LOOP) break;
+  }
+  QThread48::msleep(10); /* in case debuggee_wait_loop() fails immediately */
+  if (debuggee_state != DEBUGGEE_STATE_DEBUGGEE_WAIT_LOOP)
+  {
+    /* Todo: if somehow (bizarrely) debuggee_state >= 0, then the thread did not end and needs to be stopped. */
+    debug_delete_tab_widgets();
+    sprintf(error_message, er_strings[er_off + ER_DEBUGGEE_NOT_RESPONDING], debuggee_state);
+    if (debug_error(error_message) != 0) return;
+  }
+  /*
+    Attach to the debuggee.
+    Todo: Check: is it possible for this to fail because thread has not connected yet? If so, sleep + repeat?
+    Todo: Check: why use insertPlainText not setPlainText?
+  */
+
+  strcpy(call_statement, "call xxxmdbug.command('");
+  strcat(call_statement, debuggee_channel_name);
+  strcat(call_statement, "', 'attach');\n");
+
+  if (lmysql->ldbms_mysql_real_query(&mysql[MYSQL_MAIN_CONNECTION], call_statement, strlen(call_statement)))
+  {
+    /* Attach failed. Doubtless there's some sort of error message. Put it out now, debug_exit_go() won't override it. */
+    put_diagnostics_in_result(MYSQL_MAIN_CONNECTION);
+    debug_exit_go(1); /* This tries to tell the debuggee to stop, because we're giving up. */
+    return;
+  }
+
+  debug_timer_old_line_number= -1;
+  debug_timer_old_schema_identifier[0]= '\0';
+  debug_timer_old_routine_identifier[0]= '\0';
+  debug_timer_old_commands_count= -1;
+  debug_timer_old_number_of_status_message= -1;
+  debug_timer_old_icc_count= -1;
+  debug_timer_old_debug_widget_index= -1;
+  debug_timer->start(DEBUG_TIMER_INTERVAL);
+
+  /* By the way, we fill in [schema.] if it's missing, because otherwise default would be 'test'. */
+
+  //  strcpy(call_statement, "debug ");
+  //if (strcmp(routine_schema, "") != 0)
+  //{
+  //  strcat(call_statement, routine_schema);
+  //  strcat(call_statement, ".");
+  //}
+  //strcat(call_statement, routine_name);
+
+  /*
+    To work around a flaw in MDBug, convert all ' to ''.
+    Todo: This does not solve for $debug var_proc(''a''bc'');
+    so the manual should recommend: use an escape for '.
+    Todo: Check if other debug commands containing ', e.g. conditional breakpoints, work.
+  */
+  if (strchr(command_string, 0x27) != NULL)
+  {
+    char command_string_2[2048];
+    char *iptr, *optr;
+    for (iptr= command_string, optr= command_string_2;;)
       {
-        lmysql->ldbms_mysql_free_result(res_2);
-        res_2= NULL;
-      }
+      if (*iptr == 0x27) { *optr= 0x27; ++optr; }
+      *optr= *iptr;
+      if (*iptr == '\0') break;
+      ++iptr;
+      ++optr;
     }
-    if (res != NULL)
+    strcpy(command_string, command_string_2);
+  }
+
+  if (debug_call_xxxmdbug_command(command_string) != 0)
+  {
+    /* Debug failed. Doubtless there's some sort of error message. Put it out now, debug_exit_go() won't override it. */
+    put_diagnostics_in_result(MYSQL_MAIN_CONNECTION);
+    debug_exit_go(1); /* This tries to tell the debuggee to stop, because we're giving up. */
+    return;
+  }
+  put_diagnostics_in_result(MYSQL_MAIN_CONNECTION);
+
+  /* TODO: next line was removed TEMPORARILY. But maybe highlighting will occur due to temporary breakpoint? */
+  //debug_highlight_line(); /* highlight the first line. todo: should be the first executable line, no? */
+  debug_top_widget->show(); /* Is this necessary? I think so because initially debug_window should be hidden. */
+
+  debug_menu_enable_or_disable(TOKEN_KEYWORD_DEBUG_DEBUG);             /* Until now most debug menu items were gray. */
+}
+
+
+/*
+  Change the contents of debug_widget[debug_widget_index]->prompt_as_input_by_user.
+  action: 0 = initialize/clear, 1 = add breakpoint, 2 = delete breakpoint, 3 = add tbreakpoint
+  line_number: irrelevant if action == 0, else line number for add/clear
+  We have to set the prompt -- the separated-from-the-text stuff on the left -- so that it shows
+  the line numbers with \2 \L, and shows the breakpoints with K(line-number).
+  We avoid 'refresh breakpoints' because it waits for debuggee to be free; hope it doesn't get out of synch.
+  We should end up with something like "\2 \L \K(5,red,Ⓑ) \K(4,red,Ⓑ)" if there are breakpoints on line 5 and line 4.
+  Todo: Even if we're doing adds, do all the deletes first so that if this is called twice there won't be a duplicate.
+        (Todo: I think the debuggee would not make duplicates, but that needs checking.)
+  Todo: breakpoint and tbreakpoint look the same in this scheme.
+*/
+void MainWindow::debug_maintain_prompt(int action, int debug_widget_index, int line_number)
+{
+  if (action == 0)                                                         /* clear */
+  {
+    debug_widget[debug_widget_index]->prompt_as_input_by_user= (QString)"\\2 \\L";
+    return;
+  }
+  QString prompt_including_symbol;
+  QString breakpoint_symbol;
+
+  prompt_including_symbol= (QString)" \\K(";
+  prompt_including_symbol.append(QString::number(line_number));
+  breakpoint_symbol= QChar(0x24b7);                                        /* CIRCLED LATIN CAPITAL LETTER B */
+  prompt_including_symbol.append(",red,");
+  prompt_including_symbol.append(breakpoint_symbol);
+  prompt_including_symbol.append(")");
+
+  if (action == 2)                                                        /* delete (well, actually: clear */
+  {
+    /* I don't expect that indexOf() could return -1, and I ignore it if it does happen. */
+    int index_of_prompt;
+    index_of_prompt= debug_widget[debug_widget_index]->prompt_default.indexOf(prompt_including_symbol);
+    if (index_of_prompt >= 0) debug_widget[debug_widget_index]->prompt_default.remove(index_of_prompt, prompt_including_symbol.size());
+    index_of_prompt= debug_widget[debug_widget_index]->prompt_as_input_by_user.indexOf(prompt_including_symbol);
+    if (index_of_prompt >= 0) debug_widget[debug_widget_index]->prompt_as_input_by_user.remove(index_of_prompt, prompt_including_symbol.size());
+  }
+  if ((action == 1) || (action == 3))                                    /* add */
+  {
+    debug_widget[debug_widget_index]->prompt_default.append(prompt_including_symbol);
+    debug_widget[debug_widget_index]->prompt_as_input_by_user.append(prompt_including_symbol);
+  }
+}
+
+
+/*
+  Find out what is current routine and current line, put a symbol beside it.
+  Execute a command e.g. "debug test.p8 5".
+  So far: we get block_number = current line number - 1.
+  Todo: we don't show the B in a circle!
+  Do not confuse with action_mousebuttonpress which also generates "$breakpoint ...".
+*/
+void MainWindow::action_debug_breakpoint()
+{
+  char command[512];
+  int line_number;
+  char line_number_as_string[10];
+
+  int debug_widget_index= debug_tab_widget->currentIndex();
+  /* I can't imagine how currentIndex() could be == -1, but if it is, do nothing. */
+  if (debug_widget_index < 0) return;
+  line_number= debug_widget[debug_widget_index]->block_number + 1;
+  sprintf(line_number_as_string, "%d", line_number);
+  strcpy(command, "$BREAKPOINT ");
+  strcat(command, debug_routine_schema_name[debug_widget_index].toUtf8());
+  strcat(command,".");
+  strcat(command, debug_routine_name[debug_widget_index].toUtf8());
+  strcat(command, " ");
+  strcat(command, line_number_as_string);
+
+  statement_edit_widget->setPlainText(command);
+  action_execute(1);
+}
+
+
+/*
+  "breakpoint" and "clear" and "tbreakpoint" have the same argument syntax so we use the same routine for all,
+  passing statement_type == TOKEN_KEYWORD_DEBUG_BREAKPOINT or TOKEN_KEYWORD_DEBUG_CLEAR.
+  Todo: "$breakpoint ... hit_count = N" is not working.
+  Todo: "$breakpoint ... variable_name <> old" is not working.
+*/
+void MainWindow::debug_breakpoint_or_clear_go(int statement_type, QString text)
+{
+  char command_string[512];
+  int index_of_number_1, index_of_number_2;
+  QString routine_name;
+  QString schema_name;
+
+  /* Todo: Check that 'debug' has happened */
+  if (debuggee_state != DEBUGGEE_STATE_DEBUGGEE_WAIT_LOOP)
+  {
+    if (debug_error((char*)er_strings[er_off + ER_NO_DEBUG_SESSION]) != 0) return;
+  }
+
+  if (debug_parse_statement(text, command_string, &index_of_number_1, &index_of_number_2) < 0)
+  {
+    char error_message[512];
+    if (statement_type == TOKEN_KEYWORD_DEBUG_BREAKPOINT)
+      strcpy(error_message, er_strings[er_off + ER_BREAKPOINT_SYNTAX]);
+    else if (statement_type == TOKEN_KEYWORD_DEBUG_TBREAKPOINT)
+      strcpy(error_message, er_strings[er_off + ER_TBREAKPOINT_SYNTAX]);
+    else
+      strcpy(error_message, er_strings[er_off + ER_CLEAR_SYNTAX]);
+    if (debug_error(error_message) != 0) return;
+  }
+  schema_name= debug_q_schema_name_in_statement;
+  routine_name= debug_q_routine_name_in_statement;
+
+  if ((schema_name == "") || (routine_name == ""))
+  {
+    if (debug_error((char*)er_strings[er_off + ER_MISSING_ROUTINE_NAME]) != 0) return;
+  }
+
+  if (debug_error((char*)"") != 0) return;
+
+  if (debug_call_xxxmdbug_command(command_string) != 0)
+  {
+    put_diagnostics_in_result(MYSQL_MAIN_CONNECTION);
+    return;
+  }
+
+  /* Figure out line number and debug_widget_index from the index variables. */
+  /* Todo: This is failing to compare schema name. */
+
+  int debug_widget_index;
+
+  for (debug_widget_index= 0; debug_widget_index < DEBUG_TAB_WIDGET_MAX; ++debug_widget_index)
+  {
+    if (debug_widget[debug_widget_index] != 0)
     {
-      lmysql->ldbms_mysql_free_result(res);
-      res= NULL;
+      if ((QString::compare(routine_name, debug_routine_name[debug_widget_index]) == 0)
+       && (QString::compare(schema_name, debug_routine_schema_name[debug_widget_index]) == 0)) break;
     }
   }
-  if (res != NULL)
+
+  if (debug_widget_index == DEBUG_TAB_WIDGET_MAX)
   {
-    lmysql->ldbms_mysql_free_result(res);
-    res= NULL;
+    if (debug_error((char*)"No such routine") != 0) return;
   }
 
-  lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "set session sql_mode=@xxxmdbug_saved_sql_mode");
+  int line_number_1, line_number_2;
+  QString q_line_number;
+  q_line_number= text.mid(main_token_offsets[index_of_number_1], main_token_lengths[index_of_number_1]);
+  line_number_1= q_line_number.toInt();
+  if (index_of_number_2 == -1) line_number_2= line_number_1;
+  else
+  {
+    q_line_number= text.mid(main_token_offsets[index_of_number_2], main_token_lengths[index_of_number_2]);
+    line_number_2= q_line_number.toInt();
+  }
 
-  if (unexpected_error != NULL)
+  for (int i= line_number_1; i <= line_number_2; ++i)
   {
-    while (list_of_drop_statements > " ")
+    if (i > debug_widget[debug_widget_index]->blockCount())
     {
-      int i= list_of_drop_statements.indexOf(";") + 1;
-      if (i <= 0) break;
-      QString first_query= list_of_drop_statements.left(i);
-      if (lmysql->ldbms_mysql_real_query(&mysql[MYSQL_MAIN_CONNECTION], first_query.toUtf8(), strlen(first_query.toUtf8())))
-      {
-        ; /* create failed, cleanup failed, but what can I do? */
-      }
-      list_of_drop_statements= list_of_drop_statements.right(list_of_drop_statements.size() - i);
+      break;
     }
-    if (strcmp(unexpected_error, "create failed") ==0) return; /* we already have the diagnostics */
-    put_message_in_result(unexpected_error);
-    return;
+    if (statement_type == TOKEN_KEYWORD_DEBUG_BREAKPOINT) debug_maintain_prompt(1, debug_widget_index, i);
+    if (statement_type == TOKEN_KEYWORD_DEBUG_CLEAR) debug_maintain_prompt(2, debug_widget_index, i);
+    if (statement_type == TOKEN_KEYWORD_DEBUG_TBREAKPOINT) debug_maintain_prompt(3, debug_widget_index, i);
   }
+  /*
+    Todo: I have had trouble, sometimes the breakpoint symbols don't show up unless I click on the line.
+          I think that one of these kludges is helping, but I don't know if it always helps,
+          and I don't know which of the two lines is actually fixing the problem,
+          and I don't know whether there's a better way. So find out, eh?
+  */
+  debug_widget[debug_widget_index]->repaint();
+  debug_widget[debug_widget_index]->viewport()->update();
   put_diagnostics_in_result(MYSQL_MAIN_CONNECTION);
 }
 
 
 /*
-  debug_privilege_check() -- check in advance whether some debuggee-related privileges exist
-  It will be more convenient if the user is told in advance, and is told multiple problems at once.
-  Of course I could search for the grants, but it's easier to try it and see what happens.
-  However, this doesn't consider all possibilities and is only called before initializing.
-  To see if you have execute privilege, see if you can select from information_schema.routines, rather than execute.
-  A variant of that would be selecting where routine_definition > '' if you want to look for all privileges.
-  As well as the checks here, $setup also needs routine_definition > '' i.e. you must be routine creator
-  or you must have select privilege on mysql.proc.
-  Todo: check other possible things that the debuggee could do, and check all routines not just xxxmdbug.command.
-        one way would be to say 'command' OR 'other_routine' ... but putting into a loop would be better, I think.
-  Todo: xxxmdbug.command calls xxxmdbug.privilege_checks which will generate a signal,
-        but I'm wondering whether it's good because it sends messages using init_connect every time.
-  statement_type = TOKEN_KEYWORD_DEBUG_DEBUG or TOKEN_KEYWORD_DEBUG_SETUP or TOKEN_KEYWORD_DEBUG_INSTALL.
+  Todo: The problem with "delete n" is we don't know which breakpoint is n.
+  Of course it's in xxxmdbug.breakpoints, but "r breakpoints" only works if we're at a breakpoint.
 */
-QString MainWindow::debug_privilege_check(int statement_type)
+void MainWindow::debug_delete_go()
 {
-  QString s= "";
-  char call_statement[512];
-  unsigned int num_rows;
-  MYSQL_RES *res;
-  QString result_string;
+  make_and_put_message_in_result(ER_DELETE_STATEMENT, 0, (char*)"");
+}
 
-  if (connections_is_connected[0] != 1)
-  {
-    s.append("Not connected");
-    return s;
-  }
 
-  if (statement_type == TOKEN_KEYWORD_DEBUG_INSTALL)
-  {
-    /* Somebody has to have said: grant create, drop, create routine, alter routine, select, insert, update, delete, select on xxxmdbug.* ... */
-    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "create database xxxmdbug");
-    if (lmysql->ldbms_mysql_errno(&mysql[MYSQL_MAIN_CONNECTION]) == 1142) s.append("Need create privilege on xxxmdbug.*. ");
-    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "drop table if exists xxxmdbug.xxxmdbug");
-    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "create table xxxmdbug.xxxmdbug (s1 int)");
-    if ((s == "") && (lmysql->ldbms_mysql_errno(&mysql[MYSQL_MAIN_CONNECTION]) == 1142)) s.append("Need create privilege on xxxmdbug.*. ");
-    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "prepare xxxmdbug_stmt from 'select * from xxxmdbug.xxxmdbug'");
-    if (lmysql->ldbms_mysql_errno(&mysql[MYSQL_MAIN_CONNECTION]) == 1142) s.append("Need select privilege on xxxmdbug.*. ");
-    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "deallocate prepare xxxmdbug_stmt");
-    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "prepare xxxmdbug_stmt from 'insert into xxxmdbug.xxxmdbug values (1)'");
-    if (lmysql->ldbms_mysql_errno(&mysql[MYSQL_MAIN_CONNECTION]) == 1142) s.append("Need insert privilege on xxxmdbug.*. ");
-    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "deallocate prepare xxxmdbug_stmt");
-    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "prepare xxxmdbug_stmt from 'delete from xxxmdbug.xxxmdbug'");
-    if (lmysql->ldbms_mysql_errno(&mysql[MYSQL_MAIN_CONNECTION]) == 1142) s.append("Need delete privilege on xxxmdbug.*. ");
-    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "deallocate prepare xxxmdbug_stmt");
-    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "prepare xxxmdbug_stmt from 'update xxxmdbug.xxxmdbug set s1 = 1'");
-    if (lmysql->ldbms_mysql_errno(&mysql[MYSQL_MAIN_CONNECTION]) == 1142) s.append("Need update privilege on xxxmdbug.*. ");
-    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "deallocate prepare xxxmdbug_stmt");
-    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "drop table xxxmdbug.xxxmdbug");
-    if (lmysql->ldbms_mysql_errno(&mysql[MYSQL_MAIN_CONNECTION]) == 1142) s.append("Need drop privilege on xxxmdbug.*. ");
-    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "drop procedure if exists xxxmdbug.xxxmdbug");
-    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "create procedure xxxmdbug.xxxmdbug () set @a = 1");
-    if (lmysql->ldbms_mysql_errno(&mysql[MYSQL_MAIN_CONNECTION]) == 1044) s.append("Need create routine privilege on xxxmdbug.*. ");
-    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "drop procedure xxxmdbug.xxxmdbug");
-    if (lmysql->ldbms_mysql_errno(&mysql[MYSQL_MAIN_CONNECTION]) == 1370) s.append("Need alter routine privilege on xxxmdbug.*. ");
-    return s;
-  }
+/*
+  We will get here if mouse button pressed on debug_tab_widget (we don't know which debug_widget yet, possibly none of them).
+  What's it good for? Probably this will be the main way to set a breakpoint.
+  I think we'll need to find a right mousebutton press and put up a menu.
+  But maybe it would be better if debug_window had a menu bar.
+  In ddd, one of the many options is: double-click. But I didn't succeed with doubleclick.
+  Todo: figure out what to do if there's already a breakpoint here. Clear it? Right now we're just duplicating it.
+*/
+void MainWindow::action_debug_mousebuttonpress(QEvent *event, int which_debug_widget_index)
+{
+  int line_number;
+  char command[512];
+  char schema_name[512];
+  char routine_name[512];
+  int debug_widget_index;
 
-  /* First make sure xxxmdbug exists */
-  num_rows= 0;
-  if (lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "select * from information_schema.schemata where schema_name = 'xxxmdbug'"))
-  {
-    s.append("Cannot select from information_schema");
-    return s;
-  }
-  res= lmysql->ldbms_mysql_store_result(&mysql[MYSQL_MAIN_CONNECTION]);
-  if (res != NULL)
+  QMouseEvent *mouse_event= static_cast<QMouseEvent*> (event);            /* Get line number where mousepress happened */
+  QPoint point= mouse_event->pos();
+  debug_widget_index= debug_tab_widget->currentIndex();
+  /* I saw a crash once so maybe these checks aren't to paranoid. But I don't know whether they avoid the crash. */
+  if (debug_widget_index == -1) return;                                   /* Check for an impossible condition */
+  if (debug_widget_index > DEBUG_TAB_WIDGET_MAX) return;                  /* "" */
+  if (which_debug_widget_index >= debug_tab_widget->count()) return;      /* "" */
+  if (which_debug_widget_index != debug_widget_index) return;             /* "" */
+  QTextCursor text_cursor= debug_widget[debug_widget_index]->cursorForPosition(point);
+  line_number= text_cursor.blockNumber() + 1;
+
+  strcpy(schema_name, debug_routine_schema_name[debug_widget_index].toUtf8());
+  strcpy(routine_name, debug_routine_name[debug_widget_index].toUtf8());
+
+  sprintf(command, "$breakpoint %s.%s %d", schema_name, routine_name, line_number);
+
+  statement_edit_widget->setPlainText(command);                           /* Execute "$breakpoint ..." */
+  action_execute(1);
+}
+
+
+/*
+  Debug|Clear
+  Similar code is in action_debug_breakpoint().
+  Do not confuse with Debug|Delete: "$delete 5" clears a breakpoint #5.
+  Todo: Check that somewhere something says debug_maintain_prompt(2, debug_widget_index, line_number);
+*/
+void MainWindow::action_debug_clear()
+{
+  char command[512];
+  int line_number;
+  char line_number_as_string[10];
+
+  int debug_widget_index= debug_tab_widget->currentIndex();
+  /* I can't imagine how currentIndex() could be == -1, but if it is, do nothing. */
+  if (debug_widget_index < 0) return;
+  line_number= debug_widget[debug_widget_index]->block_number + 1;
+  sprintf(line_number_as_string, "%d", line_number);
+  strcpy(command, "$CLEAR ");
+  strcat(command, debug_routine_schema_name[debug_widget_index].toUtf8());
+  strcat(command,".");
+  strcat(command, debug_routine_name[debug_widget_index].toUtf8());
+  strcat(command, " ");
+  strcat(command, line_number_as_string);
+
+  statement_edit_widget->setPlainText(command);
+  action_execute(1);
+}
+
+
+/*
+  Debug|Continue -- "CALL xxxmdbug.command([channel-name],'continue');" as a client statement
+*/
+void MainWindow::action_debug_continue()
+{
+  statement_edit_widget->setPlainText("$CONTINUE");
+  action_execute(1);
+}
+
+/*
+  Debug|Step
+  This is much like Debug|Continue, but we don't care if we end up on a permanent breakpoint.
+*/
+void MainWindow::action_debug_step()
+{
+  statement_edit_widget->setPlainText("$STEP");
+  action_execute(1);
+}
+
+/*
+  Debug|Leave
+  This isn't working quite right. It gets out of loops, but if it's
+  in a subroutine then it will try to execute all the way to the end
+  of the main routine. (A breakpoint can stop that from happening.)
+  So we will allow the $LEAVE statement but not advertise it on the menu.
+*/
+//void MainWindow::action_debug_leave()
+//{
+//    statement_edit_widget->setPlainText("$LEAVE");
+//    action_execute(1);
+//}
+
+
+/* $SKIP seems to act like $CONT which isn't terribly useful */
+void MainWindow::debug_skip_go()
+{
+  make_and_put_message_in_result(ER_SKIP_STATEMENT, 0, (char*)"");
+}
+
+
+void MainWindow::debug_source_go()
+{
+  make_and_put_message_in_result(ER_SOURCE_STATEMENT, 0, (char*)"");
+}
+
+
+/*
+  $SET declared_variable_name = value;
+  Todo: As an additional error check: look up declared_variable_name in xxxmdbug.variables.
+  TODO: BUG: $set x = 'literal'; results in a syntax error so say only numbers are allowed.
+*/
+void MainWindow::debug_set_go(QString text)
+{
+  char command_string[5120];
+  int index_of_number_1, index_of_number_2;
+
+  if (debuggee_state != DEBUGGEE_STATE_DEBUGGEE_WAIT_LOOP)
   {
-    num_rows= lmysql->ldbms_mysql_num_rows(res);
-    lmysql->ldbms_mysql_free_result(res);
+    if (debug_error((char*)er_strings[er_off + ER_NO_DEBUG_SESSION]) != 0) return;
   }
-  if (num_rows != 1)
+  if (debug_parse_statement(text, command_string, &index_of_number_1, &index_of_number_2) < 0)
   {
-    s.append("Cannot access database xxxmdbug. Check that $install was done and privileges were granted.");
-    return s;
+    if (debug_error((char*)er_strings[er_off + ER_OVERFLOW]) != 0) return;
+    return;
   }
+  debug_call_xxxmdbug_command(command_string);
+  put_diagnostics_in_result(MYSQL_MAIN_CONNECTION);
+}
 
-  if ((statement_type == TOKEN_KEYWORD_DEBUG_DEBUG) || (statement_type == TOKEN_KEYWORD_DEBUG_SETUP))
-  {
-    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "prepare xxxmdbug_stmt from 'select * from xxxmdbug.readme union all select * from xxxmdbug.copyright'");/* Returns 1142 if SELECT denied */
-    if (lmysql->ldbms_mysql_errno(&mysql[MYSQL_MAIN_CONNECTION]) == 1142) s.append("Need select privilege on xxxmdbug.*. ");
-    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "deallocate prepare xxxmdbug_stmt");
-    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "prepare xxxmdbug_stmt from 'create temporary table xxxmdbug.xxxmdbug_tmp (s1 int)'");/* Returns 1044 if CREATE TEMPORARY denied */
-    if (lmysql->ldbms_mysql_errno(&mysql[MYSQL_MAIN_CONNECTION]) == 1044) s.append("Need create temporary privilege on xxxmdbug.*. ");
-    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "deallocate prepare xxxmdbug_stmt");
-  }
 
-  if (statement_type == TOKEN_KEYWORD_DEBUG_DEBUG)
+/*
+  $execute sql-statement
+  todo: this will fail if first token is a comment
+  todo: get rid of this, it fails
+*/
+void MainWindow::debug_execute_go()
+{
+  make_and_put_message_in_result(ER_EXECUTE_STATEMENT, 0, (char*)"");
+
+//  QString s;
+//  char command_string[5120];
+//  if (debuggee_state != DEBUGGEE_STATE_DEBUGGEE_WAIT_LOOP)
+//  {
+//    if (debug_error((char*)"No debug session in progress") != 0) return;
+//  }
+//  if (debug_error((char*)"") != 0) return;
+//
+//  s= "execute ";
+//  s.append(text.right(text.length() - (main_token_offsets[main_token_number] + main_token_lengths[main_token_number])));
+//  QMessageBox msgbox;
+//  msgbox.setText(s);
+//  msgbox.exec();
+//  strcpy(command_string, s.toUtf8());
+//  printf("command_string=%s.\n", command_string);
+//  debug_call_xxxmdbug_command(s.toUtf8());
+//  put_diagnostics_in_result(MYSQL_MAIN_CONNECTION);
+////  put_message_in_result("This statement is not supported at this time");
+}
+
+
+/* For: $next, $continue, $refresh */
+/* The following could be used for all the $... statements where one merely passes the command on to the debuggee */
+/* We strip the comments and the ; but if there's junk after the first word it will cause an error, as it should. */
+/* Todo: Should you add a semicolon? */
+void MainWindow::debug_other_go(QString text)
+{
+  char command_string[512];
+  int index_of_number_1, index_of_number_2;
+  QString q_schema_name, q_routine_name;
+
+  if (debuggee_state != DEBUGGEE_STATE_DEBUGGEE_WAIT_LOOP)
   {
-    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "prepare xxxmdbug_stmt from 'set global init_connect = @@init_connect'");/* Returns 1227 if you need SUPER */
-    if (lmysql->ldbms_mysql_errno(&mysql[MYSQL_MAIN_CONNECTION]) == 1227) s.append("Need super privilege. ");
-    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "deallocate prepare xxxmdbug_stmt");
-    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "prepare xxxmdbug_stmt from 'call xxxmdbug.command()'");
-    if (lmysql->ldbms_mysql_errno(&mysql[MYSQL_MAIN_CONNECTION]) == 1044) s.append("Need execute privilege on xxxmdbug.command. ");
-    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "deallocate prepare xxxmdbug_stmt");
+    if (debug_error((char*)er_strings[er_off + ER_NO_DEBUG_SESSION]) != 0) return;
   }
-
-  if (statement_type == TOKEN_KEYWORD_DEBUG_SETUP)
+  if (debug_parse_statement(text, command_string, &index_of_number_1, &index_of_number_2) < 0)
   {
-    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "prepare stmt1 from 'select * from mysql.proc'");
-    if (lmysql->ldbms_mysql_errno(&mysql[MYSQL_MAIN_CONNECTION]) == 1142) s.append("Need select privilege on mysql.proc. ");
-    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "deallocate prepare xxxmdbug_stmt");
-
-    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "prepare xxxmdbug_stmt from 'create table xxxmdbug.xxxmdbug_nontmp (s1 int)'");/* Returns 1044 if CREATE TEMPORARY denied */
-    if (lmysql->ldbms_mysql_errno(&mysql[MYSQL_MAIN_CONNECTION]) == 1044) s.append("Need create privilege on xxxmdbug.*. ");
-    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "deallocate prepare xxxmdbug_stmt");
-
-    /* Can't prepare create-routine statements so test by actually creating and dropping a trivial for-test-only routine */
-    sprintf(call_statement, "create procedure xxxmdbug.xxxmdbugp () set @=@a");
-    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], call_statement);
-    if (lmysql->ldbms_mysql_errno(&mysql[MYSQL_MAIN_CONNECTION]) == 1044) s.append("Need create routine privilege on xxxmdbug.*. ");
-    else
-    {
-      sprintf(call_statement, "drop procedure xxxmdbug.xxxmdbugp");
-      lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], call_statement);
-      if (lmysql->ldbms_mysql_errno(&mysql[MYSQL_MAIN_CONNECTION]) == 1044) s.append("Need drop routine privilege on xxxmdbug.*. ");
-    }
-    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "deallocate prepare xxxmdbug_stmt");
-    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "prepare xxxmdbug_stmt from 'call xxxmdbug.setup()'");
-    if (lmysql->ldbms_mysql_errno(&mysql[MYSQL_MAIN_CONNECTION]) == 1044) s.append("Need execute privilege on xxxmdbug.setup. ");
-    lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "deallocate prepare xxxmdbug_stmt");
-
-    result_string= select_1_row("select count(*) from information_schema.tables where table_schema = 'xxxmdbug' and table_name = 'setup_log'" );
-    if (result_string != "") s.append(result_string);
-    else if (select_1_row_result_1.toInt() != 0)
-    {
-      lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "prepare xxxmdbug_stmt from 'select * from xxxmdbug.setup_log'");
-      if (lmysql->ldbms_mysql_errno(&mysql[MYSQL_MAIN_CONNECTION]) == 1044) s.append("Need select privilege on xxxmdbug.setup_log. ");
-      lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "deallocate prepare xxxmdbug_stmt");
-      lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "prepare xxxmdbug_stmt from 'insert into setup_log select * from xxxmdbug.setup_log'");
-      if (lmysql->ldbms_mysql_errno(&mysql[MYSQL_MAIN_CONNECTION]) == 1044) s.append("Need insert privilege on xxxmdbug.setup_log. ");
-      lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "deallocate prepare xxxmdbug_stmt");
-      /* Todo: Find out why repair table is sometimes necessary. I know it can get corrupted but don't yet know why. */
-      if (lmysql->ldbms_mysql_query(&mysql[MYSQL_MAIN_CONNECTION], "repair table xxxmdbug.setup_log"))
-      {
-        s.append("Repair Table xxxmdbug.setup_log failed");
-      }
-      else
-      {
-        res= lmysql->ldbms_mysql_store_result(&mysql[MYSQL_MAIN_CONNECTION]);
-        if (res != NULL) lmysql->ldbms_mysql_free_result(res);
-      }
-    }
+    if (debug_error((char*)er_strings[er_off + ER_OVERFLOW]) != 0) return;
+    return;
   }
+  q_schema_name= debug_q_schema_name_in_statement;
+  q_routine_name= debug_q_routine_name_in_statement;
 
-  /* TODO: Following isn't good. */
-
-  result_string= select_1_row("select count(*) from information_schema.routines where routine_schema = 'xxxmdbug' and routine_name = 'command'" );
-  if (result_string != "") s.append(result_string);
-  else if (select_1_row_result_1.toInt() == 0) s.append("Need execute privilege for xxxmdbug.*. ");
-  return s;
+  if (debug_error((char*)"") != 0) return;
+  if (debug_call_xxxmdbug_command(command_string) != 0) return;
+  put_diagnostics_in_result(MYSQL_MAIN_CONNECTION);
 }
 
 
 /*
-  Called from: debug_debug_go(), debug_breakpoint_or_clear_go(), or other debug_ routines that might contain arguments.
-  An SQL statement may contain comments, plus semicolon and/or delimiter, which should be stripped before passing to xxxmdbug.
-  Also these procedures need to know: which tokens (if any) are for schema, routine, start line number, end line number.
-  For example from "$DEBUG x.y -- comment;", we want to produce "debug x.y" and the offsets of x and y.
-  Possible are: breakpoint/tbreakpoint location information [condition information]
-                clear [schema_identifier[.routine_identifier]] line_number_minimum [-line_number_maximum]
-                debug [schema_identifier[.routine_identifier]
-                delete breakpoint number
-  This does not detect syntax errors, we assume xxxmdbug.command() will return an error immediately for a syntax error.
-  So it's not really a parse, but should find the tokens that matter.
-  Todo: see if confusion happens if there's condition information, or parameters enclosed inside ''s.
-  If there is clearly an error, debug_parse_statement() returns -1 and command_string has an error message.
+  Debug|Next
 */
-int MainWindow::debug_parse_statement(QString text,
-                           char *command_string,
-                           int *index_of_number_1,
-                           int *index_of_number_2)
+void MainWindow::action_debug_next()
 {
-  char token[512];
-  int i, s_len;
-  int token_type;
-  QString s;
-//  int index_of_dot= -1;
-//  int index_of_minus= -1;
-  int statement_type= 0;
-  //bool left_parenthesis_seen= false;
-  bool name_is_expected= false; /* true if syntax demands [schema_name.]routine_name at this point */
-  char default_schema_name[512];
-
-  strcpy(default_schema_name, "");
-  debug_q_schema_name_in_statement="";
-  debug_q_routine_name_in_statement="";
-  *index_of_number_1= -1;
-  *index_of_number_2= -1;
-  strcpy(command_string, "");
-  for (i= 0; main_token_lengths[i] != 0; ++i)
-  {
-    token_type= main_token_types[i];
-    if ((token_type == TOKEN_TYPE_COMMENT_WITH_SLASH)
-     || (token_type == TOKEN_TYPE_COMMENT_WITH_OCTOTHORPE)
-     || (token_type == TOKEN_TYPE_COMMENT_WITH_MINUS)) continue;
-    s= text.mid(main_token_offsets[i], main_token_lengths[i]);
+ statement_edit_widget->setPlainText("$NEXT");
+ action_execute(1);
+}
 
-    if ((token_type >= TOKEN_KEYWORD_DEBUG_BREAKPOINT)
-     && (token_type <= TOKEN_KEYWORD_DEBUG_TBREAKPOINT)
-     && (strcmp(command_string, "") == 0))
-    {
-      /* We're at the first word, which is the statement type. Write it in full. */
-      statement_type= token_type;
-      if (token_type == TOKEN_KEYWORD_DEBUG_BREAKPOINT) { strcpy(command_string, "breakpoint"); name_is_expected= true; }
-      if (token_type == TOKEN_KEYWORD_DEBUG_CLEAR) { strcpy(command_string, "clear"); name_is_expected= true; }
-      if (token_type == TOKEN_KEYWORD_DEBUG_CONTINUE) strcpy(command_string, "continue");
-      if (token_type == TOKEN_KEYWORD_DEBUG_DEBUG) { strcpy(command_string, "debug"); name_is_expected= true; }
-      if (token_type == TOKEN_KEYWORD_DEBUG_DELETE) strcpy(command_string, "delete");
-      if (token_type == TOKEN_KEYWORD_DEBUG_EXECUTE) strcpy(command_string, "execute");
-      if (token_type == TOKEN_KEYWORD_DEBUG_EXIT) strcpy(command_string, "exit");
-      if (token_type == TOKEN_KEYWORD_DEBUG_INFORMATION) strcpy(command_string, "information");
-      if (token_type == TOKEN_KEYWORD_DEBUG_INSTALL) strcpy(command_string, "install");
-      if (token_type == TOKEN_KEYWORD_DEBUG_LEAVE) strcpy(command_string, "leave");
-      if (token_type == TOKEN_KEYWORD_DEBUG_NEXT) strcpy(command_string, "next");
-      if (token_type == TOKEN_KEYWORD_DEBUG_REFRESH) strcpy(command_string, "refresh");
-      if (token_type == TOKEN_KEYWORD_DEBUG_SET) strcpy(command_string, "set");
-      if (token_type == TOKEN_KEYWORD_DEBUG_SETUP) { strcpy(command_string, "setup"); name_is_expected= true; }
-      if (token_type == TOKEN_KEYWORD_DEBUG_SKIP) strcpy(command_string, "skip");
-      if (token_type == TOKEN_KEYWORD_DEBUG_SOURCE) strcpy(command_string, "source");
-      if (token_type == TOKEN_KEYWORD_DEBUG_STEP) strcpy(command_string, "step");
-      if (token_type == TOKEN_KEYWORD_DEBUG_TBREAKPOINT) { strcpy(command_string, "tbreakpoint"); name_is_expected= true; }
-      continue;
-    }
 
-    s= text.mid(main_token_offsets[i], main_token_lengths[i]);
-    s_len= s.toUtf8().size(); /* See comment "UTF8 Conversion" */
-    if (s_len + 1 >= 512) { strcpy(command_string, "overflow"); return -1; }
-    memcpy(token, s.toUtf8().constData(), s_len);
-    token[s_len]= 0;
-    if (token[0] == ';') continue;
-    if (s == ocelot_delimiter_str) continue;
-//    if (token[0] == '.') index_of_dot= i;
-//    if (token[0] == '-') index_of_minus= i;
-//    if (token[0] == '(') left_parenthesis_seen= true;
-    if (name_is_expected)
-    {
-      if ((token_type == TOKEN_TYPE_OTHER)
-       || (token_type == TOKEN_TYPE_IDENTIFIER)
-       || (token_type == TOKEN_TYPE_IDENTIFIER_WITH_DOUBLE_QUOTE)
-       || (token_type == TOKEN_TYPE_IDENTIFIER_WITH_BACKTICK))
-      {
-        /* It's possibly a routine name, and we're expecting a routine name. */
-        char tmp_schema_name[512];
-        char tmp_routine_name[512];
-        int s2_len;
-        QString s2;
-        if (text.mid(main_token_offsets[i + 1], 1) == ".")
-        {
-          /* schema-name . routine_name */
-          if ((main_token_types[i + 2] == TOKEN_TYPE_OTHER)
-           || (main_token_types[i + 2] == TOKEN_TYPE_IDENTIFIER)
-           || (token_type == TOKEN_TYPE_IDENTIFIER_WITH_DOUBLE_QUOTE)
-           || (main_token_types[i + 2] == TOKEN_TYPE_IDENTIFIER_WITH_BACKTICK))
-          {
-            strcpy(tmp_schema_name, token);
-            s2= text.mid(main_token_offsets[i + 2], main_token_lengths[i + 2]);
-            s2_len= s2.toUtf8().size(); /* See comment "UTF8 Conversion" */
-            if (s2_len + 1 + s_len + 1 >= 512) { strcpy(command_string, "overflow"); return -1; }
-            memcpy(tmp_routine_name, s2.toUtf8().constData(), s2_len);
-            tmp_routine_name[s2_len]= 0;
-            i+= 2;
-          }
-          else
-          {
-            strcpy(command_string, "Expected routine-name after .");
-            return -1;
-          }
-        }
-        else
-        {
-          /* Just routine name. Fill in [default schema name]. Todo: shouldn't require a server request so frequently. */
-          if (strcmp(default_schema_name, "") == 0)
-          {
-            QString result_string;
-            select_1_row_result_1= "";
-            result_string= select_1_row("select database()");
-            if (result_string != "") { strcpy(command_string, "Need to know default database but select database() failed"); return -1; }
-            if (select_1_row_result_1== "") { strcpy(command_string, "Need to know default database but select database() returned nothing"); return -1; }
-            s2= select_1_row_result_1;
-            s2_len= s2.toUtf8().size();
-            if (s2_len + 1 + s_len + 1 >= 512) { strcpy(command_string, "overflow"); return -1; }
-            memcpy(default_schema_name, s2.toUtf8().constData(), s2_len);
-            default_schema_name[s2_len]= 0;
-          }
-          strcpy(tmp_routine_name, token);
-          strcpy(tmp_schema_name, default_schema_name);
-        }
-        name_is_expected= false;
-        strcpy(token, tmp_schema_name);
-        strcat(token, ".");
-        strcat(token, tmp_routine_name);
+/*
+  Debug|Skip
+  Commented out -- not working at this time
+*/
+//void MainWindow::action_debug_skip()
+//{
+//  statement_edit_widget->setPlainText("$SKIP");
+//  action_execute(1);
+//}
 
-        {
-          QString result_string;
-          char query_for_select_check[512];
-          sprintf(query_for_select_check, "select count(*) from information_schema.routines where routine_schema='%s' and routine_name='%s'", tmp_schema_name, tmp_routine_name);
-          result_string= select_1_row(query_for_select_check);
-          if (result_string != "") { strcpy(command_string, "Tried to check routine name but select from information_schema.routines failed"); return -1; }
-          if (select_1_row_result_1.toInt() == 0)
-          {
-            sprintf(command_string, "Could not find routine %s.%s", tmp_schema_name, tmp_routine_name);
-            return -1;
-          }
 
-        }
+/*
+  Given 'information status' schema + routine name, find out what the tab number is and make it current.
+  Then change the cursor to point to a particular line.
+  After the cursor is set to the line, the CodeEditor's highlightCurrentLine wil highlight it.
+  Remember, blockNumber() is base 0
+  Todo: If the call was completed, you shouldn't be here -- the line number will be too big!
+*/
+void MainWindow::debug_highlight_line()
+{
+  QTextCursor cursor;
+  int debug_widget_index;
+  int new_line_number;
+  QString debuggee_schema_identifier;
+  QString debuggee_routine_identifier;
 
-        debug_q_schema_name_in_statement= tmp_schema_name;
-        debug_q_routine_name_in_statement= tmp_routine_name;
-      }
-      else
+  for (debug_widget_index= 0; debug_widget_index < DEBUG_TAB_WIDGET_MAX; ++debug_widget_index)
+  {
+    debuggee_schema_identifier= debuggee_information_status_schema_identifier;
+    debuggee_schema_identifier= connect_stripper(debuggee_schema_identifier, false);
+    debuggee_routine_identifier= debuggee_information_status_routine_identifier;
+    debuggee_routine_identifier= connect_stripper(debuggee_routine_identifier, false);
+    if (QString::compare(debuggee_schema_identifier, debug_routine_schema_name[debug_widget_index]) == 0)
+    {
+      if (QString::compare(debuggee_routine_identifier, debug_routine_name[debug_widget_index]) == 0)
       {
-        /* It's not possibly a routine identifier, and we're expecting a routine identifier. */
-        strcpy(command_string, "Expected a routine name"); return -1;
+        break; /* now we know that debug_widget_index is for the tab of the routine the debuggee's at */
       }
     }
-    if ((token[0] == ',') && (statement_type == TOKEN_KEYWORD_DEBUG_SETUP)) name_is_expected= true;
+  }
 
-    if ((token_type == TOKEN_TYPE_LITERAL_WITH_DIGIT)
-     || (token_type == TOKEN_TYPE_LITERAL))
+  if (debug_widget_index >= DEBUG_TAB_WIDGET_MAX)
+  {
+    /* I think it's impossible that routine won't be there, but if it isn't, do nothing. */
+    /* Well, not quite impossible -- schema or routine might be "unknown" or "". That's probably harmless. */
+    /* Todo: Change status line, on supposition that the routine has not started or has ended. */
+    return;
+  }
+
+  debug_tab_widget->setCurrentWidget(debug_widget[debug_widget_index]);
+
+  new_line_number= atoi(debuggee_information_status_line_number);
+
+  --new_line_number;
+
+  /*
+    Something like QTextCursor::HighlightCurrentLine. Make the background light red.
+    This cancels the "current line" background (which is light yellow), and can be cancelled by it -- I think that's okay.
+  */
+
+  /* If this is a different debug_widget than the last one, this should turn highlight off for the last one. */
+  if (debug_widget_index != debug_timer_old_debug_widget_index)
+  {
+    if (debug_timer_old_debug_widget_index != -1)
     {
-      if (*index_of_number_1 == -1) *index_of_number_1= i;
-      else if (*index_of_number_2 == -1) *index_of_number_2= i;
+      if (debug_timer_old_debug_widget_index != -1)
+      {
+        QList<QTextEdit::ExtraSelection> old_extraSelections;
+        debug_widget[debug_timer_old_debug_widget_index]->setExtraSelections(old_extraSelections);
+      }
     }
-    if (strlen(command_string) + strlen(token) + 1 >= 512) { strcpy(command_string, "overflow"); return -1; }
-    if (strcmp(command_string, "") != 0) strcat(command_string, " ");
-    strcat(command_string, token);
+    debug_timer_old_debug_widget_index= debug_widget_index;
   }
-  return 0;
+
+  QList<QTextEdit::ExtraSelection> extraSelections;
+
+  QTextEdit::ExtraSelection selection;
+
+  /* debug highlight color = current line color e.g. yellow, but faded */
+  QColor lineColor= QColor(ocelot_statement_highlight_current_line_color).lighter(160);
+
+  QTextDocument* doc= debug_widget[debug_widget_index]->document();
+  QTextBlock block;
+  /* new_line_number will be -2 if "debuggee_wait_loop ended". probably -1 is impossible */
+  if (new_line_number == -2) block= doc->findBlockByNumber(doc->blockCount() - 1);
+  else if (new_line_number < 0) block= doc->findBlockByNumber(0);
+  else block= doc->findBlockByNumber(new_line_number);
+  int pos= block.position();
+
+  selection.format.setBackground(lineColor);
+  selection.format.setProperty(QTextFormat::FullWidthSelection, true);
+  selection.cursor= QTextCursor(doc);
+  selection.cursor.setPosition(pos, QTextCursor::MoveAnchor);
+  selection.cursor.setPosition(pos + 1, QTextCursor::KeepAnchor);
+  selection.cursor.clearSelection();
+  extraSelections.append(selection);
+  debug_widget[debug_widget_index]->setExtraSelections(extraSelections);
+
+  /*
+    I don't understand why selection.cursor.setPosition(pos) does not
+    really move the cursor, I think it's got do with whether the cursor
+    is a copy. Anyway, without the following code, if the highlighted
+    line moves off the screen, it won't be visible unless the user
+    scrolls up or down.
+    The user can move the cursor too, this only overrides temporarily.
+  */
+  QTextCursor c =  debug_widget[debug_widget_index]->textCursor();
+  c.setPosition(pos);
+  debug_widget[debug_widget_index]->setTextCursor(c);
+  //debug_widget[debug_widget_index]->ensureCursorVisible(); /* I think we don't need this */
 }
 
 
 /*
-  First: find the surrogate routine that debuggee will call (if it's not there, error = you should call setup).
-  Todo: schema_name could be '.' i.e. default
-  Then: put up debug_top_widget
-  Then: execute xxxmdbug.command(...,'debug ...')
-  Todo: check that surrogate routine is not obsolete, i.e. timestamp is after original routine's timestamp
-  Todo: check that everything in the group is present and executable
-  Todo: check that user is the same ... but how can you do that? Is it only in setup_log?
-  Todo: get rid of initialize() from menu
-  Todo: when starting, make sure debuggee is not already running -- even a finished routine is not over
-  Todo: if clicking causes you to get to action_debug_debug() you must generate a $DEBUG statement -- but how click a list??
+  Debug|Delete
 */
-//void MainWindow::action_debug_debug()
+//void MainWindow::action_debug_delete()
 //{
-//  /* Figure out what the parameter should be -- it's not text, eh? */
-//  QString parameter;
-//  debug_debug_go(parameter);
+//  printf("STUB: delete\n");
 //}
 
 
 /*
-  Call debug_error((char*)"error-text") whenever, in one of the debug routines, you encounter an error.
-  Call debug_error((char*)"") regardless, at the start of a debug routine, so basic prerequisite checks can happen.
-  For example, if the user says "$debug test.x" and there is no surrogate for x, we want the user to see:
-  Error 1644 (05678) Surrogate not found.
-  TODO: make sure all the debug-routine failures go through here!
-  Todo: if the error is due to a failure of the last call, add what that last call's error message was.
+  Debug|Exit
+  = "CALL xxxmdbug.command([channel-name],'exit');" as a client statement
+  Check debuggee_state. If it's not DEBUGGEE_STATE_DEBUGGEE_WAIT_LOOP, debuggee_wait_loop() is not going on. THIS APPLIES FOR MANY COMMANDS!
+  Send "exit" command, which should cause debuggee to exit debuggee_wait_loop() and return from the thread function.
+  Wait up to 1 second for "exit" to work.
+  If it didn't work, "kill debuggee-connection-id".
+  TODO: If debuggee fails to respond, it's up to you to kill it.
+  TODO: Call this when main window exits, otherwise the thread's connection is immortal.
+  TODO: I wish there was some way to clear up init_connect now too.
+  Todo: menu item to shut down debugger, and hide debug_tab_widget, close the connection, and kill the thread.
+  Todo: when would you like to get rid of debug_widgets[]?
+  We call debug_menu_enable_or_disable(TOKEN_KEYWORD_DEBUG_EXIT) after calling debug_exit_go().
 */
-int MainWindow::debug_error(char *text)
+void MainWindow::action_debug_exit()
 {
-//  unsigned int statement_type;
+    statement_edit_widget->setPlainText("$EXIT");
+    action_execute(1);
+}
 
-  if (connections_is_connected[0] == 0)
+
+/* flagger == 0 means this is a regular $exit; flagger == 1 means we're getting rid of stuff due to a severe severe error */
+void MainWindow::debug_exit_go(int flagger)
+{
+  char call_statement[512];
+
+  if (flagger == 0)
   {
-    /* Unfortunately this might not get through. */
-    make_and_put_message_in_result(ER_NOT_CONNECTED, 0, (char*)"");
-    return 1;
+    /* Todo: merge this with debug_error somehow, and make sure nothing's enabled/disabled unless debug/exit succeeded! */
+    if (menu_debug_action_exit->isEnabled() == false)
+    {
+      make_and_put_message_in_result(ER_DEBUG_NOT_DONE, 0, (char*)"");
+      return;
+    }
   }
 
-  if (debuggee_state < 0)
+  debug_top_widget->hide();
+  debug_timer->stop();
+  /* Todo: more cleanup e.g. kill the debuggee thread, close the connection, even if it's not responding */
+  /* Todo: yet more cleanup if you want to get rid of the setup result */
+
+  debug_delete_tab_widgets();
+
+  if (debuggee_state == DEBUGGEE_STATE_DEBUGGEE_WAIT_LOOP)
   {
-    char tmp_string[STRING_LENGTH_512]="";
-    char tmp_string_2[STRING_LENGTH_512 + 64];
-    if (debuggee_state != DEBUGGEE_STATE_END)
+    if (debug_call_xxxmdbug_command("exit") != 0)
     {
-      /* debuggee_state_error should tell us something, but remove all ' first */
-      strcpy(tmp_string, debuggee_state_error);
-      for (int i= 0; tmp_string[i] != '\0'; ++i) if (tmp_string[i] == '\047') tmp_string[i]= ' ';
+      put_diagnostics_in_result(MYSQL_MAIN_CONNECTION);
+      return;
     }
-    if (debuggee_state == DEBUGGEE_STATE_END)
+    for (int kk= 0; kk < 10; ++kk) {QThread48::msleep(100); if (debuggee_state != DEBUGGEE_STATE_DEBUGGEE_WAIT_LOOP) break; }
+    if ((debuggee_state == DEBUGGEE_STATE_DEBUGGEE_WAIT_LOOP) && (debuggee_connection_id != 0))
     {
-      make_and_put_message_in_result(ER_ROUTINE_HAS_STOPPED, 0, (char*)"");
+      sprintf(call_statement, "kill %d", debuggee_connection_id);
+
+      if (lmysql->ldbms_mysql_real_query(&mysql[MYSQL_MAIN_CONNECTION], call_statement, strlen(call_statement)))
+      {
+        sprintf(call_statement, "SIGNAL SQLSTATE '05678' SET message_text='exit failed and kill failed -- try executing manually: kill %d'", debuggee_connection_id);
+        lmysql->ldbms_mysql_real_query(&mysql[MYSQL_MAIN_CONNECTION], call_statement, strlen(call_statement));
+      }
     }
-    else
+  }
+
+  /* This should erase left-over messages in the pipe, such as the 'i status' message. Probably there's only one. */
+  QString error_return;
+  sprintf(call_statement, "%s%s%s","call xxxmdbug.dbms_pipe_receive('xxxmdbug_",debuggee_channel_name,
+          "', 1, @xxxmdbug_tmp_1, @xxxmdbug_tmp_2)");
+  for (int i= 0; i < 50; ++i)                                              /* 50 is an arbitrary big number */
+  {
+    if (lmysql->ldbms_mysql_real_query(&mysql[MYSQL_MAIN_CONNECTION], call_statement, strlen(call_statement))) break;
+    error_return= select_1_row("select @xxxmdbug_tmp_1");
+    if (error_return != "") break;
+    if (select_1_row_result_1 == "") break;
+  }
+
+  /* $install was saying "Suggested next step is: $EXIT" even though $EXIT was already done. */
+  debuggee_state= DEBUGGEE_STATE_0;
+
+  /*
+     We call pthread_join so that memory is freed.
+     But it might wait forever if debug thread is loopy.
+     Perhaps we should kill the thread if we suspect that.
+     Anyway: $exit is slow, and pthread_join is probably the cause.
+  */
+  if (debug_thread_exists == true)
+  {
+    int pthread_join_result= pthread_join(debug_thread_id, NULL);
+    assert(pthread_join_result == 0);
+    debug_thread_exists= false;
+  }
+
+  if (flagger == 0)
+  {
+    put_diagnostics_in_result(MYSQL_MAIN_CONNECTION); /* This should show the result of the final call or select, so it should be "ok" */
+  }
+}
+
+
+/* This is called from $exit, but also might be called from $debug if $debug fails */
+/* We're reversing the effects of "new CodeEditor() and "addTab()" in debug_debug_go(). */
+void MainWindow::debug_delete_tab_widgets()
+{
+  debug_tab_widget->clear(); /* equivalent to removeTab() for all tab widgets */
+  for (int debug_widget_index= 0; debug_widget_index < DEBUG_TAB_WIDGET_MAX; ++debug_widget_index)
+  {
+    if (debug_widget[debug_widget_index] != 0)
     {
-      sprintf(tmp_string_2, "'%s %d. %s'", "debuggee_state:", debuggee_state, tmp_string);
-      put_message_in_result(tmp_string_2);
+      debug_widget[debug_widget_index]->removeEventFilter(this);
+      delete debug_widget[debug_widget_index];
+      debug_widget[debug_widget_index]= 0;
     }
-    return 1;
   }
+}
 
 
-  if (strcmp(text,"") != 0)
-  {
-    put_message_in_result(text);
-    return 1;
+/*
+  Debug|Information
+*/
+void MainWindow::action_debug_information()
+{
+  if (debug_call_xxxmdbug_command("information status") != 0) return;
+  statement_edit_widget->insertPlainText("select * from xxxmdbug.information_status;");
+  action_execute(1);
+}
+
+
+/*
+  Debug|Refresh server variables
+*/
+void MainWindow::action_debug_refresh_server_variables()
+{
+  if (debuggee_state != DEBUGGEE_STATE_DEBUGGEE_WAIT_LOOP)
+  {
+    if (debug_error((char*)er_strings[er_off + ER_NO_DEBUG_SESSION]) != 0) return;
   }
-
-  return 0;
+  if (debug_call_xxxmdbug_command("refresh server_variables") != 0) return;
+  statement_edit_widget->insertPlainText("select * from xxxmdbug.server_variables;");
+  action_execute(1);
 }
 
 
-/* $DEBUG [schema.]routine [(parameters)] */
-void MainWindow::debug_debug_go(QString text) /* called from execute_client_statement() or action_debug_debug() */
+/*
+  Debug|Refresh user variables
+*/
+void MainWindow::action_debug_refresh_user_variables()
 {
-  char routine_schema[512];
-  char routine_name[512];
-  char call_statement[512];
-  QString result_string;
-  QString qstring_error_message;
-  int current_widget_index;
-  QString q_routine_schema, q_routine_name;
-  char command_string[2048];
-  int index_of_number_1, index_of_number_2;
-
-  /* Todo: Check that 'debug' has not happened */
-
-  if (debug_parse_statement(text, command_string, &index_of_number_1, &index_of_number_2) < 0)
+  if (debuggee_state != DEBUGGEE_STATE_DEBUGGEE_WAIT_LOOP)
   {
-    if (debug_error(command_string) != 0) return;
+    if (debug_error((char*)er_strings[er_off + ER_NO_DEBUG_SESSION]) != 0) return;
   }
+  if (debug_call_xxxmdbug_command("refresh user_variables") != 0) return;
+  statement_edit_widget->insertPlainText("select * from xxxmdbug.user_variables;");
+  action_execute(1);
+}
 
-  q_routine_schema= debug_q_schema_name_in_statement;
-  q_routine_name= debug_q_routine_name_in_statement;
 
-  if ((q_routine_schema == "") || (q_routine_name == ""))
+/*
+  Debug|Refresh variables
+*/
+void MainWindow::action_debug_refresh_variables()
+{
+  if (debuggee_state != DEBUGGEE_STATE_DEBUGGEE_WAIT_LOOP)
   {
-    if (debug_error((char*)er_strings[er_off + ER_MISSING_ROUTINE_NAME]) != 0) return;
+    if (debug_error((char*)er_strings[er_off + ER_NO_DEBUG_SESSION]) != 0) return;
   }
+  if (debug_call_xxxmdbug_command("refresh variables") != 0) return;
+  statement_edit_widget->insertPlainText("select * from xxxmdbug.variables;");
+  action_execute(1);
+}
 
-  /*
-    If a $debug was started before, and didn't finish, we demand that the user do $exit.
-    We could instead call debug_exit_go(1).
-    Perhaps $exit will fail somehow, and users will be falsely told they can't debug.
-    That's a bug but better than hanging, which is a risk if we make two debug threads.
-  */
-  if (debug_thread_exists == true)
+
+/*
+  Debug|Refresh call_stack
+*/
+void MainWindow::action_debug_refresh_call_stack()
+{
+  if (debuggee_state != DEBUGGEE_STATE_DEBUGGEE_WAIT_LOOP)
   {
-    if (debug_error((char*)er_strings[er_off + ER_DEBUG_IS_ALREADY_RUNNING]) != 0) return;
+    if (debug_error((char*)er_strings[er_off + ER_NO_DEBUG_SESSION]) != 0) return;
   }
+  if (debug_call_xxxmdbug_command("refresh call_stack") != 0) return;
+  statement_edit_widget->insertPlainText("select * from xxxmdbug.call_stack;");
+  action_execute(1);
+}
 
-  if (debuggee_state < 0) debuggee_state= DEBUGGEE_STATE_0;
-  if (debuggee_state == DEBUGGEE_STATE_END) debuggee_state= DEBUGGEE_STATE_0;
-  if (debug_error((char*)"") != 0) return;
-
-  strcpy(routine_schema, q_routine_schema.toUtf8());
-  strcpy(routine_name, q_routine_name.toUtf8());
 
-  if (debuggee_state > 0)
-  {
-    if (debug_error((char*)er_strings[er_off + ER_DEBUG_IS_ALREADY_RUNNING]) != 0) return;
-  }
+/*
+  Called from: action_debug_exit(), action_debug_debug(), action_debug_information(),
+  and anything else which requires xxxmdbug.command -- except 'attach', except
+  'information status' from from action_debug_timer_status().
+  Make the SQL statement that is actually executed, but don't trouble the user with
+  the details by showing it. For example, if the user said "$DEBUG test.p8", we
+  execute "call xxxmdbug.command('channel#...','debug test.p8')" and return the
+  result from that.
+*/
+int MainWindow::debug_call_xxxmdbug_command(const char *command)
+{
+  char call_statement[512];
 
-  qstring_error_message= debug_privilege_check(TOKEN_KEYWORD_DEBUG_DEBUG);
-  if (qstring_error_message != "")
-  {
-    strcpy(command_string, qstring_error_message.toUtf8());
-    if (debug_error(command_string) != 0) return; /* debuggee wouldn't be able to operate so fail */
-  }
+  strcpy(call_statement, "call xxxmdbug.command('");
+  strcat(call_statement, debuggee_channel_name);
+  strcat(call_statement, "', '");
+  strcat(call_statement, command);
+  strcat(call_statement, "');\n");
 
-  /* Call xxxmdbug.debuggee_get_surrogate_name */
-  strcpy(call_statement, "CALL xxxmdbug.debuggee_get_surrogate_name('");
-  strcat(call_statement, routine_name);
-  strcat(call_statement, "','");
-  strcat(call_statement, routine_schema);
-  strcat(call_statement, "',@schema_identifier,@surrogate_routine_identifier,@routine_type,@remainder_of_original_name)");
   if (lmysql->ldbms_mysql_real_query(&mysql[MYSQL_MAIN_CONNECTION], call_statement, strlen(call_statement)))
   {
-    if (debug_error((char*)er_strings[er_off + ER_SURROGATE]) != 0) return;
-  }
-  result_string= select_1_row("select @schema_identifier, concat(left(@surrogate_routine_identifier,11), '%'), @routine_type, @remainder_of_original_name, isnull(@schema_identifier)");
-  if (result_string != "")
-  {
-    char char_result_string[512];
-    strcpy(char_result_string, result_string.toUtf8());
-    if (debug_error(char_result_string) != 0) return;
-  }
-  /* select_1_row_result_1 = @schema_identifier. select_1_row_result_2 = left(@surrogate_routine_identifier,11) || '%'. */
-
-  /* Todo: this checks whether select returned null, good. But it should make even more certain that $debug will succeed. */
-  if (select_1_row_result_5.toInt() == 1)
-  {
-    if (debug_error((char*)er_strings[er_off + ER_SURROGATE_NOT_FOUND]) != 0) return;
+    /* Initially this can happen because we start the timer immediately after we call 'attach'. */
+    put_diagnostics_in_result(MYSQL_MAIN_CONNECTION);
+    return 1;
   }
+  debug_statement= command;
 
-  QString routine_schema_name_for_search= select_1_row_result_1;
-  QString routine_name_for_search= select_1_row_result_2;
-
-  /*
-    This will find all surrogate routines which have the same prefix, xxxmdbug___
-    That means they're in the same group. Ignore icc_core.
-    Get only the part that's not part of the prefix.
-    Interesting idea: you could have a way to show both the surrogate and the original.
-  */
-  int i, j;
-  char i_as_string[10];
-  /* Todo: n should not be hard-coded here, it limits us to only 10 routines can be searched */
-  for (i= 0, j= 0; i < DEBUG_TAB_WIDGET_MAX; ++i)
-  {
-    sprintf(i_as_string, "%d", i);
-    strcpy(call_statement, "select routine_schema, right(routine_name,length(routine_name)-12) from information_schema.routines ");
-    strcat(call_statement, "where routine_schema = '");
-    strcat(call_statement, routine_schema_name_for_search.toUtf8());
-    strcat(call_statement, "' and routine_name like '");
-    strcat(call_statement, routine_name_for_search.toUtf8());
-    strcat(call_statement, "' order by routine_name limit 1 offset ");
-    strcat(call_statement, i_as_string);
-    result_string= select_1_row(call_statement);
-    if (result_string != "")
-    {
-      char char_result_string[512];
-      if (result_string == er_strings[er_off + ER_MYSQL_FETCH_ROW_FAILED]) break;
-      strcpy(char_result_string, result_string.toUtf8());
-      if (debug_error(char_result_string) != 0) return;
-    }
-    if (select_1_row_result_2 != "icc_core")
-    {
-      /* Todo: debug_routine_schema_name and debug_routine_name are global so setup() will ruin them. Fix that! */
-      debug_routine_schema_name[j]= select_1_row_result_1;
-      debug_routine_name[j]= select_1_row_result_2;
-      ++j;
-    }
-  }
+  //put_diagnostics_in_result(MYSQL_MAIN_CONNECTION)???
 
-  /* Todo: check: can this crash if there are DEBUG_TAB_WIDGET_MAX routines? Is this unnecessary if there are DEBUG_TAB_WIDGET_MAX routines? */
-  debug_routine_name[j]= "";
+  /* We no longer try to get the debuggee response with debug_information_status(). */
+  //if (strcmp(command, "information status") != 0)
+  //{
+  //  QString debuggee_response= "Debuggee response = ";
+  //  if (debug_information_status((char *)command) != 0)
+  //    {
+  //    debuggee_response.append("(none). Possibly debuggee is still executing the last command, which was: ");
+  //    debuggee_response.append(debuggee_information_status_last_command);
+  //  }
+  //  else
+  //  {
+  //    debuggee_response.append(debuggee_information_status_last_command_result);
+  //  }
+  //  history_edit_widget->append(debuggee_response);
+  //}
+  return 0;
+}
 
-  int debug_widget_index;
 
-  /* Todo: check if this is useless. You're supposed to have called debug_delete_tab_widgets[] during $exit. */
-  for (debug_widget_index= 0; debug_widget_index < DEBUG_TAB_WIDGET_MAX; ++debug_widget_index)
-  {
-    debug_widget[debug_widget_index]= 0;
-  }
+/*
+  INFORMATION STATUS -- internal
+  We should call this after 'attach' or after 'debug' to see whether there's been some success.
+  Most contacts with the debugger should get a quick response, unless the last was 'continue' or 'step ...' (?)
+  ... Actually, check that: maybe 'continue' acknowledges receipt before continuing.
+  ... And I think that 'continue' will still cause messages, if it's inside stored-procedure code that's being debugged.
+*/
+int MainWindow::debug_information_status(char *last_command)
+{
+  int k;
 
-  /* After this point, some items that get created are persistent, so be sure to clear them if there's an error. */
+  /* TODO: JUST GET RID OF THIS PROC. I NO LONGER SEE ANY POINT TO IT. */
 
-  //MYSQL_RES *debug_res;
-  //MYSQL_ROW row;
-  QString routine_definition;
-  current_widget_index= -1;
-  for (debug_widget_index= 0; debug_widget_index < DEBUG_TAB_WIDGET_MAX; ++debug_widget_index)
+  for (k= 0; k < 100; ++k)
   {
-    if (strcmp(debug_routine_name[debug_widget_index].toUtf8(), "") == 0) break;
-    strcpy(call_statement, "select routine_definition from information_schema.routines where routine_schema = '");
-    strcat(call_statement, debug_routine_schema_name[debug_widget_index].toUtf8());
-    strcat(call_statement, "' and routine_name = '");
-    strcat(call_statement, debug_routine_name[debug_widget_index].toUtf8());
-    strcat(call_statement, "'");
-    QString error_return= select_1_row(call_statement);
-    if (error_return != "")
+    /*
+       By sleeping, we give the QTimer a chance to call action_debug_timer_status() and update status.
+       But it doesn't work! I guess it's because sleeping doesn't restart the event loop!
+    */
+    QThread48::msleep(100);
+    if (strcmp(debuggee_information_status_last_command, last_command) == 0)
     {
-      debug_delete_tab_widgets();                          /* delete already-made widgets. Rest of 'exit' shouldn't happen. */
-      {
-        /* Could not find a routine in the $setup group: ... */
-        char t_error_return[256];
-        char t_schema_name[256];
-        char t_routine_name[256];
-        strcpy(t_error_return, error_return.toUtf8());
-        strcpy(t_schema_name, debug_routine_schema_name[debug_widget_index].toUtf8());
-        strcpy(t_routine_name, debug_routine_name[debug_widget_index].toUtf8());
-        sprintf(call_statement,
-                er_strings[er_off + ER_COULD_NOT_FIND_A_ROUTINE],
-                t_error_return,
-                t_schema_name,
-                t_routine_name);
-      }
-      debug_error(call_statement);                         /* Todo: you forgot to look for icc_core */
-      return;
+      /* todo: this is not enough! you should be checking also if the command number has gone up! */
+      break;
     }
-    routine_definition= select_1_row_result_1;             /* = information_schema.routines.routine_definition */
+  }
 
-    if (routine_definition == "")
-    {
-      debug_delete_tab_widgets();
-      {
-        /* Could not get a routine definition for ... */
-        char t_routine_name[256];
-        strcpy(t_routine_name, debug_routine_name[debug_widget_index].toUtf8());
-        sprintf(call_statement, er_strings[er_off + ER_COULD_NOT_GET], t_routine_name);
-      }
-      if (debug_error(call_statement)) return;
-    }
+  /* k >= 100 means the 100-iteration loop containing a 10-ms sleep has gone by without a match for last_commnd */
+  /* the caller will probably generate a warning */
+  if (k >= 100) return 1; else return 0;
+}
 
-    debug_widget[debug_widget_index]= new CodeEditor(this);
-    debug_widget[debug_widget_index]->is_debug_widget= true;
-    debug_widget[debug_widget_index]->statement_edit_widget_left_bgcolor= QColor(ocelot_statement_prompt_background_color);
-    debug_widget[debug_widget_index]->statement_edit_widget_left_treatment1_textcolor= QColor(ocelot_statement_text_color);
 
-    debug_maintain_prompt(0, debug_widget_index, 0); /* clear prompt_as_input_by_user */
+/*
+  QTimer *debug_timer: every 100 milliseconds (every 1/10 second), while the debuggee
+  is running, the timer event will invoke action_debug_timer() which updates the status.
+  Todo: Start it when debuggee starts, stop it when debuggee stops.
+  If a new information status message has appeared, display it.
+  Todo: make sure timer is stopped before debug_tab_window is closed.
+  Todo: This won't necessarily catch errors, because of the 1/10 second intervals and
+        because multiple commands can be sent asynchronously. Think of a way!
+        Meanwhile, just say: "If you must know the result, you must wait after each command."
+  Todo: It would be faster to interpret the 'information status' results in C code here,
+        rather than using xxxmdbug.information_status repeatedly.
+        Besides, selecting from xxxmdbug.information_status can change the state of the main mysql connection.
+        Maybe you should create a different connection?
+  Todo: Worry about race conditions. The main thread could look at a status variable before all
+        the status variables are updaated by this function. This might be alleviated by
+        updating the counter last, but some sort of mutex might have to be considered.
+  Todo: Check whether something closes the connection.
+        Maybe it would be safest to say that, once a connection is open, it stays open.
+        Hmm, why is this a worry, since we're doing the searching on main connection not debuggee connection?
+  Todo: I have seen the xxxmdbug.command() cause "send+receive error" meaning a change to init_connect failed.
+        Maybe xxxmdbug.commnd() shouldn't try to change init_connect -- after all, we're not trying to send, only receive.
 
-    debug_widget[debug_widget_index]->setStyleSheet(ocelot_statement_style_string);
+*/
+void MainWindow::action_debug_timer_status()
+{
+  char call_statement[512];
+  MYSQL_RES *debug_res= NULL;
+  MYSQL_ROW row= NULL;
+  char unexpected_error[512];
+  int unexpected_new_error= 0;
 
-    /* todo: call 'refresh breakpoints' and debug_maintain_prompt() for breakpoints that already have been set up. */
-    debug_widget[debug_widget_index]->prompt_default= (QString)"\\2 \\L";
-    debug_widget[debug_widget_index]->result= (QString)"ABCDEFG";
-    debug_widget[debug_widget_index]->setPlainText(routine_definition);
+  /*
+    DANGER
+    When the main line is running SQL statements, it calls
+    QApplication::processEvents(), so there can be horrible
+    conflicts -- action_debug_timer_status() runs SQL too.
+    Either we must disable the Run|Kill feature, or disable
+    the timer. Here, we've chosen to disable the timer.
+  */
+  if (dbms_long_query_state == LONG_QUERY_STATE_STARTED) return;
 
-    debug_widget[debug_widget_index]->setReadOnly(false);                 /* if debug shouldn't be editable, set to "true" here */
-    debug_widget[debug_widget_index]->installEventFilter(this);           /* is this necessary? */
-    debug_tab_widget->addTab(debug_widget[debug_widget_index], debug_routine_name[debug_widget_index]);
+  unexpected_error[0]= '\0';
+  strcpy(call_statement, "call xxxmdbug.command('");
+  strcat(call_statement, debuggee_channel_name);
+  strcat(call_statement, "', 'information status')");
 
-    if ((QString::compare(debug_routine_name[debug_widget_index], q_routine_name, Qt::CaseInsensitive) == 0)
-    &&  (QString::compare(debug_routine_schema_name[debug_widget_index], q_routine_schema, Qt::CaseInsensitive) == 0))
+  if (debuggee_state != DEBUGGEE_STATE_DEBUGGEE_WAIT_LOOP)
+  {
+    if (debuggee_state == DEBUGGEE_STATE_DEBUGGEE_WAIT_LOOP_ERROR)
     {
-      current_widget_index= debug_widget_index;
+      sprintf(unexpected_error, er_strings[er_off + ER_DEBUGGEE_WAIT_LOOP], debuggee_state_error);
+    }
+    else
+    {
+      if ((debuggee_state < 0) || (debuggee_state == DEBUGGEE_STATE_END)) strcpy(unexpected_error, "debuggee_wait_loop ended");
+      else strcpy(unexpected_error, er_strings[er_off + ER_DEBUGGEE_WAIT_LOOP_IS_NOT]);
     }
   }
 
-  if (current_widget_index == -1)
+  if (unexpected_error[0] == '\0')
   {
-    debug_delete_tab_widgets();
-    if (debug_error((char*)er_strings[er_off + ER_ROUTINE_IS_MISSING])) return;
+    if (lmysql->ldbms_mysql_real_query(&mysql[MYSQL_MAIN_CONNECTION], call_statement, strlen(call_statement)))
+    {
+      /* Initially this can happen because we start the timer immediately after we call 'attach'. */
+      strcpy(unexpected_error, er_strings[er_off + ER_I_STATUS_FAILED]);
+    }
   }
 
-  debug_tab_widget->setCurrentIndex(current_widget_index);
-
-  /* Getting ready to create a separate thread for the debugger and 'attach' to it */
-
-  char error_message[512];
-
-  debuggee_state= DEBUGGEE_STATE_0;
-
-  /*
-    We want a channel name that will differ from what others might choose.
-    Arbitrary decision = debug_channel_name will be "ch#" || connection-number-of-main-connection.
-    It could be uniquified beyond that if necessary, e.g. add user name.
-    Todo: this could be moved so it doesn't happen every time $debug happens. */
-
-  sprintf(debuggee_channel_name, "ch#%d", statement_edit_widget->dbms_connection_id);
-
-  /* Create a debuggee thread. */
-  /* Todo: consider whether it would have been better to use the Qt QThread function */
-  int pthread_create_result= pthread_create(&debug_thread_id, NULL, &debuggee_thread, NULL);
-  assert(pthread_create_result == 0);
-  debug_thread_exists= true;
+  if (unexpected_error[0]== '\0')
+  {
+    const char *query= "select * from xxxmdbug.information_status";
+    if (lmysql->ldbms_mysql_real_query(&mysql[MYSQL_MAIN_CONNECTION], query, strlen(query)))
+    {
+      strcpy(unexpected_error, er_strings[er_off + ER_I_STATUS_FAILED_NOT_SEVERE]);
+    }
+  }
 
-  /*
-    Wait till debuggee has indicated that it is about to call debuggee_wait_loop().
-    Todo: Give a better diagnostic if this doesn't happen.
-    Todo: Is it possible to fail anyway? If so, sleep + repeat?
-    Todo: This gives up after 1 second. Maybe on a heavily loaded machine that's too early?
-  */
-  for (int k= 0; k < 100; ++k)
+  if (unexpected_error[0] == '\0')
   {
-    QThread48::msleep(10);
-    if (debuggee_state == DEBUGGEE_STATE_DEBUGGEE_WAIT_LOOP) break;
+    debug_res= lmysql->ldbms_mysql_store_result(&mysql[MYSQL_MAIN_CONNECTION]);
+    if (debug_res == NULL)
+    {
+      strcpy(unexpected_error, er_strings[er_off + ER_MYSQL_STORE_RESULT_FAILED]);
+    }
   }
-  QThread48::msleep(10); /* in case debuggee_wait_loop() fails immediately */
-  if (debuggee_state != DEBUGGEE_STATE_DEBUGGEE_WAIT_LOOP)
+
+  if (unexpected_error[0] == '\0')
   {
-    /* Todo: if somehow (bizarrely) debuggee_state >= 0, then the thread did not end and needs to be stopped. */
-    debug_delete_tab_widgets();
-    sprintf(error_message, er_strings[er_off + ER_DEBUGGEE_NOT_RESPONDING], debuggee_state);
-    if (debug_error(error_message) != 0) return;
+    row= lmysql->ldbms_mysql_fetch_row(debug_res);
+    if (row == NULL)
+    {
+      strcpy(unexpected_error, er_strings[er_off + ER_MYSQL_FETCH_ROW_FAILED]);
+    }
+    else
+    {
+      if (lmysql->ldbms_mysql_num_fields(debug_res) < 14)
+      {
+        strcpy(unexpected_error, er_strings[er_off + ER_MYSQL_NUM_FIELDS]);
+      }
+      else
+      {
+        /* Just kludging -- I think something is overflowing. Todo: Find out what's really going on. */
+        memset(debuggee_information_status_debugger_name, 0, 32);
+        memset(debuggee_information_status_debugger_version, 0, 8);
+        memset(debuggee_information_status_timestamp_of_status_message, 0, 32);
+        memset(debuggee_information_status_number_of_status_message, 0, 8);
+        memset(debuggee_information_status_icc_count, 0, 8);
+        memset(debuggee_information_status_schema_identifier, 0, 256);
+        memset(debuggee_information_status_routine_identifier, 0, 256);
+        memset(debuggee_information_status_line_number, 0, 8);
+        memset(debuggee_information_status_is_at_breakpoint, 0, 8);
+        memset(debuggee_information_status_is_at_tbreakpoint, 0, 8);
+        memset(debuggee_information_status_is_at_routine_exit, 0, 8);
+        memset(debuggee_information_status_stack_depth, 0, 8);
+        memset(debuggee_information_status_last_command, 0, 256);
+        memset(debuggee_information_status_last_command_result, 0, 256);
+        memset(debuggee_information_status_commands_count, 0, 8);
+
+        if (row[0] != NULL) strncpy(debuggee_information_status_debugger_name, row[0], 32 - 1);
+        if (row[1] != NULL) strncpy(debuggee_information_status_debugger_version, row[1], 8 - 1);
+        if (row[2] != NULL) strncpy(debuggee_information_status_timestamp_of_status_message, row[2], 32 - 1);
+        if (row[3] != NULL) strncpy(debuggee_information_status_number_of_status_message, row[3], 8 - 1);
+        if (row[4] != NULL) strncpy(debuggee_information_status_icc_count, row[4], 8 - 1);
+        if (row[5] != NULL) strncpy(debuggee_information_status_schema_identifier, row[5], 256 - 1);
+        if (row[6] != NULL) strncpy(debuggee_information_status_routine_identifier, row[6], 256 - 1);
+        if (row[7] != NULL) strncpy(debuggee_information_status_line_number, row[7], 8 - 1);
+        if (row[8] != NULL) strncpy(debuggee_information_status_is_at_breakpoint, row[8], 8 - 1);
+        if (row[9] != NULL) strncpy(debuggee_information_status_is_at_tbreakpoint, row[9], 8 - 1);
+        if (row[10] != NULL) strncpy(debuggee_information_status_is_at_routine_exit, row[10], 8 - 1);
+        if (row[11] != NULL) strncpy(debuggee_information_status_stack_depth, row[11], 8 - 1);
+        if (row[12] != NULL) strncpy(debuggee_information_status_last_command, row[12], 256 - 1);
+        if (row[13] != NULL) strncpy(debuggee_information_status_last_command_result, row[13], 256 - 1);
+        if (row[14] != NULL) strncpy(debuggee_information_status_commands_count, row[14], 8 - 1);
+      }
+    }
   }
-  /*
-    Attach to the debuggee.
-    Todo: Check: is it possible for this to fail because thread has not connected yet? If so, sleep + repeat?
-    Todo: Check: why use insertPlainText not setPlainText?
-  */
 
-  strcpy(call_statement, "call xxxmdbug.command('");
-  strcat(call_statement, debuggee_channel_name);
-  strcat(call_statement, "', 'attach');\n");
+  if (debug_res != NULL) lmysql->ldbms_mysql_free_result(debug_res);
 
-  if (lmysql->ldbms_mysql_real_query(&mysql[MYSQL_MAIN_CONNECTION], call_statement, strlen(call_statement)))
+  if (unexpected_error[0] != '\0')
   {
-    /* Attach failed. Doubtless there's some sort of error message. Put it out now, debug_exit_go() won't override it. */
-    put_diagnostics_in_result(MYSQL_MAIN_CONNECTION);
-    debug_exit_go(1); /* This tries to tell the debuggee to stop, because we're giving up. */
-    return;
+    if (strcmp(debuggee_information_status_last_command_result, unexpected_error) != 0)
+    {
+      /* This should be considered as a status change, as if it's a new i status message */
+      unexpected_new_error= 1;
+      strcpy(debuggee_information_status_last_command_result, unexpected_error);
+    }
   }
 
-  debug_timer_old_line_number= -1;
-  debug_timer_old_schema_identifier[0]= '\0';
-  debug_timer_old_routine_identifier[0]= '\0';
-  debug_timer_old_commands_count= -1;
-  debug_timer_old_number_of_status_message= -1;
-  debug_timer_old_icc_count= -1;
-  debug_timer_old_debug_widget_index= -1;
-  debug_timer->start(DEBUG_TIMER_INTERVAL);
+  //  printf("debuggee_information_status_debugger_name=%s.\n", debuggee_information_status_debugger_name);
+  //  printf("debuggee_information_status_debugger_version=%s.\n", debuggee_information_status_debugger_version);
+  //  printf("debuggee_information_status_timestamp_of_status_message=%s.\n", debuggee_information_status_timestamp_of_status_message);
+  //  printf("debuggee_information_status_number_of_status_message=%s.\n", debuggee_information_status_number_of_status_message);
+  //  printf("debuggee_information_status_icc_count=%s.\n", debuggee_information_status_icc_count);
+  //  printf("debuggee_information_status_schema_identifier=%s.\n", debuggee_information_status_schema_identifier);
+  //  printf("debuggee_information_status_routine_identifier=%s.\n", debuggee_information_status_routine_identifier);
+  //  printf("debuggee_information_status_line_number=%s.\n", debuggee_information_status_line_number);
+  //  printf("debuggee_information_status_is_at_breakpoint=%s.\n", debuggee_information_status_is_at_breakpoint);
+  //  printf("debuggee_information_status_is_at_tbreakpoint=%s.\n", debuggee_information_status_is_at_tbreakpoint);
+  //  printf("debuggee_information_status_is_at_routine_exit=%s.\n", debuggee_information_status_is_at_routine_exit);
+  //  printf("debuggee_information_status_stack_depth=%s.\n", debuggee_information_status_stack_depth);
+  //  printf("debuggee_information_status_last_command=%s.\n", debuggee_information_status_last_command);
+  //  printf("debuggee_information_status_last_command_result=%s.\n", debuggee_information_status_last_command_result);
+  //  printf("debuggee_information_status_commands_count=%s.\n", debuggee_information_status_commands_count);
 
-  /* By the way, we fill in [schema.] if it's missing, because otherwise default would be 'test'. */
+  /* If a status message would probably confuse a rational user, change it. */
+    if (strstr(debuggee_information_status_last_command_result, "completed CALL") != NULL)
+      strcpy(debuggee_information_status_last_command_result, "Routine has stopped. Suggested next step is: $EXIT");
 
-  //  strcpy(call_statement, "debug ");
-  //if (strcmp(routine_schema, "") != 0)
-  //{
-  //  strcat(call_statement, routine_schema);
-  //  strcat(call_statement, ".");
-  //}
-  //strcat(call_statement, routine_name);
+    if (strstr(debuggee_information_status_last_command_result, "Failed, the expected command is debug") != NULL)
+      strcpy(debuggee_information_status_last_command_result, "Routine has stopped and continuing past the end is not possible.  Suggested next step is: $EXIT");
 
   /*
-    To work around a flaw in MDBug, convert all ' to ''.
-    Todo: This does not solve for $debug var_proc(''a''bc'');
-    so the manual should recommend: use an escape for '.
-    Todo: Check if other debug commands containing ', e.g. conditional breakpoints, work.
+    When execution ends, we still have line number = 0 and "stopped at breakpoint".
+    That's misleading, but rather than change MDBug, let's override what it returns.
+    Also: last command isn't always updated if execution has ended.
   */
-  if (strchr(command_string, 0x27) != NULL)
+  if (strcmp(debuggee_information_status_last_command_result, "debuggee_wait_loop ended") == 0)
   {
-    char command_string_2[2048];
-    char *iptr, *optr;
-    for (iptr= command_string, optr= command_string_2;;)
-      {
-      if (*iptr == 0x27) { *optr= 0x27; ++optr; }
-      *optr= *iptr;
-      if (*iptr == '\0') break;
-      ++iptr;
-      ++optr;
-    }
-    strcpy(command_string, command_string_2);
+    strcpy(debuggee_information_status_line_number, "-1");
+    strcpy(debuggee_information_status_is_at_breakpoint, "no");
+    strcpy(debuggee_information_status_is_at_routine_exit, "yes");
+    strcpy(debuggee_information_status_last_command, debug_statement.toUtf8());
+    /* todo: what about debuggee_information_status_last_command_result? */
   }
 
-  if (debug_call_xxxmdbug_command(command_string) != 0)
+  /*
+    Change line_edit i.e. status widget, and maybe change highlight, if there's a new message.
+    It would be extremely wasteful to update every time, i.e. every 1/10 second, if there's no change.
+    Apparently the change that you can depend on is icc_count, not commands_count or number_of_status_message.
+    I don't think there's any need to check whether line number + routine name have changed, but see below.
+  */
+  if ((debug_timer_old_commands_count != atoi(debuggee_information_status_commands_count))
+  ||  (debug_timer_old_number_of_status_message != atoi(debuggee_information_status_last_command))
+  ||  (debug_timer_old_icc_count != atoi(debuggee_information_status_icc_count))
+  ||  (debug_timer_old_line_number != atoi(debuggee_information_status_line_number))
+  ||  (unexpected_new_error == 1))
   {
-    /* Debug failed. Doubtless there's some sort of error message. Put it out now, debug_exit_go() won't override it. */
-    put_diagnostics_in_result(MYSQL_MAIN_CONNECTION);
-    debug_exit_go(1); /* This tries to tell the debuggee to stop, because we're giving up. */
-    return;
-  }
-  put_diagnostics_in_result(MYSQL_MAIN_CONNECTION);
+    char result[2048];
 
-  /* TODO: next line was removed TEMPORARILY. But maybe highlighting will occur due to temporary breakpoint? */
-  //debug_highlight_line(); /* highlight the first line. todo: should be the first executable line, no? */
-  debug_top_widget->show(); /* Is this necessary? I think so because initially debug_window should be hidden. */
+    strcpy(result, "Debugger status = ");
+    if (strcmp(debuggee_information_status_schema_identifier, "unknown") != 0)
+    {
+      strcat(result, "(Current position: ");
+      strcat(result, debuggee_information_status_schema_identifier);
+      strcat(result, ".");
+      strcat(result, debuggee_information_status_routine_identifier);
+      strcat(result, " line ");
+      strcat(result, debuggee_information_status_line_number);
+      strcat(result, ")");
+    }
+    strcat(result, "(Last debug command: ");
+    strcat(result, debuggee_information_status_last_command);
+    strcat(result, ", result: ");
+    strcat(result, debuggee_information_status_last_command_result);
+    strcat(result, ")");
 
-  debug_menu_enable_or_disable(TOKEN_KEYWORD_DEBUG_DEBUG);             /* Until now most debug menu items were gray. */
+    if (strcmp(debuggee_information_status_is_at_breakpoint, "yes") == 0)
+    {
+      strcat(result, "(STOPPED AT BREAKPOINT)");
+    }
+
+    if (strcmp(debuggee_information_status_is_at_routine_exit, "yes") == 0)
+    {
+      strcat(result, "(STOPPED AT ROUTINE EXIT)");
+    }
+
+    debug_line_widget->setText(result);
+
+    /*
+      If and only if the line number or routine name or schema name has changed,
+      highlight i.e. change background color in order to show where we're at now.
+      Formerly this checked "if (strcmp(debuggee_information_status_is_at_breakpoint, "yes") == 0)"
+      i.e. are we at a breakpoint, but I no longer see why that matters.
+      Besides, '$breakpoint' does not move the position.
+    */
+    if ((debug_timer_old_line_number != atoi(debuggee_information_status_line_number))
+     || (strcmp(debug_timer_old_schema_identifier, debuggee_information_status_schema_identifier) == 0)
+     || (strcmp(debug_timer_old_routine_identifier, debuggee_information_status_routine_identifier) == 0))
+    {
+      debug_highlight_line();
+      debug_timer_old_line_number= atoi(debuggee_information_status_line_number);
+      strcpy(debug_timer_old_schema_identifier, debuggee_information_status_schema_identifier);
+      strcpy(debug_timer_old_routine_identifier, debuggee_information_status_routine_identifier);
+    }
+    debug_timer_old_commands_count= atoi(debuggee_information_status_commands_count);
+    debug_timer_old_number_of_status_message= atoi(debuggee_information_status_last_command);
+    debug_timer_old_icc_count= atoi(debuggee_information_status_icc_count);
+  }
 }
+#endif
 
 
 /*
-  Change the contents of debug_widget[debug_widget_index]->prompt_as_input_by_user.
-  action: 0 = initialize/clear, 1 = add breakpoint, 2 = delete breakpoint, 3 = add tbreakpoint
-  line_number: irrelevant if action == 0, else line number for add/clear
-  We have to set the prompt -- the separated-from-the-text stuff on the left -- so that it shows
-  the line numbers with \2 \L, and shows the breakpoints with K(line-number).
-  We avoid 'refresh breakpoints' because it waits for debuggee to be free; hope it doesn't get out of synch.
-  We should end up with something like "\2 \L \K(5,red,Ⓑ) \K(4,red,Ⓑ)" if there are breakpoints on line 5 and line 4.
-  Todo: Even if we're doing adds, do all the deletes first so that if this is called twice there won't be a duplicate.
-        (Todo: I think the debuggee would not make duplicates, but that needs checking.)
-  Todo: breakpoint and tbreakpoint look the same in this scheme.
+  For menu item "Execute|Kill" we must start another thread,
+  which connects and issues a Kill query-id.
+  The kill thread has a subset of the actions of the debug thread so see also debug_thread.
+  Possible variant: keep it alive and use it for monitoring.
 */
-void MainWindow::debug_maintain_prompt(int action, int debug_widget_index, int line_number)
+void* kill_thread(void* unused)
 {
-  if (action == 0)                                                         /* clear */
-  {
-    debug_widget[debug_widget_index]->prompt_as_input_by_user= (QString)"\\2 \\L";
-    return;
-  }
-  QString prompt_including_symbol;
-  QString breakpoint_symbol;
-
-  prompt_including_symbol= (QString)" \\K(";
-  prompt_including_symbol.append(QString::number(line_number));
-  breakpoint_symbol= QChar(0x24b7);                                        /* CIRCLED LATIN CAPITAL LETTER B */
-  prompt_including_symbol.append(",red,");
-  prompt_including_symbol.append(breakpoint_symbol);
-  prompt_including_symbol.append(")");
+  (void) unused; /* suppress "unused parameter" warning */
+  char call_statement[512];
+  int is_connected;
 
-  if (action == 2)                                                        /* delete (well, actually: clear */
-  {
-    /* I don't expect that indexOf() could return -1, and I ignore it if it does happen. */
-    int index_of_prompt;
-    index_of_prompt= debug_widget[debug_widget_index]->prompt_default.indexOf(prompt_including_symbol);
-    if (index_of_prompt >= 0) debug_widget[debug_widget_index]->prompt_default.remove(index_of_prompt, prompt_including_symbol.size());
-    index_of_prompt= debug_widget[debug_widget_index]->prompt_as_input_by_user.indexOf(prompt_including_symbol);
-    if (index_of_prompt >= 0) debug_widget[debug_widget_index]->prompt_as_input_by_user.remove(index_of_prompt, prompt_including_symbol.size());
-  }
-  if ((action == 1) || (action == 3))                                    /* add */
+  is_connected= 0;
+  kill_state= KILL_STATE_CONNECT_THREAD_STARTED;
+  for (;;)
   {
-    debug_widget[debug_widget_index]->prompt_default.append(prompt_including_symbol);
-    debug_widget[debug_widget_index]->prompt_as_input_by_user.append(prompt_including_symbol);
+    if (options_and_connect(MYSQL_KILL_CONNECTION))
+    {
+      kill_state= KILL_STATE_CONNECT_FAILED;
+      break;
+    }
+    is_connected= 1;
+    kill_state= KILL_STATE_IS_CONNECTED;
+    sprintf(call_statement, "kill query %d", kill_connection_id);
+    if (lmysql->ldbms_mysql_real_query(&mysql[MYSQL_KILL_CONNECTION], call_statement, strlen(call_statement)))
+    {
+      kill_state= KILL_STATE_MYSQL_REAL_QUERY_ERROR;
+      break;
+    }
+    kill_state= KILL_STATE_ENDED;
+    break;
   }
+  if (is_connected == 1) lmysql->ldbms_mysql_close(&mysql[MYSQL_KILL_CONNECTION]);
+  lmysql->ldbms_mysql_thread_end();
+  return ((void*) NULL);
 }
 
+bool is_kill_requested;
 
 /*
-  Find out what is current routine and current line, put a symbol beside it.
-  Execute a command e.g. "debug test.p8 5".
-  So far: we get block_number = current line number - 1.
-  Todo: we don't show the B in a circle!
-  Do not confuse with action_mousebuttonpress which also generates "$breakpoint ...".
+  For SOURCE PARALLEL and $BENCH: a worker calls this, with the mutex
+  that the main thread's parallel_wait() is for locked, when it has done
+  something the main thread might be waiting for. Like an executor, see
+  dbms_executor_thread(), it sets the state that dbms_long_query_wait()
+  looks at and queues a call to dbms_long_query_done().
+  action_kill() calls it too, so the waiting main thread sees
+  is_kill_requested at once.
 */
-void MainWindow::action_debug_breakpoint()
-{
-  char command[512];
-  int line_number;
-  char line_number_as_string[10];
-
-  int debug_widget_index= debug_tab_widget->currentIndex();
-  /* I can't imagine how currentIndex() could be == -1, but if it is, do nothing. */
-  if (debug_widget_index < 0) return;
-  line_number= debug_widget[debug_widget_index]->block_number + 1;
-  sprintf(line_number_as_string, "%d", line_number);
-  strcpy(command, "$BREAKPOINT ");
-  strcat(command, debug_routine_schema_name[debug_widget_index].toUtf8());
-  strcat(command,".");
-  strcat(command, debug_routine_name[debug_widget_index].toUtf8());
-  strcat(command, " ");
-  strcat(command, line_number_as_string);
+static volatile int parallel_wait_state= LONG_QUERY_STATE_ENDED;
+static QObject *parallel_wait_notify= NULL; /* the MainWindow, while there are workers */
 
-  statement_edit_widget->setPlainText(command);
-  action_execute(1);
+static void parallel_notify()
+{
+  parallel_wait_state= LONG_QUERY_STATE_ENDED;
+  if (parallel_wait_notify != NULL)
+    QMetaObject::invokeMethod(parallel_wait_notify, "dbms_long_query_done", Qt::QueuedConnection);
 }
 
-
 /*
-  "breakpoint" and "clear" and "tbreakpoint" have the same argument syntax so we use the same routine for all,
-  passing statement_type == TOKEN_KEYWORD_DEBUG_BREAKPOINT or TOKEN_KEYWORD_DEBUG_CLEAR.
-  Todo: "$breakpoint ... hit_count = N" is not working.
-  Todo: "$breakpoint ... variable_name <> old" is not working.
+  Todo: This is no good if the running query isn't
+  on the main connection.
 */
-void MainWindow::debug_breakpoint_or_clear_go(int statement_type, QString text)
+void MainWindow::action_kill()
 {
-  char command_string[512];
-  int index_of_number_1, index_of_number_2;
-  QString routine_name;
-  QString schema_name;
+  pthread_t thread_id;
 
-  /* Todo: Check that 'debug' has happened */
-  if (debuggee_state != DEBUGGEE_STATE_DEBUGGEE_WAIT_LOOP)
+  if (connections_is_connected[0] != 1) return; /* impossible */
+  is_kill_requested= true;
+  parallel_notify();
+  if (dbms_long_query_state == LONG_QUERY_STATE_STARTED)
   {
-    if (debug_error((char*)er_strings[er_off + ER_NO_DEBUG_SESSION]) != 0) return;
+    kill_connection_id= statement_edit_widget->dbms_connection_id;
+    pthread_create(&thread_id, NULL, &kill_thread, NULL);
+    /* no pthread_join here -- what would be the point of waiting? */
   }
+}
 
-  if (debug_parse_statement(text, command_string, &index_of_number_1, &index_of_number_2) < 0)
-  {
-    char error_message[512];
-    if (statement_type == TOKEN_KEYWORD_DEBUG_BREAKPOINT)
-      strcpy(error_message, er_strings[er_off + ER_BREAKPOINT_SYNTAX]);
-    else if (statement_type == TOKEN_KEYWORD_DEBUG_TBREAKPOINT)
-      strcpy(error_message, er_strings[er_off + ER_TBREAKPOINT_SYNTAX]);
-    else
-      strcpy(error_message, er_strings[er_off + ER_CLEAR_SYNTAX]);
-    if (debug_error(error_message) != 0) return;
-  }
-  schema_name= debug_q_schema_name_in_statement;
-  routine_name= debug_q_routine_name_in_statement;
+/*
+  Implementing ^C i.e. control-C i.e. menu item Run|Kill ...
+  Once an SQL statement or SQL statement series has been accepted, user input
+  is restricted to "kill" (a few other events are tolerated but not ones that cause statements),
+  so around the loop inside action_execute() there is some enabling and disabling.
+  SQL statements are done in the connection's executor thread, see dbms_executor_thread();
+  in the main thread there is a wait-loop which stops when the executor is done;
+  the wait-loop is an event loop, see dbms_long_query_wait(), so a "Kill" will be seen.
+  "Kill" causes the SQL statement to end (if there's one running).
+  ^C is an appropriate shortcut although it usually means "clip".
+  Kill sets a flag so that if there are multiple statements, they are all aborted.
+  dbms_long_query is only for potentially-slow SQL statements that might need to be killed.
+  Todo: QThread is more portable than pthread, although it looks harder to understand.
+  Todo: put this together with the dbms_* routines in ocelotgui.h in a separate class.
+*/
+/*
+  Executors: one long-lived thread per connection, started the first time
+  the connection has something to do, instead of pthread_create() +
+  pthread_join() for every statement.
+  The queue holds one request, because the main thread always waits
+  for the response before it makes another request. The main thread
+  fills in request_* and increments request_count; the executor sees
+  request_count != response_count, does the work, fills in response_*,
+  and sets response_count= request_count. Both sides do that with the
+  mutex held, but neither holds it while the DBMS is working.
+  The arguments are copied into the request, so the executor doesn't
+  look at dbms_query or dbms_query_len, which the main thread can reuse.
+  DBMS_EXECUTOR_NEXT_RESULT with request_is_store_result also does
+  mysql_store_result(), so the rows of the next result set are
+  fetched in the executor rather than in the main thread.
+  When the work is done the executor sets its own response_state and
+  queues a call to request_notify->dbms_long_query_done(). It doesn't
+  touch dbms_long_query_result or dbms_long_query_state, those belong
+  to the main connection's statement, so dbms_executor_run() copies
+  the response to them, in the main thread, for the main connection only.
+  request_notify is read with the mutex held, so dbms_executors_stop()
+  can clear it and a late response can't go to a destroyed MainWindow.
+*/
+struct dbms_executor
+{
+  bool is_started;
+  pthread_t thread_id;
+  pthread_mutex_t mutex;
+  pthread_cond_t cond;
+  unsigned int connection_number;
+  int request_type;
+  const char *request_query;
+  unsigned long request_query_len;
+  MYSQL_STMT *request_stmt;
+  bool request_is_store_result;
+  QObject *request_notify;
+  unsigned int request_count;
+  int response_result;
+  MYSQL_RES *response_res;
+  unsigned int response_count;
+  volatile int response_state;   /* LONG_QUERY_STATE_STARTED|ENDED, see dbms_long_query_wait() */
+};
+static dbms_executor dbms_executors[MYSQL_MAX_CONNECTIONS];
+static bool dbms_is_nonblocking[MYSQL_MAX_CONNECTIONS]; /* see dbms_nonblocking_run() */
+
+/* The DBMS call for a request, in the executor or, if it can't start, in the main thread */
+static int dbms_executor_call(MYSQL *connection, int request_type,
+                              const char *query, unsigned long query_len, MYSQL_STMT *stmt)
+{
+  if (request_type == DBMS_EXECUTOR_REAL_QUERY) return lmysql->ldbms_mysql_real_query(connection, query, query_len);
+  if (request_type == DBMS_EXECUTOR_STMT_PREPARE) return lmysql->ldbms_mysql_stmt_prepare(stmt, query, query_len);
+  if (request_type == DBMS_EXECUTOR_STMT_EXECUTE) return lmysql->ldbms_mysql_stmt_execute(stmt);
+  return lmysql->ldbms_mysql_next_result(connection);
+}
 
-  if ((schema_name == "") || (routine_name == ""))
+void* dbms_executor_thread(void* executor)
+{
+  dbms_executor *e= (dbms_executor*) executor;
+  for (;;)
   {
-    if (debug_error((char*)er_strings[er_off + ER_MISSING_ROUTINE_NAME]) != 0) return;
+    pthread_mutex_lock(&e->mutex);
+    while (e->request_count == e->response_count) pthread_cond_wait(&e->cond, &e->mutex);
+    int request_type= e->request_type;
+    const char *query= e->request_query;
+    unsigned long query_len= e->request_query_len;
+    MYSQL_STMT *stmt= e->request_stmt;
+    bool is_store_result= e->request_is_store_result;
+    pthread_mutex_unlock(&e->mutex);
+    if (request_type == DBMS_EXECUTOR_STOP) break;
+
+    MYSQL *connection= &mysql[e->connection_number];
+    MYSQL_RES *res= NULL;
+    int result= dbms_executor_call(connection, request_type, query, query_len, stmt);
+    if ((result == 0) && (is_store_result == true)) res= lmysql->ldbms_mysql_store_result(connection);
+
+    pthread_mutex_lock(&e->mutex);
+    e->response_result= result;
+    e->response_res= res;
+    e->response_count= e->request_count;
+    e->response_state= LONG_QUERY_STATE_ENDED;
+    if (e->request_notify != NULL)
+      QMetaObject::invokeMethod(e->request_notify, "dbms_long_query_done", Qt::QueuedConnection);
+    pthread_mutex_unlock(&e->mutex);
   }
+  return ((void*) NULL);
+}
 
-  if (debug_error((char*)"") != 0) return;
-
-  if (debug_call_xxxmdbug_command(command_string) != 0)
-  {
-    put_diagnostics_in_result(MYSQL_MAIN_CONNECTION);
-    return;
+/*
+  Pass a request to the connection's executor and wait for the response.
+  If res != NULL it's a request to store the result too, see above.
+  If the executor thread can't be started, do it in this thread.
+  stmt is for DBMS_EXECUTOR_STMT_PREPARE|EXECUTE. MariaDB's non-blocking
+  API has no _start() for those, but blocking calls are allowed on a
+  non-blocking connection, so they go to the executor anyway.
+  is_user_statement is only for statement_timing_mark(STATEMENT_TIMING_SEND).
+*/
+int MainWindow::dbms_executor_run(unsigned int connection_number, int request_type,
+                                  const char *query, unsigned long query_len, MYSQL_RES **res,
+                                  MYSQL_STMT *stmt, bool is_user_statement)
+{
+  if ((dbms_is_nonblocking[connection_number]) && (stmt == NULL))
+    return dbms_nonblocking_run(connection_number, request_type, query, query_len, res, is_user_statement);
+  dbms_executor *e= &dbms_executors[connection_number];
+  if (res != NULL) *res= NULL;
+  if (e->is_started == false)
+  {
+    pthread_mutex_init(&e->mutex, NULL);
+    pthread_cond_init(&e->cond, NULL);
+    e->connection_number= connection_number;
+    e->request_count= e->response_count= 0;
+    if (pthread_create(&e->thread_id, NULL, &dbms_executor_thread, e) != 0)
+    {
+      pthread_cond_destroy(&e->cond);
+      pthread_mutex_destroy(&e->mutex);
+      int result= dbms_executor_call(&mysql[connection_number], request_type, query, query_len, stmt);
+      if ((result == 0) && (res != NULL)) *res= lmysql->ldbms_mysql_store_result(&mysql[connection_number]);
+      if (connection_number == MYSQL_MAIN_CONNECTION)
+      {
+        dbms_long_query_result= result;
+        dbms_long_query_state= LONG_QUERY_STATE_ENDED;
+      }
+      return result;
+    }
+    e->is_started= true;
+  }
+  pthread_mutex_lock(&e->mutex);
+  e->request_type= request_type;
+  e->request_query= query;
+  e->request_query_len= query_len;
+  e->request_stmt= stmt;
+  e->request_is_store_result= (res != NULL);
+  e->request_notify= this;
+  e->response_state= LONG_QUERY_STATE_STARTED;
+  /* For action_kill() etc., they only care about the main connection */
+  if (connection_number == MYSQL_MAIN_CONNECTION) dbms_long_query_state= LONG_QUERY_STATE_STARTED;
+  ++e->request_count;
+  pthread_cond_signal(&e->cond);
+  pthread_mutex_unlock(&e->mutex);
+
+  dbms_long_query_wait(&e->response_state);
+
+  pthread_mutex_lock(&e->mutex);
+  int result= e->response_result;
+  if (res != NULL) *res= e->response_res;
+  pthread_mutex_unlock(&e->mutex);
+  if (connection_number == MYSQL_MAIN_CONNECTION)
+  {
+    dbms_long_query_result= result;
+    dbms_long_query_state= LONG_QUERY_STATE_ENDED;
   }
+  return result;
+}
 
-  /* Figure out line number and debug_widget_index from the index variables. */
-  /* Todo: This is failing to compare schema name. */
-
-  int debug_widget_index;
-
-  for (debug_widget_index= 0; debug_widget_index < DEBUG_TAB_WIDGET_MAX; ++debug_widget_index)
-  {
-    if (debug_widget[debug_widget_index] != 0)
-    {
-      if ((QString::compare(routine_name, debug_routine_name[debug_widget_index]) == 0)
-       && (QString::compare(schema_name, debug_routine_schema_name[debug_widget_index]) == 0)) break;
+/*
+  MariaDB's non-blocking API, used instead of the executor thread if
+  the library has it and options_and_connect() could set MYSQL_OPT_NONBLOCK.
+  mysql_real_query_start() etc. return as soon as they would have to wait
+  for the socket, with a mask of MYSQL_WAIT_* bits. We wait in a local event
+  loop with a QSocketNotifier for each bit (and a QTimer for MYSQL_WAIT_TIMEOUT),
+  then call the matching _cont(), till the status is 0. So the GUI thread
+  does the whole statement with no thread or mutex, and Run|Kill still works
+  because action_kill() sees dbms_long_query_state == LONG_QUERY_STATE_STARTED.
+  The MYSQL_WAIT_* values are from MariaDB's mysql.h; MySQL's lacks them.
+*/
+#ifndef MYSQL_WAIT_READ
+#define MYSQL_WAIT_READ 1
+#define MYSQL_WAIT_WRITE 2
+#define MYSQL_WAIT_EXCEPT 4
+#define MYSQL_WAIT_TIMEOUT 8
+#endif
+int MainWindow::dbms_nonblocking_run(unsigned int connection_number, int request_type,
+                                     const char *query, unsigned long query_len, MYSQL_RES **res,
+                                     bool is_user_statement)
+{
+  MYSQL *connection= &mysql[connection_number];
+  int result= 0;
+  int status;
+  if (res != NULL) *res= NULL;
+  if (connection_number == MYSQL_MAIN_CONNECTION) dbms_long_query_state= LONG_QUERY_STATE_STARTED;
+  if (request_type == DBMS_EXECUTOR_REAL_QUERY)
+  {
+    status= lmysql->ldbms_mysql_real_query_start(&result, connection, query, query_len);
+    /* Nothing to mark unless it's the user's statement, see statement_timing_mark() */
+    bool is_sent= ((is_user_statement == false) || (connection_number != MYSQL_MAIN_CONNECTION));
+    while (status != 0)
+    {
+      /* The first wait to read is after the query's sent, see statement_timing_mark() */
+      if ((is_sent == false) && ((status & MYSQL_WAIT_READ) != 0))
+      {
+        statement_timing_mark(STATEMENT_TIMING_SEND);
+        is_sent= true;
+      }
+      status= lmysql->ldbms_mysql_real_query_cont(&result, connection, dbms_nonblocking_wait(connection, status));
     }
   }
-
-  if (debug_widget_index == DEBUG_TAB_WIDGET_MAX)
+  else
   {
-    if (debug_error((char*)"No such routine") != 0) return;
+    status= lmysql->ldbms_mysql_next_result_start(&result, connection);
+    while (status != 0)
+      status= lmysql->ldbms_mysql_next_result_cont(&result, connection, dbms_nonblocking_wait(connection, status));
   }
-
-  int line_number_1, line_number_2;
-  QString q_line_number;
-  q_line_number= text.mid(main_token_offsets[index_of_number_1], main_token_lengths[index_of_number_1]);
-  line_number_1= q_line_number.toInt();
-  if (index_of_number_2 == -1) line_number_2= line_number_1;
-  else
+  if ((result == 0) && (res != NULL))
   {
-    q_line_number= text.mid(main_token_offsets[index_of_number_2], main_token_lengths[index_of_number_2]);
-    line_number_2= q_line_number.toInt();
+    status= lmysql->ldbms_mysql_store_result_start(res, connection);
+    while (status != 0)
+      status= lmysql->ldbms_mysql_store_result_cont(res, connection, dbms_nonblocking_wait(connection, status));
   }
-
-  for (int i= line_number_1; i <= line_number_2; ++i)
+  if (connection_number == MYSQL_MAIN_CONNECTION)
   {
-    if (i > debug_widget[debug_widget_index]->blockCount())
-    {
-      break;
-    }
-    if (statement_type == TOKEN_KEYWORD_DEBUG_BREAKPOINT) debug_maintain_prompt(1, debug_widget_index, i);
-    if (statement_type == TOKEN_KEYWORD_DEBUG_CLEAR) debug_maintain_prompt(2, debug_widget_index, i);
-    if (statement_type == TOKEN_KEYWORD_DEBUG_TBREAKPOINT) debug_maintain_prompt(3, debug_widget_index, i);
+    dbms_long_query_result= result;
+    dbms_long_query_state= LONG_QUERY_STATE_ENDED;
   }
-  /*
-    Todo: I have had trouble, sometimes the breakpoint symbols don't show up unless I click on the line.
-          I think that one of these kludges is helping, but I don't know if it always helps,
-          and I don't know which of the two lines is actually fixing the problem,
-          and I don't know whether there's a better way. So find out, eh?
-  */
-  debug_widget[debug_widget_index]->repaint();
-  debug_widget[debug_widget_index]->viewport()->update();
-  put_diagnostics_in_result(MYSQL_MAIN_CONNECTION);
+  return result;
 }
 
-
 /*
-  Todo: The problem with "delete n" is we don't know which breakpoint is n.
-  Of course it's in xxxmdbug.breakpoints, but "r breakpoints" only works if we're at a breakpoint.
+  Wait till the socket is ready for what status asks, or till the timeout.
+  Return what happened, which is what the next _cont() wants.
+  If the timer fired before any notifier did, that's MYSQL_WAIT_TIMEOUT;
+  otherwise we say the socket is ready for everything that was asked,
+  the library only looks at the timeout bit.
 */
-void MainWindow::debug_delete_go()
+int MainWindow::dbms_nonblocking_wait(MYSQL *connection, int status)
 {
-  make_and_put_message_in_result(ER_DELETE_STATEMENT, 0, (char*)"");
+  int socket= (int) lmysql->ldbms_mysql_get_socket(connection);
+  QEventLoop event_loop;
+  QSocketNotifier read_notifier(socket, QSocketNotifier::Read);
+  QSocketNotifier write_notifier(socket, QSocketNotifier::Write);
+  QSocketNotifier except_notifier(socket, QSocketNotifier::Exception);
+  QTimer timer;
+  read_notifier.setEnabled((status & MYSQL_WAIT_READ) != 0);
+  write_notifier.setEnabled((status & MYSQL_WAIT_WRITE) != 0);
+  except_notifier.setEnabled((status & MYSQL_WAIT_EXCEPT) != 0);
+  connect(&read_notifier, SIGNAL(activated(int)), &event_loop, SLOT(quit()));
+  connect(&write_notifier, SIGNAL(activated(int)), &event_loop, SLOT(quit()));
+  connect(&except_notifier, SIGNAL(activated(int)), &event_loop, SLOT(quit()));
+  if ((status & MYSQL_WAIT_TIMEOUT) != 0)
+  {
+    timer.setSingleShot(true);
+    connect(&timer, SIGNAL(timeout()), &event_loop, SLOT(quit()));
+    timer.start(lmysql->ldbms_mysql_get_timeout_value_ms(connection));
+  }
+  event_loop.exec();
+  if (((status & MYSQL_WAIT_TIMEOUT) != 0) && (timer.isActive() == false))
+    return MYSQL_WAIT_TIMEOUT;
+  return status & (MYSQL_WAIT_READ | MYSQL_WAIT_WRITE | MYSQL_WAIT_EXCEPT);
 }
 
-
 /*
-  We will get here if mouse button pressed on debug_tab_widget (we don't know which debug_widget yet, possibly none of them).
-  What's it good for? Probably this will be the main way to set a breakpoint.
-  I think we'll need to find a right mousebutton press and put up a menu.
-  But maybe it would be better if debug_window had a menu bar.
-  In ddd, one of the many options is: double-click. But I didn't succeed with doubleclick.
-  Todo: figure out what to do if there's already a breakpoint here. Clear it? Right now we're just duplicating it.
+  Called from ~MainWindow. An executor that's in the middle of something
+  (only possible if we're exiting during a statement) is left alone,
+  but its request_notify is cleared, so when the statement ends it
+  won't queue a call for a MainWindow that's gone.
 */
-void MainWindow::action_debug_mousebuttonpress(QEvent *event, int which_debug_widget_index)
+void MainWindow::dbms_executors_stop()
 {
-  int line_number;
-  char command[512];
-  char schema_name[512];
-  char routine_name[512];
-  int debug_widget_index;
-
-  QMouseEvent *mouse_event= static_cast<QMouseEvent*> (event);            /* Get line number where mousepress happened */
-  QPoint point= mouse_event->pos();
-  debug_widget_index= debug_tab_widget->currentIndex();
-  /* I saw a crash once so maybe these checks aren't to paranoid. But I don't know whether they avoid the crash. */
-  if (debug_widget_index == -1) return;                                   /* Check for an impossible condition */
-  if (debug_widget_index > DEBUG_TAB_WIDGET_MAX) return;                  /* "" */
-  if (which_debug_widget_index >= debug_tab_widget->count()) return;      /* "" */
-  if (which_debug_widget_index != debug_widget_index) return;             /* "" */
-  QTextCursor text_cursor= debug_widget[debug_widget_index]->cursorForPosition(point);
-  line_number= text_cursor.blockNumber() + 1;
-
-  strcpy(schema_name, debug_routine_schema_name[debug_widget_index].toUtf8());
-  strcpy(routine_name, debug_routine_name[debug_widget_index].toUtf8());
-
-  sprintf(command, "$breakpoint %s.%s %d", schema_name, routine_name, line_number);
-
-  statement_edit_widget->setPlainText(command);                           /* Execute "$breakpoint ..." */
-  action_execute(1);
+  for (unsigned int i= 0; i < MYSQL_MAX_CONNECTIONS; ++i)
+  {
+    dbms_executor *e= &dbms_executors[i];
+    if (e->is_started == false) continue;
+    pthread_mutex_lock(&e->mutex);
+    bool is_idle= (e->request_count == e->response_count);
+    if (is_idle)
+    {
+      e->request_type= DBMS_EXECUTOR_STOP;
+      ++e->request_count;
+      pthread_cond_signal(&e->cond);
+    }
+    e->request_notify= NULL;
+    pthread_mutex_unlock(&e->mutex);
+    if (is_idle)
+    {
+      pthread_join(e->thread_id, NULL);
+      pthread_cond_destroy(&e->cond);
+      pthread_mutex_destroy(&e->mutex);
+      e->is_started= false;
+    }
+  }
 }
 
-
 /*
-  Debug|Clear
-  Similar code is in action_debug_breakpoint().
-  Do not confuse with Debug|Delete: "$delete 5" clears a breakpoint #5.
-  Todo: Check that somewhere something says debug_maintain_prompt(2, debug_widget_index, line_number);
+  The main thread's wait for the executor, see dbms_executor_run().
+  It used to be
+    for (;;) { msleep(10); if (ENDED) break; processEvents(); }
+  which made every statement take at least 10ms. Now whatever we're
+  waiting for sets *state= LONG_QUERY_STATE_ENDED and queues a call to
+  dbms_long_query_done(), and till then we're in a local event loop,
+  so Run|Kill etc. still work.
+  Waits can nest: while we're in the event loop something can start
+  another wait, e.g. for a different connection. So there's a stack
+  of loops, and dbms_long_query_done() quits every loop whose own
+  state has ended; an outer loop that's told to quit while an inner
+  one is running returns when the inner one has returned.
+  A call might be left over from a wait that ended some other way,
+  that's why dbms_long_query_done() checks the states.
 */
-void MainWindow::action_debug_clear()
+void MainWindow::dbms_long_query_wait(volatile int *state)
 {
-  char command[512];
-  int line_number;
-  char line_number_as_string[10];
-
-  int debug_widget_index= debug_tab_widget->currentIndex();
-  /* I can't imagine how currentIndex() could be == -1, but if it is, do nothing. */
-  if (debug_widget_index < 0) return;
-  line_number= debug_widget[debug_widget_index]->block_number + 1;
-  sprintf(line_number_as_string, "%d", line_number);
-  strcpy(command, "$CLEAR ");
-  strcat(command, debug_routine_schema_name[debug_widget_index].toUtf8());
-  strcat(command,".");
-  strcat(command, debug_routine_name[debug_widget_index].toUtf8());
-  strcat(command, " ");
-  strcat(command, line_number_as_string);
-
-  statement_edit_widget->setPlainText(command);
-  action_execute(1);
+  if (*state == LONG_QUERY_STATE_ENDED) return;
+  QEventLoop event_loop;
+  dbms_long_query_event_loops.append(&event_loop);
+  dbms_long_query_wait_states.append(state);
+  while (*state != LONG_QUERY_STATE_ENDED) event_loop.exec();
+  dbms_long_query_event_loops.removeLast();
+  dbms_long_query_wait_states.removeLast();
 }
 
-
-/*
-  Debug|Continue -- "CALL xxxmdbug.command([channel-name],'continue');" as a client statement
-*/
-void MainWindow::action_debug_continue()
+void MainWindow::dbms_long_query_done()
 {
-  statement_edit_widget->setPlainText("$CONTINUE");
-  action_execute(1);
+  for (int i= 0; i < dbms_long_query_event_loops.count(); ++i)
+  {
+    if (*dbms_long_query_wait_states.at(i) == LONG_QUERY_STATE_ENDED)
+      dbms_long_query_event_loops.at(i)->quit();
+  }
 }
 
 /*
-  Debug|Step
-  This is much like Debug|Continue, but we don't care if we end up on a permanent breakpoint.
+  The recognizer in the background.
+  hparse_f_multi_block() takes too long for every keystroke if the text
+  is big, so action_statement_edit_widget_text_changed() only restarts
+  hparse_background_timer, and when the user stops typing for
+  HPARSE_DEBOUNCE_MS we get here and start hparse_background_thread().
+  Meanwhile the GUI thread doesn't touch main_token_* or hparse_*:
+  the next edit calls hparse_background_cancel(), and every other
+  entry point that reads them calls hparse_background_finish() first:
+  action_execute() (so also the Debug menu items, which execute
+  $-statements), statement_edit_widget_formatter(), the Tab in
+  eventfilter_function(), action_change_one_setting(). The statement
+  widget is read-only during action_execute() so the timer can't go
+  off then. CodeEditor::mouseMoveEvent() doesn't wait, it skips the
+  hint if the state isn't HPARSE_BACKGROUND_IDLE. Highlighting uses
+  editor_token_*, which the thread doesn't touch.
+  When the thread ends it says so with hparse_background_done(),
+  which shows the results.
+  Todo: QThread is more portable than pthread, see dbms_executor_thread().
 */
-void MainWindow::action_debug_step()
+void* hparse_background_thread(void* main_window)
 {
-  statement_edit_widget->setPlainText("$STEP");
-  action_execute(1);
+  MainWindow *m= (MainWindow*) main_window;
+  int generation= m->hparse_background_generation;
+  m->hparse_f_multi_block(m->hparse_background_text);
+  m->hparse_background_state= HPARSE_BACKGROUND_ENDED;
+  QMetaObject::invokeMethod(m, "hparse_background_done", Qt::QueuedConnection, Q_ARG(int, generation));
+  return ((void*) NULL);
 }
 
-/*
-  Debug|Leave
-  This isn't working quite right. It gets out of loops, but if it's
-  in a subroutine then it will try to execute all the way to the end
-  of the main routine. (A breakpoint can stop that from happening.)
-  So we will allow the $LEAVE statement but not advertise it on the menu.
-*/
-//void MainWindow::action_debug_leave()
-//{
-//    statement_edit_widget->setPlainText("$LEAVE");
-//    action_execute(1);
-//}
-
-
-/* $SKIP seems to act like $CONT which isn't terribly useful */
-void MainWindow::debug_skip_go()
+void MainWindow::hparse_background_start()
 {
-  make_and_put_message_in_result(ER_SKIP_STATEMENT, 0, (char*)"");
+  if (hparse_background_state != HPARSE_BACKGROUND_IDLE) return;
+  if (editor_token_is_valid == false) return;
+  /* Not while action_execute() is waiting for the server, it uses main_token_* too. */
+  if (dbms_long_query_state == LONG_QUERY_STATE_STARTED)
+  {
+    hparse_background_timer->start(HPARSE_DEBOUNCE_MS);
+    return;
+  }
+  editor_tokens_restore();
+  hparse_background_text= editor_token_text;
+  hparse_is_cancelled= false;
+  ++hparse_background_generation;
+  hparse_background_state= HPARSE_BACKGROUND_RUNNING;
+  if (pthread_create(&hparse_background_thread_id, NULL, &hparse_background_thread, this) != 0)
+  {
+    /* No thread, so do it the old way */
+    hparse_background_state= HPARSE_BACKGROUND_IDLE;
+    hparse_f_multi_block(hparse_background_text);
+    statement_highlight(hparse_background_text, -2, 0, 0);
+    hparse_f_show_hint();
+  }
 }
 
-
-void MainWindow::debug_source_go()
+/* Slot. If generation is old, hparse_background_cancel|finish() already dealt with it. */
+void MainWindow::hparse_background_done(int generation)
 {
-  make_and_put_message_in_result(ER_SOURCE_STATEMENT, 0, (char*)"");
+  if (generation != hparse_background_generation) return;
+  if (hparse_background_state != HPARSE_BACKGROUND_ENDED) return;
+  pthread_join(hparse_background_thread_id, NULL);
+  hparse_background_state= HPARSE_BACKGROUND_IDLE;
+  statement_highlight(hparse_background_text, -2, 0, 0);
+  hparse_f_show_hint();
 }
 
+/* The text is changing so what hparse is doing or will do is useless. */
+void MainWindow::hparse_background_cancel()
+{
+  hparse_background_timer->stop();
+  if (hparse_background_state == HPARSE_BACKGROUND_IDLE) return;
+  hparse_is_cancelled= true;
+  pthread_join(hparse_background_thread_id, NULL);
+  hparse_is_cancelled= false;
+  hparse_background_state= HPARSE_BACKGROUND_IDLE;
+  ++hparse_background_generation;
+  editor_tokens_restore();
+}
 
 /*
-  $SET declared_variable_name = value;
-  Todo: As an additional error check: look up declared_variable_name in xxxmdbug.variables.
-  TODO: BUG: $set x = 'literal'; results in a syntax error so say only numbers are allowed.
+  Something wants main_token_* as hparse leaves them, now.
+  Wait for the thread if it's running, or parse here if the timer
+  hasn't gone off yet, so it's as if we'd parsed during the text change.
 */
-void MainWindow::debug_set_go(QString text)
+void MainWindow::hparse_background_finish()
 {
-  char command_string[5120];
-  int index_of_number_1, index_of_number_2;
-
-  if (debuggee_state != DEBUGGEE_STATE_DEBUGGEE_WAIT_LOOP)
+  if (hparse_background_state != HPARSE_BACKGROUND_IDLE)
   {
-    if (debug_error((char*)er_strings[er_off + ER_NO_DEBUG_SESSION]) != 0) return;
+    pthread_join(hparse_background_thread_id, NULL);
+    hparse_background_state= HPARSE_BACKGROUND_IDLE;
+    ++hparse_background_generation;
   }
-  if (debug_parse_statement(text, command_string, &index_of_number_1, &index_of_number_2) < 0)
+  else if (hparse_background_timer->isActive())
   {
-    if (debug_error((char*)er_strings[er_off + ER_OVERFLOW]) != 0) return;
-    return;
+    hparse_background_timer->stop();
+    if (editor_token_is_valid == false) return;
+    editor_tokens_restore();
+    hparse_background_text= editor_token_text;
+    hparse_f_multi_block(hparse_background_text);
   }
-  debug_call_xxxmdbug_command(command_string);
-  put_diagnostics_in_result(MYSQL_MAIN_CONNECTION);
+  else return;
+  statement_highlight(hparse_background_text, -2, 0, 0);
+  hparse_f_show_hint();
 }
 
+void MainWindow::action_execute_force()
+{
+  action_execute(1);
+}
 
 /*
-  $execute sql-statement
-  todo: this will fail if first token is a comment
-  todo: get rid of this, it fails
+  For menu item "execute" we said (...SLOT(action_execute(1))));
+  By default this is on and associated with File|Execute menu item.
+  Execute what's in the statement widget.
+  The statement widget might contain multiple statements.
+  Return: 0 = ok, 1 = syntax checker failed with "No"; 2 = DBMS error
 */
-void MainWindow::debug_execute_go()
+int MainWindow::action_execute(int force)
 {
-  make_and_put_message_in_result(ER_EXECUTE_STATEMENT, 0, (char*)"");
+  QString text;
+  int return_value= 0;
+  hparse_background_finish();
+  for (;;)
+  {
+    int returned_begin_count;
+    statement_timing_start();
+    main_token_number= 0;
+    text= statement_edit_widget->toPlainText(); /* or I could just pass this to tokenize() directly */
 
-//  QString s;
-//  char command_string[5120];
-//  if (debuggee_state != DEBUGGEE_STATE_DEBUGGEE_WAIT_LOOP)
-//  {
-//    if (debug_error((char*)"No debug session in progress") != 0) return;
-//  }
-//  if (debug_error((char*)"") != 0) return;
-//
-//  s= "execute ";
-//  s.append(text.right(text.length() - (main_token_offsets[main_token_number] + main_token_lengths[main_token_number])));
-//  QMessageBox msgbox;
-//  msgbox.setText(s);
-//  msgbox.exec();
-//  strcpy(command_string, s.toUtf8());
-//  printf("command_string=%s.\n", command_string);
-//  debug_call_xxxmdbug_command(s.toUtf8());
-//  put_diagnostics_in_result(MYSQL_MAIN_CONNECTION);
-////  put_message_in_result("This statement is not supported at this time");
-}
+    main_token_count_in_statement= get_next_statement_in_string(main_token_number,
+                                                                &returned_begin_count,
+                                                                true);
+    if (main_token_count_in_statement == 0) break;
 
+    /* If the next statement is unfinished, we usually want to ignore it. */
+    if ((force == 0) && (is_statement_complete(text) == false)) return 1;
 
-/* For: $next, $continue, $refresh */
-/* The following could be used for all the $... statements where one merely passes the command on to the debuggee */
-/* We strip the comments and the ; but if there's junk after the first word it will cause an error, as it should. */
-/* Todo: Should you add a semicolon? */
-void MainWindow::debug_other_go(QString text)
-{
-  char command_string[512];
-  int index_of_number_1, index_of_number_2;
-  QString q_schema_name, q_routine_name;
+    /*
+      We probably call hparse_f_multi_block continuously during statement edit,
+      but this redundancy is harmless (we're not short of time, eh?).
+      This checks for errors in the whole string, not just the first statement.
+    */
+    if (((ocelot_statement_syntax_checker.toInt()) & FLAG_FOR_ERRORS) != 0)
+    {
+      hparse_f_multi_block(text);
+      hparse_f_show_hint();
+      if (hparse_errno != 0)
+      {
+        QString s;
+        QMessageBox msgbox;
+        s= er_strings[er_off + ER_THE_SYNTAX_CHECKER_THINKS];
+        s.append(hparse_errmsg);
+        msgbox.setText(s);
+        msgbox.setInformativeText(er_strings[er_off + ER_DO_YOU_WANT_TO_CONTINUE]);
+        //msgbox.setStandardButtons(QMessageBox::Yes | QMessageBox::No);
+        //msgbox.setDefaultButton(QMessageBox::Yes);
+        //if (msgbox.exec() == no_button) return 1;
+        QPushButton *yes_button= msgbox.addButton(er_strings[er_off + ER_YES], QMessageBox::YesRole);
+        QPushButton *no_button= msgbox.addButton(er_strings[er_off + ER_NO], QMessageBox::NoRole);
+        msgbox.setDefaultButton(yes_button);
+        msgbox.exec();
+        if (msgbox.clickedButton() == no_button) return 1;
+      }
+    }
+
+    statement_timing_mark(STATEMENT_TIMING_PARSE);
+
+    /* While executing, we allow no more statements, but a few things are enabled. */
+    /* This makes the menu seem to blink. If that's not OK, turn off sub-items not main menu items. */
+    menu_file->setEnabled(false);
+    menu_edit->setEnabled(false);
+    menu_run_action_execute->setEnabled(false);
+    if (ocelot_sigint_ignore == 0) menu_run_action_kill->setEnabled(true);
+    menu_settings->setEnabled(false);
+    menu_debug->setEnabled(false);
+    menu_help->setEnabled(false);
+    statement_edit_widget->setReadOnly(true);
+    is_kill_requested= false;
+    return_value= action_execute_one_statement(text);
+    if ((is_headless == true) && (return_value != 0))
+    {
+      fprintf(stderr, "%s\n", statement_edit_widget->result.toUtf8().constData());
+      is_kill_requested= true;
+    }
 
-  if (debuggee_state != DEBUGGEE_STATE_DEBUGGEE_WAIT_LOOP)
-  {
-    if (debug_error((char*)er_strings[er_off + ER_NO_DEBUG_SESSION]) != 0) return;
-  }
-  if (debug_parse_statement(text, command_string, &index_of_number_1, &index_of_number_2) < 0)
-  {
-    if (debug_error((char*)er_strings[er_off + ER_OVERFLOW]) != 0) return;
-    return;
+    menu_file->setEnabled(true);
+    menu_edit->setEnabled(true);
+    menu_run_action_execute->setEnabled(true);
+    menu_run_action_kill->setEnabled(false);
+    menu_settings->setEnabled(true);
+    menu_debug->setEnabled(true);
+    menu_help->setEnabled(true);
+    statement_edit_widget->setReadOnly(false);
+    /*
+      In remove_statement there is a removeSelectedText() call, which
+      causes action_statement_edit_widget_text_changed() -- twice.
+      We only want it to happen once, so we'll control it ourselves.
+      Importantly, it will call tokenize() and hparse_f_multi_block()
+      so main_token_... variables will all change.
+      Todo: check again, I think the above statement might be false.
+    */
+    statement_edit_widget_text_changed_flag= 1;
+    remove_statement(text);
+    statement_edit_widget_text_changed_flag= 0;
+    action_statement_edit_widget_text_changed();
+    //widget_sizer();
+    /* Try to set history cursor at end so last line is visible. Todo: Make sure this is the right time to do it. */
+    history_edit_widget->verticalScrollBar()->setValue(history_edit_widget->verticalScrollBar()->maximum());
+    history_edit_widget->show(); /* Todo: find out if this is really necessary */
+    statement_timing_end();
+    if (is_kill_requested == true) break;
   }
-  q_schema_name= debug_q_schema_name_in_statement;
-  q_routine_name= debug_q_routine_name_in_statement;
-
-  if (debug_error((char*)"") != 0) return;
-  if (debug_call_xxxmdbug_command(command_string) != 0) return;
-  put_diagnostics_in_result(MYSQL_MAIN_CONNECTION);
+  if (return_value != 0) return 2;
+  return 0;
 }
 
-
 /*
-  Debug|Next
+  Remove the first statement in statement_edit_widget,
+  including any whitespace after the statement end.
+  This is equivalent to statement_edit_widget->clear() if there is only one statement.
+  But when a user has cut-and-pasted several statements, we execute one at a time.
+  There are other ways to do this e.g. clear() followed by insertText().
+  Unanswered question: do we want to clear undo/redo history?
+  Unanswered question: do we want to clear selection?
+  Unanswered question: do we want to move the visible cursor?
 */
-void MainWindow::action_debug_next()
+void MainWindow::remove_statement(QString text)
 {
- statement_edit_widget->setPlainText("$NEXT");
- action_execute(1);
-}
-
-
-/*
-  Debug|Skip
-  Commented out -- not working at this time
-*/
-//void MainWindow::action_debug_skip()
-//{
-//  statement_edit_widget->setPlainText("$SKIP");
-//  action_execute(1);
-//}
-
+  //statement_edit_widget->clear(); /* ?? this is supposed to be a slot. does that matter? */
 
-/*
-  Given 'information status' schema + routine name, find out what the tab number is and make it current.
-  Then change the cursor to point to a particular line.
-  After the cursor is set to the line, the CodeEditor's highlightCurrentLine wil highlight it.
-  Remember, blockNumber() is base 0
-  Todo: If the call was completed, you shouldn't be here -- the line number will be too big!
-*/
-void MainWindow::debug_highlight_line()
-{
-  QTextCursor cursor;
-  int debug_widget_index;
-  int new_line_number;
-  QString debuggee_schema_identifier;
-  QString debuggee_routine_identifier;
+  QTextCursor q= statement_edit_widget->textCursor();
 
-  for (debug_widget_index= 0; debug_widget_index < DEBUG_TAB_WIDGET_MAX; ++debug_widget_index)
-  {
-    debuggee_schema_identifier= debuggee_information_status_schema_identifier;
-    debuggee_schema_identifier= connect_stripper(debuggee_schema_identifier, false);
-    debuggee_routine_identifier= debuggee_information_status_routine_identifier;
-    debuggee_routine_identifier= connect_stripper(debuggee_routine_identifier, false);
-    if (QString::compare(debuggee_schema_identifier, debug_routine_schema_name[debug_widget_index]) == 0)
-    {
-      if (QString::compare(debuggee_routine_identifier, debug_routine_name[debug_widget_index]) == 0)
-      {
-        break; /* now we know that debug_widget_index is for the tab of the routine the debuggee's at */
-      }
-    }
-  }
+  int offset_of_statement_end= 0;
 
-  if (debug_widget_index >= DEBUG_TAB_WIDGET_MAX)
+  if (main_token_count_in_statement > 0)
   {
-    /* I think it's impossible that routine won't be there, but if it isn't, do nothing. */
-    /* Well, not quite impossible -- schema or routine might be "unknown" or "". That's probably harmless. */
-    /* Todo: Change status line, on supposition that the routine has not started or has ended. */
-    return;
+    offset_of_statement_end= main_token_offsets[main_token_count_in_statement - 1]
+                             + main_token_lengths[main_token_count_in_statement - 1];
   }
 
-  debug_tab_widget->setCurrentWidget(debug_widget[debug_widget_index]);
-
-  new_line_number= atoi(debuggee_information_status_line_number);
-
-  --new_line_number;
-
-  /*
-    Something like QTextCursor::HighlightCurrentLine. Make the background light red.
-    This cancels the "current line" background (which is light yellow), and can be cancelled by it -- I think that's okay.
-  */
-
-  /* If this is a different debug_widget than the last one, this should turn highlight off for the last one. */
-  if (debug_widget_index != debug_timer_old_debug_widget_index)
+  for (;;)
   {
-    if (debug_timer_old_debug_widget_index != -1)
-    {
-      if (debug_timer_old_debug_widget_index != -1)
-      {
-        QList<QTextEdit::ExtraSelection> old_extraSelections;
-        debug_widget[debug_timer_old_debug_widget_index]->setExtraSelections(old_extraSelections);
-      }
-    }
-    debug_timer_old_debug_widget_index= debug_widget_index;
+    QString c= text.mid(offset_of_statement_end, 1);
+    if (c == "") break;
+    if (c > " ") break;\
+    ++offset_of_statement_end;
   }
 
-  QList<QTextEdit::ExtraSelection> extraSelections;
-
-  QTextEdit::ExtraSelection selection;
-
-  /* debug highlight color = current line color e.g. yellow, but faded */
-  QColor lineColor= QColor(ocelot_statement_highlight_current_line_color).lighter(160);
+  q.setPosition(0, QTextCursor::MoveAnchor);
+  q.setPosition(offset_of_statement_end, QTextCursor::KeepAnchor);
+  q.removeSelectedText();
 
-  QTextDocument* doc= debug_widget[debug_widget_index]->document();
-  QTextBlock block;
-  /* new_line_number will be -2 if "debuggee_wait_loop ended". probably -1 is impossible */
-  if (new_line_number == -2) block= doc->findBlockByNumber(doc->blockCount() - 1);
-  else if (new_line_number < 0) block= doc->findBlockByNumber(0);
-  else block= doc->findBlockByNumber(new_line_number);
-  int pos= block.position();
 
-  selection.format.setBackground(lineColor);
-  selection.format.setProperty(QTextFormat::FullWidthSelection, true);
-  selection.cursor= QTextCursor(doc);
-  selection.cursor.setPosition(pos, QTextCursor::MoveAnchor);
-  selection.cursor.setPosition(pos + 1, QTextCursor::KeepAnchor);
-  selection.cursor.clearSelection();
-  extraSelections.append(selection);
-  debug_widget[debug_widget_index]->setExtraSelections(extraSelections);
+  //q.select(QTextCursor::LineUnderCursor);
 
-  /*
-    I don't understand why selection.cursor.setPosition(pos) does not
-    really move the cursor, I think it's got do with whether the cursor
-    is a copy. Anyway, without the following code, if the highlighted
-    line moves off the screen, it won't be visible unless the user
-    scrolls up or down.
-    The user can move the cursor too, this only overrides temporarily.
-  */
-  QTextCursor c =  debug_widget[debug_widget_index]->textCursor();
-  c.setPosition(pos);
-  debug_widget[debug_widget_index]->setTextCursor(c);
-  //debug_widget[debug_widget_index]->ensureCursorVisible(); /* I think we don't need this */
+  //statement_edit_widget->textCursor().insertText(text);
 }
 
-
 /*
-  Debug|Delete
+  Todo: There are a few things yet to be considered.
+     I'm not 100% confident about the way I'm clearing the old results out, e.g. "delete result_form_text[...]".
+     Would it be more efficient to remove only the ones between new column count and old column count?
+       No, because data type can change, it might not be a text field the next time around.
+     Should I be saying "delete later" somehow?
+     Does memory leak?
 */
-//void MainWindow::action_debug_delete()
-//{
-//  printf("STUB: delete\n");
-//}
+int MainWindow::action_execute_one_statement(QString text)
+{
+  //QString text;
+  MYSQL_RES *mysql_res_for_new_result_set= NULL;
+  unsigned short int is_vertical= ocelot_result_grid_vertical; /* true if --vertical or \G or ego */
+  unsigned return_value= 0;
+  ++statement_edit_widget->statement_count;
+  /*
+    Todo: There should be an indication that something is being executed.
+    Possibly, on the title bar, setPlainText(tr("Executing ...")
+    Possibly there should be a status widget or a progress bar.
+    Whatever it is, turn it on now and turn it off when statement is done.
+    Update: the Run|Execute menu item changes, which is slightly helpful.
+  */
 
+  /* Apparently there is no need for a call to tokenize() here, it seems certain that it's already been called. */
 
-/*
-  Debug|Exit
-  = "CALL xxxmdbug.command([channel-name],'exit');" as a client statement
-  Check debuggee_state. If it's not DEBUGGEE_STATE_DEBUGGEE_WAIT_LOOP, debuggee_wait_loop() is not going on. THIS APPLIES FOR MANY COMMANDS!
-  Send "exit" command, which should cause debuggee to exit debuggee_wait_loop() and return from the thread function.
-  Wait up to 1 second for "exit" to work.
-  If it didn't work, "kill debuggee-connection-id".
-  TODO: If debuggee fails to respond, it's up to you to kill it.
-  TODO: Call this when main window exits, otherwise the thread's connection is immortal.
-  TODO: I wish there was some way to clear up init_connect now too.
-  Todo: menu item to shut down debugger, and hide debug_tab_widget, close the connection, and kill the thread.
-  Todo: when would you like to get rid of debug_widgets[]?
-  We call debug_menu_enable_or_disable(TOKEN_KEYWORD_DEBUG_EXIT) after calling debug_exit_go().
-*/
-void MainWindow::action_debug_exit()
-{
-    statement_edit_widget->setPlainText("$EXIT");
-    action_execute(1);
-}
+  int query_utf16_len= main_token_offsets[main_token_number+main_token_count_in_statement - 1]
+                       + main_token_lengths[main_token_number+main_token_count_in_statement - 1]
+                       - main_token_offsets[main_token_number];
 
+  query_utf16= text.mid(main_token_offsets[main_token_number], query_utf16_len);
 
-/* flagger == 0 means this is a regular $exit; flagger == 1 means we're getting rid of stuff due to a severe severe error */
-void MainWindow::debug_exit_go(int flagger)
-{
-  char call_statement[512];
+  QString last_token;
+  bool strip_last_token= false;
+  int length_of_last_token_in_statement= main_token_lengths[main_token_number + main_token_count_in_statement - 1];
+  int type_of_last_token_in_statement= main_token_types[main_token_number + main_token_count_in_statement - 1];
+  last_token= text.mid(main_token_offsets[main_token_number+main_token_count_in_statement - 1],
+                       length_of_last_token_in_statement);
+  if ((length_of_last_token_in_statement == 1) && ((type_of_last_token_in_statement == TOKEN_KEYWORD_EGO) || (type_of_last_token_in_statement == TOKEN_KEYWORD_GO)))
+  {
+    length_of_last_token_in_statement= 2;
+    strip_last_token= true;
+    if (type_of_last_token_in_statement == TOKEN_KEYWORD_EGO) is_vertical= 1;
+  }
 
-  if (flagger == 0)
+  /* Strip last word if it's delimiter or (when --named-commands, not only token) go|ego. */
+  /* todo: this is obsolete now */
+  if (last_token == ocelot_delimiter_str) strip_last_token= true;
+  else if ((ocelot_named_commands > 0) && (main_token_count_in_statement > 1))
   {
-    /* Todo: merge this with debug_error somehow, and make sure nothing's enabled/disabled unless debug/exit succeeded! */
-    if (menu_debug_action_exit->isEnabled() == false)
+    if (type_of_last_token_in_statement == TOKEN_KEYWORD_GO) strip_last_token= true;
+    if (type_of_last_token_in_statement == TOKEN_KEYWORD_EGO)
     {
-      make_and_put_message_in_result(ER_DEBUG_NOT_DONE, 0, (char*)"");
-      return;
+      strip_last_token= true;
+      is_vertical= 1;
     }
   }
+  if (strip_last_token == true)
+  {
+    query_utf16_copy= text.mid(main_token_offsets[main_token_number], query_utf16_len-length_of_last_token_in_statement);
+  }
+  else query_utf16_copy= query_utf16;
 
-  debug_top_widget->hide();
-  debug_timer->stop();
-  /* Todo: more cleanup e.g. kill the debuggee thread, close the connection, even if it's not responding */
-  /* Todo: yet more cleanup if you want to get rid of the setup result */
+  statement_edit_widget->start_time= QDateTime::currentMSecsSinceEpoch(); /* will be used for elapsed-time display */
+  int additional_result= 0;
+  int ecs= execute_client_statement(text, &additional_result);
 
-  debug_delete_tab_widgets();
+  QByteArray result_set_for_history;
 
-  if (debuggee_state == DEBUGGEE_STATE_DEBUGGEE_WAIT_LOOP)
+  if (ecs != 1)
   {
-    if (debug_call_xxxmdbug_command("exit") != 0)
+    /* The statement was not handled entirely by the client, it must be passed to the DBMS. */
+
+    bool do_something= true;
+
+    /* If DBMS is not (yet) connected, except for certain SET ocelot_... statements, this is an error. */
+    if (connections_is_connected[0] == 0)
     {
-      put_diagnostics_in_result(MYSQL_MAIN_CONNECTION);
-      return;
+      if (ecs == 2) make_and_put_message_in_result(ER_OK, 0, (char*)"");
+      else make_and_put_message_in_result(ER_NOT_CONNECTED, 0, (char*)"");
+      do_something= false;
     }
-    for (int kk= 0; kk < 10; ++kk) {QThread48::msleep(100); if (debuggee_state != DEBUGGEE_STATE_DEBUGGEE_WAIT_LOOP) break; }
-    if ((debuggee_state == DEBUGGEE_STATE_DEBUGGEE_WAIT_LOOP) && (debuggee_connection_id != 0))
+    /* If --one-database, and USE caused default database to change, error */
+    if ((ocelot_one_database > 0) && (ocelot_database != statement_edit_widget->dbms_database))
     {
-      sprintf(call_statement, "kill %d", debuggee_connection_id);
+      make_and_put_message_in_result(ER_ONE_DATABASE, 0, (char*)"");
+      do_something= false;
+    }
 
-      if (lmysql->ldbms_mysql_real_query(&mysql[MYSQL_MAIN_CONNECTION], call_statement, strlen(call_statement)))
+    if (do_something == true)
+    {
+      /* Look for a CREATE TABLE statement with a SERVER clause. */
+      bool is_create_table_server;
+      int result= create_table_server(text, &is_create_table_server, main_token_number, main_token_count_in_statement);
+      dbms_long_query_result= result;
+      if (is_create_table_server == false)
       {
-        sprintf(call_statement, "SIGNAL SQLSTATE '05678' SET message_text='exit failed and kill failed -- try executing manually: kill %d'", debuggee_connection_id);
-        lmysql->ldbms_mysql_real_query(&mysql[MYSQL_MAIN_CONNECTION], call_statement, strlen(call_statement));
+        /* An export, pager or headless output must get whole values, so no LEFT(column, n) rewrite */
+        if ((ocelot_export_format != "") || (is_headless == true) || (ocelot_pager_is_on == true))
+        {
+          lazy_blob_table= "";
+          lazy_blob_column_names.clear();
+          real_query_of_tokens(text, MYSQL_MAIN_CONNECTION);
+        }
+        else
+        {
+          QString query_to_send= lazy_blob_rewrite(text);
+          if (lazy_blob_table == "") real_query_of_tokens(text, MYSQL_MAIN_CONNECTION);
+          else real_query(query_to_send, MYSQL_MAIN_CONNECTION);
+        }
       }
-    }
-  }
+      int export_result;
 
-  /* This should erase left-over messages in the pipe, such as the 'i status' message. Probably there's only one. */
-  QString error_return;
-  sprintf(call_statement, "%s%s%s","call xxxmdbug.dbms_pipe_receive('xxxmdbug_",debuggee_channel_name,
-          "', 1, @xxxmdbug_tmp_1, @xxxmdbug_tmp_2)");
-  for (int i= 0; i < 50; ++i)                                              /* 50 is an arbitrary big number */
-  {
-    if (lmysql->ldbms_mysql_real_query(&mysql[MYSQL_MAIN_CONNECTION], call_statement, strlen(call_statement))) break;
-    error_return= select_1_row("select @xxxmdbug_tmp_1");
-    if (error_return != "") break;
-    if (select_1_row_result_1 == "") break;
-  }
+      if (dbms_long_query_result)
+      {
+        /* beep() hasn't been tested because getting sound to work on my computer is so hard */
+        if (ocelot_no_beep == 0) QApplication::beep();
+        return_value= 1;
+        if (is_create_table_server == false)
+          put_diagnostics_in_result(MYSQL_MAIN_CONNECTION);
+      }
+      else if (((ocelot_export_format != "") || (is_headless == true) || (ocelot_pager_is_on == true))
+            && ((connections_dbms[0] == DBMS_MYSQL) || (connections_dbms[0] == DBMS_MARIADB))
+            && ((export_result= export_result_set(MYSQL_MAIN_CONNECTION,
+                                                  export_format_for_result(),
+                                                  export_file_for_result())) != 0))
+      {
+        /* The result went to ocelot_export_file, not to the grid or the history. */
+        if (export_result == 2) return_value= 1;
+      }
+      else {
+        /*
+          It was a successful SQL statement, and now look if it returned a result.
+          If it did, as determined by looking at the mysql_res that lmysql->ldbms_mysql_store_result() returns,
+          then free the previous mysql_res and delete the previous result grid,
+          before setting up new ones.
+          This means that statements which don't return result sets don't cause clearing
+          of old result sets from the screen, e.g. SET has no effect on result grid.
+          This means that momentarily there will be an old mysql_res and a new mysql_res.
+          That takes up memory. If it were easy to check in advance whether a statement
+          caused a result set (e.g. with mysql_next_result or by looking at whether the
+          statement is SELECT SHOW etc.), that would be better.
+        */
+#ifdef DBMS_TARANTOOL
+        if (connections_dbms[0] == DBMS_TARANTOOL)
+        {
+          /* todo: failing to check if statement started with comment */
+          if ((main_token_types[0] == TOKEN_KEYWORD_SELECT)
+           || (main_token_types[0] == TOKEN_KEYWORD_LUA)
+           || ((main_token_flags[0]&TOKEN_FLAG_IS_LUA) != 0))
+          {
+            int result_set_type= tarantool_result_set_type(0);
+            if ((result_set_type == 0) || (result_set_type == 1))
+              mysql_res_for_new_result_set= 0;
+            else
+            {
+              /* Yes mysql_res_for_new_result_set will be invalid. Fix, eh? */
+              {
+                MYSQL_RES r;
+                mysql_res_for_new_result_set= &r;
+              }
+            }
+          }
+          else mysql_res_for_new_result_set= 0;
+        }
+        if (connections_dbms[0] != DBMS_TARANTOOL)
+#endif
+        mysql_res_for_new_result_set= lmysql->ldbms_mysql_store_result(&mysql[MYSQL_MAIN_CONNECTION]);
+        statement_timing_mark(STATEMENT_TIMING_STORE);
+        if (mysql_res_for_new_result_set == 0)
+        {
+          /*
+            Last statement did not cause a result set. We could hide the grid and shrink the
+            central window with "result_grid_tab_widget[0]->hide()", but we don't.
+          */
+          get_sql_mode(main_token_types[main_token_number], text);
+          put_diagnostics_in_result(MYSQL_MAIN_CONNECTION);
+        }
+        else
+        {
+#ifdef DBMS_TARANTOOL
+          if (connections_dbms[0] == DBMS_TARANTOOL)
+          {
+            /* TODO: Free the last reply, equivalent to mysql_free_result */
+          }
+          else
+#endif
+          {
+          if (mysql_res != 0)
+            {
+              lmysql->ldbms_mysql_free_result(mysql_res); /* This is the place we free if myql_more_results wasn't true, see below. */
+            }
 
-  /* $install was saying "Suggested next step is: $EXIT" even though $EXIT was already done. */
-  debuggee_state= DEBUGGEE_STATE_0;
+            mysql_res= mysql_res_for_new_result_set;
 
-  /*
-     We call pthread_join so that memory is freed.
-     But it might wait forever if debug thread is loopy.
-     Perhaps we should kill the thread if we suspect that.
-     Anyway: $exit is slow, and pthread_join is probably the cause.
-  */
-  if (debug_thread_exists == true)
-  {
-    int pthread_join_result= pthread_join(debug_thread_id, NULL);
-    assert(pthread_join_result == 0);
-    debug_thread_exists= false;
-  }
+            /* We need to think better what to do if we exceed MAX_COLUMNS */
+            /* ... or maybe not, it seems we got rid of MAX_COLUMNS */
+            /*
+              Todo: consider whether it would be appropriate to set grid width with
+              result_grid_tab_widget[0]->result_column_count= lmysql->ldbms_mysql_num_fields(mysql_res);
+              but it may be unnecessary, and may cause a crash in garbage_collect()
+            */
 
-  if (flagger == 0)
-  {
-    put_diagnostics_in_result(MYSQL_MAIN_CONNECTION); /* This should show the result of the final call or select, so it should be "ok" */
-  }
-}
+            result_row_count= lmysql->ldbms_mysql_num_rows(mysql_res);                /* this will be the height of the grid */
+          }
 
+          ResultGrid *rg;
+          {
+            for (int i_r= 0; i_r < ocelot_grid_actual_tabs; ++i_r)
+            {
+              rg= qobject_cast<ResultGrid*>(result_grid_tab_widget->widget(i_r));
+              rg->is_paintable= 0;
+              rg->garbage_collect();
+            }
+            rg= qobject_cast<ResultGrid*>(result_grid_tab_widget->widget(0));
+            rg->lazy_blob_table= lazy_blob_table;
+            rg->lazy_blob_column_names= lazy_blob_column_names;
+            rg->lazy_blob_length= ocelot_grid_lazy_blob_length;
+            //QFont tmp_font;
+            //tmp_font= rg->font();
+            rg->fillup(mysql_res,
+                      //&tarantool_tnt_reply,
+                      connections_dbms[0],
+                      //this,
+                      is_vertical, ocelot_result_grid_column_names,
+                      lmysql, ocelot_client_side_functions,
+                      ocelot_batch, ocelot_html, ocelot_raw, ocelot_xml,
+                      MYSQL_MAIN_CONNECTION);
+            result_grid_tab_widget->setCurrentWidget(rg);
+            result_grid_tab_widget->tabBar()->hide();
+            /* next line redundant? display() ends with show() */
+            rg->show();
+            result_grid_tab_widget->show(); /* Maybe this only has to happen once */
+          }
 
-/* This is called from $exit, but also might be called from $debug if $debug fails */
-/* We're reversing the effects of "new CodeEditor() and "addTab()" in debug_debug_go(). */
-void MainWindow::debug_delete_tab_widgets()
-{
-  debug_tab_widget->clear(); /* equivalent to removeTab() for all tab widgets */
-  for (int debug_widget_index= 0; debug_widget_index < DEBUG_TAB_WIDGET_MAX; ++debug_widget_index)
-  {
-    if (debug_widget[debug_widget_index] != 0)
-    {
-      debug_widget[debug_widget_index]->removeEventFilter(this);
-      delete debug_widget[debug_widget_index];
-      debug_widget[debug_widget_index]= 0;
-    }
-  }
-}
+          /*
+            Following is no-op by default because ocelot_history_max_row_count=0
+          */
+          if ((ocelot_grid_actual_tabs > 0)
+           && (result_set_for_history.isEmpty() == true))
+          {
+            rg= qobject_cast<ResultGrid*>(result_grid_tab_widget->widget(0));
+            result_set_for_history= rg->copy_to_history(ocelot_history_max_row_count.toLong(), is_vertical,
+                                                        ocelot_history_max_result_bytes);
+          }
+          /* Todo: small bug: elapsed_time calculation happens before lmysql->ldbms_mysql_next_result(). */
+          /* You must call lmysql->ldbms_mysql_next_result() + lmysql->ldbms_mysql_free_result() if there are multiple sets */
+          put_diagnostics_in_result(MYSQL_MAIN_CONNECTION); /* Do this while we still have number of rows */
+          //history_markup_append(result_set_for_history, true);
+
+#ifdef DBMS_TARANTOOL
+          if ((connections_dbms[0] != DBMS_TARANTOOL)
+           && (lmysql->ldbms_mysql_more_results(&mysql[MYSQL_MAIN_CONNECTION])))
+
+#else
+          if (lmysql->ldbms_mysql_more_results(&mysql[MYSQL_MAIN_CONNECTION]))
+#endif
+          {
+            lmysql->ldbms_mysql_free_result(mysql_res);
+            /*
+              We started with CLIENT_MULTI_RESULT flag (not CLIENT_MULTI_STATEMENT).
+              We expect that a CALL to a stored procedure might return multiple result sets
+              plus a status result at the end. The following lines try to pick up and display
+              the extra result sets, up to a fixed maximum, and just throw away everything
+              after that, to avoid the dreaded out-of-sync error message.
+              If it's an ordinary select, lmysql->ldbms_mysql_free_result(mysql_res) happens later, see above.
+            */
+            int result_grid_table_widget_index= 1;
+            for (;;)
+            {
+              dbms_executor_run(MYSQL_MAIN_CONNECTION, DBMS_EXECUTOR_NEXT_RESULT, NULL, 0, &mysql_res);
+
+              if (dbms_long_query_result != 0)
+              {
+                return_value= 1;
+                /* If mysql_next_result) == 1 means error, -1 means no more. */
+                /* TODO: don't do this for SOURCE. Check for beep. */
+                if (dbms_long_query_result == 1)
+                {
+                  put_diagnostics_in_result(MYSQL_MAIN_CONNECTION);
+                  //history_markup_append("", true);
+                }
+                break;
+              }
+              /* todo: consider appending row count to result message */
+              /* mysql_res is already stored, by the executor */
+
+              /* I think the following will help us avoid the "status" return. */
+              if (mysql_res == NULL) continue;
+              if (result_grid_table_widget_index == ocelot_grid_actual_tabs)
+              {
+                result_grid_add_tab();
+              }
+
+              if (result_grid_table_widget_index < ocelot_grid_actual_tabs)
+              {
+                ResultGrid* r;
+                r= qobject_cast<ResultGrid*>(result_grid_tab_widget->widget(result_grid_table_widget_index));
+                result_grid_tab_widget->tabBar()->show(); /* is this in the wrong place? */
+                result_row_count= lmysql->ldbms_mysql_num_rows(mysql_res);                /* this will be the height of the grid */
+                r->fillup(mysql_res,
+                          //&tarantool_tnt_reply,
+                          connections_dbms[0],
+                          //this,
+                          is_vertical,
+                          ocelot_result_grid_column_names,
+                          lmysql,
+                          ocelot_client_side_functions,
+                          ocelot_batch, ocelot_html, ocelot_raw, ocelot_xml,
+                          MYSQL_MAIN_CONNECTION);
+                /* next line redundant? display() ends with show() */
+                r->show();
 
+                //Put in something based on this if you want extra results to go to history:
+                //... result_grid_table_widget[result_grid_tab_widget_index]->copy_to_history(); etc.
 
-/*
-  Debug|Information
-*/
-void MainWindow::action_debug_information()
-{
-  if (debug_call_xxxmdbug_command("information status") != 0) return;
-  statement_edit_widget->insertPlainText("select * from xxxmdbug.information_status;");
-  action_execute(1);
-}
+                ++result_grid_table_widget_index;
+              }
 
+              if (mysql_res != 0) lmysql->ldbms_mysql_free_result(mysql_res);
 
-/*
-  Debug|Refresh server variables
-*/
-void MainWindow::action_debug_refresh_server_variables()
-{
-  if (debuggee_state != DEBUGGEE_STATE_DEBUGGEE_WAIT_LOOP)
-  {
-    if (debug_error((char*)er_strings[er_off + ER_NO_DEBUG_SESSION]) != 0) return;
+            }
+            mysql_res= 0;
+          }
+        }
+      }
+      //put_diagnostics_in_result(MYSQL_MAIN_CONNECTION);
+    }
   }
-  if (debug_call_xxxmdbug_command("refresh server_variables") != 0) return;
-  statement_edit_widget->insertPlainText("select * from xxxmdbug.server_variables;");
-  action_execute(1);
-}
-
 
-/*
-  Debug|Refresh user variables
-*/
-void MainWindow::action_debug_refresh_user_variables()
-{
-  if (debuggee_state != DEBUGGEE_STATE_DEBUGGEE_WAIT_LOOP)
+  /* statement is over */
+  if ((ocelot_statement_timing == 2) && (additional_result != TOKEN_KEYWORD_SOURCE))
   {
-    if (debug_error((char*)er_strings[er_off + ER_NO_DEBUG_SESSION]) != 0) return;
+    statement_timing_mark(STATEMENT_TIMING_LAYOUT);
+    statement_edit_widget->result.append(" [" + statement_timing_text() + "]");
   }
-  if (debug_call_xxxmdbug_command("refresh user_variables") != 0) return;
-  statement_edit_widget->insertPlainText("select * from xxxmdbug.user_variables;");
-  action_execute(1);
-}
-
-
-/*
-  Debug|Refresh variables
-*/
-void MainWindow::action_debug_refresh_variables()
-{
-  if (debuggee_state != DEBUGGEE_STATE_DEBUGGEE_WAIT_LOOP)
+  if (additional_result != TOKEN_KEYWORD_SOURCE)
   {
-    if (debug_error((char*)er_strings[er_off + ER_NO_DEBUG_SESSION]) != 0) return;
+    history_markup_append(result_set_for_history, true); /* add prompt+statement+result to history, with markup */
   }
-  if (debug_call_xxxmdbug_command("refresh variables") != 0) return;
-  statement_edit_widget->insertPlainText("select * from xxxmdbug.variables;");
-  action_execute(1);
+  return return_value;
 }
 
-
 /*
-  Debug|Refresh call_stack
+  Bottom-level call to DBMS.
+  We call this when we know that there will be no more change
+  to the query (no local-subquery substitution, but maybe
+  stripping of comments and delimiters other than ;).
+  During this query we allocate or use globals:
+  dbms_query, dbms_query_len.
+  The query might go to either the main or the local
+  connection, the local connection might be either
+  mysql or tarantool.
+  Todo: Tarantool can't be killed so easily. Make a fiber?
 */
-void MainWindow::action_debug_refresh_call_stack()
+int MainWindow::real_query(QString query, int connection_number)
 {
-  if (debuggee_state != DEBUGGEE_STATE_DEBUGGEE_WAIT_LOOP)
-  {
-    if (debug_error((char*)er_strings[er_off + ER_NO_DEBUG_SESSION]) != 0) return;
-  }
-  if (debug_call_xxxmdbug_command("refresh call_stack") != 0) return;
-  statement_edit_widget->insertPlainText("select * from xxxmdbug.call_stack;");
-  action_execute(1);
+  /*
+    If the last error was CR_SERVER_LOST 2013 or CR_SERVER_GONE_ERROR 2006,
+    and it might be possible to reconnect, try.
+    But if mysql_ping() fails, I don't see much that we can do.
+  */
+  /* todo: figure out why you used global dbms_query for this */
+  /* TODO: BUG. This statement caused a crash when ocelot_comments == 0:
+         create procedure p27 ()
+           begin
+           declare xxx int;
+           declare yyy int;
+           set xxx = 0;
+           while xxx < 1000 do
+             set xxx = xxx;
+             set xxx = xxx + 1;
+             end while;
+           end
+      We work around it by allocating double what we need for dbms_query. */
+  statement_timing_mark(STATEMENT_TIMING_CLIENT);
+  dbms_query_len= query.toUtf8().size();           /* See comment "UTF8 Conversion" */
+  dbms_query= new char[(dbms_query_len + 1) * 2];
+  dbms_query_len= make_statement_ready_to_send(query,
+                                               dbms_query, dbms_query_len + 1);
+  assert(strlen(dbms_query) < ((unsigned int) dbms_query_len + 1) * 2);
+  return real_query_send(connection_number);
 }
 
-
 /*
-  Called from: action_debug_exit(), action_debug_debug(), action_debug_information(),
-  and anything else which requires xxxmdbug.command -- except 'attach', except
-  'information status' from from action_debug_timer_status().
-  Make the SQL statement that is actually executed, but don't trouble the user with
-  the details by showing it. For example, if the user said "$DEBUG test.p8", we
-  execute "call xxxmdbug.command('channel#...','debug test.p8')" and return the
-  result from that.
+  Like real_query(), for the statement in main_token_*, when there's
+  been no rewrite. See make_statement_ready_to_send_from_tokens().
 */
-int MainWindow::debug_call_xxxmdbug_command(const char *command)
+int MainWindow::real_query_of_tokens(QString text, int connection_number)
 {
-  char call_statement[512];
-
-  strcpy(call_statement, "call xxxmdbug.command('");
-  strcat(call_statement, debuggee_channel_name);
-  strcat(call_statement, "', '");
-  strcat(call_statement, command);
-  strcat(call_statement, "');\n");
-
-  if (lmysql->ldbms_mysql_real_query(&mysql[MYSQL_MAIN_CONNECTION], call_statement, strlen(call_statement)))
-  {
-    /* Initially this can happen because we start the timer immediately after we call 'attach'. */
-    put_diagnostics_in_result(MYSQL_MAIN_CONNECTION);
-    return 1;
-  }
-  debug_statement= command;
-
-  //put_diagnostics_in_result(MYSQL_MAIN_CONNECTION)???
-
-  /* We no longer try to get the debuggee response with debug_information_status(). */
-  //if (strcmp(command, "information status") != 0)
-  //{
-  //  QString debuggee_response= "Debuggee response = ";
-  //  if (debug_information_status((char *)command) != 0)
-  //    {
-  //    debuggee_response.append("(none). Possibly debuggee is still executing the last command, which was: ");
-  //    debuggee_response.append(debuggee_information_status_last_command);
-  //  }
-  //  else
-  //  {
-  //    debuggee_response.append(debuggee_information_status_last_command_result);
-  //  }
-  //  history_edit_widget->append(debuggee_response);
-  //}
-  return 0;
+  statement_timing_mark(STATEMENT_TIMING_CLIENT);
+  int statement_type= main_token_types[main_token_number];
+  if ((ocelot_prepared_statement_cache > 0)
+   && (connection_number == MYSQL_MAIN_CONNECTION)
+   && ((connections_dbms[connection_number] == DBMS_MYSQL) || (connections_dbms[connection_number] == DBMS_MARIADB))
+   && (lmysql->ldbms_mysql_is_stmt_available())
+   && ((statement_type == TOKEN_KEYWORD_INSERT) || (statement_type == TOKEN_KEYWORD_UPDATE)
+    || (statement_type == TOKEN_KEYWORD_DELETE) || (statement_type == TOKEN_KEYWORD_REPLACE)))
+  {
+    QStringList parameters;
+    make_statement_ready_to_send_from_tokens(text, &parameters);
+    bool is_done= prepared_statement_run(connection_number, parameters);
+    delete []dbms_query;
+    if (is_done) return dbms_long_query_result;
+  }
+  make_statement_ready_to_send_from_tokens(text);
+  return real_query_send(connection_number);
 }
 
-
-/*
-  INFORMATION STATUS -- internal
-  We should call this after 'attach' or after 'debug' to see whether there's been some success.
-  Most contacts with the debugger should get a quick response, unless the last was 'continue' or 'step ...' (?)
-  ... Actually, check that: maybe 'continue' acknowledges receipt before continuing.
-  ... And I think that 'continue' will still cause messages, if it's inside stored-procedure code that's being debugged.
-*/
-int MainWindow::debug_information_status(char *last_command)
+/* The part of real_query() that comes after dbms_query + dbms_query_len are ready */
+int MainWindow::real_query_send(int connection_number)
 {
-  int k;
-
-  /* TODO: JUST GET RID OF THIS PROC. I NO LONGER SEE ANY POINT TO IT. */
-
-  for (k= 0; k < 100; ++k)
+  statement_timing_mark(STATEMENT_TIMING_UTF8);
+  /*
+    If the last error was CR_SERVER_LOST 2013 or CR_SERVER_GONE_ERROR 2006,
+    and it might be possible to reconnect, try.
+    But if mysql_ping() fails, I don't see much that we can do.
+  */
+  if ((mysql_errno_result == 2006) || (mysql_errno_result == 2013))
   {
-    /*
-       By sleeping, we give the QTimer a chance to call action_debug_timer_status() and update status.
-       But it doesn't work! I guess it's because sleeping doesn't restart the event loop!
-    */
-    QThread48::msleep(100);
-    if (strcmp(debuggee_information_status_last_command, last_command) == 0)
+    if (ocelot_opt_reconnect > 0)
     {
-      /* todo: this is not enough! you should be checking also if the command number has gone up! */
-      break;
+      /* The server may have restarted, so the profile connection is stale too, profile_capture() will restart it */
+      profile_stop();
+      lmysql->ldbms_mysql_ping(&mysql[MYSQL_MAIN_CONNECTION]);
     }
   }
-
-  /* k >= 100 means the 100-iteration loop containing a 10-ms sleep has gone by without a match for last_commnd */
-  /* the caller will probably generate a warning */
-  if (k >= 100) return 1; else return 0;
+#ifdef DBMS_TARANTOOL
+  /* todo: for tarantool as for mysql, call with a separate thread so it's killable */
+  if (connections_dbms[connection_number] == DBMS_TARANTOOL)
+  {
+    dbms_long_query_result= tarantool_real_query(dbms_query, dbms_query_len, MYSQL_MAIN_CONNECTION, main_token_number, main_token_count_in_statement);
+    dbms_long_query_state= LONG_QUERY_STATE_ENDED;
+  }
+  else
+#endif
+  {
+    dbms_executor_run(connection_number, DBMS_EXECUTOR_REAL_QUERY, dbms_query, dbms_query_len, NULL,
+                      NULL, (connection_number == MYSQL_MAIN_CONNECTION));
+    statement_timing_mark(STATEMENT_TIMING_SERVER);
+    //     dbms_long_query_result= lmysql->ldbms_mysql_real_query(&mysql[MYSQL_MAIN_CONNECTION], dbms_query, dbms_query_len);
+    //     dbms_long_query_state= LONG_QUERY_STATE_ENDED;
+  }
+  delete []dbms_query;
+  return dbms_long_query_result;
 }
 
-
 /*
-  QTimer *debug_timer: every 100 milliseconds (every 1/10 second), while the debuggee
-  is running, the timer event will invoke action_debug_timer() which updates the status.
-  Todo: Start it when debuggee starts, stop it when debuggee stops.
-  If a new information status message has appeared, display it.
-  Todo: make sure timer is stopped before debug_tab_window is closed.
-  Todo: This won't necessarily catch errors, because of the 1/10 second intervals and
-        because multiple commands can be sent asynchronously. Think of a way!
-        Meanwhile, just say: "If you must know the result, you must wait after each command."
-  Todo: It would be faster to interpret the 'information status' results in C code here,
-        rather than using xxxmdbug.information_status repeatedly.
-        Besides, selecting from xxxmdbug.information_status can change the state of the main mysql connection.
-        Maybe you should create a different connection?
-  Todo: Worry about race conditions. The main thread could look at a status variable before all
-        the status variables are updaated by this function. This might be alleviated by
-        updating the counter last, but some sort of mutex might have to be considered.
-  Todo: Check whether something closes the connection.
-        Maybe it would be safest to say that, once a connection is open, it stays open.
-        Hmm, why is this a worry, since we're doing the searching on main connection not debuggee connection?
-  Todo: I have seen the xxxmdbug.command() cause "send+receive error" meaning a change to init_connect failed.
-        Maybe xxxmdbug.commnd() shouldn't try to change init_connect -- after all, we're not trying to send, only receive.
-
+  Prepared-statement cache, if ocelot_prepared_statement_cache > 0.
+  Repeating an INSERT|UPDATE|DELETE|REPLACE, e.g. from history, means the
+  server parses the same text each time. Instead,
+  make_statement_ready_to_send_from_tokens() replaces the literals with ?
+  (see prepared_statement_is_parameter()), and that text plus the default
+  database is the key in a list of MYSQL_STMT handles per connection, most
+  recently used first, at most ocelot_prepared_statement_cache long.
+  A hit is mysql_stmt_execute() with the literals as parameters, in the
+  binary protocol; a miss is mysql_stmt_prepare() first. Both happen in the
+  connection's executor, so Run|Kill still works.
+  If the server can't prepare the text because of a ? where it won't take
+  one, or because there's a result set (e.g. MariaDB's INSERT ... RETURNING),
+  the entry has stmt == NULL so next time we go directly to mysql_real_query().
+  SELECT isn't done this way because ResultGrid wants a MYSQL_RES.
+  put_diagnostics_in_result() still looks at the MYSQL handle, which has
+  the errno, affected rows, warning count and info after mysql_stmt_execute().
+  The handles are closed when the connection id changes, when there might
+  be a reconnect, or when the option is set to 0.
+  Only the main connection gets here, because the connection id that we
+  compare with is statement_edit_widget->dbms_connection_id, which is the
+  main connection's.
 */
-void MainWindow::action_debug_timer_status()
+struct prepared_statement_cache_entry
 {
-  char call_statement[512];
-  MYSQL_RES *debug_res= NULL;
-  MYSQL_ROW row= NULL;
-  char unexpected_error[512];
-  int unexpected_new_error= 0;
-
-  /*
-    DANGER
-    When the main line is running SQL statements, it calls
-    QApplication::processEvents(), so there can be horrible
-    conflicts -- action_debug_timer_status() runs SQL too.
-    Either we must disable the Run|Kill feature, or disable
-    the timer. Here, we've chosen to disable the timer.
-  */
-  if (dbms_long_query_state == LONG_QUERY_STATE_STARTED) return;
+  QByteArray query;    /* dbms_query with ? for literals */
+  QString database;    /* statement_edit_widget->dbms_database when it was prepared */
+  MYSQL_STMT *stmt;    /* NULL if the server couldn't prepare it */
+};
+static QList<prepared_statement_cache_entry> prepared_statement_cache[MYSQL_MAX_CONNECTIONS];
+static int prepared_statement_cache_connection_id[MYSQL_MAX_CONNECTIONS];
 
-  unexpected_error[0]= '\0';
-  strcpy(call_statement, "call xxxmdbug.command('");
-  strcat(call_statement, debuggee_channel_name);
-  strcat(call_statement, "', 'information status')");
-
-  if (debuggee_state != DEBUGGEE_STATE_DEBUGGEE_WAIT_LOOP)
+/*
+  For a literal token: the MYSQL_BIND buffer_type it would have as a
+  parameter, or -1 if it can't be a parameter.
+  123 is MYSQL_TYPE_LONGLONG, 1.5 is MYSQL_TYPE_NEWDECIMAL (as a string,
+  so it stays exact), 1e5 is MYSQL_TYPE_DOUBLE, 'x' is MYSQL_TYPE_STRING.
+  Not 0x1F, X'..', N'..', or a string with \ since what that means
+  depends on sql_mode NO_BACKSLASH_ESCAPES. Not 1abc, which is an identifier.
+*/
+static int prepared_statement_literal_type(QString token)
+{
+  int size= token.size();
+  if (size == 0) return -1;
+  if (token.at(0) == '\'')
   {
-    if (debuggee_state == DEBUGGEE_STATE_DEBUGGEE_WAIT_LOOP_ERROR)
-    {
-      sprintf(unexpected_error, er_strings[er_off + ER_DEBUGGEE_WAIT_LOOP], debuggee_state_error);
-    }
-    else
-    {
-      if ((debuggee_state < 0) || (debuggee_state == DEBUGGEE_STATE_END)) strcpy(unexpected_error, "debuggee_wait_loop ended");
-      else strcpy(unexpected_error, er_strings[er_off + ER_DEBUGGEE_WAIT_LOOP_IS_NOT]);
+    if ((size < 2) || (token.at(size - 1) != '\'')) return -1;
+    if (token.contains('\\')) return -1;
+    return MYSQL_TYPE_STRING;
+  }
+  bool is_integer= (size <= 18);
+  for (int i= 0; i < size; ++i) if ((token.at(i) < '0') || (token.at(i) > '9')) is_integer= false;
+  if (is_integer) return MYSQL_TYPE_LONGLONG;
+  bool ok;
+  token.toDouble(&ok);
+  if (ok == false) return -1;
+  if (token.contains('e', Qt::CaseInsensitive)) return MYSQL_TYPE_DOUBLE;
+  return MYSQL_TYPE_NEWDECIMAL;
+}
+
+/*
+  Whether main token i can be a ? in the prepared statement.
+  Besides prepared_statement_literal_type():
+  Not after an introducer (_utf8'x') or DATE|TIME|TIMESTAMP, or next to
+  another string ('a' 'b' is concatenation).
+  Not a number after BY, since ORDER BY 1 is a column position but
+  ORDER BY ? is a constant; a number after LIMIT etc. is all right.
+  Anything else that the server won't take, it will say at prepare time.
+*/
+bool MainWindow::prepared_statement_is_parameter(QString text, unsigned int i, unsigned int i_start)
+{
+  int type= main_token_types[i];
+  if ((type != TOKEN_TYPE_LITERAL_WITH_SINGLE_QUOTE) && (type != TOKEN_TYPE_LITERAL_WITH_DIGIT)) return false;
+  if (prepared_statement_literal_type(text.mid(main_token_offsets[i], main_token_lengths[i])) == -1) return false;
+  unsigned int i_end= main_token_number + main_token_count_in_statement;
+  if ((i + 1 < i_end) && (main_token_types[i + 1] == TOKEN_TYPE_LITERAL_WITH_SINGLE_QUOTE)) return false;
+  if (i > i_start)
+  {
+    int previous_type= main_token_types[i - 1];
+    if ((previous_type == TOKEN_KEYWORD_DATE)
+     || (previous_type == TOKEN_KEYWORD_TIME)
+     || (previous_type == TOKEN_KEYWORD_TIMESTAMP)
+     || (previous_type == TOKEN_TYPE_LITERAL_WITH_SINGLE_QUOTE)
+     || (text.at(main_token_offsets[i - 1]) == '_'))
+      return false;
+  }
+  if (type == TOKEN_TYPE_LITERAL_WITH_DIGIT)
+  {
+    for (unsigned int j= i; j > i_start; --j)
+    {
+      int t= main_token_types[j - 1];
+      if (t == TOKEN_KEYWORD_BY) return false;
+      if ((t == TOKEN_KEYWORD_LIMIT) || (t == TOKEN_KEYWORD_OFFSET)
+       || (t == TOKEN_KEYWORD_WHERE) || (t == TOKEN_KEYWORD_SET)
+       || (t == TOKEN_KEYWORD_VALUES) || (t == TOKEN_KEYWORD_SELECT)
+       || (t == TOKEN_KEYWORD_HAVING) || (t == TOKEN_KEYWORD_ON))
+        break;
     }
   }
+  return true;
+}
 
-  if (unexpected_error[0] == '\0')
+void MainWindow::prepared_statement_cache_clear(unsigned int connection_number)
+{
+  QList<prepared_statement_cache_entry> *cache= &prepared_statement_cache[connection_number];
+  for (int i= 0; i < cache->size(); ++i)
   {
-    if (lmysql->ldbms_mysql_real_query(&mysql[MYSQL_MAIN_CONNECTION], call_statement, strlen(call_statement)))
-    {
-      /* Initially this can happen because we start the timer immediately after we call 'attach'. */
-      strcpy(unexpected_error, er_strings[er_off + ER_I_STATUS_FAILED]);
-    }
+    if (cache->at(i).stmt != NULL) lmysql->ldbms_mysql_stmt_close(cache->at(i).stmt);
   }
+  cache->clear();
+}
 
-  if (unexpected_error[0]== '\0')
+/*
+  Called from real_query_of_tokens() when dbms_query has ? for the literals
+  in parameters. Returns true if the statement was done (successfully or not,
+  dbms_long_query_result says), false if the caller should send the
+  statement the ordinary way.
+*/
+bool MainWindow::prepared_statement_run(unsigned int connection_number, QStringList parameters)
+{
+  assert(connection_number == MYSQL_MAIN_CONNECTION);
+  QList<prepared_statement_cache_entry> *cache= &prepared_statement_cache[connection_number];
+  if (prepared_statement_cache_connection_id[connection_number] != statement_edit_widget->dbms_connection_id)
   {
-    const char *query= "select * from xxxmdbug.information_status";
-    if (lmysql->ldbms_mysql_real_query(&mysql[MYSQL_MAIN_CONNECTION], query, strlen(query)))
-    {
-      strcpy(unexpected_error, er_strings[er_off + ER_I_STATUS_FAILED_NOT_SEVERE]);
-    }
+    prepared_statement_cache_clear(connection_number);
+    prepared_statement_cache_connection_id[connection_number]= statement_edit_widget->dbms_connection_id;
+  }
+  /* real_query_send() might reconnect, and a new session has none of our statements */
+  if ((mysql_errno_result == 2006) || (mysql_errno_result == 2013))
+  {
+    prepared_statement_cache_clear(connection_number);
+    return false;
   }
 
-  if (unexpected_error[0] == '\0')
+  QByteArray query(dbms_query, dbms_query_len);
+  QString database= statement_edit_widget->dbms_database;
+  MYSQL_STMT *stmt;
+  int i;
+  for (i= 0; i < cache->size(); ++i)
   {
-    debug_res= lmysql->ldbms_mysql_store_result(&mysql[MYSQL_MAIN_CONNECTION]);
-    if (debug_res == NULL)
+    if ((cache->at(i).query == query) && (cache->at(i).database == database)) break;
+  }
+  if (i < cache->size())
+  {
+    cache->move(i, 0);
+    stmt= cache->at(0).stmt;
+    if (stmt == NULL) return false;
+  }
+  else
+  {
+    stmt= lmysql->ldbms_mysql_stmt_init(&mysql[connection_number]);
+    if (stmt == NULL) return false;
+    if (dbms_executor_run(connection_number, DBMS_EXECUTOR_STMT_PREPARE, dbms_query, dbms_query_len, NULL, stmt) != 0)
     {
-      strcpy(unexpected_error, er_strings[er_off + ER_MYSQL_STORE_RESULT_FAILED]);
+      /* 1064 = ER_PARSE_ERROR e.g. ? where it's not allowed. Others e.g. no such table might not happen next time. */
+      unsigned int stmt_errno= lmysql->ldbms_mysql_stmt_errno(stmt);
+      lmysql->ldbms_mysql_stmt_close(stmt);
+      if (stmt_errno != 1064) return false;
+      stmt= NULL;
+    }
+    else if ((lmysql->ldbms_mysql_stmt_field_count(stmt) != 0)
+          || (lmysql->ldbms_mysql_stmt_param_count(stmt) != (unsigned long) parameters.size()))
+    {
+      lmysql->ldbms_mysql_stmt_close(stmt);
+      stmt= NULL;
     }
+    while ((cache->size() > 0) && (cache->size() >= (int) ocelot_prepared_statement_cache))
+    {
+      if (cache->last().stmt != NULL) lmysql->ldbms_mysql_stmt_close(cache->last().stmt);
+      cache->removeLast();
+    }
+    prepared_statement_cache_entry entry;
+    entry.query= query;
+    entry.database= database;
+    entry.stmt= stmt;
+    cache->prepend(entry);
+    if (stmt == NULL) return false;
   }
 
-  if (unexpected_error[0] == '\0')
+  /* The buffers must stay till mysql_stmt_execute() is over */
+  int parameter_count= parameters.size();
+  QVector<MYSQL_BIND> binds(parameter_count);
+  QVector<QByteArray> values(parameter_count);
+  QVector<unsigned long> lengths(parameter_count);
+  QVector<long long> integers(parameter_count);
+  QVector<double> doubles(parameter_count);
+  if (parameter_count > 0) memset(binds.data(), 0, parameter_count * sizeof(MYSQL_BIND));
+  for (int j= 0; j < parameter_count; ++j)
   {
-    row= lmysql->ldbms_mysql_fetch_row(debug_res);
-    if (row == NULL)
+    QString token= parameters.at(j);
+    MYSQL_BIND *bind= &binds[j];
+    bind->buffer_type= (enum_field_types) prepared_statement_literal_type(token);
+    if (bind->buffer_type == MYSQL_TYPE_LONGLONG)
     {
-      strcpy(unexpected_error, er_strings[er_off + ER_MYSQL_FETCH_ROW_FAILED]);
+      integers[j]= token.toLongLong();
+      bind->buffer= &integers[j];
+    }
+    else if (bind->buffer_type == MYSQL_TYPE_DOUBLE)
+    {
+      doubles[j]= token.toDouble();
+      bind->buffer= &doubles[j];
     }
     else
     {
-      if (lmysql->ldbms_mysql_num_fields(debug_res) < 14)
-      {
-        strcpy(unexpected_error, er_strings[er_off + ER_MYSQL_NUM_FIELDS]);
-      }
-      else
-      {
-        /* Just kludging -- I think something is overflowing. Todo: Find out what's really going on. */
-        memset(debuggee_information_status_debugger_name, 0, 32);
-        memset(debuggee_information_status_debugger_version, 0, 8);
-        memset(debuggee_information_status_timestamp_of_status_message, 0, 32);
-        memset(debuggee_information_status_number_of_status_message, 0, 8);
-        memset(debuggee_information_status_icc_count, 0, 8);
-        memset(debuggee_information_status_schema_identifier, 0, 256);
-        memset(debuggee_information_status_routine_identifier, 0, 256);
-        memset(debuggee_information_status_line_number, 0, 8);
-        memset(debuggee_information_status_is_at_breakpoint, 0, 8);
-        memset(debuggee_information_status_is_at_tbreakpoint, 0, 8);
-        memset(debuggee_information_status_is_at_routine_exit, 0, 8);
-        memset(debuggee_information_status_stack_depth, 0, 8);
-        memset(debuggee_information_status_last_command, 0, 256);
-        memset(debuggee_information_status_last_command_result, 0, 256);
-        memset(debuggee_information_status_commands_count, 0, 8);
-
-        if (row[0] != NULL) strncpy(debuggee_information_status_debugger_name, row[0], 32 - 1);
-        if (row[1] != NULL) strncpy(debuggee_information_status_debugger_version, row[1], 8 - 1);
-        if (row[2] != NULL) strncpy(debuggee_information_status_timestamp_of_status_message, row[2], 32 - 1);
-        if (row[3] != NULL) strncpy(debuggee_information_status_number_of_status_message, row[3], 8 - 1);
-        if (row[4] != NULL) strncpy(debuggee_information_status_icc_count, row[4], 8 - 1);
-        if (row[5] != NULL) strncpy(debuggee_information_status_schema_identifier, row[5], 256 - 1);
-        if (row[6] != NULL) strncpy(debuggee_information_status_routine_identifier, row[6], 256 - 1);
-        if (row[7] != NULL) strncpy(debuggee_information_status_line_number, row[7], 8 - 1);
-        if (row[8] != NULL) strncpy(debuggee_information_status_is_at_breakpoint, row[8], 8 - 1);
-        if (row[9] != NULL) strncpy(debuggee_information_status_is_at_tbreakpoint, row[9], 8 - 1);
-        if (row[10] != NULL) strncpy(debuggee_information_status_is_at_routine_exit, row[10], 8 - 1);
-        if (row[11] != NULL) strncpy(debuggee_information_status_stack_depth, row[11], 8 - 1);
-        if (row[12] != NULL) strncpy(debuggee_information_status_last_command, row[12], 256 - 1);
-        if (row[13] != NULL) strncpy(debuggee_information_status_last_command_result, row[13], 256 - 1);
-        if (row[14] != NULL) strncpy(debuggee_information_status_commands_count, row[14], 8 - 1);
-      }
+      if (bind->buffer_type == MYSQL_TYPE_STRING) token= token.mid(1, token.size() - 2).replace("''", "'");
+      values[j]= token.toUtf8();           /* See comment "UTF8 Conversion" */
+      lengths[j]= values[j].size();
+      bind->buffer= values[j].data();
+      bind->buffer_length= lengths[j];
+      bind->length= &lengths[j];
     }
   }
-
-  if (debug_res != NULL) lmysql->ldbms_mysql_free_result(debug_res);
-
-  if (unexpected_error[0] != '\0')
+  if ((parameter_count > 0) && (lmysql->ldbms_mysql_stmt_bind_param(stmt, binds.data()) != 0))
   {
-    if (strcmp(debuggee_information_status_last_command_result, unexpected_error) != 0)
-    {
-      /* This should be considered as a status change, as if it's a new i status message */
-      unexpected_new_error= 1;
-      strcpy(debuggee_information_status_last_command_result, unexpected_error);
-    }
+    lmysql->ldbms_mysql_stmt_close(stmt);
+    cache->removeFirst();
+    return false;
   }
 
-  //  printf("debuggee_information_status_debugger_name=%s.\n", debuggee_information_status_debugger_name);
-  //  printf("debuggee_information_status_debugger_version=%s.\n", debuggee_information_status_debugger_version);
-  //  printf("debuggee_information_status_timestamp_of_status_message=%s.\n", debuggee_information_status_timestamp_of_status_message);
-  //  printf("debuggee_information_status_number_of_status_message=%s.\n", debuggee_information_status_number_of_status_message);
-  //  printf("debuggee_information_status_icc_count=%s.\n", debuggee_information_status_icc_count);
-  //  printf("debuggee_information_status_schema_identifier=%s.\n", debuggee_information_status_schema_identifier);
-  //  printf("debuggee_information_status_routine_identifier=%s.\n", debuggee_information_status_routine_identifier);
-  //  printf("debuggee_information_status_line_number=%s.\n", debuggee_information_status_line_number);
-  //  printf("debuggee_information_status_is_at_breakpoint=%s.\n", debuggee_information_status_is_at_breakpoint);
-  //  printf("debuggee_information_status_is_at_tbreakpoint=%s.\n", debuggee_information_status_is_at_tbreakpoint);
-  //  printf("debuggee_information_status_is_at_routine_exit=%s.\n", debuggee_information_status_is_at_routine_exit);
-  //  printf("debuggee_information_status_stack_depth=%s.\n", debuggee_information_status_stack_depth);
-  //  printf("debuggee_information_status_last_command=%s.\n", debuggee_information_status_last_command);
-  //  printf("debuggee_information_status_last_command_result=%s.\n", debuggee_information_status_last_command_result);
-  //  printf("debuggee_information_status_commands_count=%s.\n", debuggee_information_status_commands_count);
-
-  /* If a status message would probably confuse a rational user, change it. */
-    if (strstr(debuggee_information_status_last_command_result, "completed CALL") != NULL)
-      strcpy(debuggee_information_status_last_command_result, "Routine has stopped. Suggested next step is: $EXIT");
-
-    if (strstr(debuggee_information_status_last_command_result, "Failed, the expected command is debug") != NULL)
-      strcpy(debuggee_information_status_last_command_result, "Routine has stopped and continuing past the end is not possible.  Suggested next step is: $EXIT");
-
+  statement_timing_mark(STATEMENT_TIMING_UTF8);
+  int result= dbms_executor_run(connection_number, DBMS_EXECUTOR_STMT_EXECUTE, NULL, 0, NULL, stmt);
+  statement_timing_mark(STATEMENT_TIMING_SERVER);
+  if (result == 0) return true;
   /*
-    When execution ends, we still have line number = 0 and "stopped at breakpoint".
-    That's misleading, but rather than change MDBug, let's override what it returns.
-    Also: last command isn't always updated if execution has ended.
+    Decide from the statement handle's own errno, the MYSQL handle's could
+    be left over from an earlier statement.
+    1243 = ER_UNKNOWN_STMT_HANDLER e.g. after RESET CONNECTION, and the
+    client errors that the library raises before it sends anything
+    (2014 CR_COMMANDS_OUT_OF_SYNC, 2030 CR_NO_PREPARE_STMT,
+    2031 CR_PARAMS_NOT_BOUND, 2036 CR_UNSUPPORTED_PARAM_TYPE,
+    2056 CR_STMT_CLOSED), mean the handle is no good and the statement
+    wasn't done, so close it and do the statement the ordinary way.
+    Any other client error e.g. 2006 CR_SERVER_GONE_ERROR or 2013
+    CR_SERVER_LOST might come after the server got the statement, and
+    sending it again could do the INSERT|UPDATE|DELETE twice, so close
+    the handle and put_diagnostics_in_result() reports the error.
+    Otherwise it's the server's error e.g. a duplicate key, we keep the
+    handle and put_diagnostics_in_result() reports the error.
   */
-  if (strcmp(debuggee_information_status_last_command_result, "debuggee_wait_loop ended") == 0)
+  unsigned int stmt_errno= lmysql->ldbms_mysql_stmt_errno(stmt);
+  if ((stmt_errno == 1243) || (stmt_errno == 2014) || (stmt_errno == 2030)
+   || (stmt_errno == 2031) || (stmt_errno == 2036) || (stmt_errno == 2056))
   {
-    strcpy(debuggee_information_status_line_number, "-1");
-    strcpy(debuggee_information_status_is_at_breakpoint, "no");
-    strcpy(debuggee_information_status_is_at_routine_exit, "yes");
-    strcpy(debuggee_information_status_last_command, debug_statement.toUtf8());
-    /* todo: what about debuggee_information_status_last_command_result? */
+    lmysql->ldbms_mysql_stmt_close(stmt);
+    cache->removeFirst();
+    return false;
   }
-
-  /*
-    Change line_edit i.e. status widget, and maybe change highlight, if there's a new message.
-    It would be extremely wasteful to update every time, i.e. every 1/10 second, if there's no change.
-    Apparently the change that you can depend on is icc_count, not commands_count or number_of_status_message.
-    I don't think there's any need to check whether line number + routine name have changed, but see below.
-  */
-  if ((debug_timer_old_commands_count != atoi(debuggee_information_status_commands_count))
-  ||  (debug_timer_old_number_of_status_message != atoi(debuggee_information_status_last_command))
-  ||  (debug_timer_old_icc_count != atoi(debuggee_information_status_icc_count))
-  ||  (debug_timer_old_line_number != atoi(debuggee_information_status_line_number))
-  ||  (unexpected_new_error == 1))
+  if (stmt_errno >= 2000)
   {
-    char result[2048];
+    lmysql->ldbms_mysql_stmt_close(stmt);
+    cache->removeFirst();
+  }
+  return true;
+}
 
-    strcpy(result, "Debugger status = ");
-    if (strcmp(debuggee_information_status_schema_identifier, "unknown") != 0)
+/*
+  We see "DELIMITER".
+  If the thing that follows is 'literal' or "literal" or `identifier`: that's the delimiter.
+  Otherwise delimiter is what follows as far as next whitespace or eof or ;
+  DELIMITER ; means "go back to the default i.e. ;".
+  This is called from hparse_f_client_statement() because it affects parse of later statements.
+  This is called from execute_client_statement() because DELIMITER is a client statement.
+  One difference from mysql client:
+    If mysql client sees "DELIMITER <return>" or "DELIMITER ''" it's an error.
+    But we consider that equivalent to "DELIMITER ;"
+  We return ";" if nothing follows or quoted blank string follows; mysql client would say error.
+*/
+QString MainWindow::get_delimiter(QString token, QString text, int offset)
+{
+  QString token_to_return;
+  if ((token.mid(0, 1) == "`") || (token.mid(0, 1) == "'") || (token.mid(0, 1) == "\""))
+  {
+    token_to_return= connect_stripper(token, false);
+  }
+  else
+  {
+    token_to_return= "";
+    for (int i= offset;; ++i)
     {
-      strcat(result, "(Current position: ");
-      strcat(result, debuggee_information_status_schema_identifier);
-      strcat(result, ".");
-      strcat(result, debuggee_information_status_routine_identifier);
-      strcat(result, " line ");
-      strcat(result, debuggee_information_status_line_number);
-      strcat(result, ")");
+      QString c= text.mid(i, 1);
+      if (c <= " ") break;
+      if (c == ";")
+      {
+        if (token_to_return == "") token_to_return= ";";
+        break;
+      }
+      token_to_return.append(c);
     }
-    strcat(result, "(Last debug command: ");
-    strcat(result, debuggee_information_status_last_command);
-    strcat(result, ", result: ");
-    strcat(result, debuggee_information_status_last_command_result);
-    strcat(result, ")");
+  }
+  return token_to_return;
+}
 
-    if (strcmp(debuggee_information_status_is_at_breakpoint, "yes") == 0)
+
+/*
+  SOURCE script runner.
+  The old way was to put each line of the file in statement_edit_widget
+  and call action_execute(), so every line caused tokenize(), highlighting
+  and hparse_f_multi_block() of the editor, which made replaying a dump
+  far slower than the server. Now source_run() reads the file in big
+  chunks, source_scan() splits it into statements (looking only at bytes,
+  since quotes, comments, newlines and delimiters are ASCII and can't be
+  inside a UTF-8 multi-byte character), and each statement goes directly
+  to the connection's executor. The editor and history aren't touched,
+  except that client statements (USE, SOURCE, SET OCELOT_..., \x, $x etc.)
+  still go through action_execute() because only it knows how to do them,
+  and so do statements that return result sets (SELECT, SHOW, CALL etc.),
+  see source_is_result_set(), so that the user sees the result sets.
+  DELIMITER is handled here, at the start of a statement, as the mysql
+  client does. Comments before a statement are not sent, but comments
+  that start with slash-star-! or slash-star-M-! are statements, as in
+  mysqldump output. Tarantool statements also go through action_execute().
+  The result is a one-line summary with the first error, if any.
+*/
+#define SOURCE_READ_SIZE (1024 * 1024)
+#define SOURCE_PROGRESS_MS 500
+struct source_scanner
+{
+  QByteArray buffer;                  /* bytes read from the file but not yet consumed */
+  int scan_offset;                    /* where source_scan() continues */
+  int statement_offset;               /* where the current statement starts, maybe with white space */
+  int statement_text_offset;          /* first byte of the current statement that isn't white space or comment */
+  bool is_statement_started;          /* statement_text_offset is set */
+  char quote;                         /* ' or " or ` if inside a quoted string */
+  char comment;                       /* - or # if inside a comment that ends with \n, * if inside a slash-star comment */
+  QByteArray delimiter;
+  unsigned long line_number;          /* line number at scan_offset */
+  unsigned long statement_line_number;
+};
+
+static bool source_is_blank(char c)
+{
+  return ((c == ' ') || (c == '\t') || (c == '\r') || (c == '\n') || (c == '\f') || (c == '\v'));
+}
+
+/*
+  Find the next statement in sc->buffer. If there is one, return true with
+  *offset and *length saying where it is (without delimiter and trailing
+  white space), and sc->statement_offset past it.
+  If is_eof == false we stop when we need to look ahead past the end of
+  the buffer, and return false, so the caller can read more and call again.
+  If is_eof == true an unfinished statement at the end is a statement.
+*/
+static bool source_scan(source_scanner *sc, bool is_eof, int *offset, int *length)
+{
+  const char *p= sc->buffer.constData();
+  int size= sc->buffer.size();
+  int i= sc->scan_offset;
+  for (;;)
+  {
+    int delimiter_length= sc->delimiter.size();
+    int lookahead= (sc->is_statement_started == true) ? 3 : 10; /* 10 for "DELIMITER " */
+    if (delimiter_length > lookahead) lookahead= delimiter_length;
+    if ((is_eof == false) && (i + lookahead >= size)) break;
+    if (i >= size) break;
+    char c= p[i];
+    if (sc->comment != 0)
     {
-      strcat(result, "(STOPPED AT BREAKPOINT)");
+      if (c == '\n')
+      {
+        ++sc->line_number;
+        if (sc->comment != '*') sc->comment= 0;
+      }
+      else if ((sc->comment == '*') && (c == '*') && (i + 1 < size) && (p[i + 1] == '/'))
+      {
+        sc->comment= 0;
+        ++i;
+      }
+      ++i;
+      continue;
     }
-
-    if (strcmp(debuggee_information_status_is_at_routine_exit, "yes") == 0)
+    if (sc->quote != 0)
     {
-      strcat(result, "(STOPPED AT ROUTINE EXIT)");
+      if (c == '\n') ++sc->line_number;
+      else if ((c == '\\') && (sc->quote != '`') && (i + 1 < size))
+      {
+        if (p[i + 1] == '\n') ++sc->line_number;
+        ++i;
+      }
+      else if (c == sc->quote) sc->quote= 0;
+      ++i;
+      continue;
     }
-
-    debug_line_widget->setText(result);
-
-    /*
-      If and only if the line number or routine name or schema name has changed,
-      highlight i.e. change background color in order to show where we're at now.
-      Formerly this checked "if (strcmp(debuggee_information_status_is_at_breakpoint, "yes") == 0)"
-      i.e. are we at a breakpoint, but I no longer see why that matters.
-      Besides, '$breakpoint' does not move the position.
-    */
-    if ((debug_timer_old_line_number != atoi(debuggee_information_status_line_number))
-     || (strcmp(debug_timer_old_schema_identifier, debuggee_information_status_schema_identifier) == 0)
-     || (strcmp(debug_timer_old_routine_identifier, debuggee_information_status_routine_identifier) == 0))
+    if (source_is_blank(c))
+    {
+      if (c == '\n') ++sc->line_number;
+      ++i;
+      continue;
+    }
+    if ((c == '#')
+     || ((c == '-') && (i + 1 < size) && (p[i + 1] == '-')
+      && ((i + 2 == size) || (source_is_blank(p[i + 2])))))
+    {
+      sc->comment= '-';
+      ++i;
+      continue;
+    }
+    if ((c == '/') && (i + 1 < size) && (p[i + 1] == '*'))
     {
-      debug_highlight_line();
-      debug_timer_old_line_number= atoi(debuggee_information_status_line_number);
-      strcpy(debug_timer_old_schema_identifier, debuggee_information_status_schema_identifier);
-      strcpy(debug_timer_old_routine_identifier, debuggee_information_status_routine_identifier);
+      bool is_executable= (((i + 2 < size) && (p[i + 2] == '!'))
+                        || ((i + 3 < size) && (p[i + 2] == 'M') && (p[i + 3] == '!')));
+      if ((sc->is_statement_started == false) && (is_executable == true))
+      {
+        sc->is_statement_started= true;
+        sc->statement_text_offset= i;
+        sc->statement_line_number= sc->line_number;
+      }
+      sc->comment= '*';
+      i+= 2;
+      continue;
     }
-    debug_timer_old_commands_count= atoi(debuggee_information_status_commands_count);
-    debug_timer_old_number_of_status_message= atoi(debuggee_information_status_last_command);
-    debug_timer_old_icc_count= atoi(debuggee_information_status_icc_count);
+    if (sc->is_statement_started == false)
+    {
+      /* DELIMITER x or \d x, as the first thing in a statement, goes till end of line. */
+      int keyword_length= 0;
+      if ((i + 10 <= size) && (qstrnicmp(p + i, "DELIMITER", 9) == 0) && (source_is_blank(p[i + 9]))) keyword_length= 9;
+      else if ((i + 3 <= size) && (p[i] == '\\') && (p[i + 1] == 'd') && (source_is_blank(p[i + 2]))) keyword_length= 2;
+      if (keyword_length != 0)
+      {
+        int line_end= sc->buffer.indexOf('\n', i);
+        if (line_end == -1)
+        {
+          if (is_eof == false) break;
+          line_end= size;
+        }
+        int j= i + keyword_length;
+        while ((j < line_end) && (source_is_blank(p[j]))) ++j;
+        int k= j;
+        while ((k < line_end) && (source_is_blank(p[k]) == false)) ++k;
+        if (k > j) sc->delimiter= QByteArray(p + j, k - j);
+        i= line_end;
+        sc->statement_offset= i;
+        continue;
+      }
+      sc->is_statement_started= true;
+      sc->statement_text_offset= i;
+      sc->statement_line_number= sc->line_number;
+    }
+    if ((c == sc->delimiter.at(0))
+     && (i + delimiter_length <= size)
+     && (memcmp(p + i, sc->delimiter.constData(), delimiter_length) == 0))
+    {
+      int end= i;
+      sc->statement_offset= i + delimiter_length;
+      sc->scan_offset= sc->statement_offset;
+      if (sc->is_statement_started == false) { i= sc->scan_offset; continue; }
+      sc->is_statement_started= false;
+      while ((end > sc->statement_text_offset) && (source_is_blank(p[end - 1]))) --end;
+      if (end == sc->statement_text_offset) { i= sc->scan_offset; continue; }
+      *offset= sc->statement_text_offset;
+      *length= end - sc->statement_text_offset;
+      return true;
+    }
+    if ((c == '\'') || (c == '"') || (c == '`')) sc->quote= c;
+    ++i;
+  }
+  sc->scan_offset= i;
+  if ((is_eof == true) && (i >= size) && (sc->is_statement_started == true))
+  {
+    int end= size;
+    sc->is_statement_started= false;
+    sc->statement_offset= size;
+    while ((end > sc->statement_text_offset) && (source_is_blank(p[end - 1]))) --end;
+    if (end == sc->statement_text_offset) return false;
+    *offset= sc->statement_text_offset;
+    *length= end - sc->statement_text_offset;
+    return true;
   }
+  return false;
 }
-#endif
 
+/*
+  Is a statement that source_scan() found something that only the client can do?
+  Compare is_client_statement(), which needs main_token_* which we don't have.
+*/
+bool MainWindow::source_is_client_statement(const char *statement, int length)
+{
+  if ((statement[0] == '\\') || (statement[0] == '$') || (statement[0] == '?')) return true;
+  int word_length= 0;
+  while ((word_length < length) && (word_length < 64)
+      && (((statement[word_length] >= 'A') && (statement[word_length] <= 'Z'))
+       || ((statement[word_length] >= 'a') && (statement[word_length] <= 'z'))
+       || (statement[word_length] == '_')))
+    ++word_length;
+  if (word_length == 0) return false;
+  QString word= QString::fromLatin1(statement, word_length);
+  int t= token_type(word.data(), word_length);
+  if (t == TOKEN_KEYWORD_SET)
+  {
+    int i= word_length;
+    while ((i < length) && (source_is_blank(statement[i]))) ++i;
+    return ((i + 7 <= length) && (qstrnicmp(statement + i, "OCELOT_", 7) == 0));
+  }
+  return is_client_statement(t, 0, word);
+}
 
 /*
-  For menu item "Execute|Kill" we must start another thread,
-  which connects and issues a Kill query-id.
-  The kill thread has a subset of the actions of the debug thread so see also debug_thread.
-  Possible variant: keep it alive and use it for monitoring.
+  Batching, if ocelot_source_batch_size > 1.
+  Consecutive statements that source_is_batchable() are joined with ";\n"
+  and sent as one multi-statement query, after mysql_set_server_option()
+  turns on MYSQL_OPTION_MULTI_STATEMENTS for the duration of source_run(),
+  so there's one round trip per batch instead of one per statement.
+  A batch ends after ocelot_source_batch_size statements or
+  SOURCE_BATCH_MAX_BYTES bytes (so it's smaller than max_allowed_packet
+  unless one statement is big), or when a statement can't be batched.
+  Only while the delimiter is ; because with another delimiter a
+  statement could contain ; e.g. in a routine body.
+  Each statement in a batch has one result, so source_batch_flush() can
+  count the results to know which statement failed, and report its line.
+  The server doesn't execute the statements after an error, so they're
+  sent again as a new batch, as if there'd been no batching.
 */
-void* kill_thread(void* unused)
+#define SOURCE_BATCH_MAX_BYTES (1024 * 1024)
+/* The ; is on a line of its own, in case a statement ends with -- comment or # comment */
+#define SOURCE_BATCH_SEPARATOR "\n;\n"
+#define SOURCE_BATCH_SEPARATOR_LENGTH (sizeof(SOURCE_BATCH_SEPARATOR) - 1)
+struct source_state
 {
-  (void) unused; /* suppress "unused parameter" warning */
-  char call_statement[512];
-  int is_connected;
+  unsigned long statement_count;
+  unsigned long error_count;
+  unsigned long warning_count;
+  unsigned long first_error_line_number;  /* 0 if no error yet */
+  QString first_error;
+  QByteArray batch;                       /* statements joined with SOURCE_BATCH_SEPARATOR */
+  QList<int> batch_lengths;
+  QList<unsigned long> batch_line_numbers;
+  QString saved_query_utf16;              /* the SOURCE statement, for history */
+  QString saved_query_utf16_copy;
+  qint64 start_time;
+  qint64 progress_time;                   /* when progress was last shown */
+  bool is_progress_shown;
+};
+
+/* Statements that start with these words are DML or DDL that won't return a result set. */
+static const char *source_batchable_words[]=
+{
+  "ALTER", "COMMIT", "CREATE", "DELETE", "DROP", "INSERT", "LOCK", "RENAME",
+  "REPLACE", "SET", "START", "TRUNCATE", "UNLOCK", "UPDATE", 0
+};
 
-  is_connected= 0;
-  kill_state= KILL_STATE_CONNECT_THREAD_STARTED;
-  for (;;)
+static bool source_is_batchable(const char *statement, int length)
+{
+  for (int i= 0; source_batchable_words[i] != 0; ++i)
   {
-    if (options_and_connect(MYSQL_KILL_CONNECTION))
-    {
-      kill_state= KILL_STATE_CONNECT_FAILED;
-      break;
-    }
-    is_connected= 1;
-    kill_state= KILL_STATE_IS_CONNECTED;
-    sprintf(call_statement, "kill query %d", kill_connection_id);
-    if (lmysql->ldbms_mysql_real_query(&mysql[MYSQL_KILL_CONNECTION], call_statement, strlen(call_statement)))
-    {
-      kill_state= KILL_STATE_MYSQL_REAL_QUERY_ERROR;
-      break;
-    }
-    kill_state= KILL_STATE_ENDED;
-    break;
+    int word_length= strlen(source_batchable_words[i]);
+    if ((length > word_length)
+     && (qstrnicmp(statement, source_batchable_words[i], word_length) == 0)
+     && (source_is_blank(statement[word_length])))
+      return true;
   }
-  if (is_connected == 1) lmysql->ldbms_mysql_close(&mysql[MYSQL_KILL_CONNECTION]);
-  lmysql->ldbms_mysql_thread_end();
-  return ((void*) NULL);
+  return false;
 }
 
-bool is_kill_requested;
-
 /*
-  Todo: This is no good if the running query isn't
-  on the main connection.
+  Statements that start with these words, or with (, return result sets.
+  They go through source_by_editor() so the result sets are shown in the
+  grid, as they were before there was source_run(), instead of being
+  thrown away.
 */
-void MainWindow::action_kill()
+static const char *source_result_set_words[]=
 {
-  pthread_t thread_id;
+  "ANALYZE", "CALL", "CHECK", "CHECKSUM", "DESC", "DESCRIBE", "EXPLAIN", "HELP",
+  "OPTIMIZE", "REPAIR", "SELECT", "SHOW", "TABLE", "VALUES", "WITH", 0
+};
 
-  if (connections_is_connected[0] != 1) return; /* impossible */
-  is_kill_requested= true;
-  if (dbms_long_query_state == LONG_QUERY_STATE_STARTED)
+static bool source_is_result_set(const char *statement, int length)
+{
+  if ((length > 0) && (statement[0] == '(')) return true;
+  for (int i= 0; source_result_set_words[i] != 0; ++i)
   {
-    kill_connection_id= statement_edit_widget->dbms_connection_id;
-    pthread_create(&thread_id, NULL, &kill_thread, NULL);
-    /* no pthread_join here -- what would be the point of waiting? */
+    int word_length= strlen(source_result_set_words[i]);
+    if ((length > word_length)
+     && (qstrnicmp(statement, source_result_set_words[i], word_length) == 0)
+     && ((source_is_blank(statement[word_length])) || (statement[word_length] == '(')))
+      return true;
   }
+  return false;
+}
+
+/* Count an error on the main connection, and remember it if it's the first. */
+void MainWindow::source_error(source_state *st, unsigned long line_number)
+{
+  ++st->error_count;
+  if (st->first_error_line_number != 0) return;
+  char error_and_state[50];
+  st->first_error_line_number= line_number;
+  sprintf(error_and_state, "%d (%s) ",
+          lmysql->ldbms_mysql_errno(&mysql[MYSQL_MAIN_CONNECTION]),
+          lmysql->ldbms_mysql_sqlstate(&mysql[MYSQL_MAIN_CONNECTION]));
+  st->first_error= error_and_state;
+  st->first_error.append(QString::fromUtf8(lmysql->ldbms_mysql_error(&mysql[MYSQL_MAIN_CONNECTION])));
 }
 
 /*
-  Implementing ^C i.e. control-C i.e. menu item Run|Kill ...
-  Once an SQL statement or SQL statement series has been accepted, user input
-  is restricted to "kill" (a few other events are tolerated but not ones that cause statements),
-  so around the loop inside action_execute() there is some enabling and disabling.
-  SQL statements are done in a separate thread, dbms_long_query();
-  in the main thread there is a wait-loop which stops when the thread ends;
-  the wait-loop includes QApplication::ProcessEvents() so a "Kill" will be seen.
-  "Kill" causes the SQL statement to end (if there's one running).
-  ^C is an appropriate shortcut although it usually means "clip".
-  Kill sets a flag so that if there are multiple statements, they are all aborted.
-  dbms_long_query is only for potentially-slow SQL statements that might need to be killed.
-  Todo: this could be done via a permanently-existing thread or pool of threads.
-  Todo: QThread is more portable than pthread, although it looks harder to understand.
-  Todo: put this together with the dbms_* routines in ocelotgui.h in a separate class.
-  Normally dbms_query_connection_number is for the main connection.
+  One statement that isn't batched, and isn't source_is_result_set(). Returns 0 if ok.
+  The executor stores the result too, so the GUI thread never waits for rows.
 */
-void* dbms_long_query_thread(void* unused)
+int MainWindow::source_query(source_state *st, const char *statement, int length, unsigned long line_number)
 {
-  (void) unused; /* suppress "unused parameter" warning */
+  MYSQL_RES *res;
+  int result= dbms_executor_run(MYSQL_MAIN_CONNECTION, DBMS_EXECUTOR_REAL_QUERY, statement, length, &res);
+  if (result == 0)
+  {
+    /* Throw away unexpected result sets, to avoid out-of-sync. */
+    for (;;)
+    {
+      if (res != NULL) lmysql->ldbms_mysql_free_result(res);
+      st->warning_count+= lmysql->ldbms_mysql_warning_count(&mysql[MYSQL_MAIN_CONNECTION]);
+      if (lmysql->ldbms_mysql_more_results(&mysql[MYSQL_MAIN_CONNECTION]) == 0) break;
+      result= dbms_executor_run(MYSQL_MAIN_CONNECTION, DBMS_EXECUTOR_NEXT_RESULT, NULL, 0, &res);
+      if (result != 0)
+      {
+        if (result == -1) result= 0;
+        break;
+      }
+    }
+  }
+  if (result != 0) source_error(st, line_number);
+  return result;
+}
 
-  dbms_long_query_result= lmysql->ldbms_mysql_real_query(&mysql[dbms_query_connection_number], dbms_query, dbms_query_len);
-  dbms_long_query_state= LONG_QUERY_STATE_ENDED;
-  return ((void*) NULL);
+/* Send what's in st->batch, see the comment for batching. Returns 0 if there was no error. */
+int MainWindow::source_batch_flush(source_state *st)
+{
+  int return_value= 0;
+  int batch_count= st->batch_lengths.size();
+  int first= 0, first_offset= 0;       /* the first statement that hasn't been done */
+  while (first < batch_count)
+  {
+    int k= first, offset= first_offset;
+    MYSQL_RES *res= NULL;
+    int result= dbms_executor_run(MYSQL_MAIN_CONNECTION, DBMS_EXECUTOR_REAL_QUERY,
+                                  st->batch.constData() + first_offset,
+                                  st->batch.size() - first_offset, NULL);
+    if (result == 0) res= lmysql->ldbms_mysql_store_result(&mysql[MYSQL_MAIN_CONNECTION]);
+    while (result == 0)
+    {
+      /* Statement k is done */
+      if (res != NULL) lmysql->ldbms_mysql_free_result(res);
+      st->warning_count+= lmysql->ldbms_mysql_warning_count(&mysql[MYSQL_MAIN_CONNECTION]);
+      offset+= st->batch_lengths[k] + SOURCE_BATCH_SEPARATOR_LENGTH;
+      ++k;
+      if (lmysql->ldbms_mysql_more_results(&mysql[MYSQL_MAIN_CONNECTION]) == 0) break;
+      result= dbms_executor_run(MYSQL_MAIN_CONNECTION, DBMS_EXECUTOR_NEXT_RESULT, NULL, 0, &res);
+    }
+    if ((result != 0) && (result != -1) && (k < batch_count))
+    {
+      /* Statement k failed, the ones after it weren't done */
+      source_error(st, st->batch_line_numbers[k]);
+      return_value= 1;
+      offset+= st->batch_lengths[k] + SOURCE_BATCH_SEPARATOR_LENGTH;
+      ++k;
+      if ((ocelot_abort_source_on_error > 0) || (is_kill_requested == true)) break;
+    }
+    if (k == first) break;             /* no progress, which shouldn't happen */
+    first= k;
+    first_offset= offset;
+  }
+  st->batch.clear();
+  st->batch_lengths.clear();
+  st->batch_line_numbers.clear();
+  return return_value;
 }
 
-/* Todo: This assumes connection_number must be MYSQL_MAIN_CONNECTION */
-void* dbms_long_next_result_thread(void* unused)
+/* Start scanning with the current delimiter. */
+static void source_scanner_start(source_scanner *sc, QByteArray delimiter)
 {
-  (void) unused; /* suppress "unused parameter" warning */
+  sc->scan_offset= sc->statement_offset= sc->statement_text_offset= 0;
+  sc->is_statement_started= false;
+  sc->quote= sc->comment= 0;
+  sc->delimiter= delimiter;
+  if (sc->delimiter.size() == 0) sc->delimiter= ";";
+  sc->line_number= sc->statement_line_number= 1;
+}
 
-  dbms_long_query_result= lmysql->ldbms_mysql_next_result(&mysql[MYSQL_MAIN_CONNECTION]);
-  dbms_long_query_state= LONG_QUERY_STATE_ENDED;
-  return ((void*) NULL);
+/* After source_scan() returns false: drop what's been consumed, read more. Returns false at end of file. */
+static bool source_scanner_read(source_scanner *sc, QFile *file)
+{
+  sc->buffer.remove(0, sc->statement_offset);
+  sc->scan_offset-= sc->statement_offset;
+  sc->statement_text_offset-= sc->statement_offset;
+  sc->statement_offset= 0;
+  QByteArray chunk= file->read(SOURCE_READ_SIZE);
+  if (chunk.size() == 0) return false;
+  sc->buffer.append(chunk);
+  return true;
 }
 
-void MainWindow::action_execute_force()
+/* Show progress in the status bar, at most every SOURCE_PROGRESS_MS. */
+void MainWindow::source_progress(source_state *st, QFile *file)
 {
-  action_execute(1);
+  if (is_headless == true) return;
+  if ((st->statement_count % 100) != 0) return;
+  qint64 now= QDateTime::currentMSecsSinceEpoch();
+  if (now - st->progress_time < SOURCE_PROGRESS_MS) return;
+  char progress[ER_MAX_LENGTH];
+  sprintf(progress, er_strings[er_off + ER_SOURCE_SUMMARY], st->statement_count, st->error_count, st->warning_count);
+  QString s= "SOURCE";
+  s.append(progress);
+  qint64 file_size= file->size();
+  if (file_size > 0) s.append(" (" + QString::number((file->pos() * 100) / file_size) + "%)");
+  statusBar()->show();
+  statusBar()->showMessage(s);
+  st->is_progress_shown= true;
+  st->progress_time= now;
 }
 
-/*
-  For menu item "execute" we said (...SLOT(action_execute(1))));
-  By default this is on and associated with File|Execute menu item.
-  Execute what's in the statement widget.
-  The statement widget might contain multiple statements.
-  Return: 0 = ok, 1 = syntax checker failed with "No"; 2 = DBMS error
-*/
-int MainWindow::action_execute(int force)
+/* The end of source_run() or source_parallel_run(). */
+void MainWindow::source_end(source_state *st, source_scanner *sc)
 {
-  QString text;
-  int return_value= 0;
-  for (;;)
+  if (st->is_progress_shown == true)
   {
-    int returned_begin_count;
-    main_token_number= 0;
-    text= statement_edit_widget->toPlainText(); /* or I could just pass this to tokenize() directly */
+    statusBar()->clearMessage();
+    statusBar()->hide();
+  }
+  /*
+    DELIMITER in the file stays in effect, as with the mysql client.
+    Always, because source_by_editor() may have left ocelot_delimiter_str
+    as it was for a client statement, even if the file ends with the
+    delimiter it started with.
+  */
+  ocelot_delimiter_str= QString::fromUtf8(sc->delimiter.constData(), sc->delimiter.size());
+  query_utf16= st->saved_query_utf16;
+  query_utf16_copy= st->saved_query_utf16_copy;
+  statement_edit_widget->start_time= st->start_time;
+
+  char summary[ER_MAX_LENGTH];
+  char elapsed_time_string[50];
+  qint64 elapsed_time= QDateTime::currentMSecsSinceEpoch() - st->start_time;
+  sprintf(elapsed_time_string, " (%.1f seconds)", (float) elapsed_time / 1000);
+  sprintf(summary, er_strings[er_off + ER_SOURCE_SUMMARY], st->statement_count, st->error_count, st->warning_count);
+  QString s= er_strings[er_off + ((st->error_count == 0) ? ER_OK : ER_ERROR)];
+  s.append(summary);
+  s.append(elapsed_time_string);
+  if (st->first_error_line_number != 0)
+  {
+    char first_error_line[ER_MAX_LENGTH];
+    sprintf(first_error_line, er_strings[er_off + ER_SOURCE_FIRST_ERROR], st->first_error_line_number);
+    s.append(first_error_line);
+    s.append(st->first_error);
+  }
+  put_message_in_result(s);
+}
 
-    main_token_count_in_statement= get_next_statement_in_string(main_token_number,
-                                                                &returned_begin_count,
-                                                                true);
-    if (main_token_count_in_statement == 0) break;
+/* Do a client statement, or one that returns result sets, the old way, via the statement widget. Returns 0 if ok. */
+int MainWindow::source_by_editor(source_state *st, source_scanner *sc, const char *statement, int length)
+{
+  /* The editor's delimiter must be the same as ours, DELIMITER is just for the scanner. */
+  ocelot_delimiter_str= QString::fromUtf8(sc->delimiter.constData(), sc->delimiter.size());
+  statement_edit_widget->insertPlainText(QString::fromUtf8(statement, length));
+  if (action_execute(1) != 2) return 0;
+  ++st->error_count;
+  if ((st->first_error_line_number == 0) || (sc->statement_line_number < st->first_error_line_number))
+  {
+    st->first_error_line_number= sc->statement_line_number;
+    st->first_error= statement_edit_widget->result;
+  }
+  return 1;
+}
 
-    /* If the next statement is unfinished, we usually want to ignore it. */
-    if ((force == 0) && (is_statement_complete(text) == false)) return 1;
+/*
+  Run the statements in file. Called for SOURCE from execute_client_statement(),
+  which has opened the file. Returns 2 if a statement failed, else 1.
+*/
+int MainWindow::source_run(QFile *file)
+{
+  source_scanner sc;
+  QByteArray initial_delimiter= ocelot_delimiter_str.toUtf8();
+  source_scanner_start(&sc, initial_delimiter);
+
+  source_state st;
+  st.statement_count= st.error_count= st.warning_count= 0;
+  st.first_error_line_number= 0;
+  st.saved_query_utf16= query_utf16;
+  st.saved_query_utf16_copy= query_utf16_copy;
+  st.start_time= statement_edit_widget->start_time;
+  st.progress_time= QDateTime::currentMSecsSinceEpoch();
+  st.is_progress_shown= false;
+  bool is_eof= false;
+
+  bool is_batching= ((ocelot_source_batch_size > 1) && (connections_is_connected[0] != 0));
+#ifdef DBMS_TARANTOOL
+  if (connections_dbms[0] == DBMS_TARANTOOL) is_batching= false;
+#endif
+  if (is_batching == true)
+    is_batching= (lmysql->ldbms_mysql_set_server_option(&mysql[MYSQL_MAIN_CONNECTION], MYSQL_OPTION_MULTI_STATEMENTS_ON) == 0);
 
-    /*
-      We probably call hparse_f_multi_block continuously during statement edit,
-      but this redundancy is harmless (we're not short of time, eh?).
-      This checks for errors in the whole string, not just the first statement.
-    */
-    if (((ocelot_statement_syntax_checker.toInt()) & FLAG_FOR_ERRORS) != 0)
+  for (;;)
+  {
+    int offset, length;
+    if (source_scan(&sc, is_eof, &offset, &length) == false)
     {
-      hparse_f_multi_block(text);
-      if (hparse_errno != 0)
+      if (is_eof == true) break;
+      is_eof= (source_scanner_read(&sc, file) == false);
+      continue;
+    }
+    const char *statement= sc.buffer.constData() + offset;
+    ++st.statement_count;
+    int result;
+    bool is_by_editor= ((source_is_client_statement(statement, length))
+                     || (source_is_result_set(statement, length)));
+#ifdef DBMS_TARANTOOL
+    if (connections_dbms[0] == DBMS_TARANTOOL) is_by_editor= true;
+#endif
+    if ((is_batching == true)
+     && (is_by_editor == false)
+     && (sc.delimiter == ";")
+     && (source_is_batchable(statement, length) == true))
+    {
+      if ((st.batch.size() != 0) && (st.batch.size() + length + (int) SOURCE_BATCH_SEPARATOR_LENGTH > SOURCE_BATCH_MAX_BYTES))
+        result= source_batch_flush(&st);
+      else result= 0;
+      st.batch.append(statement, length);
+      st.batch.append(SOURCE_BATCH_SEPARATOR);
+      st.batch_lengths.append(length);
+      st.batch_line_numbers.append(sc.statement_line_number);
+      if ((result == 0) && (st.batch_lengths.size() >= (int) ocelot_source_batch_size))
+        result= source_batch_flush(&st);
+    }
+    else
+    {
+      result= 0;
+      if (st.batch.size() != 0) result= source_batch_flush(&st);
+      if ((result != 0) && (ocelot_abort_source_on_error > 0)) break;
+      if (is_kill_requested == true) break;
+      if (is_by_editor) result= source_by_editor(&st, &sc, statement, length);
+      else if (connections_is_connected[0] == 0)
       {
-        QString s;
-        QMessageBox msgbox;
-        s= er_strings[er_off + ER_THE_SYNTAX_CHECKER_THINKS];
-        s.append(hparse_errmsg);
-        msgbox.setText(s);
-        msgbox.setInformativeText(er_strings[er_off + ER_DO_YOU_WANT_TO_CONTINUE]);
-        //msgbox.setStandardButtons(QMessageBox::Yes | QMessageBox::No);
-        //msgbox.setDefaultButton(QMessageBox::Yes);
-        //if (msgbox.exec() == no_button) return 1;
-        QPushButton *yes_button= msgbox.addButton(er_strings[er_off + ER_YES], QMessageBox::YesRole);
-        QPushButton *no_button= msgbox.addButton(er_strings[er_off + ER_NO], QMessageBox::NoRole);
-        msgbox.setDefaultButton(yes_button);
-        msgbox.exec();
-        if (msgbox.clickedButton() == no_button) return 1;
+        ++st.error_count;
+        st.first_error_line_number= sc.statement_line_number;
+        st.first_error= er_strings[er_off + ER_NOT_CONNECTED];
+        break;
       }
+      else result= source_query(&st, statement, length, sc.statement_line_number);
     }
-
-    /* While executing, we allow no more statements, but a few things are enabled. */
-    /* This makes the menu seem to blink. If that's not OK, turn off sub-items not main menu items. */
-    menu_file->setEnabled(false);
-    menu_edit->setEnabled(false);
-    menu_run_action_execute->setEnabled(false);
-    if (ocelot_sigint_ignore == 0) menu_run_action_kill->setEnabled(true);
-    menu_settings->setEnabled(false);
-    menu_debug->setEnabled(false);
-    menu_help->setEnabled(false);
-    statement_edit_widget->setReadOnly(true);
-    is_kill_requested= false;
-    return_value= action_execute_one_statement(text);
-
-    menu_file->setEnabled(true);
-    menu_edit->setEnabled(true);
-    menu_run_action_execute->setEnabled(true);
-    menu_run_action_kill->setEnabled(false);
-    menu_settings->setEnabled(true);
-    menu_debug->setEnabled(true);
-    menu_help->setEnabled(true);
-    statement_edit_widget->setReadOnly(false);
-    /*
-      In remove_statement there is a removeSelectedText() call, which
-      causes action_statement_edit_widget_text_changed() -- twice.
-      We only want it to happen once, so we'll control it ourselves.
-      Importantly, it will call tokenize() and hparse_f_multi_block()
-      so main_token_... variables will all change.
-      Todo: check again, I think the above statement might be false.
-    */
-    statement_edit_widget_text_changed_flag= 1;
-    remove_statement(text);
-    statement_edit_widget_text_changed_flag= 0;
-    action_statement_edit_widget_text_changed();
-    //widget_sizer();
-    /* Try to set history cursor at end so last line is visible. Todo: Make sure this is the right time to do it. */
-    history_edit_widget->verticalScrollBar()->setValue(history_edit_widget->verticalScrollBar()->maximum());
-    history_edit_widget->show(); /* Todo: find out if this is really necessary */
+    if ((result != 0) && (ocelot_abort_source_on_error > 0)) break;
     if (is_kill_requested == true) break;
+    source_progress(&st, file);
   }
-  if (return_value != 0) return 2;
-  return 0;
+  if ((st.batch.size() != 0) && (is_kill_requested == false)
+   && ((st.error_count == 0) || (ocelot_abort_source_on_error == 0)))
+    source_batch_flush(&st);
+  if (is_batching == true)
+    lmysql->ldbms_mysql_set_server_option(&mysql[MYSQL_MAIN_CONNECTION], MYSQL_OPTION_MULTI_STATEMENTS_OFF);
+
+  source_end(&st, &sc);
+  if (st.error_count != 0) return 2;
+  return 1;
 }
 
 /*
-  Remove the first statement in statement_edit_widget,
-  including any whitespace after the statement end.
-  This is equivalent to statement_edit_widget->clear() if there is only one statement.
-  But when a user has cut-and-pasted several statements, we execute one at a time.
-  There are other ways to do this e.g. clear() followed by insertText().
-  Unanswered question: do we want to clear undo/redo history?
-  Unanswered question: do we want to clear selection?
-  Unanswered question: do we want to move the visible cursor?
+  SOURCE PARALLEL n file
+  For a dump of several tables: n worker threads, each with its own
+  connection (MYSQL_SOURCE_PARALLEL_CONNECTION + worker number) and its
+  own queue. The main thread reads and splits the file as source_run()
+  does, and puts each statement in one queue, or all of them:
+  * SET, USE, UNLOCK TABLES affect the session, so they go to every queue.
+  * A transaction must stay on one connection, so from BEGIN or
+    START TRANSACTION or SET autocommit=0 we wait till all queues are
+    empty, then everything goes to queue 0 until COMMIT or ROLLBACK
+    (or SET autocommit=1), and we wait again. So a dump that's made
+    with --no-autocommit won't be parallel, but it will be right.
+  * If the statement is for one table, e.g. INSERT INTO t, see
+    source_parallel_table(), the table name's hash picks the queue, so
+    statements for the same table are done in the same order as in the file.
+  * Otherwise, e.g. CREATE DATABASE, we wait till all queues are empty,
+    the statement goes to queue 0, and we wait again.
+  * Client statements, and statements that return result sets, wait
+    till all queues are empty, then go through the statement widget
+    on the main connection, as in source_run().
+  A queue stops accepting at SOURCE_PARALLEL_QUEUE_BYTES, so for a
+  dump in table order the main thread can only get ahead by that much
+  per table. There's no batching, and errors are counted as each worker
+  finds them; the summary says which was on the earliest line.
+  The connections are made by the main thread before the workers start,
+  because options_and_connect() isn't thread-safe.
+  A new connection only knows the database that the main connection
+  is using, not the main connection's session variables.
+  Kill stops the main thread from adding to the queues, statements
+  that are already running aren't killed.
 */
-void MainWindow::remove_statement(QString text)
+#define SOURCE_PARALLEL_QUEUE_BYTES (16 * 1024 * 1024)
+#define SOURCE_PARALLEL_TO_ALL 0
+#define SOURCE_PARALLEL_TO_TABLE 1
+#define SOURCE_PARALLEL_TO_ONE 2
+#define SOURCE_PARALLEL_BY_EDITOR 3
+#define SOURCE_PARALLEL_IN_TRANSACTION 4
+struct source_parallel_worker
 {
-  //statement_edit_widget->clear(); /* ?? this is supposed to be a slot. does that matter? */
-
-  QTextCursor q= statement_edit_widget->textCursor();
+  pthread_t thread_id;
+  pthread_cond_t cond;                /* signalled when there's something in queue, or is_end */
+  unsigned int connection_number;
+  QList<QByteArray> queue;
+  QList<unsigned long> queue_line_numbers;
+  int queue_bytes;
+  bool is_busy;
+  bool is_end;
+  source_state *st;
+};
+static source_parallel_worker source_parallel_workers[SOURCE_PARALLEL_MAX];
+static pthread_mutex_t source_parallel_mutex; /* for everything in workers, and the counts in st */
+
+/* Called by a worker, with source_parallel_mutex locked. Keep the error with the earliest line. */
+static void source_parallel_error(source_state *st, unsigned long line_number, QString error)
+{
+  ++st->error_count;
+  if ((st->first_error_line_number != 0) && (st->first_error_line_number < line_number)) return;
+  st->first_error_line_number= line_number;
+  st->first_error= error;
+}
 
-  int offset_of_statement_end= 0;
+static QString source_parallel_error_text(MYSQL *connection)
+{
+  char error_and_state[50];
+  sprintf(error_and_state, "%d (%s) ",
+          lmysql->ldbms_mysql_errno(connection),
+          lmysql->ldbms_mysql_sqlstate(connection));
+  QString s= error_and_state;
+  s.append(QString::fromUtf8(lmysql->ldbms_mysql_error(connection)));
+  return s;
+}
 
-  if (main_token_count_in_statement > 0)
+/* The worker's connection is already made, see source_parallel_run(). */
+void* source_parallel_thread(void *worker)
+{
+  source_parallel_worker *w= (source_parallel_worker*) worker;
+  MYSQL *connection= &mysql[w->connection_number];
+  pthread_mutex_lock(&source_parallel_mutex);
+  for (;;)
   {
-    offset_of_statement_end= main_token_offsets[main_token_count_in_statement - 1]
-                             + main_token_lengths[main_token_count_in_statement - 1];
+    while ((w->queue.size() == 0) && (w->is_end == false)) pthread_cond_wait(&w->cond, &source_parallel_mutex);
+    if (w->queue.size() == 0) break;
+    QByteArray statement= w->queue.takeFirst();
+    unsigned long line_number= w->queue_line_numbers.takeFirst();
+    w->is_busy= true;
+    pthread_mutex_unlock(&source_parallel_mutex);
+
+    unsigned long warning_count= 0;
+    QString error;
+    int result= lmysql->ldbms_mysql_real_query(connection, statement.constData(), statement.size());
+    if (result == 0)
+    {
+      for (;;)
+      {
+        MYSQL_RES *res= lmysql->ldbms_mysql_store_result(connection);
+        if (res != NULL) lmysql->ldbms_mysql_free_result(res);
+        warning_count+= lmysql->ldbms_mysql_warning_count(connection);
+        if (lmysql->ldbms_mysql_more_results(connection) == 0) break;
+        result= lmysql->ldbms_mysql_next_result(connection);
+        if (result != 0)
+        {
+          if (result == -1) result= 0;
+          break;
+        }
+      }
+    }
+    if (result != 0) error= source_parallel_error_text(connection);
+
+    pthread_mutex_lock(&source_parallel_mutex);
+    w->queue_bytes-= statement.size();
+    w->is_busy= false;
+    w->st->warning_count+= warning_count;
+    if (result != 0) source_parallel_error(w->st, line_number, error);
+    parallel_notify();
   }
+  pthread_mutex_unlock(&source_parallel_mutex);
+  lmysql->ldbms_mysql_thread_end();
+  return ((void*) NULL);
+}
+
+/*
+  Called by the main thread with mutex locked.
+  Wait till a worker says something with parallel_notify(), in
+  dbms_long_query_wait(), so the GUI keeps responding, e.g. to Run|Kill.
+  parallel_wait_state is set with mutex locked and workers only call
+  parallel_notify() with mutex locked, so nothing said after we looked
+  is lost; the caller looks again after we return.
+*/
+void MainWindow::parallel_wait(pthread_mutex_t *mutex)
+{
+  parallel_wait_state= LONG_QUERY_STATE_STARTED;
+  pthread_mutex_unlock(mutex);
+  dbms_long_query_wait(&parallel_wait_state);
+  pthread_mutex_lock(mutex);
+}
 
+/* Called with source_parallel_mutex locked. Returns when every queue is empty and no worker is busy. */
+void MainWindow::source_parallel_wait_till_idle(int worker_count)
+{
   for (;;)
   {
-    QString c= text.mid(offset_of_statement_end, 1);
-    if (c == "") break;
-    if (c > " ") break;\
-    ++offset_of_statement_end;
+    bool is_idle= true;
+    for (int i= 0; i < worker_count; ++i)
+    {
+      if ((source_parallel_workers[i].queue.size() != 0) || (source_parallel_workers[i].is_busy == true))
+        is_idle= false;
+    }
+    if (is_idle == true) return;
+    if (is_kill_requested == true) return;
+    parallel_wait(&source_parallel_mutex);
   }
+}
 
-  q.setPosition(0, QTextCursor::MoveAnchor);
-  q.setPosition(offset_of_statement_end, QTextCursor::KeepAnchor);
-  q.removeSelectedText();
-
-
-  //q.select(QTextCursor::LineUnderCursor);
+/* Statements that change the session go to every worker. Transactions don't, see source_parallel_transaction(). */
+static const char *source_parallel_to_all_words[]=
+{
+  "SET", "UNLOCK", "USE", 0
+};
 
-  //statement_edit_widget->textCursor().insertText(text);
+/* If p[*i] is keyword followed by a non-word character, skip it and blanks after it, and return true. */
+static bool source_skip_word(const char *p, int n, int *i, const char *keyword)
+{
+  int keyword_length= strlen(keyword);
+  if (n - *i < keyword_length) return false;
+  if (qstrnicmp(p + *i, keyword, keyword_length) != 0) return false;
+  int j= *i + keyword_length;
+  if (j < n)
+  {
+    char c= p[j];
+    if (((c >= 'a') && (c <= 'z')) || ((c >= 'A') && (c <= 'Z')) || ((c >= '0') && (c <= '9'))
+     || (c == '_') || (c == '$')) return false;
+  }
+  while ((j < n) && (source_is_blank(p[j]))) ++j;
+  *i= j;
+  return true;
 }
 
+#define SOURCE_PARALLEL_TRANSACTION_NONE 0
+#define SOURCE_PARALLEL_TRANSACTION_START 1
+#define SOURCE_PARALLEL_TRANSACTION_END 2
+#define SOURCE_PARALLEL_AUTOCOMMIT_OFF 3
+#define SOURCE_PARALLEL_AUTOCOMMIT_ON 4
 /*
-  Todo: There are a few things yet to be considered.
-     I'm not 100% confident about the way I'm clearing the old results out, e.g. "delete result_form_text[...]".
-     Would it be more efficient to remove only the ones between new column count and old column count?
-       No, because data type can change, it might not be a text field the next time around.
-     Should I be saying "delete later" somehow?
-     Does memory leak?
+  Does the statement start or end a transaction?
+  BEGIN [WORK] | START TRANSACTION starts, BEGIN NOT ATOMIC is a compound statement.
+  COMMIT | ROLLBACK ends, unless it's ROLLBACK TO savepoint or ... AND CHAIN.
+  SET [SESSION|LOCAL] [@@[session.|local.]]autocommit = 0|OFF|1|ON.
+  Only the first assignment of a SET is looked at.
 */
-int MainWindow::action_execute_one_statement(QString text)
+static int source_parallel_transaction(const char *p, int n)
 {
-  //QString text;
-  MYSQL_RES *mysql_res_for_new_result_set= NULL;
-  unsigned short int is_vertical= ocelot_result_grid_vertical; /* true if --vertical or \G or ego */
-  unsigned return_value= 0;
-  ++statement_edit_widget->statement_count;
-  /*
-    Todo: There should be an indication that something is being executed.
-    Possibly, on the title bar, setPlainText(tr("Executing ...")
-    Possibly there should be a status widget or a progress bar.
-    Whatever it is, turn it on now and turn it off when statement is done.
-    Update: the Run|Execute menu item changes, which is slightly helpful.
-  */
-
-  /* Apparently there is no need for a call to tokenize() here, it seems certain that it's already been called. */
-
-  int query_utf16_len= main_token_offsets[main_token_number+main_token_count_in_statement - 1]
-                       + main_token_lengths[main_token_number+main_token_count_in_statement - 1]
-                       - main_token_offsets[main_token_number];
-
-  query_utf16= text.mid(main_token_offsets[main_token_number], query_utf16_len);
+  int i= 0;
+  if (source_skip_word(p, n, &i, "BEGIN"))
+  {
+    if (source_skip_word(p, n, &i, "NOT")) return SOURCE_PARALLEL_TRANSACTION_NONE;
+    return SOURCE_PARALLEL_TRANSACTION_START;
+  }
+  if (source_skip_word(p, n, &i, "START"))
+  {
+    if (source_skip_word(p, n, &i, "TRANSACTION")) return SOURCE_PARALLEL_TRANSACTION_START;
+    return SOURCE_PARALLEL_TRANSACTION_NONE;
+  }
+  if ((source_skip_word(p, n, &i, "COMMIT")) || (source_skip_word(p, n, &i, "ROLLBACK")))
+  {
+    source_skip_word(p, n, &i, "WORK");
+    if (source_skip_word(p, n, &i, "TO")) return SOURCE_PARALLEL_TRANSACTION_NONE;
+    if ((source_skip_word(p, n, &i, "AND")) && (source_skip_word(p, n, &i, "NO") == false))
+      return SOURCE_PARALLEL_TRANSACTION_NONE;
+    return SOURCE_PARALLEL_TRANSACTION_END;
+  }
+  if (source_skip_word(p, n, &i, "SET") == false) return SOURCE_PARALLEL_TRANSACTION_NONE;
+  if (source_skip_word(p, n, &i, "SESSION") == false) source_skip_word(p, n, &i, "LOCAL");
+  if ((n - i >= 2) && (p[i] == '@') && (p[i + 1] == '@'))
+  {
+    i+= 2;
+    if ((n - i >= 8) && (qstrnicmp(p + i, "session.", 8) == 0)) i+= 8;
+    else if ((n - i >= 6) && (qstrnicmp(p + i, "local.", 6) == 0)) i+= 6;
+  }
+  if (source_skip_word(p, n, &i, "autocommit") == false) return SOURCE_PARALLEL_TRANSACTION_NONE;
+  if ((n - i >= 2) && (p[i] == ':') && (p[i + 1] == '=')) ++i;
+  if ((i >= n) || (p[i] != '=')) return SOURCE_PARALLEL_TRANSACTION_NONE;
+  ++i;
+  while ((i < n) && (source_is_blank(p[i]))) ++i;
+  if ((source_skip_word(p, n, &i, "0")) || (source_skip_word(p, n, &i, "OFF")) || (source_skip_word(p, n, &i, "FALSE")))
+    return SOURCE_PARALLEL_AUTOCOMMIT_OFF;
+  if ((source_skip_word(p, n, &i, "1")) || (source_skip_word(p, n, &i, "ON")) || (source_skip_word(p, n, &i, "TRUE")))
+    return SOURCE_PARALLEL_AUTOCOMMIT_ON;
+  return SOURCE_PARALLEL_TRANSACTION_NONE;
+}
 
-  QString last_token;
-  bool strip_last_token= false;
-  int length_of_last_token_in_statement= main_token_lengths[main_token_number + main_token_count_in_statement - 1];
-  int type_of_last_token_in_statement= main_token_types[main_token_number + main_token_count_in_statement - 1];
-  last_token= text.mid(main_token_offsets[main_token_number+main_token_count_in_statement - 1],
-                       length_of_last_token_in_statement);
-  if ((length_of_last_token_in_statement == 1) && ((type_of_last_token_in_statement == TOKEN_KEYWORD_EGO) || (type_of_last_token_in_statement == TOKEN_KEYWORD_GO)))
-  {
-    length_of_last_token_in_statement= 2;
-    strip_last_token= true;
-    if (type_of_last_token_in_statement == TOKEN_KEYWORD_EGO) is_vertical= 1;
-  }
+/* For classifying mysqldump's statements like slash-star-!40101 SET ... star-slash, see what's inside. */
+static void source_strip_version_comment(const char **statement, int *length)
+{
+  const char *p= *statement;
+  int n= *length;
+  int i;
+  if ((n >= 4) && (p[0] == '/') && (p[1] == '*') && (p[2] == '!')) i= 3;
+  else if ((n >= 5) && (p[0] == '/') && (p[1] == '*') && (p[2] == 'M') && (p[3] == '!')) i= 4;
+  else return;
+  while ((i < n) && (p[i] >= '0') && (p[i] <= '9')) ++i;
+  while ((i < n) && (source_is_blank(p[i]))) ++i;
+  int end= n;
+  if ((end - i >= 2) && (p[end - 2] == '*') && (p[end - 1] == '/')) end-= 2;
+  if (end <= i) return;
+  *statement= p + i;
+  *length= end - i;
+}
 
-  /* Strip last word if it's delimiter or (when --named-commands, not only token) go|ego. */
-  /* todo: this is obsolete now */
-  if (last_token == ocelot_delimiter_str) strip_last_token= true;
-  else if ((ocelot_named_commands > 0) && (main_token_count_in_statement > 1))
+/*
+  An identifier at p[*i]: `...` with `` for `, or unquoted letters, digits,
+  _, $, and bytes >= 0x80 so UTF-8 is never split. Append it without
+  quotes to name, skip it, and return true. "..." might be a string,
+  unless sql_mode has ANSI_QUOTES, so that's not an identifier here.
+*/
+static bool source_parallel_identifier(const char *p, int n, int *i, QByteArray *name)
+{
+  int j= *i;
+  if ((j < n) && (p[j] == '`'))
   {
-    if (type_of_last_token_in_statement == TOKEN_KEYWORD_GO) strip_last_token= true;
-    if (type_of_last_token_in_statement == TOKEN_KEYWORD_EGO)
+    for (++j; j < n; ++j)
     {
-      strip_last_token= true;
-      is_vertical= 1;
+      if (p[j] != '`') { name->append(p[j]); continue; }
+      if ((j + 1 < n) && (p[j + 1] == '`')) { name->append('`'); ++j; continue; }
+      break;
     }
+    if ((j >= n) || (j == *i + 1)) return false;
+    *i= j + 1;
+    return true;
   }
-  if (strip_last_token == true)
+  while (j < n)
   {
-    query_utf16_copy= text.mid(main_token_offsets[main_token_number], query_utf16_len-length_of_last_token_in_statement);
+    unsigned char c= (unsigned char) p[j];
+    if (((c >= 'a') && (c <= 'z')) || ((c >= 'A') && (c <= 'Z')) || ((c >= '0') && (c <= '9'))
+     || (c == '_') || (c == '$') || (c >= 0x80)) ++j;
+    else break;
   }
-  else query_utf16_copy= query_utf16;
-
-  statement_edit_widget->start_time= QDateTime::currentMSecsSinceEpoch(); /* will be used for elapsed-time display */
-  int additional_result= 0;
-  int ecs= execute_client_statement(text, &additional_result);
-
-  QString result_set_for_history= "";
+  if (j == *i) return false;
+  name->append(p + *i, j - *i);
+  *i= j;
+  return true;
+}
 
-  if (ecs != 1)
+/*
+  The table of a statement that's for one table, as database.table or
+  table, lower case and without quotes, or "" if it's not one of these:
+    INSERT [LOW_PRIORITY|DELAYED|HIGH_PRIORITY] [IGNORE] [INTO] table
+    REPLACE [LOW_PRIORITY|DELAYED] [INTO] table
+    UPDATE [LOW_PRIORITY] [IGNORE] table
+    DELETE [LOW_PRIORITY] [QUICK] [IGNORE] FROM table
+    CREATE [TEMPORARY] TABLE [IF NOT EXISTS] table
+    DROP [TEMPORARY] TABLE [IF EXISTS] table
+    ALTER [ONLINE] [IGNORE] TABLE table
+    TRUNCATE [TABLE] table
+    LOCK TABLE[S] table
+  or if a comma follows the table, e.g. DROP TABLE a, b or a multi-table
+  UPDATE, since then it's for more than one. "" means SOURCE_PARALLEL_TO_ONE.
+  Like source_batchable_words, this looks at the bytes of the statement's
+  head, so it costs nothing for a long INSERT, and it doesn't touch
+  main_token_* or hparse_*, which belong to the statement widget.
+*/
+static QString source_parallel_table(const char *p, int n)
+{
+  int i= 0;
+  bool is_table_keyword_needed= false;
+  if (source_skip_word(p, n, &i, "INSERT"))
   {
-    /* The statement was not handled entirely by the client, it must be passed to the DBMS. */
-
-    bool do_something= true;
-
-    /* If DBMS is not (yet) connected, except for certain SET ocelot_... statements, this is an error. */
-    if (connections_is_connected[0] == 0)
-    {
-      if (ecs == 2) make_and_put_message_in_result(ER_OK, 0, (char*)"");
-      else make_and_put_message_in_result(ER_NOT_CONNECTED, 0, (char*)"");
-      do_something= false;
-    }
-    /* If --one-database, and USE caused default database to change, error */
-    if ((ocelot_one_database > 0) && (ocelot_database != statement_edit_widget->dbms_database))
+    if ((source_skip_word(p, n, &i, "LOW_PRIORITY") == false) && (source_skip_word(p, n, &i, "DELAYED") == false))
+      source_skip_word(p, n, &i, "HIGH_PRIORITY");
+    source_skip_word(p, n, &i, "IGNORE");
+    source_skip_word(p, n, &i, "INTO");
+  }
+  else if (source_skip_word(p, n, &i, "REPLACE"))
+  {
+    if (source_skip_word(p, n, &i, "LOW_PRIORITY") == false) source_skip_word(p, n, &i, "DELAYED");
+    source_skip_word(p, n, &i, "INTO");
+  }
+  else if (source_skip_word(p, n, &i, "UPDATE"))
+  {
+    source_skip_word(p, n, &i, "LOW_PRIORITY");
+    source_skip_word(p, n, &i, "IGNORE");
+  }
+  else if (source_skip_word(p, n, &i, "DELETE"))
+  {
+    source_skip_word(p, n, &i, "LOW_PRIORITY");
+    source_skip_word(p, n, &i, "QUICK");
+    source_skip_word(p, n, &i, "IGNORE");
+    if (source_skip_word(p, n, &i, "FROM") == false) return "";
+  }
+  else if ((source_skip_word(p, n, &i, "CREATE")) || (source_skip_word(p, n, &i, "DROP")))
+  {
+    source_skip_word(p, n, &i, "TEMPORARY");
+    if (source_skip_word(p, n, &i, "TABLE") == false) return "";
+    if (source_skip_word(p, n, &i, "IF"))
     {
-      make_and_put_message_in_result(ER_ONE_DATABASE, 0, (char*)"");
-      do_something= false;
+      source_skip_word(p, n, &i, "NOT");
+      if (source_skip_word(p, n, &i, "EXISTS") == false) return "";
     }
+  }
+  else if (source_skip_word(p, n, &i, "ALTER"))
+  {
+    source_skip_word(p, n, &i, "ONLINE");
+    source_skip_word(p, n, &i, "IGNORE");
+    is_table_keyword_needed= true;
+  }
+  else if (source_skip_word(p, n, &i, "TRUNCATE")) source_skip_word(p, n, &i, "TABLE");
+  else if (source_skip_word(p, n, &i, "LOCK"))
+  {
+    if (source_skip_word(p, n, &i, "TABLES") == false) is_table_keyword_needed= true;
+  }
+  else return "";
+  if ((is_table_keyword_needed) && (source_skip_word(p, n, &i, "TABLE") == false)) return "";
 
-    if (do_something == true)
-    {
-      /* Look for a CREATE TABLE statement with a SERVER clause. */
-      bool is_create_table_server;
-      int result= create_table_server(text, &is_create_table_server, main_token_number, main_token_count_in_statement);
-      dbms_long_query_result= result;
-      if (is_create_table_server == false)
-        real_query(query_utf16, MYSQL_MAIN_CONNECTION);
-
-      if (dbms_long_query_result)
-      {
-        /* beep() hasn't been tested because getting sound to work on my computer is so hard */
-        if (ocelot_no_beep == 0) QApplication::beep();
-        return_value= 1;
-        if (is_create_table_server == false)
-          put_diagnostics_in_result(MYSQL_MAIN_CONNECTION);
-      }
-      else {
-        /*
-          It was a successful SQL statement, and now look if it returned a result.
-          If it did, as determined by looking at the mysql_res that lmysql->ldbms_mysql_store_result() returns,
-          then free the previous mysql_res and delete the previous result grid,
-          before setting up new ones.
-          This means that statements which don't return result sets don't cause clearing
-          of old result sets from the screen, e.g. SET has no effect on result grid.
-          This means that momentarily there will be an old mysql_res and a new mysql_res.
-          That takes up memory. If it were easy to check in advance whether a statement
-          caused a result set (e.g. with mysql_next_result or by looking at whether the
-          statement is SELECT SHOW etc.), that would be better.
-        */
-#ifdef DBMS_TARANTOOL
-        if (connections_dbms[0] == DBMS_TARANTOOL)
-        {
-          /* todo: failing to check if statement started with comment */
-          if ((main_token_types[0] == TOKEN_KEYWORD_SELECT)
-           || (main_token_types[0] == TOKEN_KEYWORD_LUA)
-           || ((main_token_flags[0]&TOKEN_FLAG_IS_LUA) != 0))
-          {
-            int result_set_type= tarantool_result_set_type(0);
-            if ((result_set_type == 0) || (result_set_type == 1))
-              mysql_res_for_new_result_set= 0;
-            else
-            {
-              /* Yes mysql_res_for_new_result_set will be invalid. Fix, eh? */
-              {
-                MYSQL_RES r;
-                mysql_res_for_new_result_set= &r;
-              }
-            }
-          }
-          else mysql_res_for_new_result_set= 0;
-        }
-        if (connections_dbms[0] != DBMS_TARANTOOL)
-#endif
-        mysql_res_for_new_result_set= lmysql->ldbms_mysql_store_result(&mysql[MYSQL_MAIN_CONNECTION]);
-        if (mysql_res_for_new_result_set == 0)
-        {
-          /*
-            Last statement did not cause a result set. We could hide the grid and shrink the
-            central window with "result_grid_tab_widget[0]->hide()", but we don't.
-          */
-          get_sql_mode(main_token_types[main_token_number], text);
-          put_diagnostics_in_result(MYSQL_MAIN_CONNECTION);
-        }
-        else
-        {
-#ifdef DBMS_TARANTOOL
-          if (connections_dbms[0] == DBMS_TARANTOOL)
-          {
-            /* TODO: Free the last reply, equivalent to mysql_free_result */
-          }
-          else
-#endif
-          {
-          if (mysql_res != 0)
-            {
-              lmysql->ldbms_mysql_free_result(mysql_res); /* This is the place we free if myql_more_results wasn't true, see below. */
-            }
-
-            mysql_res= mysql_res_for_new_result_set;
-
-            /* We need to think better what to do if we exceed MAX_COLUMNS */
-            /* ... or maybe not, it seems we got rid of MAX_COLUMNS */
-            /*
-              Todo: consider whether it would be appropriate to set grid width with
-              result_grid_tab_widget[0]->result_column_count= lmysql->ldbms_mysql_num_fields(mysql_res);
-              but it may be unnecessary, and may cause a crash in garbage_collect()
-            */
-
-            result_row_count= lmysql->ldbms_mysql_num_rows(mysql_res);                /* this will be the height of the grid */
-          }
-
-          ResultGrid *rg;
-          {
-            for (int i_r= 0; i_r < ocelot_grid_actual_tabs; ++i_r)
-            {
-              rg= qobject_cast<ResultGrid*>(result_grid_tab_widget->widget(i_r));
-              rg->is_paintable= 0;
-              rg->garbage_collect();
-            }
-            rg= qobject_cast<ResultGrid*>(result_grid_tab_widget->widget(0));
-            //QFont tmp_font;
-            //tmp_font= rg->font();
-            rg->fillup(mysql_res,
-                      //&tarantool_tnt_reply,
-                      connections_dbms[0],
-                      //this,
-                      is_vertical, ocelot_result_grid_column_names,
-                      lmysql, ocelot_client_side_functions,
-                      ocelot_batch, ocelot_html, ocelot_raw, ocelot_xml,
-                      MYSQL_MAIN_CONNECTION);
-            result_grid_tab_widget->setCurrentWidget(rg);
-            result_grid_tab_widget->tabBar()->hide();
-            /* next line redundant? display() ends with show() */
-            rg->show();
-            result_grid_tab_widget->show(); /* Maybe this only has to happen once */
-          }
-
-          /*
-            Following is no-op by default because ocelot_history_max_row_count=0
-          */
-          if ((ocelot_grid_actual_tabs > 0)
-           && (result_set_for_history == ""))
-          {
-            rg= qobject_cast<ResultGrid*>(result_grid_tab_widget->widget(0));
-            result_set_for_history= rg->copy_to_history(ocelot_history_max_row_count.toLong(), is_vertical);
-          }
-          /* Todo: small bug: elapsed_time calculation happens before lmysql->ldbms_mysql_next_result(). */
-          /* You must call lmysql->ldbms_mysql_next_result() + lmysql->ldbms_mysql_free_result() if there are multiple sets */
-          put_diagnostics_in_result(MYSQL_MAIN_CONNECTION); /* Do this while we still have number of rows */
-          //history_markup_append(result_set_for_history, true);
+  QByteArray name;
+  if (source_parallel_identifier(p, n, &i, &name) == false) return "";
+  while ((i < n) && (source_is_blank(p[i]))) ++i;
+  if ((i < n) && (p[i] == '.'))
+  {
+    ++i;
+    while ((i < n) && (source_is_blank(p[i]))) ++i;
+    name.append('.');
+    if (source_parallel_identifier(p, n, &i, &name) == false) return "";
+    while ((i < n) && (source_is_blank(p[i]))) ++i;
+  }
+  if ((i < n) && (p[i] == ',')) return "";
+  return QString::fromUtf8(name.constData(), name.size()).toLower();
+}
 
-#ifdef DBMS_TARANTOOL
-          if ((connections_dbms[0] != DBMS_TARANTOOL)
-           && (lmysql->ldbms_mysql_more_results(&mysql[MYSQL_MAIN_CONNECTION])))
+/* Close the workers' connections, after their threads have ended. */
+static void source_parallel_close(int connected_count)
+{
+  for (int i= 0; i < connected_count; ++i)
+  {
+    unsigned int connection_number= MYSQL_SOURCE_PARALLEL_CONNECTION + i;
+    if (connected[connection_number] == 0) continue;
+    lmysql->ldbms_mysql_close(&mysql[connection_number]);
+    connected[connection_number]= 0;
+  }
+}
 
-#else
-          if (lmysql->ldbms_mysql_more_results(&mysql[MYSQL_MAIN_CONNECTION]))
-#endif
-          {
-            lmysql->ldbms_mysql_free_result(mysql_res);
-            /*
-              We started with CLIENT_MULTI_RESULT flag (not CLIENT_MULTI_STATEMENT).
-              We expect that a CALL to a stored procedure might return multiple result sets
-              plus a status result at the end. The following lines try to pick up and display
-              the extra result sets, up to a fixed maximum, and just throw away everything
-              after that, to avoid the dreaded out-of-sync error message.
-              If it's an ordinary select, lmysql->ldbms_mysql_free_result(mysql_res) happens later, see above.
-            */
-            int result_grid_table_widget_index= 1;
-            for (;;)
-            {
-              dbms_long_query_state= LONG_QUERY_STATE_STARTED;
-              pthread_t thread_id;
-              pthread_create(&thread_id, NULL, &dbms_long_next_result_thread, NULL);
+/* Put a statement in a worker's queue, waiting if the queue is full. Called with source_parallel_mutex locked. */
+void MainWindow::source_parallel_put(source_parallel_worker *w, QByteArray statement, unsigned long line_number)
+{
+  while ((w->queue_bytes > SOURCE_PARALLEL_QUEUE_BYTES) && (is_kill_requested == false)) parallel_wait(&source_parallel_mutex);
+  w->queue.append(statement);
+  w->queue_line_numbers.append(line_number);
+  w->queue_bytes+= statement.size();
+  pthread_cond_signal(&w->cond);
+}
 
-              for (;;)
-              {
-                QThread48::msleep(10);
-                if (dbms_long_query_state == LONG_QUERY_STATE_ENDED) break;
-                QApplication::processEvents();
-              }
-              pthread_join(thread_id, NULL);
+int MainWindow::source_parallel_run(QFile *file, int worker_count)
+{
+  bool is_possible= (connections_is_connected[0] != 0);
+#ifdef DBMS_TARANTOOL
+  if (connections_dbms[0] == DBMS_TARANTOOL) is_possible= false;
+#endif
+  if (is_possible == false) return source_run(file);
+  if (worker_count < 1) worker_count= 1;
+  if (worker_count > SOURCE_PARALLEL_MAX) worker_count= SOURCE_PARALLEL_MAX;
+
+  source_scanner sc;
+  QByteArray initial_delimiter= ocelot_delimiter_str.toUtf8();
+  source_scanner_start(&sc, initial_delimiter);
+
+  source_state st;
+  st.statement_count= st.error_count= st.warning_count= 0;
+  st.first_error_line_number= 0;
+  st.saved_query_utf16= query_utf16;
+  st.saved_query_utf16_copy= query_utf16_copy;
+  st.start_time= statement_edit_widget->start_time;
+  st.progress_time= QDateTime::currentMSecsSinceEpoch();
+  st.is_progress_shown= false;
+
+  /* Connect one after another here, options_and_connect() uses globals. The threads only get the handles. */
+  QByteArray database= statement_edit_widget->dbms_database.toUtf8();
+  bool is_stopped= false;
+  int connected_count= 0;
+  for (int i= 0; i < worker_count; ++i)
+  {
+    unsigned int connection_number= MYSQL_SOURCE_PARALLEL_CONNECTION + i;
+    MYSQL *connection= &mysql[connection_number];
+    if (options_and_connect(connection_number) != 0)
+    {
+      source_parallel_error(&st, 1, source_parallel_error_text(connection));
+      is_stopped= true;
+      break;
+    }
+    ++connected_count;
+    if ((database.size() != 0) && (lmysql->ldbms_mysql_select_db(connection, database.constData()) != 0))
+    {
+      source_parallel_error(&st, 1, source_parallel_error_text(connection));
+      is_stopped= true;
+      break;
+    }
+  }
 
-              if (dbms_long_query_result != 0)
-              {
-                return_value= 1;
-                /* If mysql_next_result) == 1 means error, -1 means no more. */
-                /* TODO: don't do this for SOURCE. Check for beep. */
-                if (dbms_long_query_result == 1)
-                {
-                  put_diagnostics_in_result(MYSQL_MAIN_CONNECTION);
-                  //history_markup_append("", true);
-                }
-                break;
-              }
-              /* todo: consider appending row count to result message */
-              mysql_res= lmysql->ldbms_mysql_store_result(&mysql[MYSQL_MAIN_CONNECTION]);
+  pthread_mutex_init(&source_parallel_mutex, NULL);
+  parallel_wait_notify= this;
+  int started_count= 0;
+  if (is_stopped == false)
+  {
+    for (int i= 0; i < worker_count; ++i)
+    {
+      source_parallel_worker *w= &source_parallel_workers[i];
+      pthread_cond_init(&w->cond, NULL);
+      w->connection_number= MYSQL_SOURCE_PARALLEL_CONNECTION + i;
+      w->queue_bytes= 0;
+      w->is_busy= false;
+      w->is_end= false;
+      w->st= &st;
+      if (pthread_create(&w->thread_id, NULL, &source_parallel_thread, w) != 0)
+      {
+        pthread_cond_destroy(&w->cond);
+        break;
+      }
+      ++started_count;
+    }
+  }
+  if ((started_count == 0) && (is_stopped == false))
+  {
+    parallel_wait_notify= NULL;
+    pthread_mutex_destroy(&source_parallel_mutex);
+    source_parallel_close(connected_count);
+    return source_run(file);
+  }
+  worker_count= started_count;
 
-              /* I think the following will help us avoid the "status" return. */
-              if (mysql_res == NULL) continue;
-              if (result_grid_table_widget_index == ocelot_grid_actual_tabs)
-              {
-                result_grid_add_tab();
-              }
+  /* So hparse_background_start() won't start, and Run|Kill is enabled */
+  dbms_long_query_state= LONG_QUERY_STATE_STARTED;
 
-              if (result_grid_table_widget_index < ocelot_grid_actual_tabs)
-              {
-                ResultGrid* r;
-                r= qobject_cast<ResultGrid*>(result_grid_tab_widget->widget(result_grid_table_widget_index));
-                result_grid_tab_widget->tabBar()->show(); /* is this in the wrong place? */
-                result_row_count= lmysql->ldbms_mysql_num_rows(mysql_res);                /* this will be the height of the grid */
-                r->fillup(mysql_res,
-                          //&tarantool_tnt_reply,
-                          connections_dbms[0],
-                          //this,
-                          is_vertical,
-                          ocelot_result_grid_column_names,
-                          lmysql,
-                          ocelot_client_side_functions,
-                          ocelot_batch, ocelot_html, ocelot_raw, ocelot_xml,
-                          MYSQL_MAIN_CONNECTION);
-                /* next line redundant? display() ends with show() */
-                r->show();
+  /* While a transaction is open everything goes to worker 0, see the comment before SOURCE_PARALLEL_QUEUE_BYTES. */
+  bool is_transaction_open= false;
+  bool is_autocommit_off= false;
+  bool is_eof= false;
+  while ((is_stopped == false) && (is_kill_requested == false))
+  {
+    int offset, length;
+    if (source_scan(&sc, is_eof, &offset, &length) == false)
+    {
+      if (is_eof == true) break;
+      is_eof= (source_scanner_read(&sc, file) == false);
+      continue;
+    }
+    const char *statement= sc.buffer.constData() + offset;
+    const char *word= statement;
+    int word_length= length;
+    source_strip_version_comment(&word, &word_length);
+    ++st.statement_count;
+
+    bool was_in_transaction= (is_transaction_open || is_autocommit_off);
+    int transaction= source_parallel_transaction(word, word_length);
+    if (transaction == SOURCE_PARALLEL_TRANSACTION_START) is_transaction_open= true;
+    if (transaction == SOURCE_PARALLEL_TRANSACTION_END) is_transaction_open= false;
+    if (transaction == SOURCE_PARALLEL_AUTOCOMMIT_OFF) is_autocommit_off= true;
+    if (transaction == SOURCE_PARALLEL_AUTOCOMMIT_ON) is_transaction_open= is_autocommit_off= false;
+    bool is_in_transaction= (is_transaction_open || is_autocommit_off);
+
+    int target= SOURCE_PARALLEL_TO_TABLE;
+    for (int i= 0; source_parallel_to_all_words[i] != 0; ++i)
+    {
+      int to_all_word_length= strlen(source_parallel_to_all_words[i]);
+      if ((word_length >= to_all_word_length)
+       && (qstrnicmp(word, source_parallel_to_all_words[i], to_all_word_length) == 0)
+       && ((word_length == to_all_word_length) || (source_is_blank(word[to_all_word_length]))))
+        target= SOURCE_PARALLEL_TO_ALL;
+    }
+    if ((target != SOURCE_PARALLEL_TO_ALL)
+     && ((source_is_client_statement(statement, length) == true) || (source_is_result_set(word, word_length) == true)))
+      target= SOURCE_PARALLEL_BY_EDITOR;
+    if ((target == SOURCE_PARALLEL_TO_ALL)
+     && (qstrnicmp(word, "SET", 3) == 0)
+     && (source_is_client_statement(word, word_length) == true))
+      target= SOURCE_PARALLEL_BY_EDITOR;     /* SET OCELOT_... */
+    if (transaction != SOURCE_PARALLEL_TRANSACTION_NONE)
+      target= SOURCE_PARALLEL_IN_TRANSACTION;
+    if ((target == SOURCE_PARALLEL_TO_TABLE) && (is_in_transaction == true))
+      target= SOURCE_PARALLEL_IN_TRANSACTION;
+    int worker_number= 0;
+    if (target == SOURCE_PARALLEL_TO_TABLE)
+    {
+      QString table= source_parallel_table(word, word_length);
+      if (table == "") target= SOURCE_PARALLEL_TO_ONE;
+      else worker_number= qHash(table) % worker_count;
+    }
+
+    QByteArray statement_copy(statement, length);
+    pthread_mutex_lock(&source_parallel_mutex);
+    if ((target == SOURCE_PARALLEL_TO_ONE) || (target == SOURCE_PARALLEL_BY_EDITOR))
+      source_parallel_wait_till_idle(worker_count);
+    if ((target == SOURCE_PARALLEL_IN_TRANSACTION) && (was_in_transaction == false))
+      source_parallel_wait_till_idle(worker_count);
+    if (target == SOURCE_PARALLEL_BY_EDITOR)
+    {
+      pthread_mutex_unlock(&source_parallel_mutex);
+      source_state editor_st;
+      editor_st.error_count= 0;
+      editor_st.first_error_line_number= 0;
+      source_by_editor(&editor_st, &sc, statement, length);
+      dbms_long_query_state= LONG_QUERY_STATE_STARTED;
+      pthread_mutex_lock(&source_parallel_mutex);
+      if (editor_st.error_count != 0)
+        source_parallel_error(&st, editor_st.first_error_line_number, editor_st.first_error);
+    }
+    else if (target == SOURCE_PARALLEL_TO_ALL)
+    {
+      for (int i= 0; i < worker_count; ++i)
+        source_parallel_put(&source_parallel_workers[i], statement_copy, sc.statement_line_number);
+    }
+    else
+    {
+      source_parallel_put(&source_parallel_workers[worker_number], statement_copy, sc.statement_line_number);
+      if (target == SOURCE_PARALLEL_TO_ONE) source_parallel_wait_till_idle(worker_count);
+      if ((target == SOURCE_PARALLEL_IN_TRANSACTION) && (is_in_transaction == false))
+        source_parallel_wait_till_idle(worker_count);
+    }
+    if ((st.error_count != 0) && (ocelot_abort_source_on_error > 0)) is_stopped= true;
+    source_progress(&st, file);
+    pthread_mutex_unlock(&source_parallel_mutex);
+  }
 
-                //Put in something based on this if you want extra results to go to history:
-                //... result_grid_table_widget[result_grid_tab_widget_index]->copy_to_history(); etc.
+  /* Let the workers finish what's queued, unless we're stopping. Then end them. */
+  pthread_mutex_lock(&source_parallel_mutex);
+  if ((is_stopped == false) && (is_kill_requested == false)) source_parallel_wait_till_idle(worker_count);
+  for (int i= 0; i < worker_count; ++i)
+  {
+    source_parallel_worker *w= &source_parallel_workers[i];
+    w->queue.clear();
+    w->queue_line_numbers.clear();
+    w->queue_bytes= 0;
+    w->is_end= true;
+    pthread_cond_signal(&w->cond);
+  }
+  pthread_mutex_unlock(&source_parallel_mutex);
+  for (int i= 0; i < worker_count; ++i)
+  {
+    pthread_join(source_parallel_workers[i].thread_id, NULL);
+    pthread_cond_destroy(&source_parallel_workers[i].cond);
+  }
+  parallel_wait_notify= NULL;
+  pthread_mutex_destroy(&source_parallel_mutex);
+  source_parallel_close(connected_count);
+  dbms_long_query_state= LONG_QUERY_STATE_ENDED;
 
-                ++result_grid_table_widget_index;
-              }
+  source_end(&st, &sc);
+  if (st.error_count != 0) return 2;
+  return 1;
+}
 
-              if (mysql_res != 0) lmysql->ldbms_mysql_free_result(mysql_res);
 
-            }
-            mysql_res= 0;
-          }
+/*
+  $BENCH [n=count] [concurrency=count] statement
+  A load generator, so one needn't switch to mysqlslap to see how a
+  statement does when several connections run it at once.
+  concurrency worker threads (at most SOURCE_PARALLEL_MAX) each get a
+  connection, the same ones that SOURCE PARALLEL uses, and the same
+  database as the main connection. The main thread connects them one
+  after another, because options_and_connect() isn't thread-safe, then
+  the workers take turns at bench_next till the statement has been done
+  n times, timing each mysql_real_query() + fetch of its results.
+  The report is made by the client and goes straight to the result grid,
+  see ResultGrid::fillup_client(), so the main connection isn't used:
+  counts, statements per second, latency percentiles, and a histogram.
+  Kill stops the workers after the statements they're doing.
+*/
+#define BENCH_HISTOGRAM_BUCKETS 13
+static const double bench_histogram_ms[BENCH_HISTOGRAM_BUCKETS]=
+{
+  0.1, 0.2, 0.5, 1, 2, 5, 10, 20, 50, 100, 200, 500, 1000
+};
+struct bench_worker
+{
+  pthread_t thread_id;
+  unsigned int connection_number;
+  QByteArray query;
+  QVector<qint64> latencies;          /* nanoseconds, one per statement that this worker did */
+  unsigned long error_count;
+  QString first_error;
+  bool is_done;
+};
+static bench_worker bench_workers[SOURCE_PARALLEL_MAX];
+static pthread_mutex_t bench_mutex;
+static pthread_cond_t bench_cond;     /* broadcast when bench_is_started or bench_is_stopping changes */
+static unsigned long bench_count;
+static unsigned long bench_next;      /* statements started so far */
+static bool bench_is_started;
+static bool bench_is_stopping;
+
+/* The worker's connection is already made, see bench_run(). */
+void* bench_thread(void *worker)
+{
+  bench_worker *w= (bench_worker*) worker;
+  MYSQL *connection= &mysql[w->connection_number];
+  pthread_mutex_lock(&bench_mutex);
+  while ((bench_is_started == false) && (bench_is_stopping == false)) pthread_cond_wait(&bench_cond, &bench_mutex);
+  while ((bench_is_stopping == false) && (bench_next < bench_count))
+  {
+    ++bench_next;
+    pthread_mutex_unlock(&bench_mutex);
+    QElapsedTimer timer;
+    timer.start();
+    int result= lmysql->ldbms_mysql_real_query(connection, w->query.constData(), w->query.size());
+    if (result == 0)
+    {
+      for (;;)
+      {
+        MYSQL_RES *res= lmysql->ldbms_mysql_store_result(connection);
+        if (res != NULL) lmysql->ldbms_mysql_free_result(res);
+        if (lmysql->ldbms_mysql_more_results(connection) == 0) break;
+        result= lmysql->ldbms_mysql_next_result(connection);
+        if (result != 0)
+        {
+          if (result == -1) result= 0;
+          break;
         }
       }
-      //put_diagnostics_in_result(MYSQL_MAIN_CONNECTION);
     }
+    w->latencies.append(statement_timing_elapsed(&timer));
+    if (result != 0)
+    {
+      if (w->error_count == 0) w->first_error= source_parallel_error_text(connection);
+      ++w->error_count;
+    }
+    pthread_mutex_lock(&bench_mutex);
   }
+  w->is_done= true;
+  parallel_notify();
+  pthread_mutex_unlock(&bench_mutex);
+  lmysql->ldbms_mysql_thread_end();
+  return ((void*) NULL);
+}
 
-  /* statement is over */
-  if (additional_result != TOKEN_KEYWORD_SOURCE)
-  {
-    history_markup_append(result_set_for_history, true); /* add prompt+statement+result to history, with markup */
-  }
-  return return_value;
+/* One row of the report: item, value */
+static void bench_report_row(QList< QList<QByteArray> > *rows, QString item, QString value)
+{
+  QList<QByteArray> row;
+  row.append(item.toUtf8());
+  row.append(value.toUtf8());
+  rows->append(row);
+}
+
+static QString bench_ms(qint64 ns)
+{
+  return QString::number((double) ns / 1000000, 'f', 3);
 }
 
 /*
-  Bottom-level call to DBMS.
-  We call this when we know that there will be no more change
-  to the query (no local-subquery substitution, but maybe
-  stripping of comments and delimiters other than ;).
-  During this query we allocate or use globals:
-  dbms_query, dbms_query_len, dbms_query_connection.
-  The query might go to either the main or the local
-  connection, the local connection might be either
-  mysql or tarantool.
-  Todo: Tarantool can't be killed so easily. Make a fiber?
+  Run statement n times with concurrency connections, and put the
+  report in the result grid. Returns 0 if that's been done, else puts
+  an error in the result and returns 1.
 */
-int MainWindow::real_query(QString query, int connection_number)
+int MainWindow::bench_run(QString statement, unsigned long n, int concurrency)
 {
-  /*
-    If the last error was CR_SERVER_LOST 2013 or CR_SERVER_GONE_ERROR 2006,
-    and it might be possible to reconnect, try.
-    But if mysql_ping() fails, I don't see much that we can do.
-  */
-  if ((mysql_errno_result == 2006) || (mysql_errno_result == 2013))
-  {
-    if (ocelot_opt_reconnect > 0) lmysql->ldbms_mysql_ping(&mysql[MYSQL_MAIN_CONNECTION]);
-  }
-  /* todo: figure out why you used global dbms_query for this */
-  /* TODO: BUG. This statement caused a crash when ocelot_comments == 0:
-         create procedure p27 ()
-           begin
-           declare xxx int;
-           declare yyy int;
-           set xxx = 0;
-           while xxx < 1000 do
-             set xxx = xxx;
-             set xxx = xxx + 1;
-             end while;
-           end
-      We work around it by allocating double what we need for dbms_query. */
-  dbms_query_len= query.toUtf8().size();           /* See comment "UTF8 Conversion" */
-  dbms_query= new char[(dbms_query_len + 1) * 2];
-  dbms_query_len= make_statement_ready_to_send(query,
-                                               dbms_query, dbms_query_len + 1);
-  assert(strlen(dbms_query) < ((unsigned int) dbms_query_len + 1) * 2);
-  dbms_query_connection_number= connection_number;
+  bool is_possible= (connections_is_connected[0] != 0);
 #ifdef DBMS_TARANTOOL
-  /* todo: for tarantool as for mysql, call with a separate thread so it's killable */
-  if (connections_dbms[connection_number] == DBMS_TARANTOOL)
+  if (connections_dbms[0] == DBMS_TARANTOOL) is_possible= false;
+#endif
+  if (is_possible == false)
   {
-    dbms_long_query_result= tarantool_real_query(dbms_query, dbms_query_len, MYSQL_MAIN_CONNECTION, main_token_number, main_token_count_in_statement);
-    dbms_long_query_state= LONG_QUERY_STATE_ENDED;
+    make_and_put_message_in_result(ER_NOT_CONNECTED, 0, (char*)"");
+    return 1;
   }
-  else
-#endif
+  if (concurrency > SOURCE_PARALLEL_MAX) concurrency= SOURCE_PARALLEL_MAX;
+
+  /* Connect one after another here, options_and_connect() uses globals. The threads only get the handles. */
+  QByteArray database= statement_edit_widget->dbms_database.toUtf8();
+  QString connect_error;
+  int connected_count= 0;
+  for (int i= 0; i < concurrency; ++i)
   {
-    pthread_t thread_id;
-    dbms_long_query_state= LONG_QUERY_STATE_STARTED;
-    pthread_create(&thread_id, NULL, &dbms_long_query_thread, NULL);
-    for (;;)
+    unsigned int connection_number= MYSQL_SOURCE_PARALLEL_CONNECTION + i;
+    MYSQL *connection= &mysql[connection_number];
+    if (options_and_connect(connection_number) != 0)
     {
-      QThread48::msleep(10);
-      if (dbms_long_query_state == LONG_QUERY_STATE_ENDED) break;
-      QApplication::processEvents();
+      connect_error= source_parallel_error_text(connection);
+      break;
+    }
+    ++connected_count;
+    if ((database.size() != 0) && (lmysql->ldbms_mysql_select_db(connection, database.constData()) != 0))
+    {
+      connect_error= source_parallel_error_text(connection);
+      break;
     }
-    pthread_join(thread_id, NULL);
-    //     dbms_long_query_result= lmysql->ldbms_mysql_real_query(&mysql[MYSQL_MAIN_CONNECTION], dbms_query, dbms_query_len);
-    //     dbms_long_query_state= LONG_QUERY_STATE_ENDED;
   }
-  delete []dbms_query;
-  return dbms_long_query_result;
-}
 
-/*
-  We see "DELIMITER".
-  If the thing that follows is 'literal' or "literal" or `identifier`: that's the delimiter.
-  Otherwise delimiter is what follows as far as next whitespace or eof or ;
-  DELIMITER ; means "go back to the default i.e. ;".
-  This is called from hparse_f_client_statement() because it affects parse of later statements.
-  This is called from execute_client_statement() because DELIMITER is a client statement.
-  One difference from mysql client:
-    If mysql client sees "DELIMITER <return>" or "DELIMITER ''" it's an error.
-    But we consider that equivalent to "DELIMITER ;"
-  We return ";" if nothing follows or quoted blank string follows; mysql client would say error.
-*/
-QString MainWindow::get_delimiter(QString token, QString text, int offset)
-{
-  QString token_to_return;
-  if ((token.mid(0, 1) == "`") || (token.mid(0, 1) == "'") || (token.mid(0, 1) == "\""))
+  pthread_mutex_init(&bench_mutex, NULL);
+  pthread_cond_init(&bench_cond, NULL);
+  parallel_wait_notify= this;
+  bench_count= n;
+  bench_next= 0;
+  bench_is_started= false;
+  bench_is_stopping= false;
+  QByteArray query= statement.toUtf8();
+  int worker_count= 0;
+  if (connect_error == "")
   {
-    token_to_return= connect_stripper(token, false);
+    for (int i= 0; i < concurrency; ++i)
+    {
+      bench_worker *w= &bench_workers[i];
+      w->connection_number= MYSQL_SOURCE_PARALLEL_CONNECTION + i;
+      w->query= query;
+      w->latencies.clear();
+      w->latencies.reserve((n / concurrency) + 1);
+      w->error_count= 0;
+      w->first_error= "";
+      w->is_done= false;
+      if (pthread_create(&w->thread_id, NULL, &bench_thread, w) != 0) break;
+      ++worker_count;
+    }
   }
-  else
+
+  /* So Run|Kill is enabled */
+  dbms_long_query_state= LONG_QUERY_STATE_STARTED;
+  QElapsedTimer timer;
+  pthread_mutex_lock(&bench_mutex);
+  if (is_kill_requested == true) bench_is_stopping= true;
+  bench_is_started= true;
+  timer.start();
+  pthread_cond_broadcast(&bench_cond);
+  for (int i= 0; i < worker_count; ++i)
   {
-    token_to_return= "";
-    for (int i= offset;; ++i)
+    while (bench_workers[i].is_done == false)
     {
-      QString c= text.mid(i, 1);
-      if (c <= " ") break;
-      if (c == ";")
+      if ((is_kill_requested == true) && (bench_is_stopping == false))
       {
-        if (token_to_return == "") token_to_return= ";";
-        break;
+        bench_is_stopping= true;
+        pthread_cond_broadcast(&bench_cond);
       }
-      token_to_return.append(c);
+      parallel_wait(&bench_mutex);
     }
   }
-  return token_to_return;
+  qint64 elapsed_ns= statement_timing_elapsed(&timer);
+  pthread_mutex_unlock(&bench_mutex);
+  for (int i= 0; i < worker_count; ++i) pthread_join(bench_workers[i].thread_id, NULL);
+  parallel_wait_notify= NULL;
+  pthread_cond_destroy(&bench_cond);
+  pthread_mutex_destroy(&bench_mutex);
+  source_parallel_close(connected_count);
+  dbms_long_query_state= LONG_QUERY_STATE_ENDED;
+
+  if ((worker_count == 0) && (connect_error == "")) connect_error= "pthread_create failed";
+  if (connect_error != "")
+  {
+    QString s= er_strings[er_off + ER_ERROR];
+    s.append(". ");
+    s.append(connect_error);
+    put_message_in_result(s);
+    return 1;
+  }
+
+  QVector<qint64> latencies;
+  unsigned long error_count= 0;
+  QString first_error;
+  for (int i= 0; i < worker_count; ++i)
+  {
+    latencies+= bench_workers[i].latencies;
+    bench_workers[i].latencies.clear();
+    if ((bench_workers[i].error_count != 0) && (first_error == "")) first_error= bench_workers[i].first_error;
+    error_count+= bench_workers[i].error_count;
+  }
+  qSort(latencies);
+  int count= latencies.size();
+
+  QList< QList<QByteArray> > rows;
+  bench_report_row(&rows, "statements", QString::number(count));
+  bench_report_row(&rows, "errors", QString::number(error_count));
+  bench_report_row(&rows, "concurrency", QString::number(worker_count));
+  bench_report_row(&rows, "seconds", QString::number((double) elapsed_ns / 1000000000, 'f', 3));
+  if (elapsed_ns > 0)
+    bench_report_row(&rows, "statements per second", QString::number(((double) count * 1000000000) / elapsed_ns, 'f', 1));
+  if (count > 0)
+  {
+    bench_report_row(&rows, "min ms", bench_ms(latencies[0]));
+    bench_report_row(&rows, "p50 ms", bench_ms(latencies[((count - 1) * 50) / 100]));
+    bench_report_row(&rows, "p95 ms", bench_ms(latencies[((count - 1) * 95) / 100]));
+    bench_report_row(&rows, "p99 ms", bench_ms(latencies[((count - 1) * 99) / 100]));
+    bench_report_row(&rows, "max ms", bench_ms(latencies[count - 1]));
+    /* Histogram. latencies is sorted so each bucket starts where the last one stopped. */
+    int j= 0;
+    for (int i= 0; i <= BENCH_HISTOGRAM_BUCKETS; ++i)
+    {
+      int bucket_count= 0;
+      if (i == BENCH_HISTOGRAM_BUCKETS) bucket_count= count - j;
+      else
+      {
+        qint64 limit= (qint64) (bench_histogram_ms[i] * 1000000);
+        while ((j < count) && (latencies[j] <= limit)) { ++j; ++bucket_count; }
+      }
+      if (bucket_count == 0) continue;
+      QString item;
+      if (i == BENCH_HISTOGRAM_BUCKETS) item= "> " + QString::number(bench_histogram_ms[i - 1]) + " ms";
+      else item= "<= " + QString::number(bench_histogram_ms[i]) + " ms";
+      bench_report_row(&rows, item, QString::number(bucket_count));
+    }
+  }
+  if (first_error != "") bench_report_row(&rows, "first error", first_error);
+
+  QList<QByteArray> column_names;
+  column_names.append("item");
+  column_names.append("value");
+  ResultGrid *rg;
+  for (int i_r= 0; i_r < ocelot_grid_actual_tabs; ++i_r)
+  {
+    rg= qobject_cast<ResultGrid*>(result_grid_tab_widget->widget(i_r));
+    rg->is_paintable= 0;
+    rg->garbage_collect();
+  }
+  rg= qobject_cast<ResultGrid*>(result_grid_tab_widget->widget(0));
+  rg->fillup_client(column_names, rows,
+                    connections_dbms[0],
+                    0, ocelot_result_grid_column_names,
+                    lmysql, ocelot_client_side_functions,
+                    ocelot_batch, ocelot_html, ocelot_raw, ocelot_xml);
+  result_grid_tab_widget->setCurrentWidget(rg);
+  result_grid_tab_widget->tabBar()->hide();
+  rg->show();
+  result_grid_tab_widget->show();
+  make_and_put_message_in_result(ER_OK, 0, (char*)"");
+  return 0;
 }
 
 
@@ -7577,15 +11544,24 @@ int MainWindow::execute_client_statement(QString text, int *additional_result)
     /* Todo: allow for comments and ; */
     /* Todo: if we fill up the line, return an overflow message,
        or make line[] bigger and re-read the file. */
-    /* Executing the source-file statements is surprisingly easy: just put them in
-       the statement widget. This should be activating action_statement_edit_widget_changed
-       and that ultimately causes execution.
-       Handling multiple statements per line is okay, but SOURCE may not be witin multi-line.
-       Difference from mysql client: this puts source-file statements in history, mysql client puts "source" statement. */
+    /* The source-file statements are executed by source_run(), which sends them
+       directly to the DBMS without putting them in the statement widget.
+       As with the mysql client, history gets the SOURCE statement and a summary. */
     /* Todo: stop recursion i.e. source statement within source statement. That's an error. */
+    /* SOURCE PARALLEL n file: see source_parallel_run(). */
     QString s;
     unsigned statement_length= /* text.size() */ true_text_size;
-    if (i2 >= 2) s= text.mid(sub_token_offsets[1], statement_length - (sub_token_offsets[1] - sub_token_offsets[0]));
+    int parallel_count= 0;
+    if ((i2 >= 4)
+     && (QString::compare(text.mid(sub_token_offsets[1], sub_token_lengths[1]), "PARALLEL", Qt::CaseInsensitive) == 0))
+    {
+      bool is_number;
+      parallel_count= text.mid(sub_token_offsets[2], sub_token_lengths[2]).toInt(&is_number);
+      if ((is_number == false) || (parallel_count < 1)) parallel_count= 0;
+      else s= text.mid(sub_token_offsets[3], statement_length - (sub_token_offsets[3] - sub_token_offsets[0]));
+    }
+    if (parallel_count != 0) {;}
+    else if (i2 >= 2) s= text.mid(sub_token_offsets[1], statement_length - (sub_token_offsets[1] - sub_token_offsets[0]));
     else
     {
       make_and_put_message_in_result(ER_SOURCE, 0, (char*)"");
@@ -7599,37 +11575,43 @@ int MainWindow::execute_client_statement(QString text, int *additional_result)
       make_and_put_message_in_result(ER_FILE_OPEN, 0, (char*)"");
       return 1;
     }
-    /* Todo: this gets rid of SOURCE statement, but maybe it should be a comment in history. */
+    /* The statements don't go to the editor or history, see source_run(). */
     statement_edit_widget->clear();
-    QByteArray source_line;
-    /* TODO: Would it be good if we could abort source statements with ^C? */
-    /* TODO: Check for io error / premature eof */
-    /* TODO: This is skipping comment lines and blank lines, that's probably unnecessary. */
-    for (;;)
-    {
-      if (file.atEnd() == true) break;
-      source_line= "";
-      source_line= file.readLine();
-      QString s= source_line;
-      s= connect_stripper(s, false);
-      if ((s != "") && (s.mid(0,1) != "#") && (s.mid(0,2) != "--"))
-      {
-        statement_edit_widget->insertPlainText(s);
-        if (action_execute(0) == 2)
-        {
-          /*
-            A DBMS-calling statement failed.
-            This doesn't operate exactly as --abort-source-on-error
-            would for MariaDB client, because we only return 2 for
-            statements that call the server and are not multiple.
-          */
-          if (ocelot_abort_source_on_error > 0) break;
-        }
-     }
+    if (parallel_count != 0) source_parallel_run(&file, parallel_count);
+    else source_run(&file);
+    file.close();
+    return 1;
+  }
+
+  /*
+    $BENCH [n=count] [concurrency=count] statement.
+    Not a debugger statement, though it starts with $. See bench_run().
+  */
+  if (QString::compare(text.mid(sub_token_offsets[0], sub_token_lengths[0]), "$BENCH", Qt::CaseInsensitive) == 0)
+  {
+    unsigned long n= 1;
+    int concurrency= 1;
+    int i;
+    for (i= 1; i + 2 < i2; i+= 3)
+    {
+      QString name= text.mid(sub_token_offsets[i], sub_token_lengths[i]);
+      if (text.mid(sub_token_offsets[i + 1], sub_token_lengths[i + 1]) != "=") break;
+      bool is_number;
+      unsigned long value= text.mid(sub_token_offsets[i + 2], sub_token_lengths[i + 2]).toULong(&is_number);
+      if ((is_number == false) || (value == 0)) break;
+      if (QString::compare(name, "n", Qt::CaseInsensitive) == 0) n= value;
+      else if (QString::compare(name, "concurrency", Qt::CaseInsensitive) == 0) concurrency= (value > SOURCE_PARALLEL_MAX) ? SOURCE_PARALLEL_MAX : value;
+      else break;
+    }
+    unsigned statement_length= true_text_size;
+    QString s;
+    if (i < i2) s= text.mid(sub_token_offsets[i], statement_length - (sub_token_offsets[i] - sub_token_offsets[0]));
+    if (s.trimmed() == "")
+    {
+      make_and_put_message_in_result(ER_BENCH, 0, (char*)"");
+      return 1;
     }
-    file.close();
-    /* Without the following, the final line of source would go into the history twice. */
-    *additional_result= TOKEN_KEYWORD_SOURCE;
+    bench_run(s, n, concurrency);
     return 1;
   }
 
@@ -7722,7 +11704,8 @@ int MainWindow::execute_client_statement(QString text, int *additional_result)
   }
   if (statement_type == TOKEN_KEYWORD_NOPAGER)
   {
-    make_and_put_message_in_result(ER_NOPAGER, 0, (char*)"");
+    ocelot_pager_is_on= false;
+    make_and_put_message_in_result(ER_OK, 0, (char*)"");
     return 1;
   }
   if (statement_type == TOKEN_KEYWORD_NOTEE) /* see comment=tee+hist */
@@ -7733,7 +11716,18 @@ int MainWindow::execute_client_statement(QString text, int *additional_result)
   }
   if (statement_type == TOKEN_KEYWORD_PAGER)
   {
-    make_and_put_message_in_result(ER_PAGER, 0, (char*)"");
+    /*
+      Everything as far as statement end is the pager command. Compare TEE.
+      PAGER without a command means: the last one, or $PAGER, or less.
+      Result sets then go to the pager via export_result_set(), see export_file_for_result().
+    */
+    QString s;
+    unsigned statement_length= /* text.size() */ true_text_size;
+    if (i2 >= 2) s= text.mid(sub_token_offsets[1], statement_length - (sub_token_offsets[1] - sub_token_offsets[0]));
+    else s= "";
+    if (s.trimmed() != "") ocelot_pager= s.trimmed();
+    ocelot_pager_is_on= true;
+    make_and_put_message_in_result(ER_OK, 0, (char*)"");
     return 1;
   }
   if (statement_type == TOKEN_KEYWORD_PRINT)
@@ -8247,6 +12241,14 @@ int MainWindow::execute_client_statement(QString text, int *additional_result)
         ocelot_history_max_row_count= ccn;
         make_and_put_message_in_result(ER_OK, 0, (char*)""); return 1;
       }
+      if (QString::compare(text.mid(sub_token_offsets[1], sub_token_lengths[1]), "ocelot_history_max_result_bytes", Qt::CaseInsensitive) == 0)
+      {
+        QString ccn= connect_stripper(text.mid(sub_token_offsets[3], sub_token_lengths[3]), false);
+        if (ccn.toInt() < 0) { make_and_put_message_in_result(ER_ILLEGAL_VALUE, 0, (char*)""); return 1; }
+        ocelot_history_max_result_bytes= ccn.toInt();
+        history_result_add(QByteArray()); /* evicts if the new budget is smaller */
+        make_and_put_message_in_result(ER_OK, 0, (char*)""); return 1;
+      }
       if (QString::compare(text.mid(sub_token_offsets[1], sub_token_lengths[1]), "ocelot_menu_text_color", Qt::CaseInsensitive) == 0)
       {
         QString ccn= canonical_color_name(connect_stripper(text.mid(sub_token_offsets[3], sub_token_lengths[3]), false));
@@ -8348,6 +12350,65 @@ int MainWindow::execute_client_statement(QString text, int *additional_result)
         ocelot_raw= i;
         make_and_put_message_in_result(ER_OK, 0, (char*)""); return 1;
       }
+      if (QString::compare(text.mid(sub_token_offsets[1], sub_token_lengths[1]), "ocelot_grid_lazy_blob_length", Qt::CaseInsensitive) == 0)
+      {
+        QString ccn= connect_stripper(text.mid(sub_token_offsets[3], sub_token_lengths[3]), false);
+        if (ccn.toInt() < 0) { make_and_put_message_in_result(ER_ILLEGAL_VALUE, 0, (char*)""); return 1; }
+        ocelot_grid_lazy_blob_length= ccn.toInt();
+        make_and_put_message_in_result(ER_OK, 0, (char*)""); return 1;
+      }
+      if (QString::compare(text.mid(sub_token_offsets[1], sub_token_lengths[1]), "ocelot_export_format", Qt::CaseInsensitive) == 0)
+      {
+        QString ccn= connect_stripper(text.mid(sub_token_offsets[3], sub_token_lengths[3]), false).toLower();
+        if ((ccn != "") && (ccn != "csv") && (ccn != "tsv") && (ccn != "jsonl") && (ccn != "insert")
+         && (ccn != "html") && (ccn != "xml"))
+        { make_and_put_message_in_result(ER_ILLEGAL_VALUE, 0, (char*)""); return 1; }
+        ocelot_export_format= ccn;
+        make_and_put_message_in_result(ER_OK, 0, (char*)""); return 1;
+      }
+      if (QString::compare(text.mid(sub_token_offsets[1], sub_token_lengths[1]), "ocelot_export_file", Qt::CaseInsensitive) == 0)
+      {
+        ocelot_export_file= connect_stripper(text.mid(sub_token_offsets[3], sub_token_lengths[3]), false);
+        make_and_put_message_in_result(ER_OK, 0, (char*)""); return 1;
+      }
+      if (QString::compare(text.mid(sub_token_offsets[1], sub_token_lengths[1]), "ocelot_prepared_statement_cache", Qt::CaseInsensitive) == 0)
+      {
+        QString ccn= connect_stripper(text.mid(sub_token_offsets[3], sub_token_lengths[3]), false);
+        if ((ccn.toInt() < 0) || (ccn.toInt() > 1000)) { make_and_put_message_in_result(ER_ILLEGAL_VALUE, 0, (char*)""); return 1; }
+        ocelot_prepared_statement_cache= ccn.toInt();
+        if (ocelot_prepared_statement_cache == 0)
+        {
+          for (unsigned int i= 0; i < MYSQL_MAX_CONNECTIONS; ++i) prepared_statement_cache_clear(i);
+        }
+        make_and_put_message_in_result(ER_OK, 0, (char*)""); return 1;
+      }
+      if (QString::compare(text.mid(sub_token_offsets[1], sub_token_lengths[1]), "ocelot_source_batch_size", Qt::CaseInsensitive) == 0)
+      {
+        QString ccn= connect_stripper(text.mid(sub_token_offsets[3], sub_token_lengths[3]), false);
+        if (ccn.toInt() < 0) { make_and_put_message_in_result(ER_ILLEGAL_VALUE, 0, (char*)""); return 1; }
+        ocelot_source_batch_size= ccn.toInt();
+        make_and_put_message_in_result(ER_OK, 0, (char*)""); return 1;
+      }
+      if (QString::compare(text.mid(sub_token_offsets[1], sub_token_lengths[1]), "ocelot_statement_profile", Qt::CaseInsensitive) == 0)
+      {
+        QString ccn= connect_stripper(text.mid(sub_token_offsets[3], sub_token_lengths[3]), false);
+        if ((ccn.toInt() < 0) || (ccn.toInt() > 1)) { make_and_put_message_in_result(ER_ILLEGAL_VALUE, 0, (char*)""); return 1; }
+        ocelot_statement_profile= ccn.toInt();
+        if (ocelot_statement_profile == 0) profile_stop();
+        make_and_put_message_in_result(ER_OK, 0, (char*)""); return 1;
+      }
+      if (QString::compare(text.mid(sub_token_offsets[1], sub_token_lengths[1]), "ocelot_statement_timing", Qt::CaseInsensitive) == 0)
+      {
+        QString ccn= connect_stripper(text.mid(sub_token_offsets[3], sub_token_lengths[3]), false);
+        if ((ccn.toInt() < 0) || (ccn.toInt() > 2)) { make_and_put_message_in_result(ER_ILLEGAL_VALUE, 0, (char*)""); return 1; }
+        ocelot_statement_timing= ccn.toInt();
+        if ((ocelot_statement_timing == 0) && (is_headless == false))
+        {
+          statusBar()->clearMessage();
+          statusBar()->hide();
+        }
+        make_and_put_message_in_result(ER_OK, 0, (char*)""); return 1;
+      }
     }
   }
 
@@ -8686,6 +12747,296 @@ void MainWindow::widget_sizer()
 }
 
 
+/*
+  Server-side profile of each statement, if ocelot_statement_profile = 1.
+  performance_schema: a side connection, MYSQL_PROFILE_CONNECTION, so
+  the main session's state (warnings, last insert id, status variables,
+  performance_schema history) isn't changed by the profiling itself.
+  profile_start() enables the stage instruments and the history
+  consumers (that needs UPDATE privilege on performance_schema, and it's
+  for the whole server; if it fails we get less). It saves the rows that
+  it changes, and profile_stop() puts them back. After each statement
+  on the main connection, we look up the main connection's latest
+  top-level statement event, the stages nested in it, and the waits
+  between its EVENT_ID and END_EVENT_ID.
+  If the server has performance_schema off we just say so. SET profiling
+  would work, but it's on the main session, so it would change what the
+  main session says (SHOW PROFILES, warnings) and cost round trips there.
+  The queries go through the side connection's executor, so the GUI
+  isn't frozen and Run|Kill works if performance_schema is slow.
+  The first statement after the option is turned on isn't profiled,
+  profile_start() happens at the end of its diagnostics.
+*/
+#define PROFILE_MODE_OFF 0
+#define PROFILE_MODE_PERFORMANCE_SCHEMA 1
+#define PROFILE_MODE_FAILED 2
+static int profile_mode= PROFILE_MODE_OFF;
+static int profile_connection_id= -1;          /* the main connection's id when profile_thread_id was found */
+static QString profile_thread_id;              /* the main connection's performance_schema.threads.THREAD_ID */
+static QString profile_last_event_id;          /* so the same statement event isn't shown twice */
+static unsigned int profile_statement_count= 0; /* so a CALL with several results is profiled once */
+static QStringList profile_saved_instruments;  /* "ENABLED,TIMED" for each of profile_saved_instrument_names */
+static QStringList profile_saved_instrument_names;
+static QStringList profile_saved_consumers;    /* names of consumers that were ENABLED = 'NO' */
+
+/*
+  On MYSQL_PROFILE_CONNECTION. Returns NULL if error or no result set. Caller frees.
+*/
+MYSQL_RES *MainWindow::profile_query(QString query)
+{
+  QByteArray q= query.toUtf8();
+  MYSQL_RES *res;
+  int result= dbms_executor_run(MYSQL_PROFILE_CONNECTION, DBMS_EXECUTOR_REAL_QUERY, q.constData(), q.size(), &res);
+  if (result != 0) return NULL;
+  return res;
+}
+
+/* 'a','b','c' for an IN list */
+static QString profile_in_list(QStringList names)
+{
+  QString s;
+  for (int i= 0; i < names.size(); ++i)
+  {
+    if (i > 0) s.append(",");
+    s.append("'" + QString(names[i]).replace("\\", "\\\\").replace("'", "''") + "'");
+  }
+  return s;
+}
+
+/* Picoseconds e.g. performance_schema TIMER_WAIT, as milliseconds */
+static QString profile_ms(const char *picoseconds)
+{
+  if (picoseconds == NULL) return "?";
+  return QString::number(QString(picoseconds).toDouble() / 1000000000, 'f', 3);
+}
+
+/* stage/sql/checking permissions -> checking permissions */
+static QString profile_short_name(const char *event_name)
+{
+  QString s= QString::fromUtf8(event_name);
+  if (s.startsWith("stage/")) return s.mid(s.lastIndexOf('/') + 1);
+  return s;
+}
+
+/* Returns "" if ok, else an error message. */
+QString MainWindow::profile_start()
+{
+  QString error;
+  if (options_and_connect(MYSQL_PROFILE_CONNECTION) != 0)
+  {
+    error= source_parallel_error_text(&mysql[MYSQL_PROFILE_CONNECTION]);
+    profile_mode= PROFILE_MODE_FAILED;
+    return error;
+  }
+  bool is_performance_schema= false;
+  MYSQL_RES *res= profile_query("SELECT @@performance_schema");
+  MYSQL_ROW row;
+  if (res != NULL)
+  {
+    row= lmysql->ldbms_mysql_fetch_row(res);
+    if ((row != NULL) && (row[0] != NULL) && (strcmp(row[0], "1") == 0)) is_performance_schema= true;
+    lmysql->ldbms_mysql_free_result(res);
+  }
+  profile_connection_id= -1;
+  profile_last_event_id= "";
+  if (is_performance_schema == false)
+  {
+    lmysql->ldbms_mysql_close(&mysql[MYSQL_PROFILE_CONNECTION]);
+    connected[MYSQL_PROFILE_CONNECTION]= 0;
+    profile_mode= PROFILE_MODE_FAILED;
+    return er_strings[er_off + ER_PROFILE_OFF];
+  }
+
+  /* Save what's going to change, for profile_stop() */
+  profile_saved_instruments.clear();
+  profile_saved_instrument_names.clear();
+  profile_saved_consumers.clear();
+  res= profile_query("SELECT NAME, ENABLED, TIMED FROM performance_schema.setup_instruments"
+                     " WHERE NAME LIKE 'stage/%' AND (ENABLED <> 'YES' OR TIMED <> 'YES')");
+  if (res != NULL)
+  {
+    while ((row= lmysql->ldbms_mysql_fetch_row(res)) != NULL)
+    {
+      if ((row[0] == NULL) || (row[1] == NULL) || (row[2] == NULL)) continue;
+      profile_saved_instrument_names.append(QString::fromUtf8(row[0]));
+      profile_saved_instruments.append(QString(row[1]) + "," + QString(row[2]));
+    }
+    lmysql->ldbms_mysql_free_result(res);
+  }
+  res= profile_query("SELECT NAME FROM performance_schema.setup_consumers"
+                     " WHERE NAME IN ('events_statements_current', 'events_statements_history',"
+                     " 'events_stages_current', 'events_stages_history_long',"
+                     " 'events_waits_current', 'events_waits_history_long')"
+                     " AND ENABLED <> 'YES'");
+  if (res != NULL)
+  {
+    while ((row= lmysql->ldbms_mysql_fetch_row(res)) != NULL)
+    {
+      if (row[0] != NULL) profile_saved_consumers.append(QString::fromUtf8(row[0]));
+    }
+    lmysql->ldbms_mysql_free_result(res);
+  }
+
+  /* Errors are ignored, e.g. no privilege; the defaults may be enough. Then there's nothing to put back. */
+  if (profile_saved_instrument_names.size() != 0)
+  {
+    profile_query("UPDATE performance_schema.setup_instruments SET ENABLED = 'YES', TIMED = 'YES'"
+                  " WHERE NAME IN (" + profile_in_list(profile_saved_instrument_names) + ")");
+    if (lmysql->ldbms_mysql_errno(&mysql[MYSQL_PROFILE_CONNECTION]) != 0)
+    {
+      profile_saved_instruments.clear();
+      profile_saved_instrument_names.clear();
+    }
+  }
+  if (profile_saved_consumers.size() != 0)
+  {
+    profile_query("UPDATE performance_schema.setup_consumers SET ENABLED = 'YES'"
+                  " WHERE NAME IN (" + profile_in_list(profile_saved_consumers) + ")");
+    if (lmysql->ldbms_mysql_errno(&mysql[MYSQL_PROFILE_CONNECTION]) != 0) profile_saved_consumers.clear();
+  }
+  profile_mode= PROFILE_MODE_PERFORMANCE_SCHEMA;
+  return "";
+}
+
+/*
+  For SET ocelot_statement_profile = 0, CONNECT, reconnect, and ~MainWindow.
+  Put back the instruments and consumers that profile_start() changed,
+  and close the profile connection; profile_capture() calls
+  profile_start() again if it's still wanted, which reconnects.
+  Instruments are grouped by their old ENABLED,TIMED so it's at most four UPDATEs.
+*/
+void MainWindow::profile_stop()
+{
+  if ((profile_mode == PROFILE_MODE_PERFORMANCE_SCHEMA) && (connected[MYSQL_PROFILE_CONNECTION] != 0))
+  {
+    QStringList enabled_timed_list= profile_saved_instruments;
+    enabled_timed_list.removeDuplicates();
+    for (int i= 0; i < enabled_timed_list.size(); ++i)
+    {
+      QStringList names;
+      for (int j= 0; j < profile_saved_instruments.size(); ++j)
+      {
+        if (profile_saved_instruments[j] == enabled_timed_list[i]) names.append(profile_saved_instrument_names[j]);
+      }
+      QStringList enabled_timed= enabled_timed_list[i].split(",");
+      profile_query("UPDATE performance_schema.setup_instruments SET ENABLED = '" + enabled_timed[0]
+                    + "', TIMED = '" + enabled_timed[1] + "' WHERE NAME IN (" + profile_in_list(names) + ")");
+    }
+    if (profile_saved_consumers.size() != 0)
+      profile_query("UPDATE performance_schema.setup_consumers SET ENABLED = 'NO'"
+                    " WHERE NAME IN (" + profile_in_list(profile_saved_consumers) + ")");
+  }
+  profile_saved_instruments.clear();
+  profile_saved_instrument_names.clear();
+  profile_saved_consumers.clear();
+  if (connected[MYSQL_PROFILE_CONNECTION] != 0)
+  {
+    lmysql->ldbms_mysql_close(&mysql[MYSQL_PROFILE_CONNECTION]);
+    connected[MYSQL_PROFILE_CONNECTION]= 0;
+  }
+  profile_mode= PROFILE_MODE_OFF;
+}
+
+/*
+  Called twice from put_diagnostics_in_result(): first with
+  is_end == false before it looks at the main connection, then with
+  is_end == true when it's done, which is when profile_start() happens.
+  Returns what to add to the result, or "".
+*/
+QString MainWindow::profile_capture(bool is_end)
+{
+  if (ocelot_statement_profile == 0) return "";
+  if ((connections_dbms[0] != DBMS_MYSQL) && (connections_dbms[0] != DBMS_MARIADB)) return "";
+  if (is_end == true)
+  {
+    if (profile_mode == PROFILE_MODE_OFF)
+    {
+      QString error= profile_start();
+      if (error != "") return "\nProfile: " + error;
+    }
+    return "";
+  }
+  if (profile_mode != PROFILE_MODE_PERFORMANCE_SCHEMA) return "";
+  if (profile_statement_count == statement_edit_widget->statement_count) return "";
+
+  QString s;
+  MYSQL_RES *res;
+  MYSQL_ROW row;
+
+  /* performance_schema. Find the main connection's THREAD_ID if it's changed, e.g. after CONNECT. */
+  if ((profile_connection_id != statement_edit_widget->dbms_connection_id) || (profile_thread_id == ""))
+  {
+    profile_thread_id= "";
+    res= profile_query("SELECT THREAD_ID FROM performance_schema.threads WHERE PROCESSLIST_ID = "
+                       + QString::number(statement_edit_widget->dbms_connection_id));
+    if (res == NULL) return "";
+    row= lmysql->ldbms_mysql_fetch_row(res);
+    if ((row != NULL) && (row[0] != NULL)) profile_thread_id= row[0];
+    lmysql->ldbms_mysql_free_result(res);
+    if (profile_thread_id == "") return "";
+    profile_connection_id= statement_edit_widget->dbms_connection_id;
+  }
+  res= profile_query("SELECT EVENT_ID, END_EVENT_ID, TIMER_WAIT, ROWS_EXAMINED, ROWS_SENT, ROWS_AFFECTED,"
+                     " CREATED_TMP_TABLES, CREATED_TMP_DISK_TABLES, SORT_ROWS, NO_INDEX_USED"
+                     " FROM performance_schema.events_statements_history"
+                     " WHERE THREAD_ID = " + profile_thread_id +
+                     " AND (NESTING_EVENT_TYPE IS NULL OR NESTING_EVENT_TYPE = 'TRANSACTION')"
+                     " ORDER BY EVENT_ID DESC LIMIT 1");
+  if (res == NULL) return "";
+  row= lmysql->ldbms_mysql_fetch_row(res);
+  if ((row == NULL) || (row[0] == NULL) || (profile_last_event_id == row[0]))
+  {
+    lmysql->ldbms_mysql_free_result(res);
+    return "";
+  }
+  profile_statement_count= statement_edit_widget->statement_count;
+  profile_last_event_id= row[0];
+  QString event_id= row[0];
+  QString end_event_id= (row[1] == NULL) ? "" : row[1];
+  s= "\nProfile: " + profile_ms(row[2]) + " ms";
+  s.append(", rows examined " + QString(row[3]));
+  s.append(", rows sent " + QString(row[4]));
+  s.append(", rows affected " + QString(row[5]));
+  if ((row[6] != NULL) && (strcmp(row[6], "0") != 0))
+    s.append(", tmp tables " + QString(row[6]) + " (" + QString(row[7]) + " on disk)");
+  if ((row[8] != NULL) && (strcmp(row[8], "0") != 0)) s.append(", sort rows " + QString(row[8]));
+  if ((row[9] != NULL) && (strcmp(row[9], "0") != 0)) s.append(", no index used");
+  lmysql->ldbms_mysql_free_result(res);
+
+  res= profile_query("SELECT EVENT_NAME, TIMER_WAIT FROM performance_schema.events_stages_history_long"
+                     " WHERE THREAD_ID = " + profile_thread_id +
+                     " AND NESTING_EVENT_ID = " + event_id +
+                     " ORDER BY EVENT_ID");
+  if (res != NULL)
+  {
+    QString stages;
+    while ((row= lmysql->ldbms_mysql_fetch_row(res)) != NULL)
+    {
+      stages.append((stages == "") ? "\nStages: " : ", ");
+      stages.append(profile_short_name(row[0]) + " " + profile_ms(row[1]));
+    }
+    lmysql->ldbms_mysql_free_result(res);
+    if (stages != "") s.append(stages + " ms");
+  }
+  if (end_event_id == "") return s;
+  res= profile_query("SELECT EVENT_NAME, COUNT(*), SUM(TIMER_WAIT) FROM performance_schema.events_waits_history_long"
+                     " WHERE THREAD_ID = " + profile_thread_id +
+                     " AND EVENT_ID > " + event_id + " AND EVENT_ID <= " + end_event_id +
+                     " GROUP BY EVENT_NAME ORDER BY 3 DESC LIMIT 5");
+  if (res != NULL)
+  {
+    QString waits;
+    while ((row= lmysql->ldbms_mysql_fetch_row(res)) != NULL)
+    {
+      waits.append((waits == "") ? "\nWaits: " : ", ");
+      waits.append(profile_short_name(row[0]) + " " + QString(row[1]) + " x " + profile_ms(row[2]) + " ms");
+    }
+    lmysql->ldbms_mysql_free_result(res);
+    s.append(waits);
+  }
+  return s;
+}
+
 /*
   If the response to a MySQL query is an error, put error information
   in statement_edit_widget->result and return error number. Else return 0.
@@ -8728,6 +13079,10 @@ void MainWindow::put_diagnostics_in_result(unsigned int connection_number)
   }
 #endif
 
+  /* See profile_capture(). The side connection doesn't change what the main connection says. */
+  QString profile;
+  if (connection_number == MYSQL_MAIN_CONNECTION) profile= profile_capture(false);
+
   mysql_errno_result= lmysql->ldbms_mysql_errno(&mysql[connection_number]);
   mysql_warning_count= lmysql->ldbms_mysql_warning_count(&mysql[connection_number]);
   if (mysql_errno_result == 0)
@@ -8790,6 +13145,8 @@ void MainWindow::put_diagnostics_in_result(unsigned int connection_number)
     s2= lmysql->ldbms_mysql_error(&mysql[connection_number]);
     s1.append(s2);
   }
+  if (connection_number == MYSQL_MAIN_CONNECTION) profile.append(profile_capture(true));
+  s1.append(profile);
   statement_edit_widget->result= s1;
 }
 
@@ -8835,6 +13192,73 @@ void MainWindow::make_and_append_message_in_result(
 }
 
 
+/*
+  Fast paths for tokenize(), which otherwise goes through a long
+  series of ifs for every character. Each returns the offset of the
+  first character that tokenize() must look at the slow way.
+  They stop at \0, and at special_token_first (pass 0 if there is no
+  special_token), so that the check for special_token still happens
+  everywhere it used to.
+  tokenize_skip_till() is where most of the time goes for a dump with
+  long strings, so with SSE2 it looks at 8 QChars at a time.
+  bench/bench_tokenize.cpp measures tokens per second.
+*/
+static int tokenize_skip_till(const QChar *text, int char_offset, int text_length, QChar expected_char)
+{
+  const unsigned short *p= (const unsigned short*) text;
+  unsigned short e= expected_char.unicode();
+  int i= char_offset;
+#if defined(__SSE2__)
+  __m128i expected= _mm_set1_epi16((short) e);
+  __m128i zero= _mm_setzero_si128();
+  for (; i + 8 <= text_length; i+= 8)
+  {
+    __m128i chunk= _mm_loadu_si128((const __m128i*) (p + i));
+    __m128i hits= _mm_or_si128(_mm_cmpeq_epi16(chunk, expected), _mm_cmpeq_epi16(chunk, zero));
+    int mask= _mm_movemask_epi8(hits);
+    if (mask != 0)
+    {
+      int bit= 0;
+      while ((mask & (1 << bit)) == 0) ++bit;
+      return i + (bit / 2);
+    }
+  }
+#endif
+  for (; i < text_length; ++i)
+  {
+    if ((p[i] == e) || (p[i] == 0)) break;
+  }
+  return i;
+}
+
+static int tokenize_skip_white_space(const QChar *text, int char_offset, int text_length, QChar special_token_first)
+{
+  int i;
+  for (i= char_offset; i < text_length; ++i)
+  {
+    unsigned short c= text[i].unicode();
+    if ((c == 0) || (c > ' ') || (c == special_token_first.unicode())) break;
+  }
+  return i;
+}
+
+/* $, 0 to 9, A to Z, a to z, _, DEL, >127 are "part_of_token" in tokenize() whatever precedes them */
+static int tokenize_skip_word(const QChar *text, int char_offset, int text_length, QChar special_token_first)
+{
+  int i;
+  for (i= char_offset; i < text_length; ++i)
+  {
+    unsigned short c= text[i].unicode();
+    if (c == special_token_first.unicode()) break;
+    if ((c >= 'a') && (c <= 'z')) continue;
+    if ((c >= 'A') && (c <= 'Z')) continue;
+    if ((c >= '0') && (c <= '9')) continue;
+    if ((c == '_') || (c == '$') || (c >= 127)) continue;
+    break;
+  }
+  return i;
+}
+
 /*
    tokenize(): Produce a list of tokens given an SQL statement using MySQL rules.
 
@@ -8899,6 +13323,15 @@ void MainWindow::tokenize(QChar *text, int text_length, int *token_lengths,
   QChar version_inside_comment[6];
   int n;
 
+  /*
+    The fast paths (see tokenize_skip_*) never go past a character that
+    could be the start of special_token, so they can't change results.
+  */
+  int special_token_length= special_token.length();
+  const QChar *special_token_data= special_token.constData();
+  QChar special_token_first= 0;
+  if (special_token_length > 0) special_token_first= special_token_data[0];
+
   expected_char_at_comment_end=' ';
   comment_behaviour=passed_comment_behaviour;
   token_number= 0;
@@ -8912,15 +13345,14 @@ next_char:
   if (char_offset >= text_length) goto string_end; /* this is the usual check for end of string */
   if (text[char_offset] == 0) goto string_end;  /* \0 end of string (probably will never happen) */
   /* Check whether special_token occurs at this point. */
+  if ((special_token_length > 0) && (text[char_offset] == special_token_first))
   {
-    int special_token_length, special_token_offset;
-    special_token_length= special_token.length();
-    if ((special_token_length > 0)
-    &&  (char_offset + special_token_length <= text_length))
+    int special_token_offset;
+    if (char_offset + special_token_length <= text_length)
     {
       for (special_token_offset= 0; special_token_offset < special_token_length; ++special_token_offset)
       {
-        QChar special_token_char= special_token.at(special_token_offset);
+        QChar special_token_char= special_token_data[special_token_offset];
         if (special_token_char != text[char_offset+special_token_offset]) break;
       }
       if (special_token_offset == special_token_length)
@@ -9128,6 +13560,12 @@ next_char:
 part_of_token:
   ++char_offset;
   ++token_lengths[token_number];
+  {
+    /* Rest of a word: no need to go round the ifs for each letter */
+    int word_end= tokenize_skip_word(text, char_offset, text_length, special_token_first);
+    token_lengths[token_number]+= word_end - char_offset;
+    char_offset= word_end;
+  }
   goto next_char;
 string_end:
   if (token_lengths[token_number] > 0) token_lengths[token_number + 1]= 0;
@@ -9136,6 +13574,8 @@ string_end:
 white_space:
   if (token_lengths[token_number] > 0) ++token_number;
   ++char_offset;
+  if (token_number < (max_tokens - 1))
+    char_offset= tokenize_skip_white_space(text, char_offset, text_length, special_token_first);
   goto next_token;
 string_starting_with_bracket_start:
   for (;;)
@@ -9237,6 +13677,12 @@ skip_till_expected_char:
 skip_till_expected_char_2:
   ++char_offset;
   ++token_lengths[token_number];
+  {
+    /* Inside '...' or a comment etc.: jump to the next possible end */
+    int expected_char_offset= tokenize_skip_till(text, char_offset, text_length, expected_char);
+    token_lengths[token_number]+= expected_char_offset - char_offset;
+    char_offset= expected_char_offset;
+  }
   if (char_offset >= text_length) goto string_end;
   if (text[char_offset] == 0) goto string_end;
   if (text[char_offset] != expected_char) goto skip_till_expected_char_2;
@@ -9367,950 +13813,998 @@ int MainWindow::token_type(QChar *token, int token_length)
 }
 
 
+/*
+  Sorted list of keywords.
+  If you change this, you must also change the TOKEN_KEYWORD list.
+  We consider introducers e.g. _UTF8 to be equivalent to reserved words.
+  It's static so it's made once, not on the stack for every tokens_to_keywords_lookup().
+*/
+#define MAX_KEYWORD_LENGTH 34
+struct keywords {
+   char  chars[MAX_KEYWORD_LENGTH];
+   unsigned short int reserved_flags;
+   unsigned short int built_in_function_flags;
+   unsigned short int token_keyword;
+};
+
+static const keywords strvalues[]=
+{
+  {"?", 0, 0, TOKEN_KEYWORD_QUESTIONMARK}, /* Ocelot keyword, although tokenize() regards it as an operator */
+  {"ABORT", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_ABORT},
+  {"ABS", 0, FLAG_VERSION_ALL, TOKEN_KEYWORD_ABS},
+  {"ACCESSIBLE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_ACCESSIBLE},
+  {"ACOS", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ACOS},
+  {"ACTION", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_ACTION},
+  {"ADD", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_ADD},
+  {"ADDDATE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ADDDATE},
+  {"ADDTIME", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ADDTIME},
+  {"AES_DECRYPT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_AES_DECRYPT},
+  {"AES_ENCRYPT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_AES_ENCRYPT},
+  {"AFTER", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_AFTER},
+  {"AGAINST", 0, 0, TOKEN_KEYWORD_AGAINST},
+  {"ALGORITHM", 0, 0, TOKEN_KEYWORD_ALGORITHM},
+  {"ALL", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_ALL},
+  {"ALTER", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_ALTER},
+  {"ALWAYS", 0, 0, TOKEN_KEYWORD_ALWAYS},
+  {"ANALYZE", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_ANALYZE},
+  {"AND", FLAG_VERSION_ALL | FLAG_VERSION_LUA, 0, TOKEN_KEYWORD_AND},
+  {"ANY_VALUE", 0, FLAG_VERSION_MYSQL_ALL, TOKEN_KEYWORD_ANY_VALUE},
+  {"AREA", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_AREA}, /* deprecated in MySQL 5.7.6 */
+  {"AS", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_AS},
+  {"ASBINARY", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ASBINARY}, /* deprecated in MySQL 5.7.6 */
+  {"ASC", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_ASC},
+  {"ASCII", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ASCII},
+  {"ASENSITIVE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_ASENSITIVE},
+  {"ASIN", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ASIN},
+  {"ASTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ASTEXT}, /* deprecated in MySQL 5.7.6 */
+  {"ASWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ASWKB}, /* deprecated in MySQL 5.7.6 */
+  {"ASWKT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ASWKT}, /* deprecated in MySQL 5.7.6 */
+  {"ASYMMETRIC_DECRYPT", 0, FLAG_VERSION_MYSQL_ALL, TOKEN_KEYWORD_ASYMMETRIC_DECRYPT},
+  {"ASYMMETRIC_DERIVE", 0, FLAG_VERSION_MYSQL_ALL, TOKEN_KEYWORD_ASYMMETRIC_DERIVE},
+  {"ASYMMETRIC_ENCRYPT", 0, FLAG_VERSION_MYSQL_ALL, TOKEN_KEYWORD_ASYMMETRIC_ENCRYPT},
+  {"ASYMMETRIC_SIGN", 0, FLAG_VERSION_MYSQL_ALL, TOKEN_KEYWORD_ASYMMETRIC_SIGN},
+  {"ASYMMETRIC_VERIFY", 0, FLAG_VERSION_MYSQL_ALL, TOKEN_KEYWORD_ASYMMETRIC_VERIFY},
+  {"ATAN", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ATAN},
+  {"ATAN2", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ATAN2},
+  {"ATTACH", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_ATTACH},
+  {"AUTOINCREMENT", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_AUTOINCREMENT},
+  {"AVG", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_AVG},
+  {"BEFORE", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_BEFORE},
+  {"BEGIN", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_BEGIN},
+  {"BENCHMARK", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_BENCHMARK},
+  {"BETWEEN", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_BETWEEN},
+  {"BFILE", 0, 0, TOKEN_KEYWORD_BFILE},
+  {"BIGINT", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_BIGINT},
+  {"BIN", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_BIN},
+  {"BINARY", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_BINARY},
+  {"BINARY_DOUBLE", 0, 0, TOKEN_KEYWORD_BINARY_DOUBLE},
+  {"BINARY_FLOAT", 0, 0, TOKEN_KEYWORD_BINARY_FLOAT},
+  {"BINLOG", FLAG_VERSION_MARIADB_10_0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_BINLOG},
+  {"BINLOG_GTID_POS", FLAG_VERSION_MARIADB_10_0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_BINLOG_GTID_POS},
+  {"BIT", 0, 0, TOKEN_KEYWORD_BIT},
+  {"BIT_AND", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_BIT_AND},
+  {"BIT_COUNT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_BIT_COUNT},
+  {"BIT_LENGTH", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_BIT_LENGTH},
+  {"BIT_OR", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_BIT_OR},
+  {"BIT_XOR", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_BIT_XOR},
+  {"BLOB", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_BLOB},
+  {"BOOL", 0, 0, TOKEN_KEYWORD_BOOL},
+  {"BOOLEAN", 0, 0, TOKEN_KEYWORD_BOOLEAN},
+  {"BOTH", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_BOTH},
+  {"BREAK", FLAG_VERSION_LUA, 0, TOKEN_KEYWORD_BREAK},
+  {"BUFFER", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_BUFFER}, /* deprecated in MySQL 5.7.6 */
+  {"BY", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_BY},
+  {"CALL", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_CALL},
+  {"CASCADE", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_CASCADE},
+  {"CASE", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_CASE},
+  {"CAST", 0, FLAG_VERSION_ALL, TOKEN_KEYWORD_CAST},
+  {"CEIL", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_CEIL},
+  {"CEILING", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_CEILING},
+  {"CENTROID", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_CENTROID}, /* deprecated in MySQL 5.7.6 */
+  {"CHANGE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_CHANGE},
+  {"CHANGES", 0, FLAG_VERSION_TARANTOOL, TOKEN_KEYWORD_CHANGES},
+  {"CHAR", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, FLAG_VERSION_ALL, TOKEN_KEYWORD_CHAR},
+  {"CHARACTER", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_CHARACTER},
+  {"CHARACTER_LENGTH", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_CHARACTER_LENGTH},
+  {"CHARSET", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_CHARSET},  /* + Ocelot keyword */
+  {"CHAR_LENGTH", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_CHAR_LENGTH},
+  {"CHECK", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_CHECK},
+  {"CLEAR", 0, 0, TOKEN_KEYWORD_CLEAR}, /* Ocelot keyword */
+  {"CLOSE", 0, 0, TOKEN_KEYWORD_CLOSE},
+  {"COALESCE", 0, FLAG_VERSION_ALL, TOKEN_KEYWORD_COALESCE},
+  {"COERCIBILITY", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_COERCIBILITY},
+  {"COLLATE", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_COLLATE},
+  {"COLLATION", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_COLLATION},
+  {"COLUMN", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_COLUMN},
+  {"COLUMN_ADD", FLAG_VERSION_MARIADB_10_0, FLAG_VERSION_MARIADB_10_0, TOKEN_KEYWORD_COLUMN_ADD},
+  {"COLUMN_CHECK", FLAG_VERSION_MARIADB_10_0, FLAG_VERSION_MARIADB_10_0, TOKEN_KEYWORD_COLUMN_CHECK},
+  {"COLUMN_CREATE", FLAG_VERSION_MARIADB_10_0, FLAG_VERSION_MARIADB_10_0, TOKEN_KEYWORD_COLUMN_CREATE},
+  {"COLUMN_DELETE", FLAG_VERSION_MARIADB_10_0, FLAG_VERSION_MARIADB_10_0, TOKEN_KEYWORD_COLUMN_DELETE},
+  {"COLUMN_EXISTS", FLAG_VERSION_MARIADB_10_0, FLAG_VERSION_MARIADB_10_0, TOKEN_KEYWORD_COLUMN_EXISTS},
+  {"COLUMN_GET", FLAG_VERSION_MARIADB_10_0, FLAG_VERSION_MARIADB_10_0, TOKEN_KEYWORD_COLUMN_GET},
+  {"COLUMN_JSON", FLAG_VERSION_MARIADB_10_0, FLAG_VERSION_MARIADB_10_0, TOKEN_KEYWORD_COLUMN_JSON},
+  {"COLUMN_LIST", FLAG_VERSION_MARIADB_10_0, FLAG_VERSION_MARIADB_10_0, TOKEN_KEYWORD_COLUMN_LIST},
+  {"COMMENT", 0, 0, TOKEN_KEYWORD_COMMENT},
+  {"COMMIT", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_COMMIT},
+  {"COMPACT", 0, 0, TOKEN_KEYWORD_COMPACT},
+  {"COMPRESS", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_COMPRESS},
+  {"COMPRESSED", 0, 0, TOKEN_KEYWORD_COMPRESSED},
+  {"COMPRESSION", 0, 0, TOKEN_KEYWORD_COMPRESSION},
+  {"CONCAT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_CONCAT},
+  {"CONCAT_WS", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_CONCAT_WS},
+  {"CONDITION", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_CONDITION},
+  {"CONFLICT", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_CONFLICT},
+  {"CONNECT", 0, 0, TOKEN_KEYWORD_CONNECT}, /* Ocelot keyword */
+  {"CONNECTION_ID", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_CONNECTION_ID},
+  {"CONSTRAINT", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_CONSTRAINT},
+  {"CONTAINS", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_CONTAINS}, /* deprecated in MySQL 5.7.6 */
+  {"CONTINUE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_CONTINUE},
+  {"CONV", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_CONV},
+  {"CONVERT", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_CONVERT},
+  {"CONVERT_TZ", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_CONVERT_TZ},
+  {"CONVEXHULL", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_CONVEXHULL}, /* deprecated in MySQL 5.7.6 */
+  {"COS", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_COS},
+  {"COT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_COT},
+  {"COUNT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_COUNT},
+  {"CRC32", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_CRC32},
+  {"CREATE", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_CREATE},
+  {"CREATE_ASYMMETRIC_PRIV_KEY", 0, FLAG_VERSION_MYSQL_ALL, TOKEN_KEYWORD_CREATE_ASYMMETRIC_PRIV_KEY},
+  {"CREATE_ASYMMETRIC_PUB_KEY", 0, FLAG_VERSION_MYSQL_ALL, TOKEN_KEYWORD_CREATE_ASYMMETRIC_PUB_KEY},
+  {"CREATE_DH_PARAMETERS", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_CREATE_DH_PARAMETERS},
+  {"CREATE_DIGEST", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_CREATE_DIGEST},
+  {"CROSS", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_CROSS},
+  {"CROSSES", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_CROSSES}, /* deprecated in MySQL 5.7.6 */
+  {"CUME_DIST", 0, FLAG_VERSION_MARIADB_10_2_2, TOKEN_KEYWORD_CUME_DIST},
+  {"CURDATE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_CURDATE},
+  {"CURRENT", 0, 0, TOKEN_KEYWORD_CURRENT},
+  {"CURRENT_DATE", FLAG_VERSION_ALL, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_CURRENT_DATE},
+  {"CURRENT_ROLE", FLAG_VERSION_MARIADB_10_0, 0, TOKEN_KEYWORD_CURRENT_ROLE},
+  {"CURRENT_TIME", FLAG_VERSION_ALL, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_CURRENT_TIME},
+  {"CURRENT_TIMESTAMP", FLAG_VERSION_ALL, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_CURRENT_TIMESTAMP},
+  {"CURRENT_USER", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_CURRENT_USER},
+  {"CURSOR", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_CURSOR},
+  {"CURTIME", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_CURTIME},
+  {"DATABASE", FLAG_VERSION_ALL, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_DATABASE},
+  {"DATABASES", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_DATABASES},
+  {"DATE", 0, FLAG_VERSION_ALL, TOKEN_KEYWORD_DATE},
+  {"DATEDIFF", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_DATEDIFF},
+  {"DATETIME", 0, FLAG_VERSION_TARANTOOL, TOKEN_KEYWORD_DATETIME},
+  {"DATE_ADD", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_DATE_ADD},
+  {"DATE_FORMAT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_DATE_FORMAT},
+  {"DATE_SUB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_DATE_SUB},
+  {"DAY", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_DAY},
+  {"DAYNAME", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_DAYNAME},
+  {"DAYOFMONTH", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_DAYOFMONTH},
+  {"DAYOFWEEK", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_DAYOFWEEK},
+  {"DAYOFYEAR", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_DAYOFYEAR},
+  {"DAY_HOUR", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_DAY_HOUR},
+  {"DAY_MICROSECOND", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_DAY_MICROSECOND},
+  {"DAY_MINUTE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_DAY_MINUTE},
+  {"DAY_SECOND", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_DAY_SECOND},
+  {"DEALLOCATE", 0, 0, TOKEN_KEYWORD_DEALLOCATE},
+  {"DEC", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_DEC},
+  {"DECIMAL", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_DECIMAL},
+  {"DECLARE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_DECLARE},
+  {"DECODE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_DECODE},
+  {"DECODE_HISTOGRAM", FLAG_VERSION_MARIADB_10_0, FLAG_VERSION_MARIADB_10_0, TOKEN_KEYWORD_DECODE_HISTOGRAM},
+  {"DEFAULT", FLAG_VERSION_ALL, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_DEFAULT},
+  {"DEFERRABLE", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_DEFERRABLE},
+  {"DEFERRED", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_DEFERRED},
+  {"DEGREES", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_DEGREES},
+  {"DELAYED", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_DELAYED},
+  {"DELETE", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_DELETE},
+  {"DELIMITER", 0, 0, TOKEN_KEYWORD_DELIMITER}, /* Ocelot keyword */
+  {"DENSE_RANK", 0, FLAG_VERSION_MARIADB_10_2_2, TOKEN_KEYWORD_DENSE_RANK},
+  {"DESC", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_DESC},
+  {"DESCRIBE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_DESCRIBE},
+  {"DES_DECRYPT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_DES_DECRYPT}, /* deprecated in MySQL 5.7.6 */
+  {"DES_ENCRYPT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_DES_ENCRYPT}, /* deprecated in MySQL 5.7.6 */
+  {"DETACH", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_DETACH},
+  {"DETERMINISTIC", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_DETERMINISTIC},
+  {"DIMENSION", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_DIMENSION}, /* deprecated in MySQL 5.7.6 */
+  {"DIRECTORY", 0, 0, TOKEN_KEYWORD_DIRECTORY},
+  {"DISJOINT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_DISJOINT}, /* deprecated in MySQL 5.7.6 */
+  {"DISTANCE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_DISTANCE}, /* deprecated in MySQL 5.7.6 */
+  {"DISTINCT", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_DISTINCT},
+  {"DISTINCTROW", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_DISTINCTROW},
+  {"DIV", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_DIV},
+  {"DO", FLAG_VERSION_LUA, 0, TOKEN_KEYWORD_DO},
+  {"DOUBLE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_DOUBLE},
+  {"DROP", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_DROP},
+  {"DUAL", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_DUAL},
+  {"DUPLICATE", 0, 0, TOKEN_KEYWORD_DUPLICATE},
+  {"DYNAMIC", 0, 0, TOKEN_KEYWORD_DYNAMIC},
+  {"EACH", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_EACH},
+  {"EDIT", 0, 0, TOKEN_KEYWORD_EDIT}, /* Ocelot keyword */
+  {"EGO", 0, 0, TOKEN_KEYWORD_EGO}, /* Ocelot keyword */
+  {"ELSE", FLAG_VERSION_ALL | FLAG_VERSION_LUA, 0, TOKEN_KEYWORD_ELSE},
+  {"ELSEIF", FLAG_VERSION_MYSQL_OR_MARIADB_ALL | FLAG_VERSION_LUA, 0, TOKEN_KEYWORD_ELSEIF},
+  {"ELT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ELT},
+  {"ENABLE", 0, 0, TOKEN_KEYWORD_ENABLE},
+  {"ENCLOSED", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_ENCLOSED},
+  {"ENCODE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ENCODE},
+  {"ENCRYPT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ENCRYPT}, /* deprecated in MySQL 5.7.6 */
+  {"END", FLAG_VERSION_TARANTOOL | FLAG_VERSION_LUA, 0, TOKEN_KEYWORD_END},
+  {"ENDPOINT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ENDPOINT}, /* deprecated in MySQL 5.7.6 */
+  {"ENUM", 0, 0, TOKEN_KEYWORD_ENUM},
+  {"ENVELOPE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ENVELOPE}, /* deprecated in MySQL 5.7.6 */
+  {"EQUALS", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_EQUALS}, /* deprecated in MySQL 5.7.6 */
+  {"ESCAPE", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_ESCAPE},
+  {"ESCAPED", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_ESCAPED},
+  {"EVENT", 0, 0, TOKEN_KEYWORD_EVENT},
+  {"EXCEPT", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_EXCEPT},
+  {"EXCHANGE", 0, 0, TOKEN_KEYWORD_EXCHANGE},
+  {"EXCLUSIVE", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_EXCLUSIVE},
+  {"EXECUTE", 0, 0, TOKEN_KEYWORD_EXECUTE},
+  {"EXISTS", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_EXISTS},
+  {"EXIT", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_EXIT},
+  {"EXP", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_EXP},
+  {"EXPANSION", 0, 0, TOKEN_KEYWORD_EXPANSION},
+  {"EXPLAIN", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_EXPLAIN},
+  {"EXPORT", 0, 0, TOKEN_KEYWORD_EXPORT},
+  {"EXPORT_SET", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_EXPORT_SET},
+  {"EXTERIORRING", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_EXTERIORRING}, /* deprecated in MySQL 5.7.6 */
+  {"EXTRACT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_EXTRACT},
+  {"EXTRACTVALUE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_EXTRACTVALUE},
+  {"FAIL", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_FAIL},
+  {"FALSE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL | FLAG_VERSION_LUA, 0, TOKEN_KEYWORD_FALSE},
+  {"FETCH", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_FETCH},
+  {"FIELD", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_FIELD},
+  {"FILE", 0, 0, TOKEN_KEYWORD_FILE},
+  {"FIND_IN_SET", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_FIND_IN_SET},
+  {"FIRST", 0, 0, TOKEN_KEYWORD_FIRST}, /* MariaDB 10.2 nonreserved */
+  {"FIRST_VALUE", 0, 0, TOKEN_KEYWORD_FIRST_VALUE}, /* MariaDB 10.2 nonreserved -- or, maybe not in MariaDB 10.2*/
+  {"FIXED", 0, 0, TOKEN_KEYWORD_FIXED},
+  {"FLOAT", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_FLOAT},
+  {"FLOAT4", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_FLOAT4},
+  {"FLOAT8", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_FLOAT8},
+  {"FLOOR", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_FLOOR},
+  {"FLUSH", 0, 0, TOKEN_KEYWORD_FLUSH},
+  {"FOLLOWING", FLAG_VERSION_MARIADB_10_2_2, 0, TOKEN_KEYWORD_FOLLOWING},
+  {"FOLLOWS", FLAG_VERSION_MYSQL_5_7 | FLAG_VERSION_MARIADB_10_2_3, 0, TOKEN_KEYWORD_FOLLOWS},
+  {"FOR", FLAG_VERSION_ALL | FLAG_VERSION_LUA, 0, TOKEN_KEYWORD_FOR},
+  {"FORCE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_FORCE},
+  {"FOREIGN", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_FOREIGN},
+  {"FORMAT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_FORMAT},
+  {"FOUND_ROWS", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_FOUND_ROWS},
+  {"FROM", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_FROM},
+  {"FROM_BASE64", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_FROM_BASE64},
+  {"FROM_DAYS", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_FROM_DAYS},
+  {"FROM_UNIXTIME", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_FROM_UNIXTIME},
+  {"FULL", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_FULL},
+  {"FULLTEXT", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_FULLTEXT},
+  {"FUNCTION", FLAG_VERSION_LUA, 0, TOKEN_KEYWORD_FUNCTION},
+  {"GENERAL", 0, 0, TOKEN_KEYWORD_GENERAL},
+  {"GENERATED", FLAG_VERSION_MYSQL_5_7, 0, TOKEN_KEYWORD_GENERATED},
+  {"GEOMCOLLFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_GEOMCOLLFROMTEXT}, /* deprecated in MySQL 5.7.6 */
+  {"GEOMCOLLFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_GEOMCOLLFROMWKB}, /* deprecated in MySQL 5.7.6 */
+  {"GEOMETRY", 0, 0, TOKEN_KEYWORD_GEOMETRY},
+  {"GEOMETRYCOLLECTION", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_GEOMETRYCOLLECTION},
+  {"GEOMETRYCOLLECTIONFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_GEOMETRYCOLLECTIONFROMTEXT}, /* deprecated in MySQL 5.7.6 */
+  {"GEOMETRYCOLLECTIONFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_GEOMETRYCOLLECTIONFROMWKB}, /* deprecated in MySQL 5.7.6 */
+  {"GEOMETRYFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_GEOMETRYFROMTEXT}, /* deprecated in MySQL 5.7.6 */
+  {"GEOMETRYFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_GEOMETRYFROMWKB}, /* deprecated in MySQL 5.7.6 */
+  {"GEOMETRYN", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_GEOMETRYN}, /* deprecated in MySQL 5.7.6 */
+  {"GEOMETRYTYPE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_GEOMETRYTYPE}, /* deprecated in MySQL 5.7.6 */
+  {"GEOMFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_GEOMFROMTEXT},/* deprecated in MySQL 5.7.6 */
+  {"GEOMFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_GEOMFROMWKB}, /* deprecated in MySQL 5.7.6 */
+  {"GET", FLAG_VERSION_MYSQL_5_6, 0, TOKEN_KEYWORD_GET},
+  {"GET_FORMAT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_GET_FORMAT},
+  {"GET_LOCK", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_GET_LOCK},
+  {"GLENGTH", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_GLENGTH}, /* deprecated in MySQL 5.7.6 */
+  {"GLOB", FLAG_VERSION_TARANTOOL, FLAG_VERSION_TARANTOOL, TOKEN_KEYWORD_GLOB},
+  {"GO", 0, 0, TOKEN_KEYWORD_GO}, /* Ocelot keyword */
+  {"GRANT", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_GRANT},
+  {"GREATEST", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_GREATEST},
+  {"GROUP", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_GROUP},
+  {"GROUP_CONCAT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_GROUP_CONCAT},
+  {"GTID_SUBSET", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_GTID_SUBSET},
+  {"GTID_SUBTRACT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_GTID_SUBTRACT},
+  {"HANDLER", 0, 0, TOKEN_KEYWORD_HANDLER},
+  {"HAVING", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_HAVING},
+  {"HELP", 0, 0, TOKEN_KEYWORD_HELP}, /* Ocelot keyword */
+  {"HEX", 0, FLAG_VERSION_ALL, TOKEN_KEYWORD_HEX},
+  {"HIGH_PRIORITY", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_HIGH_PRIORITY},
+  {"HOUR", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_HOUR},
+  {"HOUR_MICROSECOND", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_HOUR_MICROSECOND},
+  {"HOUR_MINUTE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_HOUR_MINUTE},
+  {"HOUR_SECOND", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_HOUR_SECOND},
+  {"IF", FLAG_VERSION_ALL | FLAG_VERSION_LUA, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_IF},
+  {"IFNULL", 0, FLAG_VERSION_ALL, TOKEN_KEYWORD_IFNULL},
+  {"IGNORE", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_IGNORE},
+  {"IMMEDIATE", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_IMMEDIATE},
+  {"IMPORT", 0, 0, TOKEN_KEYWORD_IMPORT},
+  {"IN", FLAG_VERSION_ALL | FLAG_VERSION_LUA, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_IN},
+  {"INDEX", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_INDEX},
+  {"INDEXED", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_INDEXED},
+  {"INET6_ATON", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_INET6_ATON},
+  {"INET6_NTOA", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_INET6_NTOA},
+  {"INET_ATON", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_INET_ATON},
+  {"INET_NTOA", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_INET_NTOA},
+  {"INFILE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_INFILE},
+  {"INITIALLY", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_INITIALLY},
+  {"INNER", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_INNER},
+  {"INOUT", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_INOUT},
+  {"INSENSITIVE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_INSENSITIVE},
+  {"INSERT", FLAG_VERSION_ALL, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_INSERT},
+  {"INSTALL", 0, 0, TOKEN_KEYWORD_INSTALL},
+  {"INSTEAD", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_INSTEAD},
+  {"INSTR", 0, FLAG_VERSION_ALL, TOKEN_KEYWORD_INSTR},
+  {"INT", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_INT},
+  {"INT1", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_INT1},
+  {"INT2", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_INT2},
+  {"INT3", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_INT3},
+  {"INT4", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_INT4},
+  {"INT8", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_INT8},
+  {"INTEGER", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_INTEGER},
+  {"INTERIORRINGN", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_INTERIORRINGN}, /* deprecated in MySQL 5.7.6 */
+  {"INTERSECT", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_INTERSECT},
+  {"INTERSECTS", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_INTERSECTS}, /* deprecated in MySQL 5.7.6 */
+  {"INTERVAL", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_INTERVAL},
+  {"INTO", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_INTO},
+  {"IO_AFTER_GTIDS", FLAG_VERSION_MYSQL_5_6, 0, TOKEN_KEYWORD_IO_AFTER_GTIDS},
+  {"IO_BEFORE_GTIDS", FLAG_VERSION_MYSQL_5_6, 0, TOKEN_KEYWORD_IO_BEFORE_GTIDS},
+  {"IS", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_IS},
+  {"ISCLOSED", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ISCLOSED}, /* deprecated in MySQL 5.7.6 */
+  {"ISEMPTY", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ISEMPTY}, /* deprecated in MySQL 5.7.6 */
+  {"ISNULL", 0, FLAG_VERSION_ALL, TOKEN_KEYWORD_ISNULL},
+  {"ISSIMPLE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ISSIMPLE}, /* deprecated in MySQL 5.7.6 */
+  {"IS_FREE_LOCK", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_IS_FREE_LOCK},
+  {"IS_IPV4", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_IS_IPV4},
+  {"IS_IPV4_COMPAT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_IS_IPV4_COMPAT},
+  {"IS_IPV4_MAPPED", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_IS_IPV4_MAPPED},
+  {"IS_IPV6", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_IS_IPV6},
+  {"IS_USED_LOCK", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_IS_USED_LOCK},
+  {"ITERATE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_ITERATE},
+  {"JOIN", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_JOIN},
+  {"JSON", 0, 0, TOKEN_KEYWORD_JSON},
+  {"JSON_APPEND", 0, FLAG_VERSION_MYSQL_5_7 | FLAG_VERSION_MARIADB_10_2_3, TOKEN_KEYWORD_JSON_APPEND},
+  {"JSON_ARRAY", 0, FLAG_VERSION_MYSQL_5_7 | FLAG_VERSION_MARIADB_10_2_3 | FLAG_VERSION_TARANTOOL, TOKEN_KEYWORD_JSON_ARRAY},
+  {"JSON_ARRAY_APPEND", 0, FLAG_VERSION_MYSQL_5_7 | FLAG_VERSION_MARIADB_10_2_3, TOKEN_KEYWORD_JSON_ARRAY_APPEND},
+  {"JSON_ARRAY_INSERT", 0, FLAG_VERSION_MYSQL_5_7, TOKEN_KEYWORD_JSON_ARRAY_INSERT},
+  {"JSON_CONTAINS", 0, FLAG_VERSION_MYSQL_5_7, TOKEN_KEYWORD_JSON_CONTAINS},
+  {"JSON_CONTAINS_PATH", 0, FLAG_VERSION_MYSQL_5_7 | FLAG_VERSION_MARIADB_10_2_3, TOKEN_KEYWORD_JSON_CONTAINS_PATH},
+  {"JSON_DEPTH", 0, FLAG_VERSION_MYSQL_5_7, TOKEN_KEYWORD_JSON_DEPTH},
+  {"JSON_EXTRACT", 0, FLAG_VERSION_MYSQL_5_7 | FLAG_VERSION_MARIADB_10_2_3 | FLAG_VERSION_TARANTOOL, TOKEN_KEYWORD_JSON_EXTRACT},
+  {"JSON_INSERT", 0, FLAG_VERSION_MYSQL_5_7 | FLAG_VERSION_TARANTOOL, TOKEN_KEYWORD_JSON_INSERT},
+  {"JSON_KEYS", 0, FLAG_VERSION_MYSQL_5_7, TOKEN_KEYWORD_JSON_KEYS},
+  {"JSON_LENGTH", 0, FLAG_VERSION_MYSQL_5_7, TOKEN_KEYWORD_JSON_LENGTH},
+  {"JSON_MERGE", 0, FLAG_VERSION_MYSQL_5_7 | FLAG_VERSION_MARIADB_10_2_3, TOKEN_KEYWORD_JSON_MERGE},
+  {"JSON_OBJECT", 0, FLAG_VERSION_MYSQL_5_7 | FLAG_VERSION_MARIADB_10_2_3 | FLAG_VERSION_TARANTOOL, TOKEN_KEYWORD_JSON_OBJECT},
+  {"JSON_QUERY", 0, FLAG_VERSION_MARIADB_10_2_3, TOKEN_KEYWORD_JSON_QUERY},
+  {"JSON_QUOTE", 0, FLAG_VERSION_MYSQL_5_7 | FLAG_VERSION_MARIADB_10_2_3, TOKEN_KEYWORD_JSON_QUOTE},
+  {"JSON_REMOVE", 0, FLAG_VERSION_MYSQL_5_7 | FLAG_VERSION_TARANTOOL, TOKEN_KEYWORD_JSON_REMOVE},
+  {"JSON_REPLACE", 0, FLAG_VERSION_MYSQL_5_7 | FLAG_VERSION_TARANTOOL, TOKEN_KEYWORD_JSON_REPLACE},
+  {"JSON_SEARCH", 0, FLAG_VERSION_MYSQL_5_7, TOKEN_KEYWORD_JSON_SEARCH},
+  {"JSON_SET", 0, FLAG_VERSION_MYSQL_5_7 | FLAG_VERSION_TARANTOOL, TOKEN_KEYWORD_JSON_SET},
+  {"JSON_TYPE", 0, FLAG_VERSION_MYSQL_5_7 | FLAG_VERSION_TARANTOOL, TOKEN_KEYWORD_JSON_TYPE},
+  {"JSON_UNQUOTE", 0, FLAG_VERSION_MYSQL_5_7, TOKEN_KEYWORD_JSON_UNQUOTE},
+  {"JSON_VALID", 0, FLAG_VERSION_MYSQL_5_7 | FLAG_VERSION_MARIADB_10_2_3 | FLAG_VERSION_TARANTOOL, TOKEN_KEYWORD_JSON_VALID},
+  {"JSON_VALUE", 0, FLAG_VERSION_MARIADB_10_2_3, TOKEN_KEYWORD_JSON_VALUE},
+  {"JULIANDAY", 0, FLAG_VERSION_TARANTOOL, TOKEN_KEYWORD_JULIANDAY},
+  {"KEY", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_KEY},
+  {"KEYS", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_KEYS},
+  {"KILL", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_KILL},
+  {"LAG", 0, 0, TOKEN_KEYWORD_LAG}, /* MariaDB 10.2 nonreserved -- or, maybe not in MariaDB 10.2 */
+  {"LANGUAGE", 0, 0, TOKEN_KEYWORD_LANGUAGE},
+  {"LAST", 0, 0, TOKEN_KEYWORD_LAST}, /* MariaDB 10.2 nonreserved */
+  {"LAST_DAY", FLAG_VERSION_MARIADB_10_0, FLAG_VERSION_MARIADB_10_0, TOKEN_KEYWORD_LAST_DAY},
+  {"LAST_INSERT_ID", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_LAST_INSERT_ID},
+  {"LAST_VALUE", 0, 0, TOKEN_KEYWORD_LAST_VALUE}, /* MariaDB 10.2 nonreserved */
+  {"LCASE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_LCASE},
+  {"LEAD", 0, 0, TOKEN_KEYWORD_LEAD}, /* MariaDB 10.2 nonreserved -- or, maybe not in MariaDB 10.2 */
+  {"LEADING", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_LEADING},
+  {"LEAST", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_LEAST},
+  {"LEAVE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_LEAVE},
+  {"LEFT", FLAG_VERSION_ALL, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_LEFT},
+  {"LENGTH", 0, FLAG_VERSION_ALL, TOKEN_KEYWORD_LENGTH},
+  {"LEVEL", 0, 0, TOKEN_KEYWORD_LEVEL},
+  {"LIKE", FLAG_VERSION_ALL, FLAG_VERSION_TARANTOOL, TOKEN_KEYWORD_LIKE},
+  {"LIMIT", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_LIMIT},
+  {"LINEAR", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_LINEAR},
+  {"LINEFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_LINEFROMTEXT}, /* deprecated in MySQL 5.7.6 */
+  {"LINEFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_LINEFROMWKB}, /* deprecated in MySQL 5.7.6 */
+  {"LINES", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_LINES},
+  {"LINESTRING", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_LINESTRING},
+  {"LINESTRINGFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_LINESTRINGFROMTEXT}, /* deprecated in MySQL 5.7.6 */
+  {"LINESTRINGFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_LINESTRINGFROMWKB}, /* deprecated in MySQL 5.7.6 */
+  {"LN", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_LN},
+  {"LOAD", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_LOAD},
+  {"LOAD_FILE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_LOAD_FILE},
+  {"LOCAL", FLAG_VERSION_LUA, 0, TOKEN_KEYWORD_LOCAL},
+  {"LOCALTIME", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_LOCALTIME},
+  {"LOCALTIMESTAMP", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_LOCALTIMESTAMP},
+  {"LOCATE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_LOCATE},
+  {"LOCK", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_LOCK},
+  {"LOG", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_LOG},
+  {"LOG10", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_LOG10},
+  {"LOG2", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_LOG2},
+  {"LOGFILE", 0, 0, TOKEN_KEYWORD_LOGFILE},
+  {"LONG", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_LONG},
+  {"LONGBLOB", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_LONGBLOB},
+  {"LONGTEXT", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_LONGTEXT},
+  {"LOOP", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_LOOP},
+  {"LOWER", 0, FLAG_VERSION_ALL, TOKEN_KEYWORD_LOWER},
+  {"LOW_PRIORITY", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_LOW_PRIORITY},
+  {"LPAD", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_LPAD},
+  {"LTRIM", 0, FLAG_VERSION_ALL, TOKEN_KEYWORD_LTRIM},
+  {"LUA", 0, FLAG_VERSION_TARANTOOL, TOKEN_KEYWORD_LUA},
+  {"MAKEDATE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MAKEDATE},
+  {"MAKETIME", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MAKETIME},
+  {"MAKE_SET", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MAKE_SET},
+  {"MASTER_BIND", FLAG_VERSION_MYSQL_5_6, 0, TOKEN_KEYWORD_MASTER_BIND},
+  {"MASTER_HEARTBEAT_PERIOD", 0, 0, TOKEN_KEYWORD_MASTER_HEARTBEAT_PERIOD},
+  {"MASTER_POS_WAIT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MASTER_POS_WAIT},
+  {"MASTER_SSL_VERIFY_SERVER_CERT", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_MASTER_SSL_VERIFY_SERVER_CERT},
+  {"MATCH", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_MATCH},
+  {"MAX", 0, FLAG_VERSION_ALL, TOKEN_KEYWORD_MAX},
+  {"MAXVALUE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_MAXVALUE},
+  {"MBRCONTAINS", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MBRCONTAINS},
+  {"MBRCOVEREDBY", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MBRCOVEREDBY},
+  {"MBRCOVERS", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MBRCOVERS},
+  {"MBRDISJOINT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MBRDISJOINT},
+  {"MBREQUAL", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MBREQUAL}, /* deprecated in MySQL 5.7.6 */
+  {"MBREQUALS", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MBREQUALS},
+  {"MBRINTERSECTS", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MBRINTERSECTS},
+  {"MBROVERLAPS", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MBROVERLAPS},
+  {"MBRTOUCHES", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MBRTOUCHES},
+  {"MBRWITHIN", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MBRWITHIN},
+  {"MD5", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MD5},
+  {"MEDIUMBLOB", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_MEDIUMBLOB},
+  {"MEDIUMINT", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_MEDIUMINT},
+  {"MEDIUMTEXT", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_MEDIUMTEXT},
+  {"MICROSECOND", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MICROSECOND},
+  {"MID", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MID},
+  {"MIDDLEINT", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_MIDDLEINT},
+  {"MIN", 0, FLAG_VERSION_ALL, TOKEN_KEYWORD_MIN},
+  {"MINUTE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MINUTE},
+  {"MINUTE_MICROSECOND", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_MINUTE_MICROSECOND},
+  {"MINUTE_SECOND", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_MINUTE_SECOND},
+  {"MLINEFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MLINEFROMTEXT},  /* deprecated in MySQL 5.7.6 */
+  {"MLINEFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MLINEFROMWKB},  /* deprecated in MySQL 5.7.6 */
+  {"MOD", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MOD},
+  {"MODE", 0, 0, TOKEN_KEYWORD_MODE},
+  {"MODIFIES", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_MODIFIES},
+  {"MONTH", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MONTH},
+  {"MONTHNAME", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MONTHNAME},
+  {"MPOINTFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MPOINTFROMTEXT},  /* deprecated in MySQL 5.7.6 */
+  {"MPOINTFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MPOINTFROMWKB}, /* deprecated in MySQL 5.7.6 */
+  {"MPOLYFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MPOLYFROMTEXT}, /* deprecated in MySQL 5.7.6 */
+  {"MPOLYFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MPOLYFROMWKB}, /* deprecated in MySQL 5.7.6 */
+  {"MULTILINESTRING", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MULTILINESTRING},
+  {"MULTILINESTRINGFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MULTILINESTRINGFROMTEXT}, /* deprecated in MySQL 5.7.6 */
+  {"MULTILINESTRINGFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MULTILINESTRINGFROMWKB}, /* deprecated in MySQL 5.7.6 */
+  {"MULTIPOINT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MULTIPOINT},
+  {"MULTIPOINTFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MULTIPOINTFROMTEXT},  /* deprecated in MySQL 5.7.6 */
+  {"MULTIPOINTFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MULTIPOINTFROMWKB}, /* deprecated in MySQL 5.7.6 */
+  {"MULTIPOLYGON", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MULTIPOLYGON},
+  {"MULTIPOLYGONFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MULTIPOLYGONFROMTEXT}, /* deprecated in MySQL 5.7.6 */
+  {"MULTIPOLYGONFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MULTIPOLYGONFROMWKB}, /* deprecated in MySQL 5.7.6 */
+  {"NAME_CONST", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_NAME_CONST},
+  {"NATURAL", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_NATURAL},
+  {"NIL", FLAG_VERSION_LUA, 0, TOKEN_KEYWORD_NIL},
+  {"NO", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_NO},
+  {"NOPAGER", 0, 0, TOKEN_KEYWORD_NOPAGER}, /* Ocelot keyword */
+  {"NOT", FLAG_VERSION_TARANTOOL | FLAG_VERSION_LUA, 0, TOKEN_KEYWORD_NOT},
+  {"NOTEE", 0, 0, TOKEN_KEYWORD_NOTEE}, /* Ocelot keyword */
+  {"NOTNULL", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_NOTNULL},
+  {"NOW", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_NOW},
+  {"NOWARNING", 0, 0, TOKEN_KEYWORD_NOWARNING}, /* Ocelot keyword */
+  {"NO_WRITE_TO_BINLOG", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_NO_WRITE_TO_BINLOG},
+  {"NTH_VALUE", 0, 0, TOKEN_KEYWORD_NTH_VALUE}, /* MariaDB 10.2 nonreserved -- or, maybe not in MariaDB 10.2 */
+  {"NTILE", 0, FLAG_VERSION_MARIADB_10_2_2, TOKEN_KEYWORD_NTILE},
+  {"NULL", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_NULL},
+  {"NULLIF", 0, FLAG_VERSION_ALL, TOKEN_KEYWORD_NULLIF},
+  {"NULLS", 0, 0, TOKEN_KEYWORD_NULLS}, /* MariaDB 10.2 nonreserved  -- or, maybe not in MariaDB 10.2 */
+  {"NUMBER", 0, 0, TOKEN_KEYWORD_NUMBER},
+  {"NUMERIC", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_NUMERIC},
+  {"NUMGEOMETRIES", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_NUMGEOMETRIES}, /* deprecated in MySQL 5.7.6 */
+  {"NUMINTERIORRINGS", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_NUMINTERIORRINGS}, /* deprecated in MySQL 5.7.6 */
+  {"NUMPOINTS", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_NUMPOINTS}, /* deprecated in MySQL 5.7.6 */
+  {"NVARCHAR2", 0, 0, TOKEN_KEYWORD_NVARCHAR2},
+  {"OCT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_OCT},
+  {"OCTET_LENGTH", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_OCTET_LENGTH},
+  {"OF", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_OF},
+  {"OFF", 0, 0, TOKEN_KEYWORD_OFF},
+  {"OFFSET", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_OFFSET},
+  {"OJ", 0, 0, TOKEN_KEYWORD_OJ},
+  {"OLD_PASSWORD", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_OLD_PASSWORD},
+  {"ON", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_ON},
+  {"OPEN", 0, 0, TOKEN_KEYWORD_OPEN},
+  {"OPTIMIZE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_OPTIMIZE},
+  {"OPTIMIZER_COSTS", FLAG_VERSION_MYSQL_5_7, 0, TOKEN_KEYWORD_OPTIMIZER_COSTS},
+  {"OPTION", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_OPTION},
+  {"OPTIONALLY", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_OPTIONALLY},
+  {"OR", FLAG_VERSION_ALL | FLAG_VERSION_LUA, 0, TOKEN_KEYWORD_OR},
+  {"ORD", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ORD},
+  {"ORDER", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_ORDER},
+  {"OUT", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_OUT},
+  {"OUTER", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_OUTER},
+  {"OUTFILE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_OUTFILE},
+  {"OVER", FLAG_VERSION_MARIADB_10_2_2, 0, TOKEN_KEYWORD_OVER},
+  {"OVERLAPS", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_OVERLAPS}, /* deprecated in MySQL 5.7.6 */
+  {"PAGER", 0, 0, TOKEN_KEYWORD_PAGER}, /* Ocelot keyword */
+  {"PARTIAL", 0, 0, TOKEN_KEYWORD_PARTIAL},
+  {"PARTITION", FLAG_VERSION_MYSQL_5_6 | FLAG_VERSION_MARIADB_10_0, 0, TOKEN_KEYWORD_PARTITION},
+  {"PASSWORD", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_PASSWORD}, /* deprecated in MySQL 5.7.6 */
+  {"PERCENT_RANK", 0, FLAG_VERSION_MARIADB_10_2_2, TOKEN_KEYWORD_PERCENT_RANK},
+  {"PERIOD_ADD", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_PERIOD_ADD},
+  {"PERIOD_DIFF", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_PERIOD_DIFF},
+  {"PI", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_PI},
+  {"PLAN", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_PLAN},
+  {"POINT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_POINT},
+  {"POINTFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_POINTFROMTEXT}, /* deprecated in MySQL 5.7.6 */
+  {"POINTFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_POINTFROMWKB}, /* deprecated in MySQL 5.7.6 */
+  {"POINTN", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_POINTN}, /* deprecated in MySQL 5.7.6 */
+  {"POLYFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_POLYFROMTEXT},
+  {"POLYFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_POLYFROMWKB}, /* deprecated in MySQL 5.7 */
+  {"POLYGON", 0, 0, TOKEN_KEYWORD_POLYGON},
+  {"POLYGONFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_POLYGONFROMTEXT}, /* deprecated in MySQL 5.7.6 */
+  {"POLYGONFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_POLYGONFROMWKB}, /* deprecated in MySQL 5.7.6 */
+  {"POSITION", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_POSITION},
+  {"POW", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_POW},
+  {"POWER", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_POWER},
+  {"PRAGMA", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_PRAGMA},
+  {"PRECEDES", FLAG_VERSION_MYSQL_5_7 | FLAG_VERSION_MARIADB_10_2_3, 0, TOKEN_KEYWORD_PRECEDES},
+  {"PRECISION", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_PRECISION},
+  {"PREPARE", 0, 0, TOKEN_KEYWORD_PREPARE},
+  {"PRIMARY", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_PRIMARY},
+  {"PRINT", 0, 0, TOKEN_KEYWORD_PRINT}, /* Ocelot keyword */
+  {"PRINTF", 0, FLAG_VERSION_TARANTOOL, TOKEN_KEYWORD_PRINTF},
+  {"PROCEDURE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_PROCEDURE},
+  {"PROCESS", 0, 0, TOKEN_KEYWORD_PROCESS},
+  {"PROMPT", 0, 0, TOKEN_KEYWORD_PROMPT}, /* Ocelot keyword */
+  {"PROXY", 0, 0, TOKEN_KEYWORD_PROXY},
+  {"PURGE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_PURGE},
+  {"QUARTER", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_QUARTER},
+  {"QUERY", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_QUERY},
+  {"QUIT", 0, 0, TOKEN_KEYWORD_QUIT}, /* Ocelot keyword */
+  {"QUOTE", 0, FLAG_VERSION_ALL, TOKEN_KEYWORD_QUOTE},
+  {"RADIANS", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_RADIANS},
+  {"RAISE", FLAG_VERSION_TARANTOOL, FLAG_VERSION_TARANTOOL, TOKEN_KEYWORD_RAISE},
+  {"RAND", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_RAND},
+  {"RANDOM", 0, FLAG_VERSION_TARANTOOL, TOKEN_KEYWORD_RANDOM},
+  {"RANDOMBLOB", 0, FLAG_VERSION_TARANTOOL, TOKEN_KEYWORD_RANDOMBLOB},
+  {"RANDOM_BYTES", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_RANDOM_BYTES},
+  {"RANGE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_RANGE},
+  {"RANK", 0, FLAG_VERSION_MARIADB_10_2_2, TOKEN_KEYWORD_RANK},
+  {"RAW", 0, 0, TOKEN_KEYWORD_RAW},
+  {"READ", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_READ},
+  {"READS", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_READS},
+  {"READ_WRITE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_READ_WRITE},
+  {"REAL", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_REAL},
+  {"REBUILD", 0, 0, TOKEN_KEYWORD_REBUILD},
+  {"RECURSIVE", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_RECURSIVE},
+  {"REDUNDANT", 0, 0, TOKEN_KEYWORD_REDUNDANT},
+  {"REFERENCES", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_REFERENCES},
+  {"REGEXP", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_REGEXP},
+  {"REHASH", 0, 0, TOKEN_KEYWORD_REHASH}, /* Ocelot keyword */
+  {"REINDEX", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_REINDEX},
+  {"RELEASE", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_RELEASE},
+  {"RELEASE_ALL_LOCKS", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_RELEASE_ALL_LOCKS},
+  {"RELEASE_LOCK", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_RELEASE_LOCK},
+  {"RELOAD", 0, 0, TOKEN_KEYWORD_RELOAD},
+  {"RENAME", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_RENAME},
+  {"REORGANIZE", 0, 0, TOKEN_KEYWORD_REORGANIZE},
+  {"REPAIR", 0, 0, TOKEN_KEYWORD_REPAIR},
+  {"REPEAT", FLAG_VERSION_MYSQL_OR_MARIADB_ALL | FLAG_VERSION_LUA, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_REPEAT},
+  {"REPLACE", FLAG_VERSION_ALL, FLAG_VERSION_ALL, TOKEN_KEYWORD_REPLACE},
+  {"REPLICATION", 0, 0, TOKEN_KEYWORD_REPLICATION},
+  {"REQUIRE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_REQUIRE},
+  {"RESET", 0, 0, TOKEN_KEYWORD_RESET},
+  {"RESETCONNECTION", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_RESETCONNECTION},
+  {"RESIGNAL", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_RESIGNAL},
+  {"RESTRICT", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_RESTRICT},
+  {"RETURN", FLAG_VERSION_MYSQL_OR_MARIADB_ALL | FLAG_VERSION_LUA, 0, TOKEN_KEYWORD_RETURN},
+  {"RETURNS", 0, 0, TOKEN_KEYWORD_RETURNS},
+  {"REVERSE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_REVERSE},
+  {"REVOKE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_REVOKE},
+  {"RIGHT", FLAG_VERSION_ALL, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_RIGHT},
+  {"RLIKE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_RLIKE},
+  {"ROLE", 0, 0, TOKEN_KEYWORD_ROLE},
+  {"ROLLBACK", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_ROLLBACK},
+  {"ROUND", 0, FLAG_VERSION_ALL, TOKEN_KEYWORD_ROUND},
+  {"ROW", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_ROW},
+  {"ROW_COUNT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ROW_COUNT},
+  {"ROW_NUMBER", 0, FLAG_VERSION_MARIADB_10_2_2, TOKEN_KEYWORD_ROW_NUMBER},
+  {"RPAD", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_RPAD},
+  {"RTRIM", 0, FLAG_VERSION_ALL, TOKEN_KEYWORD_RTRIM},
+  {"SAVEPOINT", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_SAVEPOINT},
+  {"SCHEMA", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_SCHEMA},
+  {"SCHEMAS", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_SCHEMAS},
+  {"SECOND", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_SECOND},
+  {"SECOND_MICROSECOND", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_SECOND_MICROSECOND},
+  {"SECURITY", 0, 0, TOKEN_KEYWORD_SECURITY},
+  {"SEC_TO_TIME", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_SEC_TO_TIME},
+  {"SELECT", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_SELECT},
+  {"SENSITIVE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_SENSITIVE},
+  {"SEPARATOR", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_SEPARATOR},
+  {"SERIAL", 0, 0, TOKEN_KEYWORD_SERIAL},
+  {"SERVER", 0, 0, TOKEN_KEYWORD_SERVER},
+  {"SESSION", 0, 0, TOKEN_KEYWORD_SESSION},
+  {"SESSION_USER", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_SESSION_USER},
+  {"SET", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_SET},
+  {"SHA", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_SHA},
+  {"SHA1", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_SHA1},
+  {"SHA2", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_SHA2},
+  {"SHARED", 0, 0, TOKEN_KEYWORD_SHARED},
+  {"SHOW", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_SHOW},
+  {"SHUTDOWN", 0, 0, TOKEN_KEYWORD_SHUTDOWN},
+  {"SIGN", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_SIGN},
+  {"SIGNAL", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_SIGNAL},
+  {"SIMPLE", 0, 0, TOKEN_KEYWORD_SIMPLE},
+  {"SIN", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_SIN},
+  {"SLEEP", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_SLEEP},
+  {"SLOW", 0, 0, TOKEN_KEYWORD_SLOW},
+  {"SMALLINT", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_SMALLINT},
+  {"SONAME", 0, 0, TOKEN_KEYWORD_SONAME},
+  {"SOUNDEX", 0, FLAG_VERSION_ALL, TOKEN_KEYWORD_SOUNDEX},
+  {"SOURCE", 0, 0, TOKEN_KEYWORD_SOURCE}, /* Ocelot keyword */
+  {"SPACE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_SPACE},
+  {"SPATIAL", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_SPATIAL},
+  {"SPECIFIC", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_SPECIFIC},
+  {"SQL", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_SQL},
+  {"SQLEXCEPTION", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_SQLEXCEPTION},
+  {"SQLSTATE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_SQLSTATE},
+  {"SQLWARNING", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_SQLWARNING},
+  {"SQL_BIG_RESULT", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_SQL_BIG_RESULT},
+  {"SQL_CALC_FOUND_ROWS", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_SQL_CALC_FOUND_ROWS},
+  {"SQL_SMALL_RESULT", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_SQL_SMALL_RESULT},
+  {"SQRT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_SQRT},
+  {"SRID", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_SRID},
+  {"SSL", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_SSL},
+  {"START", 0, 0, TOKEN_KEYWORD_START},
+  {"STARTING", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_STARTING},
+  {"STARTPOINT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_STARTPOINT}, /* deprecated in MySQL 5.7.6 */
+  {"STATUS", 0, 0, TOKEN_KEYWORD_STATUS}, /* Ocelot keyword */
+  {"STD", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_STD},
+  {"STDDEV", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_STDDEV},
+  {"STDDEV_POP", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_STDDEV_POP},
+  {"STDDEV_SAMP", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_STDDEV_SAMP},
+  {"STOP", 0, 0, TOKEN_KEYWORD_STOP},
+  {"STORED", FLAG_VERSION_MYSQL_5_7, 0, TOKEN_KEYWORD_STORED},
+  {"STRAIGHT_JOIN", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_STRAIGHT_JOIN},
+  {"STRCMP", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_STRCMP},
+  {"STRFTIME", 0, FLAG_VERSION_TARANTOOL, TOKEN_KEYWORD_STRFTIME},
+  {"STR_TO_DATE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_STR_TO_DATE},
+  {"ST_AREA", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_AREA},
+  {"ST_ASBINARY", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_ASBINARY},
+  {"ST_ASGEOJSON", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_ASGEOJSON},
+  {"ST_ASTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_ASTEXT},
+  {"ST_ASWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_ASWKB},
+  {"ST_ASWKT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_ASWKT},
+  {"ST_BUFFER", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_BUFFER},
+  {"ST_BUFFER_STRATEGY", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_BUFFER_STRATEGY},
+  {"ST_CENTROID", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_CENTROID},
+  {"ST_CONTAINS", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_CONTAINS},
+  {"ST_CONVEXHULL", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_CONVEXHULL},
+  {"ST_CROSSES", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_CROSSES},
+  {"ST_DIFFERENCE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_DIFFERENCE},
+  {"ST_DIMENSION", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_DIMENSION},
+  {"ST_DISJOINT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_DISJOINT},
+  {"ST_DISTANCE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_DISTANCE},
+  {"ST_DISTANCE_SPHERE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_DISTANCE_SPHERE},
+  {"ST_ENDPOINT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_ENDPOINT},
+  {"ST_ENVELOPE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_ENVELOPE},
+  {"ST_EQUALS", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_EQUALS},
+  {"ST_EXTERIORRING", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_EXTERIORRING},
+  {"ST_GEOHASH", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_GEOHASH},
+  {"ST_GEOMCOLLFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_GEOMCOLLFROMTEXT},
+  {"ST_GEOMCOLLFROMTXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_GEOMCOLLFROMTXT},
+  {"ST_GEOMCOLLFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_GEOMCOLLFROMWKB},
+  {"ST_GEOMETRYCOLLECTIONFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_GEOMETRYCOLLECTIONFROMTEXT},
+  {"ST_GEOMETRYCOLLECTIONFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_GEOMETRYCOLLECTIONFROMWKB},
+  {"ST_GEOMETRYFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_GEOMETRYFROMTEXT},
+  {"ST_GEOMETRYFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_GEOMETRYFROMWKB},
+  {"ST_GEOMETRYN", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_GEOMETRYN},
+  {"ST_GEOMETRYTYPE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_GEOMETRYTYPE},
+  {"ST_GEOMFROMGEOJSON", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_GEOMFROMGEOJSON},
+  {"ST_GEOMFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_GEOMFROMTEXT},
+  {"ST_GEOMFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_GEOMFROMWKB},
+  {"ST_INTERIORRINGN", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_INTERIORRINGN},
+  {"ST_INTERSECTION", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_INTERSECTION},
+  {"ST_INTERSECTS", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_INTERSECTS},
+  {"ST_ISCLOSED", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_ISCLOSED},
+  {"ST_ISEMPTY", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_ISEMPTY},
+  {"ST_ISSIMPLE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_ISSIMPLE},
+  {"ST_ISVALID", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_ISVALID},
+  {"ST_LATFROMGEOHASH", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_LATFROMGEOHASH},
+  {"ST_LENGTH", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_LENGTH},
+  {"ST_LINEFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_LINEFROMTEXT},
+  {"ST_LINEFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_LINEFROMWKB},
+  {"ST_LINESTRINGFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_LINESTRINGFROMTEXT},
+  {"ST_LINESTRINGFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_LINESTRINGFROMWKB},
+  {"ST_LONGFROMGEOHASH", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_LONGFROMGEOHASH},
+  {"ST_MAKEENVELOPE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_MAKEENVELOPE},
+  {"ST_MLINEFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_MLINEFROMTEXT},
+  {"ST_MLINEFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_MLINEFROMWKB},
+  {"ST_MPOINTFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_MPOINTFROMTEXT},
+  {"ST_MPOINTFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_MPOINTFROMWKB},
+  {"ST_MPOLYFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_MPOLYFROMTEXT},
+  {"ST_MPOLYFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_MPOLYFROMWKB},
+  {"ST_MULTILINESTRINGFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_MULTILINESTRINGFROMTEXT},
+  {"ST_MULTILINESTRINGFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_MULTILINESTRINGFROMWKB},
+  {"ST_MULTIPOINTFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_MULTIPOINTFROMTEXT},
+  {"ST_MULTIPOINTFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_MULTIPOINTFROMWKB},
+  {"ST_MULTIPOLYGONFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_MULTIPOLYGONFROMTEXT},
+  {"ST_MULTIPOLYGONFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_MULTIPOLYGONFROMWKB},
+  {"ST_NUMGEOMETRIES", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_NUMGEOMETRIES},
+  {"ST_NUMINTERIORRING", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_NUMINTERIORRING},
+  {"ST_NUMINTERIORRINGS", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_NUMINTERIORRINGS},
+  {"ST_NUMPOINTS", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_NUMPOINTS},
+  {"ST_OVERLAPS", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_OVERLAPS},
+  {"ST_POINTFROMGEOHASH", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_POINTFROMGEOHASH},
+  {"ST_POINTFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_POINTFROMTEXT},
+  {"ST_POINTFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_POINTFROMWKB},
+  {"ST_POINTN", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_POINTN},
+  {"ST_POLYFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_POLYFROMTEXT},
+  {"ST_POLYFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_POLYFROMWKB},
+  {"ST_POLYGONFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_POLYGONFROMTEXT},
+  {"ST_POLYGONFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_POLYGONFROMWKB},
+  {"ST_SIMPLIFY", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_SIMPLIFY},
+  {"ST_SRID", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_SRID},
+  {"ST_STARTPOINT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_STARTPOINT},
+  {"ST_SYMDIFFERENCE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_SYMDIFFERENCE},
+  {"ST_TOUCHES", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_TOUCHES},
+  {"ST_UNION", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_UNION},
+  {"ST_VALIDATE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_VALIDATE},
+  {"ST_WITHIN", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_WITHIN},
+  {"ST_X", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_X},
+  {"ST_Y", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_Y},
+  {"SUBDATE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_SUBDATE},
+  {"SUBSTR", 0, FLAG_VERSION_ALL, TOKEN_KEYWORD_SUBSTR},
+  {"SUBSTRING", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_SUBSTRING},
+  {"SUBSTRING_INDEX", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_SUBSTRING_INDEX},
+  {"SUBTIME", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_SUBTIME},
+  {"SUM", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_SUM},
+  {"SUPER", 0, 0, TOKEN_KEYWORD_SUPER},
+  {"SYSDATE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_SYSDATE},
+  {"SYSTEM", 0, 0, TOKEN_KEYWORD_SYSTEM}, /* Ocelot keyword */
+  {"SYSTEM_USER", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_SYSTEM_USER},
+  {"TABLE", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_TABLE},
+  {"TABLESPACE", 0, 0, TOKEN_KEYWORD_TABLESPACE},
+  {"TAN", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_TAN},
+  {"TEE", 0, 0, TOKEN_KEYWORD_TEE}, /* Ocelot keyword */
+  {"TEMP", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_TEMP},
+  {"TEMPORARY", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_TEMPORARY},
+  {"TERMINATED", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_TERMINATED},
+  {"THEN", FLAG_VERSION_ALL | FLAG_VERSION_LUA, 0, TOKEN_KEYWORD_THEN},
+  {"TIME", 0, FLAG_VERSION_ALL, TOKEN_KEYWORD_TIME},
+  {"TIMEDIFF", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_TIMEDIFF},
+  {"TIMESTAMP", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_TIMESTAMP},
+  {"TIMESTAMPADD", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_TIMESTAMPADD},
+  {"TIMESTAMPDIFF", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_TIMESTAMPDIFF},
+  {"TIME_FORMAT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_TIME_FORMAT},
+  {"TIME_TO_SEC", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_TIME_TO_SEC},
+  {"TINYBLOB", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_TINYBLOB},
+  {"TINYINT", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_TINYINT},
+  {"TINYTEXT", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_TINYTEXT},
+  {"TO", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_TO},
+  {"TOTAL_CHANGES", 0, FLAG_VERSION_TARANTOOL, TOKEN_KEYWORD_TOTAL_CHANGES},
+  {"TOUCHES", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_TOUCHES}, /* deprecated in MySQL 5.7.6 */
+  {"TO_BASE64", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_TO_BASE64},
+  {"TO_DAYS", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_TO_DAYS},
+  {"TO_SECONDS", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_TO_SECONDS},
+  {"TRAILING", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_TRAILING},
+  {"TRANSACTION", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_TRANSACTION},
+  {"TRIGGER", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_TRIGGER},
+  {"TRIM", 0, FLAG_VERSION_ALL, TOKEN_KEYWORD_TRIM},
+  {"TRUE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL | FLAG_VERSION_LUA, 0, TOKEN_KEYWORD_TRUE},
+  {"TRUNCATE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_TRUNCATE},
+  {"TYPEOF", 0, FLAG_VERSION_TARANTOOL, TOKEN_KEYWORD_TYPEOF},
+  {"UCASE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_UCASE},
+  {"UNBOUNDED", 0, 0, TOKEN_KEYWORD_UNBOUNDED},
+  {"UNCOMPRESS", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_UNCOMPRESS},
+  {"UNCOMPRESSED_LENGTH", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_UNCOMPRESSED_LENGTH},
+  {"UNDO", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_UNDO},
+  {"UNHEX", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_UNHEX},
+  {"UNICODE", 0, FLAG_VERSION_TARANTOOL, TOKEN_KEYWORD_UNICODE},
+  {"UNINSTALL", 0, 0, TOKEN_KEYWORD_UNINSTALL},
+  {"UNION", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_UNION},
+  {"UNIQUE", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_UNIQUE},
+  {"UNIX_TIMESTAMP", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_UNIX_TIMESTAMP},
+  {"UNKNOWN", 0, 0, TOKEN_KEYWORD_UNKNOWN},
+  {"UNLOCK", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_UNLOCK},
+  {"UNSIGNED", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_UNSIGNED},
+  {"UNTIL", FLAG_VERSION_LUA, 0, TOKEN_KEYWORD_UNTIL},
+  {"UPDATE", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_UPDATE},
+  {"UPDATEXML", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_UPDATEXML},
+  {"UPPER", 0, FLAG_VERSION_ALL, TOKEN_KEYWORD_UPPER},
+  {"USAGE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_USAGE},
+  {"USE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_USE}, /* Ocelot keyword, also reserved word */
+  {"USER", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_USER},
+  {"USING", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_USING},
+  {"UTC_DATE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_UTC_DATE},
+  {"UTC_TIME", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_UTC_TIME},
+  {"UTC_TIMESTAMP", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_UTC_TIMESTAMP},
+  {"UUID", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_UUID},
+  {"UUID_SHORT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_UUID_SHORT},
+  {"VACUUM", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_VACUUM},
+  {"VALIDATE_PASSWORD_STRENGTH", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_VALIDATE_PASSWORD_STRENGTH},
+  {"VALIDATION", 0, 0, TOKEN_KEYWORD_VALIDATION},
+  {"VALUES", FLAG_VERSION_ALL, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_VALUES},
+  {"VARBINARY", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_VARBINARY},
+  {"VARCHAR", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_VARCHAR},
+  {"VARCHAR2", 0, 0, TOKEN_KEYWORD_VARCHAR2},
+  {"VARCHARACTER", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_VARCHARACTER},
+  {"VARIANCE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_VARIANCE},
+  {"VARYING", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_VARYING},
+  {"VAR_POP", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_VAR_POP},
+  {"VAR_SAMP", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_VAR_SAMP},
+  {"VERSION", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_VERSION},
+  {"VIEW", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_VIEW},
+  {"VIRTUAL", FLAG_VERSION_MYSQL_5_7 | FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_VIRTUAL},
+  {"WAIT_FOR_EXECUTED_GTID_SET", 0, FLAG_VERSION_MYSQL_ALL, TOKEN_KEYWORD_WAIT_FOR_EXECUTED_GTID_SET},
+  {"WAIT_UNTIL_SQL_THREAD_AFTER_GTIDS", 0, FLAG_VERSION_MYSQL_ALL, TOKEN_KEYWORD_WAIT_UNTIL_SQL_THREAD_AFTER_GTIDS},
+  {"WARNINGS", 0, 0, TOKEN_KEYWORD_WARNINGS}, /* Ocelot keyword */
+  {"WEEK", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_WEEK},
+  {"WEEKDAY", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_WEEKDAY},
+  {"WEEKOFYEAR", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_WEEKOFYEAR},
+  {"WEIGHT_STRING", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_WEIGHT_STRING},
+  {"WHEN", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_WHEN},
+  {"WHERE", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_WHERE},
+  {"WHILE", FLAG_VERSION_ALL | FLAG_VERSION_LUA, 0, TOKEN_KEYWORD_WHILE},
+  {"WITH", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_WITH},
+  {"WITHIN", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_WITHIN}, /* deprecated in MySQL 5.7.6 */
+  {"WITHOUT", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_WITHOUT},
+  {"WRITE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_WRITE},
+  {"X", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_X}, /* deprecated in MySQL 5.7.6 */
+  {"XA", 0, 0, TOKEN_KEYWORD_XA},
+  {"XOR", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_XOR},
+  {"Y", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_Y}, /* deprecated in MySQL 5.7.6 */
+  {"YEAR", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_YEAR},
+  {"YEARWEEK", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_YEARWEEK},
+  {"YEAR_MONTH", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_YEAR_MONTH},
+  {"ZEROFILL", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_ZEROFILL},
+  {"_ARMSCII8", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__ARMSCII8},
+  {"_ASCII", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__ASCII},
+  {"_BIG5", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__BIG5},
+  {"_BINARY", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__BINARY},
+  {"_CP1250", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__CP1250},
+  {"_CP1251", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__CP1251},
+  {"_CP1256", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__CP1256},
+  {"_CP1257", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__CP1257},
+  {"_CP850", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__CP850},
+  {"_CP852", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__CP852},
+  {"_CP866", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__CP866},
+  {"_CP932", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__CP932},
+  {"_DEC8", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__DEC8},
+  {"_EUCJPMS", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__EUCJPMS},
+  {"_EUCKR", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__EUCKR},
+  {"_FILENAME", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__FILENAME},
+  {"_GB2312", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__GB2312},
+  {"_GBK", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__GBK},
+  {"_GEOSTD8", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__GEOSTD8},
+  {"_GREEK", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__GREEK},
+  {"_HEBREW", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__HEBREW},
+  {"_HP8", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__HP8},
+  {"_KEYBCS2", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__KEYBCS2},
+  {"_KOI8R", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__KOI8R},
+  {"_KOI8U", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__KOI8U},
+  {"_LATIN1", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__LATIN1},
+  {"_LATIN2", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__LATIN2},
+  {"_LATIN5", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__LATIN5},
+  {"_LATIN7", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__LATIN7},
+  {"_MACCE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__MACCE},
+  {"_MACROMAN", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__MACROMAN},
+  {"_SJIS", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__SJIS},
+  {"_SWE7", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__SWE7},
+  {"_TIS620", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__TIS620},
+  {"_UCS2", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__UCS2},
+  {"_UJIS", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__UJIS},
+  {"_UTF16", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__UTF16},
+  {"_UTF16LE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__UTF16LE},
+  {"_UTF32", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__UTF32},
+  {"_UTF8", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__UTF8},
+  {"_UTF8MB4", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__UTF8MB4}
+};
+
+/* If this doesn't compile, strvalues[] and the TOKEN_KEYWORD list in ocelotgui.h are different sizes. */
+#define KEYWORD_COUNT (sizeof(strvalues) / sizeof(strvalues[0]))
+typedef char strvalues_size_must_match_token_keyword_list[((int) KEYWORD_COUNT == TOKEN_KEYWORD__UTF8MB4 - TOKEN_KEYWORD_QUESTIONMARK + 1) ? 1 : -1];
+
+/*
+  Keyword lookup is with a hash table of strvalues[] indexes, made by
+  the MainWindow constructor before any thread starts, so after that
+  it's only read and threads needn't lock it.
+  It's open addressing with KEYWORD_HASH_SIZE a power of 2 several times
+  bigger than KEYWORD_COUNT, so usually there is only one strcmp().
+  While making it, we check what the bsearch() used to depend on, and
+  what hparse depends on: strvalues[] is in order, and
+  strvalues[i].token_keyword is TOKEN_KEYWORDS_START + i. That's not an
+  assert(), a release build with a bad strvalues[] would go wrong
+  quietly, so if it fails the constructor says so and exits.
+*/
+#define KEYWORD_HASH_SIZE 4096
+static unsigned short int keyword_hash_table[KEYWORD_HASH_SIZE]; /* strvalues[] index + 1, or 0 */
+
+static unsigned int keyword_hash(const char *key, int key_length)
+{
+  unsigned int h= 2166136261U;
+  for (int i= 0; i < key_length; ++i) h= (h ^ (unsigned char) key[i]) * 16777619U;
+  return h;
+}
+
+/* Returns false if strvalues[] is bad, see above. */
+static bool keyword_hash_table_make()
+{
+  for (unsigned int i= 0; i < KEYWORD_COUNT; ++i)
+  {
+    if ((i > 0) && (strcmp(strvalues[i - 1].chars, strvalues[i].chars) >= 0)) return false;
+    if (strvalues[i].token_keyword != TOKEN_KEYWORDS_START + i) return false;
+    unsigned int slot= keyword_hash(strvalues[i].chars, strlen(strvalues[i].chars)) & (KEYWORD_HASH_SIZE - 1);
+    while (keyword_hash_table[slot] != 0) slot= (slot + 1) & (KEYWORD_HASH_SIZE - 1);
+    keyword_hash_table[slot]= i + 1;
+  }
+  return true;
+}
+
+/* Return strvalues[] index of key, which must be upper case, or -1 */
+static int keyword_find(const char *key, int key_length)
+{
+  unsigned int slot= keyword_hash(key, key_length) & (KEYWORD_HASH_SIZE - 1);
+  while (keyword_hash_table[slot] != 0)
+  {
+    int index= keyword_hash_table[slot] - 1;
+    if (strcmp(strvalues[index].chars, key) == 0) return index;
+    slot= (slot + 1) & (KEYWORD_HASH_SIZE - 1);
+  }
+  return -1;
+}
+
 /*
   I got tired of repeating
   if (QString::compare(text.mid(main_token_offsets[0], main_token_lengths[0]), "SELECT", Qt::CaseInsensitive) == 0) ...
-  so switched to maintaining a permanent list.
-  Two compiler-dependent assumptions: bsearch() exists, and char* can be converted to unsigned long.
+  so switched to maintaining a permanent list, strvalues[], see keyword_find().
   Upper case is reserved, lower case is unreserved, we search both ways.
 */
 /* Todo: use "const" and "static" more often */
-#define MAX_KEYWORD_LENGTH 34
 void MainWindow::tokens_to_keywords(QString text, int start)
 {
   log("tokens_to_keywords start", 80);
-  /*
-    Sorted list of keywords.
-    If you change this, you must also change bsearch parameters and change TOKEN_KEYWORD list.
-    We consider introducers e.g. _UTF8 to be equivalent to reserved words.
-  */
+  tokens_to_keywords_lookup(text, start, -1);
+  tokens_to_keywords_context(text, start);
+  log("tokens_to_keywords end", 80);
+}
 
-    struct keywords {
-       char  chars[MAX_KEYWORD_LENGTH];
-       unsigned short int reserved_flags;
-       unsigned short int built_in_function_flags;
-       unsigned short int token_keyword;
-    };
-
-    const keywords strvalues[]=
-    {
-      {"?", 0, 0, TOKEN_KEYWORD_QUESTIONMARK}, /* Ocelot keyword, although tokenize() regards it as an operator */
-      {"ABORT", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_ABORT},
-      {"ABS", 0, FLAG_VERSION_ALL, TOKEN_KEYWORD_ABS},
-      {"ACCESSIBLE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_ACCESSIBLE},
-      {"ACOS", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ACOS},
-      {"ACTION", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_ACTION},
-      {"ADD", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_ADD},
-      {"ADDDATE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ADDDATE},
-      {"ADDTIME", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ADDTIME},
-      {"AES_DECRYPT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_AES_DECRYPT},
-      {"AES_ENCRYPT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_AES_ENCRYPT},
-      {"AFTER", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_AFTER},
-      {"AGAINST", 0, 0, TOKEN_KEYWORD_AGAINST},
-      {"ALGORITHM", 0, 0, TOKEN_KEYWORD_ALGORITHM},
-      {"ALL", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_ALL},
-      {"ALTER", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_ALTER},
-      {"ALWAYS", 0, 0, TOKEN_KEYWORD_ALWAYS},
-      {"ANALYZE", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_ANALYZE},
-      {"AND", FLAG_VERSION_ALL | FLAG_VERSION_LUA, 0, TOKEN_KEYWORD_AND},
-      {"ANY_VALUE", 0, FLAG_VERSION_MYSQL_ALL, TOKEN_KEYWORD_ANY_VALUE},
-      {"AREA", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_AREA}, /* deprecated in MySQL 5.7.6 */
-      {"AS", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_AS},
-      {"ASBINARY", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ASBINARY}, /* deprecated in MySQL 5.7.6 */
-      {"ASC", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_ASC},
-      {"ASCII", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ASCII},
-      {"ASENSITIVE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_ASENSITIVE},
-      {"ASIN", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ASIN},
-      {"ASTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ASTEXT}, /* deprecated in MySQL 5.7.6 */
-      {"ASWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ASWKB}, /* deprecated in MySQL 5.7.6 */
-      {"ASWKT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ASWKT}, /* deprecated in MySQL 5.7.6 */
-      {"ASYMMETRIC_DECRYPT", 0, FLAG_VERSION_MYSQL_ALL, TOKEN_KEYWORD_ASYMMETRIC_DECRYPT},
-      {"ASYMMETRIC_DERIVE", 0, FLAG_VERSION_MYSQL_ALL, TOKEN_KEYWORD_ASYMMETRIC_DERIVE},
-      {"ASYMMETRIC_ENCRYPT", 0, FLAG_VERSION_MYSQL_ALL, TOKEN_KEYWORD_ASYMMETRIC_ENCRYPT},
-      {"ASYMMETRIC_SIGN", 0, FLAG_VERSION_MYSQL_ALL, TOKEN_KEYWORD_ASYMMETRIC_SIGN},
-      {"ASYMMETRIC_VERIFY", 0, FLAG_VERSION_MYSQL_ALL, TOKEN_KEYWORD_ASYMMETRIC_VERIFY},
-      {"ATAN", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ATAN},
-      {"ATAN2", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ATAN2},
-      {"ATTACH", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_ATTACH},
-      {"AUTOINCREMENT", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_AUTOINCREMENT},
-      {"AVG", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_AVG},
-      {"BEFORE", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_BEFORE},
-      {"BEGIN", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_BEGIN},
-      {"BENCHMARK", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_BENCHMARK},
-      {"BETWEEN", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_BETWEEN},
-      {"BFILE", 0, 0, TOKEN_KEYWORD_BFILE},
-      {"BIGINT", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_BIGINT},
-      {"BIN", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_BIN},
-      {"BINARY", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_BINARY},
-      {"BINARY_DOUBLE", 0, 0, TOKEN_KEYWORD_BINARY_DOUBLE},
-      {"BINARY_FLOAT", 0, 0, TOKEN_KEYWORD_BINARY_FLOAT},
-      {"BINLOG", FLAG_VERSION_MARIADB_10_0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_BINLOG},
-      {"BINLOG_GTID_POS", FLAG_VERSION_MARIADB_10_0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_BINLOG_GTID_POS},
-      {"BIT", 0, 0, TOKEN_KEYWORD_BIT},
-      {"BIT_AND", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_BIT_AND},
-      {"BIT_COUNT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_BIT_COUNT},
-      {"BIT_LENGTH", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_BIT_LENGTH},
-      {"BIT_OR", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_BIT_OR},
-      {"BIT_XOR", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_BIT_XOR},
-      {"BLOB", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_BLOB},
-      {"BOOL", 0, 0, TOKEN_KEYWORD_BOOL},
-      {"BOOLEAN", 0, 0, TOKEN_KEYWORD_BOOLEAN},
-      {"BOTH", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_BOTH},
-      {"BREAK", FLAG_VERSION_LUA, 0, TOKEN_KEYWORD_BREAK},
-      {"BUFFER", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_BUFFER}, /* deprecated in MySQL 5.7.6 */
-      {"BY", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_BY},
-      {"CALL", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_CALL},
-      {"CASCADE", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_CASCADE},
-      {"CASE", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_CASE},
-      {"CAST", 0, FLAG_VERSION_ALL, TOKEN_KEYWORD_CAST},
-      {"CEIL", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_CEIL},
-      {"CEILING", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_CEILING},
-      {"CENTROID", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_CENTROID}, /* deprecated in MySQL 5.7.6 */
-      {"CHANGE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_CHANGE},
-      {"CHANGES", 0, FLAG_VERSION_TARANTOOL, TOKEN_KEYWORD_CHANGES},
-      {"CHAR", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, FLAG_VERSION_ALL, TOKEN_KEYWORD_CHAR},
-      {"CHARACTER", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_CHARACTER},
-      {"CHARACTER_LENGTH", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_CHARACTER_LENGTH},
-      {"CHARSET", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_CHARSET},  /* + Ocelot keyword */
-      {"CHAR_LENGTH", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_CHAR_LENGTH},
-      {"CHECK", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_CHECK},
-      {"CLEAR", 0, 0, TOKEN_KEYWORD_CLEAR}, /* Ocelot keyword */
-      {"CLOSE", 0, 0, TOKEN_KEYWORD_CLOSE},
-      {"COALESCE", 0, FLAG_VERSION_ALL, TOKEN_KEYWORD_COALESCE},
-      {"COERCIBILITY", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_COERCIBILITY},
-      {"COLLATE", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_COLLATE},
-      {"COLLATION", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_COLLATION},
-      {"COLUMN", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_COLUMN},
-      {"COLUMN_ADD", FLAG_VERSION_MARIADB_10_0, FLAG_VERSION_MARIADB_10_0, TOKEN_KEYWORD_COLUMN_ADD},
-      {"COLUMN_CHECK", FLAG_VERSION_MARIADB_10_0, FLAG_VERSION_MARIADB_10_0, TOKEN_KEYWORD_COLUMN_CHECK},
-      {"COLUMN_CREATE", FLAG_VERSION_MARIADB_10_0, FLAG_VERSION_MARIADB_10_0, TOKEN_KEYWORD_COLUMN_CREATE},
-      {"COLUMN_DELETE", FLAG_VERSION_MARIADB_10_0, FLAG_VERSION_MARIADB_10_0, TOKEN_KEYWORD_COLUMN_DELETE},
-      {"COLUMN_EXISTS", FLAG_VERSION_MARIADB_10_0, FLAG_VERSION_MARIADB_10_0, TOKEN_KEYWORD_COLUMN_EXISTS},
-      {"COLUMN_GET", FLAG_VERSION_MARIADB_10_0, FLAG_VERSION_MARIADB_10_0, TOKEN_KEYWORD_COLUMN_GET},
-      {"COLUMN_JSON", FLAG_VERSION_MARIADB_10_0, FLAG_VERSION_MARIADB_10_0, TOKEN_KEYWORD_COLUMN_JSON},
-      {"COLUMN_LIST", FLAG_VERSION_MARIADB_10_0, FLAG_VERSION_MARIADB_10_0, TOKEN_KEYWORD_COLUMN_LIST},
-      {"COMMENT", 0, 0, TOKEN_KEYWORD_COMMENT},
-      {"COMMIT", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_COMMIT},
-      {"COMPACT", 0, 0, TOKEN_KEYWORD_COMPACT},
-      {"COMPRESS", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_COMPRESS},
-      {"COMPRESSED", 0, 0, TOKEN_KEYWORD_COMPRESSED},
-      {"COMPRESSION", 0, 0, TOKEN_KEYWORD_COMPRESSION},
-      {"CONCAT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_CONCAT},
-      {"CONCAT_WS", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_CONCAT_WS},
-      {"CONDITION", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_CONDITION},
-      {"CONFLICT", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_CONFLICT},
-      {"CONNECT", 0, 0, TOKEN_KEYWORD_CONNECT}, /* Ocelot keyword */
-      {"CONNECTION_ID", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_CONNECTION_ID},
-      {"CONSTRAINT", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_CONSTRAINT},
-      {"CONTAINS", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_CONTAINS}, /* deprecated in MySQL 5.7.6 */
-      {"CONTINUE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_CONTINUE},
-      {"CONV", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_CONV},
-      {"CONVERT", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_CONVERT},
-      {"CONVERT_TZ", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_CONVERT_TZ},
-      {"CONVEXHULL", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_CONVEXHULL}, /* deprecated in MySQL 5.7.6 */
-      {"COS", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_COS},
-      {"COT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_COT},
-      {"COUNT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_COUNT},
-      {"CRC32", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_CRC32},
-      {"CREATE", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_CREATE},
-      {"CREATE_ASYMMETRIC_PRIV_KEY", 0, FLAG_VERSION_MYSQL_ALL, TOKEN_KEYWORD_CREATE_ASYMMETRIC_PRIV_KEY},
-      {"CREATE_ASYMMETRIC_PUB_KEY", 0, FLAG_VERSION_MYSQL_ALL, TOKEN_KEYWORD_CREATE_ASYMMETRIC_PUB_KEY},
-      {"CREATE_DH_PARAMETERS", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_CREATE_DH_PARAMETERS},
-      {"CREATE_DIGEST", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_CREATE_DIGEST},
-      {"CROSS", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_CROSS},
-      {"CROSSES", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_CROSSES}, /* deprecated in MySQL 5.7.6 */
-      {"CUME_DIST", 0, FLAG_VERSION_MARIADB_10_2_2, TOKEN_KEYWORD_CUME_DIST},
-      {"CURDATE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_CURDATE},
-      {"CURRENT", 0, 0, TOKEN_KEYWORD_CURRENT},
-      {"CURRENT_DATE", FLAG_VERSION_ALL, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_CURRENT_DATE},
-      {"CURRENT_ROLE", FLAG_VERSION_MARIADB_10_0, 0, TOKEN_KEYWORD_CURRENT_ROLE},
-      {"CURRENT_TIME", FLAG_VERSION_ALL, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_CURRENT_TIME},
-      {"CURRENT_TIMESTAMP", FLAG_VERSION_ALL, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_CURRENT_TIMESTAMP},
-      {"CURRENT_USER", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_CURRENT_USER},
-      {"CURSOR", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_CURSOR},
-      {"CURTIME", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_CURTIME},
-      {"DATABASE", FLAG_VERSION_ALL, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_DATABASE},
-      {"DATABASES", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_DATABASES},
-      {"DATE", 0, FLAG_VERSION_ALL, TOKEN_KEYWORD_DATE},
-      {"DATEDIFF", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_DATEDIFF},
-      {"DATETIME", 0, FLAG_VERSION_TARANTOOL, TOKEN_KEYWORD_DATETIME},
-      {"DATE_ADD", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_DATE_ADD},
-      {"DATE_FORMAT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_DATE_FORMAT},
-      {"DATE_SUB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_DATE_SUB},
-      {"DAY", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_DAY},
-      {"DAYNAME", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_DAYNAME},
-      {"DAYOFMONTH", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_DAYOFMONTH},
-      {"DAYOFWEEK", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_DAYOFWEEK},
-      {"DAYOFYEAR", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_DAYOFYEAR},
-      {"DAY_HOUR", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_DAY_HOUR},
-      {"DAY_MICROSECOND", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_DAY_MICROSECOND},
-      {"DAY_MINUTE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_DAY_MINUTE},
-      {"DAY_SECOND", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_DAY_SECOND},
-      {"DEALLOCATE", 0, 0, TOKEN_KEYWORD_DEALLOCATE},
-      {"DEC", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_DEC},
-      {"DECIMAL", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_DECIMAL},
-      {"DECLARE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_DECLARE},
-      {"DECODE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_DECODE},
-      {"DECODE_HISTOGRAM", FLAG_VERSION_MARIADB_10_0, FLAG_VERSION_MARIADB_10_0, TOKEN_KEYWORD_DECODE_HISTOGRAM},
-      {"DEFAULT", FLAG_VERSION_ALL, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_DEFAULT},
-      {"DEFERRABLE", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_DEFERRABLE},
-      {"DEFERRED", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_DEFERRED},
-      {"DEGREES", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_DEGREES},
-      {"DELAYED", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_DELAYED},
-      {"DELETE", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_DELETE},
-      {"DELIMITER", 0, 0, TOKEN_KEYWORD_DELIMITER}, /* Ocelot keyword */
-      {"DENSE_RANK", 0, FLAG_VERSION_MARIADB_10_2_2, TOKEN_KEYWORD_DENSE_RANK},
-      {"DESC", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_DESC},
-      {"DESCRIBE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_DESCRIBE},
-      {"DES_DECRYPT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_DES_DECRYPT}, /* deprecated in MySQL 5.7.6 */
-      {"DES_ENCRYPT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_DES_ENCRYPT}, /* deprecated in MySQL 5.7.6 */
-      {"DETACH", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_DETACH},
-      {"DETERMINISTIC", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_DETERMINISTIC},
-      {"DIMENSION", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_DIMENSION}, /* deprecated in MySQL 5.7.6 */
-      {"DIRECTORY", 0, 0, TOKEN_KEYWORD_DIRECTORY},
-      {"DISJOINT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_DISJOINT}, /* deprecated in MySQL 5.7.6 */
-      {"DISTANCE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_DISTANCE}, /* deprecated in MySQL 5.7.6 */
-      {"DISTINCT", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_DISTINCT},
-      {"DISTINCTROW", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_DISTINCTROW},
-      {"DIV", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_DIV},
-      {"DO", FLAG_VERSION_LUA, 0, TOKEN_KEYWORD_DO},
-      {"DOUBLE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_DOUBLE},
-      {"DROP", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_DROP},
-      {"DUAL", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_DUAL},
-      {"DUPLICATE", 0, 0, TOKEN_KEYWORD_DUPLICATE},
-      {"DYNAMIC", 0, 0, TOKEN_KEYWORD_DYNAMIC},
-      {"EACH", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_EACH},
-      {"EDIT", 0, 0, TOKEN_KEYWORD_EDIT}, /* Ocelot keyword */
-      {"EGO", 0, 0, TOKEN_KEYWORD_EGO}, /* Ocelot keyword */
-      {"ELSE", FLAG_VERSION_ALL | FLAG_VERSION_LUA, 0, TOKEN_KEYWORD_ELSE},
-      {"ELSEIF", FLAG_VERSION_MYSQL_OR_MARIADB_ALL | FLAG_VERSION_LUA, 0, TOKEN_KEYWORD_ELSEIF},
-      {"ELT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ELT},
-      {"ENABLE", 0, 0, TOKEN_KEYWORD_ENABLE},
-      {"ENCLOSED", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_ENCLOSED},
-      {"ENCODE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ENCODE},
-      {"ENCRYPT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ENCRYPT}, /* deprecated in MySQL 5.7.6 */
-      {"END", FLAG_VERSION_TARANTOOL | FLAG_VERSION_LUA, 0, TOKEN_KEYWORD_END},
-      {"ENDPOINT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ENDPOINT}, /* deprecated in MySQL 5.7.6 */
-      {"ENUM", 0, 0, TOKEN_KEYWORD_ENUM},
-      {"ENVELOPE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ENVELOPE}, /* deprecated in MySQL 5.7.6 */
-      {"EQUALS", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_EQUALS}, /* deprecated in MySQL 5.7.6 */
-      {"ESCAPE", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_ESCAPE},
-      {"ESCAPED", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_ESCAPED},
-      {"EVENT", 0, 0, TOKEN_KEYWORD_EVENT},
-      {"EXCEPT", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_EXCEPT},
-      {"EXCHANGE", 0, 0, TOKEN_KEYWORD_EXCHANGE},
-      {"EXCLUSIVE", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_EXCLUSIVE},
-      {"EXECUTE", 0, 0, TOKEN_KEYWORD_EXECUTE},
-      {"EXISTS", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_EXISTS},
-      {"EXIT", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_EXIT},
-      {"EXP", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_EXP},
-      {"EXPANSION", 0, 0, TOKEN_KEYWORD_EXPANSION},
-      {"EXPLAIN", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_EXPLAIN},
-      {"EXPORT", 0, 0, TOKEN_KEYWORD_EXPORT},
-      {"EXPORT_SET", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_EXPORT_SET},
-      {"EXTERIORRING", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_EXTERIORRING}, /* deprecated in MySQL 5.7.6 */
-      {"EXTRACT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_EXTRACT},
-      {"EXTRACTVALUE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_EXTRACTVALUE},
-      {"FAIL", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_FAIL},
-      {"FALSE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL | FLAG_VERSION_LUA, 0, TOKEN_KEYWORD_FALSE},
-      {"FETCH", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_FETCH},
-      {"FIELD", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_FIELD},
-      {"FILE", 0, 0, TOKEN_KEYWORD_FILE},
-      {"FIND_IN_SET", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_FIND_IN_SET},
-      {"FIRST", 0, 0, TOKEN_KEYWORD_FIRST}, /* MariaDB 10.2 nonreserved */
-      {"FIRST_VALUE", 0, 0, TOKEN_KEYWORD_FIRST_VALUE}, /* MariaDB 10.2 nonreserved -- or, maybe not in MariaDB 10.2*/
-      {"FIXED", 0, 0, TOKEN_KEYWORD_FIXED},
-      {"FLOAT", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_FLOAT},
-      {"FLOAT4", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_FLOAT4},
-      {"FLOAT8", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_FLOAT8},
-      {"FLOOR", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_FLOOR},
-      {"FLUSH", 0, 0, TOKEN_KEYWORD_FLUSH},
-      {"FOLLOWING", FLAG_VERSION_MARIADB_10_2_2, 0, TOKEN_KEYWORD_FOLLOWING},
-      {"FOLLOWS", FLAG_VERSION_MYSQL_5_7 | FLAG_VERSION_MARIADB_10_2_3, 0, TOKEN_KEYWORD_FOLLOWS},
-      {"FOR", FLAG_VERSION_ALL | FLAG_VERSION_LUA, 0, TOKEN_KEYWORD_FOR},
-      {"FORCE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_FORCE},
-      {"FOREIGN", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_FOREIGN},
-      {"FORMAT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_FORMAT},
-      {"FOUND_ROWS", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_FOUND_ROWS},
-      {"FROM", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_FROM},
-      {"FROM_BASE64", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_FROM_BASE64},
-      {"FROM_DAYS", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_FROM_DAYS},
-      {"FROM_UNIXTIME", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_FROM_UNIXTIME},
-      {"FULL", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_FULL},
-      {"FULLTEXT", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_FULLTEXT},
-      {"FUNCTION", FLAG_VERSION_LUA, 0, TOKEN_KEYWORD_FUNCTION},
-      {"GENERAL", 0, 0, TOKEN_KEYWORD_GENERAL},
-      {"GENERATED", FLAG_VERSION_MYSQL_5_7, 0, TOKEN_KEYWORD_GENERATED},
-      {"GEOMCOLLFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_GEOMCOLLFROMTEXT}, /* deprecated in MySQL 5.7.6 */
-      {"GEOMCOLLFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_GEOMCOLLFROMWKB}, /* deprecated in MySQL 5.7.6 */
-      {"GEOMETRY", 0, 0, TOKEN_KEYWORD_GEOMETRY},
-      {"GEOMETRYCOLLECTION", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_GEOMETRYCOLLECTION},
-      {"GEOMETRYCOLLECTIONFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_GEOMETRYCOLLECTIONFROMTEXT}, /* deprecated in MySQL 5.7.6 */
-      {"GEOMETRYCOLLECTIONFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_GEOMETRYCOLLECTIONFROMWKB}, /* deprecated in MySQL 5.7.6 */
-      {"GEOMETRYFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_GEOMETRYFROMTEXT}, /* deprecated in MySQL 5.7.6 */
-      {"GEOMETRYFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_GEOMETRYFROMWKB}, /* deprecated in MySQL 5.7.6 */
-      {"GEOMETRYN", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_GEOMETRYN}, /* deprecated in MySQL 5.7.6 */
-      {"GEOMETRYTYPE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_GEOMETRYTYPE}, /* deprecated in MySQL 5.7.6 */
-      {"GEOMFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_GEOMFROMTEXT},/* deprecated in MySQL 5.7.6 */
-      {"GEOMFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_GEOMFROMWKB}, /* deprecated in MySQL 5.7.6 */
-      {"GET", FLAG_VERSION_MYSQL_5_6, 0, TOKEN_KEYWORD_GET},
-      {"GET_FORMAT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_GET_FORMAT},
-      {"GET_LOCK", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_GET_LOCK},
-      {"GLENGTH", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_GLENGTH}, /* deprecated in MySQL 5.7.6 */
-      {"GLOB", FLAG_VERSION_TARANTOOL, FLAG_VERSION_TARANTOOL, TOKEN_KEYWORD_GLOB},
-      {"GO", 0, 0, TOKEN_KEYWORD_GO}, /* Ocelot keyword */
-      {"GRANT", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_GRANT},
-      {"GREATEST", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_GREATEST},
-      {"GROUP", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_GROUP},
-      {"GROUP_CONCAT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_GROUP_CONCAT},
-      {"GTID_SUBSET", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_GTID_SUBSET},
-      {"GTID_SUBTRACT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_GTID_SUBTRACT},
-      {"HANDLER", 0, 0, TOKEN_KEYWORD_HANDLER},
-      {"HAVING", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_HAVING},
-      {"HELP", 0, 0, TOKEN_KEYWORD_HELP}, /* Ocelot keyword */
-      {"HEX", 0, FLAG_VERSION_ALL, TOKEN_KEYWORD_HEX},
-      {"HIGH_PRIORITY", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_HIGH_PRIORITY},
-      {"HOUR", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_HOUR},
-      {"HOUR_MICROSECOND", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_HOUR_MICROSECOND},
-      {"HOUR_MINUTE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_HOUR_MINUTE},
-      {"HOUR_SECOND", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_HOUR_SECOND},
-      {"IF", FLAG_VERSION_ALL | FLAG_VERSION_LUA, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_IF},
-      {"IFNULL", 0, FLAG_VERSION_ALL, TOKEN_KEYWORD_IFNULL},
-      {"IGNORE", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_IGNORE},
-      {"IMMEDIATE", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_IMMEDIATE},
-      {"IMPORT", 0, 0, TOKEN_KEYWORD_IMPORT},
-      {"IN", FLAG_VERSION_ALL | FLAG_VERSION_LUA, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_IN},
-      {"INDEX", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_INDEX},
-      {"INDEXED", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_INDEXED},
-      {"INET6_ATON", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_INET6_ATON},
-      {"INET6_NTOA", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_INET6_NTOA},
-      {"INET_ATON", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_INET_ATON},
-      {"INET_NTOA", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_INET_NTOA},
-      {"INFILE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_INFILE},
-      {"INITIALLY", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_INITIALLY},
-      {"INNER", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_INNER},
-      {"INOUT", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_INOUT},
-      {"INSENSITIVE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_INSENSITIVE},
-      {"INSERT", FLAG_VERSION_ALL, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_INSERT},
-      {"INSTALL", 0, 0, TOKEN_KEYWORD_INSTALL},
-      {"INSTEAD", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_INSTEAD},
-      {"INSTR", 0, FLAG_VERSION_ALL, TOKEN_KEYWORD_INSTR},
-      {"INT", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_INT},
-      {"INT1", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_INT1},
-      {"INT2", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_INT2},
-      {"INT3", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_INT3},
-      {"INT4", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_INT4},
-      {"INT8", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_INT8},
-      {"INTEGER", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_INTEGER},
-      {"INTERIORRINGN", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_INTERIORRINGN}, /* deprecated in MySQL 5.7.6 */
-      {"INTERSECT", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_INTERSECT},
-      {"INTERSECTS", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_INTERSECTS}, /* deprecated in MySQL 5.7.6 */
-      {"INTERVAL", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_INTERVAL},
-      {"INTO", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_INTO},
-      {"IO_AFTER_GTIDS", FLAG_VERSION_MYSQL_5_6, 0, TOKEN_KEYWORD_IO_AFTER_GTIDS},
-      {"IO_BEFORE_GTIDS", FLAG_VERSION_MYSQL_5_6, 0, TOKEN_KEYWORD_IO_BEFORE_GTIDS},
-      {"IS", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_IS},
-      {"ISCLOSED", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ISCLOSED}, /* deprecated in MySQL 5.7.6 */
-      {"ISEMPTY", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ISEMPTY}, /* deprecated in MySQL 5.7.6 */
-      {"ISNULL", 0, FLAG_VERSION_ALL, TOKEN_KEYWORD_ISNULL},
-      {"ISSIMPLE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ISSIMPLE}, /* deprecated in MySQL 5.7.6 */
-      {"IS_FREE_LOCK", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_IS_FREE_LOCK},
-      {"IS_IPV4", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_IS_IPV4},
-      {"IS_IPV4_COMPAT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_IS_IPV4_COMPAT},
-      {"IS_IPV4_MAPPED", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_IS_IPV4_MAPPED},
-      {"IS_IPV6", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_IS_IPV6},
-      {"IS_USED_LOCK", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_IS_USED_LOCK},
-      {"ITERATE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_ITERATE},
-      {"JOIN", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_JOIN},
-      {"JSON", 0, 0, TOKEN_KEYWORD_JSON},
-      {"JSON_APPEND", 0, FLAG_VERSION_MYSQL_5_7 | FLAG_VERSION_MARIADB_10_2_3, TOKEN_KEYWORD_JSON_APPEND},
-      {"JSON_ARRAY", 0, FLAG_VERSION_MYSQL_5_7 | FLAG_VERSION_MARIADB_10_2_3 | FLAG_VERSION_TARANTOOL, TOKEN_KEYWORD_JSON_ARRAY},
-      {"JSON_ARRAY_APPEND", 0, FLAG_VERSION_MYSQL_5_7 | FLAG_VERSION_MARIADB_10_2_3, TOKEN_KEYWORD_JSON_ARRAY_APPEND},
-      {"JSON_ARRAY_INSERT", 0, FLAG_VERSION_MYSQL_5_7, TOKEN_KEYWORD_JSON_ARRAY_INSERT},
-      {"JSON_CONTAINS", 0, FLAG_VERSION_MYSQL_5_7, TOKEN_KEYWORD_JSON_CONTAINS},
-      {"JSON_CONTAINS_PATH", 0, FLAG_VERSION_MYSQL_5_7 | FLAG_VERSION_MARIADB_10_2_3, TOKEN_KEYWORD_JSON_CONTAINS_PATH},
-      {"JSON_DEPTH", 0, FLAG_VERSION_MYSQL_5_7, TOKEN_KEYWORD_JSON_DEPTH},
-      {"JSON_EXTRACT", 0, FLAG_VERSION_MYSQL_5_7 | FLAG_VERSION_MARIADB_10_2_3 | FLAG_VERSION_TARANTOOL, TOKEN_KEYWORD_JSON_EXTRACT},
-      {"JSON_INSERT", 0, FLAG_VERSION_MYSQL_5_7 | FLAG_VERSION_TARANTOOL, TOKEN_KEYWORD_JSON_INSERT},
-      {"JSON_KEYS", 0, FLAG_VERSION_MYSQL_5_7, TOKEN_KEYWORD_JSON_KEYS},
-      {"JSON_LENGTH", 0, FLAG_VERSION_MYSQL_5_7, TOKEN_KEYWORD_JSON_LENGTH},
-      {"JSON_MERGE", 0, FLAG_VERSION_MYSQL_5_7 | FLAG_VERSION_MARIADB_10_2_3, TOKEN_KEYWORD_JSON_MERGE},
-      {"JSON_OBJECT", 0, FLAG_VERSION_MYSQL_5_7 | FLAG_VERSION_MARIADB_10_2_3 | FLAG_VERSION_TARANTOOL, TOKEN_KEYWORD_JSON_OBJECT},
-      {"JSON_QUERY", 0, FLAG_VERSION_MARIADB_10_2_3, TOKEN_KEYWORD_JSON_QUERY},
-      {"JSON_QUOTE", 0, FLAG_VERSION_MYSQL_5_7 | FLAG_VERSION_MARIADB_10_2_3, TOKEN_KEYWORD_JSON_QUOTE},
-      {"JSON_REMOVE", 0, FLAG_VERSION_MYSQL_5_7 | FLAG_VERSION_TARANTOOL, TOKEN_KEYWORD_JSON_REMOVE},
-      {"JSON_REPLACE", 0, FLAG_VERSION_MYSQL_5_7 | FLAG_VERSION_TARANTOOL, TOKEN_KEYWORD_JSON_REPLACE},
-      {"JSON_SEARCH", 0, FLAG_VERSION_MYSQL_5_7, TOKEN_KEYWORD_JSON_SEARCH},
-      {"JSON_SET", 0, FLAG_VERSION_MYSQL_5_7 | FLAG_VERSION_TARANTOOL, TOKEN_KEYWORD_JSON_SET},
-      {"JSON_TYPE", 0, FLAG_VERSION_MYSQL_5_7 | FLAG_VERSION_TARANTOOL, TOKEN_KEYWORD_JSON_TYPE},
-      {"JSON_UNQUOTE", 0, FLAG_VERSION_MYSQL_5_7, TOKEN_KEYWORD_JSON_UNQUOTE},
-      {"JSON_VALID", 0, FLAG_VERSION_MYSQL_5_7 | FLAG_VERSION_MARIADB_10_2_3 | FLAG_VERSION_TARANTOOL, TOKEN_KEYWORD_JSON_VALID},
-      {"JSON_VALUE", 0, FLAG_VERSION_MARIADB_10_2_3, TOKEN_KEYWORD_JSON_VALUE},
-      {"JULIANDAY", 0, FLAG_VERSION_TARANTOOL, TOKEN_KEYWORD_JULIANDAY},
-      {"KEY", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_KEY},
-      {"KEYS", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_KEYS},
-      {"KILL", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_KILL},
-      {"LAG", 0, 0, TOKEN_KEYWORD_LAG}, /* MariaDB 10.2 nonreserved -- or, maybe not in MariaDB 10.2 */
-      {"LANGUAGE", 0, 0, TOKEN_KEYWORD_LANGUAGE},
-      {"LAST", 0, 0, TOKEN_KEYWORD_LAST}, /* MariaDB 10.2 nonreserved */
-      {"LAST_DAY", FLAG_VERSION_MARIADB_10_0, FLAG_VERSION_MARIADB_10_0, TOKEN_KEYWORD_LAST_DAY},
-      {"LAST_INSERT_ID", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_LAST_INSERT_ID},
-      {"LAST_VALUE", 0, 0, TOKEN_KEYWORD_LAST_VALUE}, /* MariaDB 10.2 nonreserved */
-      {"LCASE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_LCASE},
-      {"LEAD", 0, 0, TOKEN_KEYWORD_LEAD}, /* MariaDB 10.2 nonreserved -- or, maybe not in MariaDB 10.2 */
-      {"LEADING", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_LEADING},
-      {"LEAST", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_LEAST},
-      {"LEAVE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_LEAVE},
-      {"LEFT", FLAG_VERSION_ALL, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_LEFT},
-      {"LENGTH", 0, FLAG_VERSION_ALL, TOKEN_KEYWORD_LENGTH},
-      {"LEVEL", 0, 0, TOKEN_KEYWORD_LEVEL},
-      {"LIKE", FLAG_VERSION_ALL, FLAG_VERSION_TARANTOOL, TOKEN_KEYWORD_LIKE},
-      {"LIMIT", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_LIMIT},
-      {"LINEAR", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_LINEAR},
-      {"LINEFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_LINEFROMTEXT}, /* deprecated in MySQL 5.7.6 */
-      {"LINEFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_LINEFROMWKB}, /* deprecated in MySQL 5.7.6 */
-      {"LINES", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_LINES},
-      {"LINESTRING", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_LINESTRING},
-      {"LINESTRINGFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_LINESTRINGFROMTEXT}, /* deprecated in MySQL 5.7.6 */
-      {"LINESTRINGFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_LINESTRINGFROMWKB}, /* deprecated in MySQL 5.7.6 */
-      {"LN", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_LN},
-      {"LOAD", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_LOAD},
-      {"LOAD_FILE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_LOAD_FILE},
-      {"LOCAL", FLAG_VERSION_LUA, 0, TOKEN_KEYWORD_LOCAL},
-      {"LOCALTIME", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_LOCALTIME},
-      {"LOCALTIMESTAMP", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_LOCALTIMESTAMP},
-      {"LOCATE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_LOCATE},
-      {"LOCK", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_LOCK},
-      {"LOG", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_LOG},
-      {"LOG10", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_LOG10},
-      {"LOG2", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_LOG2},
-      {"LOGFILE", 0, 0, TOKEN_KEYWORD_LOGFILE},
-      {"LONG", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_LONG},
-      {"LONGBLOB", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_LONGBLOB},
-      {"LONGTEXT", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_LONGTEXT},
-      {"LOOP", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_LOOP},
-      {"LOWER", 0, FLAG_VERSION_ALL, TOKEN_KEYWORD_LOWER},
-      {"LOW_PRIORITY", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_LOW_PRIORITY},
-      {"LPAD", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_LPAD},
-      {"LTRIM", 0, FLAG_VERSION_ALL, TOKEN_KEYWORD_LTRIM},
-      {"LUA", 0, FLAG_VERSION_TARANTOOL, TOKEN_KEYWORD_LUA},
-      {"MAKEDATE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MAKEDATE},
-      {"MAKETIME", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MAKETIME},
-      {"MAKE_SET", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MAKE_SET},
-      {"MASTER_BIND", FLAG_VERSION_MYSQL_5_6, 0, TOKEN_KEYWORD_MASTER_BIND},
-      {"MASTER_HEARTBEAT_PERIOD", 0, 0, TOKEN_KEYWORD_MASTER_HEARTBEAT_PERIOD},
-      {"MASTER_POS_WAIT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MASTER_POS_WAIT},
-      {"MASTER_SSL_VERIFY_SERVER_CERT", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_MASTER_SSL_VERIFY_SERVER_CERT},
-      {"MATCH", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_MATCH},
-      {"MAX", 0, FLAG_VERSION_ALL, TOKEN_KEYWORD_MAX},
-      {"MAXVALUE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_MAXVALUE},
-      {"MBRCONTAINS", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MBRCONTAINS},
-      {"MBRCOVEREDBY", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MBRCOVEREDBY},
-      {"MBRCOVERS", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MBRCOVERS},
-      {"MBRDISJOINT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MBRDISJOINT},
-      {"MBREQUAL", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MBREQUAL}, /* deprecated in MySQL 5.7.6 */
-      {"MBREQUALS", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MBREQUALS},
-      {"MBRINTERSECTS", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MBRINTERSECTS},
-      {"MBROVERLAPS", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MBROVERLAPS},
-      {"MBRTOUCHES", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MBRTOUCHES},
-      {"MBRWITHIN", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MBRWITHIN},
-      {"MD5", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MD5},
-      {"MEDIUMBLOB", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_MEDIUMBLOB},
-      {"MEDIUMINT", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_MEDIUMINT},
-      {"MEDIUMTEXT", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_MEDIUMTEXT},
-      {"MICROSECOND", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MICROSECOND},
-      {"MID", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MID},
-      {"MIDDLEINT", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_MIDDLEINT},
-      {"MIN", 0, FLAG_VERSION_ALL, TOKEN_KEYWORD_MIN},
-      {"MINUTE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MINUTE},
-      {"MINUTE_MICROSECOND", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_MINUTE_MICROSECOND},
-      {"MINUTE_SECOND", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_MINUTE_SECOND},
-      {"MLINEFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MLINEFROMTEXT},  /* deprecated in MySQL 5.7.6 */
-      {"MLINEFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MLINEFROMWKB},  /* deprecated in MySQL 5.7.6 */
-      {"MOD", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MOD},
-      {"MODE", 0, 0, TOKEN_KEYWORD_MODE},
-      {"MODIFIES", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_MODIFIES},
-      {"MONTH", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MONTH},
-      {"MONTHNAME", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MONTHNAME},
-      {"MPOINTFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MPOINTFROMTEXT},  /* deprecated in MySQL 5.7.6 */
-      {"MPOINTFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MPOINTFROMWKB}, /* deprecated in MySQL 5.7.6 */
-      {"MPOLYFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MPOLYFROMTEXT}, /* deprecated in MySQL 5.7.6 */
-      {"MPOLYFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MPOLYFROMWKB}, /* deprecated in MySQL 5.7.6 */
-      {"MULTILINESTRING", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MULTILINESTRING},
-      {"MULTILINESTRINGFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MULTILINESTRINGFROMTEXT}, /* deprecated in MySQL 5.7.6 */
-      {"MULTILINESTRINGFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MULTILINESTRINGFROMWKB}, /* deprecated in MySQL 5.7.6 */
-      {"MULTIPOINT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MULTIPOINT},
-      {"MULTIPOINTFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MULTIPOINTFROMTEXT},  /* deprecated in MySQL 5.7.6 */
-      {"MULTIPOINTFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MULTIPOINTFROMWKB}, /* deprecated in MySQL 5.7.6 */
-      {"MULTIPOLYGON", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MULTIPOLYGON},
-      {"MULTIPOLYGONFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MULTIPOLYGONFROMTEXT}, /* deprecated in MySQL 5.7.6 */
-      {"MULTIPOLYGONFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_MULTIPOLYGONFROMWKB}, /* deprecated in MySQL 5.7.6 */
-      {"NAME_CONST", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_NAME_CONST},
-      {"NATURAL", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_NATURAL},
-      {"NIL", FLAG_VERSION_LUA, 0, TOKEN_KEYWORD_NIL},
-      {"NO", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_NO},
-      {"NOPAGER", 0, 0, TOKEN_KEYWORD_NOPAGER}, /* Ocelot keyword */
-      {"NOT", FLAG_VERSION_TARANTOOL | FLAG_VERSION_LUA, 0, TOKEN_KEYWORD_NOT},
-      {"NOTEE", 0, 0, TOKEN_KEYWORD_NOTEE}, /* Ocelot keyword */
-      {"NOTNULL", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_NOTNULL},
-      {"NOW", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_NOW},
-      {"NOWARNING", 0, 0, TOKEN_KEYWORD_NOWARNING}, /* Ocelot keyword */
-      {"NO_WRITE_TO_BINLOG", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_NO_WRITE_TO_BINLOG},
-      {"NTH_VALUE", 0, 0, TOKEN_KEYWORD_NTH_VALUE}, /* MariaDB 10.2 nonreserved -- or, maybe not in MariaDB 10.2 */
-      {"NTILE", 0, FLAG_VERSION_MARIADB_10_2_2, TOKEN_KEYWORD_NTILE},
-      {"NULL", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_NULL},
-      {"NULLIF", 0, FLAG_VERSION_ALL, TOKEN_KEYWORD_NULLIF},
-      {"NULLS", 0, 0, TOKEN_KEYWORD_NULLS}, /* MariaDB 10.2 nonreserved  -- or, maybe not in MariaDB 10.2 */
-      {"NUMBER", 0, 0, TOKEN_KEYWORD_NUMBER},
-      {"NUMERIC", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_NUMERIC},
-      {"NUMGEOMETRIES", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_NUMGEOMETRIES}, /* deprecated in MySQL 5.7.6 */
-      {"NUMINTERIORRINGS", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_NUMINTERIORRINGS}, /* deprecated in MySQL 5.7.6 */
-      {"NUMPOINTS", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_NUMPOINTS}, /* deprecated in MySQL 5.7.6 */
-      {"NVARCHAR2", 0, 0, TOKEN_KEYWORD_NVARCHAR2},
-      {"OCT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_OCT},
-      {"OCTET_LENGTH", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_OCTET_LENGTH},
-      {"OF", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_OF},
-      {"OFF", 0, 0, TOKEN_KEYWORD_OFF},
-      {"OFFSET", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_OFFSET},
-      {"OJ", 0, 0, TOKEN_KEYWORD_OJ},
-      {"OLD_PASSWORD", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_OLD_PASSWORD},
-      {"ON", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_ON},
-      {"OPEN", 0, 0, TOKEN_KEYWORD_OPEN},
-      {"OPTIMIZE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_OPTIMIZE},
-      {"OPTIMIZER_COSTS", FLAG_VERSION_MYSQL_5_7, 0, TOKEN_KEYWORD_OPTIMIZER_COSTS},
-      {"OPTION", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_OPTION},
-      {"OPTIONALLY", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_OPTIONALLY},
-      {"OR", FLAG_VERSION_ALL | FLAG_VERSION_LUA, 0, TOKEN_KEYWORD_OR},
-      {"ORD", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ORD},
-      {"ORDER", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_ORDER},
-      {"OUT", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_OUT},
-      {"OUTER", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_OUTER},
-      {"OUTFILE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_OUTFILE},
-      {"OVER", FLAG_VERSION_MARIADB_10_2_2, 0, TOKEN_KEYWORD_OVER},
-      {"OVERLAPS", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_OVERLAPS}, /* deprecated in MySQL 5.7.6 */
-      {"PAGER", 0, 0, TOKEN_KEYWORD_PAGER}, /* Ocelot keyword */
-      {"PARTIAL", 0, 0, TOKEN_KEYWORD_PARTIAL},
-      {"PARTITION", FLAG_VERSION_MYSQL_5_6 | FLAG_VERSION_MARIADB_10_0, 0, TOKEN_KEYWORD_PARTITION},
-      {"PASSWORD", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_PASSWORD}, /* deprecated in MySQL 5.7.6 */
-      {"PERCENT_RANK", 0, FLAG_VERSION_MARIADB_10_2_2, TOKEN_KEYWORD_PERCENT_RANK},
-      {"PERIOD_ADD", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_PERIOD_ADD},
-      {"PERIOD_DIFF", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_PERIOD_DIFF},
-      {"PI", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_PI},
-      {"PLAN", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_PLAN},
-      {"POINT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_POINT},
-      {"POINTFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_POINTFROMTEXT}, /* deprecated in MySQL 5.7.6 */
-      {"POINTFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_POINTFROMWKB}, /* deprecated in MySQL 5.7.6 */
-      {"POINTN", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_POINTN}, /* deprecated in MySQL 5.7.6 */
-      {"POLYFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_POLYFROMTEXT},
-      {"POLYFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_POLYFROMWKB}, /* deprecated in MySQL 5.7 */
-      {"POLYGON", 0, 0, TOKEN_KEYWORD_POLYGON},
-      {"POLYGONFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_POLYGONFROMTEXT}, /* deprecated in MySQL 5.7.6 */
-      {"POLYGONFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_POLYGONFROMWKB}, /* deprecated in MySQL 5.7.6 */
-      {"POSITION", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_POSITION},
-      {"POW", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_POW},
-      {"POWER", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_POWER},
-      {"PRAGMA", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_PRAGMA},
-      {"PRECEDES", FLAG_VERSION_MYSQL_5_7 | FLAG_VERSION_MARIADB_10_2_3, 0, TOKEN_KEYWORD_PRECEDES},
-      {"PRECISION", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_PRECISION},
-      {"PREPARE", 0, 0, TOKEN_KEYWORD_PREPARE},
-      {"PRIMARY", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_PRIMARY},
-      {"PRINT", 0, 0, TOKEN_KEYWORD_PRINT}, /* Ocelot keyword */
-      {"PRINTF", 0, FLAG_VERSION_TARANTOOL, TOKEN_KEYWORD_PRINTF},
-      {"PROCEDURE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_PROCEDURE},
-      {"PROCESS", 0, 0, TOKEN_KEYWORD_PROCESS},
-      {"PROMPT", 0, 0, TOKEN_KEYWORD_PROMPT}, /* Ocelot keyword */
-      {"PROXY", 0, 0, TOKEN_KEYWORD_PROXY},
-      {"PURGE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_PURGE},
-      {"QUARTER", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_QUARTER},
-      {"QUERY", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_QUERY},
-      {"QUIT", 0, 0, TOKEN_KEYWORD_QUIT}, /* Ocelot keyword */
-      {"QUOTE", 0, FLAG_VERSION_ALL, TOKEN_KEYWORD_QUOTE},
-      {"RADIANS", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_RADIANS},
-      {"RAISE", FLAG_VERSION_TARANTOOL, FLAG_VERSION_TARANTOOL, TOKEN_KEYWORD_RAISE},
-      {"RAND", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_RAND},
-      {"RANDOM", 0, FLAG_VERSION_TARANTOOL, TOKEN_KEYWORD_RANDOM},
-      {"RANDOMBLOB", 0, FLAG_VERSION_TARANTOOL, TOKEN_KEYWORD_RANDOMBLOB},
-      {"RANDOM_BYTES", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_RANDOM_BYTES},
-      {"RANGE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_RANGE},
-      {"RANK", 0, FLAG_VERSION_MARIADB_10_2_2, TOKEN_KEYWORD_RANK},
-      {"RAW", 0, 0, TOKEN_KEYWORD_RAW},
-      {"READ", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_READ},
-      {"READS", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_READS},
-      {"READ_WRITE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_READ_WRITE},
-      {"REAL", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_REAL},
-      {"REBUILD", 0, 0, TOKEN_KEYWORD_REBUILD},
-      {"RECURSIVE", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_RECURSIVE},
-      {"REDUNDANT", 0, 0, TOKEN_KEYWORD_REDUNDANT},
-      {"REFERENCES", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_REFERENCES},
-      {"REGEXP", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_REGEXP},
-      {"REHASH", 0, 0, TOKEN_KEYWORD_REHASH}, /* Ocelot keyword */
-      {"REINDEX", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_REINDEX},
-      {"RELEASE", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_RELEASE},
-      {"RELEASE_ALL_LOCKS", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_RELEASE_ALL_LOCKS},
-      {"RELEASE_LOCK", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_RELEASE_LOCK},
-      {"RELOAD", 0, 0, TOKEN_KEYWORD_RELOAD},
-      {"RENAME", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_RENAME},
-      {"REORGANIZE", 0, 0, TOKEN_KEYWORD_REORGANIZE},
-      {"REPAIR", 0, 0, TOKEN_KEYWORD_REPAIR},
-      {"REPEAT", FLAG_VERSION_MYSQL_OR_MARIADB_ALL | FLAG_VERSION_LUA, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_REPEAT},
-      {"REPLACE", FLAG_VERSION_ALL, FLAG_VERSION_ALL, TOKEN_KEYWORD_REPLACE},
-      {"REPLICATION", 0, 0, TOKEN_KEYWORD_REPLICATION},
-      {"REQUIRE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_REQUIRE},
-      {"RESET", 0, 0, TOKEN_KEYWORD_RESET},
-      {"RESETCONNECTION", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_RESETCONNECTION},
-      {"RESIGNAL", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_RESIGNAL},
-      {"RESTRICT", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_RESTRICT},
-      {"RETURN", FLAG_VERSION_MYSQL_OR_MARIADB_ALL | FLAG_VERSION_LUA, 0, TOKEN_KEYWORD_RETURN},
-      {"RETURNS", 0, 0, TOKEN_KEYWORD_RETURNS},
-      {"REVERSE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_REVERSE},
-      {"REVOKE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_REVOKE},
-      {"RIGHT", FLAG_VERSION_ALL, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_RIGHT},
-      {"RLIKE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_RLIKE},
-      {"ROLE", 0, 0, TOKEN_KEYWORD_ROLE},
-      {"ROLLBACK", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_ROLLBACK},
-      {"ROUND", 0, FLAG_VERSION_ALL, TOKEN_KEYWORD_ROUND},
-      {"ROW", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_ROW},
-      {"ROW_COUNT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ROW_COUNT},
-      {"ROW_NUMBER", 0, FLAG_VERSION_MARIADB_10_2_2, TOKEN_KEYWORD_ROW_NUMBER},
-      {"RPAD", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_RPAD},
-      {"RTRIM", 0, FLAG_VERSION_ALL, TOKEN_KEYWORD_RTRIM},
-      {"SAVEPOINT", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_SAVEPOINT},
-      {"SCHEMA", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_SCHEMA},
-      {"SCHEMAS", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_SCHEMAS},
-      {"SECOND", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_SECOND},
-      {"SECOND_MICROSECOND", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_SECOND_MICROSECOND},
-      {"SECURITY", 0, 0, TOKEN_KEYWORD_SECURITY},
-      {"SEC_TO_TIME", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_SEC_TO_TIME},
-      {"SELECT", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_SELECT},
-      {"SENSITIVE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_SENSITIVE},
-      {"SEPARATOR", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_SEPARATOR},
-      {"SERIAL", 0, 0, TOKEN_KEYWORD_SERIAL},
-      {"SERVER", 0, 0, TOKEN_KEYWORD_SERVER},
-      {"SESSION", 0, 0, TOKEN_KEYWORD_SESSION},
-      {"SESSION_USER", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_SESSION_USER},
-      {"SET", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_SET},
-      {"SHA", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_SHA},
-      {"SHA1", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_SHA1},
-      {"SHA2", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_SHA2},
-      {"SHARED", 0, 0, TOKEN_KEYWORD_SHARED},
-      {"SHOW", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_SHOW},
-      {"SHUTDOWN", 0, 0, TOKEN_KEYWORD_SHUTDOWN},
-      {"SIGN", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_SIGN},
-      {"SIGNAL", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_SIGNAL},
-      {"SIMPLE", 0, 0, TOKEN_KEYWORD_SIMPLE},
-      {"SIN", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_SIN},
-      {"SLEEP", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_SLEEP},
-      {"SLOW", 0, 0, TOKEN_KEYWORD_SLOW},
-      {"SMALLINT", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_SMALLINT},
-      {"SONAME", 0, 0, TOKEN_KEYWORD_SONAME},
-      {"SOUNDEX", 0, FLAG_VERSION_ALL, TOKEN_KEYWORD_SOUNDEX},
-      {"SOURCE", 0, 0, TOKEN_KEYWORD_SOURCE}, /* Ocelot keyword */
-      {"SPACE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_SPACE},
-      {"SPATIAL", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_SPATIAL},
-      {"SPECIFIC", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_SPECIFIC},
-      {"SQL", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_SQL},
-      {"SQLEXCEPTION", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_SQLEXCEPTION},
-      {"SQLSTATE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_SQLSTATE},
-      {"SQLWARNING", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_SQLWARNING},
-      {"SQL_BIG_RESULT", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_SQL_BIG_RESULT},
-      {"SQL_CALC_FOUND_ROWS", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_SQL_CALC_FOUND_ROWS},
-      {"SQL_SMALL_RESULT", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_SQL_SMALL_RESULT},
-      {"SQRT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_SQRT},
-      {"SRID", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_SRID},
-      {"SSL", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_SSL},
-      {"START", 0, 0, TOKEN_KEYWORD_START},
-      {"STARTING", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_STARTING},
-      {"STARTPOINT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_STARTPOINT}, /* deprecated in MySQL 5.7.6 */
-      {"STATUS", 0, 0, TOKEN_KEYWORD_STATUS}, /* Ocelot keyword */
-      {"STD", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_STD},
-      {"STDDEV", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_STDDEV},
-      {"STDDEV_POP", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_STDDEV_POP},
-      {"STDDEV_SAMP", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_STDDEV_SAMP},
-      {"STOP", 0, 0, TOKEN_KEYWORD_STOP},
-      {"STORED", FLAG_VERSION_MYSQL_5_7, 0, TOKEN_KEYWORD_STORED},
-      {"STRAIGHT_JOIN", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_STRAIGHT_JOIN},
-      {"STRCMP", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_STRCMP},
-      {"STRFTIME", 0, FLAG_VERSION_TARANTOOL, TOKEN_KEYWORD_STRFTIME},
-      {"STR_TO_DATE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_STR_TO_DATE},
-      {"ST_AREA", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_AREA},
-      {"ST_ASBINARY", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_ASBINARY},
-      {"ST_ASGEOJSON", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_ASGEOJSON},
-      {"ST_ASTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_ASTEXT},
-      {"ST_ASWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_ASWKB},
-      {"ST_ASWKT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_ASWKT},
-      {"ST_BUFFER", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_BUFFER},
-      {"ST_BUFFER_STRATEGY", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_BUFFER_STRATEGY},
-      {"ST_CENTROID", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_CENTROID},
-      {"ST_CONTAINS", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_CONTAINS},
-      {"ST_CONVEXHULL", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_CONVEXHULL},
-      {"ST_CROSSES", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_CROSSES},
-      {"ST_DIFFERENCE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_DIFFERENCE},
-      {"ST_DIMENSION", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_DIMENSION},
-      {"ST_DISJOINT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_DISJOINT},
-      {"ST_DISTANCE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_DISTANCE},
-      {"ST_DISTANCE_SPHERE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_DISTANCE_SPHERE},
-      {"ST_ENDPOINT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_ENDPOINT},
-      {"ST_ENVELOPE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_ENVELOPE},
-      {"ST_EQUALS", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_EQUALS},
-      {"ST_EXTERIORRING", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_EXTERIORRING},
-      {"ST_GEOHASH", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_GEOHASH},
-      {"ST_GEOMCOLLFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_GEOMCOLLFROMTEXT},
-      {"ST_GEOMCOLLFROMTXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_GEOMCOLLFROMTXT},
-      {"ST_GEOMCOLLFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_GEOMCOLLFROMWKB},
-      {"ST_GEOMETRYCOLLECTIONFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_GEOMETRYCOLLECTIONFROMTEXT},
-      {"ST_GEOMETRYCOLLECTIONFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_GEOMETRYCOLLECTIONFROMWKB},
-      {"ST_GEOMETRYFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_GEOMETRYFROMTEXT},
-      {"ST_GEOMETRYFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_GEOMETRYFROMWKB},
-      {"ST_GEOMETRYN", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_GEOMETRYN},
-      {"ST_GEOMETRYTYPE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_GEOMETRYTYPE},
-      {"ST_GEOMFROMGEOJSON", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_GEOMFROMGEOJSON},
-      {"ST_GEOMFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_GEOMFROMTEXT},
-      {"ST_GEOMFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_GEOMFROMWKB},
-      {"ST_INTERIORRINGN", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_INTERIORRINGN},
-      {"ST_INTERSECTION", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_INTERSECTION},
-      {"ST_INTERSECTS", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_INTERSECTS},
-      {"ST_ISCLOSED", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_ISCLOSED},
-      {"ST_ISEMPTY", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_ISEMPTY},
-      {"ST_ISSIMPLE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_ISSIMPLE},
-      {"ST_ISVALID", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_ISVALID},
-      {"ST_LATFROMGEOHASH", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_LATFROMGEOHASH},
-      {"ST_LENGTH", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_LENGTH},
-      {"ST_LINEFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_LINEFROMTEXT},
-      {"ST_LINEFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_LINEFROMWKB},
-      {"ST_LINESTRINGFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_LINESTRINGFROMTEXT},
-      {"ST_LINESTRINGFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_LINESTRINGFROMWKB},
-      {"ST_LONGFROMGEOHASH", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_LONGFROMGEOHASH},
-      {"ST_MAKEENVELOPE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_MAKEENVELOPE},
-      {"ST_MLINEFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_MLINEFROMTEXT},
-      {"ST_MLINEFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_MLINEFROMWKB},
-      {"ST_MPOINTFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_MPOINTFROMTEXT},
-      {"ST_MPOINTFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_MPOINTFROMWKB},
-      {"ST_MPOLYFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_MPOLYFROMTEXT},
-      {"ST_MPOLYFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_MPOLYFROMWKB},
-      {"ST_MULTILINESTRINGFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_MULTILINESTRINGFROMTEXT},
-      {"ST_MULTILINESTRINGFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_MULTILINESTRINGFROMWKB},
-      {"ST_MULTIPOINTFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_MULTIPOINTFROMTEXT},
-      {"ST_MULTIPOINTFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_MULTIPOINTFROMWKB},
-      {"ST_MULTIPOLYGONFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_MULTIPOLYGONFROMTEXT},
-      {"ST_MULTIPOLYGONFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_MULTIPOLYGONFROMWKB},
-      {"ST_NUMGEOMETRIES", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_NUMGEOMETRIES},
-      {"ST_NUMINTERIORRING", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_NUMINTERIORRING},
-      {"ST_NUMINTERIORRINGS", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_NUMINTERIORRINGS},
-      {"ST_NUMPOINTS", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_NUMPOINTS},
-      {"ST_OVERLAPS", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_OVERLAPS},
-      {"ST_POINTFROMGEOHASH", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_POINTFROMGEOHASH},
-      {"ST_POINTFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_POINTFROMTEXT},
-      {"ST_POINTFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_POINTFROMWKB},
-      {"ST_POINTN", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_POINTN},
-      {"ST_POLYFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_POLYFROMTEXT},
-      {"ST_POLYFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_POLYFROMWKB},
-      {"ST_POLYGONFROMTEXT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_POLYGONFROMTEXT},
-      {"ST_POLYGONFROMWKB", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_POLYGONFROMWKB},
-      {"ST_SIMPLIFY", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_SIMPLIFY},
-      {"ST_SRID", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_SRID},
-      {"ST_STARTPOINT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_STARTPOINT},
-      {"ST_SYMDIFFERENCE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_SYMDIFFERENCE},
-      {"ST_TOUCHES", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_TOUCHES},
-      {"ST_UNION", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_UNION},
-      {"ST_VALIDATE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_VALIDATE},
-      {"ST_WITHIN", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_WITHIN},
-      {"ST_X", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_X},
-      {"ST_Y", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_ST_Y},
-      {"SUBDATE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_SUBDATE},
-      {"SUBSTR", 0, FLAG_VERSION_ALL, TOKEN_KEYWORD_SUBSTR},
-      {"SUBSTRING", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_SUBSTRING},
-      {"SUBSTRING_INDEX", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_SUBSTRING_INDEX},
-      {"SUBTIME", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_SUBTIME},
-      {"SUM", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_SUM},
-      {"SUPER", 0, 0, TOKEN_KEYWORD_SUPER},
-      {"SYSDATE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_SYSDATE},
-      {"SYSTEM", 0, 0, TOKEN_KEYWORD_SYSTEM}, /* Ocelot keyword */
-      {"SYSTEM_USER", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_SYSTEM_USER},
-      {"TABLE", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_TABLE},
-      {"TABLESPACE", 0, 0, TOKEN_KEYWORD_TABLESPACE},
-      {"TAN", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_TAN},
-      {"TEE", 0, 0, TOKEN_KEYWORD_TEE}, /* Ocelot keyword */
-      {"TEMP", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_TEMP},
-      {"TEMPORARY", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_TEMPORARY},
-      {"TERMINATED", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_TERMINATED},
-      {"THEN", FLAG_VERSION_ALL | FLAG_VERSION_LUA, 0, TOKEN_KEYWORD_THEN},
-      {"TIME", 0, FLAG_VERSION_ALL, TOKEN_KEYWORD_TIME},
-      {"TIMEDIFF", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_TIMEDIFF},
-      {"TIMESTAMP", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_TIMESTAMP},
-      {"TIMESTAMPADD", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_TIMESTAMPADD},
-      {"TIMESTAMPDIFF", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_TIMESTAMPDIFF},
-      {"TIME_FORMAT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_TIME_FORMAT},
-      {"TIME_TO_SEC", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_TIME_TO_SEC},
-      {"TINYBLOB", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_TINYBLOB},
-      {"TINYINT", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_TINYINT},
-      {"TINYTEXT", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_TINYTEXT},
-      {"TO", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_TO},
-      {"TOTAL_CHANGES", 0, FLAG_VERSION_TARANTOOL, TOKEN_KEYWORD_TOTAL_CHANGES},
-      {"TOUCHES", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_TOUCHES}, /* deprecated in MySQL 5.7.6 */
-      {"TO_BASE64", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_TO_BASE64},
-      {"TO_DAYS", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_TO_DAYS},
-      {"TO_SECONDS", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_TO_SECONDS},
-      {"TRAILING", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_TRAILING},
-      {"TRANSACTION", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_TRANSACTION},
-      {"TRIGGER", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_TRIGGER},
-      {"TRIM", 0, FLAG_VERSION_ALL, TOKEN_KEYWORD_TRIM},
-      {"TRUE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL | FLAG_VERSION_LUA, 0, TOKEN_KEYWORD_TRUE},
-      {"TRUNCATE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_TRUNCATE},
-      {"TYPEOF", 0, FLAG_VERSION_TARANTOOL, TOKEN_KEYWORD_TYPEOF},
-      {"UCASE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_UCASE},
-      {"UNBOUNDED", 0, 0, TOKEN_KEYWORD_UNBOUNDED},
-      {"UNCOMPRESS", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_UNCOMPRESS},
-      {"UNCOMPRESSED_LENGTH", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_UNCOMPRESSED_LENGTH},
-      {"UNDO", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_UNDO},
-      {"UNHEX", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_UNHEX},
-      {"UNICODE", 0, FLAG_VERSION_TARANTOOL, TOKEN_KEYWORD_UNICODE},
-      {"UNINSTALL", 0, 0, TOKEN_KEYWORD_UNINSTALL},
-      {"UNION", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_UNION},
-      {"UNIQUE", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_UNIQUE},
-      {"UNIX_TIMESTAMP", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_UNIX_TIMESTAMP},
-      {"UNKNOWN", 0, 0, TOKEN_KEYWORD_UNKNOWN},
-      {"UNLOCK", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_UNLOCK},
-      {"UNSIGNED", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_UNSIGNED},
-      {"UNTIL", FLAG_VERSION_LUA, 0, TOKEN_KEYWORD_UNTIL},
-      {"UPDATE", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_UPDATE},
-      {"UPDATEXML", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_UPDATEXML},
-      {"UPPER", 0, FLAG_VERSION_ALL, TOKEN_KEYWORD_UPPER},
-      {"USAGE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_USAGE},
-      {"USE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_USE}, /* Ocelot keyword, also reserved word */
-      {"USER", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_USER},
-      {"USING", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_USING},
-      {"UTC_DATE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_UTC_DATE},
-      {"UTC_TIME", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_UTC_TIME},
-      {"UTC_TIMESTAMP", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_UTC_TIMESTAMP},
-      {"UUID", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_UUID},
-      {"UUID_SHORT", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_UUID_SHORT},
-      {"VACUUM", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_VACUUM},
-      {"VALIDATE_PASSWORD_STRENGTH", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_VALIDATE_PASSWORD_STRENGTH},
-      {"VALIDATION", 0, 0, TOKEN_KEYWORD_VALIDATION},
-      {"VALUES", FLAG_VERSION_ALL, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_VALUES},
-      {"VARBINARY", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_VARBINARY},
-      {"VARCHAR", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_VARCHAR},
-      {"VARCHAR2", 0, 0, TOKEN_KEYWORD_VARCHAR2},
-      {"VARCHARACTER", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_VARCHARACTER},
-      {"VARIANCE", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_VARIANCE},
-      {"VARYING", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_VARYING},
-      {"VAR_POP", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_VAR_POP},
-      {"VAR_SAMP", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_VAR_SAMP},
-      {"VERSION", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_VERSION},
-      {"VIEW", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_VIEW},
-      {"VIRTUAL", FLAG_VERSION_MYSQL_5_7 | FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_VIRTUAL},
-      {"WAIT_FOR_EXECUTED_GTID_SET", 0, FLAG_VERSION_MYSQL_ALL, TOKEN_KEYWORD_WAIT_FOR_EXECUTED_GTID_SET},
-      {"WAIT_UNTIL_SQL_THREAD_AFTER_GTIDS", 0, FLAG_VERSION_MYSQL_ALL, TOKEN_KEYWORD_WAIT_UNTIL_SQL_THREAD_AFTER_GTIDS},
-      {"WARNINGS", 0, 0, TOKEN_KEYWORD_WARNINGS}, /* Ocelot keyword */
-      {"WEEK", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_WEEK},
-      {"WEEKDAY", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_WEEKDAY},
-      {"WEEKOFYEAR", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_WEEKOFYEAR},
-      {"WEIGHT_STRING", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_WEIGHT_STRING},
-      {"WHEN", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_WHEN},
-      {"WHERE", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_WHERE},
-      {"WHILE", FLAG_VERSION_ALL | FLAG_VERSION_LUA, 0, TOKEN_KEYWORD_WHILE},
-      {"WITH", FLAG_VERSION_ALL, 0, TOKEN_KEYWORD_WITH},
-      {"WITHIN", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_WITHIN}, /* deprecated in MySQL 5.7.6 */
-      {"WITHOUT", FLAG_VERSION_TARANTOOL, 0, TOKEN_KEYWORD_WITHOUT},
-      {"WRITE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_WRITE},
-      {"X", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_X}, /* deprecated in MySQL 5.7.6 */
-      {"XA", 0, 0, TOKEN_KEYWORD_XA},
-      {"XOR", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_XOR},
-      {"Y", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_Y}, /* deprecated in MySQL 5.7.6 */
-      {"YEAR", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_YEAR},
-      {"YEARWEEK", 0, FLAG_VERSION_MYSQL_OR_MARIADB_ALL, TOKEN_KEYWORD_YEARWEEK},
-      {"YEAR_MONTH", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_YEAR_MONTH},
-      {"ZEROFILL", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD_ZEROFILL},
-      {"_ARMSCII8", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__ARMSCII8},
-      {"_ASCII", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__ASCII},
-      {"_BIG5", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__BIG5},
-      {"_BINARY", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__BINARY},
-      {"_CP1250", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__CP1250},
-      {"_CP1251", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__CP1251},
-      {"_CP1256", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__CP1256},
-      {"_CP1257", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__CP1257},
-      {"_CP850", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__CP850},
-      {"_CP852", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__CP852},
-      {"_CP866", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__CP866},
-      {"_CP932", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__CP932},
-      {"_DEC8", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__DEC8},
-      {"_EUCJPMS", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__EUCJPMS},
-      {"_EUCKR", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__EUCKR},
-      {"_FILENAME", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__FILENAME},
-      {"_GB2312", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__GB2312},
-      {"_GBK", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__GBK},
-      {"_GEOSTD8", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__GEOSTD8},
-      {"_GREEK", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__GREEK},
-      {"_HEBREW", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__HEBREW},
-      {"_HP8", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__HP8},
-      {"_KEYBCS2", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__KEYBCS2},
-      {"_KOI8R", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__KOI8R},
-      {"_KOI8U", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__KOI8U},
-      {"_LATIN1", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__LATIN1},
-      {"_LATIN2", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__LATIN2},
-      {"_LATIN5", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__LATIN5},
-      {"_LATIN7", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__LATIN7},
-      {"_MACCE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__MACCE},
-      {"_MACROMAN", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__MACROMAN},
-      {"_SJIS", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__SJIS},
-      {"_SWE7", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__SWE7},
-      {"_TIS620", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__TIS620},
-      {"_UCS2", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__UCS2},
-      {"_UJIS", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__UJIS},
-      {"_UTF16", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__UTF16},
-      {"_UTF16LE", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__UTF16LE},
-      {"_UTF32", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__UTF32},
-      {"_UTF8", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__UTF8},
-      {"_UTF8MB4", FLAG_VERSION_MYSQL_OR_MARIADB_ALL, 0, TOKEN_KEYWORD__UTF8MB4}
-    };
-  //QString text;
-  QString s= "";
+/*
+  The part of tokens_to_keywords() that looks at one token at a time:
+  token_type(), then keyword lookup. For tokens start to end-1, or to the
+  last token if end == -1. Since it doesn't look at neighbours, it can be
+  done for only the tokens that editor_tokens_update() re-tokenized.
+*/
+void MainWindow::tokens_to_keywords_lookup(QString text, int start, int end)
+{
   int t;
-  char *p_item;
-  unsigned long index;
+  int index;
   char key2[MAX_KEYWORD_LENGTH + 1];
   int i, i2;
+  const QChar *text_data= text.constData();
 
-  //text= statement_edit_widget->toPlainText();
-  for (i2= start; main_token_lengths[i2] != 0; ++i2)
+  for (i2= start; (main_token_lengths[i2] != 0) && (i2 != end); ++i2)
   {
     /* Get the next word. */
-    s= text.mid(main_token_offsets[i2], main_token_lengths[i2]);
-    t= token_type(s.data(), main_token_lengths[i2]);
+    const QChar *token= text_data + main_token_offsets[i2];
+    t= token_type((QChar*) token, main_token_lengths[i2]);
     main_token_types[i2]= t;
     main_token_flags[i2]= 0;
     main_token_pointers[i2]= 0;
     main_token_reftypes[i2]= 0;
     if ((t == TOKEN_TYPE_OTHER) && (main_token_lengths[i2] < MAX_KEYWORD_LENGTH))
     {
-      /* It's not a literal or operator. Maybe it's a keyword. Convert it to char[]. */
-      QByteArray key_as_byte_array= s.toLocal8Bit();
-      const char *key= key_as_byte_array.data();
-      /* Uppercase it. I don't necessarily have strupr(). */
-      for (i= 0; (*(key + i) != '\0') && (i < MAX_KEYWORD_LENGTH); ++i) key2[i]= toupper(*(key + i)); key2[i]= '\0';
-      /* If the following assert happens, you inserted/removed something without changing "868" */
-
-      assert(TOKEN_KEYWORD__UTF8MB4 == TOKEN_KEYWORD_QUESTIONMARK + (868 - 1));
-
-      /* Test strvalues is ordered by bsearching for every item. */
-      //for (int ii= 0; ii < 868; ++ii)
-      //{
-      //  char *k= (char*) &strvalues[ii].chars;
-      //  p_item= (char*) bsearch(k, strvalues, 868, sizeof(struct keywords), (int(*)(const void*, const void*)) strcmp);
-      //  assert(p_item != NULL);
-      //  index= ((((unsigned long)p_item - (unsigned long)strvalues)) / sizeof(struct keywords));
-      //  index+= TOKEN_KEYWORDS_START;
-      ////  printf("ii=%d, index=%d, k=%s.\n", ii, index, k);
-      //  assert(index == strvalues[ii].token_keyword);
-      //}
-
-      /* TODO: you don't need to calculate index, it's strvalues[...].token_keyword. */
-      /* Search it with library binary-search. Assume 868 items and everything MAX_KEYWORD_LENGTH bytes long. */
-      p_item= (char*) bsearch(key2, strvalues, 868, sizeof(struct keywords), (int(*)(const void*, const void*)) strcmp);
-      if (p_item != NULL)
+      /* It's not a literal or operator. Maybe it's a keyword. Uppercase it into key2[]. */
+      /* All keywords are ASCII so if there's anything else, it's not one. */
+      for (i= 0; i < main_token_lengths[i2]; ++i)
+      {
+        if (token[i].unicode() > 127) break;
+        key2[i]= toupper((char) token[i].unicode());
+      }
+      if (i < main_token_lengths[i2]) continue;
+      key2[i]= '\0';
+      index= keyword_find(key2, i);
+      if (index != -1)
       {
         /* It's in the list, so instead of TOKEN_TYPE_OTHER, make it TOKEN_KEYWORD_something. */
-        index= ((((unsigned long)p_item - (unsigned long)strvalues)) / sizeof(struct keywords));
         if ((strvalues[index].reserved_flags & dbms_version_mask) != 0)
           main_token_flags[i2]= (main_token_flags[i2] | TOKEN_FLAG_IS_RESERVED);
         if ((strvalues[index].built_in_function_flags & dbms_version_mask) != 0)
@@ -10319,8 +14813,7 @@ void MainWindow::tokens_to_keywords(QString text, int start)
         }
         if ((strvalues[index].reserved_flags & FLAG_VERSION_LUA) != 0)
           main_token_flags[i2]= (main_token_flags[i2] | TOKEN_FLAG_IS_MAYBE_LUA);
-        index+= TOKEN_KEYWORDS_START;
-        main_token_types[i2]= index;
+        main_token_types[i2]= strvalues[index].token_keyword;
       }
 #ifdef DEBUGGER
       else
@@ -10352,10 +14845,23 @@ void MainWindow::tokens_to_keywords(QString text, int start)
     }
   }
 
-  /* Global. Sometimes we'll want to know how many tokens there are. */
-  main_token_count_in_all= i2;
+  if (end == -1)
+  {
+    /* Global. Sometimes we'll want to know how many tokens there are. */
+    main_token_count_in_all= i2;
+
+    main_token_types[i2]= 0;
+  }
+}
 
-  main_token_types[i2]= 0;
+/*
+  The part of tokens_to_keywords() that depends on neighbouring tokens.
+  Expects main_token_count_in_all to be set, as tokens_to_keywords_lookup() does.
+*/
+void MainWindow::tokens_to_keywords_context(QString text, int start)
+{
+  QString s;
+  int i2= main_token_count_in_all;
 
   /* The special cases of BEGIN, DO, END, FUNCTION, ROW. */
   int i_of_function= -1;
@@ -10446,7 +14952,6 @@ void MainWindow::tokens_to_keywords(QString text, int start)
     if (s == QString("\\u")) main_token_types[xx]= main_token_types[xx + 1]= TOKEN_KEYWORD_USE;
     if (s == QString("\\W")) main_token_types[xx]= main_token_types[xx + 1]= TOKEN_KEYWORD_WARNINGS;
   }
-  log("tokens_to_keywords end", 80);
 }
 
 /*
@@ -11050,6 +15555,11 @@ int MainWindow::connect_mysql(unsigned int connection_number)
 
   /* I decided this line is unnecessary, mysql_init is done in options_and_connect() */
   //lmysql->ldbms_mysql_init(&mysql[connection_number]);
+  /*
+    A CONNECT might be to a different server, so put back what profile_start()
+    changed on the old one while we can, profile_capture() will start again.
+  */
+  if (connection_number == MYSQL_MAIN_CONNECTION) profile_stop();
   if (the_connect(connection_number))
   {
     put_diagnostics_in_result(connection_number);
@@ -12861,6 +17371,7 @@ TextEditFrame::TextEditFrame(QWidget *parent, ResultGrid *result_grid_widget, un
   ancestor_result_grid_widget= result_grid_widget;
   text_edit_frames_index= index;
   is_style_sheet_set_flag= false;
+  is_truncated_flag= false;
   hide();
 }
 
@@ -13288,6 +17799,33 @@ void TextEditWidget::keyPressEvent(QKeyEvent *event)
 }
 
 
+/*
+  Double-click on a cell which has only a prefix of a BLOB|TEXT value
+  (see lazy_blob_rewrite()) means: get the full value and show it.
+  result_set_copy still has only the prefix, so after a scroll the
+  prefix shows again. Todo: keep the full value, or let the user choose.
+  Todo: images -- TextEditWidget::paintEvent() still uses content_pointer.
+*/
+void TextEditWidget::mouseDoubleClickEvent(QMouseEvent *event)
+{
+  if ((text_edit_frame_of_cell->is_truncated_flag == true)
+   && (text_edit_frame_of_cell->cell_type != TEXTEDITFRAME_CELL_TYPE_HEADER))
+  {
+    ResultGrid *result_grid= text_edit_frame_of_cell->ancestor_result_grid_widget;
+    QByteArray value;
+    if (result_grid->lazy_blob_fetch(text_edit_frame_of_cell->ancestor_grid_result_row_number,
+                                     text_edit_frame_of_cell->ancestor_grid_column_number,
+                                     &value) == 0)
+    {
+      setText(QString::fromUtf8(value.constData(), value.size()));
+      text_edit_frame_of_cell->is_truncated_flag= false;
+      return;
+    }
+  }
+  QTextEdit::mouseDoubleClickEvent(event);
+}
+
+
 /*
   If the cell has text then we did setText() and QTextEdit::copy() should work okay.
   The reason that we reimplement copy(), and call it from QKeySequence, is:
@@ -14496,6 +19034,13 @@ void MainWindow::connect_set_variable(QString token0, QString token2)
   if (strcmp(token0_as_utf8, "ocelot_grid_cell_border_size") == 0) { ocelot_grid_cell_border_size= token2; return; }
   if (strcmp(token0_as_utf8, "ocelot_grid_cell_drag_line_size") == 0) { ocelot_grid_cell_drag_line_size= token2; return; }
   if (strcmp(token0_as_utf8, "ocelot_grid_tabs") == 0) { ocelot_grid_tabs= to_long(token2); return; }
+  if (strcmp(token0_as_utf8, "ocelot_grid_lazy_blob_length") == 0) { ocelot_grid_lazy_blob_length= to_long(token2); return; }
+  if (strcmp(token0_as_utf8, "ocelot_export_format") == 0) { ocelot_export_format= token2.toLower(); return; }
+  if (strcmp(token0_as_utf8, "ocelot_export_file") == 0) { ocelot_export_file= token2; return; }
+  if (strcmp(token0_as_utf8, "ocelot_prepared_statement_cache") == 0) { ocelot_prepared_statement_cache= to_long(token2); return; }
+  if (strcmp(token0_as_utf8, "ocelot_source_batch_size") == 0) { ocelot_source_batch_size= to_long(token2); return; }
+  if (strcmp(token0_as_utf8, "ocelot_statement_profile") == 0) { ocelot_statement_profile= to_long(token2); return; }
+  if (strcmp(token0_as_utf8, "ocelot_statement_timing") == 0) { ocelot_statement_timing= to_long(token2); return; }
   if (strcmp(token0_as_utf8, "ocelot_history_text_color") == 0)
   { ccn= canonical_color_name(token2); if (ccn != "") ocelot_history_text_color= ccn; return; }
   if (strcmp(token0_as_utf8, "ocelot_history_background_color") == 0)
@@ -14509,6 +19054,7 @@ void MainWindow::connect_set_variable(QString token0, QString token2)
   if (strcmp(token0_as_utf8, "ocelot_history_font_weight") == 0)
   { ccn= canonical_font_weight(token2); if (ccn != "") ocelot_history_font_weight= ccn; return; }
   if (strcmp(token0_as_utf8, "ocelot_history_max_row_count") == 0) { ocelot_history_max_row_count= token2; return; }
+  if (strcmp(token0_as_utf8, "ocelot_history_max_result_bytes") == 0) { ocelot_history_max_result_bytes= to_long(token2); return; }
   if (strcmp(token0_as_utf8, "ocelot_language") == 0) { ocelot_language= token2; return; }
   if (strcmp(token0_as_utf8, "ocelot_menu_text_color") == 0)
   { ccn= canonical_color_name(token2); if (ccn != "") ocelot_menu_text_color= ccn; return; }
@@ -14565,7 +19111,25 @@ void MainWindow::connect_set_variable(QString token0, QString token2)
     return;
   }
   if (strcmp(token0_as_utf8, "one_database") == 0) { ocelot_one_database= is_enable; return; }
-  if (strcmp(token0_as_utf8, "pager") == 0) { ocelot_pager= is_enable; return; }
+  if (strcmp(token0_as_utf8, "pager") == 0)
+  {
+    /*
+      The value is a command, e.g. --pager='less -S', so is_enable's test
+      for ON|TRUE|1 doesn't apply. --skip-pager or --pager=OFF|FALSE|0 means off.
+      --pager or --pager=ON|TRUE|1 means on with the old ocelot_pager, see export_file_for_result().
+    */
+    QString token2_upper= token2.toUpper();
+    if (((is_enable_disable_skip_specified == true) && (is_enable == 0))
+     || (token2_upper == "OFF") || (token2_upper == "FALSE") || (token2 == "0"))
+    {
+      ocelot_pager_is_on= false;
+      return;
+    }
+    if ((token2 != "") && (token2_upper != "ON") && (token2_upper != "TRUE") && (token2 != "1"))
+      ocelot_pager= token2;
+    ocelot_pager_is_on= true;
+    return;
+  }
   if ((token0_length >= sizeof("pas") - 1) && (strncmp(token0_as_utf8, "password", token0_length) == 0))
   {
     ocelot_password= token2;
@@ -14922,6 +19486,18 @@ int options_and_connect(
     lmysql->ldbms_mysql_options(&mysql[connection_number], OCELOT_OPTION_3, init_command);
   }
 
+  /*
+    MYSQL_OPT_NONBLOCK (MariaDB only) must be set before connecting if we
+    want to use the non-blocking API for this connection, see dbms_nonblocking_run().
+    NULL means the library's default stack size for the async context.
+  */
+  dbms_is_nonblocking[connection_number]= false;
+  if (lmysql->ldbms_mysql_is_nonblocking_available())
+  {
+    if (lmysql->ldbms_mysql_options(&mysql[connection_number], OCELOT_OPTION_6000, NULL) == 0)
+      dbms_is_nonblocking[connection_number]= true;
+  }
+
   /* CLIENT_MULTI_RESULTS but not CLIENT_MULTI_STATEMENTS */
   unsigned long real_connect_flags= CLIENT_MULTI_RESULTS;
   if (ocelot_opt_can_handle_expired_passwords != 0)
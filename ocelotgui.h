@@ -68,9 +68,13 @@
 #include <QDateTime>
 #include <QDialog>
 #include <QDir>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QSocketNotifier>
 #include <QFontDialog>
 #include <QFrame>
 #include <QHBoxLayout>
+#include <QHash>
 #include <QLabel>
 #include <QSpinBox>
 #ifndef __linux
@@ -85,10 +89,13 @@
 #include <QPushButton>
 #include <QScrollArea>
 #include <QScrollBar>
+#include <QStatusBar>
 #include <QTextBlock>
+#include <QTextLayout>
 #include <QTextEdit>
 #include <QThread>
 #include <QTimer>
+#include <QVector>
 //#include <QWidget>
 #include <QTextStream>
 #include <QDesktopWidget>
@@ -103,6 +110,7 @@
   We use getpwuid() when getting password, therefore include pwd.h.
   We use pthread_create() for debug and kill, therefore include pthread.h.
   We use stat() to see if a configuration file is world-writable, therefore include stat.h.
+  We use signal() to ignore SIGPIPE when export output goes to a pipe, therefore include signal.h.
   Todo: Maybe we should be looking for Qt's Q_OS_LINUX etc. not __linux etc.
 */
 #ifdef __linux
@@ -111,6 +119,12 @@
 #include <pwd.h>
 #include <pthread.h>
 #include <sys/stat.h>
+#include <signal.h>
+#endif
+
+/* tokenize_skip_till() looks at 8 QChars at a time if there's SSE2, therefore include emmintrin.h. */
+#if defined(__SSE2__)
+#include <emmintrin.h>
 #endif
 
 #ifdef DBMS_TARANTOOL
@@ -293,6 +307,24 @@ extern int MENU_PICK_NEW_FONT;
 
 extern unsigned int menu_off;
 
+struct source_state; /* see source_run() */
+struct source_scanner;
+struct source_parallel_worker;
+
+/* Phases of a statement for SET ocelot_statement_timing, see statement_timing_mark() */
+#define STATEMENT_TIMING_TOKENIZE 0
+#define STATEMENT_TIMING_PARSE 1
+#define STATEMENT_TIMING_CLIENT 2
+#define STATEMENT_TIMING_UTF8 3
+#define STATEMENT_TIMING_SEND 4
+#define STATEMENT_TIMING_SERVER 5
+#define STATEMENT_TIMING_STORE 6
+#define STATEMENT_TIMING_SCAN 7
+#define STATEMENT_TIMING_LAYOUT 8
+#define STATEMENT_TIMING_PAINT 9
+#define STATEMENT_TIMING_MAX 10
+void statement_timing_mark(int phase);
+
 namespace Ui
 {
 class MainWindow;
@@ -318,8 +350,44 @@ class QScrollAreaWithSize;
 class QThread48;
 class QTabWidget48;
 class TextEditHistory;
+class StatementHighlighter;
 QT_END_NAMESPACE
 
+/*
+  Token arrays: what tokenize() + tokens_to_keywords() + hparse produce.
+  Struct of arrays, all six carved from one allocation ("arena") so
+  growth is one new[] and one delete[]. Copying is not allowed,
+  but swap() exchanges two buffers without copying any tokens.
+  MainWindow::main_token_* point into main_token_buffer, see main_token_use().
+*/
+struct token_buffer
+{
+  char *arena;
+  int  *offsets;
+  int  *lengths;
+  int  *types;
+  unsigned int *flags;
+  int  *pointers;
+  unsigned char *reftypes;
+  unsigned int max_count;
+  unsigned int count_in_all;
+  token_buffer();
+  ~token_buffer();
+  void reserve(unsigned int desired_count);
+  void swap(token_buffer &other);
+private:
+  token_buffer(const token_buffer &);
+  token_buffer &operator=(const token_buffer &);
+};
+
+/* What hparse found for one statement, see hparse_f_statement_cache_restore() */
+struct hparse_statement_cache_entry
+{
+  unsigned int hash;    /* of all the statement's tokens as they were before hparse */
+  int token_count;
+  QByteArray results;   /* main_token_types|flags|reftypes as they were after hparse */
+};
+
 class MainWindow : public QMainWindow
 {
   Q_OBJECT
@@ -511,9 +579,13 @@ public:
   void hparse_f_error();
   bool hparse_f_is_equal(QString,QString);
   bool hparse_f_is_special_verb(int);
+  int hparse_f_accept(unsigned short int,unsigned char,int,const char*);
   int hparse_f_accept(unsigned short int,unsigned char,int,QString);
+  bool hparse_f_token_is(const char*,bool);
+  void hparse_f_expected_append(const char*);
   int hparse_f_acceptn(int,QString,int);
   QString hparse_f_token_to_appendee(QString,int);
+  int hparse_f_expect(unsigned short int,unsigned char,int,const char*);
   int hparse_f_expect(unsigned short int,unsigned char,int,QString);
   int hparse_f_literal();
   int hparse_f_default(int);
@@ -561,6 +633,8 @@ public:
   void hparse_f_show_columns();
   void hparse_f_if_not_exists();
   void hparse_f_indexes_or_keys();
+  void hparse_f_show_expect(const char*);
+  void hparse_f_show();
   void hparse_f_alter_or_create_clause(int,unsigned short int*,bool*);
   int hparse_f_semicolon_and_or_delimiter(int);
   int hparse_f_explainable_statement(int);
@@ -668,6 +742,13 @@ public:
   int hparse_f_variables(bool);
   void msgBoxClosed(QAbstractButton*);
   void hparse_f_multi_block(QString text);
+  void hparse_f_show_hint();
+  void hparse_f_statement_cache_start(QString);
+  void hparse_f_statement_cache_hash_tokens(QString, int);
+  int hparse_f_statement_cache_segment(int);
+  unsigned int hparse_f_statement_cache_key(int, int);
+  bool hparse_f_statement_cache_restore();
+  void hparse_f_statement_cache_save();
   int hparse_f_backslash_command(bool);
   void hparse_f_other(int);
   int hparse_f_client_statement();
@@ -706,9 +787,12 @@ public:
                  char **p_result_field_names);
   int create_table_server(QString, bool *, unsigned int, unsigned int);
   QString tarantool_read_format(QString);
-  void log(const char*,int);
+  static void log(const char*,int);
   int real_query(QString, int);
+  int real_query_of_tokens(QString, int);
+  int real_query_send(int);
 #endif
+  int lazy_blob_select(QString select_statement, QByteArray *value);
   QVBoxLayout *main_layout;
 
 public slots:
@@ -723,6 +807,13 @@ public slots:
   void action_libmysqlclient();
   void action_settings();
   void action_statement_edit_widget_text_changed();
+  void history_result_expand(int);
+  void action_statement_edit_widget_contents_change(int, int, int);
+  void statement_highlight_visible(int);
+  void hparse_background_start();
+  void hparse_background_done(int);
+  void dbms_long_query_done();
+  void statement_timing_paint();
   void action_undo();
   void statement_edit_widget_formatter();
   void action_change_one_setting(QString old_setting, QString new_setting, const char *name_of_setting);
@@ -803,7 +894,8 @@ private:
   void debug_maintain_prompt(int action, int debug_widget_index, int line_number);
   QString debug_privilege_check(int statement_type);
 #endif
-  void main_token_new(int), main_token_push(), main_token_pop();
+  void main_token_new(int), main_token_use(), main_token_push(), main_token_pop();
+  void editor_token_use();
   void create_menu();
   int rehash_scan();
   QString rehash_search(char *search_string, int reftype);
@@ -811,6 +903,23 @@ private:
   void widget_sizer();
   QString get_delimiter(QString,QString,int);
   int execute_client_statement(QString text, int *additional_result);
+  bool source_is_client_statement(const char *, int);
+  void source_error(source_state *, unsigned long);
+  int source_query(source_state *, const char *, int, unsigned long);
+  int source_batch_flush(source_state *);
+  void source_progress(source_state *, QFile *);
+  void source_end(source_state *, source_scanner *);
+  int source_by_editor(source_state *, source_scanner *, const char *, int);
+  int source_run(QFile *);
+  void parallel_wait(pthread_mutex_t *);
+  void source_parallel_wait_till_idle(int);
+  void source_parallel_put(source_parallel_worker *, QByteArray, unsigned long);
+  int source_parallel_run(QFile *, int);
+  int bench_run(QString, unsigned long, int);
+  QString profile_start();
+  void profile_stop();
+  QString profile_capture(bool);
+  MYSQL_RES *profile_query(QString);
   void put_diagnostics_in_result(unsigned int);
   void put_message_in_result(QString);
   void make_and_put_message_in_result(unsigned int, int, char*);
@@ -843,11 +952,16 @@ private:
   //void create_the_manual_widget();
   int get_next_statement_in_string(int passed_main_token_number, int *returned_begin_count, bool);
   int make_statement_ready_to_send(QString, char *, int);
+  void make_statement_ready_to_send_from_tokens(QString, QStringList *parameters= NULL);
   void remove_statement(QString);
   int action_execute_one_statement(QString text);
+  void statement_timing_end();
 
   void history_markup_make_strings();
-  void history_markup_append(QString result_set_for_history, bool is_interactive);
+  void history_markup_append(QByteArray result_set_for_history, bool is_interactive);
+  unsigned int history_result_add(QByteArray snapshot);
+  void history_result_trim();
+  QString history_result_render(QByteArray snapshot);
   QString history_markup_copy_for_history(QString);
   int history_file_start(QString, QString);        /* see comment=tee+hist */
   void history_file_stop(QString);                 /* see comment=tee+hist */
@@ -872,11 +986,43 @@ private:
 #define FLAG_FOR_HIGHLIGHTS 1
 #define FLAG_FOR_ERRORS     2
 
-  void tokenize(QChar *text, int text_length, int *token_lengths, int *token_offsets, int max_tokens, QChar *version, int passed_comment_behaviour, QString special_token, int minus_behaviour);
+/* editor_token_highlights[] values, see statement_highlight() */
+#define HIGHLIGHT_OTHER      0
+#define HIGHLIGHT_LITERAL    1
+#define HIGHLIGHT_IDENTIFIER 2
+#define HIGHLIGHT_COMMENT    3
+#define HIGHLIGHT_OPERATOR   4
+#define HIGHLIGHT_KEYWORD    5
+#define HIGHLIGHT_FUNCTION   6
+#define HIGHLIGHT_COUNT      7
+#define HIGHLIGHT_IS_ERROR   128
+
+/* hparse_background_state values, see hparse_background_start() */
+#define HPARSE_BACKGROUND_IDLE    0
+#define HPARSE_BACKGROUND_RUNNING 1
+#define HPARSE_BACKGROUND_ENDED   2
+#define HPARSE_DEBOUNCE_MS      300  /* how long the user must stop typing before we parse */
+
 
   int token_type(QChar *token, int token_length);
 
   void tokens_to_keywords(QString text, int start);
+  void tokens_to_keywords_lookup(QString text, int start, int end);
+  void tokens_to_keywords_context(QString text, int start);
+  bool editor_tokens_update(QString text);
+  void editor_tokens_save(QString text, bool is_whole);
+  void statement_highlight(QString text, int change_position, int change_added, int delta);
+  void editor_tokens_restore();
+  void hparse_background_cancel();
+  void dbms_long_query_wait(volatile int *);
+  int dbms_executor_run(unsigned int, int, const char *, unsigned long, MYSQL_RES **, MYSQL_STMT *stmt= NULL, bool is_user_statement= false);
+  bool prepared_statement_is_parameter(QString, unsigned int, unsigned int);
+  bool prepared_statement_run(unsigned int, QStringList);
+  void prepared_statement_cache_clear(unsigned int);
+  int dbms_nonblocking_run(unsigned int, int, const char *, unsigned long, MYSQL_RES **, bool);
+  int dbms_nonblocking_wait(MYSQL *, int);
+  void dbms_executors_stop();
+  void hparse_background_finish();
   void tokens_to_keywords_revert(int i_of_body, int i_of_function, int i_of_do, QString text, int start);
   int next_token(int i);
   bool is_client_statement(int, int, QString);
@@ -892,6 +1038,21 @@ private:
   QString tarantool_internal_query(char*, int);
 #endif
   QString select_1_row(const char *select_statement);
+  QString lazy_blob_rewrite(QString text);
+  QString lazy_blob_table;
+  QStringList lazy_blob_column_names;
+  int export_result_set(unsigned int connection_number, QString format, QString file_name);
+  QString export_format_for_result();
+  QString export_file_for_result();
+  void run_headless();
+  bool is_headless;
+  QList<QByteArray> history_result_snapshots;  /* ring of copy_to_history() results, oldest first */
+  QList<unsigned int> history_result_ids;      /* id in "[result set #id]" marker for each snapshot */
+  unsigned int history_result_bytes;           /* sum of snapshot sizes + rendered sizes */
+  QList<QTextCursor> history_result_rendered_cursors; /* selection = a rendered result set in the document, oldest first */
+  QList<unsigned int> history_result_rendered_ids;
+  QList<int> history_result_rendered_sizes;
+  unsigned int history_result_next_id;
 
   QWidget *main_window;
 
@@ -984,10 +1145,13 @@ private:
 #endif
 
 public:
+  /* static, and public, so bench/bench_tokenize.cpp can call it without a MainWindow */
+  static void tokenize(QChar *text, int text_length, int *token_lengths, int *token_offsets, int max_tokens, QChar *version, int passed_comment_behaviour, QString special_token, int minus_behaviour);
   int tarantool_execute_sql(const char *, unsigned long, unsigned int, int, QString);
   QString query_utf16;
   QString query_utf16_copy;
-  /* main_token_offsets|lengths|types|flags|pointers are alloc'd in main_token_new() */
+  /* main_token_offsets|lengths|types|flags|pointers|reftypes|max_count are main_token_buffer's, see main_token_use() */
+  token_buffer main_token_buffer;
   int  *main_token_offsets;
   int  *main_token_lengths;
   int  *main_token_types;
@@ -999,17 +1163,55 @@ public:
   unsigned int main_token_count_in_statement;
   unsigned int main_token_number;      /* = offset within main_token_offsets, e.g. 0 if currently at first token */
 
-  int  *saved_main_token_offsets;
-  int  *saved_main_token_lengths;
-  int  *saved_main_token_types;
-  unsigned int *saved_main_token_flags;
-  int  *saved_main_token_pointers;
-  unsigned char *saved_main_token_reftypes;
-  /* unsigned int saved_main_token_max_count; doesn't need saving */
-  unsigned int saved_main_token_count_in_all;
+  token_buffer saved_main_token_buffer;  /* main_token_push() swaps, doesn't copy */
   unsigned int saved_main_token_count_in_statement;
   unsigned int saved_main_token_number;
 
+  /*
+    editor_token_offsets|lengths|types|flags are what tokenize() +
+    tokens_to_keywords_lookup() gave for editor_token_text, i.e. the
+    statement_edit_widget contents, before tokens_to_keywords_context()
+    or hparse changed anything. editor_change_* is what the document
+    said changed since then. See editor_tokens_update().
+  */
+  token_buffer editor_token_buffer;      /* editor_token_offsets|lengths|types|flags|max_count are its, see editor_token_use() */
+  int  *editor_token_offsets;
+  int  *editor_token_lengths;
+  int  *editor_token_types;
+  unsigned int *editor_token_flags;
+  unsigned int editor_token_max_count;
+  unsigned int editor_token_count;
+  bool editor_token_is_valid;
+  bool editor_token_has_version_comment; /* / *! ... * / has tokenizer state so we can't restart */
+  QString editor_token_text;
+  QString editor_token_delimiter_str;
+  unsigned short int editor_token_dbms_version_mask;
+  unsigned short int editor_token_hparse_dbms_mask;
+  int editor_change_position;          /* -1 if nothing changed */
+  int editor_change_removed;
+  int editor_change_added;
+  unsigned char *editor_token_highlights; /* HIGHLIGHT_... for each token, used by StatementHighlighter */
+  unsigned int editor_token_highlights_count;
+  StatementHighlighter *statement_highlighter;
+  QString statement_highlight_colors;
+  int statement_highlight_dirty_start;  /* range that needs StatementHighlighter when it's visible */
+  int statement_highlight_dirty_end;
+  QString hparse_hint;  /* "Expecting: ..." for hparse_line_edit, "" if none */
+  volatile bool hparse_is_cancelled;  /* hparse_f_nexttoken() gives up if this is on */
+  QTimer *hparse_background_timer;  /* single-shot, restarted by each edit */
+  QList<QEventLoop*> dbms_long_query_event_loops; /* one per dbms_long_query_wait() in progress, innermost last */
+  QList<volatile int*> dbms_long_query_wait_states; /* what each of them waits for */
+  pthread_t hparse_background_thread_id;
+  volatile int hparse_background_state;  /* HPARSE_BACKGROUND_IDLE|RUNNING|ENDED */
+  int hparse_background_generation;  /* so hparse_background_done() can see it's stale */
+  QString hparse_background_text;
+  unsigned int *hparse_token_hashes;  /* for each token before hparse, see hparse_f_statement_cache_start() */
+  unsigned int hparse_token_hashes_max_count;
+  QHash<unsigned int, hparse_statement_cache_entry> hparse_statement_cache;  /* key = hash of first segment */
+  QHash<unsigned int, hparse_statement_cache_entry> hparse_statement_cache_previous;
+  bool hparse_statement_cache_is_partial;  /* last hparse_f_multi_block() didn't reach the end */
+  QString hparse_statement_cache_delimiter;  /* hparse_delimiter_str when the statement started */
+
   /* main_token_flags[] values. so far there are only twelve but we expect there will be more. */
   #define TOKEN_FLAG_IS_RESERVED 1
   #define TOKEN_FLAG_IS_BLOCK_END 2
@@ -1042,7 +1244,7 @@ public:
     TOKEN_TYPE_COMMENT_WITH_MINUS= 11,        /* starts with -- */
     TOKEN_TYPE_OPERATOR= 12,                 /* starts with < > = ! etc. */
     TOKEN_TYPE_OTHER= 13,                    /* identifier? keyword? */
-    /* The TOKEN_KEYWORD_... numbers must match the list in tokens_to_keywords(). */
+    /* The TOKEN_KEYWORD_... numbers must match strvalues[] in ocelotgui.cpp, see keyword_hash_table_make(). */
     TOKEN_KEYWORDS_START= TOKEN_TYPE_OTHER + 1,
     TOKEN_KEYWORD_QUESTIONMARK= TOKEN_KEYWORDS_START, /* Ocelot keyword */
       TOKEN_KEYWORD_ABORT,
@@ -2102,6 +2304,7 @@ public:
   bool is_retrieved_flag;
   bool is_style_sheet_set_flag;
   bool is_image_flag;                    /* true if data type = blob and appropriate flag is on */
+  bool is_truncated_flag;                /* true if content is only a prefix, see lazy_blob_rewrite() */
 
 protected:
   void mousePressEvent(QMouseEvent *event);
@@ -2137,6 +2340,7 @@ public:
 protected:
   void paintEvent(QPaintEvent *event);
   void keyPressEvent(QKeyEvent *event);
+  void mouseDoubleClickEvent(QMouseEvent *event);
 
   QString unstripper(QString value_to_unstrip);
 
@@ -2608,7 +2812,7 @@ enum ocelot_option
   OCELOT_OPTION_41=41,  /* unused. in MySQL, opt_tls_version */
   OCELOT_OPTION_42=42,  /* in MySQL 5.7.11+, opt_ssl_mode */
   OCELOT_OPTION_5999=5999,  /*unused. In MariaDB, progress_callback */
-  OCELOT_OPTION_6000=6000,  /* unused. In MariaDB, nonblock */
+  OCELOT_OPTION_6000=6000,  /* In MariaDB, nonblock. see options_and_connect() */
   OCELOT_OPTION_6001=6001  /* unused. in MariaDB, thread_specific_memory */
 };
 
@@ -2655,15 +2859,33 @@ public:
                                                   const char *,
                                                   unsigned long);
   typedef int             (*tmysql_real_query)   (MYSQL *, const char *, unsigned long);
+  typedef int             (*tmysql_real_query_start)(int *, MYSQL *, const char *, unsigned long);
+  typedef int             (*tmysql_real_query_cont)(int *, MYSQL *, int);
   typedef int             (*tmysql_select_db)    (MYSQL *, const char *);
+  typedef int             (*tmysql_set_server_option)(MYSQL *, enum enum_mysql_set_option);
   typedef char*           (*tmysql_sqlstate)     (MYSQL *);
+  typedef my_bool         (*tmysql_stmt_bind_param)(MYSQL_STMT *, MYSQL_BIND *);
+  typedef my_bool         (*tmysql_stmt_close)   (MYSQL_STMT *);
+  typedef unsigned int    (*tmysql_stmt_errno)   (MYSQL_STMT *);
+  typedef int             (*tmysql_stmt_execute) (MYSQL_STMT *);
+  typedef unsigned int    (*tmysql_stmt_field_count)(MYSQL_STMT *);
+  typedef MYSQL_STMT*     (*tmysql_stmt_init)    (MYSQL *);
+  typedef unsigned long   (*tmysql_stmt_param_count)(MYSQL_STMT *);
+  typedef int             (*tmysql_stmt_prepare) (MYSQL_STMT *, const char *, unsigned long);
   typedef bool            (*tmysql_ssl_set)      (MYSQL *, const char *,
                                                   const char *,
                                                   const char *,
                                                   const char *,
                                                   const char *);
   typedef MYSQL_RES*      (*tmysql_store_result) (MYSQL *);
+  typedef int             (*tmysql_store_result_start)(MYSQL_RES **, MYSQL *);
+  typedef int             (*tmysql_store_result_cont)(MYSQL_RES **, MYSQL *, int);
+  typedef int             (*tmysql_next_result_start)(int *, MYSQL *);
+  typedef int             (*tmysql_next_result_cont)(int *, MYSQL *, int);
+  typedef my_socket       (*tmysql_get_socket)   (const MYSQL *);
+  typedef unsigned int    (*tmysql_get_timeout_value_ms)(const MYSQL *);
   typedef void            (*tmysql_thread_end)   (void);
+  typedef MYSQL_RES*      (*tmysql_use_result)   (MYSQL *);
   typedef unsigned int    (*tmysql_warning_count)(MYSQL *);
   typedef int             (*tAES_set_decrypt_key)(unsigned char *, int, AES_KEY *);
   typedef void            (*tAES_decrypt)        (unsigned char *, unsigned char *, AES_KEY *);
@@ -2744,11 +2966,29 @@ public:
   tmysql_query t__mysql_query;
   tmysql_real_connect t__mysql_real_connect;
   tmysql_real_query t__mysql_real_query;
+  tmysql_real_query_start t__mysql_real_query_start;
+  tmysql_real_query_cont t__mysql_real_query_cont;
   tmysql_select_db t__mysql_select_db;
+  tmysql_set_server_option t__mysql_set_server_option;
   tmysql_sqlstate t__mysql_sqlstate;
+  tmysql_stmt_bind_param t__mysql_stmt_bind_param;
+  tmysql_stmt_close t__mysql_stmt_close;
+  tmysql_stmt_errno t__mysql_stmt_errno;
+  tmysql_stmt_execute t__mysql_stmt_execute;
+  tmysql_stmt_field_count t__mysql_stmt_field_count;
+  tmysql_stmt_init t__mysql_stmt_init;
+  tmysql_stmt_param_count t__mysql_stmt_param_count;
+  tmysql_stmt_prepare t__mysql_stmt_prepare;
   tmysql_ssl_set t__mysql_ssl_set;
   tmysql_store_result t__mysql_store_result;
+  tmysql_store_result_start t__mysql_store_result_start;
+  tmysql_store_result_cont t__mysql_store_result_cont;
+  tmysql_next_result_start t__mysql_next_result_start;
+  tmysql_next_result_cont t__mysql_next_result_cont;
+  tmysql_get_socket t__mysql_get_socket;
+  tmysql_get_timeout_value_ms t__mysql_get_timeout_value_ms;
   tmysql_thread_end t__mysql_thread_end;
+  tmysql_use_result t__mysql_use_result;
   tmysql_warning_count t__mysql_warning_count;
   tAES_set_decrypt_key t__AES_set_decrypt_key;
   tAES_decrypt t__AES_decrypt;
@@ -3016,11 +3256,31 @@ void ldbms_get_library(QString ocelot_ld_run_path,
         t__mysql_real_connect= (tmysql_real_connect) dlsym(dlopen_handle, "mysql_real_connect"); if (dlerror() != 0) s.append("mysql_real_connect ");
         t__mysql_real_query= (tmysql_real_query) dlsym(dlopen_handle, "mysql_real_query"); if (dlerror() != 0) s.append("mysql_real_query ");
         t__mysql_select_db= (tmysql_select_db) dlsym(dlopen_handle, "mysql_select_db"); if (dlerror() != 0) s.append("mysql_select_db ");
+        t__mysql_set_server_option= (tmysql_set_server_option) dlsym(dlopen_handle, "mysql_set_server_option"); if (dlerror() != 0) t__mysql_set_server_option= NULL;
         t__mysql_sqlstate= (tmysql_sqlstate) dlsym(dlopen_handle, "mysql_sqlstate"); if (dlerror() != 0) s.append("mysql_sqlstate ");
         t__mysql_ssl_set= (tmysql_ssl_set) dlsym(dlopen_handle, "mysql_ssl_set"); if (dlerror() != 0) t__mysql_ssl_set= NULL;
         t__mysql_store_result= (tmysql_store_result) dlsym(dlopen_handle, "mysql_store_result"); if (dlerror() != 0) s.append("mysql_store_result ");
         t__mysql_thread_end= (tmysql_thread_end) dlsym(dlopen_handle, "mysql_thread_end"); if (dlerror() != 0) s.append("mysql_thread_end ");
+        t__mysql_use_result= (tmysql_use_result) dlsym(dlopen_handle, "mysql_use_result"); if (dlerror() != 0) s.append("mysql_use_result ");
         t__mysql_warning_count= (tmysql_warning_count) dlsym(dlopen_handle, "mysql_warning_count"); if (dlerror() != 0) s.append("mysql_warning_count ");
+        /* The non-blocking API is only in MariaDB's library. Not an error if it's missing. */
+        t__mysql_real_query_start= (tmysql_real_query_start) dlsym(dlopen_handle, "mysql_real_query_start"); if (dlerror() != 0) t__mysql_real_query_start= NULL;
+        t__mysql_real_query_cont= (tmysql_real_query_cont) dlsym(dlopen_handle, "mysql_real_query_cont"); if (dlerror() != 0) t__mysql_real_query_cont= NULL;
+        t__mysql_store_result_start= (tmysql_store_result_start) dlsym(dlopen_handle, "mysql_store_result_start"); if (dlerror() != 0) t__mysql_store_result_start= NULL;
+        t__mysql_store_result_cont= (tmysql_store_result_cont) dlsym(dlopen_handle, "mysql_store_result_cont"); if (dlerror() != 0) t__mysql_store_result_cont= NULL;
+        t__mysql_next_result_start= (tmysql_next_result_start) dlsym(dlopen_handle, "mysql_next_result_start"); if (dlerror() != 0) t__mysql_next_result_start= NULL;
+        t__mysql_next_result_cont= (tmysql_next_result_cont) dlsym(dlopen_handle, "mysql_next_result_cont"); if (dlerror() != 0) t__mysql_next_result_cont= NULL;
+        t__mysql_get_socket= (tmysql_get_socket) dlsym(dlopen_handle, "mysql_get_socket"); if (dlerror() != 0) t__mysql_get_socket= NULL;
+        t__mysql_get_timeout_value_ms= (tmysql_get_timeout_value_ms) dlsym(dlopen_handle, "mysql_get_timeout_value_ms"); if (dlerror() != 0) t__mysql_get_timeout_value_ms= NULL;
+        /* The prepared-statement API is only for ocelot_prepared_statement_cache. Not an error if it's missing. */
+        t__mysql_stmt_bind_param= (tmysql_stmt_bind_param) dlsym(dlopen_handle, "mysql_stmt_bind_param"); if (dlerror() != 0) t__mysql_stmt_bind_param= NULL;
+        t__mysql_stmt_close= (tmysql_stmt_close) dlsym(dlopen_handle, "mysql_stmt_close"); if (dlerror() != 0) t__mysql_stmt_close= NULL;
+        t__mysql_stmt_errno= (tmysql_stmt_errno) dlsym(dlopen_handle, "mysql_stmt_errno"); if (dlerror() != 0) t__mysql_stmt_errno= NULL;
+        t__mysql_stmt_execute= (tmysql_stmt_execute) dlsym(dlopen_handle, "mysql_stmt_execute"); if (dlerror() != 0) t__mysql_stmt_execute= NULL;
+        t__mysql_stmt_field_count= (tmysql_stmt_field_count) dlsym(dlopen_handle, "mysql_stmt_field_count"); if (dlerror() != 0) t__mysql_stmt_field_count= NULL;
+        t__mysql_stmt_init= (tmysql_stmt_init) dlsym(dlopen_handle, "mysql_stmt_init"); if (dlerror() != 0) t__mysql_stmt_init= NULL;
+        t__mysql_stmt_param_count= (tmysql_stmt_param_count) dlsym(dlopen_handle, "mysql_stmt_param_count"); if (dlerror() != 0) t__mysql_stmt_param_count= NULL;
+        t__mysql_stmt_prepare= (tmysql_stmt_prepare) dlsym(dlopen_handle, "mysql_stmt_prepare"); if (dlerror() != 0) t__mysql_stmt_prepare= NULL;
       }
       if (which_library == WHICH_LIBRARY_LIBCRYPTO)
       {
@@ -3124,11 +3384,31 @@ void ldbms_get_library(QString ocelot_ld_run_path,
         if ((t__mysql_real_connect= (tmysql_real_connect) lib.resolve("mysql_real_connect")) == 0) s.append("mysql_real_connect ");
         if ((t__mysql_real_query= (tmysql_real_query) lib.resolve("mysql_real_query")) == 0) s.append("mysql_real_query ");
         if ((t__mysql_select_db= (tmysql_select_db) lib.resolve("mysql_select_db")) == 0) s.append("mysql_select_db ");
+        if ((t__mysql_set_server_option= (tmysql_set_server_option) lib.resolve("mysql_set_server_option")) == 0) t__mysql_set_server_option= NULL;
         if ((t__mysql_sqlstate= (tmysql_sqlstate) lib.resolve("mysql_sqlstate")) == 0) s.append("mysql_sqlstate ");
         if ((t__mysql_ssl_set= (tmysql_ssl_set) lib.resolve("mysql_ssl_set")) == 0) t__mysql_ssl_set= NULL;
         if ((t__mysql_store_result= (tmysql_store_result) lib.resolve("mysql_store_result")) == 0) s.append("mysql_store_result ");
         if ((t__mysql_thread_end= (tmysql_thread_end) lib.resolve("mysql_thread_end")) == 0) s.append("mysql_thread_end ");
+        if ((t__mysql_use_result= (tmysql_use_result) lib.resolve("mysql_use_result")) == 0) s.append("mysql_use_result ");
         if ((t__mysql_warning_count= (tmysql_warning_count) lib.resolve("mysql_warning_count")) == 0) s.append("mysql_warning_count ");
+        /* The non-blocking API is only in MariaDB's library. Not an error if it's missing. */
+        t__mysql_real_query_start= (tmysql_real_query_start) lib.resolve("mysql_real_query_start");
+        t__mysql_real_query_cont= (tmysql_real_query_cont) lib.resolve("mysql_real_query_cont");
+        t__mysql_store_result_start= (tmysql_store_result_start) lib.resolve("mysql_store_result_start");
+        t__mysql_store_result_cont= (tmysql_store_result_cont) lib.resolve("mysql_store_result_cont");
+        t__mysql_next_result_start= (tmysql_next_result_start) lib.resolve("mysql_next_result_start");
+        t__mysql_next_result_cont= (tmysql_next_result_cont) lib.resolve("mysql_next_result_cont");
+        t__mysql_get_socket= (tmysql_get_socket) lib.resolve("mysql_get_socket");
+        t__mysql_get_timeout_value_ms= (tmysql_get_timeout_value_ms) lib.resolve("mysql_get_timeout_value_ms");
+        /* The prepared-statement API is only for ocelot_prepared_statement_cache. Not an error if it's missing. */
+        t__mysql_stmt_bind_param= (tmysql_stmt_bind_param) lib.resolve("mysql_stmt_bind_param");
+        t__mysql_stmt_close= (tmysql_stmt_close) lib.resolve("mysql_stmt_close");
+        t__mysql_stmt_errno= (tmysql_stmt_errno) lib.resolve("mysql_stmt_errno");
+        t__mysql_stmt_execute= (tmysql_stmt_execute) lib.resolve("mysql_stmt_execute");
+        t__mysql_stmt_field_count= (tmysql_stmt_field_count) lib.resolve("mysql_stmt_field_count");
+        t__mysql_stmt_init= (tmysql_stmt_init) lib.resolve("mysql_stmt_init");
+        t__mysql_stmt_param_count= (tmysql_stmt_param_count) lib.resolve("mysql_stmt_param_count");
+        t__mysql_stmt_prepare= (tmysql_stmt_prepare) lib.resolve("mysql_stmt_prepare");
       }
       if (which_library == WHICH_LIBRARY_LIBCRYPTO)
       {
@@ -3275,11 +3555,124 @@ void ldbms_get_library(QString ocelot_ld_run_path,
     return t__mysql_real_query(mysql, stmt_str, length);
   }
 
+  /*
+    MariaDB non-blocking API. Callers must check ldbms_mysql_is_nonblocking_available() first.
+    Each _start or _cont returns 0 when done, else a mask of MYSQL_WAIT_* bits saying
+    what the socket must be waited for before the next _cont.
+  */
+  bool ldbms_mysql_is_nonblocking_available()
+  {
+    return ((t__mysql_real_query_start != NULL) && (t__mysql_real_query_cont != NULL)
+         && (t__mysql_store_result_start != NULL) && (t__mysql_store_result_cont != NULL)
+         && (t__mysql_next_result_start != NULL) && (t__mysql_next_result_cont != NULL)
+         && (t__mysql_get_socket != NULL) && (t__mysql_get_timeout_value_ms != NULL));
+  }
+
+  int ldbms_mysql_real_query_start(int *ret, MYSQL *mysql, const char *stmt_str, unsigned long length)
+  {
+    return t__mysql_real_query_start(ret, mysql, stmt_str, length);
+  }
+
+  int ldbms_mysql_real_query_cont(int *ret, MYSQL *mysql, int status)
+  {
+    return t__mysql_real_query_cont(ret, mysql, status);
+  }
+
+  int ldbms_mysql_store_result_start(MYSQL_RES **ret, MYSQL *mysql)
+  {
+    return t__mysql_store_result_start(ret, mysql);
+  }
+
+  int ldbms_mysql_store_result_cont(MYSQL_RES **ret, MYSQL *mysql, int status)
+  {
+    return t__mysql_store_result_cont(ret, mysql, status);
+  }
+
+  int ldbms_mysql_next_result_start(int *ret, MYSQL *mysql)
+  {
+    return t__mysql_next_result_start(ret, mysql);
+  }
+
+  int ldbms_mysql_next_result_cont(int *ret, MYSQL *mysql, int status)
+  {
+    return t__mysql_next_result_cont(ret, mysql, status);
+  }
+
+  my_socket ldbms_mysql_get_socket(MYSQL *mysql)
+  {
+    return t__mysql_get_socket(mysql);
+  }
+
+  unsigned int ldbms_mysql_get_timeout_value_ms(MYSQL *mysql)
+  {
+    return t__mysql_get_timeout_value_ms(mysql);
+  }
+
+  /*
+    Prepared statements. Callers must check ldbms_mysql_is_stmt_available() first.
+    ldbms_mysql_stmt_prepare() and ldbms_mysql_stmt_execute() are not usually
+    called from the main thread, see dbms_executor_thread().
+  */
+  bool ldbms_mysql_is_stmt_available()
+  {
+    return ((t__mysql_stmt_bind_param != NULL) && (t__mysql_stmt_close != NULL)
+         && (t__mysql_stmt_errno != NULL) && (t__mysql_stmt_execute != NULL)
+         && (t__mysql_stmt_field_count != NULL) && (t__mysql_stmt_init != NULL)
+         && (t__mysql_stmt_param_count != NULL) && (t__mysql_stmt_prepare != NULL));
+  }
+
+  my_bool ldbms_mysql_stmt_bind_param(MYSQL_STMT *stmt, MYSQL_BIND *bind)
+  {
+    return t__mysql_stmt_bind_param(stmt, bind);
+  }
+
+  my_bool ldbms_mysql_stmt_close(MYSQL_STMT *stmt)
+  {
+    return t__mysql_stmt_close(stmt);
+  }
+
+  unsigned int ldbms_mysql_stmt_errno(MYSQL_STMT *stmt)
+  {
+    return t__mysql_stmt_errno(stmt);
+  }
+
+  int ldbms_mysql_stmt_execute(MYSQL_STMT *stmt)
+  {
+    return t__mysql_stmt_execute(stmt);
+  }
+
+  unsigned int ldbms_mysql_stmt_field_count(MYSQL_STMT *stmt)
+  {
+    return t__mysql_stmt_field_count(stmt);
+  }
+
+  MYSQL_STMT *ldbms_mysql_stmt_init(MYSQL *mysql)
+  {
+    return t__mysql_stmt_init(mysql);
+  }
+
+  unsigned long ldbms_mysql_stmt_param_count(MYSQL_STMT *stmt)
+  {
+    return t__mysql_stmt_param_count(stmt);
+  }
+
+  int ldbms_mysql_stmt_prepare(MYSQL_STMT *stmt, const char *stmt_str, unsigned long length)
+  {
+    return t__mysql_stmt_prepare(stmt, stmt_str, length);
+  }
+
   int ldbms_mysql_select_db(MYSQL *mysql, const char *db)
   {
     return t__mysql_select_db(mysql, db);
   }
 
+  /* If dlopen() failed for "mysql_set_server_option" the option can't be set, which is not an error. */
+  int ldbms_mysql_set_server_option(MYSQL *mysql, enum enum_mysql_set_option option)
+  {
+    if (t__mysql_set_server_option == NULL) return 1;
+    return t__mysql_set_server_option(mysql, option);
+  }
+
   const char *ldbms_mysql_sqlstate(MYSQL *mysql)
   {
     return t__mysql_sqlstate(mysql);
@@ -3301,6 +3694,11 @@ void ldbms_get_library(QString ocelot_ld_run_path,
     t__mysql_thread_end();
   }
 
+  MYSQL_RES *ldbms_mysql_use_result(MYSQL *mysql)
+  {
+    return t__mysql_use_result(mysql);
+  }
+
   unsigned int ldbms_mysql_warning_count(MYSQL *mysql)
   {
     return t__mysql_warning_count(mysql);
@@ -3713,6 +4111,9 @@ public:
   QFont text_edit_widget_font;
   ldbms *lmysql;
   unsigned int scroll_bar_width;
+  QString lazy_blob_table;                                     /* set by MainWindow if lazy_blob_rewrite() changed the select */
+  QStringList lazy_blob_column_names;                          /* columns which lazy_blob_rewrite() changed to LEFT(...) */
+  unsigned int lazy_blob_length;                               /* = ocelot_grid_lazy_blob_length at time of select */
 
 /* How many rows can fit on the screen? Take a guess for initialization. */
 #define RESULT_GRID_WIDGET_INITIAL_HEIGHT 10
@@ -3726,6 +4127,7 @@ public:
 #define FIELD_VALUE_FLAG_IS_NUMBER 2
 #define FIELD_VALUE_FLAG_IS_STRING 4
 #define FIELD_VALUE_FLAG_IS_OTHER 8
+#define FIELD_VALUE_FLAG_IS_TRUNCATED 16
 
 ResultGrid(
 //        MYSQL_RES *mysql_res,
@@ -3759,6 +4161,7 @@ ResultGrid(
   result_original_table_names= 0;
   result_original_database_names= 0;
   gridx_field_names= 0;
+  lazy_blob_length= 0;
 
   gridx_max_column_widths= 0;
   gridx_result_indexes= 0;
@@ -4067,10 +4470,14 @@ void fillup(MYSQL_RES *mysql_res,
               &result_max_column_widths);
   else
 #endif
+  {
+    statement_timing_mark(STATEMENT_TIMING_LAYOUT);
     scan_rows(result_column_count, result_row_count,
               grid_mysql_res,
               &result_set_copy, &result_set_copy_rows,
               &result_max_column_widths);
+    statement_timing_mark(STATEMENT_TIMING_SCAN);
+  }
 #ifdef DBMS_TARANTOOL
   if (connections_dbms == DBMS_TARANTOOL)
   {
@@ -4149,6 +4556,127 @@ void fillup(MYSQL_RES *mysql_res,
 
   /* todo: gotta use MYSQL_REMOTE_CONNECTION rather than 3 someday. */
   if (connection_number == 3) return;
+  fillup_layout(connections_dbms,
+                ocelot_result_grid_vertical, ocelot_result_grid_column_names,
+                ocelot_batch, ocelot_html, ocelot_raw, ocelot_xml);
+}
+
+/*
+  Like fillup(), but for a result set that the client made, e.g. $BENCH's
+  report, so there's no MYSQL_RES. Values are UTF-8, a null QByteArray
+  is NULL. Every column is a VARCHAR and no column comes from a table,
+  so the grid can be looked at but not edited.
+*/
+void fillup_client(QList<QByteArray> column_names,
+                   QList< QList<QByteArray> > rows,
+                   int connections_dbms,
+                   unsigned short ocelot_result_grid_vertical,
+                   unsigned short ocelot_result_grid_column_names,
+                   ldbms *passed_lmysql,
+                   int ocelot_client_side_functions,
+                   unsigned short int ocelot_batch,
+                   unsigned short int ocelot_html,
+                   unsigned short int ocelot_raw,
+                   unsigned short int ocelot_xml)
+{
+  lmysql= passed_lmysql;
+
+  ocelot_result_grid_vertical_copy= ocelot_result_grid_vertical;
+  ocelot_result_grid_column_names_copy= ocelot_result_grid_column_names;
+  ocelot_client_side_functions_copy= ocelot_client_side_functions;
+
+  grid_mysql_res= 0;
+  mysql_fields= 0;
+  result_column_count= column_names.size();
+  result_row_count= rows.size();
+  result_max_column_widths= new unsigned int[result_column_count];
+  result_field_types= new unsigned short int[result_column_count];
+  result_field_charsetnrs= new unsigned int[result_column_count];
+  result_field_flags= new unsigned int[result_column_count];
+  for (unsigned int i= 0; i < result_column_count; ++i)
+  {
+    result_max_column_widths[i]= 0;
+    result_field_types[i]= OCELOT_DATA_TYPE_VAR_STRING;
+    result_field_charsetnrs[i]= 83; /* utf8, utf8_bin */
+    result_field_flags[i]= 0;
+  }
+
+  /* The same layout as scan_rows() makes: for each column (unsigned int) length, (char) flag, contents. */
+  unsigned int total_size= 0;
+  for (long unsigned int r= 0; r < result_row_count; ++r)
+  {
+    for (unsigned int i= 0; i < result_column_count; ++i)
+    {
+      total_size+= sizeof(unsigned int) + sizeof(char);
+      if (i < (unsigned int) rows[r].size()) total_size+= rows[r][i].size();
+    }
+  }
+  result_set_copy= new char[total_size];
+  result_set_copy_rows= new char*[result_row_count];
+  char *result_set_copy_pointer= result_set_copy;
+  for (long unsigned int r= 0; r < result_row_count; ++r)
+  {
+    result_set_copy_rows[r]= result_set_copy_pointer;
+    for (unsigned int i= 0; i < result_column_count; ++i)
+    {
+      QByteArray value;
+      if (i < (unsigned int) rows[r].size()) value= rows[r][i];
+      unsigned int v_length= value.size();
+      memcpy(result_set_copy_pointer, &v_length, sizeof(unsigned int));
+      if (value.isNull())
+      {
+        if (sizeof(NULL_STRING) - 1 > result_max_column_widths[i]) result_max_column_widths[i]= sizeof(NULL_STRING) - 1;
+        *(result_set_copy_pointer + sizeof(unsigned int))= FIELD_VALUE_FLAG_IS_NULL;
+      }
+      else
+      {
+        set_max_column_width(v_length, value.constData(), &result_max_column_widths[i]);
+        *(result_set_copy_pointer + sizeof(unsigned int))= FIELD_VALUE_FLAG_IS_ZERO;
+      }
+      result_set_copy_pointer+= sizeof(unsigned int) + sizeof(char);
+      memcpy(result_set_copy_pointer, value.constData(), v_length);
+      result_set_copy_pointer+= v_length;
+    }
+  }
+
+  QList<QByteArray> no_names;
+  for (unsigned int i= 0; i < result_column_count; ++i) no_names.append(QByteArray(""));
+  client_field_names(column_names, &result_field_names);
+  client_field_names(no_names, &result_original_field_names);
+  client_field_names(no_names, &result_original_table_names);
+  client_field_names(no_names, &result_original_database_names);
+
+  fillup_layout(connections_dbms,
+                ocelot_result_grid_vertical, ocelot_result_grid_column_names,
+                ocelot_batch, ocelot_html, ocelot_raw, ocelot_xml);
+}
+
+/* The same layout as scan_field_names() makes: for each column (unsigned int) length, contents. */
+void client_field_names(QList<QByteArray> names, char **p_result_field_names)
+{
+  unsigned int total_size= 0;
+  for (int i= 0; i < names.size(); ++i) total_size+= sizeof(unsigned int) + names[i].size();
+  *p_result_field_names= new char[total_size];
+  char *result_field_names_pointer= *p_result_field_names;
+  for (int i= 0; i < names.size(); ++i)
+  {
+    unsigned int v_lengths= names[i].size();
+    memcpy(result_field_names_pointer, &v_lengths, sizeof(unsigned int));
+    result_field_names_pointer+= sizeof(unsigned int);
+    memcpy(result_field_names_pointer, names[i].constData(), v_lengths);
+    result_field_names_pointer+= v_lengths;
+  }
+}
+
+/* The end of fillup() or fillup_client(), when result_set_copy etc. are ready. */
+void fillup_layout(int connections_dbms,
+                   unsigned short ocelot_result_grid_vertical,
+                   unsigned short ocelot_result_grid_column_names,
+                   unsigned short int ocelot_batch,
+                   unsigned short int ocelot_html,
+                   unsigned short int ocelot_raw,
+                   unsigned short int ocelot_xml)
+{
   copy_result_to_gridx(connections_dbms);
   /* Todo: no more grid_result_row_count, and copy_result_to_gridx already
      said what gridx_row_count is. */
@@ -5250,263 +5778,105 @@ bool is_image(int col)
 /*
   Move a limited part of a result set to history.
   We want to show what it looks like, but dumping the whole thing might waste time and space,
-  so it's throttled by an ocelot_history variable that can be set to a small values:
-  ocelot_history_max_row_count, default "0".
+  so it's throttled by ocelot_history variables that can be set to small values:
+  ocelot_history_max_row_count, default "0", and max_bytes = ocelot_history_max_result_bytes.
   This is called after preparing a result set in fillup(), and
   depends on fillup() results including max_column widths.
-  Example output:
-  +------+------+------------+
-  | s1   | s2   | The Rain I |
-  +------+------+------------+
-  |    1 | A    |          0 |
-  | NULL | NULL |          0 |
-  +------+------+------------+
-  The output is the same as what mysql client would display --
-    left margin = 1, right margin = 1, left justify if number,
-    content length = maximum actual length -- except that mysql
-    client has minimum content length = 4 if column is nullable,
-    and we don't bother with that, it looks like a flaw.
+  We don't format here. We copy rows into a compact snapshot, which
+  MainWindow keeps in a ring with a byte budget (history_result_add()), and
+  MainWindow::history_result_render() only makes text if the user scrolls
+  to it. Values are cut to the width that would be displayed, so one BLOB
+  can't use up the budget. The snapshot stops at the last row that fits.
+  Snapshot layout, all in one QByteArray:
+    [unsigned int column_count][unsigned int row_count][char is_vertical][char is_column_names]
+    per column: [unsigned int width][char is_number][unsigned int name_length][name]
+    per row per column: [unsigned int length][char flag][bytes]
   Defined limits on column width and on number of columns are arbitrary.
   If changing this, remember to test ^P and ^N which depend on markup.
-  Todo: this could be adapted for an alternate way to display the result grid.
-  Warning: making the copy bigger would slow down the way the Previous and Next keys work.
   Remaining challenges with copy_to_history:
   * Names and max widths should depend on result_row stuff not gridx_max stuff
-  * We should try to keep track of statements so we don't spend too much time going backwards.
   * The "8192" for vertical output is arbitrary. Max should be calculated.
 */
 #define HISTORY_COLUMN_MARGIN 1
 #define HISTORY_MAX_COLUMN_WIDTH 65535
 #define HISTORY_MAX_COLUMN_COUNT 65535
 #define HISTORY_MAX_VERTICAL_COLUMN_WIDTH 8192
-QString copy_to_history(long int ocelot_history_max_row_count, unsigned short int is_vertical)
+QByteArray copy_to_history(long int ocelot_history_max_row_count, unsigned short int is_vertical, unsigned int max_bytes)
 {
-  if (ocelot_history_max_row_count == 0) return "";
+  QByteArray snapshot;
+  if (ocelot_history_max_row_count == 0) return snapshot;
   unsigned int col;
   long unsigned int r;
-  unsigned int length;
   unsigned int history_result_column_count;
+  unsigned int history_result_row_count;
+  unsigned int column_width;
+  unsigned int column_length;
+  char flag;
+  char is_number;
+  char *pointer_to_field_names= result_field_names;
   unsigned int *history_max_column_widths;
-  unsigned long history_result_row_count;
-  char *history_line;
-  char *divider_line;
-  char *pointer_to_history_line;
-  unsigned int history_line_width;
-  QString s;
 
-  s= "";
-
-
-  history_max_column_widths= 0;
-  history_line= 0;
-
-  /* TODO: See whether gridx_column_count was necessary */
-  //if (gridx_column_count > HISTORY_MAX_COLUMN_COUNT) history_result_column_count= HISTORY_MAX_COLUMN_COUNT;
-  //else history_result_column_count= gridx_column_count;
   if (result_column_count > HISTORY_MAX_COLUMN_COUNT) history_result_column_count= HISTORY_MAX_COLUMN_COUNT;
   else history_result_column_count= result_column_count;
-
-  history_max_column_widths= new unsigned int[history_result_column_count];
-  history_line_width= 2;
-  unsigned int column_width;
-
-  {
-    char *pointer_to_field_names= result_field_names;
-    unsigned int column_length;
-    for (col= 0; col < history_result_column_count; ++col)
-    {
-      if (ocelot_result_grid_column_names_copy == 1)
-      {
-        memcpy(&column_length, pointer_to_field_names, sizeof(unsigned int));
-        pointer_to_field_names+= sizeof(unsigned int);
-        pointer_to_field_names+= column_length;
-        column_width= column_length;
-      }
-      else column_width= 0;
-      if (column_width < gridx_max_column_widths[col]) column_width= gridx_max_column_widths[col];
-      if (column_width > HISTORY_MAX_COLUMN_WIDTH) column_width= HISTORY_MAX_COLUMN_WIDTH;
-      history_max_column_widths[col]= column_width;
-      history_line_width+= column_width + 1 + HISTORY_COLUMN_MARGIN * 2;
-    }
-  }
-
   if (result_row_count > (unsigned long) ocelot_history_max_row_count) history_result_row_count= ocelot_history_max_row_count;
   else history_result_row_count= result_row_count;
 
-  if (is_vertical == 1)
+  snapshot.append((const char*) &history_result_column_count, sizeof(unsigned int));
+  snapshot.append((const char*) &history_result_row_count, sizeof(unsigned int)); /* changed later if budget is hit */
+  snapshot.append((char) is_vertical);
+  snapshot.append((char) ocelot_result_grid_column_names_copy);
+  history_max_column_widths= new unsigned int[history_result_column_count];
+  for (col= 0; col < history_result_column_count; ++col)
   {
-    unsigned int longest_column_name_length= 0;
-    unsigned int column_length;
-    if (ocelot_result_grid_column_names_copy == 1)
-    {
-      char *pointer_to_field_names= result_field_names;
-      for (col= 0; col < history_result_column_count; ++col)
-      {
-        memcpy(&column_length, pointer_to_field_names, sizeof(unsigned int));
-        if (column_length > longest_column_name_length)
-          longest_column_name_length= column_length;
-        pointer_to_field_names+= sizeof(unsigned int);
-        pointer_to_field_names+= column_length;
-      }
-    }
-
-    history_line= new char[HISTORY_MAX_VERTICAL_COLUMN_WIDTH + 256];
-    for (r= 0; r < history_result_row_count; ++r)
-    {
-      sprintf(history_line, "*************************** %ld. row ***************************\n", r + 1);
-      s.append(history_line);
-      char *row_pointer;
-      unsigned int column_length;
-      char flag;
-      char *pointer_to_source;
-      row_pointer= result_set_copy_rows[r];
-      char *pointer_to_field_names= result_field_names;
-      for (col= 0; col < history_result_column_count; ++col)
-      {
-        pointer_to_history_line= history_line;
-        memcpy(&column_length, pointer_to_field_names, sizeof(unsigned int));
-        pointer_to_field_names+= sizeof(unsigned int);
-        memset(pointer_to_history_line, ' ', longest_column_name_length - column_length);
-        pointer_to_history_line+= longest_column_name_length - column_length;
-        memcpy(pointer_to_history_line, pointer_to_field_names, column_length);
-        pointer_to_field_names+= column_length;
-        pointer_to_history_line+= column_length;
-        *(pointer_to_history_line++)= ':';
-        *(pointer_to_history_line++)= ' ';
-        memcpy(&column_length, row_pointer, sizeof(unsigned int));
-        flag= *(row_pointer + sizeof(unsigned int));
-        row_pointer+= sizeof(unsigned int) + sizeof(char);
-        if ((flag & FIELD_VALUE_FLAG_IS_NULL) != 0)
-        {
-          length= strlen(NULL_STRING);
-          pointer_to_source= (char *) NULL_STRING;
-        }
-        else
-        {
-          length= column_length;
-          pointer_to_source= row_pointer;
-        }
-        if (length > HISTORY_MAX_VERTICAL_COLUMN_WIDTH) length= HISTORY_MAX_VERTICAL_COLUMN_WIDTH;
-        memcpy(pointer_to_history_line, pointer_to_source, length);
-        row_pointer+= column_length;
-        pointer_to_history_line+= length;
-        *(pointer_to_history_line)= '\n'; *(pointer_to_history_line + 1)= '\0';
-        s.append(history_line);
-      }
-    }
-    return s;
+    memcpy(&column_length, pointer_to_field_names, sizeof(unsigned int));
+    pointer_to_field_names+= sizeof(unsigned int);
+    if (ocelot_result_grid_column_names_copy == 1) column_width= column_length;
+    else column_width= 0;
+    if (column_width < gridx_max_column_widths[col]) column_width= gridx_max_column_widths[col];
+    if (column_width > HISTORY_MAX_COLUMN_WIDTH) column_width= HISTORY_MAX_COLUMN_WIDTH;
+    history_max_column_widths[col]= column_width;
+    is_number= ((result_field_flags[col] & NUM_FLAG) != 0);
+    snapshot.append((const char*) &column_width, sizeof(unsigned int));
+    snapshot.append(is_number);
+    snapshot.append((const char*) &column_length, sizeof(unsigned int));
+    snapshot.append(pointer_to_field_names, column_length);
+    pointer_to_field_names+= column_length;
   }
-
-  history_line= new char[history_line_width + 2];
-
-  divider_line= new char[history_line_width + 2];
-
-
-
+  if ((unsigned int) snapshot.size() > max_bytes)
   {
-    char *pointer_to_divider_line;
-    pointer_to_divider_line= divider_line;
-    *(pointer_to_divider_line++)= '+';
-    for (col= 0; col < history_result_column_count; ++col)
-    {
-      memset(pointer_to_divider_line, '-',
-             history_max_column_widths[col] + HISTORY_COLUMN_MARGIN * 2);
-      pointer_to_divider_line+=
-             history_max_column_widths[col] + HISTORY_COLUMN_MARGIN * 2;
-      *(pointer_to_divider_line++)= '+';
-    }
-    *(pointer_to_divider_line)= '\n'; *(pointer_to_divider_line + 1)= '\0';
+    delete [] history_max_column_widths;
+    return QByteArray();
   }
 
-  if (ocelot_result_grid_column_names_copy == 1)
-  {
-    char *pointer_to_field_names= result_field_names;
-    unsigned int column_length;
-    s.append(divider_line);
-    pointer_to_history_line= history_line;
-    *(pointer_to_history_line++)= '|';
-    for (col= 0; col < history_result_column_count; ++col)
-    {
-      memset(pointer_to_history_line, ' ', HISTORY_COLUMN_MARGIN);
-      pointer_to_history_line+= HISTORY_COLUMN_MARGIN;
-      memcpy(&column_length, pointer_to_field_names, sizeof(unsigned int));
-      pointer_to_field_names+= sizeof(unsigned int);
-      length= column_length;
-      if (length > history_max_column_widths[col]) length= history_max_column_widths[col];
-      memcpy(pointer_to_history_line, pointer_to_field_names, length);
-      pointer_to_field_names+= column_length;
-      pointer_to_history_line+= length;
-      if (length < history_max_column_widths[col])
-      {
-        length= history_max_column_widths[col] - length;
-        memset(pointer_to_history_line, ' ', length);
-        pointer_to_history_line+= length;
-      }
-      memset(pointer_to_history_line, ' ', HISTORY_COLUMN_MARGIN);
-      pointer_to_history_line+= HISTORY_COLUMN_MARGIN;
-      *(pointer_to_history_line++)= '|';
-    }
-    *(pointer_to_history_line)= '\n'; *(pointer_to_history_line + 1)= '\0';
-    s.append(history_line);
-  }
-  pointer_to_history_line= history_line;
-  s.append(divider_line);
   for (r= 0; r < history_result_row_count; ++r)
   {
-    char *row_pointer;
-    unsigned int column_length;
-    char flag;
-    char *pointer_to_source;
-    unsigned int spaces_before, spaces_after;
-    pointer_to_history_line= history_line;
-    row_pointer= result_set_copy_rows[r];
-    *(pointer_to_history_line++)= '|';
+    int size_before_row= snapshot.size();
+    char *row_pointer= result_set_copy_rows[r];
     for (col= 0; col < history_result_column_count; ++col)
     {
+      column_width= history_max_column_widths[col];
       memcpy(&column_length, row_pointer, sizeof(unsigned int));
       flag= *(row_pointer + sizeof(unsigned int));
       row_pointer+= sizeof(unsigned int) + sizeof(char);
-      if ((flag & FIELD_VALUE_FLAG_IS_NULL) != 0)
-      {
-        length= strlen(NULL_STRING);
-        pointer_to_source= (char *) NULL_STRING;
-      }
-      else
-      {
-        length= column_length;
-        pointer_to_source= row_pointer;
-      }
-      spaces_before= spaces_after= HISTORY_COLUMN_MARGIN;
-      if (length > history_max_column_widths[col]) length= history_max_column_widths[col];
-      else
-      {
-        /* Todo: for Tarantool, check (flag & FIELD_VALUE_FLAG_IS_NUMBER) */
-        if ((result_field_flags[col] & NUM_FLAG) != 0)
-        //if (result_field_types[col] <= MYSQL_TYPE_DOUBLE)
-        {
-          spaces_before+= history_max_column_widths[col] - length;
-        }
-        else
-        {
-          spaces_after+= history_max_column_widths[col] - length;
-        }
-      }
-      memset(pointer_to_history_line, ' ', spaces_before);
-      pointer_to_history_line+= spaces_before;
-      memcpy(pointer_to_history_line, pointer_to_source, length);
-      pointer_to_history_line+= length;
-      memset(pointer_to_history_line, ' ', spaces_after);
-      pointer_to_history_line+= spaces_after;
-      *(pointer_to_history_line++)= '|';
+      unsigned int length= column_length;
+      if (is_vertical == 1) column_width= HISTORY_MAX_VERTICAL_COLUMN_WIDTH;
+      if (length > column_width) length= column_width;
+      if ((flag & FIELD_VALUE_FLAG_IS_NULL) != 0) length= 0;
+      snapshot.append((const char*) &length, sizeof(unsigned int));
+      snapshot.append(flag);
+      snapshot.append(row_pointer, length);
       row_pointer+= column_length;
     }
-    *(pointer_to_history_line)= '\n'; *(pointer_to_history_line + 1)= '\0';
-    s.append(history_line);
+    if ((unsigned int) snapshot.size() > max_bytes)
+    {
+      snapshot.truncate(size_before_row);
+      history_result_row_count= r;
+      memcpy(snapshot.data() + sizeof(unsigned int), &history_result_row_count, sizeof(unsigned int));
+      break;
+    }
   }
-  s.append(divider_line);
-  if (history_line != 0) delete [] history_line;
-  if (history_max_column_widths != 0) delete [] history_max_column_widths;
-  return s;
+  delete [] history_max_column_widths;
+  return snapshot;
 }
 
 /*
@@ -5763,6 +6133,10 @@ void grid_column_size_calc(int ocelot_grid_cell_border_size_as_int,
     Also, after the copy, we're less (or not at all?) dependent on calls to MySQL functions.
   For each column, we have: (unsigned int) length, (char) unused or null flag, (char[n]) contents.
   We want max actual length too.
+  If lazy_blob_table is set, the select was changed by lazy_blob_rewrite() and
+  some columns are LEFT(column, lazy_blob_length). A value in such a column
+  which is lazy_blob_length bytes or longer might be only a prefix, so we flag
+  it FIELD_VALUE_FLAG_IS_TRUNCATED, and lazy_blob_fetch() can get the rest later.
 */
 void scan_rows(unsigned int p_result_column_count,
                unsigned int p_result_row_count,
@@ -5776,9 +6150,20 @@ void scan_rows(unsigned int p_result_column_count,
   MYSQL_ROW v_row;
   unsigned long *v_lengths;
 //  unsigned int ki;
+  bool *is_lazy_blob_column= 0;
 
   for (i= 0; i < p_result_column_count; ++i) (*p_result_max_column_widths)[i]= 0;
 
+  if (lazy_blob_table != "")
+  {
+    is_lazy_blob_column= new bool[p_result_column_count];
+    for (i= 0; i < p_result_column_count; ++i)
+    {
+      is_lazy_blob_column[i]= lazy_blob_column_names.contains(QString::fromUtf8(mysql_fields[i].name, mysql_fields[i].name_length),
+                                                              Qt::CaseInsensitive);
+    }
+  }
+
   /*
     First loop: find how much to allocate. Allocate. Second loop: fill in with pointers within allocated area.
   */
@@ -5858,7 +6243,11 @@ void scan_rows(unsigned int p_result_column_count,
           //if (v_lengths[i] > (*p_result_max_column_widths)[i]) (*p_result_max_column_widths)[i]= v_lengths[i];
           set_max_column_width(v_lengths[i], v_row[i], (&(*p_result_max_column_widths)[i]));
           memcpy(result_set_copy_pointer, &v_lengths[i], sizeof(unsigned int));
-          *(result_set_copy_pointer + sizeof(unsigned int))= FIELD_VALUE_FLAG_IS_ZERO;
+          if ((is_lazy_blob_column != 0)
+           && (is_lazy_blob_column[i] == true)
+           && (v_lengths[i] >= lazy_blob_length))
+            *(result_set_copy_pointer + sizeof(unsigned int))= FIELD_VALUE_FLAG_IS_TRUNCATED;
+          else *(result_set_copy_pointer + sizeof(unsigned int))= FIELD_VALUE_FLAG_IS_ZERO;
           result_set_copy_pointer+= sizeof(unsigned int) + sizeof(char);
           memcpy(result_set_copy_pointer, v_row[i], v_lengths[i]);
           result_set_copy_pointer+= v_lengths[i];
@@ -5866,6 +6255,7 @@ void scan_rows(unsigned int p_result_column_count,
       }
     }
   }
+  if (is_lazy_blob_column != 0) delete [] is_lazy_blob_column;
 }
 
 
@@ -5961,6 +6351,61 @@ void scan_field_names(
 }
 
 
+/*
+  Get the full value of a cell that scan_rows() flagged FIELD_VALUE_FLAG_IS_TRUNCATED.
+  The select was SELECT * FROM lazy_blob_table, so every column of the primary key
+  is in the row, and the field names are the column names.
+  We make: SELECT `column` FROM lazy_blob_table WHERE `pk1`=_binary X'...' AND ...
+  Hex with _binary means we needn't worry about escapes or sql_mode,
+  and the server will convert for comparison with a number.
+  Return 0 if ok, else 1.
+*/
+int lazy_blob_fetch(long unsigned int result_row_number, unsigned int result_column_number, QByteArray *value)
+{
+  if (lazy_blob_table == "") return 1;
+  if (result_row_number >= result_row_count) return 1;
+  if (result_column_number >= result_column_count) return 1;
+
+  QString column_name= "";
+  QString where_clause= "";
+  char *row_pointer= result_set_copy_rows[result_row_number];
+  char *field_names_pointer= result_field_names;
+  unsigned int name_length, column_length;
+  char flag;
+  for (unsigned int col= 0; col < result_column_count; ++col)
+  {
+    memcpy(&name_length, field_names_pointer, sizeof(unsigned int));
+    field_names_pointer+= sizeof(unsigned int);
+    QString name= QString::fromUtf8(field_names_pointer, name_length);
+    field_names_pointer+= name_length;
+    name.replace("`", "``");
+    name= "`" + name + "`";
+    memcpy(&column_length, row_pointer, sizeof(unsigned int));
+    flag= *(row_pointer + sizeof(unsigned int));
+    row_pointer+= sizeof(unsigned int) + sizeof(char);
+    if (col == result_column_number) column_name= name;
+    if ((result_field_flags[col] & PRI_KEY_FLAG) != 0)
+    {
+      if ((flag & FIELD_VALUE_FLAG_IS_NULL) != 0) return 1;
+      if (where_clause == "") where_clause= " WHERE ";
+      else where_clause.append(" AND ");
+      where_clause.append(name);
+      where_clause.append("=_binary X'");
+      where_clause.append(QString(QByteArray(row_pointer, column_length).toHex()));
+      where_clause.append("'");
+    }
+    row_pointer+= column_length;
+  }
+  if (where_clause == "") return 1;
+  QString select_statement= "SELECT ";
+  select_statement.append(column_name);
+  select_statement.append(" FROM ");
+  select_statement.append(lazy_blob_table);
+  select_statement.append(where_clause);
+  return copy_of_parent->lazy_blob_select(select_statement, value);
+}
+
+
 /*
    Set alignment and height of a cell.
    Todo: There's a terrible amount of duplication:
@@ -6079,6 +6524,7 @@ void fill_detail_widgets(int new_grid_vertical_scroll_bar_value, int connections
         text_edit_frames[text_edit_frames_index]->ancestor_grid_column_number= result_column_number;
         text_edit_frames[text_edit_frames_index]->ancestor_grid_result_row_number= result_row_number;
         text_edit_frames[text_edit_frames_index]->is_image_flag= false;
+        text_edit_frames[text_edit_frames_index]->is_truncated_flag= false;
         ++text_edit_frames_index;
       }
       text_edit_frames[text_edit_frames_index]->content_length= new_content_length; /* include value. */
@@ -6087,6 +6533,7 @@ void fill_detail_widgets(int new_grid_vertical_scroll_bar_value, int connections
         text_edit_frames[text_edit_frames_index]->content_pointer= 0;
       }
       else text_edit_frames[text_edit_frames_index]->content_pointer= row_pointer;
+      text_edit_frames[text_edit_frames_index]->is_truncated_flag= ((*(row_pointer - 1) & FIELD_VALUE_FLAG_IS_TRUNCATED) != 0);
       text_edit_frames[text_edit_frames_index]->is_retrieved_flag= false;
       text_edit_frames[text_edit_frames_index]->ancestor_grid_column_number= result_column_number;
       text_edit_frames[text_edit_frames_index]->ancestor_grid_result_row_number= result_row_number;
@@ -6177,6 +6624,7 @@ void fill_detail_widgets(int new_grid_vertical_scroll_bar_value, int connections
         {
           text_edit_frames[text_edit_frames_index]->content_length= 0;
           text_edit_frames[text_edit_frames_index]->content_pointer= 0;
+          text_edit_frames[text_edit_frames_index]->is_truncated_flag= false;
         }
         else
         {
@@ -6187,6 +6635,7 @@ void fill_detail_widgets(int new_grid_vertical_scroll_bar_value, int connections
             text_edit_frames[text_edit_frames_index]->content_pointer= 0;
           }
           else text_edit_frames[text_edit_frames_index]->content_pointer= row_pointer;
+          text_edit_frames[text_edit_frames_index]->is_truncated_flag= ((*(row_pointer - 1) & FIELD_VALUE_FLAG_IS_TRUNCATED) != 0);
           row_pointer+= text_edit_frames[text_edit_frames_index]->content_length;
         }
         text_edit_frames[text_edit_frames_index]->is_retrieved_flag= false;
@@ -6424,6 +6873,8 @@ void garbage_collect()
   if (gridx_result_indexes != 0) { delete [] gridx_result_indexes; gridx_result_indexes= 0; }
   if (gridx_flags != 0) { delete [] gridx_flags; gridx_flags= 0; }
   if (gridx_field_types != 0) { delete [] gridx_field_types; gridx_field_types= 0; }
+  lazy_blob_table= "";
+  lazy_blob_column_names.clear();
   for (unsigned int i= 0; i < cell_pool_size; ++i) text_edit_widgets[i]->clear(); /* unnecessary? */
   if (batch_text_edit != NULL) batch_text_edit->clear(); /* unnecessary? */
 }
@@ -6709,11 +7160,14 @@ private:
    text= statement_edit_widget->toPlainText(); but maybe I won't care.
    Todo: Consider: QToolTip::showText() instead of setToolTip()
          (it would cause immediate change but might be distracting).
+   Not while hparse_background_thread() has main_token_*, and we don't
+   wait for it because that would make hovering jerky. The next move will do.
 */
 void mouseMoveEvent(QMouseEvent *event)
 {
   if (((main_window->ocelot_statement_syntax_checker.toInt()) & FLAG_FOR_HIGHLIGHTS)
    && (main_window->main_token_max_count > 0)
+   && (main_window->hparse_background_state == HPARSE_BACKGROUND_IDLE)
    && (main_window->statement_edit_widget == this))
   {
     QPoint i= event->pos();
@@ -8139,5 +8593,101 @@ bool eventFilter(QObject *obj, QEvent *event)
 };
 #endif // TEXTEDITHISTORY_H
 
+/*****************************************************************************************************************************/
+/* THE STATEMENTHIGHLIGHTER */
+
+/*
+  Syntax highlighting of statement_edit_widget.
+  MainWindow::statement_highlight() decides what each token looks like
+  and puts it in editor_token_highlights[]. It calls highlight_block()
+  for blocks that are visible and changed, other changed blocks wait till
+  they're scrolled into view (statement_highlight_visible()).
+  highlight_block() finds the first token that ends in the block -- it might
+  have started in an earlier block, e.g. a multi-line comment -- so the
+  state that carries from block to block is the token list.
+  This isn't a QSyntaxHighlighter because that rehighlights the changed
+  blocks itself on every contentsChange(), before the tokens are redone,
+  and then statement_highlight_visible() would do the same blocks again.
+  So statement_highlight_visible() is the only path, and it sets the
+  block layout's formats as QSyntaxHighlighter would. Those formats are
+  not part of the document so, unlike QTextCursor::setCharFormat(), they
+  don't go on the undo stack.
+*/
+
+#ifndef STATEMENTHIGHLIGHTER_H
+#define STATEMENTHIGHLIGHTER_H
+
+class StatementHighlighter
+{
+public:
+  MainWindow *main_window;
+  QTextDocument *document;
+  QTextCharFormat formats[HIGHLIGHT_COUNT];
+
+  StatementHighlighter(QTextDocument *parent_document, MainWindow *parent)
+  {
+    document= parent_document;
+    main_window= parent;
+  }
+
+void highlight_block(QTextBlock block)
+{
+  /* If the document changed and statement_highlight() hasn't happened yet, tokens are old. */
+  if ((main_window->editor_token_is_valid == false)
+   || (main_window->editor_change_position != -1)
+   || (main_window->editor_token_highlights == 0)) return;
+  int *offsets= main_window->editor_token_offsets;
+  int *lengths= main_window->editor_token_lengths;
+  unsigned char *highlights= main_window->editor_token_highlights;
+  int count= main_window->editor_token_highlights_count;
+  int block_start= block.position();
+  int block_end= block_start + block.length() - 1;
+#if QT_VERSION >= 0x50600
+  QVector<QTextLayout::FormatRange> ranges;
+#else
+  QList<QTextLayout::FormatRange> ranges;
+#endif
+  int i= count;
+  int low= 0, high= count - 1;
+  while (low <= high)
+  {
+    int middle= (low + high) / 2;
+    if (offsets[middle] + lengths[middle] > block_start)
+    {
+      i= middle;
+      high= middle - 1;
+    }
+    else low= middle + 1;
+  }
+  for (; (i < count) && (offsets[i] < block_end); ++i)
+  {
+    if (highlights[i] == HIGHLIGHT_OTHER) continue;
+    int start= offsets[i];
+    if (start < block_start) start= block_start;
+    int end= offsets[i] + lengths[i];
+    if (end > block_end) end= block_end;
+    QTextLayout::FormatRange range;
+    range.start= start - block_start;
+    range.length= end - start;
+    range.format= formats[highlights[i] & (~HIGHLIGHT_IS_ERROR)];
+    /* Todo: consider using SpellCheckUnderline instead of WaveUnderline. */
+    if ((highlights[i] & HIGHLIGHT_IS_ERROR) != 0)
+    {
+      range.format.setUnderlineStyle(QTextCharFormat::WaveUnderline);
+      range.format.setUnderlineColor(Qt::red);
+    }
+    ranges.append(range);
+  }
+#if QT_VERSION >= 0x50600
+  block.layout()->setFormats(ranges);
+#else
+  block.layout()->setAdditionalFormats(ranges);
+#endif
+  document->markContentsDirty(block_start, block.length());
+}
+
+};
+#endif // STATEMENTHIGHLIGHTER_H
+
 #endif // OCELOTGUI_H
 
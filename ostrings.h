@@ -157,7 +157,13 @@ static const char *string_languages[]=
 #define ER_CREATE_SERVER                  80
 #define ER_EMPTY_LITERAL                  81
 #define ER_START_OF_SESSION               82
-#define ER_END                            83
+#define ER_ROWS_EXPORTED                  83
+#define ER_EXPORT_WRITE_FAILED            84
+#define ER_SOURCE_SUMMARY                 85
+#define ER_SOURCE_FIRST_ERROR             86
+#define ER_BENCH                          87
+#define ER_PROFILE_OFF                    88
+#define ER_END                            89
 #define ER_MAX_LENGTH       1024
 static const char *er_strings[]=
 {
@@ -244,7 +250,13 @@ static const char *er_strings[]=
   "No", /* ER_NO */
   "CREATE SERVER not done for this name", /* ER_CREATE_SERVER */
   "Empty literal", /* ER_EMPTY_LITERAL */
-  "/* Start of Session */" /* ER_START_OF_SESSION */
+  "/* Start of Session */", /* ER_START_OF_SESSION */
+  " %llu rows exported", /* ER_ROWS_EXPORTED */
+  "Error, export write failed (disk full or pipe closed?)", /* ER_EXPORT_WRITE_FAILED */
+  " %lu statements, %lu errors, %lu warnings", /* ER_SOURCE_SUMMARY */
+  ". First error at line %lu: ", /* ER_SOURCE_FIRST_ERROR */
+  "Error, $BENCH syntax is $BENCH [n=count] [concurrency=count] statement", /* ER_BENCH */
+  "performance_schema is off, so ocelot_statement_profile does nothing", /* ER_PROFILE_OFF */
   /* FRENCH */
     "OK",                           /* ER_OK */
     "Erreur non connecté",          /* ER_NOT_CONNECTED */
@@ -328,7 +340,13 @@ static const char *er_strings[]=
     "Non", /* ER_NO */
     "CREATE SERVER pas fait pour ce nom", /* ER_CREATE_SERVER */
     "Vide constant", /* ER_EMPTY_LITERAL */
-    "/* Début de Session */" /* ER_START_OF_SESSION */
+    "/* Début de Session */", /* ER_START_OF_SESSION */
+    " %llu lignes exportées", /* ER_ROWS_EXPORTED */
+    "Erreur, écriture de l'export échouée (disque plein ou pipe fermé?)", /* ER_EXPORT_WRITE_FAILED */
+    " %lu instructions, %lu erreurs, %lu avertissements", /* ER_SOURCE_SUMMARY */
+    ". Première erreur à la ligne %lu : ", /* ER_SOURCE_FIRST_ERROR */
+    "Erreur, la syntaxe de $BENCH est $BENCH [n=nombre] [concurrency=nombre] instruction", /* ER_BENCH */
+    "performance_schema est désactivé, donc ocelot_statement_profile ne fait rien" /* ER_PROFILE_OFF */
 };
 
 /*